@@ -0,0 +1 @@
+#include "/root/repo/ns-3.44/src/spectrum/helper/adhoc-aloha-noack-ideal-phy-helper.h"
@@ -0,0 +1 @@
+#include "../../../src/network/utils/async-file-writer.h"
@@ -0,0 +1 @@
+#include "/root/repo/ns-3.44/src/propagation/model/cost231-propagation-loss-model.h"
@@ -0,0 +1 @@
+#include "/root/repo/ns-3.44/src/energy/helper/energy-harvester-helper.h"
@@ -0,0 +1 @@
+#include "/root/repo/ns-3.44/src/flow-monitor/helper/flow-monitor-helper.h"
@@ -0,0 +1 @@
+#include "/root/repo/ns-3.44/src/network/test/header-serialization-test.h"
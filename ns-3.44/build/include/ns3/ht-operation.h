@@ -0,0 +1 @@
+#include "/root/repo/ns-3.44/src/wifi/model/ht/ht-operation.h"
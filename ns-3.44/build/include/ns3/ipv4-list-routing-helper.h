@@ -0,0 +1 @@
+#include "/root/repo/ns-3.44/src/internet/helper/ipv4-list-routing-helper.h"
@@ -0,0 +1 @@
+#include "/root/repo/ns-3.44/src/internet/model/ipv6-end-point.h"
@@ -0,0 +1 @@
+#include "/root/repo/ns-3.44/src/propagation/model/itu-r-1411-los-propagation-loss-model.h"
@@ -0,0 +1 @@
+#include "/root/repo/ns-3.44/src/propagation/model/kun-2600-mhz-propagation-loss-model.h"
@@ -0,0 +1 @@
+#include "/root/repo/ns-3.44/src/network/model/nix-vector.h"
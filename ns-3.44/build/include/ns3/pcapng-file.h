@@ -0,0 +1 @@
+#include "../../../src/network/utils/pcapng-file.h"
@@ -0,0 +1 @@
+#include "/root/repo/ns-3.44/src/point-to-point/model/point-to-point-net-device.h"
@@ -0,0 +1 @@
+#include "/root/repo/ns-3.44/src/propagation/model/probabilistic-v2v-channel-condition-model.h"
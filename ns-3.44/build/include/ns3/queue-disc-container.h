@@ -0,0 +1 @@
+#include "/root/repo/ns-3.44/src/traffic-control/helper/queue-disc-container.h"
@@ -0,0 +1 @@
+#include "/root/repo/ns-3.44/src/mobility/model/random-walk-2d-mobility-model.h"
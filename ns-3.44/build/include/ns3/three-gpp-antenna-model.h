@@ -0,0 +1 @@
+#include "/root/repo/ns-3.44/src/antenna/model/three-gpp-antenna-model.h"
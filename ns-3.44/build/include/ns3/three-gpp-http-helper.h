@@ -0,0 +1 @@
+#include "/root/repo/ns-3.44/src/applications/helper/three-gpp-http-helper.h"
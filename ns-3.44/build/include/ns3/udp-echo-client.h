@@ -0,0 +1 @@
+#include "/root/repo/ns-3.44/src/applications/model/udp-echo-client.h"
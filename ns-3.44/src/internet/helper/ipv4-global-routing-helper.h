@@ -76,6 +76,9 @@ class Ipv4GlobalRoutingHelper : public Ipv4RoutingHelper
      * Users must first call PopulateRoutingTables() and then may subsequently
      * call RecomputeRoutingTables() at any later time in the simulation.
      *
+     * Only the routes of the nodes whose shortest path tree may be changed by
+     * the updated Link State Advertisements are removed and recomputed; the
+     * routes of the other nodes are left as they are.
      */
     static void RecomputeRoutingTables();
 };
@@ -19,6 +19,9 @@
 #include "ns3/trace-source-accessor.h"
 #include "ns3/uinteger.h"
 
+#include <algorithm>
+#include <vector>
+
 namespace ns3
 {
 
@@ -186,40 +189,46 @@ void
 ArpCache::HandleWaitReplyTimeout()
 {
     NS_LOG_FUNCTION(this);
-    ArpCache::Entry* entry;
     bool restartWaitReplyTimer = false;
-    for (auto i = m_arpCache.begin(); i != m_arpCache.end(); i++)
+    // only the entries which were put in WaitReply state are visited, in address order
+    for (auto i = m_waitReply.begin(); i != m_waitReply.end();)
     {
-        entry = (*i).second;
-        if (entry != nullptr && entry->IsWaitReply())
+        auto it = m_arpCache.find(*i);
+        if (it == m_arpCache.end() || !it->second->IsWaitReply())
         {
-            if (entry->GetRetries() < m_maxRetries)
-            {
-                NS_LOG_LOGIC("node=" << m_device->GetNode()->GetId() << ", ArpWaitTimeout for "
-                                     << entry->GetIpv4Address()
-                                     << " expired -- retransmitting arp request since retries = "
-                                     << entry->GetRetries());
-                m_arpRequestCallback(this, entry->GetIpv4Address());
-                restartWaitReplyTimer = true;
-                entry->IncrementRetries();
-            }
-            else
+            // the entry has been resolved or removed since
+            i = m_waitReply.erase(i);
+            continue;
+        }
+        ArpCache::Entry* entry = it->second;
+        if (entry->GetRetries() < m_maxRetries)
+        {
+            NS_LOG_LOGIC("node=" << m_device->GetNode()->GetId() << ", ArpWaitTimeout for "
+                                 << entry->GetIpv4Address()
+                                 << " expired -- retransmitting arp request since retries = "
+                                 << entry->GetRetries());
+            m_arpRequestCallback(this, entry->GetIpv4Address());
+            restartWaitReplyTimer = true;
+            entry->IncrementRetries();
+            i++;
+        }
+        else
+        {
+            NS_LOG_LOGIC("node=" << m_device->GetNode()->GetId() << ", wait reply for "
+                                 << entry->GetIpv4Address()
+                                 << " expired -- drop since max retries exceeded: "
+                                 << entry->GetRetries());
+            entry->MarkDead();
+            entry->ClearRetries();
+            Ipv4PayloadHeaderPair pending = entry->DequeuePending();
+            while (pending.first)
             {
-                NS_LOG_LOGIC("node=" << m_device->GetNode()->GetId() << ", wait reply for "
-                                     << entry->GetIpv4Address()
-                                     << " expired -- drop since max retries exceeded: "
-                                     << entry->GetRetries());
-                entry->MarkDead();
-                entry->ClearRetries();
-                Ipv4PayloadHeaderPair pending = entry->DequeuePending();
-                while (pending.first)
-                {
-                    // add the Ipv4 header for tracing purposes
-                    pending.first->AddHeader(pending.second);
-                    m_dropTrace(pending.first);
-                    pending = entry->DequeuePending();
-                }
+                // add the Ipv4 header for tracing purposes
+                pending.first->AddHeader(pending.second);
+                m_dropTrace(pending.first);
+                pending = entry->DequeuePending();
             }
+            i = m_waitReply.erase(i);
         }
     }
     if (restartWaitReplyTimer)
@@ -239,6 +248,8 @@ ArpCache::Flush()
         delete (*i).second;
     }
     m_arpCache.erase(m_arpCache.begin(), m_arpCache.end());
+    m_macIndex.clear();
+    m_waitReply.clear();
     if (m_waitReplyTimer.IsPending())
     {
         NS_LOG_LOGIC("Stopping WaitReplyTimer at " << Simulator::Now().GetSeconds()
@@ -253,7 +264,13 @@ ArpCache::PrintArpCache(Ptr<OutputStreamWrapper> stream)
     NS_LOG_FUNCTION(this << stream);
     std::ostream* os = stream->GetStream();
 
-    for (auto i = m_arpCache.begin(); i != m_arpCache.end(); i++)
+    // print the entries in address order
+    std::vector<std::pair<Ipv4Address, ArpCache::Entry*>> entries(m_arpCache.begin(),
+                                                                  m_arpCache.end());
+    std::sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) {
+        return a.first < b.first;
+    });
+    for (auto i = entries.begin(); i != entries.end(); i++)
     {
         *os << i->first << " dev ";
         std::string found = Names::FindName(m_device);
@@ -300,8 +317,9 @@ ArpCache::RemoveAutoGeneratedEntries()
         if (i->second->IsAutoGenerated())
         {
             i->second->ClearPendingPacket(); // clear the pending packets for entry's ipaddress
+            UnindexMacAddress(i->second);
             delete i->second;
-            m_arpCache.erase(i++);
+            i = m_arpCache.erase(i);
             continue;
         }
         i++;
@@ -314,13 +332,10 @@ ArpCache::LookupInverse(Address to)
     NS_LOG_FUNCTION(this << to);
 
     std::list<ArpCache::Entry*> entryList;
-    for (auto i = m_arpCache.begin(); i != m_arpCache.end(); i++)
+    auto range = m_macIndex.equal_range(to);
+    for (auto i = range.first; i != range.second; i++)
     {
-        ArpCache::Entry* entry = (*i).second;
-        if (entry->GetMacAddress() == to)
-        {
-            entryList.push_back(entry);
-        }
+        entryList.push_back(i->second);
     }
     return entryList;
 }
@@ -344,7 +359,7 @@ ArpCache::Add(Ipv4Address to)
     NS_ASSERT(m_arpCache.find(to) == m_arpCache.end());
 
     auto entry = new ArpCache::Entry(this);
-    m_arpCache[to] = entry;
+    m_arpCache.emplace(to, entry);
     entry->SetIpv4Address(to);
     return entry;
 }
@@ -354,17 +369,41 @@ ArpCache::Remove(ArpCache::Entry* entry)
 {
     NS_LOG_FUNCTION(this << entry);
 
-    for (auto i = m_arpCache.begin(); i != m_arpCache.end(); i++)
+    auto i = m_arpCache.find(entry->GetIpv4Address());
+    if (i != m_arpCache.end() && i->second == entry)
     {
-        if ((*i).second == entry)
+        m_arpCache.erase(i);
+        UnindexMacAddress(entry);
+        entry->ClearPendingPacket(); // clear the pending packets for entry's ipaddress
+        delete entry;
+        return;
+    }
+    NS_LOG_WARN("Entry not found in this ARP Cache");
+}
+
+void
+ArpCache::IndexMacAddress(ArpCache::Entry* entry)
+{
+    NS_LOG_FUNCTION(this << entry);
+    if (!entry->GetMacAddress().IsInvalid())
+    {
+        m_macIndex.emplace(entry->GetMacAddress(), entry);
+    }
+}
+
+void
+ArpCache::UnindexMacAddress(ArpCache::Entry* entry)
+{
+    NS_LOG_FUNCTION(this << entry);
+    auto range = m_macIndex.equal_range(entry->GetMacAddress());
+    for (auto i = range.first; i != range.second; i++)
+    {
+        if (i->second == entry)
         {
-            m_arpCache.erase(i);
-            entry->ClearPendingPacket(); // clear the pending packets for entry's ipaddress
-            delete entry;
+            m_macIndex.erase(i);
             return;
         }
     }
-    NS_LOG_WARN("Entry not found in this ARP Cache");
 }
 
 ArpCache::Entry::Entry(ArpCache* arp)
@@ -425,7 +464,9 @@ ArpCache::Entry::MarkAlive(Address macAddress)
 {
     NS_LOG_FUNCTION(this << macAddress);
     NS_ASSERT(m_state == WAIT_REPLY);
+    m_arp->UnindexMacAddress(this);
     m_macAddress = macAddress;
+    m_arp->IndexMacAddress(this);
     m_state = ALIVE;
     ClearRetries();
     UpdateSeen();
@@ -481,6 +522,7 @@ ArpCache::Entry::MarkWaitReply(Ipv4PayloadHeaderPair waiting)
     m_state = WAIT_REPLY;
     m_pending.push_back(waiting);
     UpdateSeen();
+    m_arp->m_waitReply.insert(m_ipv4Address);
     m_arp->StartWaitReplyTimer();
 }
 
@@ -495,7 +537,9 @@ void
 ArpCache::Entry::SetMacAddress(Address macAddress)
 {
     NS_LOG_FUNCTION(this);
+    m_arp->UnindexMacAddress(this);
     m_macAddress = macAddress;
+    m_arp->IndexMacAddress(this);
 }
 
 Ipv4Address
@@ -22,7 +22,9 @@
 
 #include <list>
 #include <map>
+#include <set>
 #include <stdint.h>
+#include <unordered_map>
 
 namespace ns3
 {
@@ -37,6 +39,11 @@ class Ipv4Header;
  *
  * A cached lookup table for translating layer 3 addresses to layer 2.
  * This implementation does lookups from IPv4 to a MAC address
+ *
+ * The entries are kept in a hash table, and indexed by MAC address for the
+ * inverse lookups. The entries expire lazily, when they are looked up, and
+ * the entries waiting for a reply are kept in a separate set, so that the
+ * single wait reply timer of the cache only visits these entries.
  */
 class ArpCache : public Object
 {
@@ -310,14 +317,26 @@ class ArpCache : public Object
     /**
      * @brief ARP Cache container
      */
-    typedef std::map<Ipv4Address, ArpCache::Entry*> Cache;
+    typedef std::unordered_map<Ipv4Address, ArpCache::Entry*, Ipv4AddressHash> Cache;
     /**
      * @brief ARP Cache container iterator
      */
-    typedef std::map<Ipv4Address, ArpCache::Entry*>::iterator CacheI;
+    typedef std::unordered_map<Ipv4Address, ArpCache::Entry*, Ipv4AddressHash>::iterator CacheI;
 
     void DoDispose() override;
 
+    /**
+     * @brief Index an entry by its MAC address, if valid.
+     * @param entry the entry
+     */
+    void IndexMacAddress(ArpCache::Entry* entry);
+
+    /**
+     * @brief Remove an entry from the index of the MAC addresses.
+     * @param entry the entry
+     */
+    void UnindexMacAddress(ArpCache::Entry* entry);
+
     Ptr<NetDevice> m_device;        //!< NetDevice associated with the cache
     Ptr<Ipv4Interface> m_interface; //!< Ipv4Interface associated with the cache
     Time m_aliveTimeout;            //!< cache alive state timeout
@@ -338,6 +357,9 @@ class ArpCache : public Object
     Cache m_arpCache;            //!< the ARP cache
     TracedCallback<Ptr<const Packet>>
         m_dropTrace; //!< trace for packets dropped by the ARP cache queue
+
+    std::multimap<Address, ArpCache::Entry*> m_macIndex; //!< the entries, by MAC address
+    std::set<Ipv4Address> m_waitReply;                   //!< the entries waiting for a reply
 };
 
 } // namespace ns3
@@ -60,7 +60,8 @@ operator<<(std::ostream& os, const CandidateQueue& q)
 }
 
 CandidateQueue::CandidateQueue()
-    : m_candidates()
+    : m_candidates(),
+      m_index()
 {
     NS_LOG_FUNCTION(this);
 }
@@ -93,6 +94,7 @@ CandidateQueue::Push(SPFVertex* vNew)
                               vNew,
                               &CandidateQueue::CompareSPFVertex);
     m_candidates.insert(i, vNew);
+    m_index[vNew->GetVertexId()] = vNew;
 }
 
 SPFVertex*
@@ -106,6 +108,11 @@ CandidateQueue::Pop()
 
     SPFVertex* v = m_candidates.front();
     m_candidates.pop_front();
+    auto i = m_index.find(v->GetVertexId());
+    if (i != m_index.end() && i->second == v)
+    {
+        m_index.erase(i);
+    }
     return v;
 }
 
@@ -139,18 +146,12 @@ SPFVertex*
 CandidateQueue::Find(const Ipv4Address addr) const
 {
     NS_LOG_FUNCTION(this);
-    auto i = m_candidates.begin();
-
-    for (; i != m_candidates.end(); i++)
+    auto i = m_index.find(addr);
+    if (i == m_index.end())
     {
-        SPFVertex* v = *i;
-        if (v->GetVertexId() == addr)
-        {
-            return v;
-        }
+        return nullptr;
     }
-
-    return nullptr;
+    return i->second;
 }
 
 void
@@ -19,13 +19,19 @@
 
 #include "ns3/assert.h"
 #include "ns3/fatal-error.h"
+#include "ns3/global-value.h"
 #include "ns3/log.h"
 #include "ns3/node-list.h"
 #include "ns3/simulator.h"
+#include "ns3/uinteger.h"
 
 #include <algorithm>
+#include <atomic>
 #include <iostream>
+#include <iterator>
 #include <queue>
+#include <thread>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -34,6 +40,19 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("GlobalRouteManagerImpl");
 
+/**
+ * @ingroup globalrouting
+ * @anchor GlobalValueGlobalRoutingSpfThreads
+ * @brief Number of threads running the SPF calculations of the global routing.
+ */
+static GlobalValue g_globalRoutingSpfThreads =
+    GlobalValue("GlobalRoutingSpfThreads",
+                "The number of threads running the SPF calculations of the global routing "
+                "(0 for one per hardware thread).  Since logging is not thread safe, the "
+                "calculations run on a single thread when a log component is enabled.",
+                UintegerValue(1),
+                MakeUintegerChecker<uint32_t>());
+
 /**
  * @brief Stream insertion operator.
  *
@@ -415,6 +434,8 @@ SPFVertex::ClearVertexProcessed()
 
 GlobalRouteManagerLSDB::GlobalRouteManagerLSDB()
     : m_database(),
+      m_index(),
+      m_linkDataIndex(),
       m_extdatabase()
 {
     NS_LOG_FUNCTION(this);
@@ -426,7 +447,7 @@ GlobalRouteManagerLSDB::~GlobalRouteManagerLSDB()
     for (auto i = m_database.begin(); i != m_database.end(); i++)
     {
         NS_LOG_LOGIC("free LSA");
-        GlobalRoutingLSA* temp = i->second;
+        GlobalRoutingLSA* temp = *i;
         delete temp;
     }
     for (uint32_t j = 0; j < m_extdatabase.size(); j++)
@@ -437,6 +458,8 @@ GlobalRouteManagerLSDB::~GlobalRouteManagerLSDB()
     }
     NS_LOG_LOGIC("clear map");
     m_database.clear();
+    m_index.clear();
+    m_linkDataIndex.clear();
 }
 
 void
@@ -445,7 +468,7 @@ GlobalRouteManagerLSDB::Initialize()
     NS_LOG_FUNCTION(this);
     for (auto i = m_database.begin(); i != m_database.end(); i++)
     {
-        GlobalRoutingLSA* temp = i->second;
+        GlobalRoutingLSA* temp = *i;
         temp->SetStatus(GlobalRoutingLSA::LSA_SPF_NOT_EXPLORED);
     }
 }
@@ -457,10 +480,30 @@ GlobalRouteManagerLSDB::Insert(Ipv4Address addr, GlobalRoutingLSA* lsa)
     if (lsa->GetLSType() == GlobalRoutingLSA::ASExternalLSAs)
     {
         m_extdatabase.push_back(lsa);
+        return;
     }
-    else
+    if (!m_index.insert(LSDBMap_t::value_type(addr, m_database.size())).second)
+    {
+        NS_LOG_LOGIC("An LSA is already stored for " << addr);
+        return;
+    }
+    m_database.push_back(lsa);
+    //
+    // When several routers claim the same LinkData, the one with the lowest link
+    // state ID is returned, as when the database was scanned in address order.
+    //
+    for (uint32_t j = 0; j < lsa->GetNLinkRecords(); j++)
     {
-        m_database.insert(LSDBPair_t(addr, lsa));
+        GlobalRoutingLinkRecord* lr = lsa->GetLinkRecord(j);
+        if (lr->GetLinkType() != GlobalRoutingLinkRecord::TransitNetwork)
+        {
+            continue;
+        }
+        auto ret = m_linkDataIndex.insert({lr->GetLinkData(), lsa});
+        if (!ret.second && addr < ret.first->second->GetLinkStateId())
+        {
+            ret.first->second = lsa;
+        }
     }
 }
 
@@ -485,14 +528,12 @@ GlobalRouteManagerLSDB::GetLSA(Ipv4Address addr) const
     //
     // Look up an LSA by its address.
     //
-    for (auto i = m_database.begin(); i != m_database.end(); i++)
+    auto i = m_index.find(addr);
+    if (i == m_index.end())
     {
-        if (i->first == addr)
-        {
-            return i->second;
-        }
+        return nullptr;
     }
-    return nullptr;
+    return m_database[i->second];
 }
 
 GlobalRoutingLSA*
@@ -500,23 +541,40 @@ GlobalRouteManagerLSDB::GetLSAByLinkData(Ipv4Address addr) const
 {
     NS_LOG_FUNCTION(this << addr);
     //
-    // Look up an LSA by its address.
+    // Look up an LSA by the LinkData of one of its TransitNetwork link records.
     //
-    for (auto i = m_database.begin(); i != m_database.end(); i++)
+    auto i = m_linkDataIndex.find(addr);
+    if (i == m_linkDataIndex.end())
     {
-        GlobalRoutingLSA* temp = i->second;
-        // Iterate among temp's Link Records
-        for (uint32_t j = 0; j < temp->GetNLinkRecords(); j++)
-        {
-            GlobalRoutingLinkRecord* lr = temp->GetLinkRecord(j);
-            if (lr->GetLinkType() == GlobalRoutingLinkRecord::TransitNetwork &&
-                lr->GetLinkData() == addr)
-            {
-                return temp;
-            }
-        }
+        return nullptr;
     }
-    return nullptr;
+    return i->second;
+}
+
+uint32_t
+GlobalRouteManagerLSDB::GetNumLSAs() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_database.size();
+}
+
+GlobalRoutingLSA*
+GlobalRouteManagerLSDB::GetLSAByIndex(uint32_t index) const
+{
+    NS_LOG_FUNCTION(this << index);
+    return m_database.at(index);
+}
+
+uint32_t
+GlobalRouteManagerLSDB::GetLSAIndex(Ipv4Address addr) const
+{
+    NS_LOG_FUNCTION(this << addr);
+    auto i = m_index.find(addr);
+    if (i == m_index.end())
+    {
+        return m_database.size();
+    }
+    return i->second;
 }
 
 // ---------------------------------------------------------------------------
@@ -526,16 +584,31 @@ GlobalRouteManagerLSDB::GetLSAByLinkData(Ipv4Address addr) const
 // ---------------------------------------------------------------------------
 
 GlobalRouteManagerImpl::GlobalRouteManagerImpl()
-    : m_spfroot(nullptr)
+    : m_spfroot(nullptr),
+      m_ownsLsdb(true),
+      m_spfRouting(nullptr),
+      m_spfIpv4(nullptr),
+      m_spfResult(nullptr)
 {
     NS_LOG_FUNCTION(this);
     m_lsdb = new GlobalRouteManagerLSDB();
 }
 
+GlobalRouteManagerImpl::GlobalRouteManagerImpl(GlobalRouteManagerLSDB* lsdb)
+    : m_spfroot(nullptr),
+      m_lsdb(lsdb),
+      m_ownsLsdb(false),
+      m_spfRouting(nullptr),
+      m_spfIpv4(nullptr),
+      m_spfResult(nullptr)
+{
+    NS_LOG_FUNCTION(this << lsdb);
+}
+
 GlobalRouteManagerImpl::~GlobalRouteManagerImpl()
 {
     NS_LOG_FUNCTION(this);
-    if (m_lsdb)
+    if (m_lsdb && m_ownsLsdb)
     {
         delete m_lsdb;
     }
@@ -550,6 +623,24 @@ GlobalRouteManagerImpl::DebugUseLsdb(GlobalRouteManagerLSDB* lsdb)
         delete m_lsdb;
     }
     m_lsdb = lsdb;
+    m_spfResults.clear();
+}
+
+void
+GlobalRouteManagerImpl::DeleteRoutes(Ptr<Ipv4GlobalRouting> gr)
+{
+    NS_LOG_FUNCTION(gr);
+    uint32_t j = 0;
+    uint32_t nRoutes = gr->GetNRoutes();
+    // Each time we delete route 0, the route index shifts downward
+    // We can delete all routes if we delete the route numbered 0
+    // nRoutes times
+    for (j = 0; j < nRoutes; j++)
+    {
+        NS_LOG_LOGIC("Deleting global route " << j);
+        gr->RemoveRoute(0);
+    }
+    NS_LOG_LOGIC("Deleted " << j << " global routes");
 }
 
 void
@@ -565,18 +656,8 @@ GlobalRouteManagerImpl::DeleteGlobalRoutes()
             continue;
         }
         Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol();
-        uint32_t j = 0;
-        uint32_t nRoutes = gr->GetNRoutes();
         NS_LOG_LOGIC("Deleting " << gr->GetNRoutes() << " routes from node " << node->GetId());
-        // Each time we delete route 0, the route index shifts downward
-        // We can delete all routes if we delete the route numbered 0
-        // nRoutes times
-        for (j = 0; j < nRoutes; j++)
-        {
-            NS_LOG_LOGIC("Deleting global route " << j << " from node " << node->GetId());
-            gr->RemoveRoute(0);
-        }
-        NS_LOG_LOGIC("Deleted " << j << " global routes from node " << node->GetId());
+        DeleteRoutes(gr);
     }
     if (m_lsdb)
     {
@@ -584,6 +665,7 @@ GlobalRouteManagerImpl::DeleteGlobalRoutes()
         delete m_lsdb;
         m_lsdb = new GlobalRouteManagerLSDB();
     }
+    m_spfResults.clear();
 }
 
 //
@@ -685,6 +767,7 @@ GlobalRouteManagerImpl::InitializeRoutes()
     // Walk the list of nodes in the system.
     //
     NS_LOG_INFO("About to start SPF calculation");
+    std::vector<SPFJob> jobs;
     for (auto i = NodeList::Begin(); i != NodeList::End(); i++)
     {
         Ptr<Node> node = *i;
@@ -707,12 +790,477 @@ GlobalRouteManagerImpl::InitializeRoutes()
         //
         if (rtr && rtr->GetNumLSAs())
         {
-            SPFCalculate(rtr->GetRouterId());
+            jobs.push_back(MakeSPFJob(node, rtr));
         }
     }
+    m_spfResults.clear();
+    RunSPFJobs(jobs);
     NS_LOG_INFO("Finished SPF calculation");
 }
 
+void
+GlobalRouteManagerImpl::UpdateGlobalRoutes()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_spfResults.empty())
+    {
+        DeleteGlobalRoutes();
+        BuildGlobalRoutingDatabase();
+        InitializeRoutes();
+        return;
+    }
+
+    GlobalRouteManagerLSDB* previous = m_lsdb;
+    m_lsdb = new GlobalRouteManagerLSDB();
+    BuildGlobalRoutingDatabase();
+    std::set<Ipv4Address> roots;
+    bool incremental = FindAffectedRoots(previous, roots);
+    delete previous;
+
+    uint32_t systemId = Simulator::GetSystemId();
+    std::vector<SPFJob> jobs;
+    for (auto i = NodeList::Begin(); i != NodeList::End(); i++)
+    {
+        Ptr<Node> node = *i;
+        Ptr<GlobalRouter> rtr = node->GetObject<GlobalRouter>();
+        if (!rtr || (incremental && roots.find(rtr->GetRouterId()) == roots.end()))
+        {
+            continue;
+        }
+        DeleteRoutes(rtr->GetRoutingProtocol());
+        if (node->GetSystemId() == systemId && rtr->GetNumLSAs())
+        {
+            jobs.push_back(MakeSPFJob(node, rtr));
+        }
+    }
+    if (!incremental)
+    {
+        NS_LOG_INFO("The set of LSAs changed, recomputing the routes of all the routers");
+        m_spfResults.clear();
+    }
+    NS_LOG_INFO("Recomputing the routes of " << jobs.size() << " routers");
+    RunSPFJobs(jobs);
+}
+
+GlobalRouteManagerImpl::SPFJob
+GlobalRouteManagerImpl::MakeSPFJob(Ptr<Node> node, Ptr<GlobalRouter> rtr)
+{
+    NS_LOG_FUNCTION(node << rtr);
+    SPFJob job;
+    job.root = rtr->GetRouterId();
+    // the routing objects are kept alive by the node, the SPF calculation
+    // must not copy Ptr instances, whose reference counts are not thread safe
+    job.routing = PeekPointer(rtr->GetRoutingProtocol());
+    NS_ASSERT(job.routing);
+    //
+    // Routing information is updated using the Ipv4 interface.  We need to
+    // GetObject for that interface.  If the node is acting as an IP version 4
+    // router, it should absolutely have an Ipv4 interface.
+    //
+    job.ipv4 = PeekPointer(node->GetObject<Ipv4>());
+    NS_ASSERT_MSG(job.ipv4,
+                  "GlobalRouteManagerImpl::MakeSPFJob (): "
+                  "GetObject for <Ipv4> interface failed");
+    return job;
+}
+
+void
+GlobalRouteManagerImpl::RunSPFJobs(std::vector<SPFJob>& jobs)
+{
+    NS_LOG_FUNCTION(this << jobs.size());
+    UintegerValue value;
+    g_globalRoutingSpfThreads.GetValue(value);
+    std::size_t nThreads = value.Get();
+    if (nThreads == 0)
+    {
+        nThreads = std::max(1U, std::thread::hardware_concurrency());
+    }
+    nThreads = std::min(nThreads, jobs.size());
+    if (nThreads > 1 && IsLoggingEnabled())
+    {
+        NS_LOG_WARN("Logging is enabled, running the SPF calculations on a single thread");
+        nThreads = 1;
+    }
+
+    if (nThreads <= 1)
+    {
+        for (auto& job : jobs)
+        {
+            RunSPFJob(job);
+        }
+    }
+    else
+    {
+        //
+        // Each thread takes the next job to run until there is none left.  The
+        // threads only read the LSDB, and each job only writes to the routing
+        // table of its root, whose objects were all looked up by this thread.
+        // The threads neither log nor copy Ptr instances.
+        //
+        NS_LOG_INFO("Running " << jobs.size() << " SPF calculations on " << nThreads
+                               << " threads");
+        std::atomic<std::size_t> next(0);
+        auto work = [this, &jobs, &next]() {
+            GlobalRouteManagerImpl worker(m_lsdb);
+            for (std::size_t i = next++; i < jobs.size(); i = next++)
+            {
+                worker.RunSPFJob(jobs[i]);
+            }
+        };
+        std::vector<std::thread> threads;
+        for (std::size_t i = 0; i < nThreads; i++)
+        {
+            threads.emplace_back(work);
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    for (auto& job : jobs)
+    {
+        m_spfResults[job.root] = std::move(job.result);
+    }
+}
+
+bool
+GlobalRouteManagerImpl::IsLoggingEnabled()
+{
+#ifdef NS3_LOG_ENABLE
+    for (const auto& [name, component] : *LogComponent::GetComponentList())
+    {
+        if (!component->IsNoneEnabled())
+        {
+            return true;
+        }
+    }
+#endif
+    return false;
+}
+
+void
+GlobalRouteManagerImpl::RunSPFJob(SPFJob& job)
+{
+    NS_LOG_FUNCTION(this << job.root);
+    m_spfRouting = job.routing;
+    m_spfIpv4 = job.ipv4;
+    m_spfResult = &job.result;
+    SPFCalculate(job.root);
+    m_spfRouting = nullptr;
+    m_spfIpv4 = nullptr;
+    m_spfResult = nullptr;
+}
+
+namespace
+{
+
+/**
+ * @ingroup globalrouting
+ *
+ * A link record of an LSA, as a sortable tuple: type, link ID, link data and metric.
+ */
+typedef std::tuple<int, Ipv4Address, Ipv4Address, uint16_t> LinkRecordKey;
+
+/**
+ * @ingroup globalrouting
+ *
+ * @param lsa an LSA
+ * @returns the link records of the LSA, in order
+ */
+std::vector<LinkRecordKey>
+GetLinkRecordKeys(const GlobalRoutingLSA* lsa)
+{
+    std::vector<LinkRecordKey> keys;
+    for (uint32_t i = 0; i < lsa->GetNLinkRecords(); i++)
+    {
+        GlobalRoutingLinkRecord* l = lsa->GetLinkRecord(i);
+        keys.emplace_back(l->GetLinkType(), l->GetLinkId(), l->GetLinkData(), l->GetMetric());
+    }
+    return keys;
+}
+
+/**
+ * @ingroup globalrouting
+ *
+ * @param lsa an LSA
+ * @returns the attached routers of a network LSA, in order
+ */
+std::vector<Ipv4Address>
+GetAttachedRouters(const GlobalRoutingLSA* lsa)
+{
+    std::vector<Ipv4Address> routers;
+    for (uint32_t i = 0; i < lsa->GetNAttachedRouters(); i++)
+    {
+        routers.push_back(lsa->GetAttachedRouter(i));
+    }
+    return routers;
+}
+
+/**
+ * @ingroup globalrouting
+ *
+ * @param a an LSA
+ * @param b another LSA
+ * @returns true if the LSAs advertise the same links
+ */
+bool
+IsSameLSA(const GlobalRoutingLSA* a, const GlobalRoutingLSA* b)
+{
+    return a->GetLSType() == b->GetLSType() && a->GetLinkStateId() == b->GetLinkStateId() &&
+           a->GetAdvertisingRouter() == b->GetAdvertisingRouter() &&
+           a->GetNetworkLSANetworkMask() == b->GetNetworkLSANetworkMask() &&
+           GetLinkRecordKeys(a) == GetLinkRecordKeys(b) &&
+           GetAttachedRouters(a) == GetAttachedRouters(b);
+}
+
+/**
+ * @ingroup globalrouting
+ *
+ * @brief The change of an LSA, as seen by the SPF calculations.
+ */
+struct LSAChange
+{
+    uint32_t index; //!< the index of the LSA
+    bool addresses; //!< whether the addresses advertised by the LSA changed
+    std::vector<std::tuple<uint32_t, uint32_t, uint32_t>>
+        edges; //!< the edges (from, to, metric) added or removed, by LSA index
+};
+
+/**
+ * @ingroup globalrouting
+ *
+ * @param v a sorted vector
+ * @param w another sorted vector
+ * @returns the elements of v which are not in w
+ */
+template <typename T>
+std::vector<T>
+Difference(const std::vector<T>& v, const std::vector<T>& w)
+{
+    std::vector<T> result;
+    std::set_difference(v.begin(), v.end(), w.begin(), w.end(), std::back_inserter(result));
+    return result;
+}
+
+/**
+ * @ingroup globalrouting
+ *
+ * @brief Describe the change of an LSA between two databases holding the same
+ * LSAs at the same indexes.
+ *
+ * @param index the index of the LSA
+ * @param before the LSA in the previous database
+ * @param after the LSA in the current database
+ * @param previous the previous database
+ * @param current the current database
+ * @returns the change
+ */
+LSAChange
+DescribeLSAChange(uint32_t index,
+                  const GlobalRoutingLSA* before,
+                  const GlobalRoutingLSA* after,
+                  const GlobalRouteManagerLSDB* previous,
+                  const GlobalRouteManagerLSDB* current)
+{
+    LSAChange change;
+    change.index = index;
+    change.addresses = false;
+    uint32_t nLSAs = current->GetNumLSAs();
+
+    if (after->GetLSType() == GlobalRoutingLSA::NetworkLSA)
+    {
+        change.addresses = before->GetNetworkLSANetworkMask() != after->GetNetworkLSANetworkMask();
+        std::vector<Ipv4Address> oldRouters = GetAttachedRouters(before);
+        std::vector<Ipv4Address> newRouters = GetAttachedRouters(after);
+        std::sort(oldRouters.begin(), oldRouters.end());
+        std::sort(newRouters.begin(), newRouters.end());
+        // the attached routers are found by the LinkData of their transit records
+        for (const auto& [routers, lsdb] :
+             {std::make_pair(Difference(oldRouters, newRouters), previous),
+              std::make_pair(Difference(newRouters, oldRouters), current)})
+        {
+            for (const auto& address : routers)
+            {
+                GlobalRoutingLSA* w = lsdb->GetLSAByLinkData(address);
+                if (w)
+                {
+                    change.edges.emplace_back(index, current->GetLSAIndex(w->GetLinkStateId()), 0);
+                }
+            }
+        }
+        return change;
+    }
+
+    std::vector<LinkRecordKey> oldKeys = GetLinkRecordKeys(before);
+    std::vector<LinkRecordKey> newKeys = GetLinkRecordKeys(after);
+    std::sort(oldKeys.begin(), oldKeys.end());
+    std::sort(newKeys.begin(), newKeys.end());
+    std::vector<LinkRecordKey> changed = Difference(oldKeys, newKeys);
+    for (const auto& key : Difference(newKeys, oldKeys))
+    {
+        changed.push_back(key);
+    }
+    for (const auto& [type, linkId, linkData, metric] : changed)
+    {
+        uint32_t to = current->GetLSAIndex(linkId);
+        if (type == GlobalRoutingLinkRecord::PointToPoint && to < nLSAs)
+        {
+            change.edges.emplace_back(index, to, metric);
+        }
+        else if (type == GlobalRoutingLinkRecord::TransitNetwork && to < nLSAs)
+        {
+            // the network LSA leads back to this router through its LinkData
+            change.edges.emplace_back(index, to, metric);
+            change.edges.emplace_back(to, index, 0);
+        }
+        else
+        {
+            // stub networks are routed to
+            change.addresses = true;
+        }
+    }
+
+    // the local addresses of the point-to-point links are routed to
+    std::vector<Ipv4Address> oldAddresses;
+    std::vector<Ipv4Address> newAddresses;
+    for (const auto& [keys, addresses] :
+         {std::make_pair(&oldKeys, &oldAddresses), std::make_pair(&newKeys, &newAddresses)})
+    {
+        for (const auto& [type, linkId, linkData, metric] : *keys)
+        {
+            if (type == GlobalRoutingLinkRecord::PointToPoint)
+            {
+                addresses->push_back(linkData);
+            }
+        }
+        std::sort(addresses->begin(), addresses->end());
+    }
+    change.addresses = change.addresses || oldAddresses != newAddresses;
+    return change;
+}
+
+} // namespace
+
+bool
+GlobalRouteManagerImpl::FindAffectedRoots(const GlobalRouteManagerLSDB* previous,
+                                          std::set<Ipv4Address>& roots) const
+{
+    NS_LOG_FUNCTION(this << previous);
+    //
+    // The stored results are only valid when the LSAs are the same, at the same
+    // indexes.
+    //
+    uint32_t nLSAs = m_lsdb->GetNumLSAs();
+    if (previous->GetNumLSAs() != nLSAs || previous->GetNumExtLSAs() != m_lsdb->GetNumExtLSAs())
+    {
+        return false;
+    }
+    for (uint32_t i = 0; i < m_lsdb->GetNumExtLSAs(); i++)
+    {
+        if (!IsSameLSA(previous->GetExtLSA(i), m_lsdb->GetExtLSA(i)))
+        {
+            return false;
+        }
+    }
+    std::vector<LSAChange> changes;
+    for (uint32_t i = 0; i < nLSAs; i++)
+    {
+        GlobalRoutingLSA* before = previous->GetLSAByIndex(i);
+        GlobalRoutingLSA* after = m_lsdb->GetLSAByIndex(i);
+        if (before->GetLinkStateId() != after->GetLinkStateId() ||
+            before->GetLSType() != after->GetLSType())
+        {
+            return false;
+        }
+        if (!IsSameLSA(before, after))
+        {
+            NS_LOG_LOGIC("LSA " << after->GetLinkStateId() << " changed");
+            changes.push_back(DescribeLSAChange(i, before, after, previous, m_lsdb));
+        }
+    }
+
+    //
+    // A tree is left unchanged when no edge it uses is removed or made more
+    // expensive, no edge added or made cheaper gives a path as short as the ones
+    // it holds, and the addresses advertised by the routers it reaches are the
+    // same.  The next hops are also taken from the links of the neighbors back to
+    // the root and to the networks adjacent to it.
+    //
+    for (const auto& [root, result] : m_spfResults)
+    {
+        uint32_t rootIndex = m_lsdb->GetLSAIndex(root);
+        const std::vector<uint32_t>& distance = result.distance;
+        auto isAffected = [&](const LSAChange& change) {
+            if (change.index == rootIndex)
+            {
+                return true;
+            }
+            if (change.addresses && distance[change.index] != SPF_INFINITY)
+            {
+                return true;
+            }
+            for (const auto& [from, to, metric] : change.edges)
+            {
+                if (distance[from] == SPF_INFINITY)
+                {
+                    continue;
+                }
+                if (to == rootIndex ||
+                    std::find(result.rootNetworks.begin(), result.rootNetworks.end(), to) !=
+                        result.rootNetworks.end() ||
+                    static_cast<uint64_t>(distance[from]) + metric <= distance[to])
+                {
+                    return true;
+                }
+            }
+            return false;
+        };
+        if (std::any_of(changes.begin(), changes.end(), isAffected))
+        {
+            NS_LOG_LOGIC("Routes of " << root << " affected");
+            roots.insert(root);
+        }
+    }
+    return true;
+}
+
+void
+GlobalRouteManagerImpl::RecordSPFVertex(SPFVertex* v)
+{
+    NS_LOG_FUNCTION(this << v);
+    uint32_t index = m_lsdb->GetLSAIndex(v->GetLSA()->GetLinkStateId());
+    m_spfResult->distance[index] = v->GetDistanceFromRoot();
+    if (v->GetVertexType() != SPFVertex::VertexNetwork)
+    {
+        return;
+    }
+    for (uint32_t i = 0; v->GetParent(i); i++)
+    {
+        if (v->GetParent(i) == m_spfroot)
+        {
+            m_spfResult->rootNetworks.push_back(index);
+            return;
+        }
+    }
+}
+
+GlobalRoutingLSA::SPFStatus
+GlobalRouteManagerImpl::GetLSAStatus(GlobalRoutingLSA* lsa) const
+{
+    uint32_t index = m_lsdb->GetLSAIndex(lsa->GetLinkStateId());
+    NS_ASSERT(index < m_lsaStatus.size());
+    return m_lsaStatus[index];
+}
+
+void
+GlobalRouteManagerImpl::SetLSAStatus(GlobalRoutingLSA* lsa, GlobalRoutingLSA::SPFStatus status)
+{
+    uint32_t index = m_lsdb->GetLSAIndex(lsa->GetLinkStateId());
+    NS_ASSERT(index < m_lsaStatus.size());
+    m_lsaStatus[index] = status;
+}
+
 //
 // This method is derived from quagga ospf_spf_next ().  See RFC2328 Section
 // 16.1 (2) for further details.
@@ -816,7 +1364,7 @@ GlobalRouteManagerImpl::SPFNext(SPFVertex* v, CandidateQueue& candidate)
         // If the link is to a router that is already in the shortest path first tree
         // then we have it covered -- ignore it.
         //
-        if (w_lsa->GetStatus() == GlobalRoutingLSA::LSA_SPF_IN_SPFTREE)
+        if (GetLSAStatus(w_lsa) == GlobalRoutingLSA::LSA_SPF_IN_SPFTREE)
         {
             NS_LOG_LOGIC("Skipping ->  LSA " << w_lsa->GetLinkStateId() << " already in SPF tree");
             continue;
@@ -840,7 +1388,7 @@ GlobalRouteManagerImpl::SPFNext(SPFVertex* v, CandidateQueue& candidate)
         NS_LOG_LOGIC("Considering w_lsa " << w_lsa->GetLinkStateId());
 
         // Is there already vertex w in candidate list?
-        if (w_lsa->GetStatus() == GlobalRoutingLSA::LSA_SPF_NOT_EXPLORED)
+        if (GetLSAStatus(w_lsa) == GlobalRoutingLSA::LSA_SPF_NOT_EXPLORED)
         {
             // Calculate nexthop to w
             // We need to figure out how to actually get to the new router represented
@@ -852,7 +1400,7 @@ GlobalRouteManagerImpl::SPFNext(SPFVertex* v, CandidateQueue& candidate)
             w = new SPFVertex(w_lsa);
             if (SPFNexthopCalculation(v, w, l, distance))
             {
-                w_lsa->SetStatus(GlobalRoutingLSA::LSA_SPF_CANDIDATE);
+                SetLSAStatus(w_lsa, GlobalRoutingLSA::LSA_SPF_CANDIDATE);
                 //
                 // Push this new vertex onto the priority queue (ordered by distance from the
                 // root node).
@@ -869,7 +1417,7 @@ GlobalRouteManagerImpl::SPFNext(SPFVertex* v, CandidateQueue& candidate)
                                   << "return false, but it does now!");
             }
         }
-        else if (w_lsa->GetStatus() == GlobalRoutingLSA::LSA_SPF_CANDIDATE)
+        else if (GetLSAStatus(w_lsa) == GlobalRoutingLSA::LSA_SPF_CANDIDATE)
         {
             //
             // We have already considered the link represented by <w>.  What wse have to
@@ -1223,7 +1771,18 @@ void
 GlobalRouteManagerImpl::DebugSPFCalculate(Ipv4Address root)
 {
     NS_LOG_FUNCTION(this << root);
-    SPFCalculate(root);
+    SPFJob job;
+    job.root = root;
+    for (auto i = NodeList::Begin(); i != NodeList::End(); i++)
+    {
+        Ptr<GlobalRouter> rtr = (*i)->GetObject<GlobalRouter>();
+        if (rtr && rtr->GetRouterId() == root)
+        {
+            job = MakeSPFJob(*i, rtr);
+            break;
+        }
+    }
+    RunSPFJob(job);
 }
 
 //
@@ -1292,14 +1851,12 @@ GlobalRouteManagerImpl::CheckForStubNode(Ipv4Address root)
                 if (lr->GetLinkId() == myRouterId)
                 {
                     // Next hop is stored in the LinkID field of lr
-                    Ptr<GlobalRouter> router = rlsa->GetNode()->GetObject<GlobalRouter>();
-                    NS_ASSERT(router);
-                    Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol();
-                    NS_ASSERT(gr);
-                    gr->AddNetworkRouteTo(Ipv4Address("0.0.0.0"),
-                                          Ipv4Mask("0.0.0.0"),
-                                          lr->GetLinkData(),
-                                          FindOutgoingInterfaceId(transitLink->GetLinkData()));
+                    NS_ASSERT(m_spfRouting);
+                    m_spfRouting->AddNetworkRouteTo(
+                        Ipv4Address("0.0.0.0"),
+                        Ipv4Mask("0.0.0.0"),
+                        lr->GetLinkData(),
+                        FindOutgoingInterfaceId(transitLink->GetLinkData()));
                     NS_LOG_LOGIC("Inserting default route for node "
                                  << myRouterId << " to next hop " << lr->GetLinkData()
                                  << " via interface "
@@ -1320,9 +1877,11 @@ GlobalRouteManagerImpl::SPFCalculate(Ipv4Address root)
 
     SPFVertex* v;
     //
-    // Initialize the Link State Database.
+    // Initialize the status of the Link State Advertisements.  It is kept by this
+    // object rather than in the LSAs, so that the database is only read during
+    // the calculation, and can be shared by calculations rooted at other routers.
     //
-    m_lsdb->Initialize();
+    m_lsaStatus.assign(m_lsdb->GetNumLSAs(), GlobalRoutingLSA::LSA_SPF_NOT_EXPLORED);
     //
     // The candidate queue is a priority queue of SPFVertex objects, with the top
     // of the queue being the closest vertex in terms of distance from the root
@@ -1342,8 +1901,14 @@ GlobalRouteManagerImpl::SPFCalculate(Ipv4Address root)
     //
     m_spfroot = v;
     v->SetDistanceFromRoot(0);
-    v->GetLSA()->SetStatus(GlobalRoutingLSA::LSA_SPF_IN_SPFTREE);
+    SetLSAStatus(v->GetLSA(), GlobalRoutingLSA::LSA_SPF_IN_SPFTREE);
     NS_LOG_LOGIC("Starting SPFCalculate for node " << root);
+    if (m_spfResult)
+    {
+        m_spfResult->distance.assign(m_lsdb->GetNumLSAs(), SPF_INFINITY);
+        m_spfResult->distance[m_lsdb->GetLSAIndex(root)] = 0;
+        m_spfResult->rootNetworks.clear();
+    }
 
     //
     // Optimize SPF calculation, for ns-3.
@@ -1352,10 +1917,28 @@ GlobalRouteManagerImpl::SPFCalculate(Ipv4Address root)
     // reached.  Instead, short-circuit this computation and just install
     // a default route in the CheckForStubNode() method.
     //
-    if (NodeList::GetNNodes() > 0 && CheckForStubNode(root))
+    if (m_spfRouting && CheckForStubNode(root))
     {
         NS_LOG_LOGIC("SPFCalculate truncated for stub node " << root);
+        if (m_spfResult)
+        {
+            //
+            // The default route depends on the LSAs of the neighbors: consider them
+            // at distance 0, so that any change of theirs is seen as affecting this
+            // router.
+            //
+            GlobalRoutingLSA* rlsa = m_spfroot->GetLSA();
+            for (uint32_t i = 0; i < rlsa->GetNLinkRecords(); i++)
+            {
+                uint32_t index = m_lsdb->GetLSAIndex(rlsa->GetLinkRecord(i)->GetLinkId());
+                if (index < m_lsdb->GetNumLSAs())
+                {
+                    m_spfResult->distance[index] = 0;
+                }
+            }
+        }
         delete m_spfroot;
+        m_spfroot = nullptr;
         return;
     }
 
@@ -1403,7 +1986,11 @@ GlobalRouteManagerImpl::SPFCalculate(Ipv4Address root)
         // Update the status field of the vertex to indicate that it is in the SPF
         // tree.
         //
-        v->GetLSA()->SetStatus(GlobalRoutingLSA::LSA_SPF_IN_SPFTREE);
+        SetLSAStatus(v->GetLSA(), GlobalRoutingLSA::LSA_SPF_IN_SPFTREE);
+        if (m_spfResult)
+        {
+            RecordSPFVertex(v);
+        }
         //
         // The current vertex has a parent pointer.  By calling this rather oddly
         // named method (blame quagga) we add the current vertex to the list of
@@ -1419,12 +2006,11 @@ GlobalRouteManagerImpl::SPFCalculate(Ipv4Address root)
         //
         // RFC2328 16.1. (4).
         //
-        // This is the method that actually adds the routes.  It'll walk the list
-        // of nodes in the system, looking for the node corresponding to the router
-        // ID of the root of the tree -- that is the router we're building the routes
-        // for.  It looks for the Ipv4 interface of that node and remembers it.  So
-        // we are only actually adding routes to that one node at the root of the SPF
-        // tree.
+        // This is the method that actually adds the routes.  It uses the routing
+        // protocol of the node corresponding to the router ID of the root of the
+        // tree -- that is the router we're building the routes for -- which was
+        // looked up before the calculation.  So we are only actually adding routes
+        // to that one node at the root of the SPF tree.
         //
         // We're going to pop of a pointer to every vertex in the tree except the
         // root in order of distance from the root.  For each of the vertices, we call
@@ -1533,107 +2119,50 @@ GlobalRouteManagerImpl::SPFAddASExternal(GlobalRoutingLSA* extlsa, SPFVertex* v)
 
     NS_LOG_LOGIC("Vertex ID = " << routerId);
     //
-    // We need to walk the list of nodes looking for the one that has the router
-    // ID corresponding to the root vertex.  This is the one we're going to write
-    // the routing information to.
+    // The routing protocol of the node whose router ID is the one of the root
+    // vertex was looked up before the SPF calculation.  This is the one we're
+    // going to write the routing information to.
     //
-    for (auto i = NodeList::Begin(); i != NodeList::End(); i++)
+    if (!m_spfRouting)
     {
-        Ptr<Node> node = *i;
-        //
-        // The router ID is accessible through the GlobalRouter interface, so we need
-        // to QI for that interface.  If there's no GlobalRouter interface, the node
-        // in question cannot be the router we want, so we continue.
-        //
-        Ptr<GlobalRouter> rtr = node->GetObject<GlobalRouter>();
-
-        if (!rtr)
-        {
-            NS_LOG_LOGIC("No GlobalRouter interface on node " << node->GetId());
-            continue;
-        }
-        //
-        // If the router ID of the current node is equal to the router ID of the
-        // root of the SPF tree, then this node is the one for which we need to
-        // write the routing tables.
-        //
-        NS_LOG_LOGIC("Considering router " << rtr->GetRouterId());
-
-        if (rtr->GetRouterId() != routerId)
-        {
-            continue;
-        }
-
-        NS_LOG_LOGIC("Setting routes for node " << node->GetId());
-        //
-        // Routing information is updated using the Ipv4 interface.  We need to QI
-        // for that interface.  If the node is acting as an IP version 4 router, it
-        // should absolutely have an Ipv4 interface.
-        //
-        Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
-        NS_ASSERT_MSG(ipv4,
-                      "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                      "QI for <Ipv4> interface failed");
-        //
-        // Get the Global Router Link State Advertisement from the vertex we're
-        // adding the routes to.  The LSA will have a number of attached Global Router
-        // Link Records corresponding to links off of that vertex / node.  We're going
-        // to be interested in the records corresponding to point-to-point links.
-        //
-        NS_ASSERT_MSG(v->GetLSA(),
-                      "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                      "Expected valid LSA in SPFVertex* v");
-        Ipv4Mask tempmask = extlsa->GetNetworkLSANetworkMask();
-        Ipv4Address tempip = extlsa->GetLinkStateId();
-        tempip = tempip.CombineMask(tempmask);
+        NS_LOG_LOGIC("No node with router ID " << routerId);
+        return;
+    }
 
-        //
-        // Here's why we did all of that work.  We're going to add a host route to the
-        // host address found in the m_linkData field of the point-to-point link
-        // record.  In the case of a point-to-point link, this is the local IP address
-        // of the node connected to the link.  Each of these point-to-point links
-        // will correspond to a local interface that has an IP address to which
-        // the node at the root of the SPF tree can send packets.  The vertex <v>
-        // (corresponding to the node that has these links and interfaces) has
-        // an m_nextHop address precalculated for us that is the address to which the
-        // root node should send packets to be forwarded to these IP addresses.
-        // Similarly, the vertex <v> has an m_rootOif (outbound interface index) to
-        // which the packets should be send for forwarding.
-        //
-        Ptr<GlobalRouter> router = node->GetObject<GlobalRouter>();
-        if (!router)
+    NS_LOG_LOGIC("Setting routes for router " << routerId);
+    NS_ASSERT_MSG(v->GetLSA(),
+                  "GlobalRouteManagerImpl::SPFAddASExternal (): "
+                  "Expected valid LSA in SPFVertex* v");
+    Ipv4Mask tempmask = extlsa->GetNetworkLSANetworkMask();
+    Ipv4Address tempip = extlsa->GetLinkStateId();
+    tempip = tempip.CombineMask(tempmask);
+
+    // walk through all next-hop-IPs and out-going-interfaces for reaching
+    // the stub network gateway 'v' from the root node
+    for (uint32_t i = 0; i < v->GetNRootExitDirections(); i++)
+    {
+        SPFVertex::NodeExit_t exit = v->GetRootExitDirection(i);
+        Ipv4Address nextHop = exit.first;
+        int32_t outIf = exit.second;
+        if (outIf >= 0)
         {
-            continue;
+            m_spfRouting->AddASExternalRouteTo(tempip, tempmask, nextHop, outIf);
+            NS_LOG_LOGIC("(Route " << i << ") Router " << routerId
+                                   << " add external network route to " << tempip
+                                   << " using next hop " << nextHop << " via interface "
+                                   << outIf);
         }
-        Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol();
-        NS_ASSERT(gr);
-        // walk through all next-hop-IPs and out-going-interfaces for reaching
-        // the stub network gateway 'v' from the root node
-        for (uint32_t i = 0; i < v->GetNRootExitDirections(); i++)
+        else
         {
-            SPFVertex::NodeExit_t exit = v->GetRootExitDirection(i);
-            Ipv4Address nextHop = exit.first;
-            int32_t outIf = exit.second;
-            if (outIf >= 0)
-            {
-                gr->AddASExternalRouteTo(tempip, tempmask, nextHop, outIf);
-                NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
-                                       << " add external network route to " << tempip
-                                       << " using next hop " << nextHop << " via interface "
-                                       << outIf);
-            }
-            else
-            {
-                NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
-                                       << " NOT able to add network route to " << tempip
-                                       << " using next hop " << nextHop
-                                       << " since outgoing interface id is negative");
-            }
+            NS_LOG_LOGIC("(Route " << i << ") Router " << routerId
+                                   << " NOT able to add network route to " << tempip
+                                   << " using next hop " << nextHop
+                                   << " since outgoing interface id is negative");
         }
-        return;
-    } // for
+    }
 }
 
+// Processing logic from RFC 2328, page 166 and quagga ospf_spf_process_stubs ()
 // Processing logic from RFC 2328, page 166 and quagga ospf_spf_process_stubs ()
 // stub link records will exist for point-to-point interfaces and for
 // broadcast interfaces for which no neighboring router can be found
@@ -1690,114 +2219,52 @@ GlobalRouteManagerImpl::SPFIntraAddStub(GlobalRoutingLinkRecord* l, SPFVertex* v
     NS_LOG_LOGIC("Stub is on remote host: " << v->GetVertexId() << "; installing");
     //
     // The root of the Shortest Path First tree is the router to which we are
-    // going to write the actual routing table entries.  The vertex corresponding
-    // to this router has a vertex ID which is the router ID of that node.  We're
-    // going to use this ID to discover which node it is that we're actually going
-    // to update.
+    // going to write the actual routing table entries.  Its routing protocol was
+    // looked up before the SPF calculation.
     //
     Ipv4Address routerId = m_spfroot->GetVertexId();
 
     NS_LOG_LOGIC("Vertex ID = " << routerId);
-    //
-    // We need to walk the list of nodes looking for the one that has the router
-    // ID corresponding to the root vertex.  This is the one we're going to write
-    // the routing information to.
-    //
-    for (auto i = NodeList::Begin(); i != NodeList::End(); i++)
+    if (!m_spfRouting)
     {
-        Ptr<Node> node = *i;
-        //
-        // The router ID is accessible through the GlobalRouter interface, so we need
-        // to QI for that interface.  If there's no GlobalRouter interface, the node
-        // in question cannot be the router we want, so we continue.
-        //
-        Ptr<GlobalRouter> rtr = node->GetObject<GlobalRouter>();
+        NS_LOG_LOGIC("No node with router ID " << routerId);
+        return;
+    }
 
-        if (!rtr)
+    NS_LOG_LOGIC("Setting routes for router " << routerId);
+    NS_ASSERT_MSG(v->GetLSA(),
+                  "GlobalRouteManagerImpl::SPFIntraAddStub (): "
+                  "Expected valid LSA in SPFVertex* v");
+    Ipv4Mask tempmask(l->GetLinkData().Get());
+    Ipv4Address tempip = l->GetLinkId();
+    tempip = tempip.CombineMask(tempmask);
+
+    // walk through all next-hop-IPs and out-going-interfaces for reaching
+    // the stub network gateway 'v' from the root node
+    for (uint32_t i = 0; i < v->GetNRootExitDirections(); i++)
+    {
+        SPFVertex::NodeExit_t exit = v->GetRootExitDirection(i);
+        Ipv4Address nextHop = exit.first;
+        int32_t outIf = exit.second;
+        if (outIf >= 0)
         {
-            NS_LOG_LOGIC("No GlobalRouter interface on node " << node->GetId());
-            continue;
+            m_spfRouting->AddNetworkRouteTo(tempip, tempmask, nextHop, outIf);
+            NS_LOG_LOGIC("(Route " << i << ") Router " << routerId << " add network route to "
+                                   << tempip << " using next hop " << nextHop
+                                   << " via interface " << outIf);
         }
-        //
-        // If the router ID of the current node is equal to the router ID of the
-        // root of the SPF tree, then this node is the one for which we need to
-        // write the routing tables.
-        //
-        NS_LOG_LOGIC("Considering router " << rtr->GetRouterId());
-
-        if (rtr->GetRouterId() == routerId)
+        else
         {
-            NS_LOG_LOGIC("Setting routes for node " << node->GetId());
-            //
-            // Routing information is updated using the Ipv4 interface.  We need to QI
-            // for that interface.  If the node is acting as an IP version 4 router, it
-            // should absolutely have an Ipv4 interface.
-            //
-            Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
-            NS_ASSERT_MSG(ipv4,
-                          "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                          "QI for <Ipv4> interface failed");
-            //
-            // Get the Global Router Link State Advertisement from the vertex we're
-            // adding the routes to.  The LSA will have a number of attached Global Router
-            // Link Records corresponding to links off of that vertex / node.  We're going
-            // to be interested in the records corresponding to point-to-point links.
-            //
-            NS_ASSERT_MSG(v->GetLSA(),
-                          "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                          "Expected valid LSA in SPFVertex* v");
-            Ipv4Mask tempmask(l->GetLinkData().Get());
-            Ipv4Address tempip = l->GetLinkId();
-            tempip = tempip.CombineMask(tempmask);
-            //
-            // Here's why we did all of that work.  We're going to add a host route to the
-            // host address found in the m_linkData field of the point-to-point link
-            // record.  In the case of a point-to-point link, this is the local IP address
-            // of the node connected to the link.  Each of these point-to-point links
-            // will correspond to a local interface that has an IP address to which
-            // the node at the root of the SPF tree can send packets.  The vertex <v>
-            // (corresponding to the node that has these links and interfaces) has
-            // an m_nextHop address precalculated for us that is the address to which the
-            // root node should send packets to be forwarded to these IP addresses.
-            // Similarly, the vertex <v> has an m_rootOif (outbound interface index) to
-            // which the packets should be send for forwarding.
-            //
-
-            Ptr<GlobalRouter> router = node->GetObject<GlobalRouter>();
-            if (!router)
-            {
-                continue;
-            }
-            Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol();
-            NS_ASSERT(gr);
-            // walk through all next-hop-IPs and out-going-interfaces for reaching
-            // the stub network gateway 'v' from the root node
-            for (uint32_t i = 0; i < v->GetNRootExitDirections(); i++)
-            {
-                SPFVertex::NodeExit_t exit = v->GetRootExitDirection(i);
-                Ipv4Address nextHop = exit.first;
-                int32_t outIf = exit.second;
-                if (outIf >= 0)
-                {
-                    gr->AddNetworkRouteTo(tempip, tempmask, nextHop, outIf);
-                    NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
-                                           << " add network route to " << tempip
-                                           << " using next hop " << nextHop << " via interface "
-                                           << outIf);
-                }
-                else
-                {
-                    NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
-                                           << " NOT able to add network route to " << tempip
-                                           << " using next hop " << nextHop
-                                           << " since outgoing interface id is negative");
-                }
-            }
-            return;
-        } // if
-    }     // for
+            NS_LOG_LOGIC("(Route " << i << ") Router " << routerId
+                                   << " NOT able to add network route to " << tempip
+                                   << " using next hop " << nextHop
+                                   << " since outgoing interface id is negative");
+        }
+    }
 }
 
+//
+// Return the interface number corresponding to a given IP address and mask
 //
 // Return the interface number corresponding to a given IP address and mask
 // This is a wrapper around GetInterfaceForPrefix(), but we first
@@ -1810,67 +2277,25 @@ GlobalRouteManagerImpl::FindOutgoingInterfaceId(Ipv4Address a, Ipv4Mask amask)
 {
     NS_LOG_FUNCTION(this << a << amask);
     //
-    // We have an IP address <a> and a vertex ID of the root of the SPF tree.
-    // The question is what interface index does this address correspond to.
-    // The answer is a little complicated since we have to find a pointer to
-    // the node corresponding to the vertex ID, find the Ipv4 interface on that
-    // node in order to iterate the interfaces and find the one corresponding to
-    // the address in question.
+    // We have to find the interface of the root node, whose Ipv4 interface was
+    // looked up before the SPF calculation.
     //
-    Ipv4Address routerId = m_spfroot->GetVertexId();
-    //
-    // Walk the list of nodes in the system looking for the one corresponding to
-    // the node at the root of the SPF tree.  This is the node for which we are
-    // building the routing table.
-    //
-    for (auto i = NodeList::Begin(); i != NodeList::End(); i++)
+    if (!m_spfIpv4)
     {
-        Ptr<Node> node = *i;
-
-        Ptr<GlobalRouter> rtr = node->GetObject<GlobalRouter>();
-        //
-        // If the node doesn't have a GlobalRouter interface it can't be the one
-        // we're interested in.
-        //
-        if (!rtr)
-        {
-            continue;
-        }
-
-        if (rtr->GetRouterId() == routerId)
-        {
-            //
-            // This is the node we're building the routing table for.  We're going to need
-            // the Ipv4 interface to look for the ipv4 interface index.  Since this node
-            // is participating in routing IP version 4 packets, it certainly must have
-            // an Ipv4 interface.
-            //
-            Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
-            NS_ASSERT_MSG(ipv4,
-                          "GlobalRouteManagerImpl::FindOutgoingInterfaceId (): "
-                          "GetObject for <Ipv4> interface failed");
-            //
-            // Look through the interfaces on this node for one that has the IP address
-            // we're looking for.  If we find one, return the corresponding interface
-            // index, or -1 if not found.
-            //
-            int32_t interface = ipv4->GetInterfaceForPrefix(a, amask);
+        NS_LOG_LOGIC("FindOutgoingInterfaceId():Can't find root node "
+                     << m_spfroot->GetVertexId());
+        return -1;
+    }
+    int32_t interface = m_spfIpv4->GetInterfaceForPrefix(a, amask);
 
 #if 0
-          if (interface < 0)
-            {
-              NS_FATAL_ERROR ("GlobalRouteManagerImpl::FindOutgoingInterfaceId(): "
-                              "Expected an interface associated with address a:" << a);
-            }
-#endif
-            return interface;
-        }
+    if (interface < 0)
+    {
+        NS_FATAL_ERROR ("GlobalRouteManagerImpl::FindOutgoingInterfaceId(): "
+                        "Expected an interface associated with address a:" << a);
     }
-    //
-    // Couldn't find it.
-    //
-    NS_LOG_LOGIC("FindOutgoingInterfaceId():Can't find root node " << routerId);
-    return -1;
+#endif
+    return interface;
 }
 
 //
@@ -1897,138 +2322,88 @@ GlobalRouteManagerImpl::SPFIntraAddRouter(SPFVertex* v)
     NS_ASSERT_MSG(m_spfroot, "GlobalRouteManagerImpl::SPFIntraAddRouter (): Root pointer not set");
     //
     // The root of the Shortest Path First tree is the router to which we are
-    // going to write the actual routing table entries.  The vertex corresponding
-    // to this router has a vertex ID which is the router ID of that node.  We're
-    // going to use this ID to discover which node it is that we're actually going
-    // to update.
+    // going to write the actual routing table entries.  The routing protocol of
+    // the node whose router ID is the vertex ID of the root was looked up before
+    // the SPF calculation.
     //
     Ipv4Address routerId = m_spfroot->GetVertexId();
 
     NS_LOG_LOGIC("Vertex ID = " << routerId);
+    if (!m_spfRouting)
+    {
+        NS_LOG_LOGIC("No node with router ID " << routerId);
+        return;
+    }
+
+    NS_LOG_LOGIC("Setting routes for router " << routerId);
     //
-    // We need to walk the list of nodes looking for the one that has the router
-    // ID corresponding to the root vertex.  This is the one we're going to write
-    // the routing information to.
+    // Get the Global Router Link State Advertisement from the vertex we're
+    // adding the routes to.  The LSA will have a number of attached Global Router
+    // Link Records corresponding to links off of that vertex / node.  We're going
+    // to be interested in the records corresponding to point-to-point links.
     //
-    for (auto i = NodeList::Begin(); i != NodeList::End(); i++)
-    {
-        Ptr<Node> node = *i;
-        //
-        // The router ID is accessible through the GlobalRouter interface, so we need
-        // to GetObject for that interface.  If there's no GlobalRouter interface,
-        // the node in question cannot be the router we want, so we continue.
-        //
-        Ptr<GlobalRouter> rtr = node->GetObject<GlobalRouter>();
+    GlobalRoutingLSA* lsa = v->GetLSA();
+    NS_ASSERT_MSG(lsa,
+                  "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
+                  "Expected valid LSA in SPFVertex* v");
 
-        if (!rtr)
-        {
-            NS_LOG_LOGIC("No GlobalRouter interface on node " << node->GetId());
-            continue;
-        }
+    uint32_t nLinkRecords = lsa->GetNLinkRecords();
+    //
+    // Iterate through the link records on the vertex to which we're going to add
+    // routes.  To make sure we're being clear, we're going to add routing table
+    // entries to the tables on the node corresponding to the root of the SPF tree.
+    // These entries will have routes to the IP addresses we find from looking at
+    // the local side of the point-to-point links found on the node described by
+    // the vertex <v>.
+    //
+    NS_LOG_LOGIC(" Router " << routerId << " found " << nLinkRecords << " link records in LSA "
+                            << lsa << "with LinkStateId " << lsa->GetLinkStateId());
+    for (uint32_t j = 0; j < nLinkRecords; ++j)
+    {
         //
-        // If the router ID of the current node is equal to the router ID of the
-        // root of the SPF tree, then this node is the one for which we need to
-        // write the routing tables.
+        // We are only concerned about point-to-point links
         //
-        NS_LOG_LOGIC("Considering router " << rtr->GetRouterId());
-
-        if (rtr->GetRouterId() != routerId)
+        GlobalRoutingLinkRecord* lr = lsa->GetLinkRecord(j);
+        if (lr->GetLinkType() != GlobalRoutingLinkRecord::PointToPoint)
         {
             continue;
         }
-
-        NS_LOG_LOGIC("Setting routes for node " << node->GetId());
         //
-        // Routing information is updated using the Ipv4 interface.  We need to
-        // GetObject for that interface.  If the node is acting as an IP version 4
-        // router, it should absolutely have an Ipv4 interface.
-        //
-        Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
-        NS_ASSERT_MSG(ipv4,
-                      "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                      "GetObject for <Ipv4> interface failed");
-        //
-        // Get the Global Router Link State Advertisement from the vertex we're
-        // adding the routes to.  The LSA will have a number of attached Global Router
-        // Link Records corresponding to links off of that vertex / node.  We're going
-        // to be interested in the records corresponding to point-to-point links.
-        //
-        GlobalRoutingLSA* lsa = v->GetLSA();
-        NS_ASSERT_MSG(lsa,
-                      "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                      "Expected valid LSA in SPFVertex* v");
-
-        uint32_t nLinkRecords = lsa->GetNLinkRecords();
-        //
-        // Iterate through the link records on the vertex to which we're going to add
-        // routes.  To make sure we're being clear, we're going to add routing table
-        // entries to the tables on the node corresponding to the root of the SPF tree.
-        // These entries will have routes to the IP addresses we find from looking at
-        // the local side of the point-to-point links found on the node described by
-        // the vertex <v>.
+        // Here's why we did all of that work.  We're going to add a host route to the
+        // host address found in the m_linkData field of the point-to-point link
+        // record.  In the case of a point-to-point link, this is the local IP address
+        // of the node connected to the link.  Each of these point-to-point links
+        // will correspond to a local interface that has an IP address to which
+        // the node at the root of the SPF tree can send packets.  The vertex <v>
+        // (corresponding to the node that has these links and interfaces) has
+        // an m_nextHop address precalculated for us that is the address to which the
+        // root node should send packets to be forwarded to these IP addresses.
+        // Similarly, the vertex <v> has an m_rootOif (outbound interface index) to
+        // which the packets should be send for forwarding.
         //
-        NS_LOG_LOGIC(" Node " << node->GetId() << " found " << nLinkRecords
-                              << " link records in LSA " << lsa << "with LinkStateId "
-                              << lsa->GetLinkStateId());
-        for (uint32_t j = 0; j < nLinkRecords; ++j)
+        // walk through all available exit directions due to ECMP,
+        // and add host route for each of the exit direction toward
+        // the vertex 'v'
+        for (uint32_t i = 0; i < v->GetNRootExitDirections(); i++)
         {
-            //
-            // We are only concerned about point-to-point links
-            //
-            GlobalRoutingLinkRecord* lr = lsa->GetLinkRecord(j);
-            if (lr->GetLinkType() != GlobalRoutingLinkRecord::PointToPoint)
+            SPFVertex::NodeExit_t exit = v->GetRootExitDirection(i);
+            Ipv4Address nextHop = exit.first;
+            int32_t outIf = exit.second;
+            if (outIf >= 0)
             {
-                continue;
+                m_spfRouting->AddHostRouteTo(lr->GetLinkData(), nextHop, outIf);
+                NS_LOG_LOGIC("(Route " << i << ") Router " << routerId << " adding host route to "
+                                       << lr->GetLinkData() << " using next hop " << nextHop
+                                       << " and outgoing interface " << outIf);
             }
-            //
-            // Here's why we did all of that work.  We're going to add a host route to the
-            // host address found in the m_linkData field of the point-to-point link
-            // record.  In the case of a point-to-point link, this is the local IP address
-            // of the node connected to the link.  Each of these point-to-point links
-            // will correspond to a local interface that has an IP address to which
-            // the node at the root of the SPF tree can send packets.  The vertex <v>
-            // (corresponding to the node that has these links and interfaces) has
-            // an m_nextHop address precalculated for us that is the address to which the
-            // root node should send packets to be forwarded to these IP addresses.
-            // Similarly, the vertex <v> has an m_rootOif (outbound interface index) to
-            // which the packets should be send for forwarding.
-            //
-            Ptr<GlobalRouter> router = node->GetObject<GlobalRouter>();
-            if (!router)
+            else
             {
-                continue;
+                NS_LOG_LOGIC("(Route " << i << ") Router " << routerId
+                                       << " NOT able to add host route to " << lr->GetLinkData()
+                                       << " using next hop " << nextHop
+                                       << " since outgoing interface id is negative " << outIf);
             }
-            Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol();
-            NS_ASSERT(gr);
-            // walk through all available exit directions due to ECMP,
-            // and add host route for each of the exit direction toward
-            // the vertex 'v'
-            for (uint32_t i = 0; i < v->GetNRootExitDirections(); i++)
-            {
-                SPFVertex::NodeExit_t exit = v->GetRootExitDirection(i);
-                Ipv4Address nextHop = exit.first;
-                int32_t outIf = exit.second;
-                if (outIf >= 0)
-                {
-                    gr->AddHostRouteTo(lr->GetLinkData(), nextHop, outIf);
-                    NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
-                                           << " adding host route to " << lr->GetLinkData()
-                                           << " using next hop " << nextHop
-                                           << " and outgoing interface " << outIf);
-                }
-                else
-                {
-                    NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
-                                           << " NOT able to add host route to " << lr->GetLinkData()
-                                           << " using next hop " << nextHop
-                                           << " since outgoing interface id is negative " << outIf);
-                }
-            } // for all routes from the root the vertex 'v'
-        }
-        //
-        // Done adding the routes for the selected node.
-        //
-        return;
+        } // for all routes from the root the vertex 'v'
     }
 }
 
@@ -2040,102 +2415,56 @@ GlobalRouteManagerImpl::SPFIntraAddTransit(SPFVertex* v)
     NS_ASSERT_MSG(m_spfroot, "GlobalRouteManagerImpl::SPFIntraAddTransit (): Root pointer not set");
     //
     // The root of the Shortest Path First tree is the router to which we are
-    // going to write the actual routing table entries.  The vertex corresponding
-    // to this router has a vertex ID which is the router ID of that node.  We're
-    // going to use this ID to discover which node it is that we're actually going
-    // to update.
+    // going to write the actual routing table entries.  Its routing protocol was
+    // looked up before the SPF calculation.
     //
     Ipv4Address routerId = m_spfroot->GetVertexId();
 
     NS_LOG_LOGIC("Vertex ID = " << routerId);
+    if (!m_spfRouting)
+    {
+        NS_LOG_LOGIC("No node with router ID " << routerId);
+        return;
+    }
+
+    NS_LOG_LOGIC("setting routes for router " << routerId);
     //
-    // We need to walk the list of nodes looking for the one that has the router
-    // ID corresponding to the root vertex.  This is the one we're going to write
-    // the routing information to.
+    // Get the Global Router Link State Advertisement from the vertex we're
+    // adding the routes to.  The LSA will have a number of attached Global Router
+    // Link Records corresponding to links off of that vertex / node.  We're going
+    // to be interested in the records corresponding to point-to-point links.
     //
-    for (auto i = NodeList::Begin(); i != NodeList::End(); i++)
+    GlobalRoutingLSA* lsa = v->GetLSA();
+    NS_ASSERT_MSG(lsa,
+                  "GlobalRouteManagerImpl::SPFIntraAddTransit (): "
+                  "Expected valid LSA in SPFVertex* v");
+    Ipv4Mask tempmask = lsa->GetNetworkLSANetworkMask();
+    Ipv4Address tempip = lsa->GetLinkStateId();
+    tempip = tempip.CombineMask(tempmask);
+    for (uint32_t i = 0; i < v->GetNRootExitDirections(); i++)
     {
-        Ptr<Node> node = *i;
-        //
-        // The router ID is accessible through the GlobalRouter interface, so we need
-        // to GetObject for that interface.  If there's no GlobalRouter interface,
-        // the node in question cannot be the router we want, so we continue.
-        //
-        Ptr<GlobalRouter> rtr = node->GetObject<GlobalRouter>();
+        SPFVertex::NodeExit_t exit = v->GetRootExitDirection(i);
+        Ipv4Address nextHop = exit.first;
+        int32_t outIf = exit.second;
 
-        if (!rtr)
+        if (outIf >= 0)
         {
-            NS_LOG_LOGIC("No GlobalRouter interface on node " << node->GetId());
-            continue;
+            m_spfRouting->AddNetworkRouteTo(tempip, tempmask, nextHop, outIf);
+            NS_LOG_LOGIC("(Route " << i << ") Router " << routerId << " add network route to "
+                                   << tempip << " using next hop " << nextHop
+                                   << " via interface " << outIf);
         }
-        //
-        // If the router ID of the current node is equal to the router ID of the
-        // root of the SPF tree, then this node is the one for which we need to
-        // write the routing tables.
-        //
-        NS_LOG_LOGIC("Considering router " << rtr->GetRouterId());
-
-        if (rtr->GetRouterId() == routerId)
+        else
         {
-            NS_LOG_LOGIC("setting routes for node " << node->GetId());
-            //
-            // Routing information is updated using the Ipv4 interface.  We need to
-            // GetObject for that interface.  If the node is acting as an IP version 4
-            // router, it should absolutely have an Ipv4 interface.
-            //
-            Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
-            NS_ASSERT_MSG(ipv4,
-                          "GlobalRouteManagerImpl::SPFIntraAddTransit (): "
-                          "GetObject for <Ipv4> interface failed");
-            //
-            // Get the Global Router Link State Advertisement from the vertex we're
-            // adding the routes to.  The LSA will have a number of attached Global Router
-            // Link Records corresponding to links off of that vertex / node.  We're going
-            // to be interested in the records corresponding to point-to-point links.
-            //
-            GlobalRoutingLSA* lsa = v->GetLSA();
-            NS_ASSERT_MSG(lsa,
-                          "GlobalRouteManagerImpl::SPFIntraAddTransit (): "
-                          "Expected valid LSA in SPFVertex* v");
-            Ipv4Mask tempmask = lsa->GetNetworkLSANetworkMask();
-            Ipv4Address tempip = lsa->GetLinkStateId();
-            tempip = tempip.CombineMask(tempmask);
-            Ptr<GlobalRouter> router = node->GetObject<GlobalRouter>();
-            if (!router)
-            {
-                continue;
-            }
-            Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol();
-            NS_ASSERT(gr);
-            // walk through all available exit directions due to ECMP,
-            // and add host route for each of the exit direction toward
-            // the vertex 'v'
-            for (uint32_t i = 0; i < v->GetNRootExitDirections(); i++)
-            {
-                SPFVertex::NodeExit_t exit = v->GetRootExitDirection(i);
-                Ipv4Address nextHop = exit.first;
-                int32_t outIf = exit.second;
-
-                if (outIf >= 0)
-                {
-                    gr->AddNetworkRouteTo(tempip, tempmask, nextHop, outIf);
-                    NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
-                                           << " add network route to " << tempip
-                                           << " using next hop " << nextHop << " via interface "
-                                           << outIf);
-                }
-                else
-                {
-                    NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
-                                           << " NOT able to add network route to " << tempip
-                                           << " using next hop " << nextHop
-                                           << " since outgoing interface id is negative " << outIf);
-                }
-            }
+            NS_LOG_LOGIC("(Route " << i << ") Router " << routerId
+                                   << " NOT able to add network route to " << tempip
+                                   << " using next hop " << nextHop
+                                   << " since outgoing interface id is negative " << outIf);
         }
     }
 }
 
+// Derived from quagga ospf_vertex_add_parents ()
 // Derived from quagga ospf_vertex_add_parents ()
 //
 // This is a somewhat oddly named method (blame quagga).  Although you might
@@ -19,7 +19,9 @@
 #include <list>
 #include <map>
 #include <queue>
+#include <set>
 #include <stdint.h>
+#include <unordered_map>
 #include <vector>
 
 namespace ns3
@@ -28,7 +30,9 @@ namespace ns3
 const uint32_t SPF_INFINITY = 0xffffffff; //!< "infinite" distance between nodes
 
 class CandidateQueue;
+class Ipv4;
 class Ipv4GlobalRouting;
+class Node;
 
 /**
  * @ingroup globalrouting
@@ -628,6 +632,35 @@ class GlobalRouteManagerLSDB
      */
     GlobalRoutingLSA* GetLSAByLinkData(Ipv4Address addr) const;
 
+    /**
+     * @brief Get the number of (non external) Link State Advertisements.
+     *
+     * @returns the number of Link State Advertisements.
+     */
+    uint32_t GetNumLSAs() const;
+
+    /**
+     * @brief Look up a Link State Advertisement by its index.
+     *
+     * The Link State Advertisements are numbered from 0 in their insertion
+     * order, so that the SPF computation can keep its per-LSA state in
+     * vectors.
+     *
+     * @param index the index of the LSA, lower than GetNumLSAs ()
+     * @returns A pointer to the Link State Advertisement.
+     */
+    GlobalRoutingLSA* GetLSAByIndex(uint32_t index) const;
+
+    /**
+     * @brief Get the index of the Link State Advertisement associated with the
+     * given link state ID (address).
+     *
+     * @see GetLSAByIndex
+     * @param addr The IP address associated with the LSA.
+     * @returns the index of the LSA, or GetNumLSAs () if there is none.
+     */
+    uint32_t GetLSAIndex(Ipv4Address addr) const;
+
     /**
      * @brief Set all LSA flags to an initialized state, for SPF computation
      *
@@ -662,12 +695,13 @@ class GlobalRouteManagerLSDB
     uint32_t GetNumExtLSAs() const;
 
   private:
-    typedef std::map<Ipv4Address, GlobalRoutingLSA*>
-        LSDBMap_t; //!< container of IPv4 addresses / Link State Advertisements
-    typedef std::pair<Ipv4Address, GlobalRoutingLSA*>
-        LSDBPair_t; //!< pair of IPv4 addresses / Link State Advertisements
+    typedef std::unordered_map<Ipv4Address, uint32_t, Ipv4AddressHash>
+        LSDBMap_t; //!< container of IPv4 addresses / Link State Advertisement indexes
 
-    LSDBMap_t m_database; //!< database of IPv4 addresses / Link State Advertisements
+    std::vector<GlobalRoutingLSA*> m_database; //!< database of Link State Advertisements
+    LSDBMap_t m_index; //!< indexes of the Link State Advertisements, by link state ID
+    std::unordered_map<Ipv4Address, GlobalRoutingLSA*, Ipv4AddressHash>
+        m_linkDataIndex; //!< router LSAs, by LinkData of their TransitNetwork link records
     std::vector<GlobalRoutingLSA*>
         m_extdatabase; //!< database of External Link State Advertisements
 };
@@ -682,6 +716,16 @@ class GlobalRouteManagerLSDB
  * and finally configure each of the node's forwarding tables.
  *
  * The design is guided by OSPFv2 \RFC{2328} section 16.1.1 and quagga ospfd.
+ *
+ * The shortest path trees rooted at the different routers are independent
+ * calculations over the same Link State Database: they can be run by a pool
+ * of threads (see the GlobalRoutingSpfThreads global value), each thread
+ * writing only to the routing tables of the routers it computes the tree of.
+ * The SPF jobs refer to the routing objects of their root by raw pointers,
+ * so that the threads do not update the reference counts of shared objects,
+ * and the calculations run on the calling thread when logging is enabled.
+ * The distances computed by each tree are kept, so that UpdateGlobalRoutes ()
+ * only recomputes the trees that a change of the Link State Database affects.
  */
 class GlobalRouteManagerImpl
 {
@@ -714,6 +758,19 @@ class GlobalRouteManagerImpl
      */
     virtual void InitializeRoutes();
 
+    /**
+     * @brief Rebuild the routing database and update the routes of the routers
+     * affected by the changes of their Link State Advertisements.
+     *
+     * This is equivalent to DeleteGlobalRoutes (), BuildGlobalRoutingDatabase ()
+     * and InitializeRoutes (), except that the routes of a router are left
+     * untouched when the changed LSAs can not change its shortest path tree nor
+     * the addresses it has routes to.  All the routes are recomputed when the
+     * set of LSAs itself changes (a router or a transit network appears or
+     * disappears, or an external LSA changes).
+     */
+    virtual void UpdateGlobalRoutes();
+
     /**
      * @brief Debugging routine; allow client code to supply a pre-built LSDB
      * @param lsdb the pre-built LSDB
@@ -727,8 +784,107 @@ class GlobalRouteManagerImpl
     void DebugSPFCalculate(Ipv4Address root);
 
   private:
-    SPFVertex* m_spfroot;           //!< the root node
-    GlobalRouteManagerLSDB* m_lsdb; //!< the Link State DataBase (LSDB) of the Global Route Manager
+    /**
+     * @brief The distances computed by the SPF calculation rooted at a router.
+     */
+    struct SPFResult
+    {
+        std::vector<uint32_t> distance;     //!< distance from the root, by LSA index
+        std::vector<uint32_t> rootNetworks; //!< indexes of the networks adjacent to the root
+    };
+
+    /**
+     * @brief An SPF calculation to run.
+     */
+    struct SPFJob
+    {
+        Ipv4Address root;                    //!< the router ID of the root
+        Ipv4GlobalRouting* routing{nullptr}; //!< the routing protocol of the root
+        Ipv4* ipv4{nullptr};                 //!< the IPv4 stack of the root
+        SPFResult result;                    //!< the result of the calculation
+    };
+
+    /**
+     * @brief Construct a worker running SPF calculations over the LSDB of
+     * another manager.
+     * @param lsdb the LSDB, which is read but not owned by the worker
+     */
+    explicit GlobalRouteManagerImpl(GlobalRouteManagerLSDB* lsdb);
+
+    /**
+     * @brief Prepare the SPF calculation rooted at a node.
+     * @param node the node
+     * @param rtr the GlobalRouter of the node
+     * @returns the SPF job
+     */
+    static SPFJob MakeSPFJob(Ptr<Node> node, Ptr<GlobalRouter> rtr);
+
+    /**
+     * @brief Run SPF calculations, on several threads if configured to and if
+     * logging is disabled, and store their results.
+     * @param jobs the SPF jobs
+     */
+    void RunSPFJobs(std::vector<SPFJob>& jobs);
+
+    /**
+     * @returns true if a log component is enabled, in which case the SPF
+     * calculations must not run on several threads, since logging is not
+     * thread safe
+     */
+    static bool IsLoggingEnabled();
+
+    /**
+     * @brief Run an SPF calculation on the calling thread.
+     * @param job the SPF job
+     */
+    void RunSPFJob(SPFJob& job);
+
+    /**
+     * @brief Find the routers whose routes may change from the previous LSDB
+     * to the current one.
+     * @param previous the previous LSDB, from which the stored SPF results were
+     * computed
+     * @param roots the router IDs of the affected routers
+     * @returns false if the routes of all the routers must be recomputed
+     */
+    bool FindAffectedRoots(const GlobalRouteManagerLSDB* previous,
+                           std::set<Ipv4Address>& roots) const;
+
+    /**
+     * @brief Delete all the routes of a routing protocol.
+     * @param gr the routing protocol
+     */
+    static void DeleteRoutes(Ptr<Ipv4GlobalRouting> gr);
+
+    /**
+     * @brief Store the distance of a vertex added to the SPF tree in the result
+     * of the calculation.
+     * @param v the vertex
+     */
+    void RecordSPFVertex(SPFVertex* v);
+
+    /**
+     * @param lsa an LSA of the LSDB
+     * @returns the status of the LSA in the current SPF calculation
+     */
+    GlobalRoutingLSA::SPFStatus GetLSAStatus(GlobalRoutingLSA* lsa) const;
+
+    /**
+     * @brief Set the status of an LSA in the current SPF calculation.
+     * @param lsa an LSA of the LSDB
+     * @param status the status
+     */
+    void SetLSAStatus(GlobalRoutingLSA* lsa, GlobalRoutingLSA::SPFStatus status);
+
+    SPFVertex* m_spfroot;            //!< the root node
+    GlobalRouteManagerLSDB* m_lsdb;  //!< the Link State DataBase (LSDB)
+    bool m_ownsLsdb;                 //!< whether the LSDB is deleted with this object
+    Ipv4GlobalRouting* m_spfRouting; //!< the routing protocol of the root node
+    Ipv4* m_spfIpv4;                 //!< the IPv4 stack of the root node
+    SPFResult* m_spfResult;          //!< where to store the result of the calculation
+    std::vector<GlobalRoutingLSA::SPFStatus>
+        m_lsaStatus; //!< status of the LSAs in the current SPF calculation, by index
+    std::map<Ipv4Address, SPFResult> m_spfResults; //!< SPF results, by router ID of the root
 
     /**
      * @brief Test if a node is a stub, from an OSPF sense.
@@ -59,6 +59,16 @@ class GlobalRouteManager
      * per-node forwarding tables
      */
     static void InitializeRoutes();
+
+    /**
+     * @brief Rebuild the routing database and recompute the routes of the
+     * nodes affected by its changes
+     *
+     * This has the effect of DeleteGlobalRoutes (), BuildGlobalRoutingDatabase ()
+     * and InitializeRoutes (), but leaves the routes of the nodes whose shortest
+     * path tree can not change as they are.
+     */
+    static void UpdateGlobalRoutes();
 };
 
 } // namespace ns3
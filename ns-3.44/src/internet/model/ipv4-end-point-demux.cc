@@ -13,11 +13,47 @@
 
 #include "ns3/log.h"
 
+#include <algorithm>
+
 namespace ns3
 {
 
 NS_LOG_COMPONENT_DEFINE("Ipv4EndPointDemux");
 
+namespace
+{
+
+/**
+ * @brief Remove an endpoint from a bucket of an index, and the bucket if it becomes empty.
+ * @tparam Index \deduced the index type
+ * @param index the index
+ * @param key the key of the bucket
+ * @param endPoint the endpoint
+ */
+template <typename Index>
+void
+RemoveFromBucket(Index& index, const typename Index::key_type& key, Ipv4EndPoint* endPoint)
+{
+    auto it = index.find(key);
+    NS_ASSERT_MSG(it != index.end(), "Endpoint " << endPoint << " is not indexed");
+    auto& bucket = it->second;
+    bucket.erase(std::find(bucket.begin(), bucket.end(), endPoint));
+    if (bucket.empty())
+    {
+        index.erase(it);
+    }
+}
+
+} // namespace
+
+std::size_t
+Ipv4EndPointDemux::KeyHash::operator()(const Key& key) const
+{
+    uint64_t local = (static_cast<uint64_t>(key.localAddress.Get()) << 16) | key.localPort;
+    uint64_t peer = (static_cast<uint64_t>(key.peerAddress.Get()) << 16) | key.peerPort;
+    return std::hash<uint64_t>()((local * 0x9e3779b97f4a7c15ULL) ^ peer);
+}
+
 Ipv4EndPointDemux::Ipv4EndPointDemux()
     : m_ephemeral(49152),
       m_portLast(65535),
@@ -32,33 +68,33 @@ Ipv4EndPointDemux::~Ipv4EndPointDemux()
     for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
     {
         Ipv4EndPoint* endPoint = *i;
+        endPoint->m_demux = nullptr;
         delete endPoint;
     }
     m_endPoints.clear();
+    m_index.clear();
+    m_ports.clear();
 }
 
 bool
 Ipv4EndPointDemux::LookupPortLocal(uint16_t port)
 {
     NS_LOG_FUNCTION(this << port);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
-    {
-        if ((*i)->GetLocalPort() == port)
-        {
-            return true;
-        }
-    }
-    return false;
+    return m_ports.find(port) != m_ports.end();
 }
 
 bool
 Ipv4EndPointDemux::LookupLocal(Ptr<NetDevice> boundNetDevice, Ipv4Address addr, uint16_t port)
 {
     NS_LOG_FUNCTION(this << addr << port);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto it = m_ports.find(port);
+    if (it == m_ports.end())
     {
-        if ((*i)->GetLocalPort() == port && (*i)->GetLocalAddress() == addr &&
-            (*i)->GetBoundNetDevice() == boundNetDevice)
+        return false;
+    }
+    for (auto endPoint : it->second)
+    {
+        if (endPoint->GetLocalAddress() == addr && endPoint->GetBoundNetDevice() == boundNetDevice)
         {
             return true;
         }
@@ -66,6 +102,40 @@ Ipv4EndPointDemux::LookupLocal(Ptr<NetDevice> boundNetDevice, Ipv4Address addr,
     return false;
 }
 
+Ipv4EndPoint*
+Ipv4EndPointDemux::Insert(Ipv4EndPoint* endPoint)
+{
+    NS_LOG_FUNCTION(this << endPoint);
+    m_endPoints.push_back(endPoint);
+    m_ports[endPoint->GetLocalPort()].push_back(endPoint);
+    Index(endPoint);
+    endPoint->m_demux = this;
+    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
+    return endPoint;
+}
+
+void
+Ipv4EndPointDemux::Index(Ipv4EndPoint* endPoint)
+{
+    NS_LOG_FUNCTION(this << endPoint);
+    Key key{endPoint->GetLocalAddress(),
+            endPoint->GetLocalPort(),
+            endPoint->GetPeerAddress(),
+            endPoint->GetPeerPort()};
+    m_index[key].push_back(endPoint);
+}
+
+void
+Ipv4EndPointDemux::Unindex(Ipv4EndPoint* endPoint)
+{
+    NS_LOG_FUNCTION(this << endPoint);
+    Key key{endPoint->GetLocalAddress(),
+            endPoint->GetLocalPort(),
+            endPoint->GetPeerAddress(),
+            endPoint->GetPeerPort()};
+    RemoveFromBucket(m_index, key, endPoint);
+}
+
 Ipv4EndPoint*
 Ipv4EndPointDemux::Allocate()
 {
@@ -76,10 +146,7 @@ Ipv4EndPointDemux::Allocate()
         NS_LOG_WARN("Ephemeral port allocation failed.");
         return nullptr;
     }
-    auto endPoint = new Ipv4EndPoint(Ipv4Address::GetAny(), port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
-    return endPoint;
+    return Insert(new Ipv4EndPoint(Ipv4Address::GetAny(), port));
 }
 
 Ipv4EndPoint*
@@ -92,10 +159,7 @@ Ipv4EndPointDemux::Allocate(Ipv4Address address)
         NS_LOG_WARN("Ephemeral port allocation failed.");
         return nullptr;
     }
-    auto endPoint = new Ipv4EndPoint(address, port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
-    return endPoint;
+    return Insert(new Ipv4EndPoint(address, port));
 }
 
 Ipv4EndPoint*
@@ -115,10 +179,7 @@ Ipv4EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice, Ipv4Address address,
         NS_LOG_WARN("Duplicated endpoint.");
         return nullptr;
     }
-    auto endPoint = new Ipv4EndPoint(address, port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
-    return endPoint;
+    return Insert(new Ipv4EndPoint(address, port));
 }
 
 Ipv4EndPoint*
@@ -129,23 +190,21 @@ Ipv4EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice,
                             uint16_t peerPort)
 {
     NS_LOG_FUNCTION(this << localAddress << localPort << peerAddress << peerPort << boundNetDevice);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto it = m_index.find(Key{localAddress, localPort, peerAddress, peerPort});
+    if (it != m_index.end())
     {
-        if ((*i)->GetLocalPort() == localPort && (*i)->GetLocalAddress() == localAddress &&
-            (*i)->GetPeerPort() == peerPort && (*i)->GetPeerAddress() == peerAddress &&
-            ((*i)->GetBoundNetDevice() == boundNetDevice || !(*i)->GetBoundNetDevice()))
+        for (auto endPoint : it->second)
         {
-            NS_LOG_WARN("Duplicated endpoint.");
-            return nullptr;
+            if (endPoint->GetBoundNetDevice() == boundNetDevice || !endPoint->GetBoundNetDevice())
+            {
+                NS_LOG_WARN("Duplicated endpoint.");
+                return nullptr;
+            }
         }
     }
     auto endPoint = new Ipv4EndPoint(localAddress, localPort);
     endPoint->SetPeer(peerAddress, peerPort);
-    m_endPoints.push_back(endPoint);
-
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
-
-    return endPoint;
+    return Insert(endPoint);
 }
 
 void
@@ -156,6 +215,9 @@ Ipv4EndPointDemux::DeAllocate(Ipv4EndPoint* endPoint)
     {
         if (*i == endPoint)
         {
+            Unindex(endPoint);
+            RemoveFromBucket(m_ports, endPoint->GetLocalPort(), endPoint);
+            endPoint->m_demux = nullptr;
             delete endPoint;
             m_endPoints.erase(i);
             break;
@@ -180,30 +242,18 @@ Ipv4EndPointDemux::GetAllEndPoints()
     return ret;
 }
 
-/*
- * If we have an exact match, we return it.
- * Otherwise, if we find a generic match, we return it.
- * Otherwise, we return 0.
- */
-Ipv4EndPointDemux::EndPoints
-Ipv4EndPointDemux::Lookup(Ipv4Address daddr,
-                          uint16_t dport,
-                          Ipv4Address saddr,
-                          uint16_t sport,
-                          Ptr<Ipv4Interface> incomingInterface)
+void
+Ipv4EndPointDemux::Collect(const Key& key,
+                           Ptr<Ipv4Interface> incomingInterface,
+                           EndPoints& endPoints) const
 {
-    NS_LOG_FUNCTION(this << daddr << dport << saddr << sport << incomingInterface);
-
-    EndPoints retval1; // Matches exact on local port, wildcards on others
-    EndPoints retval2; // Matches exact on local port/adder, wildcards on others
-    EndPoints retval3; // Matches all but local address
-    EndPoints retval4; // Exact match on all 4
-
-    NS_LOG_DEBUG("Looking up endpoint for destination address " << daddr << ":" << dport);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto it = m_index.find(key);
+    if (it == m_index.end())
+    {
+        return;
+    }
+    for (auto endP : it->second)
     {
-        Ipv4EndPoint* endP = *i;
-
         NS_LOG_DEBUG("Looking at endpoint dport="
                      << endP->GetLocalPort() << " daddr=" << endP->GetLocalAddress()
                      << " sport=" << endP->GetPeerPort() << " saddr=" << endP->GetPeerAddress());
@@ -214,14 +264,6 @@ Ipv4EndPointDemux::Lookup(Ipv4Address daddr,
                                               << " because endpoint can not receive packets");
             continue;
         }
-
-        if (endP->GetLocalPort() != dport)
-        {
-            NS_LOG_LOGIC("Skipping endpoint " << &endP << " because endpoint dport "
-                                              << endP->GetLocalPort()
-                                              << " does not match packet dport " << dport);
-            continue;
-        }
         if (endP->GetBoundNetDevice())
         {
             if (endP->GetBoundNetDevice() != incomingInterface->GetDevice())
@@ -233,118 +275,81 @@ Ipv4EndPointDemux::Lookup(Ipv4Address daddr,
                 continue;
             }
         }
+        endPoints.push_back(endP);
+    }
+}
 
-        bool localAddressMatchesExact = false;
-        bool localAddressIsAny = false;
-        bool localAddressIsSubnetAny = false;
+/*
+ * If we have an exact match, we return it.
+ * Otherwise, if we find a generic match, we return it.
+ * Otherwise, we return 0.
+ */
+Ipv4EndPointDemux::EndPoints
+Ipv4EndPointDemux::Lookup(Ipv4Address daddr,
+                          uint16_t dport,
+                          Ipv4Address saddr,
+                          uint16_t sport,
+                          Ptr<Ipv4Interface> incomingInterface)
+{
+    NS_LOG_FUNCTION(this << daddr << dport << saddr << sport << incomingInterface);
 
-        // We have 3 cases:
-        // 1) Exact local / destination address match
-        // 2) Local endpoint bound to Any -> matches anything
-        // 3) Local endpoint bound to x.y.z.0 -> matches Subnet-directed broadcast packet (e.g.,
-        // x.y.z.255 in a /24 net) and direct destination match.
+    EndPoints retval;
 
-        if (endP->GetLocalAddress() == daddr)
-        {
-            // Case 1:
-            localAddressMatchesExact = true;
-        }
-        else if (endP->GetLocalAddress() == Ipv4Address::GetAny())
-        {
-            // Case 2:
-            localAddressIsAny = true;
-        }
-        else
-        {
-            // Case 3:
-            for (uint32_t i = 0; i < incomingInterface->GetNAddresses(); i++)
-            {
-                Ipv4InterfaceAddress addr = incomingInterface->GetAddress(i);
-
-                Ipv4Address addrNetpart = addr.GetLocal().CombineMask(addr.GetMask());
-                if (endP->GetLocalAddress() == addrNetpart)
-                {
-                    NS_LOG_LOGIC("Endpoint is SubnetDirectedAny "
-                                 << endP->GetLocalAddress() << "/"
-                                 << addr.GetMask().GetPrefixLength());
-
-                    Ipv4Address daddrNetPart = daddr.CombineMask(addr.GetMask());
-                    if (addrNetpart == daddrNetPart)
-                    {
-                        localAddressIsSubnetAny = true;
-                    }
-                }
-            }
+    NS_LOG_DEBUG("Looking up endpoint for destination address " << daddr << ":" << dport);
 
-            // if no match here, keep looking
-            if (!localAddressIsSubnetAny)
-            {
-                continue;
-            }
-        }
+    // All 4 match - this is the case of an open TCP connection, for example.
+    Collect(Key{daddr, dport, saddr, sport}, incomingInterface, retval);
+    if (!retval.empty())
+    {
+        NS_LOG_LOGIC("Found an endpoint for case 4");
+        return retval;
+    }
 
-        bool remotePortMatchesExact = endP->GetPeerPort() == sport;
-        bool remotePortMatchesWildCard = endP->GetPeerPort() == 0;
-        bool remoteAddressMatchesExact = endP->GetPeerAddress() == saddr;
-        bool remoteAddressMatchesWildCard = endP->GetPeerAddress() == Ipv4Address::GetAny();
+    // The local address of the endpoints matching all but the local address
+    // is a wildcard. We have 2 cases:
+    // 1) Local endpoint bound to Any -> matches anything
+    // 2) Local endpoint bound to x.y.z.0 -> matches Subnet-directed broadcast packet (e.g.,
+    // x.y.z.255 in a /24 net) and direct destination match.
+    std::vector<Ipv4Address> wildcards{Ipv4Address::GetAny()};
+    for (uint32_t i = 0; incomingInterface && i < incomingInterface->GetNAddresses(); i++)
+    {
+        Ipv4InterfaceAddress addr = incomingInterface->GetAddress(i);
 
-        // If remote does not match either with exact or wildcard,
-        // skip this one
-        if (!(remotePortMatchesExact || remotePortMatchesWildCard))
-        {
-            continue;
-        }
-        if (!(remoteAddressMatchesExact || remoteAddressMatchesWildCard))
+        Ipv4Address addrNetpart = addr.GetLocal().CombineMask(addr.GetMask());
+        if (addrNetpart != daddr && daddr.CombineMask(addr.GetMask()) == addrNetpart &&
+            std::find(wildcards.begin(), wildcards.end(), addrNetpart) == wildcards.end())
         {
-            continue;
-        }
-
-        bool localAddressMatchesWildCard = localAddressIsAny || localAddressIsSubnetAny;
-
-        if (localAddressMatchesExact && remoteAddressMatchesExact && remotePortMatchesExact)
-        { // All 4 match - this is the case of an open TCP connection, for example.
-            NS_LOG_LOGIC("Found an endpoint for case 4, adding " << endP->GetLocalAddress() << ":"
-                                                                 << endP->GetLocalPort());
-            retval4.push_back(endP);
-        }
-        if (localAddressMatchesWildCard && remoteAddressMatchesExact && remotePortMatchesExact)
-        { // All but local address - no idea what this case could be.
-            NS_LOG_LOGIC("Found an endpoint for case 3, adding " << endP->GetLocalAddress() << ":"
-                                                                 << endP->GetLocalPort());
-            retval3.push_back(endP);
-        }
-        if (localAddressMatchesExact && remoteAddressMatchesWildCard && remotePortMatchesWildCard)
-        { // Only local port and local address matches exactly - Not yet opened connection
-            NS_LOG_LOGIC("Found an endpoint for case 2, adding " << endP->GetLocalAddress() << ":"
-                                                                 << endP->GetLocalPort());
-            retval2.push_back(endP);
-        }
-        if (localAddressMatchesWildCard && remoteAddressMatchesWildCard &&
-            remotePortMatchesWildCard)
-        { // Only local port matches exactly - Endpoint open to "any" connection
-            NS_LOG_LOGIC("Found an endpoint for case 1, adding " << endP->GetLocalAddress() << ":"
-                                                                 << endP->GetLocalPort());
-            retval1.push_back(endP);
+            NS_LOG_LOGIC("Looking for SubnetDirectedAny endpoints "
+                         << addrNetpart << "/" << addr.GetMask().GetPrefixLength());
+            wildcards.push_back(addrNetpart);
         }
     }
 
-    // Here we find the most exact match
-    EndPoints retval;
-    if (!retval4.empty())
+    // All but local address - no idea what this case could be.
+    for (const auto& wildcard : wildcards)
     {
-        retval = retval4;
+        Collect(Key{wildcard, dport, saddr, sport}, incomingInterface, retval);
     }
-    else if (!retval3.empty())
+    if (!retval.empty())
     {
-        retval = retval3;
+        NS_LOG_LOGIC("Found an endpoint for case 3");
     }
-    else if (!retval2.empty())
+    else
     {
-        retval = retval2;
+        // Only local port and local address matches exactly - Not yet opened connection
+        Collect(Key{daddr, dport, Ipv4Address::GetAny(), 0}, incomingInterface, retval);
+        if (!retval.empty())
+        {
+            NS_LOG_LOGIC("Found an endpoint for case 2");
+        }
     }
-    else
+    if (retval.empty())
     {
-        retval = retval1;
+        // Only local port matches exactly - Endpoint open to "any" connection
+        for (const auto& wildcard : wildcards)
+        {
+            Collect(Key{wildcard, dport, Ipv4Address::GetAny(), 0}, incomingInterface, retval);
+        }
     }
 
     NS_ABORT_MSG_IF(retval.size() > 1,
@@ -361,34 +366,36 @@ Ipv4EndPointDemux::SimpleLookup(Ipv4Address daddr,
 {
     NS_LOG_FUNCTION(this << daddr << dport << saddr << sport);
 
+    auto exact = m_index.find(Key{daddr, dport, saddr, sport});
+    if (exact != m_index.end())
+    {
+        /* this is an exact match. */
+        return exact->second.front();
+    }
+
     // this code is a copy/paste version of an old BSD ip stack lookup
     // function.
+    auto port = m_ports.find(dport);
+    if (port == m_ports.end())
+    {
+        return nullptr;
+    }
     uint32_t genericity = 3;
     Ipv4EndPoint* generic = nullptr;
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    for (auto endPoint : port->second)
     {
-        if ((*i)->GetLocalPort() != dport)
-        {
-            continue;
-        }
-        if ((*i)->GetLocalAddress() == daddr && (*i)->GetPeerPort() == sport &&
-            (*i)->GetPeerAddress() == saddr)
-        {
-            /* this is an exact match. */
-            return *i;
-        }
         uint32_t tmp = 0;
-        if ((*i)->GetLocalAddress() == Ipv4Address::GetAny())
+        if (endPoint->GetLocalAddress() == Ipv4Address::GetAny())
         {
             tmp++;
         }
-        if ((*i)->GetPeerAddress() == Ipv4Address::GetAny())
+        if (endPoint->GetPeerAddress() == Ipv4Address::GetAny())
         {
             tmp++;
         }
         if (tmp < genericity)
         {
-            generic = (*i);
+            generic = endPoint;
             genericity = tmp;
         }
     }
@@ -15,6 +15,8 @@
 
 #include <list>
 #include <stdint.h>
+#include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
@@ -31,6 +33,11 @@ class Ipv4EndPoint;
  * of endpoints, and has APIs to add and find endpoints in this demux.  This
  * code is shared in common to TCP and UDP protocols in ns3.  This demux
  * sits between ns3's layer four and the socket layer
+ *
+ * The endpoints are indexed in hash tables by local port, and by local and
+ * peer addresses and ports, so that the cost of a lookup does not depend on
+ * the number of endpoints. The endpoints notify the demux when their local
+ * address or peer is changed.
  */
 
 class Ipv4EndPointDemux
@@ -160,6 +167,75 @@ class Ipv4EndPointDemux
     void DeAllocate(Ipv4EndPoint* endPoint);
 
   private:
+    friend class Ipv4EndPoint;
+
+    /**
+     * @brief The local and peer addresses and ports of an endpoint.
+     *
+     * The peer address and port are wildcards (any address and port 0)
+     * until the endpoint is connected.
+     */
+    struct Key
+    {
+        Ipv4Address localAddress; //!< local address
+        uint16_t localPort;       //!< local port
+        Ipv4Address peerAddress;  //!< peer address
+        uint16_t peerPort;        //!< peer port
+
+        /**
+         * @brief Comparison operator.
+         * @param other the key to compare to
+         * @return true if the keys are equal
+         */
+        bool operator==(const Key& other) const = default;
+    };
+
+    /**
+     * @brief Hash function of a Key.
+     */
+    struct KeyHash
+    {
+        /**
+         * @brief Hash a key.
+         * @param key the key
+         * @return the hash
+         */
+        std::size_t operator()(const Key& key) const;
+    };
+
+    /**
+     * @brief Add an endpoint to the list and to the indexes.
+     * @param endPoint the endpoint
+     * @return the endpoint
+     */
+    Ipv4EndPoint* Insert(Ipv4EndPoint* endPoint);
+
+    /**
+     * @brief Index an endpoint by its current addresses and ports.
+     *
+     * Called by the endpoint when its address or peer has been changed.
+     * @param endPoint the endpoint
+     */
+    void Index(Ipv4EndPoint* endPoint);
+
+    /**
+     * @brief Remove an endpoint from the index of its current addresses and ports.
+     *
+     * Called by the endpoint before its address or peer is changed.
+     * @param endPoint the endpoint
+     */
+    void Unindex(Ipv4EndPoint* endPoint);
+
+    /**
+     * @brief Append the endpoints indexed with a key that can receive a packet.
+     * @param key the key
+     * @param incomingInterface the incoming interface of the packet
+     * @param endPoints the list to append the endpoints to
+     */
+    void Collect(const Key& key,
+                 Ptr<Ipv4Interface> incomingInterface,
+                 EndPoints& endPoints) const;
+
     /**
      * @brief Allocate an ephemeral port.
      * @returns the ephemeral port
@@ -185,6 +261,16 @@ class Ipv4EndPointDemux
      * @brief A list of IPv4 end points.
      */
     EndPoints m_endPoints;
+
+    /**
+     * @brief The endpoints, by local and peer addresses and ports.
+     */
+    std::unordered_map<Key, std::vector<Ipv4EndPoint*>, KeyHash> m_index;
+
+    /**
+     * @brief The endpoints, by local port.
+     */
+    std::unordered_map<uint16_t, std::vector<Ipv4EndPoint*>> m_ports;
 };
 
 } // namespace ns3
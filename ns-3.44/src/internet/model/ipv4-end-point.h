@@ -23,6 +23,7 @@ namespace ns3
 
 class Header;
 class Packet;
+class Ipv4EndPointDemux;
 
 /**
  * @ingroup ipv4
@@ -224,6 +225,13 @@ class Ipv4EndPoint
      * @brief true if the endpoint can receive packets.
      */
     bool m_rxEnabled;
+
+    friend class Ipv4EndPointDemux;
+
+    /**
+     * @brief The demux indexing the endpoint by address and port, if any.
+     */
+    Ipv4EndPointDemux* m_demux;
 };
 
 } // namespace ns3
@@ -19,6 +19,7 @@
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
 
+#include <algorithm>
 #include <iomanip>
 #include <vector>
 
@@ -72,6 +73,7 @@ Ipv4GlobalRouting::AddHostRouteTo(Ipv4Address dest, Ipv4Address nextHop, uint32_
     auto route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateHostRouteTo(dest, nextHop, interface);
     m_hostRoutes.push_back(route);
+    IndexRoute(route, m_hostRouteTrie);
 }
 
 void
@@ -81,6 +83,7 @@ Ipv4GlobalRouting::AddHostRouteTo(Ipv4Address dest, uint32_t interface)
     auto route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateHostRouteTo(dest, interface);
     m_hostRoutes.push_back(route);
+    IndexRoute(route, m_hostRouteTrie);
 }
 
 void
@@ -93,6 +96,7 @@ Ipv4GlobalRouting::AddNetworkRouteTo(Ipv4Address network,
     auto route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, nextHop, interface);
     m_networkRoutes.push_back(route);
+    IndexRoute(route, m_networkRouteTrie);
 }
 
 void
@@ -102,6 +106,7 @@ Ipv4GlobalRouting::AddNetworkRouteTo(Ipv4Address network, Ipv4Mask networkMask,
     auto route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, interface);
     m_networkRoutes.push_back(route);
+    IndexRoute(route, m_networkRouteTrie);
 }
 
 void
@@ -114,6 +119,23 @@ Ipv4GlobalRouting::AddASExternalRouteTo(Ipv4Address network,
     auto route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, nextHop, interface);
     m_ASexternalRoutes.push_back(route);
+    IndexRoute(route, m_ASexternalRouteTrie);
+}
+
+void
+Ipv4GlobalRouting::IndexRoute(Ipv4RoutingTableEntry* route, RouteTrie& trie)
+{
+    NS_LOG_FUNCTION(this << route);
+    trie.Insert(route->GetDestNetwork(), route->GetDestNetworkMask(), route);
+}
+
+void
+Ipv4GlobalRouting::RemoveFromTrie(Ipv4RoutingTableEntry* route, RouteTrie& trie)
+{
+    NS_LOG_FUNCTION(this << route);
+    [[maybe_unused]] bool found =
+        trie.Remove(route->GetDestNetwork(), route->GetDestNetworkMask(), route);
+    NS_ASSERT_MSG(found, "Route " << *route << " is not indexed");
 }
 
 Ptr<Ipv4Route>
@@ -122,73 +144,41 @@ Ipv4GlobalRouting::LookupGlobal(Ipv4Address dest, Ptr<NetDevice> oif)
     NS_LOG_FUNCTION(this << dest << oif);
     NS_LOG_LOGIC("Looking for route for destination " << dest);
     Ptr<Ipv4Route> rtentry = nullptr;
-    // store all available routes that bring packets to their destination
     typedef std::vector<Ipv4RoutingTableEntry*> RouteVec_t;
-    RouteVec_t allRoutes;
-
-    NS_LOG_LOGIC("Number of m_hostRoutes = " << m_hostRoutes.size());
-    for (auto i = m_hostRoutes.begin(); i != m_hostRoutes.end(); i++)
-    {
-        NS_ASSERT((*i)->IsHost());
-        if ((*i)->GetDest() == dest)
+    auto onRequestedInterface = [this, oif](Ipv4RoutingTableEntry* route) {
+        return !oif || oif == m_ipv4->GetNetDevice(route->GetInterface());
+    };
+    // the matching routes, in the order they were added, as a scan of the route lists
+    // would find them, and the number of them on the requested interface, if any
+    const RouteVec_t* routes = nullptr;
+    uint32_t nRoutes = 0;
+    auto findRoutes = [&](const RouteTrie& trie) {
+        routes = trie.FindMatches(dest);
+        nRoutes = 0;
+        if (routes)
         {
-            if (oif)
-            {
-                if (oif != m_ipv4->GetNetDevice((*i)->GetInterface()))
-                {
-                    NS_LOG_LOGIC("Not on requested interface, skipping");
-                    continue;
-                }
-            }
-            allRoutes.push_back(*i);
-            NS_LOG_LOGIC(allRoutes.size() << "Found global host route" << *i);
+            nRoutes = oif ? std::count_if(routes->begin(), routes->end(), onRequestedInterface)
+                          : routes->size();
         }
-    }
-    if (allRoutes.empty()) // if no host route is found
+        return nRoutes > 0;
+    };
+
+    NS_LOG_LOGIC("Number of m_hostRoutes = " << m_hostRoutes.size());
+    if (!findRoutes(m_hostRouteTrie)) // if no host route is found
     {
         NS_LOG_LOGIC("Number of m_networkRoutes" << m_networkRoutes.size());
-        for (auto j = m_networkRoutes.begin(); j != m_networkRoutes.end(); j++)
-        {
-            Ipv4Mask mask = (*j)->GetDestNetworkMask();
-            Ipv4Address entry = (*j)->GetDestNetwork();
-            if (mask.IsMatch(dest, entry))
-            {
-                if (oif)
-                {
-                    if (oif != m_ipv4->GetNetDevice((*j)->GetInterface()))
-                    {
-                        NS_LOG_LOGIC("Not on requested interface, skipping");
-                        continue;
-                    }
-                }
-                allRoutes.push_back(*j);
-                NS_LOG_LOGIC(allRoutes.size() << "Found global network route" << *j);
-            }
-        }
+        // all the matching network routes are ECMP candidates, whatever their prefix
+        findRoutes(m_networkRouteTrie);
+        NS_LOG_LOGIC(nRoutes << " global network routes found");
     }
-    if (allRoutes.empty()) // consider external if no host/network found
+    // consider external if no host/network found
+    if (nRoutes == 0 && findRoutes(m_ASexternalRouteTrie))
     {
-        for (auto k = m_ASexternalRoutes.begin(); k != m_ASexternalRoutes.end(); k++)
-        {
-            Ipv4Mask mask = (*k)->GetDestNetworkMask();
-            Ipv4Address entry = (*k)->GetDestNetwork();
-            if (mask.IsMatch(dest, entry))
-            {
-                NS_LOG_LOGIC("Found external route" << *k);
-                if (oif)
-                {
-                    if (oif != m_ipv4->GetNetDevice((*k)->GetInterface()))
-                    {
-                        NS_LOG_LOGIC("Not on requested interface, skipping");
-                        continue;
-                    }
-                }
-                allRoutes.push_back(*k);
-                break;
-            }
-        }
+        // no ECMP among the external routes: the first matching one is selected
+        NS_LOG_LOGIC("Found external route");
+        nRoutes = 1;
     }
-    if (!allRoutes.empty()) // if route(s) is found
+    if (nRoutes > 0) // if route(s) is found
     {
         // pick up one of the routes uniformly at random if random
         // ECMP routing is enabled, or always select the first route
@@ -196,13 +186,27 @@ Ipv4GlobalRouting::LookupGlobal(Ipv4Address dest, Ptr<NetDevice> oif)
         uint32_t selectIndex;
         if (m_randomEcmpRouting)
         {
-            selectIndex = m_rand->GetInteger(0, allRoutes.size() - 1);
+            selectIndex = m_rand->GetInteger(0, nRoutes - 1);
         }
         else
         {
             selectIndex = 0;
         }
-        Ipv4RoutingTableEntry* route = allRoutes.at(selectIndex);
+        auto it = routes->begin();
+        if (oif)
+        {
+            // skip the routes on the other interfaces
+            it = std::find_if(it, routes->end(), onRequestedInterface);
+            while (selectIndex-- > 0)
+            {
+                it = std::find_if(std::next(it), routes->end(), onRequestedInterface);
+            }
+        }
+        else
+        {
+            it += selectIndex;
+        }
+        Ipv4RoutingTableEntry* route = *it;
         // create a Ipv4Route object from the selected routing table entry
         rtentry = Create<Ipv4Route>();
         rtentry->SetDestination(route->GetDest());
@@ -286,6 +290,7 @@ Ipv4GlobalRouting::RemoveRoute(uint32_t index)
             if (tmp == index)
             {
                 NS_LOG_LOGIC("Removing route " << index << "; size = " << m_hostRoutes.size());
+                RemoveFromTrie(*i, m_hostRouteTrie);
                 delete *i;
                 m_hostRoutes.erase(i);
                 NS_LOG_LOGIC("Done removing host route "
@@ -302,6 +307,7 @@ Ipv4GlobalRouting::RemoveRoute(uint32_t index)
         if (tmp == index)
         {
             NS_LOG_LOGIC("Removing route " << index << "; size = " << m_networkRoutes.size());
+            RemoveFromTrie(*j, m_networkRouteTrie);
             delete *j;
             m_networkRoutes.erase(j);
             NS_LOG_LOGIC("Done removing network route "
@@ -317,6 +323,7 @@ Ipv4GlobalRouting::RemoveRoute(uint32_t index)
         if (tmp == index)
         {
             NS_LOG_LOGIC("Removing route " << index << "; size = " << m_ASexternalRoutes.size());
+            RemoveFromTrie(*k, m_ASexternalRouteTrie);
             delete *k;
             m_ASexternalRoutes.erase(k);
             NS_LOG_LOGIC("Done removing network route "
@@ -353,6 +360,9 @@ Ipv4GlobalRouting::DoDispose()
     {
         delete (*l);
     }
+    m_hostRouteTrie.Clear();
+    m_networkRouteTrie.Clear();
+    m_ASexternalRouteTrie.Clear();
 
     Ipv4RoutingProtocol::DoDispose();
 }
@@ -521,9 +531,7 @@ Ipv4GlobalRouting::NotifyInterfaceUp(uint32_t i)
     NS_LOG_FUNCTION(this << i);
     if (m_respondToInterfaceEvents && Simulator::Now().GetSeconds() > 0) // avoid startup events
     {
-        GlobalRouteManager::DeleteGlobalRoutes();
-        GlobalRouteManager::BuildGlobalRoutingDatabase();
-        GlobalRouteManager::InitializeRoutes();
+        GlobalRouteManager::UpdateGlobalRoutes();
     }
 }
 
@@ -533,9 +541,7 @@ Ipv4GlobalRouting::NotifyInterfaceDown(uint32_t i)
     NS_LOG_FUNCTION(this << i);
     if (m_respondToInterfaceEvents && Simulator::Now().GetSeconds() > 0) // avoid startup events
     {
-        GlobalRouteManager::DeleteGlobalRoutes();
-        GlobalRouteManager::BuildGlobalRoutingDatabase();
-        GlobalRouteManager::InitializeRoutes();
+        GlobalRouteManager::UpdateGlobalRoutes();
     }
 }
 
@@ -545,9 +551,7 @@ Ipv4GlobalRouting::NotifyAddAddress(uint32_t interface, Ipv4InterfaceAddress add
     NS_LOG_FUNCTION(this << interface << address);
     if (m_respondToInterfaceEvents && Simulator::Now().GetSeconds() > 0) // avoid startup events
     {
-        GlobalRouteManager::DeleteGlobalRoutes();
-        GlobalRouteManager::BuildGlobalRoutingDatabase();
-        GlobalRouteManager::InitializeRoutes();
+        GlobalRouteManager::UpdateGlobalRoutes();
     }
 }
 
@@ -557,9 +561,7 @@ Ipv4GlobalRouting::NotifyRemoveAddress(uint32_t interface, Ipv4InterfaceAddress
     NS_LOG_FUNCTION(this << interface << address);
     if (m_respondToInterfaceEvents && Simulator::Now().GetSeconds() > 0) // avoid startup events
     {
-        GlobalRouteManager::DeleteGlobalRoutes();
-        GlobalRouteManager::BuildGlobalRoutingDatabase();
-        GlobalRouteManager::InitializeRoutes();
+        GlobalRouteManager::UpdateGlobalRoutes();
     }
 }
 
@@ -8,6 +8,7 @@
 #define IPV4_GLOBAL_ROUTING_H
 
 #include "ipv4-header.h"
+#include "ipv4-prefix-trie.h"
 #include "ipv4-routing-protocol.h"
 #include "ipv4.h"
 
@@ -54,6 +55,14 @@ class Node;
  *
  * This class deals with Ipv4 unicast routes only.
  *
+ * The routes are looked up in prefix tries, updated as the routes are added
+ * and removed, so that the cost of a lookup does not depend on the number
+ * of routes. Host routes are preferred to network routes, which are
+ * preferred to AS external routes. All the matching network routes are
+ * candidates, whatever the length of their prefix, and one of them is
+ * selected according to the RandomEcmpRouting attribute; the first added
+ * matching AS external route is selected.
+ *
  * @see Ipv4RoutingProtocol
  * @see GlobalRouteManager
  */
@@ -262,10 +271,31 @@ class Ipv4GlobalRouting : public Ipv4RoutingProtocol
      */
     Ptr<Ipv4Route> LookupGlobal(Ipv4Address dest, Ptr<NetDevice> oif = nullptr);
 
+    /// prefix trie of Ipv4RoutingTableEntry
+    typedef Ipv4PrefixTrie<Ipv4RoutingTableEntry*> RouteTrie;
+
+    /**
+     * @brief Index a route in a trie.
+     * @param route the route, which has just been appended to its route list
+     * @param trie the trie
+     */
+    void IndexRoute(Ipv4RoutingTableEntry* route, RouteTrie& trie);
+
+    /**
+     * @brief Remove a route from the trie indexing it.
+     * @param route the route
+     * @param trie the trie
+     */
+    void RemoveFromTrie(Ipv4RoutingTableEntry* route, RouteTrie& trie);
+
     HostRoutes m_hostRoutes;             //!< Routes to hosts
     NetworkRoutes m_networkRoutes;       //!< Routes to networks
     ASExternalRoutes m_ASexternalRoutes; //!< External routes imported
 
+    RouteTrie m_hostRouteTrie;       //!< Routes to hosts, by destination
+    RouteTrie m_networkRouteTrie;    //!< Routes to networks, by prefix
+    RouteTrie m_ASexternalRouteTrie; //!< External routes imported, by prefix
+
     Ptr<Ipv4> m_ipv4; //!< associated IPv4 instance
 };
 
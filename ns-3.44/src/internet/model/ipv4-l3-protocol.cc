@@ -25,6 +25,7 @@
 #include "ns3/node.h"
 #include "ns3/object-vector.h"
 #include "ns3/packet.h"
+#include "ns3/segmentation-offload-tag.h"
 #include "ns3/socket.h"
 #include "ns3/string.h"
 #include "ns3/trace-source-accessor.h"
@@ -978,7 +979,12 @@ Ipv4L3Protocol::SendRealOut(Ptr<Ipv4Route> route, Ptr<Packet> packet, const Ipv4
     if (outInterface->IsUp())
     {
         NS_LOG_LOGIC("Send to " << targetLabel << " " << target);
-        if (packet->GetSize() + ipHeader.GetSerializedSize() > outInterface->GetDevice()->GetMtu())
+        // The super-segments of segmentation offload are not fragmented when the
+        // device supports it
+        Ptr<NetDevice> outDevice = outInterface->GetDevice();
+        SegmentationOffloadTag offloadTag;
+        if (packet->GetSize() + ipHeader.GetSerializedSize() > outDevice->GetMtu() &&
+            !(outDevice->SupportsSegmentationOffload() && packet->PeekPacketTag(offloadTag)))
         {
             std::list<Ipv4PayloadHeaderPair> listFragments;
             DoFragmentation(packet, ipHeader, outInterface->GetDevice()->GetMtu(), listFragments);
@@ -0,0 +1,108 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef IPV4_PREFIX_TRIE_H
+#define IPV4_PREFIX_TRIE_H
+
+#include "prefix-trie.h"
+
+#include "ns3/ipv4-address.h"
+
+namespace ns3
+{
+
+/**
+ * @ingroup ipv4Routing
+ *
+ * @brief Path-compressed binary trie indexing values by IPv4 prefix.
+ *
+ * The prefixes matching an address are found by walking at most 33 nodes.
+ *
+ * @see PrefixTrie
+ *
+ * @tparam T \explicit Type of the values
+ */
+template <typename T>
+class Ipv4PrefixTrie : public PrefixTrie<T, 32>
+{
+  public:
+    /**
+     * @brief Append a value to the list of a prefix.
+     *
+     * @param network the network address of the prefix
+     * @param mask the network mask of the prefix
+     * @param value the value
+     */
+    void Insert(Ipv4Address network, Ipv4Mask mask, const T& value)
+    {
+        PrefixTrie<T, 32>::Insert(KeyOf(network), KeyOf(mask), value);
+    }
+
+    /**
+     * @brief Remove a value from the list of a prefix.
+     *
+     * @param network the network address of the prefix
+     * @param mask the network mask of the prefix
+     * @param value the value
+     * @returns true if the value was found
+     */
+    bool Remove(Ipv4Address network, Ipv4Mask mask, const T& value)
+    {
+        return PrefixTrie<T, 32>::Remove(KeyOf(network), KeyOf(mask), value);
+    }
+
+    /**
+     * @brief Find the values of all the prefixes matching an address.
+     *
+     * @param address the address
+     * @returns the values of the prefixes matching the address, in insertion
+     * order, or a null pointer if no prefix matches the address
+     */
+    const std::vector<T>* FindMatches(Ipv4Address address) const
+    {
+        return PrefixTrie<T, 32>::FindMatches(KeyOf(address));
+    }
+
+    /**
+     * @brief Visit the lists of the prefixes matching an address, longest prefix first.
+     *
+     * @tparam Visitor \deduced the type of the visitor
+     * @param address the address
+     * @param visitor a callable taking a const std::vector<T>& and returning a bool
+     * @returns true if the visitor returned true
+     */
+    template <typename Visitor>
+    bool VisitMatches(Ipv4Address address, Visitor visitor) const
+    {
+        return PrefixTrie<T, 32>::VisitMatches(KeyOf(address), visitor);
+    }
+
+  private:
+    /// An address or a mask, in network byte order
+    typedef typename PrefixTrie<T, 32>::Key Key;
+
+    /**
+     * @param address an address
+     * @returns the bytes of the address
+     */
+    static Key KeyOf(Ipv4Address address)
+    {
+        Key key;
+        address.Serialize(key.data());
+        return key;
+    }
+
+    /**
+     * @param mask a mask
+     * @returns the bytes of the mask
+     */
+    static Key KeyOf(Ipv4Mask mask)
+    {
+        return KeyOf(Ipv4Address(mask.Get()));
+    }
+};
+
+} // namespace ns3
+
+#endif /* IPV4_PREFIX_TRIE_H */
@@ -24,6 +24,7 @@
 #include "ns3/output-stream-wrapper.h"
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
+#include "ns3/uinteger.h"
 
 #include <iomanip>
 
@@ -39,15 +40,24 @@ NS_OBJECT_ENSURE_REGISTERED(Ipv4StaticRouting);
 TypeId
 Ipv4StaticRouting::GetTypeId()
 {
-    static TypeId tid = TypeId("ns3::Ipv4StaticRouting")
-                            .SetParent<Ipv4RoutingProtocol>()
-                            .SetGroupName("Internet")
-                            .AddConstructor<Ipv4StaticRouting>();
+    static TypeId tid =
+        TypeId("ns3::Ipv4StaticRouting")
+            .SetParent<Ipv4RoutingProtocol>()
+            .SetGroupName("Internet")
+            .AddConstructor<Ipv4StaticRouting>()
+            .AddAttribute("RouteCacheSize",
+                          "The maximum number of destinations whose selected route is cached. "
+                          "The cache is flushed when it is full and whenever a route is added "
+                          "or removed. Zero disables the cache.",
+                          UintegerValue(1024),
+                          MakeUintegerAccessor(&Ipv4StaticRouting::m_routeCacheSize),
+                          MakeUintegerChecker<uint32_t>());
     return tid;
 }
 
 Ipv4StaticRouting::Ipv4StaticRouting()
-    : m_ipv4(nullptr)
+    : m_routeCacheSize(0),
+      m_ipv4(nullptr)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -67,8 +77,7 @@ Ipv4StaticRouting::AddNetworkRouteTo(Ipv4Address network,
 
     if (!LookupRoute(route, metric))
     {
-        auto routePtr = new Ipv4RoutingTableEntry(route);
-        m_networkRoutes.emplace_back(routePtr, metric);
+        InsertNetworkRoute(new Ipv4RoutingTableEntry(route), metric);
     }
 }
 
@@ -84,9 +93,7 @@ Ipv4StaticRouting::AddNetworkRouteTo(Ipv4Address network,
         Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, interface);
     if (!LookupRoute(route, metric))
     {
-        auto routePtr = new Ipv4RoutingTableEntry(route);
-
-        m_networkRoutes.emplace_back(routePtr, metric);
+        InsertNetworkRoute(new Ipv4RoutingTableEntry(route), metric);
     }
 }
 
@@ -141,7 +148,7 @@ Ipv4StaticRouting::SetDefaultMulticastRoute(uint32_t outputInterface)
     Ipv4Address network("224.0.0.0");
     Ipv4Mask networkMask("240.0.0.0");
     *route = Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, outputInterface);
-    m_networkRoutes.emplace_back(route, 0);
+    InsertNetworkRoute(route, 0);
 }
 
 uint32_t
@@ -210,22 +217,102 @@ Ipv4StaticRouting::RemoveMulticastRoute(uint32_t index)
     }
 }
 
+void
+Ipv4StaticRouting::InsertNetworkRoute(Ipv4RoutingTableEntry* route, uint32_t metric)
+{
+    NS_LOG_FUNCTION(this << *route << metric);
+    m_networkRoutes.emplace_back(route, metric);
+    m_networkRouteTrie.Insert(route->GetDestNetwork(),
+                              route->GetDestNetworkMask(),
+                              m_networkRoutes.back());
+    m_routeCache.clear();
+}
+
+Ipv4StaticRouting::NetworkRoutesI
+Ipv4StaticRouting::EraseNetworkRoute(NetworkRoutesI it)
+{
+    NS_LOG_FUNCTION(this << *it->first << it->second);
+    [[maybe_unused]] bool found = m_networkRouteTrie.Remove(it->first->GetDestNetwork(),
+                                                            it->first->GetDestNetworkMask(),
+                                                            *it);
+    NS_ASSERT_MSG(found, "Route " << *it->first << " is not indexed");
+    m_routeCache.clear();
+    delete it->first;
+    return m_networkRoutes.erase(it);
+}
+
 bool
 Ipv4StaticRouting::LookupRoute(const Ipv4RoutingTableEntry& route, uint32_t metric)
 {
-    for (auto j = m_networkRoutes.begin(); j != m_networkRoutes.end(); j++)
+    // the routes to the prefix of the route are among the routes matching its destination
+    return m_networkRouteTrie.VisitMatches(
+        route.GetDest(),
+        [&route, metric](const std::vector<std::pair<Ipv4RoutingTableEntry*, uint32_t>>& routes) {
+            for (const auto& [rtentry, rtmetric] : routes)
+            {
+                if (rtentry->GetDest() == route.GetDest() &&
+                    rtentry->GetDestNetworkMask() == route.GetDestNetworkMask() &&
+                    rtentry->GetGateway() == route.GetGateway() &&
+                    rtentry->GetInterface() == route.GetInterface() && rtmetric == metric)
+                {
+                    return true;
+                }
+            }
+            return false;
+        });
+}
+
+Ipv4RoutingTableEntry*
+Ipv4StaticRouting::FindRoute(Ipv4Address dest, Ptr<NetDevice> oif)
+{
+    NS_LOG_FUNCTION(this << dest << oif);
+    bool cacheable = !oif && m_routeCacheSize > 0;
+    if (cacheable)
     {
-        Ipv4RoutingTableEntry* rtentry = j->first;
+        auto it = m_routeCache.find(dest);
+        if (it != m_routeCache.end())
+        {
+            NS_LOG_LOGIC("Route to " << dest << " found in the route cache");
+            return it->second;
+        }
+    }
+
+    // among the routes to the longest matching prefix that has routes on the
+    // requested interface, select the one with the lowest metric, the last
+    // added one on a tie
+    Ipv4RoutingTableEntry* result = nullptr;
+    uint32_t shortestMetric = 0xffffffff;
+    m_networkRouteTrie.VisitMatches(
+        dest,
+        [this, oif, &result, &shortestMetric](
+            const std::vector<std::pair<Ipv4RoutingTableEntry*, uint32_t>>& routes) {
+            for (const auto& [route, metric] : routes)
+            {
+                NS_LOG_LOGIC("Found network route " << *route << ", metric " << metric);
+                if (oif && oif != m_ipv4->GetNetDevice(route->GetInterface()))
+                {
+                    NS_LOG_LOGIC("Not on requested interface, skipping");
+                    continue;
+                }
+                if (metric <= shortestMetric)
+                {
+                    shortestMetric = metric;
+                    result = route;
+                }
+            }
+            return result != nullptr;
+        });
 
-        if (rtentry->GetDest() == route.GetDest() &&
-            rtentry->GetDestNetworkMask() == route.GetDestNetworkMask() &&
-            rtentry->GetGateway() == route.GetGateway() &&
-            rtentry->GetInterface() == route.GetInterface() && j->second == metric)
+    if (cacheable)
+    {
+        if (m_routeCache.size() >= m_routeCacheSize)
         {
-            return true;
+            NS_LOG_LOGIC("Route cache full, flushing it");
+            m_routeCache.clear();
         }
+        m_routeCache[dest] = result;
     }
-    return false;
+    return result;
 }
 
 Ptr<Ipv4Route>
@@ -233,8 +320,6 @@ Ipv4StaticRouting::LookupStatic(Ipv4Address dest, Ptr<NetDevice> oif)
 {
     NS_LOG_FUNCTION(this << dest << " " << oif);
     Ptr<Ipv4Route> rtentry = nullptr;
-    uint16_t longest_mask = 0;
-    uint32_t shortest_metric = 0xffffffff;
     /* when sending on local multicast, there have to be interface specified */
     if (dest.IsLocalMulticast())
     {
@@ -250,55 +335,15 @@ Ipv4StaticRouting::LookupStatic(Ipv4Address dest, Ptr<NetDevice> oif)
         return rtentry;
     }
 
-    for (auto i = m_networkRoutes.begin(); i != m_networkRoutes.end(); i++)
+    Ipv4RoutingTableEntry* route = FindRoute(dest, oif);
+    if (route)
     {
-        Ipv4RoutingTableEntry* j = i->first;
-        uint32_t metric = i->second;
-        Ipv4Mask mask = (j)->GetDestNetworkMask();
-        uint16_t masklen = mask.GetPrefixLength();
-        Ipv4Address entry = (j)->GetDestNetwork();
-        NS_LOG_LOGIC("Searching for route to " << dest << ", checking against route to " << entry
-                                               << "/" << masklen);
-        if (mask.IsMatch(dest, entry))
-        {
-            NS_LOG_LOGIC("Found global network route " << j << ", mask length " << masklen
-                                                       << ", metric " << metric);
-            if (oif)
-            {
-                if (oif != m_ipv4->GetNetDevice(j->GetInterface()))
-                {
-                    NS_LOG_LOGIC("Not on requested interface, skipping");
-                    continue;
-                }
-            }
-            if (masklen < longest_mask) // Not interested if got shorter mask
-            {
-                NS_LOG_LOGIC("Previous match longer, skipping");
-                continue;
-            }
-            if (masklen > longest_mask) // Reset metric if longer masklen
-            {
-                shortest_metric = 0xffffffff;
-            }
-            longest_mask = masklen;
-            if (metric > shortest_metric)
-            {
-                NS_LOG_LOGIC("Equal mask length, but previous metric shorter, skipping");
-                continue;
-            }
-            shortest_metric = metric;
-            Ipv4RoutingTableEntry* route = (j);
-            uint32_t interfaceIdx = route->GetInterface();
-            rtentry = Create<Ipv4Route>();
-            rtentry->SetDestination(route->GetDest());
-            rtentry->SetSource(m_ipv4->SourceAddressSelection(interfaceIdx, route->GetDest()));
-            rtentry->SetGateway(route->GetGateway());
-            rtentry->SetOutputDevice(m_ipv4->GetNetDevice(interfaceIdx));
-            if (masklen == 32)
-            {
-                break;
-            }
-        }
+        uint32_t interfaceIdx = route->GetInterface();
+        rtentry = Create<Ipv4Route>();
+        rtentry->SetDestination(route->GetDest());
+        rtentry->SetSource(m_ipv4->SourceAddressSelection(interfaceIdx, route->GetDest()));
+        rtentry->SetGateway(route->GetGateway());
+        rtentry->SetOutputDevice(m_ipv4->GetNetDevice(interfaceIdx));
     }
     if (rtentry)
     {
@@ -446,8 +491,7 @@ Ipv4StaticRouting::RemoveRoute(uint32_t index)
     {
         if (tmp == index)
         {
-            delete j->first;
-            m_networkRoutes.erase(j);
+            EraseNetworkRoute(j);
             return;
         }
         tmp++;
@@ -581,6 +625,8 @@ Ipv4StaticRouting::DoDispose()
     {
         delete (j->first);
     }
+    m_networkRouteTrie.Clear();
+    m_routeCache.clear();
     for (auto i = m_multicastRoutes.begin(); i != m_multicastRoutes.end();
          i = m_multicastRoutes.erase(i))
     {
@@ -620,8 +666,7 @@ Ipv4StaticRouting::NotifyInterfaceDown(uint32_t i)
     {
         if (it->first->GetInterface() == i)
         {
-            delete it->first;
-            it = m_networkRoutes.erase(it);
+            it = EraseNetworkRoute(it);
         }
         else
         {
@@ -665,8 +710,7 @@ Ipv4StaticRouting::NotifyRemoveAddress(uint32_t interface, Ipv4InterfaceAddress
             it->first->GetDestNetwork() == networkAddress &&
             it->first->GetDestNetworkMask() == networkMask)
         {
-            delete it->first;
-            it = m_networkRoutes.erase(it);
+            it = EraseNetworkRoute(it);
         }
         else
         {
@@ -11,6 +11,7 @@
 #define IPV4_STATIC_ROUTING_H
 
 #include "ipv4-header.h"
+#include "ipv4-prefix-trie.h"
 #include "ipv4-routing-protocol.h"
 #include "ipv4.h"
 
@@ -20,6 +21,7 @@
 
 #include <list>
 #include <stdint.h>
+#include <unordered_map>
 #include <utility>
 
 namespace ns3
@@ -49,6 +51,13 @@ class Node;
  * Ipv4RoutingProtocol that defines the interface methods that a routing
  * protocol must support.
  *
+ * The unicast routes are looked up in a prefix trie: the selected route is
+ * one of the routes to the longest prefix matching the destination (and
+ * going through the requested output device, if any), the one with the
+ * lowest metric or, on a tie, the last added one. The route selected for
+ * each destination is cached, up to RouteCacheSize destinations, and the
+ * cache is flushed whenever a route is added or removed.
+ *
  * @see Ipv4RoutingProtocol
  * @see Ipv4ListRouting
  * @see Ipv4ListRouting::AddRoutingProtocol
@@ -370,6 +379,31 @@ class Ipv4StaticRouting : public Ipv4RoutingProtocol
     /// Iterator for container for the multicast routes
     typedef std::list<Ipv4MulticastRoutingTableEntry*>::iterator MulticastRoutesI;
 
+    /// Prefix trie of the network routes and their metric
+    typedef Ipv4PrefixTrie<std::pair<Ipv4RoutingTableEntry*, uint32_t>> NetworkRouteTrie;
+
+    /**
+     * @brief Add a route to the forwarding table.
+     * @param route the route, now owned by the forwarding table
+     * @param metric metric of route
+     */
+    void InsertNetworkRoute(Ipv4RoutingTableEntry* route, uint32_t metric);
+
+    /**
+     * @brief Remove a route from the forwarding table and delete it.
+     * @param it the route
+     * @return the route following the removed one
+     */
+    NetworkRoutesI EraseNetworkRoute(NetworkRoutesI it);
+
+    /**
+     * @brief Select the route to a destination, in the route cache or in the prefix trie.
+     * @param dest destination address
+     * @param oif output interface if any (put 0 otherwise)
+     * @return the selected route, or nullptr if there is no route
+     */
+    Ipv4RoutingTableEntry* FindRoute(Ipv4Address dest, Ptr<NetDevice> oif);
+
     /**
      * @brief Checks if a route is already present in the forwarding table.
      * @param route route
@@ -400,6 +434,21 @@ class Ipv4StaticRouting : public Ipv4RoutingProtocol
      */
     NetworkRoutes m_networkRoutes;
 
+    /**
+     * @brief the network routes, by prefix.
+     */
+    NetworkRouteTrie m_networkRouteTrie;
+
+    /**
+     * @brief the route selected for each destination looked up without output interface.
+     */
+    std::unordered_map<Ipv4Address, Ipv4RoutingTableEntry*, Ipv4AddressHash> m_routeCache;
+
+    /**
+     * @brief the maximum number of destinations in the route cache.
+     */
+    uint32_t m_routeCacheSize;
+
     /**
      * @brief the forwarding table for multicast.
      */
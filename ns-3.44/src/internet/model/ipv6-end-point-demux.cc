@@ -12,11 +12,48 @@
 
 #include "ns3/log.h"
 
+#include <algorithm>
+
 namespace ns3
 {
 
 NS_LOG_COMPONENT_DEFINE("Ipv6EndPointDemux");
 
+namespace
+{
+
+/**
+ * @brief Remove an endpoint from a bucket of an index, and the bucket if it becomes empty.
+ * @tparam Index \deduced the index type
+ * @param index the index
+ * @param key the key of the bucket
+ * @param endPoint the endpoint
+ */
+template <typename Index>
+void
+RemoveFromBucket(Index& index, const typename Index::key_type& key, Ipv6EndPoint* endPoint)
+{
+    auto it = index.find(key);
+    NS_ASSERT_MSG(it != index.end(), "Endpoint " << endPoint << " is not indexed");
+    auto& bucket = it->second;
+    bucket.erase(std::find(bucket.begin(), bucket.end(), endPoint));
+    if (bucket.empty())
+    {
+        index.erase(it);
+    }
+}
+
+} // namespace
+
+std::size_t
+Ipv6EndPointDemux::KeyHash::operator()(const Key& key) const
+{
+    Ipv6AddressHash hash;
+    std::size_t h = hash(key.localAddress) ^ key.localPort;
+    h = (h * 0x9e3779b97f4a7c15ULL) ^ hash(key.peerAddress);
+    return (h * 0x9e3779b97f4a7c15ULL) ^ key.peerPort;
+}
+
 Ipv6EndPointDemux::Ipv6EndPointDemux()
     : m_ephemeral(49152),
       m_portFirst(49152),
@@ -31,33 +68,33 @@ Ipv6EndPointDemux::~Ipv6EndPointDemux()
     for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
     {
         Ipv6EndPoint* endPoint = *i;
+        endPoint->m_demux = nullptr;
         delete endPoint;
     }
     m_endPoints.clear();
+    m_index.clear();
+    m_ports.clear();
 }
 
 bool
 Ipv6EndPointDemux::LookupPortLocal(uint16_t port)
 {
     NS_LOG_FUNCTION(this << port);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
-    {
-        if ((*i)->GetLocalPort() == port)
-        {
-            return true;
-        }
-    }
-    return false;
+    return m_ports.find(port) != m_ports.end();
 }
 
 bool
 Ipv6EndPointDemux::LookupLocal(Ptr<NetDevice> boundNetDevice, Ipv6Address addr, uint16_t port)
 {
     NS_LOG_FUNCTION(this << addr << port);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto it = m_ports.find(port);
+    if (it == m_ports.end())
+    {
+        return false;
+    }
+    for (auto endPoint : it->second)
     {
-        if ((*i)->GetLocalPort() == port && (*i)->GetLocalAddress() == addr &&
-            (*i)->GetBoundNetDevice() == boundNetDevice)
+        if (endPoint->GetLocalAddress() == addr && endPoint->GetBoundNetDevice() == boundNetDevice)
         {
             return true;
         }
@@ -65,6 +102,40 @@ Ipv6EndPointDemux::LookupLocal(Ptr<NetDevice> boundNetDevice, Ipv6Address addr,
     return false;
 }
 
+Ipv6EndPoint*
+Ipv6EndPointDemux::Insert(Ipv6EndPoint* endPoint)
+{
+    NS_LOG_FUNCTION(this << endPoint);
+    m_endPoints.push_back(endPoint);
+    m_ports[endPoint->GetLocalPort()].push_back(endPoint);
+    Index(endPoint);
+    endPoint->m_demux = this;
+    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
+    return endPoint;
+}
+
+void
+Ipv6EndPointDemux::Index(Ipv6EndPoint* endPoint)
+{
+    NS_LOG_FUNCTION(this << endPoint);
+    Key key{endPoint->GetLocalAddress(),
+            endPoint->GetLocalPort(),
+            endPoint->GetPeerAddress(),
+            endPoint->GetPeerPort()};
+    m_index[key].push_back(endPoint);
+}
+
+void
+Ipv6EndPointDemux::Unindex(Ipv6EndPoint* endPoint)
+{
+    NS_LOG_FUNCTION(this << endPoint);
+    Key key{endPoint->GetLocalAddress(),
+            endPoint->GetLocalPort(),
+            endPoint->GetPeerAddress(),
+            endPoint->GetPeerPort()};
+    RemoveFromBucket(m_index, key, endPoint);
+}
+
 Ipv6EndPoint*
 Ipv6EndPointDemux::Allocate()
 {
@@ -75,10 +146,7 @@ Ipv6EndPointDemux::Allocate()
         NS_LOG_WARN("Ephemeral port allocation failed.");
         return nullptr;
     }
-    auto endPoint = new Ipv6EndPoint(Ipv6Address::GetAny(), port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
-    return endPoint;
+    return Insert(new Ipv6EndPoint(Ipv6Address::GetAny(), port));
 }
 
 Ipv6EndPoint*
@@ -91,10 +159,7 @@ Ipv6EndPointDemux::Allocate(Ipv6Address address)
         NS_LOG_WARN("Ephemeral port allocation failed.");
         return nullptr;
     }
-    auto endPoint = new Ipv6EndPoint(address, port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
-    return endPoint;
+    return Insert(new Ipv6EndPoint(address, port));
 }
 
 Ipv6EndPoint*
@@ -114,10 +179,7 @@ Ipv6EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice, Ipv6Address address,
         NS_LOG_WARN("Duplicated endpoint.");
         return nullptr;
     }
-    auto endPoint = new Ipv6EndPoint(address, port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
-    return endPoint;
+    return Insert(new Ipv6EndPoint(address, port));
 }
 
 Ipv6EndPoint*
@@ -128,23 +190,21 @@ Ipv6EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice,
                             uint16_t peerPort)
 {
     NS_LOG_FUNCTION(this << boundNetDevice << localAddress << localPort << peerAddress << peerPort);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto it = m_index.find(Key{localAddress, localPort, peerAddress, peerPort});
+    if (it != m_index.end())
     {
-        if ((*i)->GetLocalPort() == localPort && (*i)->GetLocalAddress() == localAddress &&
-            (*i)->GetPeerPort() == peerPort && (*i)->GetPeerAddress() == peerAddress &&
-            ((*i)->GetBoundNetDevice() == boundNetDevice || !(*i)->GetBoundNetDevice()))
+        for (auto endPoint : it->second)
         {
-            NS_LOG_WARN("Duplicated endpoint.");
-            return nullptr;
+            if (endPoint->GetBoundNetDevice() == boundNetDevice || !endPoint->GetBoundNetDevice())
+            {
+                NS_LOG_WARN("Duplicated endpoint.");
+                return nullptr;
+            }
         }
     }
     auto endPoint = new Ipv6EndPoint(localAddress, localPort);
     endPoint->SetPeer(peerAddress, peerPort);
-    m_endPoints.push_back(endPoint);
-
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
-
-    return endPoint;
+    return Insert(endPoint);
 }
 
 void
@@ -155,6 +215,9 @@ Ipv6EndPointDemux::DeAllocate(Ipv6EndPoint* endPoint)
     {
         if (*i == endPoint)
         {
+            Unindex(endPoint);
+            RemoveFromBucket(m_ports, endPoint->GetLocalPort(), endPoint);
+            endPoint->m_demux = nullptr;
             delete endPoint;
             m_endPoints.erase(i);
             break;
@@ -162,30 +225,18 @@ Ipv6EndPointDemux::DeAllocate(Ipv6EndPoint* endPoint)
     }
 }
 
-/*
- * If we have an exact match, we return it.
- * Otherwise, if we find a generic match, we return it.
- * Otherwise, we return 0.
- */
-Ipv6EndPointDemux::EndPoints
-Ipv6EndPointDemux::Lookup(Ipv6Address daddr,
-                          uint16_t dport,
-                          Ipv6Address saddr,
-                          uint16_t sport,
-                          Ptr<Ipv6Interface> incomingInterface)
+void
+Ipv6EndPointDemux::Collect(const Key& key,
+                           Ptr<Ipv6Interface> incomingInterface,
+                           EndPoints& endPoints) const
 {
-    NS_LOG_FUNCTION(this << daddr << dport << saddr << sport << incomingInterface);
-
-    EndPoints retval1; /* Matches exact on local port, wildcards on others */
-    EndPoints retval2; /* Matches exact on local port/adder, wildcards on others */
-    EndPoints retval3; /* Matches all but local address */
-    EndPoints retval4; /* Exact match on all 4 */
-
-    NS_LOG_DEBUG("Looking up endpoint for destination address " << daddr);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto it = m_index.find(key);
+    if (it == m_index.end())
+    {
+        return;
+    }
+    for (auto endP : it->second)
     {
-        Ipv6EndPoint* endP = *i;
-
         NS_LOG_DEBUG("Looking at endpoint dport="
                      << endP->GetLocalPort() << " daddr=" << endP->GetLocalAddress()
                      << " sport=" << endP->GetPeerPort() << " saddr=" << endP->GetPeerAddress());
@@ -197,14 +248,6 @@ Ipv6EndPointDemux::Lookup(Ipv6Address daddr,
             continue;
         }
 
-        if (endP->GetLocalPort() != dport)
-        {
-            NS_LOG_LOGIC("Skipping endpoint " << &endP << " because endpoint dport "
-                                              << endP->GetLocalPort()
-                                              << " does not match packet dport " << dport);
-            continue;
-        }
-
         if (endP->GetBoundNetDevice())
         {
             if (!incomingInterface)
@@ -220,74 +263,46 @@ Ipv6EndPointDemux::Lookup(Ipv6Address daddr,
                 continue;
             }
         }
+        endPoints.push_back(endP);
+    }
+}
 
-        /*    Ipv6Address incomingInterfaceAddr = incomingInterface->GetAddress (); */
-        NS_LOG_DEBUG("dest addr " << daddr);
-
-        bool localAddressMatchesWildCard = endP->GetLocalAddress() == Ipv6Address::GetAny();
-        bool localAddressMatchesExact = endP->GetLocalAddress() == daddr;
-        bool localAddressMatchesAllRouters =
-            endP->GetLocalAddress() == Ipv6Address::GetAllRoutersMulticast();
+/*
+ * If we have an exact match, we return it.
+ * Otherwise, if we find a generic match, we return it.
+ * Otherwise, we return 0.
+ */
+Ipv6EndPointDemux::EndPoints
+Ipv6EndPointDemux::Lookup(Ipv6Address daddr,
+                          uint16_t dport,
+                          Ipv6Address saddr,
+                          uint16_t sport,
+                          Ptr<Ipv6Interface> incomingInterface)
+{
+    NS_LOG_FUNCTION(this << daddr << dport << saddr << sport << incomingInterface);
 
-        /* if no match here, keep looking */
-        if (!(localAddressMatchesExact || localAddressMatchesWildCard))
-        {
-            continue;
-        }
-        bool remotePeerMatchesExact = endP->GetPeerPort() == sport;
-        bool remotePeerMatchesWildCard = endP->GetPeerPort() == 0;
-        bool remoteAddressMatchesExact = endP->GetPeerAddress() == saddr;
-        bool remoteAddressMatchesWildCard = endP->GetPeerAddress() == Ipv6Address::GetAny();
-
-        /* If remote does not match either with exact or wildcard,i
-           skip this one */
-        if (!(remotePeerMatchesExact || remotePeerMatchesWildCard))
-        {
-            continue;
-        }
-        if (!(remoteAddressMatchesExact || remoteAddressMatchesWildCard))
-        {
-            continue;
-        }
+    EndPoints retval;
 
-        /* Now figure out which return list to add this one to */
-        if (localAddressMatchesWildCard && remotePeerMatchesWildCard &&
-            remoteAddressMatchesWildCard)
-        { /* Only local port matches exactly */
-            retval1.push_back(endP);
-        }
-        if ((localAddressMatchesExact || (localAddressMatchesAllRouters)) &&
-            remotePeerMatchesWildCard && remoteAddressMatchesWildCard)
-        { /* Only local port and local address matches exactly */
-            retval2.push_back(endP);
-        }
-        if (localAddressMatchesWildCard && remotePeerMatchesExact && remoteAddressMatchesExact)
-        { /* All but local address */
-            retval3.push_back(endP);
-        }
-        if (localAddressMatchesExact && remotePeerMatchesExact && remoteAddressMatchesExact)
-        { /* All 4 match */
-            retval4.push_back(endP);
-        }
-    }
+    NS_LOG_DEBUG("Looking up endpoint for destination address " << daddr);
 
-    // Here we find the most exact match
-    EndPoints retval;
-    if (!retval4.empty())
-    {
-        retval = retval4;
-    }
-    else if (!retval3.empty())
+    /* All 4 match */
+    Collect(Key{daddr, dport, saddr, sport}, incomingInterface, retval);
+    if (retval.empty())
     {
-        retval = retval3;
+        /* All but local address */
+        Collect(Key{Ipv6Address::GetAny(), dport, saddr, sport}, incomingInterface, retval);
     }
-    else if (!retval2.empty())
+    if (retval.empty())
     {
-        retval = retval2;
+        /* Only local port and local address matches exactly */
+        Collect(Key{daddr, dport, Ipv6Address::GetAny(), 0}, incomingInterface, retval);
     }
-    else
+    if (retval.empty())
     {
-        retval = retval1;
+        /* Only local port matches exactly */
+        Collect(Key{Ipv6Address::GetAny(), dport, Ipv6Address::GetAny(), 0},
+                incomingInterface,
+                retval);
     }
 
     NS_ABORT_MSG_IF(retval.size() > 1,
@@ -299,38 +314,37 @@ Ipv6EndPointDemux::Lookup(Ipv6Address daddr,
 Ipv6EndPoint*
 Ipv6EndPointDemux::SimpleLookup(Ipv6Address dst, uint16_t dport, Ipv6Address src, uint16_t sport)
 {
+    auto exact = m_index.find(Key{dst, dport, src, sport});
+    if (exact != m_index.end())
+    {
+        /* this is an exact match. */
+        return exact->second.front();
+    }
+
+    auto port = m_ports.find(dport);
+    if (port == m_ports.end())
+    {
+        return nullptr;
+    }
     uint32_t genericity = 3;
     Ipv6EndPoint* generic = nullptr;
-
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    for (auto endPoint : port->second)
     {
         uint32_t tmp = 0;
 
-        if ((*i)->GetLocalPort() != dport)
-        {
-            continue;
-        }
-
-        if ((*i)->GetLocalAddress() == dst && (*i)->GetPeerPort() == sport &&
-            (*i)->GetPeerAddress() == src)
-        {
-            /* this is an exact match. */
-            return *i;
-        }
-
-        if ((*i)->GetLocalAddress() == Ipv6Address::GetAny())
+        if (endPoint->GetLocalAddress() == Ipv6Address::GetAny())
         {
             tmp++;
         }
 
-        if ((*i)->GetPeerAddress() == Ipv6Address::GetAny())
+        if (endPoint->GetPeerAddress() == Ipv6Address::GetAny())
         {
             tmp++;
         }
 
         if (tmp < genericity)
         {
-            generic = (*i);
+            generic = endPoint;
             genericity = tmp;
         }
     }
@@ -15,6 +15,8 @@
 
 #include <list>
 #include <stdint.h>
+#include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
@@ -25,6 +27,11 @@ class Ipv6EndPoint;
  * @ingroup ipv6
  *
  * @brief Demultiplexer for end points.
+ *
+ * The endpoints are indexed in hash tables by local port, and by local and
+ * peer addresses and ports, so that the cost of a lookup does not depend on
+ * the number of endpoints. The endpoints notify the demux when their local
+ * address or peer is changed.
  */
 class Ipv6EndPointDemux
 {
@@ -150,6 +157,75 @@ class Ipv6EndPointDemux
     EndPoints GetEndPoints() const;
 
   private:
+    friend class Ipv6EndPoint;
+
+    /**
+     * @brief The local and peer addresses and ports of an endpoint.
+     *
+     * The peer address and port are wildcards (any address and port 0)
+     * until the endpoint is connected.
+     */
+    struct Key
+    {
+        Ipv6Address localAddress; //!< local address
+        uint16_t localPort;       //!< local port
+        Ipv6Address peerAddress;  //!< peer address
+        uint16_t peerPort;        //!< peer port
+
+        /**
+         * @brief Comparison operator.
+         * @param other the key to compare to
+         * @return true if the keys are equal
+         */
+        bool operator==(const Key& other) const = default;
+    };
+
+    /**
+     * @brief Hash function of a Key.
+     */
+    struct KeyHash
+    {
+        /**
+         * @brief Hash a key.
+         * @param key the key
+         * @return the hash
+         */
+        std::size_t operator()(const Key& key) const;
+    };
+
+    /**
+     * @brief Add an endpoint to the list and to the indexes.
+     * @param endPoint the endpoint
+     * @return the endpoint
+     */
+    Ipv6EndPoint* Insert(Ipv6EndPoint* endPoint);
+
+    /**
+     * @brief Index an endpoint by its current addresses and ports.
+     *
+     * Called by the endpoint when its address or peer has been changed.
+     * @param endPoint the endpoint
+     */
+    void Index(Ipv6EndPoint* endPoint);
+
+    /**
+     * @brief Remove an endpoint from the index of its current addresses and ports.
+     *
+     * Called by the endpoint before its address or peer is changed.
+     * @param endPoint the endpoint
+     */
+    void Unindex(Ipv6EndPoint* endPoint);
+
+    /**
+     * @brief Append the endpoints indexed with a key that can receive a packet.
+     * @param key the key
+     * @param incomingInterface the incoming interface of the packet
+     * @param endPoints the list to append the endpoints to
+     */
+    void Collect(const Key& key,
+                 Ptr<Ipv6Interface> incomingInterface,
+                 EndPoints& endPoints) const;
+
     /**
      * @brief Allocate a ephemeral port.
      * @return a port
@@ -175,6 +251,16 @@ class Ipv6EndPointDemux
      * @brief A list of IPv6 end points.
      */
     EndPoints m_endPoints;
+
+    /**
+     * @brief The endpoints, by local and peer addresses and ports.
+     */
+    std::unordered_map<Key, std::vector<Ipv6EndPoint*>, KeyHash> m_index;
+
+    /**
+     * @brief The endpoints, by local port.
+     */
+    std::unordered_map<uint16_t, std::vector<Ipv6EndPoint*>> m_ports;
 };
 
 } /* namespace ns3 */
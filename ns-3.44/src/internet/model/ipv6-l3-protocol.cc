@@ -29,6 +29,7 @@
 #include "ns3/mac64-address.h"
 #include "ns3/node.h"
 #include "ns3/object-vector.h"
+#include "ns3/segmentation-offload-tag.h"
 #include "ns3/trace-source-accessor.h"
 #include "ns3/traffic-control-layer.h"
 #include "ns3/uinteger.h"
@@ -1217,10 +1218,16 @@ Ipv6L3Protocol::SendRealOut(Ptr<Ipv6Route> route, Ptr<Packet> packet, const Ipv6
         targetMtu = dev->GetMtu();
     }
 
-    if (packet->GetSize() + ipHeader.GetSerializedSize() > targetMtu)
+    // The super-segments of segmentation offload are not fragmented when the
+    // device supports it
+    SegmentationOffloadTag offloadTag;
+    bool isSuperSegment = packet->PeekPacketTag(offloadTag);
+    if (packet->GetSize() + ipHeader.GetSerializedSize() > targetMtu &&
+        !(isSuperSegment && dev->SupportsSegmentationOffload()))
     {
-        // Router => drop
-        if (!fromMe)
+        // Router => drop, unless the packet is a super-segment, standing for
+        // segments which would fit in the MTU: it is fragmented instead
+        if (!fromMe && !isSuperSegment)
         {
             Ptr<Icmpv6L4Protocol> icmpv6 = GetIcmpv6();
             if (icmpv6)
@@ -0,0 +1,111 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef IPV6_PREFIX_TRIE_H
+#define IPV6_PREFIX_TRIE_H
+
+#include "prefix-trie.h"
+
+#include "ns3/ipv6-address.h"
+
+namespace ns3
+{
+
+/**
+ * @ingroup ipv6Routing
+ *
+ * @brief Path-compressed binary trie indexing values by IPv6 prefix.
+ *
+ * The prefixes matching an address are found by walking at most 129 nodes,
+ * and in practice a few nodes only.
+ *
+ * @see PrefixTrie
+ *
+ * @tparam T \explicit Type of the values
+ */
+template <typename T>
+class Ipv6PrefixTrie : public PrefixTrie<T, 128>
+{
+  public:
+    /**
+     * @brief Append a value to the list of a prefix.
+     *
+     * @param network the network address of the prefix
+     * @param prefix the prefix
+     * @param value the value
+     */
+    void Insert(Ipv6Address network, Ipv6Prefix prefix, const T& value)
+    {
+        PrefixTrie<T, 128>::Insert(KeyOf(network), KeyOf(prefix), value);
+    }
+
+    /**
+     * @brief Remove a value from the list of a prefix.
+     *
+     * @param network the network address of the prefix
+     * @param prefix the prefix
+     * @param value the value
+     * @returns true if the value was found
+     */
+    bool Remove(Ipv6Address network, Ipv6Prefix prefix, const T& value)
+    {
+        return PrefixTrie<T, 128>::Remove(KeyOf(network), KeyOf(prefix), value);
+    }
+
+    /**
+     * @brief Find the values of all the prefixes matching an address.
+     *
+     * @param address the address
+     * @returns the values of the prefixes matching the address, in insertion
+     * order, or a null pointer if no prefix matches the address
+     */
+    const std::vector<T>* FindMatches(Ipv6Address address) const
+    {
+        return PrefixTrie<T, 128>::FindMatches(KeyOf(address));
+    }
+
+    /**
+     * @brief Visit the lists of the prefixes matching an address, longest prefix first.
+     *
+     * @tparam Visitor \deduced the type of the visitor
+     * @param address the address
+     * @param visitor a callable taking a const std::vector<T>& and returning a bool
+     * @returns true if the visitor returned true
+     */
+    template <typename Visitor>
+    bool VisitMatches(Ipv6Address address, Visitor visitor) const
+    {
+        return PrefixTrie<T, 128>::VisitMatches(KeyOf(address), visitor);
+    }
+
+  private:
+    /// An address or a prefix, in network byte order
+    typedef typename PrefixTrie<T, 128>::Key Key;
+
+    /**
+     * @param address an address
+     * @returns the bytes of the address
+     */
+    static Key KeyOf(Ipv6Address address)
+    {
+        Key key;
+        address.GetBytes(key.data());
+        return key;
+    }
+
+    /**
+     * @param prefix a prefix
+     * @returns the bytes of the prefix
+     */
+    static Key KeyOf(Ipv6Prefix prefix)
+    {
+        Key key;
+        prefix.GetBytes(key.data());
+        return key;
+    }
+};
+
+} // namespace ns3
+
+#endif /* IPV6_PREFIX_TRIE_H */
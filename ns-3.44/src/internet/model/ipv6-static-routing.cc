@@ -17,6 +17,7 @@
 #include "ns3/node.h"
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
+#include "ns3/uinteger.h"
 
 #include <iomanip>
 
@@ -30,15 +31,24 @@ NS_OBJECT_ENSURE_REGISTERED(Ipv6StaticRouting);
 TypeId
 Ipv6StaticRouting::GetTypeId()
 {
-    static TypeId tid = TypeId("ns3::Ipv6StaticRouting")
-                            .SetParent<Ipv6RoutingProtocol>()
-                            .SetGroupName("Internet")
-                            .AddConstructor<Ipv6StaticRouting>();
+    static TypeId tid =
+        TypeId("ns3::Ipv6StaticRouting")
+            .SetParent<Ipv6RoutingProtocol>()
+            .SetGroupName("Internet")
+            .AddConstructor<Ipv6StaticRouting>()
+            .AddAttribute("RouteCacheSize",
+                          "The maximum number of destinations whose selected route is cached. "
+                          "The cache is flushed when it is full and whenever a route is added "
+                          "or removed. Zero disables the cache.",
+                          UintegerValue(1024),
+                          MakeUintegerAccessor(&Ipv6StaticRouting::m_routeCacheSize),
+                          MakeUintegerChecker<uint32_t>());
     return tid;
 }
 
 Ipv6StaticRouting::Ipv6StaticRouting()
-    : m_ipv6(nullptr)
+    : m_routeCacheSize(0),
+      m_ipv6(nullptr)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -170,8 +180,7 @@ Ipv6StaticRouting::AddNetworkRouteTo(Ipv6Address network,
 
     if (!LookupRoute(route, metric))
     {
-        auto routePtr = new Ipv6RoutingTableEntry(route);
-        m_networkRoutes.emplace_back(routePtr, metric);
+        InsertNetworkRoute(new Ipv6RoutingTableEntry(route), metric);
     }
 }
 
@@ -197,8 +206,7 @@ Ipv6StaticRouting::AddNetworkRouteTo(Ipv6Address network,
                                                                               prefixToUse);
     if (!LookupRoute(route, metric))
     {
-        auto routePtr = new Ipv6RoutingTableEntry(route);
-        m_networkRoutes.emplace_back(routePtr, metric);
+        InsertNetworkRoute(new Ipv6RoutingTableEntry(route), metric);
     }
 }
 
@@ -214,8 +222,7 @@ Ipv6StaticRouting::AddNetworkRouteTo(Ipv6Address network,
         Ipv6RoutingTableEntry::CreateNetworkRouteTo(network, networkPrefix, interface);
     if (!LookupRoute(route, metric))
     {
-        auto routePtr = new Ipv6RoutingTableEntry(route);
-        m_networkRoutes.emplace_back(routePtr, metric);
+        InsertNetworkRoute(new Ipv6RoutingTableEntry(route), metric);
     }
 }
 
@@ -257,7 +264,7 @@ Ipv6StaticRouting::SetDefaultMulticastRoute(uint32_t outputInterface)
     Ipv6Address network = Ipv6Address("ff00::"); /* RFC 3513 */
     Ipv6Prefix networkMask = Ipv6Prefix(8);
     *route = Ipv6RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, outputInterface);
-    m_networkRoutes.emplace_back(route, 0);
+    InsertNetworkRoute(route, 0);
 }
 
 uint32_t
@@ -332,40 +339,117 @@ Ipv6StaticRouting::HasNetworkDest(Ipv6Address network, uint32_t interfaceIndex)
 {
     NS_LOG_FUNCTION(this << network << interfaceIndex);
 
-    /* in the network table */
-    for (auto j = m_networkRoutes.begin(); j != m_networkRoutes.end(); j++)
-    {
-        Ipv6RoutingTableEntry* rtentry = j->first;
-        Ipv6Prefix prefix = rtentry->GetDestNetworkPrefix();
-        Ipv6Address entry = rtentry->GetDestNetwork();
+    return m_networkRouteTrie.VisitMatches(
+        network,
+        [interfaceIndex](const std::vector<std::pair<Ipv6RoutingTableEntry*, uint32_t>>& routes) {
+            for (const auto& route : routes)
+            {
+                if (route.first->GetInterface() == interfaceIndex)
+                {
+                    return true;
+                }
+            }
+            return false;
+        });
+}
 
-        if (prefix.IsMatch(network, entry) && rtentry->GetInterface() == interfaceIndex)
-        {
-            return true;
-        }
-    }
+void
+Ipv6StaticRouting::InsertNetworkRoute(Ipv6RoutingTableEntry* route, uint32_t metric)
+{
+    NS_LOG_FUNCTION(this << *route << metric);
+    m_networkRoutes.emplace_back(route, metric);
+    m_networkRouteTrie.Insert(route->GetDestNetwork(),
+                              route->GetDestNetworkPrefix(),
+                              m_networkRoutes.back());
+    m_routeCache.clear();
+}
 
-    /* beuh!!! not route at all */
-    return false;
+Ipv6StaticRouting::NetworkRoutesI
+Ipv6StaticRouting::EraseNetworkRoute(NetworkRoutesI it)
+{
+    NS_LOG_FUNCTION(this << *it->first << it->second);
+    [[maybe_unused]] bool found = m_networkRouteTrie.Remove(it->first->GetDestNetwork(),
+                                                            it->first->GetDestNetworkPrefix(),
+                                                            *it);
+    NS_ASSERT_MSG(found, "Route " << *it->first << " is not indexed");
+    m_routeCache.clear();
+    delete it->first;
+    return m_networkRoutes.erase(it);
 }
 
 bool
 Ipv6StaticRouting::LookupRoute(const Ipv6RoutingTableEntry& route, uint32_t metric)
 {
-    for (auto j = m_networkRoutes.begin(); j != m_networkRoutes.end(); j++)
+    // the routes to the prefix of the route are among the routes matching its destination
+    return m_networkRouteTrie.VisitMatches(
+        route.GetDest(),
+        [&route, metric](const std::vector<std::pair<Ipv6RoutingTableEntry*, uint32_t>>& routes) {
+            for (const auto& [rtentry, rtmetric] : routes)
+            {
+                if (rtentry->GetDest() == route.GetDest() &&
+                    rtentry->GetDestNetworkPrefix() == route.GetDestNetworkPrefix() &&
+                    rtentry->GetGateway() == route.GetGateway() &&
+                    rtentry->GetInterface() == route.GetInterface() &&
+                    rtentry->GetPrefixToUse() == route.GetPrefixToUse() && rtmetric == metric)
+                {
+                    return true;
+                }
+            }
+            return false;
+        });
+}
+
+Ipv6RoutingTableEntry*
+Ipv6StaticRouting::FindRoute(Ipv6Address dest, Ptr<NetDevice> interface)
+{
+    NS_LOG_FUNCTION(this << dest << interface);
+    bool cacheable = !interface && m_routeCacheSize > 0;
+    if (cacheable)
     {
-        Ipv6RoutingTableEntry* rtentry = j->first;
+        auto it = m_routeCache.find(dest);
+        if (it != m_routeCache.end())
+        {
+            NS_LOG_LOGIC("Route to " << dest << " found in the route cache");
+            return it->second;
+        }
+    }
+
+    // among the routes to the longest matching prefix that has routes on the
+    // requested interface, select the one with the lowest metric, the last
+    // added one on a tie
+    Ipv6RoutingTableEntry* result = nullptr;
+    uint32_t shortestMetric = 0xffffffff;
+    m_networkRouteTrie.VisitMatches(
+        dest,
+        [this, interface, &result, &shortestMetric](
+            const std::vector<std::pair<Ipv6RoutingTableEntry*, uint32_t>>& routes) {
+            for (const auto& [route, metric] : routes)
+            {
+                NS_LOG_LOGIC("Found network route " << *route << ", metric " << metric);
+                if (interface && interface != m_ipv6->GetNetDevice(route->GetInterface()))
+                {
+                    NS_LOG_LOGIC("Not on requested interface, skipping");
+                    continue;
+                }
+                if (metric <= shortestMetric)
+                {
+                    shortestMetric = metric;
+                    result = route;
+                }
+            }
+            return result != nullptr;
+        });
 
-        if (rtentry->GetDest() == route.GetDest() &&
-            rtentry->GetDestNetworkPrefix() == route.GetDestNetworkPrefix() &&
-            rtentry->GetGateway() == route.GetGateway() &&
-            rtentry->GetInterface() == route.GetInterface() &&
-            rtentry->GetPrefixToUse() == route.GetPrefixToUse() && j->second == metric)
+    if (cacheable)
+    {
+        if (m_routeCache.size() >= m_routeCacheSize)
         {
-            return true;
+            NS_LOG_LOGIC("Route cache full, flushing it");
+            m_routeCache.clear();
         }
+        m_routeCache[dest] = result;
     }
-    return false;
+    return result;
 }
 
 Ptr<Ipv6Route>
@@ -373,8 +457,6 @@ Ipv6StaticRouting::LookupStatic(Ipv6Address dst, Ptr<NetDevice> interface)
 {
     NS_LOG_FUNCTION(this << dst << interface);
     Ptr<Ipv6Route> rtentry = nullptr;
-    uint16_t longestMask = 0;
-    uint32_t shortestMetric = 0xffffffff;
 
     /* when sending on link-local multicast, there have to be interface specified */
     if (dst.IsLinkLocalMulticast())
@@ -391,70 +473,27 @@ Ipv6StaticRouting::LookupStatic(Ipv6Address dst, Ptr<NetDevice> interface)
         return rtentry;
     }
 
-    for (auto it = m_networkRoutes.begin(); it != m_networkRoutes.end(); it++)
+    Ipv6RoutingTableEntry* route = FindRoute(dst, interface);
+    if (route)
     {
-        Ipv6RoutingTableEntry* j = it->first;
-        uint32_t metric = it->second;
-        Ipv6Prefix mask = j->GetDestNetworkPrefix();
-        uint16_t maskLen = mask.GetPrefixLength();
-        Ipv6Address entry = j->GetDestNetwork();
-
-        NS_LOG_LOGIC("Searching for route to " << dst << ", mask length " << maskLen << ", metric "
-                                               << metric);
+        uint32_t interfaceIdx = route->GetInterface();
+        rtentry = Create<Ipv6Route>();
 
-        if (mask.IsMatch(dst, entry))
+        if (route->GetGateway().IsAny() || !route->GetDest().IsAny())
         {
-            NS_LOG_LOGIC("Found global network route " << *j << ", mask length " << maskLen
-                                                       << ", metric " << metric);
-
-            /* if interface is given, check the route will output on this interface */
-            if (!interface || interface == m_ipv6->GetNetDevice(j->GetInterface()))
-            {
-                if (maskLen < longestMask)
-                {
-                    NS_LOG_LOGIC("Previous match longer, skipping");
-                    continue;
-                }
-
-                if (maskLen > longestMask)
-                {
-                    shortestMetric = 0xffffffff;
-                }
-
-                longestMask = maskLen;
-                if (metric > shortestMetric)
-                {
-                    NS_LOG_LOGIC("Equal mask length, but previous metric shorter, skipping");
-                    continue;
-                }
-
-                shortestMetric = metric;
-                Ipv6RoutingTableEntry* route = j;
-                uint32_t interfaceIdx = route->GetInterface();
-                rtentry = Create<Ipv6Route>();
-
-                if (route->GetGateway().IsAny() || !route->GetDest().IsAny())
-                {
-                    rtentry->SetSource(
-                        m_ipv6->SourceAddressSelection(interfaceIdx, route->GetDest()));
-                }
-                else
-                {
-                    // Default route
-                    rtentry->SetSource(m_ipv6->SourceAddressSelection(
-                        interfaceIdx,
-                        route->GetPrefixToUse().IsAny() ? dst : route->GetPrefixToUse()));
-                }
-
-                rtentry->SetDestination(route->GetDest());
-                rtentry->SetGateway(route->GetGateway());
-                rtentry->SetOutputDevice(m_ipv6->GetNetDevice(interfaceIdx));
-                if (maskLen == 128)
-                {
-                    break;
-                }
-            }
+            rtentry->SetSource(m_ipv6->SourceAddressSelection(interfaceIdx, route->GetDest()));
         }
+        else
+        {
+            // Default route
+            rtentry->SetSource(m_ipv6->SourceAddressSelection(
+                interfaceIdx,
+                route->GetPrefixToUse().IsAny() ? dst : route->GetPrefixToUse()));
+        }
+
+        rtentry->SetDestination(route->GetDest());
+        rtentry->SetGateway(route->GetGateway());
+        rtentry->SetOutputDevice(m_ipv6->GetNetDevice(interfaceIdx));
     }
 
     if (rtentry)
@@ -475,6 +514,8 @@ Ipv6StaticRouting::DoDispose()
         delete j->first;
     }
     m_networkRoutes.clear();
+    m_networkRouteTrie.Clear();
+    m_routeCache.clear();
 
     for (auto i = m_multicastRoutes.begin(); i != m_multicastRoutes.end();
          i = m_multicastRoutes.erase(i))
@@ -632,8 +673,7 @@ Ipv6StaticRouting::RemoveRoute(uint32_t index)
     {
         if (tmp == index)
         {
-            delete it->first;
-            m_networkRoutes.erase(it);
+            EraseNetworkRoute(it);
             return;
         }
         tmp++;
@@ -655,8 +695,7 @@ Ipv6StaticRouting::RemoveRoute(Ipv6Address network,
         if (network == rtentry->GetDest() && rtentry->GetInterface() == ifIndex &&
             rtentry->GetPrefixToUse() == prefixToUse)
         {
-            delete it->first;
-            m_networkRoutes.erase(it);
+            EraseNetworkRoute(it);
             return;
         }
     }
@@ -797,8 +836,7 @@ Ipv6StaticRouting::NotifyInterfaceDown(uint32_t i)
     {
         if (it->first->GetInterface() == i)
         {
-            delete it->first;
-            it = m_networkRoutes.erase(it);
+            it = EraseNetworkRoute(it);
         }
         else
         {
@@ -835,8 +873,7 @@ Ipv6StaticRouting::NotifyRemoveAddress(uint32_t interface, Ipv6InterfaceAddress
             it->first->GetDestNetwork() == networkAddress &&
             it->first->GetDestNetworkPrefix() == networkMask)
         {
-            delete it->first;
-            it = m_networkRoutes.erase(it);
+            it = EraseNetworkRoute(it);
         }
         else
         {
@@ -893,8 +930,7 @@ Ipv6StaticRouting::NotifyRemoveRoute(Ipv6Address dst,
 
             if (dst == entry && prefix == mask && rtentry->GetInterface() == interface)
             {
-                delete j->first;
-                j = m_networkRoutes.erase(j);
+                j = EraseNetworkRoute(j);
             }
             else
             {
@@ -10,6 +10,7 @@
 #define IPV6_STATIC_ROUTING_H
 
 #include "ipv6-header.h"
+#include "ipv6-prefix-trie.h"
 #include "ipv6-routing-protocol.h"
 #include "ipv6.h"
 
@@ -18,6 +19,7 @@
 
 #include <list>
 #include <stdint.h>
+#include <unordered_map>
 
 namespace ns3
 {
@@ -45,6 +47,13 @@ class Ipv6MulticastRoutingTableEntry;
  * Ipv6RoutingProtocol that defines the interface methods that a routing
  * protocol must support.
  *
+ * The unicast routes are looked up in a prefix trie: the selected route is
+ * one of the routes to the longest prefix matching the destination (and
+ * going through the requested output device, if any), the one with the
+ * lowest metric or, on a tie, the last added one. The route selected for
+ * each destination is cached, up to RouteCacheSize destinations, and the
+ * cache is flushed whenever a route is added or removed.
+ *
  * @see Ipv6RoutingProtocol
  * @see Ipv6ListRouting
  * @see Ipv6ListRouting::AddRoutingProtocol
@@ -295,6 +304,31 @@ class Ipv6StaticRouting : public Ipv6RoutingProtocol
     /// Iterator for container for the multicast routes
     typedef std::list<Ipv6MulticastRoutingTableEntry*>::iterator MulticastRoutesI;
 
+    /// Prefix trie of the network routes and their metric
+    typedef Ipv6PrefixTrie<std::pair<Ipv6RoutingTableEntry*, uint32_t>> NetworkRouteTrie;
+
+    /**
+     * @brief Add a route to the forwarding table.
+     * @param route the route, now owned by the forwarding table
+     * @param metric metric of route
+     */
+    void InsertNetworkRoute(Ipv6RoutingTableEntry* route, uint32_t metric);
+
+    /**
+     * @brief Remove a route from the forwarding table and delete it.
+     * @param it the route
+     * @return the route following the removed one
+     */
+    NetworkRoutesI EraseNetworkRoute(NetworkRoutesI it);
+
+    /**
+     * @brief Select the route to a destination, in the route cache or in the prefix trie.
+     * @param dest destination address
+     * @param interface output interface if any (put 0 otherwise)
+     * @return the selected route, or nullptr if there is no route
+     */
+    Ipv6RoutingTableEntry* FindRoute(Ipv6Address dest, Ptr<NetDevice> interface);
+
     /**
      * @brief Checks if a route is already present in the forwarding table.
      * @param route route
@@ -325,6 +359,21 @@ class Ipv6StaticRouting : public Ipv6RoutingProtocol
      */
     NetworkRoutes m_networkRoutes;
 
+    /**
+     * @brief the network routes, by prefix.
+     */
+    NetworkRouteTrie m_networkRouteTrie;
+
+    /**
+     * @brief the route selected for each destination looked up without output interface.
+     */
+    std::unordered_map<Ipv6Address, Ipv6RoutingTableEntry*, Ipv6AddressHash> m_routeCache;
+
+    /**
+     * @brief the maximum number of destinations in the route cache.
+     */
+    uint32_t m_routeCacheSize;
+
     /**
      * @brief the forwarding table for multicast.
      */
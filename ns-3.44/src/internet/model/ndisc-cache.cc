@@ -15,8 +15,11 @@
 #include "ns3/log.h"
 #include "ns3/names.h"
 #include "ns3/node.h"
+#include "ns3/simulator.h"
 #include "ns3/uinteger.h"
 
+#include <algorithm>
+
 namespace ns3
 {
 
@@ -39,6 +42,7 @@ NdiscCache::GetTypeId()
 }
 
 NdiscCache::NdiscCache()
+    : m_nudSequence(0)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -90,9 +94,10 @@ NdiscCache::Lookup(Ipv6Address dst)
 {
     NS_LOG_FUNCTION(this << dst);
 
-    if (m_ndCache.find(dst) != m_ndCache.end())
+    auto it = m_ndCache.find(dst);
+    if (it != m_ndCache.end())
     {
-        NdiscCache::Entry* entry = m_ndCache[dst];
+        NdiscCache::Entry* entry = it->second;
         NS_LOG_LOGIC("Found an entry: " << *entry);
 
         return entry;
@@ -107,14 +112,11 @@ NdiscCache::LookupInverse(Address dst)
     NS_LOG_FUNCTION(this << dst);
 
     std::list<NdiscCache::Entry*> entryList;
-    for (auto i = m_ndCache.begin(); i != m_ndCache.end(); i++)
+    auto range = m_macIndex.equal_range(dst);
+    for (auto i = range.first; i != range.second; i++)
     {
-        NdiscCache::Entry* entry = (*i).second;
-        if (entry->GetMacAddress() == dst)
-        {
-            NS_LOG_LOGIC("Found an entry:" << (*entry));
-            entryList.push_back(entry);
-        }
+        NS_LOG_LOGIC("Found an entry:" << (*i->second));
+        entryList.push_back(i->second);
     }
     return entryList;
 }
@@ -127,7 +129,7 @@ NdiscCache::Add(Ipv6Address to)
 
     auto entry = new NdiscCache::Entry(this);
     entry->SetIpv6Address(to);
-    m_ndCache[to] = entry;
+    m_ndCache.emplace(to, entry);
     return entry;
 }
 
@@ -136,15 +138,13 @@ NdiscCache::Remove(NdiscCache::Entry* entry)
 {
     NS_LOG_FUNCTION(this << entry);
 
-    for (auto i = m_ndCache.begin(); i != m_ndCache.end(); i++)
+    auto i = m_ndCache.find(entry->GetIpv6Address());
+    if (i != m_ndCache.end() && i->second == entry)
     {
-        if ((*i).second == entry)
-        {
-            m_ndCache.erase(i);
-            entry->ClearWaitingPacket();
-            delete entry;
-            return;
-        }
+        m_ndCache.erase(i);
+        UnindexMacAddress(entry);
+        entry->ClearWaitingPacket();
+        delete entry;
     }
 }
 
@@ -159,6 +159,94 @@ NdiscCache::Flush()
     }
 
     m_ndCache.erase(m_ndCache.begin(), m_ndCache.end());
+    m_macIndex.clear();
+    m_nudTimers = {};
+    m_nudEvent.Cancel();
+}
+
+void
+NdiscCache::IndexMacAddress(NdiscCache::Entry* entry)
+{
+    NS_LOG_FUNCTION(this << entry);
+    if (!entry->GetMacAddress().IsInvalid())
+    {
+        m_macIndex.emplace(entry->GetMacAddress(), entry);
+    }
+}
+
+void
+NdiscCache::UnindexMacAddress(NdiscCache::Entry* entry)
+{
+    NS_LOG_FUNCTION(this << entry);
+    auto range = m_macIndex.equal_range(entry->GetMacAddress());
+    for (auto i = range.first; i != range.second; i++)
+    {
+        if (i->second == entry)
+        {
+            m_macIndex.erase(i);
+            return;
+        }
+    }
+}
+
+void
+NdiscCache::QueueNudTimer(NdiscCache::Entry* entry)
+{
+    NS_LOG_FUNCTION(this << entry);
+    if (entry->m_nudExpiry >= entry->m_nudQueued)
+    {
+        // the timer is queued earlier, and will be queued again when handled
+        return;
+    }
+    entry->m_nudQueued = entry->m_nudExpiry;
+    m_nudTimers.emplace(entry->m_nudExpiry, m_nudSequence++, entry->GetIpv6Address());
+    if (std::get<1>(m_nudTimers.top()) == m_nudSequence - 1)
+    {
+        // the timer is the earliest one
+        m_nudEvent.Cancel();
+        m_nudEvent = Simulator::Schedule(entry->m_nudExpiry - Simulator::Now(),
+                                         &NdiscCache::HandleNudTimers,
+                                         this);
+    }
+}
+
+void
+NdiscCache::HandleNudTimers()
+{
+    NS_LOG_FUNCTION(this);
+    while (!m_nudTimers.empty() && std::get<0>(m_nudTimers.top()) <= Simulator::Now())
+    {
+        auto [queued, sequence, address] = m_nudTimers.top();
+        m_nudTimers.pop();
+        auto it = m_ndCache.find(address);
+        if (it == m_ndCache.end() || it->second->m_nudQueued != queued)
+        {
+            // stale timer
+            continue;
+        }
+        NdiscCache::Entry* entry = it->second;
+        entry->m_nudQueued = Time::Max();
+        if (entry->m_nudExpiry > Simulator::Now())
+        {
+            // the timer has been extended or stopped since it was queued
+            if (entry->m_nudExpiry != Time::Max())
+            {
+                QueueNudTimer(entry);
+            }
+            continue;
+        }
+        entry->m_nudExpiry = Time::Max();
+        // the function may remove the entry
+        (entry->*(entry->m_nudFunction))();
+    }
+    // the timers started by the functions called may have scheduled the event already
+    m_nudEvent.Cancel();
+    if (!m_nudTimers.empty())
+    {
+        m_nudEvent = Simulator::Schedule(std::get<0>(m_nudTimers.top()) - Simulator::Now(),
+                                         &NdiscCache::HandleNudTimers,
+                                         this);
+    }
 }
 
 void
@@ -181,7 +269,13 @@ NdiscCache::PrintNdiscCache(Ptr<OutputStreamWrapper> stream)
     NS_LOG_FUNCTION(this << stream);
     std::ostream* os = stream->GetStream();
 
-    for (auto i = m_ndCache.begin(); i != m_ndCache.end(); i++)
+    // print the entries in address order
+    std::vector<std::pair<Ipv6Address, NdiscCache::Entry*>> entries(m_ndCache.begin(),
+                                                                    m_ndCache.end());
+    std::sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) {
+        return a.first < b.first;
+    });
+    for (auto i = entries.begin(); i != entries.end(); i++)
     {
         *os << i->first << " dev ";
         std::string found = Names::FindName(m_device);
@@ -236,7 +330,9 @@ NdiscCache::Entry::Entry(NdiscCache* nd)
     : m_ndCache(nd),
       m_waiting(),
       m_router(false),
-      m_nudTimer(Timer::CANCEL_ON_DESTROY),
+      m_nudFunction(nullptr),
+      m_nudExpiry(Time::Max()),
+      m_nudQueued(Time::Max()),
       m_lastReachabilityConfirmation(),
       m_nsRetransmit(0)
 {
@@ -454,19 +550,23 @@ NdiscCache::Entry::GetLastReachabilityConfirmation() const
     return m_lastReachabilityConfirmation;
 }
 
+void
+NdiscCache::Entry::StartNudTimer(void (Entry::*function)(), Time delay)
+{
+    NS_LOG_FUNCTION(this << delay);
+    m_nudFunction = function;
+    m_nudDelay = delay;
+    m_nudExpiry = Simulator::Now() + delay;
+    m_ndCache->QueueNudTimer(this);
+}
+
 void
 NdiscCache::Entry::StartReachableTimer()
 {
     NS_LOG_FUNCTION(this);
-    if (m_nudTimer.IsRunning())
-    {
-        m_nudTimer.Cancel();
-    }
-
     m_lastReachabilityConfirmation = Simulator::Now();
-    m_nudTimer.SetFunction(&NdiscCache::Entry::FunctionReachableTimeout, this);
-    m_nudTimer.SetDelay(m_ndCache->m_icmpv6->GetReachableTime());
-    m_nudTimer.Schedule();
+    StartNudTimer(&NdiscCache::Entry::FunctionReachableTimeout,
+                  m_ndCache->m_icmpv6->GetReachableTime());
 }
 
 void
@@ -474,14 +574,12 @@ NdiscCache::Entry::UpdateReachableTimer()
 {
     NS_LOG_FUNCTION(this);
 
-    if (m_state == REACHABLE)
+    if (m_state == REACHABLE && m_nudFunction)
     {
         m_lastReachabilityConfirmation = Simulator::Now();
-        if (m_nudTimer.IsRunning())
-        {
-            m_nudTimer.Cancel();
-        }
-        m_nudTimer.Schedule();
+        // the timer is extended lazily, when its earlier expiry is handled
+        m_nudExpiry = Simulator::Now() + m_nudDelay;
+        m_ndCache->QueueNudTimer(this);
     }
 }
 
@@ -489,49 +587,31 @@ void
 NdiscCache::Entry::StartProbeTimer()
 {
     NS_LOG_FUNCTION(this);
-    if (m_nudTimer.IsRunning())
-    {
-        m_nudTimer.Cancel();
-    }
-
-    m_nudTimer.SetFunction(&NdiscCache::Entry::FunctionProbeTimeout, this);
-    m_nudTimer.SetDelay(m_ndCache->m_icmpv6->GetRetransmissionTime());
-    m_nudTimer.Schedule();
+    StartNudTimer(&NdiscCache::Entry::FunctionProbeTimeout,
+                  m_ndCache->m_icmpv6->GetRetransmissionTime());
 }
 
 void
 NdiscCache::Entry::StartDelayTimer()
 {
     NS_LOG_FUNCTION(this);
-    if (m_nudTimer.IsRunning())
-    {
-        m_nudTimer.Cancel();
-    }
-
-    m_nudTimer.SetFunction(&NdiscCache::Entry::FunctionDelayTimeout, this);
-    m_nudTimer.SetDelay(m_ndCache->m_icmpv6->GetDelayFirstProbe());
-    m_nudTimer.Schedule();
+    StartNudTimer(&NdiscCache::Entry::FunctionDelayTimeout,
+                  m_ndCache->m_icmpv6->GetDelayFirstProbe());
 }
 
 void
 NdiscCache::Entry::StartRetransmitTimer()
 {
     NS_LOG_FUNCTION(this);
-    if (m_nudTimer.IsRunning())
-    {
-        m_nudTimer.Cancel();
-    }
-
-    m_nudTimer.SetFunction(&NdiscCache::Entry::FunctionRetransmitTimeout, this);
-    m_nudTimer.SetDelay(m_ndCache->m_icmpv6->GetRetransmissionTime());
-    m_nudTimer.Schedule();
+    StartNudTimer(&NdiscCache::Entry::FunctionRetransmitTimeout,
+                  m_ndCache->m_icmpv6->GetRetransmissionTime());
 }
 
 void
 NdiscCache::Entry::StopNudTimer()
 {
     NS_LOG_FUNCTION(this);
-    m_nudTimer.Cancel();
+    m_nudExpiry = Time::Max();
     m_nsRetransmit = 0;
 }
 
@@ -552,7 +632,7 @@ NdiscCache::Entry::MarkReachable(Address mac)
 {
     NS_LOG_FUNCTION(this << mac);
     m_state = REACHABLE;
-    m_macAddress = mac;
+    SetMacAddress(mac);
     return m_waiting;
 }
 
@@ -582,7 +662,7 @@ NdiscCache::Entry::MarkStale(Address mac)
 {
     NS_LOG_FUNCTION(this << mac);
     m_state = STALE;
-    m_macAddress = mac;
+    SetMacAddress(mac);
     return m_waiting;
 }
 
@@ -669,7 +749,9 @@ void
 NdiscCache::Entry::SetMacAddress(Address mac)
 {
     NS_LOG_FUNCTION(this << mac << int(m_state));
+    m_ndCache->UnindexMacAddress(this);
     m_macAddress = mac;
+    m_ndCache->IndexMacAddress(this);
 }
 
 void
@@ -711,8 +793,9 @@ NdiscCache::RemoveAutoGeneratedEntries()
         if (i->second->IsAutoGenerated())
         {
             i->second->ClearWaitingPacket();
+            UnindexMacAddress(i->second);
             delete i->second;
-            m_ndCache.erase(i++);
+            i = m_ndCache.erase(i);
             continue;
         }
         i++;
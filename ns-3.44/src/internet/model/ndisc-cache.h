@@ -9,6 +9,7 @@
 #ifndef NDISC_CACHE_H
 #define NDISC_CACHE_H
 
+#include "ns3/event-id.h"
 #include "ns3/ipv6-address.h"
 #include "ns3/net-device.h"
 #include "ns3/nstime.h"
@@ -17,9 +18,14 @@
 #include "ns3/ptr.h"
 #include "ns3/timer.h"
 
+#include <functional>
 #include <list>
 #include <map>
+#include <queue>
 #include <stdint.h>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
@@ -33,6 +39,13 @@ class Icmpv6L4Protocol;
  * @ingroup ipv6
  *
  * @brief IPv6 Neighbor Discovery cache.
+ *
+ * The entries are kept in a hash table, and indexed by MAC address for the
+ * inverse lookups. The entries do not run their own NUD timers: the cache
+ * keeps their expiry times in a priority queue, and runs a single event, at
+ * the earliest expiry time, to handle the expired timers. Hence, extending
+ * the reachable timer of an entry, which is done for each reachability
+ * confirmation, only updates the expiry time of the entry.
  */
 class NdiscCache : public Object
 {
@@ -401,6 +414,8 @@ class NdiscCache : public Object
         NdiscCache* m_ndCache;
 
       private:
+        friend class NdiscCache;
+
         /**
          * @brief The IPv6 address.
          */
@@ -422,9 +437,32 @@ class NdiscCache : public Object
         bool m_router;
 
         /**
-         * @brief Timer (used for NUD).
+         * @brief Start the NUD timer.
+         * @param function the function called when the timer expires
+         * @param delay the delay of the timer
+         */
+        void StartNudTimer(void (Entry::*function)(), Time delay);
+
+        /**
+         * @brief Function called when the NUD timer expires (nullptr if none).
+         */
+        void (Entry::*m_nudFunction)();
+
+        /**
+         * @brief Delay of the NUD timer.
+         */
+        Time m_nudDelay;
+
+        /**
+         * @brief Expiry time of the NUD timer (Time::Max () if stopped).
          */
-        Timer m_nudTimer;
+        Time m_nudExpiry;
+
+        /**
+         * @brief Earliest time the entry is queued at in the NUD timer queue
+         * of the cache (Time::Max () if not queued).
+         */
+        Time m_nudQueued;
 
         /**
          * @brief Last time we see a reachability confirmation.
@@ -446,11 +484,12 @@ class NdiscCache : public Object
     /**
      * @brief Neighbor Discovery Cache container
      */
-    typedef std::map<Ipv6Address, NdiscCache::Entry*> Cache;
+    typedef std::unordered_map<Ipv6Address, NdiscCache::Entry*, Ipv6AddressHash> Cache;
     /**
      * @brief Neighbor Discovery Cache container iterator
      */
-    typedef std::map<Ipv6Address, NdiscCache::Entry*>::iterator CacheI;
+    typedef std::unordered_map<Ipv6Address, NdiscCache::Entry*, Ipv6AddressHash>::iterator
+        CacheI;
 
     /**
      * @brief A list of Entry.
@@ -458,6 +497,56 @@ class NdiscCache : public Object
     Cache m_ndCache;
 
   private:
+    /**
+     * @brief Index an entry by its MAC address, if valid.
+     * @param entry the entry
+     */
+    void IndexMacAddress(NdiscCache::Entry* entry);
+
+    /**
+     * @brief Remove an entry from the index of the MAC addresses.
+     * @param entry the entry
+     */
+    void UnindexMacAddress(NdiscCache::Entry* entry);
+
+    /**
+     * @brief Queue the NUD timer of an entry, unless it is queued earlier.
+     * @param entry the entry
+     */
+    void QueueNudTimer(NdiscCache::Entry* entry);
+
+    /**
+     * @brief Handle the NUD timers expired, and schedule the next expiry.
+     */
+    void HandleNudTimers();
+
+    /**
+     * @brief A queued NUD timer: expiry time, sequence number (to handle the
+     * timers with the same expiry time in order) and address of the entry.
+     */
+    typedef std::tuple<Time, uint64_t, Ipv6Address> NudTimer;
+
+    /**
+     * @brief The entries, by MAC address.
+     */
+    std::multimap<Address, NdiscCache::Entry*> m_macIndex;
+
+    /**
+     * @brief The NUD timers, earliest first. A timer is stale if its entry
+     * has been removed or queued at another time since.
+     */
+    std::priority_queue<NudTimer, std::vector<NudTimer>, std::greater<>> m_nudTimers;
+
+    /**
+     * @brief The sequence number of the next queued NUD timer.
+     */
+    uint64_t m_nudSequence;
+
+    /**
+     * @brief The event handling the earliest NUD timer.
+     */
+    EventId m_nudEvent;
+
     /**
      * @brief The NetDevice.
      */
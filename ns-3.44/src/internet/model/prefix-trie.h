@@ -0,0 +1,520 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef PREFIX_TRIE_H
+#define PREFIX_TRIE_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup internet
+ *
+ * @brief Path-compressed binary trie indexing values by address prefix.
+ *
+ * Each prefix (network address and contiguous mask) is associated with the
+ * list of the values inserted with that prefix, in insertion order. The
+ * trie finds the prefixes matching an address by walking at most Bits + 1
+ * nodes, whatever the number of prefixes stored, and the nodes without
+ * value and with a single child are never kept, so that its size is linear
+ * in the number of prefixes. Each prefix is also associated with the list
+ * of the values of all the prefixes containing it, in insertion order,
+ * which is updated when values are inserted and removed, so that all the
+ * values matching an address are found without merging lists.
+ *
+ * A value inserted with a non contiguous mask (e.g., 255.0.255.0) matches
+ * the addresses equal to its network address on the bits set in the mask,
+ * and the length of its prefix is the index of the last bit set in the
+ * mask, plus one. Such values cannot be stored in the trie: they are kept
+ * in a list, which the lookups scan as long as it is not empty.
+ *
+ * The trie does not own the values: a routing protocol typically keeps its
+ * routing table entries in its own containers (to number them, print them,
+ * etc.) and indexes pointers to these entries in the trie. Ipv4PrefixTrie
+ * and Ipv6PrefixTrie index the values by IPv4 and IPv6 prefix.
+ *
+ * @tparam T \explicit Type of the values
+ * @tparam Bits \explicit Number of bits of the addresses, a multiple of 8
+ */
+template <typename T, uint8_t Bits>
+class PrefixTrie
+{
+  public:
+    /// An address or a mask, in network byte order
+    typedef std::array<uint8_t, Bits / 8> Key;
+
+    PrefixTrie()
+        : m_root(std::make_unique<Node>(Key{}, 0)),
+          m_size(0),
+          m_nextRank(0)
+    {
+    }
+
+    /**
+     * @brief Append a value to the list of a prefix.
+     *
+     * @param network the network address of the prefix
+     * @param mask the network mask of the prefix
+     * @param value the value
+     */
+    void Insert(const Key& network, const Key& mask, const T& value)
+    {
+        uint8_t length = LengthOf(mask);
+        uint64_t rank = m_nextRank++;
+        ++m_size;
+        if (mask != MaskOf(length))
+        {
+            m_others.push_back({And(network, mask), mask, length, value, rank});
+            return;
+        }
+        Key key = Prefix(network, length);
+        const Node* container = nullptr;
+        Node* node = m_root.get();
+        while (node->length < length)
+        {
+            if (!node->values.empty())
+            {
+                container = node;
+            }
+            std::unique_ptr<Node>& slot = node->children[Bit(key, node->length)];
+            if (!slot)
+            {
+                slot = std::make_unique<Node>(key, length);
+                node = slot.get();
+                break;
+            }
+            uint8_t common = CommonLength(key, length, slot->prefix, slot->length);
+            if (common < slot->length)
+            {
+                // the prefix diverges from the child: insert a node at the branching point
+                auto branch = std::make_unique<Node>(Prefix(key, common), common);
+                branch->children[Bit(slot->prefix, common)] = std::move(slot);
+                slot = std::move(branch);
+            }
+            node = slot.get();
+        }
+        if (node->values.empty() && container)
+        {
+            node->matches = container->matches;
+            node->matchRanks = container->matchRanks;
+        }
+        node->values.push_back(value);
+        node->ranks.push_back(rank);
+        AddMatch(node, value, rank);
+    }
+
+    /**
+     * @brief Remove a value from the list of a prefix.
+     *
+     * @param network the network address of the prefix
+     * @param mask the network mask of the prefix
+     * @param value the value
+     * @returns true if the value was found
+     */
+    bool Remove(const Key& network, const Key& mask, const T& value)
+    {
+        uint8_t length = LengthOf(mask);
+        if (mask != MaskOf(length))
+        {
+            Key key = And(network, mask);
+            auto it = std::find_if(m_others.begin(), m_others.end(), [&](const Other& other) {
+                return other.network == key && other.mask == mask && other.value == value;
+            });
+            if (it == m_others.end())
+            {
+                return false;
+            }
+            m_others.erase(it);
+            --m_size;
+            return true;
+        }
+        Key key = Prefix(network, length);
+        std::array<Node*, Bits + 2> path;
+        std::size_t depth = 0;
+        Node* node = m_root.get();
+        while (node && node->length < length && node->prefix == Prefix(key, node->length))
+        {
+            path[depth++] = node;
+            node = node->children[Bit(key, node->length)].get();
+        }
+        if (!node || node->length != length || node->prefix != key)
+        {
+            return false;
+        }
+        auto it = std::find(node->values.begin(), node->values.end(), value);
+        if (it == node->values.end())
+        {
+            return false;
+        }
+        auto rankIt = node->ranks.begin() + (it - node->values.begin());
+        uint64_t rank = *rankIt;
+        node->values.erase(it);
+        node->ranks.erase(rankIt);
+        RemoveMatch(node, rank);
+        if (node->values.empty())
+        {
+            node->matches.clear();
+            node->matchRanks.clear();
+        }
+        --m_size;
+
+        // drop the nodes left without value and with less than two children
+        path[depth] = node;
+        for (std::size_t i = depth; i > 0 && path[i]->values.empty(); --i)
+        {
+            Node* parent = path[i - 1];
+            std::unique_ptr<Node>& slot = parent->children[Bit(path[i]->prefix, parent->length)];
+            if (slot->children[0] && slot->children[1])
+            {
+                break;
+            }
+            std::unique_ptr<Node> child =
+                std::move(slot->children[0] ? slot->children[0] : slot->children[1]);
+            slot = std::move(child);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Remove all the values.
+     */
+    void Clear()
+    {
+        m_root = std::make_unique<Node>(Key{}, 0);
+        m_others.clear();
+        m_size = 0;
+    }
+
+    /**
+     * @returns the number of values
+     */
+    std::size_t GetSize() const
+    {
+        return m_size;
+    }
+
+    /**
+     * @brief Find the values of all the prefixes matching an address.
+     *
+     * The returned list is valid until the trie is modified or looked up again.
+     *
+     * @param address the address
+     * @returns the values of the prefixes matching the address, in insertion
+     * order, or a null pointer if no prefix matches the address
+     */
+    const std::vector<T>* FindMatches(const Key& address) const
+    {
+        const Node* found = nullptr;
+        const Node* node = m_root.get();
+        while (node && node->prefix == Prefix(address, node->length))
+        {
+            if (!node->values.empty())
+            {
+                found = node;
+            }
+            if (node->length == Bits)
+            {
+                break;
+            }
+            node = node->children[Bit(address, node->length)].get();
+        }
+        if (m_others.empty())
+        {
+            return found ? &found->matches : nullptr;
+        }
+
+        // merge the matching values inserted with a non contiguous mask
+        m_scratch.clear();
+        std::size_t i = 0;
+        std::size_t n = found ? found->matches.size() : 0;
+        for (const auto& other : m_others)
+        {
+            if (And(address, other.mask) == other.network)
+            {
+                for (; i < n && found->matchRanks[i] < other.rank; ++i)
+                {
+                    m_scratch.push_back(found->matches[i]);
+                }
+                m_scratch.push_back(other.value);
+            }
+        }
+        for (; i < n; ++i)
+        {
+            m_scratch.push_back(found->matches[i]);
+        }
+        return m_scratch.empty() ? nullptr : &m_scratch;
+    }
+
+    /**
+     * @brief Visit the lists of the prefixes matching an address, longest prefix first.
+     *
+     * The visitor is called with the (non empty) list of values of each
+     * matching prefix, in insertion order, and the visit stops when it
+     * returns true.
+     *
+     * @tparam Visitor \deduced the type of the visitor
+     * @param address the address
+     * @param visitor a callable taking a const std::vector<T>& and returning a bool
+     * @returns true if the visitor returned true
+     */
+    template <typename Visitor>
+    bool VisitMatches(const Key& address, Visitor visitor) const
+    {
+        std::array<const Node*, Bits + 1> matches;
+        std::size_t n = 0;
+        const Node* node = m_root.get();
+        while (node && node->prefix == Prefix(address, node->length))
+        {
+            if (!node->values.empty())
+            {
+                matches[n++] = node;
+            }
+            if (node->length == Bits)
+            {
+                break;
+            }
+            node = node->children[Bit(address, node->length)].get();
+        }
+        if (m_others.empty())
+        {
+            while (n > 0)
+            {
+                if (visitor(matches[--n]->values))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // visit the matching values inserted with a non contiguous mask along
+        // with the values of the prefix of the same length, if any
+        for (int length = Bits; length >= 0; --length)
+        {
+            const Node* match = nullptr;
+            if (n > 0 && matches[n - 1]->length == length)
+            {
+                match = matches[--n];
+            }
+            m_scratch.clear();
+            std::size_t i = 0;
+            for (const auto& other : m_others)
+            {
+                if (other.length == length && And(address, other.mask) == other.network)
+                {
+                    for (; match && i < match->values.size() && match->ranks[i] < other.rank; ++i)
+                    {
+                        m_scratch.push_back(match->values[i]);
+                    }
+                    m_scratch.push_back(other.value);
+                }
+            }
+            for (; match && i < match->values.size(); ++i)
+            {
+                m_scratch.push_back(match->values[i]);
+            }
+            if (!m_scratch.empty() && visitor(std::as_const(m_scratch)))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+  private:
+    /// A node of the trie
+    struct Node
+    {
+        /**
+         * Constructor
+         * @param p the prefix
+         * @param l the prefix length
+         */
+        Node(const Key& p, uint8_t l)
+            : prefix(p),
+              length(l)
+        {
+        }
+
+        Key prefix;                                    //!< the prefix, host bits cleared
+        uint8_t length;                                //!< the prefix length
+        std::vector<T> values;                         //!< the values of the prefix
+        std::vector<uint64_t> ranks;                   //!< the insertion ranks of the values
+        std::vector<T> matches;                        //!< the values of the containing prefixes
+        std::vector<uint64_t> matchRanks;              //!< the insertion ranks of the matches
+        std::array<std::unique_ptr<Node>, 2> children; //!< children, by value of the next bit
+    };
+
+    /// A value inserted with a non contiguous mask
+    struct Other
+    {
+        Key network;    //!< the network address, host bits cleared
+        Key mask;       //!< the network mask
+        uint8_t length; //!< the length of the prefix
+        T value;        //!< the value
+        uint64_t rank;  //!< the insertion rank of the value
+    };
+
+    /**
+     * @brief Append a value to the lists of the matching values of the nodes
+     * with values in a subtree.
+     *
+     * @param node the root of the subtree
+     * @param value the value
+     * @param rank the insertion rank of the value, greater than those of the listed values
+     */
+    static void AddMatch(Node* node, const T& value, uint64_t rank)
+    {
+        if (!node->values.empty())
+        {
+            node->matches.push_back(value);
+            node->matchRanks.push_back(rank);
+        }
+        for (auto& child : node->children)
+        {
+            if (child)
+            {
+                AddMatch(child.get(), value, rank);
+            }
+        }
+    }
+
+    /**
+     * @brief Remove a value from the lists of the matching values of the nodes
+     * in a subtree.
+     *
+     * @param node the root of the subtree
+     * @param rank the insertion rank of the value
+     */
+    static void RemoveMatch(Node* node, uint64_t rank)
+    {
+        auto it = std::lower_bound(node->matchRanks.begin(), node->matchRanks.end(), rank);
+        if (it != node->matchRanks.end() && *it == rank)
+        {
+            node->matches.erase(node->matches.begin() + (it - node->matchRanks.begin()));
+            node->matchRanks.erase(it);
+        }
+        for (auto& child : node->children)
+        {
+            if (child)
+            {
+                RemoveMatch(child.get(), rank);
+            }
+        }
+    }
+
+    /**
+     * @param mask a mask
+     * @returns the index of the last bit set in the mask, plus one
+     */
+    static uint8_t LengthOf(const Key& mask)
+    {
+        for (std::size_t i = mask.size(); i > 0; --i)
+        {
+            uint8_t byte = mask[i - 1];
+            if (byte != 0)
+            {
+                uint8_t length = i * 8;
+                for (; (byte & 1) == 0; byte >>= 1)
+                {
+                    --length;
+                }
+                return length;
+            }
+        }
+        return 0;
+    }
+
+    /**
+     * @param length a prefix length
+     * @returns the contiguous mask of the given length
+     */
+    static Key MaskOf(uint8_t length)
+    {
+        Key ones;
+        ones.fill(0xff);
+        return Prefix(ones, length);
+    }
+
+    /**
+     * @param a an address
+     * @param b a mask
+     * @returns the bitwise and of the address and the mask
+     */
+    static Key And(const Key& a, const Key& b)
+    {
+        Key result;
+        for (std::size_t i = 0; i < result.size(); ++i)
+        {
+            result[i] = a[i] & b[i];
+        }
+        return result;
+    }
+
+    /**
+     * @param key an address
+     * @param length a prefix length
+     * @returns the prefix of the given length of the address
+     */
+    static Key Prefix(const Key& key, uint8_t length)
+    {
+        Key prefix{};
+        uint8_t bytes = length / 8;
+        std::copy(key.begin(), key.begin() + bytes, prefix.begin());
+        if (length % 8 != 0)
+        {
+            prefix[bytes] = key[bytes] & (0xff << (8 - length % 8));
+        }
+        return prefix;
+    }
+
+    /**
+     * @param key an address
+     * @param index the index of a bit, 0 being the most significant one
+     * @returns the bit of the address
+     */
+    static uint8_t Bit(const Key& key, uint8_t index)
+    {
+        return (key[index / 8] >> (7 - index % 8)) & 1;
+    }
+
+    /**
+     * @param a a prefix
+     * @param aLength the length of the first prefix
+     * @param b another prefix
+     * @param bLength the length of the other prefix
+     * @returns the length of the longest prefix common to both prefixes
+     */
+    static uint8_t CommonLength(const Key& a, uint8_t aLength, const Key& b, uint8_t bLength)
+    {
+        uint8_t length = std::min(aLength, bLength);
+        uint8_t same = 0;
+        while (same < length && a[same / 8] == b[same / 8])
+        {
+            same += 8;
+        }
+        while (same < length && Bit(a, same) == Bit(b, same))
+        {
+            ++same;
+        }
+        return std::min(same, length);
+    }
+
+    std::unique_ptr<Node> m_root;     //!< the root node, with a zero-length prefix
+    std::vector<Other> m_others;      //!< the values inserted with a non contiguous mask
+    std::size_t m_size;               //!< the number of values
+    uint64_t m_nextRank;              //!< the insertion rank of the next value
+    mutable std::vector<T> m_scratch; //!< the values matching the last address looked up
+};
+
+} // namespace ns3
+
+#endif /* PREFIX_TRIE_H */
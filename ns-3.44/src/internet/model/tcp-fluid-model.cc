@@ -0,0 +1,298 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "tcp-fluid-model.h"
+
+#include "ipv4-route.h"
+#include "ipv4-routing-protocol.h"
+#include "ipv4.h"
+
+#include "ns3/abort.h"
+#include "ns3/channel.h"
+#include "ns3/double.h"
+#include "ns3/log.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("TcpFluidModel");
+
+NS_OBJECT_ENSURE_REGISTERED(TcpFluidModel);
+
+/// The maximum number of hops of the path of a flow
+static const uint32_t FLUID_MAX_HOPS = 64;
+
+TypeId
+TcpFluidModel::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::TcpFluidModel")
+            .SetParent<Object>()
+            .SetGroupName("Internet")
+            .AddConstructor<TcpFluidModel>()
+            .AddAttribute("MaxUtilization",
+                          "The fraction of the data rate of the links that the fluid flows "
+                          "can use, the rest being left to the packets",
+                          DoubleValue(0.9),
+                          MakeDoubleAccessor(&TcpFluidModel::m_maxUtilization),
+                          MakeDoubleChecker<double>(0, 0.99))
+            .AddAttribute("MeanPacketSize",
+                          "The mean size of the packets of the fluid flows, in bytes, "
+                          "which sets the queueing delay they add",
+                          UintegerValue(1500),
+                          MakeUintegerAccessor(&TcpFluidModel::m_meanPacketSize),
+                          MakeUintegerChecker<uint32_t>(1));
+    return tid;
+}
+
+TcpFluidModel::TcpFluidModel()
+    : m_nextFlowId(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+TcpFluidModel::~TcpFluidModel()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+TcpFluidModel::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_flows.clear();
+    m_links.clear();
+    Object::DoDispose();
+}
+
+uint32_t
+TcpFluidModel::AddFlow(Ptr<Node> source, Ipv4Address destination, DataRate maxRate)
+{
+    NS_LOG_FUNCTION(this << source << destination << maxRate);
+
+    uint32_t flowId = m_nextFlowId++;
+    Flow flow;
+    flow.maxRate = maxRate.GetBitRate();
+    flow.rate = 0;
+    for (const auto& device : FindPath(source, destination))
+    {
+        auto it = m_links.find(device);
+        if (it == m_links.end())
+        {
+            DataRateValue dataRate;
+            if (!device->GetAttributeFailSafe("DataRate", dataRate))
+            {
+                NS_LOG_LOGIC("Device " << device << " does not limit the flows");
+                continue;
+            }
+            it = m_links.emplace(device, Link{}).first;
+            it->second.dataRate = dataRate.Get().GetBitRate();
+        }
+        it->second.flows.push_back(flowId);
+        flow.path.push_back(device);
+    }
+    m_flows.emplace(flowId, std::move(flow));
+    Update();
+    return flowId;
+}
+
+void
+TcpFluidModel::RemoveFlow(uint32_t flowId)
+{
+    NS_LOG_FUNCTION(this << flowId);
+
+    auto it = m_flows.find(flowId);
+    NS_ASSERT_MSG(it != m_flows.end(), "Unknown flow " << flowId);
+    for (const auto& device : it->second.path)
+    {
+        std::vector<uint32_t>& flows = m_links[device].flows;
+        flows.erase(std::find(flows.begin(), flows.end(), flowId));
+    }
+    m_flows.erase(it);
+    Update();
+}
+
+DataRate
+TcpFluidModel::GetFlowRate(uint32_t flowId) const
+{
+    auto it = m_flows.find(flowId);
+    NS_ASSERT_MSG(it != m_flows.end(), "Unknown flow " << flowId);
+    return DataRate(static_cast<uint64_t>(it->second.rate));
+}
+
+uint32_t
+TcpFluidModel::GetNFlows() const
+{
+    return m_flows.size();
+}
+
+DataRate
+TcpFluidModel::GetLoad(Ptr<NetDevice> device) const
+{
+    auto it = m_links.find(device);
+    return DataRate(it == m_links.end() ? 0 : static_cast<uint64_t>(it->second.load));
+}
+
+std::vector<Ptr<NetDevice>>
+TcpFluidModel::FindPath(Ptr<Node> source, Ipv4Address destination) const
+{
+    NS_LOG_FUNCTION(this << source << destination);
+
+    std::vector<Ptr<NetDevice>> path;
+    Ipv4Header header;
+    header.SetDestination(destination);
+    Ptr<Node> node = source;
+    for (uint32_t hops = 0;; hops++)
+    {
+        Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
+        NS_ABORT_MSG_UNLESS(ipv4, "Node " << node->GetId() << " has no IPv4 stack");
+        if (ipv4->GetInterfaceForAddress(destination) >= 0)
+        {
+            return path;
+        }
+        NS_ABORT_MSG_IF(hops == FLUID_MAX_HOPS, "Routing loop towards " << destination);
+
+        Socket::SocketErrno sockerr;
+        Ptr<Ipv4Route> route =
+            ipv4->GetRoutingProtocol()->RouteOutput(nullptr, header, nullptr, sockerr);
+        NS_ABORT_MSG_UNLESS(route,
+                            "No route from node " << node->GetId() << " to " << destination);
+        Ptr<NetDevice> device = route->GetOutputDevice();
+        path.push_back(device);
+
+        // the next node is the one owning the next hop address on the channel
+        Ipv4Address nextHop = route->GetGateway() == Ipv4Address::GetAny() ? destination
+                                                                          : route->GetGateway();
+        Ptr<Channel> channel = device->GetChannel();
+        node = nullptr;
+        for (std::size_t i = 0; channel && i < channel->GetNDevices(); i++)
+        {
+            Ptr<Node> peer = channel->GetDevice(i)->GetNode();
+            Ptr<Ipv4> peerIpv4 = peer->GetObject<Ipv4>();
+            if (peer != device->GetNode() && peerIpv4 &&
+                peerIpv4->GetInterfaceForAddress(nextHop) >= 0)
+            {
+                node = peer;
+                break;
+            }
+        }
+        NS_ABORT_MSG_UNLESS(node, "Next hop " << nextHop << " not found on the channel");
+    }
+}
+
+void
+TcpFluidModel::Allocate(Flow& flow, double rate)
+{
+    flow.rate = rate;
+    for (const auto& device : flow.path)
+    {
+        Link& link = m_links[device];
+        link.remaining = std::max(link.remaining - rate, 0.0);
+        link.unallocated--;
+    }
+}
+
+void
+TcpFluidModel::Update()
+{
+    NS_LOG_FUNCTION(this);
+
+    // Max-min fair allocation: the flows of the link with the smallest fair
+    // share are given this share, unless a flow has a lower maximum rate, and
+    // so on with the remaining flows and capacities
+    for (auto& [device, link] : m_links)
+    {
+        link.remaining = link.dataRate * m_maxUtilization;
+        link.unallocated = link.flows.size();
+    }
+    std::vector<Flow*> limited;
+    for (auto& [flowId, flow] : m_flows)
+    {
+        flow.rate = -1;
+        if (flow.maxRate > 0)
+        {
+            limited.push_back(&flow);
+        }
+    }
+    std::sort(limited.begin(), limited.end(), [](const Flow* a, const Flow* b) {
+        return a->maxRate < b->maxRate;
+    });
+    auto nextLimited = limited.begin();
+    std::size_t unallocated = m_flows.size();
+    while (unallocated > 0)
+    {
+        Link* bottleneck = nullptr;
+        double share = std::numeric_limits<double>::infinity();
+        for (auto& [device, link] : m_links)
+        {
+            if (link.unallocated > 0 && link.remaining / link.unallocated < share)
+            {
+                bottleneck = &link;
+                share = link.remaining / link.unallocated;
+            }
+        }
+        // the fair share never decreases, hence the limited flows are allocated in order
+        while (nextLimited != limited.end() && (*nextLimited)->rate >= 0)
+        {
+            nextLimited++;
+        }
+        if (nextLimited != limited.end() && (*nextLimited)->maxRate <= share)
+        {
+            Allocate(**nextLimited, (*nextLimited)->maxRate);
+            unallocated--;
+        }
+        else if (bottleneck)
+        {
+            for (uint32_t flowId : bottleneck->flows)
+            {
+                Flow& flow = m_flows[flowId];
+                if (flow.rate < 0)
+                {
+                    Allocate(flow, share);
+                    unallocated--;
+                }
+            }
+        }
+        else
+        {
+            // the remaining flows cross no link and have no maximum rate
+            for (auto& [flowId, flow] : m_flows)
+            {
+                flow.rate = std::max(flow.rate, 0.0);
+            }
+            unallocated = 0;
+        }
+    }
+
+    // Pass the load of the links to their devices, with the queueing delay of
+    // an M/D/1 queue with this load
+    for (auto it = m_links.begin(); it != m_links.end();)
+    {
+        Link& link = it->second;
+        link.load = link.flows.empty() ? 0 : link.dataRate * m_maxUtilization - link.remaining;
+        double utilization = link.load / link.dataRate;
+        double serviceTime = m_meanPacketSize * 8 / link.dataRate;
+        Time delay = Seconds(serviceTime * utilization / (2 * (1 - utilization)));
+        NS_LOG_LOGIC("Device " << it->first << " load " << link.load << " bit/s, delay "
+                               << delay.As(Time::US));
+        if (!it->first->SetFluidLoad(DataRate(static_cast<uint64_t>(link.load)), delay))
+        {
+            NS_LOG_WARN("Device " << it->first << " does not model the load of fluid flows");
+        }
+        if (link.flows.empty())
+        {
+            it = m_links.erase(it);
+        }
+        else
+        {
+            it++;
+        }
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,148 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef TCP_FLUID_MODEL_H
+#define TCP_FLUID_MODEL_H
+
+#include "ns3/data-rate.h"
+#include "ns3/ipv4-address.h"
+#include "ns3/net-device.h"
+#include "ns3/node.h"
+#include "ns3/object.h"
+
+#include <map>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup tcp
+ *
+ * @brief Flow-level (fluid) model of background TCP flows.
+ *
+ * Simulating many background TCP flows packet by packet, only to load the
+ * links crossed by a few foreground flows, is expensive. This model instead
+ * represents each background flow as a fluid flow whose rate is given by
+ * the max-min fair share of the links of its path, which is what long-lived
+ * TCP flows with similar RTTs tend to. The rates are recomputed whenever a
+ * flow is added or removed, so that the cost of the background traffic
+ * depends on the number of flow arrivals and departures, not on the number
+ * of packets.
+ *
+ * The path of a flow is taken from the IPv4 routing protocols of the nodes
+ * when the flow is added. Each network device of the path having a
+ * "DataRate" attribute is a link of capacity MaxUtilization times its data
+ * rate; the other devices do not limit the flows. The load of the fluid
+ * flows is passed to the devices with NetDevice::SetFluidLoad, along with
+ * the queueing delay of an M/D/1 queue with this load and packets of
+ * MeanPacketSize bytes. The devices supporting it (e.g.,
+ * PointToPointNetDevice) then send the packet-level flows, such as the
+ * TcpSocketBase foreground flows, at the data rate left by the fluid flows
+ * and add this delay to their packets; the queue discs of the devices hence
+ * fill up as the device drains more slowly.
+ *
+ * The fluid flows do not react to the packet-level flows, nor to the
+ * routing changes after they are added.
+ */
+class TcpFluidModel : public Object
+{
+  public:
+    /**
+     * @brief Get the type ID.
+     * @return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    TcpFluidModel();
+    ~TcpFluidModel() override;
+
+    /**
+     * @brief Add a fluid flow, and update the rates of the flows.
+     *
+     * @param source the source node of the flow
+     * @param destination the destination address of the flow
+     * @param maxRate the maximum rate of the flow (e.g., the rate of the
+     *        application), 0 if the flow is only limited by the links
+     * @return the identifier of the flow
+     */
+    uint32_t AddFlow(Ptr<Node> source, Ipv4Address destination, DataRate maxRate = DataRate(0));
+
+    /**
+     * @brief Remove a fluid flow, and update the rates of the other flows.
+     *
+     * @param flowId the identifier of the flow
+     */
+    void RemoveFlow(uint32_t flowId);
+
+    /**
+     * @param flowId the identifier of a flow
+     * @return the rate of the flow
+     */
+    DataRate GetFlowRate(uint32_t flowId) const;
+
+    /**
+     * @return the number of fluid flows
+     */
+    uint32_t GetNFlows() const;
+
+    /**
+     * @param device a network device
+     * @return the aggregate rate of the fluid flows sent through the device
+     */
+    DataRate GetLoad(Ptr<NetDevice> device) const;
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    /// A fluid flow
+    struct Flow
+    {
+        std::vector<Ptr<NetDevice>> path; //!< the links crossed by the flow
+        double maxRate;                   //!< the maximum rate, in bit/s (0 if none)
+        double rate;                      //!< the current rate, in bit/s
+    };
+
+    /// A link crossed by fluid flows
+    struct Link
+    {
+        double dataRate;             //!< the data rate of the device, in bit/s
+        double load;                 //!< the aggregate rate of the fluid flows, in bit/s
+        std::vector<uint32_t> flows; //!< the flows crossing the link
+        double remaining;            //!< the capacity not allocated yet (while solving)
+        uint32_t unallocated;        //!< the flows not allocated yet (while solving)
+    };
+
+    /**
+     * @brief Find the links from a node to a destination, hop by hop.
+     * @param source the source node
+     * @param destination the destination address
+     * @return the devices sending the packets, at each hop
+     */
+    std::vector<Ptr<NetDevice>> FindPath(Ptr<Node> source, Ipv4Address destination) const;
+
+    /**
+     * @brief Compute the max-min fair rates of the flows, and pass the load
+     *        of the links to their devices.
+     */
+    void Update();
+
+    /**
+     * @brief Allocate its rate to a flow.
+     * @param flow the flow
+     * @param rate the rate of the flow, in bit/s
+     */
+    void Allocate(Flow& flow, double rate);
+
+    std::map<uint32_t, Flow> m_flows;       //!< the flows, by identifier
+    std::map<Ptr<NetDevice>, Link> m_links; //!< the links crossed by the flows
+    uint32_t m_nextFlowId;                  //!< the identifier of the next flow
+    double m_maxUtilization;                //!< the fraction of the links usable by the flows
+    uint32_t m_meanPacketSize;              //!< the mean size of the packets, in bytes
+};
+
+} // namespace ns3
+
+#endif /* TCP_FLUID_MODEL_H */
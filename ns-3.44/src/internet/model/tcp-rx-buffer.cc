@@ -160,16 +160,21 @@ TcpRxBuffer::Add(Ptr<Packet> p, const TcpHeader& tcph)
             headSeq = tailSeq;
         }
     }
-    // Remove overlapped bytes from packet
-    auto i = m_data.begin();
+    // Remove overlapped bytes from packet. The stored data do not overlap, so
+    // only the block starting at or before the head can overlap it from the left
+    auto i = m_data.upper_bound(headSeq);
+    if (i != m_data.begin())
+    {
+        --i;
+    }
     while (i != m_data.end() && i->first <= tailSeq)
     {
-        SequenceNumber32 lastByteSeq = i->first + SequenceNumber32(i->second->GetSize());
+        SequenceNumber32 lastByteSeq = i->first + SequenceNumber32(i->second.length);
         if (lastByteSeq > headSeq)
         {
             if (i->first > headSeq && lastByteSeq < tailSeq)
             { // Rare case: Existing packet is embedded fully in the new packet
-                m_size -= i->second->GetSize();
+                m_size -= i->second.length;
                 m_data.erase(i++);
                 continue;
             }
@@ -184,44 +189,47 @@ TcpRxBuffer::Add(Ptr<Packet> p, const TcpHeader& tcph)
         }
         ++i;
     }
-    // We now know how much we are going to store, trim the packet
+    // We now know how much we are going to store
     if (headSeq >= tailSeq)
     {
         NS_LOG_LOGIC("Nothing to buffer");
         return false; // Nothing to buffer anyway
     }
-    else
+    // Insert a reference to the data into buffer
+    Slice slice;
+    slice.packet = p;
+    slice.offset = static_cast<uint32_t>(headSeq - tcph.GetSequenceNumber());
+    slice.length = static_cast<uint32_t>(tailSeq - headSeq);
+    NS_ASSERT(m_data.find(headSeq) == m_data.end()); // Shouldn't be there yet
+    m_data.emplace(headSeq, slice);
+    m_size += slice.length; // Occupancy
+    NS_LOG_LOGIC("Buffered packet of seqno=" << headSeq << " len=" << slice.length);
+
+    // Merge the new data with the blocks of out-of-order data it touches
+    SequenceNumber32 blockHead = headSeq;
+    SequenceNumber32 blockTail = tailSeq;
+    auto block = m_blocks.lower_bound(headSeq);
+    if (block != m_blocks.begin() && std::prev(block)->second >= headSeq)
     {
-        uint32_t start = static_cast<uint32_t>(headSeq - tcph.GetSequenceNumber());
-        auto length = static_cast<uint32_t>(tailSeq - headSeq);
-        p = p->CreateFragment(start, length);
-        NS_ASSERT(length == p->GetSize());
+        --block;
     }
-    // Insert packet into buffer
-    NS_ASSERT(m_data.find(headSeq) == m_data.end()); // Shouldn't be there yet
-    m_data[headSeq] = p;
-
-    if (headSeq > m_nextRxSeq)
+    while (block != m_blocks.end() && block->first <= blockTail)
     {
-        // Generate a new SACK block
-        UpdateSackList(headSeq, tailSeq);
+        blockHead = std::min(blockHead, block->first);
+        blockTail = std::max(blockTail, block->second);
+        block = m_blocks.erase(block);
     }
-
-    NS_LOG_LOGIC("Buffered packet of seqno=" << headSeq << " len=" << p->GetSize());
-    // Update variables
-    m_size += p->GetSize(); // Occupancy
-    for (i = m_data.begin(); i != m_data.end(); ++i)
+    if (blockHead > m_nextRxSeq)
     {
-        if (i->first < m_nextRxSeq)
-        {
-            continue;
-        }
-        else if (i->first > m_nextRxSeq)
-        {
-            break;
-        };
-        m_nextRxSeq = i->first + SequenceNumber32(i->second->GetSize());
-        m_availBytes += i->second->GetSize();
+        // Generate a new SACK block
+        m_blocks.emplace(blockHead, blockTail);
+        UpdateSackList(blockHead, blockTail);
+    }
+    else
+    { // In-sequence data, which may fill the hole before a block
+        NS_ASSERT(blockHead == m_nextRxSeq);
+        m_availBytes += static_cast<uint32_t>(blockTail - m_nextRxSeq);
+        m_nextRxSeq = blockTail;
         ClearSackList(m_nextRxSeq);
     }
     NS_LOG_LOGIC("Updated buffer occupancy=" << m_size << " nextRxSeq=" << m_nextRxSeq);
@@ -278,50 +286,20 @@ TcpRxBuffer::UpdateSackList(const SequenceNumber32& head, const SequenceNumber32
 
     m_sackList.push_front(current);
 
-    // We have inserted the block at the beginning of the list. Now, we should
-    // check if any existing blocks overlap with that.
-    bool updated = false;
-    auto it = m_sackList.begin();
-    TcpOptionSack::SackBlock begin = *it;
-    TcpOptionSack::SackBlock merged;
-    ++it;
-
-    // Iterates until we examined all blocks in the list (maximum 4)
-    while (it != m_sackList.end())
+    // The block is the whole interval of out-of-order data containing the
+    // segment, so that the blocks previously reported either do not overlap
+    // it, or are subsets of it: these are removed.
+    for (auto it = std::next(m_sackList.begin()); it != m_sackList.end();)
     {
-        current = *it;
-
-        // This is a left merge:
-        // [current_first; current_second] [beg_first; beg_second]
-        if (begin.first == current.second)
-        {
-            NS_ASSERT(current.first < begin.second);
-            merged = TcpOptionSack::SackBlock(current.first, begin.second);
-            updated = true;
-        }
-        // while this is a right merge
-        // [begin_first; begin_second] [current_first; current_second]
-        else if (begin.second == current.first)
+        if (it->first >= head && it->second <= tail)
         {
-            NS_ASSERT(begin.first < current.second);
-            merged = TcpOptionSack::SackBlock(begin.first, current.second);
-            updated = true;
+            it = m_sackList.erase(it);
         }
-
-        // If we have merged the blocks (and the result is in merged) we should
-        // delete the current block (it), the first block, and insert the merged
-        // one at the beginning.
-        if (updated)
+        else
         {
-            m_sackList.erase(it);
-            m_sackList.pop_front();
-            m_sackList.push_front(merged);
-            it = m_sackList.begin();
-            begin = *it;
-            updated = false;
+            NS_ASSERT(it->second < head || it->first > tail);
+            ++it;
         }
-
-        ++it;
     }
 
     // Since the maximum blocks that fits into a TCP header are 4, there's no
@@ -330,11 +308,6 @@ TcpRxBuffer::UpdateSackList(const SequenceNumber32& head, const SequenceNumber32
     {
         m_sackList.pop_back();
     }
-
-    // Please note that, if a block b is discarded and then a block contiguous
-    // to b is received, only that new block (without the b part) is reported.
-    // This is perfectly fine for the RFC point (a), given that we do not report any
-    // overlapping blocks shortly after.
 }
 
 void
@@ -376,38 +349,37 @@ TcpRxBuffer::Extract(uint32_t maxSize)
     {
         return nullptr; // No contiguous block to return
     }
-    NS_ASSERT(!m_data.empty());            // At least we have something to extract
-    Ptr<Packet> outPkt = Create<Packet>(); // The packet that contains all the data to return
-    BufIterator i;
+    NS_ASSERT(!m_data.empty()); // At least we have something to extract
+    Ptr<Packet> outPkt;         // The packet that contains all the data to return
     while (extractSize)
     { // Check the buffered data for delivery
-        i = m_data.begin();
+        auto i = m_data.begin();
         NS_ASSERT(i->first <= m_nextRxSeq); // in-sequence data expected
-        // Check if we send the whole pkt or just a partial
-        uint32_t pktSize = i->second->GetSize();
-        if (pktSize <= extractSize)
-        { // Whole packet is extracted
-            outPkt->AddAtEnd(i->second);
-            m_data.erase(i);
-            m_size -= pktSize;
-            m_availBytes -= pktSize;
-            extractSize -= pktSize;
+        const Slice& slice = i->second;
+        uint32_t length = std::min(slice.length, extractSize);
+        // The fragment shares the payload of the received packet: the bytes
+        // are copied only when the data of several segments are concatenated
+        Ptr<Packet> fragment = slice.packet->CreateFragment(slice.offset, length);
+        if (outPkt)
+        {
+            outPkt->AddAtEnd(fragment);
         }
         else
+        {
+            outPkt = fragment;
+        }
+        if (length < slice.length)
         { // Partial is extracted and done
-            outPkt->AddAtEnd(i->second->CreateFragment(0, extractSize));
-            m_data[i->first + SequenceNumber32(extractSize)] =
-                i->second->CreateFragment(extractSize, pktSize - extractSize);
-            m_data.erase(i);
-            m_size -= extractSize;
-            m_availBytes -= extractSize;
-            extractSize = 0;
+            Slice rest;
+            rest.packet = slice.packet;
+            rest.offset = slice.offset + length;
+            rest.length = slice.length - length;
+            m_data.emplace_hint(std::next(i), i->first + SequenceNumber32(length), rest);
         }
-    }
-    if (outPkt->GetSize() == 0)
-    {
-        NS_LOG_LOGIC("Nothing extracted.");
-        return nullptr;
+        m_data.erase(i);
+        m_size -= length;
+        m_availBytes -= length;
+        extractSize -= length;
     }
     NS_LOG_LOGIC("Extracted " << outPkt->GetSize() << " bytes, bufsize=" << m_size
                               << ", num pkts in buffer=" << m_data.size());
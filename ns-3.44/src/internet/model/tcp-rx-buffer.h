@@ -44,6 +44,15 @@ class Packet;
  * To store data, use Add; for retrieving a certain amount of ordered data, use
  * the method Extract.
  *
+ * The buffer does not copy the received payload: it keeps, for each stored
+ * interval of sequence numbers, a reference to the received packet and the
+ * slice of it holding the data, which must hence not be modified afterwards.
+ * The data is cut out of the received packets (sharing their payload bytes)
+ * only when it is extracted, so that the bytes of a single segment are handed
+ * to the application without being copied, and the overlaps between the
+ * received segments only shorten the slices. The coalesced intervals of
+ * out-of-order data are tracked as well, and are the blocks of the SACK list.
+ *
  * SACK list
  * ---------
  *
@@ -209,10 +218,16 @@ class TcpRxBuffer : public Object
      */
     void ClearSackList(const SequenceNumber32& seq);
 
+    /// Data stored in the buffer: a slice of a received packet
+    struct Slice
+    {
+        Ptr<Packet> packet; //!< The received packet
+        uint32_t offset;    //!< Offset of the data in the packet
+        uint32_t length;    //!< Length of the data
+    };
+
     TcpOptionSack::SackList m_sackList; //!< Sack list (updated constantly)
 
-    /// container for data stored in the buffer
-    typedef std::map<SequenceNumber32, Ptr<Packet>>::iterator BufIterator;
     TracedValue<SequenceNumber32>
         m_nextRxSeq;           //!< Seqnum of the first missing byte in data (RCV.NXT)
     SequenceNumber32 m_finSeq; //!< Seqnum of the FIN packet
@@ -220,7 +235,9 @@ class TcpRxBuffer : public Object
     uint32_t m_size;       //!< Number of total data bytes in the buffer, not necessarily contiguous
     uint32_t m_maxBuffer;  //!< Upper bound of the number of data bytes in buffer (RCV.WND)
     uint32_t m_availBytes; //!< Number of bytes available to read, i.e. contiguous block at head
-    std::map<SequenceNumber32, Ptr<Packet>> m_data; //!< Corresponding data (may be null)
+    std::map<SequenceNumber32, Slice> m_data; //!< Stored data, by sequence number, without overlap
+    /// Maximal intervals of contiguous data beyond m_nextRxSeq (head -> tail)
+    std::map<SequenceNumber32, SequenceNumber32> m_blocks;
 };
 
 } // namespace ns3
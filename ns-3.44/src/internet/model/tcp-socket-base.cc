@@ -46,6 +46,7 @@
 #include "ns3/object.h"
 #include "ns3/packet.h"
 #include "ns3/pointer.h"
+#include "ns3/segmentation-offload-tag.h"
 #include "ns3/simulation-singleton.h"
 #include "ns3/simulator.h"
 #include "ns3/trace-source-accessor.h"
@@ -139,6 +140,13 @@ TcpSocketBase::GetTypeId()
                           BooleanValue(true),
                           MakeBooleanAccessor(&TcpSocketBase::m_timestampEnabled),
                           MakeBooleanChecker())
+            .AddAttribute("SegmentationOffload",
+                          "Maximum payload size of the super-segments sent at once, standing "
+                          "for several segments, to emulate TCP segmentation offload (TSO); "
+                          "0 disables it",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&TcpSocketBase::m_maxOffloadSize),
+                          MakeUintegerChecker<uint32_t>(0, 65535))
             .AddAttribute(
                 "MinRto",
                 "Minimum retransmit timeout value",
@@ -399,6 +407,7 @@ TcpSocketBase::TcpSocketBase(const TcpSocketBase& sock)
       m_sndWindShift(sock.m_sndWindShift),
       m_timestampEnabled(sock.m_timestampEnabled),
       m_timestampToEcho(sock.m_timestampToEcho),
+      m_maxOffloadSize(sock.m_maxOffloadSize),
       m_recover(sock.m_recover),
       m_recoverActive(sock.m_recoverActive),
       m_retxThresh(sock.m_retxThresh),
@@ -3242,6 +3251,10 @@ TcpSocketBase::SendDataPacket(SequenceNumber32 seq, uint32_t maxSize, bool withA
 
     bool isEct = IsEct(isRetransmission ? TcpPacketType_t::RE_XMT : TcpPacketType_t::DATA);
     AddSocketTags(p, isEct);
+    if (sz > m_tcb->m_segmentSize)
+    {
+        p->AddPacketTag(SegmentationOffloadTag(m_tcb->m_segmentSize, sz));
+    }
 
     if (m_closeOnEmpty && (remainingData == 0))
     {
@@ -3468,6 +3481,14 @@ TcpSocketBase::SendPendingData(bool withAck)
             // NextSeg () may have further constrained the segment size
             auto maxSizeToSend = static_cast<uint32_t>(nextHigh - next);
             s = std::min(s, maxSizeToSend);
+            if (s == m_tcb->m_segmentSize && next == m_tcb->m_highTxMark &&
+                m_maxOffloadSize >= 2 * m_tcb->m_segmentSize && !IsPacingEnabled())
+            {
+                // Segmentation offload: send the full segments of new data allowed
+                // by the window at once
+                uint32_t maxOffload = std::min({availableWindow, availableData, m_maxOffloadSize});
+                s = std::max(s, maxOffload - maxOffload % m_tcb->m_segmentSize);
+            }
 
             // (C.2) If any of the data octets sent in (C.1) are below HighData,
             //       HighRxt MUST be set to the highest sequence number of the
@@ -3622,6 +3643,11 @@ TcpSocketBase::ReceivedData(Ptr<Packet> p, const TcpHeader& tcpHeader)
     NS_LOG_DEBUG("Data segment, seq=" << tcpHeader.GetSequenceNumber()
                                       << " pkt size=" << p->GetSize());
 
+    // A super-segment (see SegmentationOffloadTag) stands for several segments,
+    // and is acknowledged at once, as Linux does for the segments aggregated by GRO
+    SegmentationOffloadTag offloadTag;
+    bool isSuperSegment = p->RemovePacketTag(offloadTag);
+
     // Put into Rx buffer
     SequenceNumber32 expectedSeq = m_tcb->m_rxBuffer->NextRxSequence();
     if (!m_tcb->m_rxBuffer->Add(p, tcpHeader))
@@ -3678,7 +3704,7 @@ TcpSocketBase::ReceivedData(Ptr<Packet> p, const TcpHeader& tcpHeader)
     }
     else
     { // In-sequence packet: ACK if delayed ack count allows
-        if (++m_delAckCount >= m_delAckMaxCount)
+        if (isSuperSegment || ++m_delAckCount >= m_delAckMaxCount)
         {
             m_delAckEvent.Cancel();
             m_delAckCount = 0;
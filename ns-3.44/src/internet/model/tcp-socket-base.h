@@ -1418,6 +1418,7 @@ class TcpSocketBase : public TcpSocket
     uint8_t m_sndWindShift{0};      //!< Window shift to apply to incoming segments
     bool m_timestampEnabled{true};  //!< Timestamp option enabled
     uint32_t m_timestampToEcho{0};  //!< Timestamp to echo
+    uint32_t m_maxOffloadSize{0};   //!< Max size of the super-segments (0 disables offload)
 
     EventId m_sendPendingDataEvent{}; //!< micro-delay event to send pending data
 
@@ -16,6 +16,7 @@
 
 #include <algorithm>
 #include <iostream>
+#include <set>
 
 namespace ns3
 {
@@ -283,7 +284,7 @@ TcpTxBuffer::GetNewSegment(uint32_t numBytes)
     NS_ASSERT(it != m_appList.end());
 
     m_appList.erase(it);
-    m_sentList.insert(m_sentList.end(), item);
+    IndexSentItem(m_sentList.insert(m_sentList.end(), item));
     m_sentSize += item->m_packet->GetSize();
 
     return item;
@@ -297,37 +298,34 @@ TcpTxBuffer::GetTransmittedSegment(uint32_t numBytes, const SequenceNumber32& se
     NS_ASSERT(numBytes <= m_sentSize);
     NS_ASSERT(!m_sentList.empty());
 
-    auto it = m_sentList.begin();
     bool listEdited = false;
     uint32_t s = numBytes;
 
     // Avoid to merge different packet for this retransmission if flags are
     // different.
-    for (; it != m_sentList.end(); ++it)
+    auto found = m_sentIndex.find(seq);
+    if (found != m_sentIndex.end())
     {
-        if ((*it)->m_startSeq == seq)
+        auto it = found->second;
+        auto next = it;
+        next++;
+        if (next != m_sentList.end())
         {
-            auto next = it;
-            next++;
-            if (next != m_sentList.end())
+            // Next is not sacked and have the same value for m_lost ... there is the
+            // possibility to merge
+            if ((!(*next)->m_sacked) && ((*it)->m_lost == (*next)->m_lost))
             {
-                // Next is not sacked and have the same value for m_lost ... there is the
-                // possibility to merge
-                if ((!(*next)->m_sacked) && ((*it)->m_lost == (*next)->m_lost))
-                {
-                    s = std::min(s, (*it)->m_packet->GetSize() + (*next)->m_packet->GetSize());
-                }
-                else
-                {
-                    // Next is sacked... better to retransmit only the first segment
-                    s = std::min(s, (*it)->m_packet->GetSize());
-                }
+                s = std::min(s, (*it)->m_packet->GetSize() + (*next)->m_packet->GetSize());
             }
             else
             {
+                // Next is sacked... better to retransmit only the first segment
                 s = std::min(s, (*it)->m_packet->GetSize());
             }
-            break;
+        }
+        else
+        {
+            s = std::min(s, (*it)->m_packet->GetSize());
         }
     }
 
@@ -335,8 +333,10 @@ TcpTxBuffer::GetTransmittedSegment(uint32_t numBytes, const SequenceNumber32& se
 
     if (!item->m_retrans)
     {
+        RemoveFromScoreboard(item);
         m_retrans += item->m_packet->GetSize();
         item->m_retrans = true;
+        AddToScoreboard(item);
     }
 
     return item;
@@ -364,6 +364,72 @@ TcpTxBuffer::FindHighestSacked() const
     return ret;
 }
 
+std::set<SequenceNumber32>*
+TcpTxBuffer::GetScoreboardSet(const TcpTxItem* item)
+{
+    if (item->m_sacked)
+    {
+        return &m_sackedSeqs;
+    }
+    if (item->m_lost)
+    {
+        return item->m_retrans ? nullptr : &m_lostSeqs;
+    }
+    return item->m_retrans ? &m_retransSeqs : &m_pendingSeqs;
+}
+
+void
+TcpTxBuffer::AddToScoreboard(const TcpTxItem* item)
+{
+    std::set<SequenceNumber32>* set = GetScoreboardSet(item);
+    if (set)
+    {
+        set->insert(item->m_startSeq);
+    }
+}
+
+void
+TcpTxBuffer::RemoveFromScoreboard(const TcpTxItem* item)
+{
+    std::set<SequenceNumber32>* set = GetScoreboardSet(item);
+    if (set)
+    {
+        set->erase(item->m_startSeq);
+    }
+}
+
+void
+TcpTxBuffer::IndexSentItem(PacketList::iterator it)
+{
+    bool inserted [[maybe_unused]] = m_sentIndex.emplace((*it)->m_startSeq, it).second;
+    NS_ASSERT_MSG(inserted, "Item " << **it << " already indexed");
+    AddToScoreboard(*it);
+}
+
+void
+TcpTxBuffer::UnindexSentItem(const TcpTxItem* item)
+{
+    RemoveFromScoreboard(item);
+    m_sentIndex.erase(item->m_startSeq);
+}
+
+TcpTxBuffer::PacketList::iterator
+TcpTxBuffer::FindSentItem(const SequenceNumber32& seq) const
+{
+    auto it = m_sentIndex.upper_bound(seq);
+    if (it == m_sentIndex.begin())
+    {
+        return const_cast<PacketList&>(m_sentList).end();
+    }
+    --it;
+    const TcpTxItem* item = *it->second;
+    if (seq >= item->m_startSeq + item->m_packet->GetSize())
+    {
+        return const_cast<PacketList&>(m_sentList).end();
+    }
+    return it->second;
+}
+
 void
 TcpTxBuffer::SplitItems(TcpTxItem* t1, TcpTxItem* t2, uint32_t size) const
 {
@@ -389,7 +455,7 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
                                const SequenceNumber32& listStartFrom,
                                uint32_t numBytes,
                                const SequenceNumber32& seq,
-                               bool* listEdited) const
+                               bool* listEdited)
 {
     NS_LOG_FUNCTION(this << numBytes << seq);
 
@@ -423,14 +489,27 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
     Ptr<Packet> currentPacket = nullptr;
     TcpTxItem* currentItem = nullptr;
     TcpTxItem* outItem = nullptr;
+    // the items of the sent list are indexed by their starting sequence number
+    bool indexed = (&list == &m_sentList);
     auto it = list.begin();
     SequenceNumber32 beginOfCurrentPacket = listStartFrom;
 
+    if (indexed)
+    {
+        // start from the item containing seq
+        auto found = FindSentItem(seq);
+        if (found != list.end())
+        {
+            it = found;
+            beginOfCurrentPacket = (*it)->m_startSeq;
+        }
+    }
+
     while (it != list.end())
     {
         currentItem = *it;
         currentPacket = currentItem->m_packet;
-        NS_ASSERT_MSG(list != m_sentList || currentItem->m_startSeq >= m_firstByteSeq,
+        NS_ASSERT_MSG(!indexed || currentItem->m_startSeq >= m_firstByteSeq,
                       "start: " << m_firstByteSeq
                                 << " currentItem start: " << currentItem->m_startSeq);
 
@@ -456,10 +535,19 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
                                          << " and now we recurse because packet ends at "
                                          << beginOfCurrentPacket + currentPacket->GetSize());
                 auto firstPart = new TcpTxItem();
+                if (indexed)
+                {
+                    UnindexSentItem(currentItem);
+                }
                 SplitItems(firstPart, currentItem, seq - beginOfCurrentPacket);
 
                 // insert firstPart before currentItem
-                list.insert(it, firstPart);
+                auto firstPartIt = list.insert(it, firstPart);
+                if (indexed)
+                {
+                    IndexSentItem(firstPartIt);
+                    IndexSentItem(it);
+                }
                 if (listEdited)
                 {
                     *listEdited = true;
@@ -505,6 +593,11 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
                     NS_ASSERT(it != list.begin());
                     TcpTxItem* previous = *(--it);
 
+                    if (indexed)
+                    {
+                        UnindexSentItem(previous);
+                        UnindexSentItem(currentItem);
+                    }
                     list.erase(it);
 
                     MergeItems(previous, currentItem);
@@ -522,10 +615,19 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
                 // the end is inside the current packet, but it isn't exactly
                 // the packet end. Just fragment, fix the list, and return.
                 auto firstPart = new TcpTxItem();
+                if (indexed)
+                {
+                    UnindexSentItem(currentItem);
+                }
                 SplitItems(firstPart, currentItem, numBytes);
 
                 // insert firstPart before currentItem
-                list.insert(it, firstPart);
+                auto firstPartIt = list.insert(it, firstPart);
+                if (indexed)
+                {
+                    IndexSentItem(firstPartIt);
+                    IndexSentItem(it);
+                }
                 if (listEdited)
                 {
                     *listEdited = true;
@@ -553,8 +655,17 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
             TcpTxItem* next = (*it); // Please remember we have incremented it
                                      // in the previous if
 
+            if (indexed)
+            {
+                UnindexSentItem(currentItem);
+                UnindexSentItem(next);
+            }
             MergeItems(currentItem, next);
-            list.erase(it);
+            it = list.erase(it);
+            if (indexed)
+            {
+                IndexSentItem(--it);
+            }
 
             delete next;
 
@@ -638,16 +749,15 @@ bool
 TcpTxBuffer::IsRetransmittedDataAcked(const SequenceNumber32& ack) const
 {
     NS_LOG_FUNCTION(this);
-    for (const auto& it : m_sentList)
+    // the item which ends at ack is the one containing the previous byte
+    auto it = FindSentItem(ack - 1);
+    if (it == m_sentList.end())
     {
-        TcpTxItem* item = it;
-        Ptr<Packet> p = item->m_packet;
-        if (item->m_startSeq + p->GetSize() == ack && !item->m_sacked && item->m_retrans)
-        {
-            return true;
-        }
+        return false;
     }
-    return false;
+    TcpTxItem* item = *it;
+    Ptr<Packet> p = item->m_packet;
+    return item->m_startSeq + p->GetSize() == ack && !item->m_sacked && item->m_retrans;
 }
 
 void
@@ -695,6 +805,7 @@ TcpTxBuffer::DiscardUpTo(const SequenceNumber32& seq, const Callback<void, TcpTx
 
             RemoveFromCounts(item, pktSize);
 
+            UnindexSentItem(item);
             i = m_sentList.erase(i);
             NS_LOG_INFO("Removed " << *item << " lost: " << m_lostOut << " retrans: " << m_retrans
                                    << " sacked: " << m_sackedOut << ". Remaining data " << m_size);
@@ -711,9 +822,11 @@ TcpTxBuffer::DiscardUpTo(const SequenceNumber32& seq, const Callback<void, TcpTx
         { // Part of the packet is behind the seqnum. Fragment
             pktSize -= offset;
             NS_LOG_INFO(*item);
+            UnindexSentItem(item);
             // PacketTags are preserved when fragmenting
             item->m_packet = item->m_packet->CreateFragment(offset, pktSize);
             item->m_startSeq += offset;
+            IndexSentItem(i);
             m_size -= offset;
             m_sentSize -= offset;
             m_firstByteSeq += offset;
@@ -741,7 +854,9 @@ TcpTxBuffer::DiscardUpTo(const SequenceNumber32& seq, const Callback<void, TcpTx
             // It is not possible to have the UNA sacked; otherwise, it would
             // have been ACKed. This is, most likely, our wrong guessing
             // when adding Reno dupacks in the count.
+            RemoveFromScoreboard(head);
             head->m_sacked = false;
+            AddToScoreboard(head);
             m_sackedOut -= head->m_packet->GetSize();
             NS_LOG_INFO("Moving the SACK flag from the HEAD to another segment");
             AddRenoSack();
@@ -777,18 +892,20 @@ TcpTxBuffer::Update(const TcpOptionSack::SackList& list, const Callback<void, Tc
 
     for (auto option_it = list.begin(); option_it != list.end(); ++option_it)
     {
-        auto item_it = m_sentList.begin();
-        SequenceNumber32 beginOfCurrentPacket = m_firstByteSeq;
-
         if (m_firstByteSeq + m_sentSize < (*option_it).first)
         {
             NS_LOG_INFO("Not updating scoreboard, the option block is outside the sent list");
             return bytesSacked;
         }
 
+        // Only the items starting inside the block can be covered by it
+        auto index_it = m_sentIndex.lower_bound(std::max((*option_it).first, m_firstByteSeq.Get()));
+        auto item_it = (index_it == m_sentIndex.end()) ? m_sentList.end() : index_it->second;
+
         while (item_it != m_sentList.end())
         {
             uint32_t pktSize = (*item_it)->m_packet->GetSize();
+            SequenceNumber32 beginOfCurrentPacket = (*item_it)->m_startSeq;
 
             // Check the boundary of this packet ... only mark as sacked if
             // it is precisely mapped over the option. It means that if the receiver
@@ -807,6 +924,7 @@ TcpTxBuffer::Update(const TcpOptionSack::SackList& list, const Callback<void, Tc
                 }
                 else
                 {
+                    RemoveFromScoreboard(*item_it);
                     if ((*item_it)->m_lost)
                     {
                         (*item_it)->m_lost = false;
@@ -814,6 +932,7 @@ TcpTxBuffer::Update(const TcpOptionSack::SackList& list, const Callback<void, Tc
                     }
 
                     (*item_it)->m_sacked = true;
+                    AddToScoreboard(*item_it);
                     m_sackedOut += (*item_it)->m_packet->GetSize();
                     bytesSacked += (*item_it)->m_packet->GetSize();
 
@@ -843,7 +962,6 @@ TcpTxBuffer::Update(const TcpOptionSack::SackList& list, const Callback<void, Tc
                 break;
             }
 
-            beginOfCurrentPacket += pktSize;
             ++item_it;
         }
     }
@@ -866,44 +984,55 @@ void
 TcpTxBuffer::UpdateLostCount()
 {
     NS_LOG_FUNCTION(this);
-    uint32_t sacked = 0;
-    SequenceNumber32 beginOfCurrentPacket = m_highestSack.second;
-    if (m_highestSack.first == m_sentList.end())
-    {
-        NS_LOG_INFO("Status before the update: " << *this
-                                                 << ", will start from the latest sent item");
-    }
-    else
-    {
-        NS_LOG_INFO("Status before the update: " << *this << ", will start from item "
-                                                 << *(*m_highestSack.first));
-    }
+    NS_LOG_INFO("Status before the update: " << *this << ", will start from the item at "
+                                             << m_highestSack.second);
 
-    for (auto it = m_highestSack.first; it != m_sentList.begin(); --it)
+    // Count the sacked segments from the highest sacked one down to the head
+    // (excluded), until the dupAckThresh-th one: all the items below it are
+    // lost. An item sent with segmentation offload counts as the segments it
+    // stands for.
+    uint32_t sacked = 0;
+    SequenceNumber32 lostBelow = m_highestSack.second;
+    SequenceNumber32 head = m_sentList.front()->m_startSeq;
+    for (auto it = m_sentIndex.upper_bound(m_highestSack.second);
+         sacked < m_dupAckThresh && it != m_sentIndex.begin();)
     {
-        TcpTxItem* item = *it;
-        if (item->m_sacked)
+        --it;
+        if (it->first == head)
         {
-            sacked++;
+            break;
+        }
+        if ((*it->second)->m_sacked)
+        {
+            uint32_t size = (*it->second)->m_packet->GetSize();
+            sacked += (m_segmentSize == 0 || size <= m_segmentSize)
+                          ? 1
+                          : (size + m_segmentSize - 1) / m_segmentSize;
+            lostBelow = it->first;
         }
+    }
 
-        if (sacked >= m_dupAckThresh)
+    if (sacked >= m_dupAckThresh)
+    {
+        // The items which are neither sacked nor lost are retransmitted or pending
+        for (auto set : {&m_retransSeqs, &m_pendingSeqs})
         {
-            if (!item->m_sacked && !item->m_lost)
+            while (!set->empty() && *set->begin() <= lostBelow)
             {
+                TcpTxItem* item = *m_sentIndex.at(*set->begin());
+                RemoveFromScoreboard(item);
                 item->m_lost = true;
+                AddToScoreboard(item);
                 m_lostOut += item->m_packet->GetSize();
             }
         }
-        beginOfCurrentPacket -= item->m_packet->GetSize();
-    }
 
-    if (sacked >= m_dupAckThresh)
-    {
-        TcpTxItem* item = *m_sentList.begin();
+        TcpTxItem* item = m_sentList.front();
         if (!item->m_lost)
         {
+            RemoveFromScoreboard(item);
             item->m_lost = true;
+            AddToScoreboard(item);
             m_lostOut += item->m_packet->GetSize();
         }
     }
@@ -921,24 +1050,19 @@ TcpTxBuffer::IsLost(const SequenceNumber32& seq) const
         return false;
     }
 
-    // In theory, using a map and hints when inserting elements can improve
-    // performance
-    for (auto it = m_sentList.begin(); it != m_sentList.end(); ++it)
+    auto it = FindSentItem(seq);
+    if (it != m_sentList.end())
     {
-        // Search for the right iterator before calling IsLost()
-        if ((*it)->m_startSeq <= seq && seq < (*it)->m_startSeq + (*it)->m_packet->GetSize())
+        if ((*it)->m_lost)
         {
-            if ((*it)->m_lost)
-            {
-                NS_LOG_INFO("seq=" << seq << " is lost because of lost flag");
-                return true;
-            }
+            NS_LOG_INFO("seq=" << seq << " is lost because of lost flag");
+            return true;
+        }
 
-            if ((*it)->m_sacked)
-            {
-                NS_LOG_INFO("seq=" << seq << " is not lost because of sacked flag");
-                return false;
-            }
+        if ((*it)->m_sacked)
+        {
+            NS_LOG_INFO("seq=" << seq << " is not lost because of sacked flag");
+            return false;
         }
     }
 
@@ -963,36 +1087,34 @@ TcpTxBuffer::NextSeg(SequenceNumber32* seq, SequenceNumber32* seqHigh, bool isRe
      *
      *     (1.c) IsLost (S2) returns true.
      */
-    TcpTxItem* item;
     SequenceNumber32 seqPerRule3;
     bool isSeqPerRule3Valid = false;
-    SequenceNumber32 beginOfCurrentPkt = m_firstByteSeq;
 
-    for (auto it = m_sentList.begin(); it != m_sentList.end(); ++it)
+    // Condition 1.a and 1.b: neither retransmitted nor sacked, and below the
+    // highest sacked item. The candidates which are lost (condition 1.c) are
+    // in m_lostSeqs, the others in m_pendingSeqs.
+    auto isCandidate = [this](const SequenceNumber32& start) {
+        return !m_sackSeen || start < m_highestSack.second;
+    };
+
+    if (!m_lostSeqs.empty() && isCandidate(*m_lostSeqs.begin()))
     {
-        item = *it;
+        NS_LOG_INFO("IsLost, returning" << *m_lostSeqs.begin());
+        *seq = *m_lostSeqs.begin();
+        *seqHigh = *seq + m_segmentSize;
+        return true;
+    }
 
-        // Condition 1.a , 1.b , and 1.c
-        if (!item->m_retrans && !item->m_sacked &&
-            ((m_sackSeen && item->m_startSeq < m_highestSack.second) || !m_sackSeen))
+    if (isRecovery)
+    {
+        for (auto it = m_pendingSeqs.begin();
+             it != m_pendingSeqs.end() && isCandidate(*it) && seqPerRule3.GetValue() == 0;
+             ++it)
         {
-            if (item->m_lost)
-            {
-                NS_LOG_INFO("IsLost, returning" << beginOfCurrentPkt);
-                *seq = beginOfCurrentPkt;
-                *seqHigh = *seq + m_segmentSize;
-                return true;
-            }
-            else if (seqPerRule3.GetValue() == 0 && isRecovery)
-            {
-                NS_LOG_INFO("Saving for rule 3 the seq " << beginOfCurrentPkt);
-                isSeqPerRule3Valid = true;
-                seqPerRule3 = beginOfCurrentPkt;
-            }
+            NS_LOG_INFO("Saving for rule 3 the seq " << *it);
+            isSeqPerRule3Valid = true;
+            seqPerRule3 = *it;
         }
-
-        // Nothing found, iterate
-        beginOfCurrentPkt += item->m_packet->GetSize();
     }
 
     /* (2) If no sequence number 'S2' per rule (1) exists but there
@@ -1198,9 +1320,12 @@ TcpTxBuffer::ResetRenoSack()
     NS_LOG_FUNCTION(this);
 
     m_sackedOut = 0;
-    for (auto it = m_sentList.begin(); it != m_sentList.end(); ++it)
+    while (!m_sackedSeqs.empty())
     {
-        (*it)->m_sacked = false;
+        TcpTxItem* item = *m_sentIndex.at(*m_sackedSeqs.begin());
+        RemoveFromScoreboard(item);
+        item->m_sacked = false;
+        AddToScoreboard(item);
     }
 
     m_highestSack = std::make_pair(m_sentList.end(), SequenceNumber32(0));
@@ -1229,6 +1354,12 @@ TcpTxBuffer::ResetSentList()
         m_sentList.pop_back();
     }
 
+    m_sentIndex.clear();
+    m_sackedSeqs.clear();
+    m_lostSeqs.clear();
+    m_retransSeqs.clear();
+    m_pendingSeqs.clear();
+
     m_sentSize = 0;
     m_lostOut = 0;
     m_retrans = 0;
@@ -1245,6 +1376,7 @@ TcpTxBuffer::ResetLastSegmentSent()
     {
         TcpTxItem* item = m_sentList.back();
 
+        UnindexSentItem(item);
         m_sentList.pop_back();
         m_sentSize -= item->m_packet->GetSize();
         if (item->m_retrans)
@@ -1274,6 +1406,11 @@ TcpTxBuffer::SetSentListLost(bool resetSack)
         m_lostOut = 0;
     }
 
+    m_sackedSeqs.clear();
+    m_lostSeqs.clear();
+    m_retransSeqs.clear();
+    m_pendingSeqs.clear();
+
     for (auto it = m_sentList.begin(); it != m_sentList.end(); ++it)
     {
         if (resetSack)
@@ -1297,6 +1434,7 @@ TcpTxBuffer::SetSentListLost(bool resetSack)
         }
 
         (*it)->m_retrans = false;
+        AddToScoreboard(*it);
     }
 
     NS_LOG_INFO("Set sent list lost, status: " << *this);
@@ -1329,7 +1467,9 @@ TcpTxBuffer::DeleteRetransmittedFlagFromHead()
 
     if (m_sentList.front()->m_retrans)
     {
+        RemoveFromScoreboard(m_sentList.front());
         m_sentList.front()->m_retrans = false;
+        AddToScoreboard(m_sentList.front());
         m_retrans -= m_sentList.front()->m_packet->GetSize();
     }
     ConsistencyCheck();
@@ -1340,6 +1480,8 @@ TcpTxBuffer::MarkHeadAsLost()
 {
     if (!m_sentList.empty())
     {
+        RemoveFromScoreboard(m_sentList.front());
+
         // If the head is sacked (reneging by the receiver the previously sent
         // information) we revert the sacked flag.
         // A sacked head means that we should advance SND.UNA.. so it's an error.
@@ -1360,6 +1502,8 @@ TcpTxBuffer::MarkHeadAsLost()
             m_sentList.front()->m_lost = true;
             m_lostOut += m_sentList.front()->m_packet->GetSize();
         }
+
+        AddToScoreboard(m_sentList.front());
     }
     ConsistencyCheck();
 }
@@ -1392,7 +1536,9 @@ TcpTxBuffer::AddRenoSack()
     // Add to the sacked size the size of the first "not sacked" segment
     if (it != m_sentList.end())
     {
+        RemoveFromScoreboard(*it);
         (*it)->m_sacked = true;
+        AddToScoreboard(*it);
         m_sackedOut += (*it)->m_packet->GetSize();
         m_sackSeen = true;
         m_highestSack = std::make_pair(it, (*it)->m_startSeq);
@@ -1442,6 +1588,22 @@ TcpTxBuffer::ConsistencyCheck() const
     NS_ASSERT_MSG(lost == m_lostOut, " Counted lost: " << lost << " stored lost: " << m_lostOut);
     NS_ASSERT_MSG(retrans == m_retrans,
                   " Counted retrans: " << retrans << " stored retrans: " << m_retrans);
+
+    NS_ASSERT_MSG(m_sentIndex.size() == m_sentList.size(),
+                  "Indexed " << m_sentIndex.size() << " items out of " << m_sentList.size());
+    for (auto it = m_sentList.begin(); it != m_sentList.end(); ++it)
+    {
+        auto found = m_sentIndex.find((*it)->m_startSeq);
+        NS_ASSERT_MSG(found != m_sentIndex.end() && found->second == it,
+                      "Item " << **it << " not indexed");
+        auto self = const_cast<TcpTxBuffer*>(this);
+        std::set<SequenceNumber32>* set = self->GetScoreboardSet(*it);
+        NS_ASSERT_MSG(!set || set->count((*it)->m_startSeq) == 1,
+                      "Item " << **it << " not in the scoreboard");
+    }
+    NS_ASSERT(m_sackedSeqs.size() + m_lostSeqs.size() + m_retransSeqs.size() +
+                  m_pendingSeqs.size() <=
+              m_sentList.size());
 }
 
 std::ostream&
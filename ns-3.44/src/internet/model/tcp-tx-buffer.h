@@ -18,6 +18,9 @@
 #include "ns3/sequence-number.h"
 #include "ns3/traced-value.h"
 
+#include <map>
+#include <set>
+
 namespace ns3
 {
 class Packet;
@@ -61,8 +64,16 @@ class Packet;
  * associated with every segment sent. This is done through the use of the
  * class TcpTxItem: instead of storing a list of packets, we store a list of
  * TcpTxItem. Each item has different flags (check the corresponding
- * documentation) and maintaining the scoreboard is a matter of travelling the
- * list and set the SACK flag on the corresponding segment sent.
+ * documentation) and maintaining the scoreboard is a matter of finding the
+ * segments sent covered by a SACK block and set their SACK flag.
+ *
+ * To avoid walking the list on every ACK, the sent items are also indexed by
+ * their starting sequence number, and the starting sequence numbers of the
+ * items are kept in ordered sets according to their flags (sacked; lost and
+ * not retransmitted; retransmitted; neither of them). A SACK block, IsLost()
+ * and NextSeg() only visit the items they are interested in, at a
+ * logarithmic cost in the number of items, and UpdateLostCount() only visits
+ * the items it marks as lost.
  *
  * Item properties
  * ---------------
@@ -554,7 +565,7 @@ class TcpTxBuffer : public Object
                                  const SequenceNumber32& startingSeq,
                                  uint32_t numBytes,
                                  const SequenceNumber32& requestedSeq,
-                                 bool* listEdited = nullptr) const;
+                                 bool* listEdited = nullptr);
 
     /**
      * @brief Merge two TcpTxItem
@@ -592,6 +603,51 @@ class TcpTxBuffer : public Object
      */
     std::pair<TcpTxBuffer::PacketList::const_iterator, SequenceNumber32> FindHighestSacked() const;
 
+    /**
+     * @brief Get the set of the scoreboard an item belongs to, according to its flags
+     * @param item the item
+     * @return the set, or nullptr for the items lost and retransmitted
+     */
+    std::set<SequenceNumber32>* GetScoreboardSet(const TcpTxItem* item);
+
+    /**
+     * @brief Add a sent item to the set of the scoreboard matching its flags
+     *
+     * Must be called after the flags of the item are changed.
+     * @param item the item
+     */
+    void AddToScoreboard(const TcpTxItem* item);
+
+    /**
+     * @brief Remove a sent item from the set of the scoreboard matching its flags
+     *
+     * Must be called before the flags of the item are changed.
+     * @param item the item
+     */
+    void RemoveFromScoreboard(const TcpTxItem* item);
+
+    /**
+     * @brief Index a sent item by its starting sequence number and add it to the scoreboard
+     * @param it iterator to the item in the sent list
+     */
+    void IndexSentItem(PacketList::iterator it);
+
+    /**
+     * @brief Remove a sent item from the index and from the scoreboard
+     *
+     * Must be called before the starting sequence number of the item is changed
+     * or the item is removed from the sent list.
+     * @param item the item
+     */
+    void UnindexSentItem(const TcpTxItem* item);
+
+    /**
+     * @brief Find the sent item containing a sequence number
+     * @param seq the sequence number
+     * @return an iterator to the item in the sent list, or the end of the list
+     */
+    PacketList::iterator FindSentItem(const SequenceNumber32& seq) const;
+
     PacketList m_appList;              //!< Buffer for application data
     PacketList m_sentList;             //!< Buffer for sent (but not acked) data
     uint32_t m_maxBuffer;              //!< Max number of data bytes in buffer (SND.WND)
@@ -603,6 +659,13 @@ class TcpTxBuffer : public Object
         m_firstByteSeq; //!< Sequence number of the first byte in data (SND.UNA)
     std::pair<PacketList::const_iterator, SequenceNumber32> m_highestSack; //!< Highest SACK byte
 
+    std::map<SequenceNumber32, PacketList::iterator>
+        m_sentIndex; //!< Items of the sent list, by starting sequence number
+    std::set<SequenceNumber32> m_sackedSeqs;  //!< Start of the sacked items
+    std::set<SequenceNumber32> m_lostSeqs;    //!< Start of the lost, not retransmitted items
+    std::set<SequenceNumber32> m_retransSeqs; //!< Start of the retransmitted, not lost items
+    std::set<SequenceNumber32> m_pendingSeqs; //!< Start of the other items (not marked at all)
+
     uint32_t m_lostOut{0};   //!< Number of lost bytes
     uint32_t m_sackedOut{0}; //!< Number of sacked bytes
     uint32_t m_retrans{0};   //!< Number of retransmitted bytes
@@ -0,0 +1,318 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/ipv4-end-point-demux.h"
+#include "ns3/ipv4-end-point.h"
+#include "ns3/ipv4-interface-address.h"
+#include "ns3/ipv4-interface.h"
+#include "ns3/ipv6-end-point-demux.h"
+#include "ns3/ipv6-end-point.h"
+#include "ns3/ipv6-interface.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/test.h"
+
+using namespace ns3;
+
+/**
+ * @ingroup internet-test
+ *
+ * @brief Ipv4EndPointDemux lookup test.
+ *
+ * Checks the priority of the matches (full match, all but local address,
+ * local address and port, local port only), the subnet-directed wildcard
+ * addresses, and that the endpoints are found after their address or peer
+ * is changed.
+ */
+class Ipv4EndPointDemuxTestCase : public TestCase
+{
+  public:
+    Ipv4EndPointDemuxTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * @brief Look up the endpoint receiving a packet.
+     * @param daddr destination address
+     * @param dport destination port
+     * @param saddr source address
+     * @param sport source port
+     * @param incomingInterface the incoming interface
+     * @return the endpoint, or nullptr if none
+     */
+    Ipv4EndPoint* Lookup(std::string daddr,
+                         uint16_t dport,
+                         std::string saddr,
+                         uint16_t sport,
+                         Ptr<Ipv4Interface> incomingInterface);
+
+    Ipv4EndPointDemux m_demux; //!< demux under test
+};
+
+Ipv4EndPointDemuxTestCase::Ipv4EndPointDemuxTestCase()
+    : TestCase("Check the lookups of Ipv4EndPointDemux")
+{
+}
+
+Ipv4EndPoint*
+Ipv4EndPointDemuxTestCase::Lookup(std::string daddr,
+                                  uint16_t dport,
+                                  std::string saddr,
+                                  uint16_t sport,
+                                  Ptr<Ipv4Interface> incomingInterface)
+{
+    Ipv4EndPointDemux::EndPoints endPoints = m_demux.Lookup(Ipv4Address(daddr.c_str()),
+                                                            dport,
+                                                            Ipv4Address(saddr.c_str()),
+                                                            sport,
+                                                            incomingInterface);
+    return endPoints.empty() ? nullptr : endPoints.front();
+}
+
+void
+Ipv4EndPointDemuxTestCase::DoRun()
+{
+    Ptr<SimpleNetDevice> device1 = CreateObject<SimpleNetDevice>();
+    Ptr<SimpleNetDevice> device2 = CreateObject<SimpleNetDevice>();
+    Ptr<Ipv4Interface> interface1 = CreateObject<Ipv4Interface>();
+    interface1->SetDevice(device1);
+    interface1->AddAddress(Ipv4InterfaceAddress("10.1.1.1", "255.255.255.0"));
+    Ptr<Ipv4Interface> interface2 = CreateObject<Ipv4Interface>();
+    interface2->SetDevice(device2);
+    interface2->AddAddress(Ipv4InterfaceAddress("10.2.1.1", "255.255.255.0"));
+
+    Ipv4EndPoint* listener = m_demux.Allocate(nullptr, Ipv4Address::GetAny(), 80);
+    NS_TEST_EXPECT_MSG_EQ(Lookup("10.1.1.1", 80, "10.1.1.2", 1234, interface1),
+                          listener,
+                          "The wildcard endpoint must match");
+    NS_TEST_EXPECT_MSG_EQ(Lookup("10.1.1.1", 81, "10.1.1.2", 1234, interface1),
+                          nullptr,
+                          "No endpoint on this port");
+
+    Ipv4EndPoint* bound = m_demux.Allocate(nullptr, Ipv4Address("10.1.1.1"), 80);
+    NS_TEST_EXPECT_MSG_EQ(Lookup("10.1.1.1", 80, "10.1.1.2", 1234, interface1),
+                          bound,
+                          "The endpoint bound to the local address must be preferred");
+    NS_TEST_EXPECT_MSG_EQ(m_demux.Allocate(nullptr, Ipv4Address("10.1.1.1"), 80),
+                          nullptr,
+                          "Duplicated endpoint");
+    NS_TEST_EXPECT_MSG_EQ(m_demux.SimpleLookup(Ipv4Address("10.1.1.1"),
+                                               80,
+                                               Ipv4Address("10.9.9.9"),
+                                               1),
+                          bound,
+                          "SimpleLookup must return the least generic match");
+
+    Ipv4EndPoint* connection = m_demux.Allocate(nullptr,
+                                                Ipv4Address("10.1.1.1"),
+                                                80,
+                                                Ipv4Address("10.1.1.2"),
+                                                1234);
+    NS_TEST_EXPECT_MSG_EQ(Lookup("10.1.1.1", 80, "10.1.1.2", 1234, interface1),
+                          connection,
+                          "The fully matching endpoint must be preferred");
+    NS_TEST_EXPECT_MSG_EQ(Lookup("10.1.1.1", 80, "10.1.1.2", 1235, interface1),
+                          bound,
+                          "The connection must not match another peer port");
+    NS_TEST_EXPECT_MSG_EQ(
+        m_demux.Allocate(nullptr, Ipv4Address("10.1.1.1"), 80, Ipv4Address("10.1.1.2"), 1234),
+        nullptr,
+        "Duplicated endpoint");
+    NS_TEST_EXPECT_MSG_EQ(m_demux.SimpleLookup(Ipv4Address("10.1.1.1"),
+                                               80,
+                                               Ipv4Address("10.1.1.2"),
+                                               1234),
+                          connection,
+                          "SimpleLookup must return the exact match");
+
+    connection->SetRxEnabled(false);
+    NS_TEST_EXPECT_MSG_EQ(Lookup("10.1.1.1", 80, "10.1.1.2", 1234, interface1),
+                          bound,
+                          "An endpoint with disabled Rx must be skipped");
+    connection->SetRxEnabled(true);
+
+    // an endpoint connected to a remote server from an ephemeral port
+    Ipv4EndPoint* client = m_demux.Allocate();
+    uint16_t port = client->GetLocalPort();
+    NS_TEST_EXPECT_MSG_EQ(m_demux.LookupPortLocal(port), true, "The port must be in use");
+    client->SetPeer(Ipv4Address("10.1.1.3"), 80);
+    NS_TEST_EXPECT_MSG_EQ(Lookup("10.1.1.1", port, "10.1.1.3", 80, interface1),
+                          client,
+                          "The endpoint must be found after its peer is set");
+    client->SetLocalAddress(Ipv4Address("10.1.1.1"));
+    NS_TEST_EXPECT_MSG_EQ(Lookup("10.1.1.1", port, "10.1.1.3", 80, interface1),
+                          client,
+                          "The endpoint must be found after its local address is set");
+    NS_TEST_EXPECT_MSG_EQ(Lookup("10.1.1.1", port, "10.1.1.4", 80, interface1),
+                          nullptr,
+                          "The endpoint must not match another peer");
+
+    // subnet-directed wildcard
+    Ipv4EndPoint* subnet = m_demux.Allocate(nullptr, Ipv4Address("10.1.1.0"), 53);
+    NS_TEST_EXPECT_MSG_EQ(Lookup("10.1.1.255", 53, "10.1.1.2", 1234, interface1),
+                          subnet,
+                          "The endpoint bound to the subnet must match a subnet broadcast");
+    NS_TEST_EXPECT_MSG_EQ(Lookup("10.2.1.255", 53, "10.2.1.2", 1234, interface2),
+                          nullptr,
+                          "The endpoint bound to the subnet must not match another subnet");
+
+    // bound device
+    Ipv4EndPoint* boundToDevice = m_demux.Allocate(device2, Ipv4Address::GetAny(), 8080);
+    boundToDevice->BindToNetDevice(device2);
+    NS_TEST_EXPECT_MSG_EQ(Lookup("10.2.1.1", 8080, "10.2.1.2", 1234, interface2),
+                          boundToDevice,
+                          "The endpoint bound to the device must match");
+    NS_TEST_EXPECT_MSG_EQ(Lookup("10.1.1.1", 8080, "10.1.1.2", 1234, interface1),
+                          nullptr,
+                          "The endpoint bound to another device must not match");
+
+    m_demux.DeAllocate(connection);
+    NS_TEST_EXPECT_MSG_EQ(Lookup("10.1.1.1", 80, "10.1.1.2", 1234, interface1),
+                          bound,
+                          "A deallocated endpoint must not match");
+    m_demux.DeAllocate(bound);
+    m_demux.DeAllocate(listener);
+    NS_TEST_EXPECT_MSG_EQ(m_demux.LookupPortLocal(80), false, "The port must be free");
+    NS_TEST_EXPECT_MSG_EQ(m_demux.GetAllEndPoints().size(), 3, "Wrong number of endpoints");
+}
+
+/**
+ * @ingroup internet-test
+ *
+ * @brief Ipv6EndPointDemux lookup test.
+ *
+ * Checks the priority of the matches and that the endpoints are found
+ * after their address or peer is changed.
+ */
+class Ipv6EndPointDemuxTestCase : public TestCase
+{
+  public:
+    Ipv6EndPointDemuxTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * @brief Look up the endpoint receiving a packet.
+     * @param daddr destination address
+     * @param dport destination port
+     * @param saddr source address
+     * @param sport source port
+     * @param incomingInterface the incoming interface
+     * @return the endpoint, or nullptr if none
+     */
+    Ipv6EndPoint* Lookup(std::string daddr,
+                         uint16_t dport,
+                         std::string saddr,
+                         uint16_t sport,
+                         Ptr<Ipv6Interface> incomingInterface);
+
+    Ipv6EndPointDemux m_demux; //!< demux under test
+};
+
+Ipv6EndPointDemuxTestCase::Ipv6EndPointDemuxTestCase()
+    : TestCase("Check the lookups of Ipv6EndPointDemux")
+{
+}
+
+Ipv6EndPoint*
+Ipv6EndPointDemuxTestCase::Lookup(std::string daddr,
+                                  uint16_t dport,
+                                  std::string saddr,
+                                  uint16_t sport,
+                                  Ptr<Ipv6Interface> incomingInterface)
+{
+    Ipv6EndPointDemux::EndPoints endPoints = m_demux.Lookup(Ipv6Address(daddr.c_str()),
+                                                            dport,
+                                                            Ipv6Address(saddr.c_str()),
+                                                            sport,
+                                                            incomingInterface);
+    return endPoints.empty() ? nullptr : endPoints.front();
+}
+
+void
+Ipv6EndPointDemuxTestCase::DoRun()
+{
+    Ptr<SimpleNetDevice> device1 = CreateObject<SimpleNetDevice>();
+    Ptr<SimpleNetDevice> device2 = CreateObject<SimpleNetDevice>();
+    Ptr<Ipv6Interface> interface1 = CreateObject<Ipv6Interface>();
+    interface1->SetDevice(device1);
+    Ptr<Ipv6Interface> interface2 = CreateObject<Ipv6Interface>();
+    interface2->SetDevice(device2);
+
+    Ipv6EndPoint* listener = m_demux.Allocate(nullptr, Ipv6Address::GetAny(), 80);
+    NS_TEST_EXPECT_MSG_EQ(Lookup("2001:1::1", 80, "2001:1::2", 1234, interface1),
+                          listener,
+                          "The wildcard endpoint must match");
+
+    Ipv6EndPoint* bound = m_demux.Allocate(nullptr, Ipv6Address("2001:1::1"), 80);
+    NS_TEST_EXPECT_MSG_EQ(Lookup("2001:1::1", 80, "2001:1::2", 1234, interface1),
+                          bound,
+                          "The endpoint bound to the local address must be preferred");
+
+    Ipv6EndPoint* connection = m_demux.Allocate(nullptr,
+                                                Ipv6Address("2001:1::1"),
+                                                80,
+                                                Ipv6Address("2001:1::2"),
+                                                1234);
+    NS_TEST_EXPECT_MSG_EQ(Lookup("2001:1::1", 80, "2001:1::2", 1234, interface1),
+                          connection,
+                          "The fully matching endpoint must be preferred");
+    NS_TEST_EXPECT_MSG_EQ(Lookup("2001:1::1", 80, "2001:1::3", 1234, interface1),
+                          bound,
+                          "The connection must not match another peer");
+    NS_TEST_EXPECT_MSG_EQ(m_demux.SimpleLookup(Ipv6Address("2001:1::1"),
+                                               80,
+                                               Ipv6Address("2001:1::2"),
+                                               1234),
+                          connection,
+                          "SimpleLookup must return the exact match");
+
+    Ipv6EndPoint* client = m_demux.Allocate();
+    uint16_t port = client->GetLocalPort();
+    client->SetPeer(Ipv6Address("2001:1::3"), 80);
+    NS_TEST_EXPECT_MSG_EQ(Lookup("2001:1::1", port, "2001:1::3", 80, interface1),
+                          client,
+                          "The endpoint must be found after its peer is set");
+    client->SetLocalAddress(Ipv6Address("2001:1::1"));
+    NS_TEST_EXPECT_MSG_EQ(Lookup("2001:1::1", port, "2001:1::3", 80, interface1),
+                          client,
+                          "The endpoint must be found after its local address is set");
+
+    Ipv6EndPoint* boundToDevice = m_demux.Allocate(device2, Ipv6Address::GetAny(), 8080);
+    boundToDevice->BindToNetDevice(device2);
+    NS_TEST_EXPECT_MSG_EQ(Lookup("2001:2::1", 8080, "2001:2::2", 1234, interface2),
+                          boundToDevice,
+                          "The endpoint bound to the device must match");
+    NS_TEST_EXPECT_MSG_EQ(Lookup("2001:1::1", 8080, "2001:1::2", 1234, interface1),
+                          nullptr,
+                          "The endpoint bound to another device must not match");
+
+    m_demux.DeAllocate(connection);
+    NS_TEST_EXPECT_MSG_EQ(Lookup("2001:1::1", 80, "2001:1::2", 1234, interface1),
+                          bound,
+                          "A deallocated endpoint must not match");
+    m_demux.DeAllocate(bound);
+    m_demux.DeAllocate(listener);
+    NS_TEST_EXPECT_MSG_EQ(m_demux.LookupPortLocal(80), false, "The port must be free");
+    NS_TEST_EXPECT_MSG_EQ(m_demux.GetEndPoints().size(), 2, "Wrong number of endpoints");
+}
+
+/**
+ * @ingroup internet-test
+ *
+ * @brief Endpoint demux TestSuite
+ */
+class EndPointDemuxTestSuite : public TestSuite
+{
+  public:
+    EndPointDemuxTestSuite()
+        : TestSuite("end-point-demux", Type::UNIT)
+    {
+        AddTestCase(new Ipv4EndPointDemuxTestCase, TestCase::Duration::QUICK);
+        AddTestCase(new Ipv6EndPointDemuxTestCase, TestCase::Duration::QUICK);
+    }
+};
+
+static EndPointDemuxTestSuite g_endPointDemuxTestSuite; //!< Static variable for test initialization
@@ -5,6 +5,9 @@
 #include "ns3/boolean.h"
 #include "ns3/bridge-helper.h"
 #include "ns3/config.h"
+#include "ns3/global-route-manager.h"
+#include "ns3/global-router-interface.h"
+#include "ns3/global-value.h"
 #include "ns3/inet-socket-address.h"
 #include "ns3/internet-stack-helper.h"
 #include "ns3/ipv4-address-helper.h"
@@ -30,6 +33,8 @@
 #include "ns3/udp-socket-factory.h"
 #include "ns3/uinteger.h"
 
+#include <set>
+#include <sstream>
 #include <vector>
 
 using namespace ns3;
@@ -1300,6 +1305,342 @@ Ipv4GlobalRoutingSlash32TestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup internet-test
+ *
+ * @brief IPv4 GlobalRouting lookup test
+ *
+ * The routes are added by hand to a node with three interfaces, and looked
+ * up with RouteOutput. All the matching network routes are candidates,
+ * whatever the length of their prefix, in the order they were added, and
+ * the first added matching AS external route is selected.
+ */
+class Ipv4GlobalRoutingLookupTestCase : public TestCase
+{
+  public:
+    Ipv4GlobalRoutingLookupTestCase();
+
+  private:
+    void DoRun() override;
+    /**
+     * @brief Look up a route.
+     * @param dest The destination.
+     * @param oif The requested output device, if any.
+     * @returns The gateway of the route, or 255.255.255.255 if there is no route.
+     */
+    Ipv4Address Lookup(std::string dest, Ptr<NetDevice> oif = nullptr);
+
+    Ptr<Ipv4GlobalRouting> m_routing; //!< The routing protocol under test.
+};
+
+Ipv4GlobalRoutingLookupTestCase::Ipv4GlobalRoutingLookupTestCase()
+    : TestCase("Global routing lookup")
+{
+}
+
+Ipv4Address
+Ipv4GlobalRoutingLookupTestCase::Lookup(std::string dest, Ptr<NetDevice> oif)
+{
+    Ipv4Header header;
+    header.SetDestination(Ipv4Address(dest.c_str()));
+    Socket::SocketErrno sockerr;
+    Ptr<Ipv4Route> route = m_routing->RouteOutput(nullptr, header, oif, sockerr);
+    return route ? route->GetGateway() : Ipv4Address::GetBroadcast();
+}
+
+void
+Ipv4GlobalRoutingLookupTestCase::DoRun()
+{
+    Ptr<Node> node = CreateObject<Node>();
+    InternetStackHelper internet;
+    Ipv4GlobalRoutingHelper globalRoutingHelper;
+    internet.SetRoutingHelper(globalRoutingHelper);
+    internet.Install(node);
+    Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
+    std::vector<Ptr<NetDevice>> devices;
+    for (uint32_t i = 1; i <= 3; i++)
+    {
+        Ptr<SimpleNetDevice> device = CreateObject<SimpleNetDevice>();
+        device->SetAddress(Mac48Address::Allocate());
+        node->AddDevice(device);
+        uint32_t interface = ipv4->AddInterface(device);
+        std::ostringstream address;
+        address << "192.168." << i << ".1";
+        ipv4->AddAddress(interface,
+                         Ipv4InterfaceAddress(Ipv4Address(address.str().c_str()), "/24"));
+        ipv4->SetUp(interface);
+        devices.push_back(device);
+    }
+    m_routing = ipv4->GetRoutingProtocol()->GetObject<Ipv4GlobalRouting>();
+    NS_TEST_ASSERT_MSG_NE(m_routing, nullptr, "Error-- no Ipv4GlobalRouting object");
+
+    m_routing->AddASExternalRouteTo("0.0.0.0", "0.0.0.0", "192.168.1.254", 1);
+    m_routing->AddASExternalRouteTo("172.16.0.0", "255.240.0.0", "192.168.2.254", 2);
+    m_routing->AddNetworkRouteTo("10.0.0.0", "255.0.0.0", "192.168.1.2", 1);
+    m_routing->AddNetworkRouteTo("10.1.0.0", "255.255.0.0", "192.168.2.2", 2);
+    m_routing->AddNetworkRouteTo("10.1.0.0", "255.255.0.0", "192.168.3.2", 3);
+    m_routing->AddHostRouteTo("10.1.2.3", "192.168.3.3", 3);
+
+    NS_TEST_EXPECT_MSG_EQ(Lookup("10.1.2.3"), Ipv4Address("192.168.3.3"), "Host route expected");
+    NS_TEST_EXPECT_MSG_EQ(Lookup("10.1.2.4"),
+                          Ipv4Address("192.168.1.2"),
+                          "First added matching route expected");
+    NS_TEST_EXPECT_MSG_EQ(Lookup("10.2.0.1"), Ipv4Address("192.168.1.2"), "/8 route expected");
+    NS_TEST_EXPECT_MSG_EQ(Lookup("172.16.0.1"),
+                          Ipv4Address("192.168.1.254"),
+                          "First added external route expected");
+
+    // routes on the requested output device only
+    NS_TEST_EXPECT_MSG_EQ(Lookup("10.1.2.3", devices[1]),
+                          Ipv4Address("192.168.2.2"),
+                          "Network route on the second device expected");
+    NS_TEST_EXPECT_MSG_EQ(Lookup("10.1.2.4", devices[2]),
+                          Ipv4Address("192.168.3.2"),
+                          "Route on the third device expected");
+    NS_TEST_EXPECT_MSG_EQ(Lookup("10.1.2.4", devices[0]),
+                          Ipv4Address("192.168.1.2"),
+                          "Route on the first device expected");
+    NS_TEST_EXPECT_MSG_EQ(Lookup("172.16.0.1", devices[1]),
+                          Ipv4Address("192.168.2.254"),
+                          "External route on the second device expected");
+    NS_TEST_EXPECT_MSG_EQ(Lookup("172.16.0.1", devices[2]),
+                          Ipv4Address::GetBroadcast(),
+                          "No route on the third device expected");
+
+    // all the matching network routes are selected with random ECMP
+    m_routing->SetAttribute("RandomEcmpRouting", BooleanValue(true));
+    std::set<Ipv4Address> gateways;
+    for (uint32_t i = 0; i < 100; i++)
+    {
+        gateways.insert(Lookup("10.1.2.4"));
+    }
+    NS_TEST_EXPECT_MSG_EQ(gateways.size(), 3, "All the ECMP routes must be used");
+    m_routing->SetAttribute("RandomEcmpRouting", BooleanValue(false));
+
+    // removing routes updates the lookups; the routes are numbered host
+    // routes first, then network routes, then external routes
+    m_routing->RemoveRoute(0);
+    NS_TEST_EXPECT_MSG_EQ(Lookup("10.1.2.3"),
+                          Ipv4Address("192.168.1.2"),
+                          "Network route expected once the host route is removed");
+    m_routing->RemoveRoute(0);
+    NS_TEST_EXPECT_MSG_EQ(Lookup("10.1.2.3"),
+                          Ipv4Address("192.168.2.2"),
+                          "/16 route expected once the /8 route is removed");
+    m_routing->RemoveRoute(2);
+    NS_TEST_EXPECT_MSG_EQ(Lookup("172.16.0.1"),
+                          Ipv4Address("192.168.2.254"),
+                          "External route expected once the default route is removed");
+    NS_TEST_EXPECT_MSG_EQ(m_routing->GetNRoutes(), 3, "Three routes expected");
+
+    // a shorter prefix added last is a candidate for the longer prefixes, after their routes
+    m_routing->AddNetworkRouteTo("10.0.0.0", "255.0.0.0", "192.168.3.9", 3);
+    NS_TEST_EXPECT_MSG_EQ(Lookup("10.1.2.3"),
+                          Ipv4Address("192.168.2.2"),
+                          "First added matching route expected");
+    NS_TEST_EXPECT_MSG_EQ(Lookup("10.1.2.3", devices[2]),
+                          Ipv4Address("192.168.3.2"),
+                          "First added route on the third device expected");
+    NS_TEST_EXPECT_MSG_EQ(Lookup("10.2.0.1"), Ipv4Address("192.168.3.9"), "/8 route expected");
+    m_routing->SetAttribute("RandomEcmpRouting", BooleanValue(true));
+    gateways.clear();
+    for (uint32_t i = 0; i < 100; i++)
+    {
+        gateways.insert(Lookup("10.1.2.3", devices[2]));
+    }
+    NS_TEST_EXPECT_MSG_EQ(gateways.size(), 2, "Both routes on the third device must be used");
+
+    // a route with a non contiguous mask is a candidate for the addresses it matches
+    m_routing->AddNetworkRouteTo("10.0.3.0", "255.0.255.0", "192.168.2.7", 2);
+    NS_TEST_EXPECT_MSG_EQ(Lookup("10.9.3.1", devices[1]),
+                          Ipv4Address("192.168.2.7"),
+                          "Route with a non contiguous mask expected");
+    NS_TEST_EXPECT_MSG_EQ(Lookup("10.9.4.1", devices[1]),
+                          Ipv4Address::GetBroadcast(),
+                          "No route on the second device expected");
+    gateways.clear();
+    for (uint32_t i = 0; i < 100; i++)
+    {
+        gateways.insert(Lookup("10.1.3.1", devices[1]));
+    }
+    NS_TEST_EXPECT_MSG_EQ(gateways.size(), 2, "Both routes on the second device must be used");
+    m_routing->SetAttribute("RandomEcmpRouting", BooleanValue(false));
+    NS_TEST_EXPECT_MSG_EQ(Lookup("10.1.3.1", devices[1]),
+                          Ipv4Address("192.168.2.2"),
+                          "First added matching route expected");
+
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup internet-test
+ *
+ * @brief IPv4 GlobalRouting parallel and incremental SPF test
+ *
+ * The routes computed by several threads, and the routes updated after a
+ * link change, must be the ones of a full computation on a single thread.
+ */
+class Ipv4GlobalRoutingSpfTestCase : public TestCase
+{
+  public:
+    Ipv4GlobalRoutingSpfTestCase();
+
+  private:
+    void DoRun() override;
+    /**
+     * @brief Get the routes of all the nodes.
+     * @returns The routes of each node, as sorted strings.
+     */
+    std::vector<std::multiset<std::string>> GetRoutes() const;
+    /**
+     * @brief Compute all the routes from scratch on a single thread.
+     * @returns The routes of each node, as sorted strings.
+     */
+    std::vector<std::multiset<std::string>> ComputeRoutes() const;
+    /**
+     * @brief Change the metric of a link.
+     * @param link The index of the link.
+     * @param metric The new metric.
+     */
+    void SetLinkMetric(uint32_t link, uint16_t metric);
+
+    NodeContainer m_nodes;                   //!< Nodes used in the test.
+    std::vector<NetDeviceContainer> m_links; //!< Point-to-point links.
+};
+
+Ipv4GlobalRoutingSpfTestCase::Ipv4GlobalRoutingSpfTestCase()
+    : TestCase("Global routing parallel and incremental SPF")
+{
+}
+
+std::vector<std::multiset<std::string>>
+Ipv4GlobalRoutingSpfTestCase::GetRoutes() const
+{
+    std::vector<std::multiset<std::string>> routes;
+    for (uint32_t i = 0; i < m_nodes.GetN(); i++)
+    {
+        Ptr<Ipv4GlobalRouting> routing =
+            m_nodes.Get(i)->GetObject<GlobalRouter>()->GetRoutingProtocol();
+        std::multiset<std::string> nodeRoutes;
+        for (uint32_t j = 0; j < routing->GetNRoutes(); j++)
+        {
+            std::ostringstream oss;
+            oss << *routing->GetRoute(j);
+            nodeRoutes.insert(oss.str());
+        }
+        routes.push_back(nodeRoutes);
+    }
+    return routes;
+}
+
+std::vector<std::multiset<std::string>>
+Ipv4GlobalRoutingSpfTestCase::ComputeRoutes() const
+{
+    UintegerValue threads;
+    GlobalValue::GetValueByName("GlobalRoutingSpfThreads", threads);
+    Config::SetGlobal("GlobalRoutingSpfThreads", UintegerValue(1));
+    GlobalRouteManager::DeleteGlobalRoutes();
+    GlobalRouteManager::BuildGlobalRoutingDatabase();
+    GlobalRouteManager::InitializeRoutes();
+    Config::SetGlobal("GlobalRoutingSpfThreads", threads);
+    return GetRoutes();
+}
+
+void
+Ipv4GlobalRoutingSpfTestCase::SetLinkMetric(uint32_t link, uint16_t metric)
+{
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        Ptr<NetDevice> device = m_links[link].Get(i);
+        Ptr<Ipv4> ipv4 = device->GetNode()->GetObject<Ipv4>();
+        ipv4->SetMetric(ipv4->GetInterfaceForDevice(device), metric);
+    }
+}
+
+void
+Ipv4GlobalRoutingSpfTestCase::DoRun()
+{
+    // a ring of ten routers with two chords, a LAN between three of them and
+    // a stub node
+    m_nodes.Create(12);
+    InternetStackHelper internet;
+    Ipv4GlobalRoutingHelper globalRoutingHelper;
+    internet.SetRoutingHelper(globalRoutingHelper);
+    internet.Install(m_nodes);
+
+    SimpleNetDeviceHelper p2pHelper;
+    p2pHelper.SetNetDevicePointToPointMode(true);
+    Ipv4AddressHelper address("10.0.0.0", "255.255.255.252");
+    std::vector<std::pair<uint32_t, uint32_t>> links;
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        links.emplace_back(i, (i + 1) % 10);
+    }
+    links.emplace_back(0, 5);
+    links.emplace_back(2, 7);
+    links.emplace_back(10, 11);
+    for (const auto& [a, b] : links)
+    {
+        m_links.push_back(p2pHelper.Install(NodeContainer(m_nodes.Get(a), m_nodes.Get(b))));
+        address.Assign(m_links.back());
+        address.NewNetwork();
+    }
+    SimpleNetDeviceHelper lanHelper;
+    NodeContainer lan(m_nodes.Get(3), m_nodes.Get(8), m_nodes.Get(10));
+    Ipv4AddressHelper lanAddress("10.1.0.0", "255.255.255.0");
+    lanAddress.Assign(lanHelper.Install(lan));
+
+    Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+    std::vector<std::multiset<std::string>> reference = GetRoutes();
+    NS_TEST_ASSERT_MSG_EQ(reference[0].empty(), false, "Routes expected");
+
+    // parallel computation
+    Config::SetGlobal("GlobalRoutingSpfThreads", UintegerValue(4));
+    GlobalRouteManager::DeleteGlobalRoutes();
+    GlobalRouteManager::BuildGlobalRoutingDatabase();
+    GlobalRouteManager::InitializeRoutes();
+    NS_TEST_EXPECT_MSG_EQ((GetRoutes() == reference),
+                          true,
+                          "Parallel SPF must compute the routes of serial SPF");
+
+    // without any change, no route is recomputed
+    Ptr<Ipv4GlobalRouting> routing0 =
+        m_nodes.Get(0)->GetObject<GlobalRouter>()->GetRoutingProtocol();
+    routing0->AddHostRouteTo("192.168.0.1", "10.0.0.2", 1);
+    Ipv4GlobalRoutingHelper::RecomputeRoutingTables();
+    NS_TEST_EXPECT_MSG_EQ(routing0->GetNRoutes(),
+                          reference[0].size() + 1,
+                          "Routes must not be recomputed when nothing changed");
+
+    // a cheaper chord attracts traffic
+    SetLinkMetric(10, 1);
+    SetLinkMetric(0, 5);
+    Ipv4GlobalRoutingHelper::RecomputeRoutingTables();
+    std::vector<std::multiset<std::string>> updated = GetRoutes();
+    NS_TEST_EXPECT_MSG_EQ((updated != reference), true, "The metric change must change routes");
+    NS_TEST_EXPECT_MSG_EQ((updated == ComputeRoutes()),
+                          true,
+                          "Incremental SPF must compute the routes of a full SPF");
+
+    // a more expensive link which is not on any shortest path
+    SetLinkMetric(11, 20);
+    Ipv4GlobalRoutingHelper::RecomputeRoutingTables();
+    NS_TEST_EXPECT_MSG_EQ((GetRoutes() == ComputeRoutes()),
+                          true,
+                          "Incremental SPF must compute the routes of a full SPF");
+
+    // a link down
+    Ptr<Ipv4> ipv4 = m_nodes.Get(5)->GetObject<Ipv4>();
+    ipv4->SetDown(ipv4->GetInterfaceForDevice(m_links[5].Get(0)));
+    Ipv4GlobalRoutingHelper::RecomputeRoutingTables();
+    NS_TEST_EXPECT_MSG_EQ((GetRoutes() == ComputeRoutes()),
+                          true,
+                          "Incremental SPF must compute the routes of a full SPF");
+
+    Config::SetGlobal("GlobalRoutingSpfThreads", UintegerValue(1));
+    Simulator::Destroy();
+}
+
 /**
  * @ingroup internet-test
  *
@@ -1322,6 +1663,8 @@ Ipv4GlobalRoutingTestSuite::Ipv4GlobalRoutingTestSuite()
     AddTestCase(new TwoBridgeTest, TestCase::Duration::QUICK);
     AddTestCase(new Ipv4DynamicGlobalRoutingTestCase, TestCase::Duration::QUICK);
     AddTestCase(new Ipv4GlobalRoutingSlash32TestCase, TestCase::Duration::QUICK);
+    AddTestCase(new Ipv4GlobalRoutingLookupTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new Ipv4GlobalRoutingSpfTestCase, TestCase::Duration::QUICK);
 }
 
 static Ipv4GlobalRoutingTestSuite
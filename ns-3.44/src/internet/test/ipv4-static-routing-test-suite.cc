@@ -9,6 +9,8 @@
 #include "ns3/inet-socket-address.h"
 #include "ns3/internet-stack-helper.h"
 #include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4-route.h"
+#include "ns3/ipv4-routing-table-entry.h"
 #include "ns3/ipv4-static-routing-helper.h"
 #include "ns3/node-container.h"
 #include "ns3/node.h"
@@ -196,6 +198,192 @@ Ipv4StaticRoutingSlash32TestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup internet-test
+ *
+ * @brief IPv4 StaticRouting route selection Test
+ *
+ * Checks the longest prefix match, the metric tie breaking and the
+ * invalidation of the route cache when routes are added or removed.
+ */
+class Ipv4StaticRoutingLookupTestCase : public TestCase
+{
+  public:
+    Ipv4StaticRoutingLookupTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * @brief Look up the route to a destination.
+     * @param dest The destination.
+     * @param oif The output device, if any.
+     * @return The gateway of the route, or 255.255.255.255 if there is no route.
+     */
+    Ipv4Address GetGateway(std::string dest, Ptr<NetDevice> oif = nullptr);
+
+    Ptr<Ipv4StaticRouting> m_routing; //!< Static routing under test
+};
+
+Ipv4StaticRoutingLookupTestCase::Ipv4StaticRoutingLookupTestCase()
+    : TestCase("Static routing route selection")
+{
+}
+
+Ipv4Address
+Ipv4StaticRoutingLookupTestCase::GetGateway(std::string dest, Ptr<NetDevice> oif)
+{
+    Ipv4Header header;
+    header.SetDestination(Ipv4Address(dest.c_str()));
+    Socket::SocketErrno sockerr;
+    Ptr<Ipv4Route> route = m_routing->RouteOutput(nullptr, header, oif, sockerr);
+    return route ? route->GetGateway() : Ipv4Address::GetBroadcast();
+}
+
+void
+Ipv4StaticRoutingLookupTestCase::DoRun()
+{
+    Ptr<Node> node = CreateObject<Node>();
+    InternetStackHelper internet;
+    internet.Install(node);
+    Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
+
+    std::vector<Ptr<SimpleNetDevice>> devices;
+    for (uint32_t i = 1; i <= 2; i++)
+    {
+        Ptr<SimpleNetDevice> device = CreateObject<SimpleNetDevice>();
+        device->SetAddress(Mac48Address::Allocate());
+        node->AddDevice(device);
+        devices.push_back(device);
+        int32_t ifIndex = ipv4->AddInterface(device);
+        std::ostringstream address;
+        address << "10.0." << i << ".1";
+        ipv4->AddAddress(ifIndex,
+                         Ipv4InterfaceAddress(Ipv4Address(address.str().c_str()),
+                                              Ipv4Mask("255.255.255.0")));
+        ipv4->SetUp(ifIndex);
+    }
+
+    Ipv4StaticRoutingHelper ipv4RoutingHelper;
+    m_routing = ipv4RoutingHelper.GetStaticRouting(ipv4);
+    m_routing->AddNetworkRouteTo(Ipv4Address("192.168.0.0"),
+                                 Ipv4Mask("255.255.0.0"),
+                                 Ipv4Address("10.0.1.2"),
+                                 1,
+                                 5);
+    m_routing->AddNetworkRouteTo(Ipv4Address("192.168.1.0"),
+                                 Ipv4Mask("255.255.255.0"),
+                                 Ipv4Address("10.0.2.2"),
+                                 2,
+                                 10);
+    m_routing->AddNetworkRouteTo(Ipv4Address("192.168.1.0"),
+                                 Ipv4Mask("255.255.255.0"),
+                                 Ipv4Address("10.0.1.3"),
+                                 1,
+                                 1);
+    m_routing->AddNetworkRouteTo(Ipv4Address("192.168.1.0"),
+                                 Ipv4Mask("255.255.255.0"),
+                                 Ipv4Address("10.0.1.4"),
+                                 1,
+                                 10);
+    // many host routes, which must not slow down nor disturb the lookups
+    for (uint32_t i = 0; i < 1000; i++)
+    {
+        m_routing->AddHostRouteTo(Ipv4Address(Ipv4Address("172.16.0.0").Get() + i),
+                                  Ipv4Address("10.0.2.3"),
+                                  2);
+    }
+
+    NS_TEST_EXPECT_MSG_EQ(GetGateway("192.168.1.5"),
+                          Ipv4Address("10.0.1.3"),
+                          "The route with the lowest metric must be selected");
+    NS_TEST_EXPECT_MSG_EQ(GetGateway("192.168.1.5"),
+                          Ipv4Address("10.0.1.3"),
+                          "The cached route must be selected");
+    NS_TEST_EXPECT_MSG_EQ(GetGateway("192.168.2.5"),
+                          Ipv4Address("10.0.1.2"),
+                          "The shorter prefix must be selected");
+    NS_TEST_EXPECT_MSG_EQ(GetGateway("192.168.1.5", devices[1]),
+                          Ipv4Address("10.0.2.2"),
+                          "The route on the requested device must be selected");
+    NS_TEST_EXPECT_MSG_EQ(GetGateway("192.168.2.5", devices[1]),
+                          Ipv4Address::GetBroadcast(),
+                          "No route on the requested device");
+    NS_TEST_EXPECT_MSG_EQ(GetGateway("172.16.3.231"),
+                          Ipv4Address("10.0.2.3"),
+                          "The host route must be selected");
+    NS_TEST_EXPECT_MSG_EQ(GetGateway("10.0.2.7"),
+                          Ipv4Address::GetZero(),
+                          "The route to the attached network must be selected");
+    NS_TEST_EXPECT_MSG_EQ(GetGateway("8.8.8.8"), Ipv4Address::GetBroadcast(), "No route");
+
+    // removing and adding routes must flush the route cache
+    for (uint32_t i = 0; i < m_routing->GetNRoutes(); i++)
+    {
+        if (m_routing->GetRoute(i).GetGateway() == Ipv4Address("10.0.1.3"))
+        {
+            m_routing->RemoveRoute(i);
+            break;
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ(GetGateway("192.168.1.5"),
+                          Ipv4Address("10.0.1.4"),
+                          "On a metric tie, the last added route must be selected");
+    m_routing->AddHostRouteTo(Ipv4Address("192.168.1.5"), Ipv4Address("10.0.2.4"), 2, 20);
+    NS_TEST_EXPECT_MSG_EQ(GetGateway("192.168.1.5"),
+                          Ipv4Address("10.0.2.4"),
+                          "The added host route must be selected");
+    m_routing->SetDefaultRoute(Ipv4Address("10.0.2.5"), 2);
+    NS_TEST_EXPECT_MSG_EQ(GetGateway("8.8.8.8"),
+                          Ipv4Address("10.0.2.5"),
+                          "The added default route must be selected");
+    ipv4->SetDown(2);
+    NS_TEST_EXPECT_MSG_EQ(GetGateway("192.168.1.5"),
+                          Ipv4Address("10.0.1.4"),
+                          "The routes through a down interface must be removed");
+    NS_TEST_EXPECT_MSG_EQ(GetGateway("8.8.8.8"),
+                          Ipv4Address::GetBroadcast(),
+                          "The default route through a down interface must be removed");
+
+    // a route with a non contiguous mask matches the addresses equal to its
+    // network address on the bits of the mask, its prefix length being the
+    // index of the last bit of the mask
+    m_routing->AddNetworkRouteTo(Ipv4Address("172.0.5.0"),
+                                 Ipv4Mask("255.0.255.0"),
+                                 Ipv4Address("10.0.1.9"),
+                                 1,
+                                 0);
+    NS_TEST_EXPECT_MSG_EQ(GetGateway("172.99.5.1"),
+                          Ipv4Address("10.0.1.9"),
+                          "The route with a non contiguous mask must be selected");
+    NS_TEST_EXPECT_MSG_EQ(GetGateway("172.99.6.1"), Ipv4Address::GetBroadcast(), "No route");
+    m_routing->AddNetworkRouteTo(Ipv4Address("172.99.5.0"),
+                                 Ipv4Mask("255.255.255.0"),
+                                 Ipv4Address("10.0.1.10"),
+                                 1,
+                                 0);
+    NS_TEST_EXPECT_MSG_EQ(GetGateway("172.99.5.1"),
+                          Ipv4Address("10.0.1.10"),
+                          "On a metric tie, the last added route must be selected");
+    NS_TEST_EXPECT_MSG_EQ(GetGateway("172.98.5.1"),
+                          Ipv4Address("10.0.1.9"),
+                          "The route with a non contiguous mask must be selected");
+    for (uint32_t i = 0; i < m_routing->GetNRoutes(); i++)
+    {
+        if (m_routing->GetRoute(i).GetGateway() == Ipv4Address("10.0.1.9"))
+        {
+            m_routing->RemoveRoute(i);
+            break;
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ(GetGateway("172.98.5.1"),
+                          Ipv4Address::GetBroadcast(),
+                          "The route with a non contiguous mask must be removed");
+
+    m_routing = nullptr;
+    Simulator::Destroy();
+}
+
 /**
  * @ingroup internet-test
  *
@@ -211,6 +399,7 @@ Ipv4StaticRoutingTestSuite::Ipv4StaticRoutingTestSuite()
     : TestSuite("ipv4-static-routing", Type::UNIT)
 {
     AddTestCase(new Ipv4StaticRoutingSlash32TestCase, TestCase::Duration::QUICK);
+    AddTestCase(new Ipv4StaticRoutingLookupTestCase, TestCase::Duration::QUICK);
 }
 
 static Ipv4StaticRoutingTestSuite
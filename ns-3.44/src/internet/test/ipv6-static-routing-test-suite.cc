@@ -0,0 +1,190 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// Tests for the route selection of Ipv6 static routing
+
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv6-route.h"
+#include "ns3/ipv6-routing-table-entry.h"
+#include "ns3/ipv6-static-routing-helper.h"
+#include "ns3/ipv6-static-routing.h"
+#include "ns3/node.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <sstream>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * @ingroup internet-test
+ *
+ * @brief IPv6 StaticRouting route selection Test
+ *
+ * Checks the longest prefix match, the metric tie breaking and the
+ * invalidation of the route cache when routes are added or removed.
+ */
+class Ipv6StaticRoutingLookupTestCase : public TestCase
+{
+  public:
+    Ipv6StaticRoutingLookupTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * @brief Look up the route to a destination.
+     * @param dest The destination.
+     * @param oif The output device, if any.
+     * @return The gateway of the route, or ff02::1 if there is no route.
+     */
+    Ipv6Address GetGateway(std::string dest, Ptr<NetDevice> oif = nullptr);
+
+    Ptr<Ipv6StaticRouting> m_routing; //!< Static routing under test
+};
+
+Ipv6StaticRoutingLookupTestCase::Ipv6StaticRoutingLookupTestCase()
+    : TestCase("Static routing route selection")
+{
+}
+
+Ipv6Address
+Ipv6StaticRoutingLookupTestCase::GetGateway(std::string dest, Ptr<NetDevice> oif)
+{
+    Ipv6Header header;
+    header.SetDestination(Ipv6Address(dest.c_str()));
+    Socket::SocketErrno sockerr;
+    Ptr<Ipv6Route> route = m_routing->RouteOutput(nullptr, header, oif, sockerr);
+    return route ? route->GetGateway() : Ipv6Address::GetAllNodesMulticast();
+}
+
+void
+Ipv6StaticRoutingLookupTestCase::DoRun()
+{
+    Ptr<Node> node = CreateObject<Node>();
+    InternetStackHelper internet;
+    internet.SetIpv4StackInstall(false);
+    internet.Install(node);
+    Ptr<Ipv6> ipv6 = node->GetObject<Ipv6>();
+
+    std::vector<Ptr<SimpleNetDevice>> devices;
+    for (uint32_t i = 1; i <= 2; i++)
+    {
+        Ptr<SimpleNetDevice> device = CreateObject<SimpleNetDevice>();
+        device->SetAddress(Mac48Address::Allocate());
+        node->AddDevice(device);
+        devices.push_back(device);
+        int32_t ifIndex = ipv6->AddInterface(device);
+        std::ostringstream address;
+        address << "2001:" << i << "::1";
+        ipv6->AddAddress(ifIndex,
+                         Ipv6InterfaceAddress(Ipv6Address(address.str().c_str()), Ipv6Prefix(64)));
+        ipv6->SetUp(ifIndex);
+    }
+
+    Ipv6StaticRoutingHelper ipv6RoutingHelper;
+    m_routing = ipv6RoutingHelper.GetStaticRouting(ipv6);
+    m_routing->AddNetworkRouteTo(Ipv6Address("2001:db8::"),
+                                 Ipv6Prefix(32),
+                                 Ipv6Address("fe80::2"),
+                                 1,
+                                 5);
+    m_routing->AddNetworkRouteTo(Ipv6Address("2001:db8:1::"),
+                                 Ipv6Prefix(48),
+                                 Ipv6Address("fe80::3"),
+                                 2,
+                                 10);
+    m_routing->AddNetworkRouteTo(Ipv6Address("2001:db8:1::"),
+                                 Ipv6Prefix(48),
+                                 Ipv6Address("fe80::4"),
+                                 1,
+                                 1);
+    m_routing->AddNetworkRouteTo(Ipv6Address("2001:db8:1::"),
+                                 Ipv6Prefix(48),
+                                 Ipv6Address("fe80::6"),
+                                 1,
+                                 10);
+    m_routing->AddNetworkRouteTo(Ipv6Address("2001:db8:1:8000::"),
+                                 Ipv6Prefix(49),
+                                 Ipv6Address("fe80::5"),
+                                 2,
+                                 10);
+    // many host routes, which must not slow down nor disturb the lookups
+    for (uint32_t i = 0; i < 1000; i++)
+    {
+        std::ostringstream address;
+        address << "2001:db8:ff::" << std::hex << i;
+        m_routing->AddHostRouteTo(Ipv6Address(address.str().c_str()), Ipv6Address("fe80::7"), 2);
+    }
+
+    NS_TEST_EXPECT_MSG_EQ(GetGateway("2001:db8:1::5"),
+                          Ipv6Address("fe80::4"),
+                          "The route with the lowest metric must be selected");
+    NS_TEST_EXPECT_MSG_EQ(GetGateway("2001:db8:1::5"),
+                          Ipv6Address("fe80::4"),
+                          "The cached route must be selected");
+    NS_TEST_EXPECT_MSG_EQ(GetGateway("2001:db8:1:8001::1"),
+                          Ipv6Address("fe80::5"),
+                          "The longest prefix must be selected");
+    NS_TEST_EXPECT_MSG_EQ(GetGateway("2001:db8:2::1"),
+                          Ipv6Address("fe80::2"),
+                          "The shorter prefix must be selected");
+    NS_TEST_EXPECT_MSG_EQ(GetGateway("2001:db8:1::5", devices[1]),
+                          Ipv6Address("fe80::3"),
+                          "The route on the requested device must be selected");
+    NS_TEST_EXPECT_MSG_EQ(GetGateway("2001:db8:ff::3e7"),
+                          Ipv6Address("fe80::7"),
+                          "The host route must be selected");
+    NS_TEST_EXPECT_MSG_EQ(GetGateway("2001:2::7"),
+                          Ipv6Address::GetZero(),
+                          "The route to the attached network must be selected");
+    NS_TEST_EXPECT_MSG_EQ(GetGateway("3001::1"), Ipv6Address::GetAllNodesMulticast(), "No route");
+
+    // removing and adding routes must flush the route cache
+    for (uint32_t i = 0; i < m_routing->GetNRoutes(); i++)
+    {
+        if (m_routing->GetRoute(i).GetGateway() == Ipv6Address("fe80::4"))
+        {
+            m_routing->RemoveRoute(i);
+            break;
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ(GetGateway("2001:db8:1::5"),
+                          Ipv6Address("fe80::6"),
+                          "On a metric tie, the last added route must be selected");
+    m_routing->SetDefaultRoute(Ipv6Address("fe80::8"), 2);
+    NS_TEST_EXPECT_MSG_EQ(GetGateway("3001::1"),
+                          Ipv6Address("fe80::8"),
+                          "The added default route must be selected");
+    ipv6->SetDown(2);
+    NS_TEST_EXPECT_MSG_EQ(GetGateway("2001:db8:1:8001::1"),
+                          Ipv6Address("fe80::6"),
+                          "The routes through a down interface must be removed");
+    NS_TEST_EXPECT_MSG_EQ(GetGateway("3001::1"),
+                          Ipv6Address::GetAllNodesMulticast(),
+                          "The default route through a down interface must be removed");
+
+    m_routing = nullptr;
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup internet-test
+ *
+ * @brief IPv6 StaticRouting TestSuite
+ */
+class Ipv6StaticRoutingTestSuite : public TestSuite
+{
+  public:
+    Ipv6StaticRoutingTestSuite()
+        : TestSuite("ipv6-static-routing", Type::UNIT)
+    {
+        AddTestCase(new Ipv6StaticRoutingLookupTestCase, TestCase::Duration::QUICK);
+    }
+};
+
+static Ipv6StaticRoutingTestSuite
+    g_ipv6StaticRoutingTestSuite; //!< Static variable for test initialization
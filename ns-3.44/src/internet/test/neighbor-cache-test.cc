@@ -6,6 +6,7 @@
  * Author: Zhiheng Dong <dzh2077@gmail.com>
  */
 
+#include "ns3/arp-cache.h"
 #include "ns3/icmpv4-l4-protocol.h"
 #include "ns3/icmpv6-l4-protocol.h"
 #include "ns3/internet-stack-helper.h"
@@ -15,6 +16,7 @@
 #include "ns3/ipv6-address-helper.h"
 #include "ns3/ipv6-l3-protocol.h"
 #include "ns3/ipv6-routing-helper.h"
+#include "ns3/ndisc-cache.h"
 #include "ns3/neighbor-cache-helper.h"
 #include "ns3/simple-channel.h"
 #include "ns3/simple-net-device-helper.h"
@@ -25,6 +27,7 @@
 #include "ns3/test.h"
 #include "ns3/udp-l4-protocol.h"
 #include "ns3/udp-socket-factory.h"
+#include "ns3/uinteger.h"
 
 using namespace ns3;
 
@@ -1210,6 +1213,254 @@ DynamicPartialTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup internet-test
+ *
+ * @brief ARP Cache Entries Test
+ */
+class ArpCacheEntryTest : public TestCase
+{
+  public:
+    void DoRun() override;
+    ArpCacheEntryTest();
+
+  private:
+    /**
+     * @brief Record an ARP request sent by the cache.
+     * @param cache The ARP cache.
+     * @param address The address to resolve.
+     */
+    void ArpRequest(Ptr<const ArpCache> cache, Ipv4Address address);
+
+    /**
+     * @brief Record a packet dropped by the cache.
+     * @param packet The dropped packet.
+     */
+    void Drop(Ptr<const Packet> packet);
+
+    NodeContainer m_nodes;                  //!< Nodes used in the test.
+    std::vector<Ipv4Address> m_arpRequests; //!< Addresses of the ARP requests sent.
+    uint32_t m_drops{0};                    //!< Number of packets dropped.
+};
+
+ArpCacheEntryTest::ArpCacheEntryTest()
+    : TestCase("The ArpCacheEntryTest checks the lookup of the ARP cache entries by MAC address, "
+               "and the retries and expiry of the entries waiting for a reply, also when an "
+               "entry is removed and added again.")
+{
+}
+
+void
+ArpCacheEntryTest::ArpRequest(Ptr<const ArpCache> cache, Ipv4Address address)
+{
+    m_arpRequests.push_back(address);
+}
+
+void
+ArpCacheEntryTest::Drop(Ptr<const Packet> packet)
+{
+    m_drops++;
+}
+
+void
+ArpCacheEntryTest::DoRun()
+{
+    m_nodes.Create(2);
+
+    Ptr<SimpleChannel> channel = CreateObject<SimpleChannel>();
+    SimpleNetDeviceHelper simpleHelper;
+    NetDeviceContainer net = simpleHelper.Install(m_nodes, channel);
+
+    InternetStackHelper internet;
+    internet.SetIpv6StackInstall(false);
+    internet.Install(m_nodes);
+
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer i = ipv4.Assign(net);
+
+    Ptr<ArpCache> arpCache =
+        DynamicCast<Ipv4L3Protocol>(i.Get(0).first)->GetInterface(i.Get(0).second)->GetArpCache();
+    arpCache->SetWaitReplyTimeout(Seconds(1));
+    arpCache->SetAttribute("MaxRetries", UintegerValue(3));
+    arpCache->SetArpRequestCallback(MakeCallback(&ArpCacheEntryTest::ArpRequest, this));
+    arpCache->TraceConnectWithoutContext("Drop", MakeCallback(&ArpCacheEntryTest::Drop, this));
+
+    Mac48Address mac1("00:00:00:00:00:a1");
+    Mac48Address mac2("00:00:00:00:00:a2");
+    Mac48Address mac3("00:00:00:00:00:a3");
+
+    // Lookup by MAC address after an entry is updated or removed
+    ArpCache::Entry* entry1 = arpCache->Add(Ipv4Address("10.1.1.21"));
+    entry1->SetMacAddress(mac1);
+    entry1->MarkPermanent();
+    NS_TEST_EXPECT_MSG_EQ(arpCache->LookupInverse(mac1).size(), 1, "Entry not found by MAC");
+    entry1->SetMacAddress(mac2);
+    NS_TEST_EXPECT_MSG_EQ(arpCache->LookupInverse(mac1).empty(), true, "Stale MAC address");
+    NS_TEST_EXPECT_MSG_EQ(arpCache->LookupInverse(mac2).size(), 1, "Entry not found by new MAC");
+    ArpCache::Entry* entry2 = arpCache->Add(Ipv4Address("10.1.1.22"));
+    entry2->SetMacAddress(mac2);
+    entry2->MarkPermanent();
+    NS_TEST_EXPECT_MSG_EQ(arpCache->LookupInverse(mac2).size(), 2, "Entries not found by MAC");
+    arpCache->Remove(entry1);
+    NS_TEST_EXPECT_MSG_EQ(arpCache->LookupInverse(mac2).size(), 1, "Removed entry found by MAC");
+    NS_TEST_EXPECT_MSG_EQ(arpCache->LookupInverse(mac2).front(), entry2, "Wrong entry");
+
+    // Two entries wait for a reply, the second one is removed and added again
+    // before the first retry, and resolved after it
+    Ipv4Address waitAddress("10.1.1.10");
+    Ipv4Address readdAddress("10.1.1.11");
+    ArpCache::Entry* waitEntry = arpCache->Add(waitAddress);
+    waitEntry->MarkWaitReply(ArpCache::Ipv4PayloadHeaderPair(Create<Packet>(100), Ipv4Header()));
+    arpCache->Add(readdAddress)
+        ->MarkWaitReply(ArpCache::Ipv4PayloadHeaderPair(Create<Packet>(100), Ipv4Header()));
+
+    ArpCache::Entry* readdEntry = nullptr;
+    Simulator::Schedule(Seconds(0.5), [&]() {
+        arpCache->Remove(arpCache->Lookup(readdAddress));
+        readdEntry = arpCache->Add(readdAddress);
+        readdEntry->MarkWaitReply(
+            ArpCache::Ipv4PayloadHeaderPair(Create<Packet>(100), Ipv4Header()));
+    });
+    Simulator::Schedule(Seconds(1.5), [&]() {
+        NS_TEST_EXPECT_MSG_EQ(m_arpRequests.size(), 2, "Wrong number of ARP requests");
+        NS_TEST_EXPECT_MSG_EQ(readdEntry->GetRetries(), 1, "The added entry was not retried");
+        readdEntry->MarkAlive(mac3);
+        NS_TEST_EXPECT_MSG_EQ(arpCache->LookupInverse(mac3).size(), 1, "Entry not found by MAC");
+    });
+    Simulator::Schedule(Seconds(3.5), [&]() {
+        NS_TEST_EXPECT_MSG_EQ(waitEntry->IsWaitReply(), true, "The entry expired too early");
+        NS_TEST_EXPECT_MSG_EQ(waitEntry->GetRetries(), 3, "Wrong number of retries");
+        NS_TEST_EXPECT_MSG_EQ(m_drops, 0, "Packets dropped too early");
+    });
+
+    Simulator::Stop(Seconds(10));
+    Simulator::Run();
+
+    // the request of the resolved entry is not retried, the other one is
+    // retried up to MaxRetries times, then its pending packet is dropped
+    std::vector<Ipv4Address> arpRequests{waitAddress,
+                                         readdAddress,
+                                         waitAddress,
+                                         waitAddress};
+    NS_TEST_EXPECT_MSG_EQ((m_arpRequests == arpRequests), true, "Wrong ARP requests");
+    NS_TEST_EXPECT_MSG_EQ(waitEntry->IsDead(), true, "The entry did not expire");
+    NS_TEST_EXPECT_MSG_EQ(m_drops, 1, "Wrong number of dropped packets");
+    NS_TEST_EXPECT_MSG_EQ(arpCache->Lookup(readdAddress), readdEntry, "Wrong entry");
+    NS_TEST_EXPECT_MSG_EQ(readdEntry->IsAlive(), true, "The added entry is not alive");
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup internet-test
+ *
+ * @brief NDISC Cache Entries Test
+ */
+class NdiscCacheEntryTest : public TestCase
+{
+  public:
+    void DoRun() override;
+    NdiscCacheEntryTest();
+
+  private:
+    NodeContainer m_nodes; //!< Nodes used in the test.
+};
+
+NdiscCacheEntryTest::NdiscCacheEntryTest()
+    : TestCase("The NdiscCacheEntryTest checks the lookup of the NDISC cache entries by MAC "
+               "address, and the transitions of their NUD state on the timers, also when an "
+               "entry is removed and added again.")
+{
+}
+
+void
+NdiscCacheEntryTest::DoRun()
+{
+    m_nodes.Create(2);
+
+    Ptr<SimpleChannel> channel = CreateObject<SimpleChannel>();
+    SimpleNetDeviceHelper simpleHelper;
+    NetDeviceContainer net = simpleHelper.Install(m_nodes, channel);
+
+    InternetStackHelper internet;
+    internet.SetIpv4StackInstall(false);
+    internet.Install(m_nodes);
+
+    Ipv6AddressHelper ipv6;
+    ipv6.SetBase(Ipv6Address("2001:0::"), Ipv6Prefix(64));
+    Ipv6InterfaceContainer i = ipv6.Assign(net);
+
+    // ReachableTime 30 s, DelayFirstProbe 5 s, RetransmissionTime 1 s, MaxUnicastSolicit 3
+    Ptr<Ipv6L3Protocol> ipv6L3 = DynamicCast<Ipv6L3Protocol>(i.Get(0).first);
+    Ptr<NdiscCache> ndiscCache = ipv6L3->GetInterface(i.Get(0).second)->GetNdiscCache();
+
+    Mac48Address mac1("00:00:00:00:00:a1");
+    Mac48Address mac2("00:00:00:00:00:a2");
+    Ipv6Address probedAddress("2001::a1");
+    Ipv6Address extendedAddress("2001::a2");
+    Ipv6Address readdAddress("2001::a3");
+
+    // Lookup by MAC address after an entry is updated
+    NdiscCache::Entry* probedEntry = ndiscCache->Add(probedAddress);
+    probedEntry->MarkReachable(mac1);
+    probedEntry->StartReachableTimer();
+    NdiscCache::Entry* extendedEntry = ndiscCache->Add(extendedAddress);
+    extendedEntry->MarkReachable(mac1);
+    extendedEntry->StartReachableTimer();
+    NS_TEST_EXPECT_MSG_EQ(ndiscCache->LookupInverse(mac1).size(), 2, "Entries not found by MAC");
+    extendedEntry->MarkStale(mac2);
+    extendedEntry->MarkReachable();
+    NS_TEST_EXPECT_MSG_EQ(ndiscCache->LookupInverse(mac1).size(), 1, "Stale MAC address");
+    NS_TEST_EXPECT_MSG_EQ(ndiscCache->LookupInverse(mac2).front(),
+                          extendedEntry,
+                          "Entry not found by new MAC");
+
+    // An entry is removed and added again with a later reachable timer: the
+    // timer of the removed entry must not make the new one stale
+    NdiscCache::Entry* readdEntry = ndiscCache->Add(readdAddress);
+    readdEntry->MarkReachable(mac2);
+    readdEntry->StartReachableTimer();
+    Simulator::Schedule(Seconds(5), [&]() {
+        ndiscCache->Remove(ndiscCache->Lookup(readdAddress));
+        NS_TEST_EXPECT_MSG_EQ(ndiscCache->LookupInverse(mac2).size(),
+                              1,
+                              "Removed entry found by MAC");
+        readdEntry = ndiscCache->Add(readdAddress);
+        readdEntry->MarkReachable(mac2);
+        readdEntry->StartReachableTimer();
+    });
+
+    // The reachable timer of an entry is extended, and expires at the same
+    // time as the one of the re-added entry
+    Simulator::Schedule(Seconds(5), [&]() { extendedEntry->UpdateReachableTimer(); });
+
+    Simulator::Schedule(Seconds(32), [&]() {
+        NS_TEST_EXPECT_MSG_EQ(probedEntry->IsStale(), true, "REACHABLE -> STALE failed");
+        NS_TEST_EXPECT_MSG_EQ(extendedEntry->IsReachable(), true, "Timer not extended");
+        NS_TEST_EXPECT_MSG_EQ(readdEntry->IsReachable(), true, "Removed entry timer fired");
+        // a packet sent to a stale entry moves it to the DELAY state
+        probedEntry->MarkDelay();
+        probedEntry->StartDelayTimer();
+    });
+    Simulator::Schedule(Seconds(36), [&]() {
+        NS_TEST_EXPECT_MSG_EQ(extendedEntry->IsStale(), true, "Extended timer did not expire");
+        NS_TEST_EXPECT_MSG_EQ(readdEntry->IsStale(), true, "Re-added entry timer did not expire");
+        NS_TEST_EXPECT_MSG_EQ(probedEntry->IsDelay(), true, "STALE -> DELAY failed");
+    });
+    Simulator::Schedule(Seconds(37.5), [&]() {
+        NS_TEST_EXPECT_MSG_EQ(probedEntry->IsProbe(), true, "DELAY -> PROBE failed");
+    });
+
+    Simulator::Stop(Seconds(50));
+    Simulator::Run();
+
+    // the unanswered probes removed the entry
+    NS_TEST_EXPECT_MSG_EQ(ndiscCache->Lookup(probedAddress), nullptr, "Probed entry not removed");
+    NS_TEST_EXPECT_MSG_EQ(ndiscCache->LookupInverse(mac1).empty(), true, "Removed entry found");
+    NS_TEST_EXPECT_MSG_EQ(ndiscCache->Lookup(readdAddress), readdEntry, "Wrong entry");
+    Simulator::Destroy();
+}
+
 /**
  * @ingroup internet-test
  *
@@ -1228,6 +1479,8 @@ class NeighborCacheTestSuite : public TestSuite
         AddTestCase(new FlushTest, TestCase::Duration::QUICK);
         AddTestCase(new DuplicateTest, TestCase::Duration::QUICK);
         AddTestCase(new DynamicPartialTest, TestCase::Duration::QUICK);
+        AddTestCase(new ArpCacheEntryTest, TestCase::Duration::QUICK);
+        AddTestCase(new NdiscCacheEntryTest, TestCase::Duration::QUICK);
     }
 };
 
@@ -31,6 +31,11 @@ class TcpRxBufferTestCase : public TestCase
      * @brief Test the SACK list update.
      */
     void TestUpdateSACKList();
+
+    /**
+     * @brief Test the reassembly of overlapping segments.
+     */
+    void TestReassembly();
 };
 
 TcpRxBufferTestCase::TcpRxBufferTestCase()
@@ -42,6 +47,7 @@ void
 TcpRxBufferTestCase::DoRun()
 {
     TestUpdateSACKList();
+    TestReassembly();
 }
 
 void
@@ -277,6 +283,74 @@ TcpRxBufferTestCase::TestUpdateSACKList()
     NS_TEST_ASSERT_MSG_EQ(sackList.size(), 0, "SACK list should contain no element");
 }
 
+void
+TcpRxBufferTestCase::TestReassembly()
+{
+    TcpRxBuffer rxBuf;
+    TcpHeader h;
+    uint8_t data[500];
+    for (uint32_t i = 0; i < sizeof(data); i++)
+    {
+        data[i] = i % 251;
+    }
+    rxBuf.SetNextRxSequence(SequenceNumber32(1));
+
+    // out of order segment
+    h.SetSequenceNumber(SequenceNumber32(301));
+    rxBuf.Add(Create<Packet>(data + 300, 100), h);
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Size(), 100, "Buffer size differs from expected");
+
+    // out of order segment, in which the previous one is embedded
+    h.SetSequenceNumber(SequenceNumber32(151));
+    rxBuf.Add(Create<Packet>(data + 150, 300), h);
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Size(), 300, "Buffer size differs from expected");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Available(), 0, "No data should be available");
+    TcpOptionSack::SackList sackList = rxBuf.GetSackList();
+    NS_TEST_ASSERT_MSG_EQ(sackList.size(), 1, "SACK list should contain one element");
+    NS_TEST_ASSERT_MSG_EQ(sackList.front().first,
+                          SequenceNumber32(151),
+                          "SACK block different than expected");
+    NS_TEST_ASSERT_MSG_EQ(sackList.front().second,
+                          SequenceNumber32(451),
+                          "SACK block different than expected");
+
+    // in order segment, whose tail overlaps the buffered data
+    h.SetSequenceNumber(SequenceNumber32(1));
+    rxBuf.Add(Create<Packet>(data, 200), h);
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.NextRxSequence(),
+                          SequenceNumber32(451),
+                          "Sequence number differs from expected");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Size(), 450, "Buffer size differs from expected");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Available(), 450, "Available data differs from expected");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.GetSackListSize(), 0, "SACK list should contain no element");
+
+    // duplicate segment
+    h.SetSequenceNumber(SequenceNumber32(101));
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Add(Create<Packet>(data + 100, 100), h),
+                          false,
+                          "Duplicate data should not be buffered");
+
+    // extract the data in pieces which do not match the segments
+    uint8_t out[500];
+    uint32_t extracted = 0;
+    for (uint32_t maxSize : {100, 100, 1000})
+    {
+        Ptr<Packet> p = rxBuf.Extract(maxSize);
+        NS_TEST_ASSERT_MSG_NE(p, nullptr, "Data should have been extracted");
+        NS_TEST_ASSERT_MSG_EQ(p->GetSize(),
+                              std::min(maxSize, 450 - extracted),
+                              "Extracted size differs from expected");
+        p->CopyData(out + extracted, p->GetSize());
+        extracted += p->GetSize();
+    }
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Size(), 0, "Buffer should be empty");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Extract(100), nullptr, "No data should be extracted");
+    for (uint32_t i = 0; i < extracted; i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(uint32_t(out[i]), uint32_t(data[i]), "Wrong byte at " << i);
+    }
+}
+
 void
 TcpRxBufferTestCase::DoTeardown()
 {
@@ -42,6 +42,8 @@ class TcpTxBufferTestCase : public TestCase
     /** @brief Test the logic of merging items in GetTransmittedSegment()
      * which is triggered by CopyFromSequence()*/
     void TestMergeItemsWhenGetTransmittedSegment();
+    /** @brief Test the scoreboard with a large window and many holes */
+    void TestScoreboard();
     /**
      * @brief Callback to provide a value of receiver window
      * @returns the receiver window size
@@ -89,6 +91,13 @@ TcpTxBufferTestCase::DoRun()
                         &TcpTxBufferTestCase::TestMergeItemsWhenGetTransmittedSegment,
                         this);
 
+    /*
+     * Case for a large window:
+     *  -> one segment out of ten is lost, and the others are sacked
+     *  -> the lost segments are retransmitted in order
+     */
+    Simulator::Schedule(Seconds(0), &TcpTxBufferTestCase::TestScoreboard, this);
+
     Simulator::Run();
     Simulator::Destroy();
 }
@@ -409,6 +418,74 @@ TcpTxBufferTestCase::TestMergeItemsWhenGetTransmittedSegment()
     txBuf.CopyFromSequence(2000, SequenceNumber32(1));
 }
 
+void
+TcpTxBufferTestCase::TestScoreboard()
+{
+    Ptr<TcpTxBuffer> txBuf = CreateObject<TcpTxBuffer>();
+    txBuf->SetRWndCallback(MakeCallback(&TcpTxBufferTestCase::GetRWnd, this));
+    SequenceNumber32 head(1);
+    SequenceNumber32 ret;
+    SequenceNumber32 retHigh;
+    uint32_t segmentSize = 100;
+    uint32_t segments = 1000;
+    txBuf->SetHeadSequence(head);
+    txBuf->SetSegmentSize(segmentSize);
+    txBuf->SetDupAckThresh(3);
+    txBuf->SetMaxBufferSize(segmentSize * segments);
+    txBuf->Add(Create<Packet>(segmentSize * segments));
+
+    for (uint32_t i = 0; i < segments; ++i)
+    {
+        txBuf->NextSeg(&ret, &retHigh, false);
+        txBuf->CopyFromSequence(segmentSize, ret);
+    }
+
+    // the receiver gets all the segments but one out of ten
+    for (uint32_t i = 0; i < segments; i += 10)
+    {
+        TcpOptionSack::SackList list;
+        list.emplace_back(head + segmentSize * (i + 1), head + segmentSize * (i + 10));
+        txBuf->Update(list);
+    }
+    uint32_t holes = segments / 10;
+    NS_TEST_ASSERT_MSG_EQ(txBuf->GetSacked(),
+                          segmentSize * (segments - holes),
+                          "Wrong number of sacked bytes");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->GetLost(), segmentSize * holes, "Wrong number of lost bytes");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->IsLost(head + segmentSize * 500), true, "The hole is lost");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->IsLost(head + segmentSize * 501 + 10),
+                          false,
+                          "The sacked segment is not lost");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->BytesInFlight(), 0, "No bytes should be in flight");
+
+    // the holes are retransmitted in order
+    for (uint32_t i = 0; i < segments; i += 10)
+    {
+        NS_TEST_ASSERT_MSG_EQ(txBuf->NextSeg(&ret, &retHigh, true),
+                              true,
+                              "A lost segment must be retransmitted");
+        NS_TEST_ASSERT_MSG_EQ(ret, head + segmentSize * i, "Wrong segment retransmitted");
+        txBuf->CopyFromSequence(segmentSize, ret);
+    }
+    NS_TEST_ASSERT_MSG_EQ(txBuf->NextSeg(&ret, &retHigh, true),
+                          false,
+                          "Nothing left to retransmit");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->BytesInFlight(),
+                          segmentSize * holes,
+                          "The retransmitted segments are in flight");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->IsRetransmittedDataAcked(head + segmentSize),
+                          true,
+                          "The first hole was retransmitted");
+
+    txBuf->DiscardUpTo(head + segmentSize * 10);
+    NS_TEST_ASSERT_MSG_EQ(txBuf->GetSacked(),
+                          segmentSize * (segments - holes - 9),
+                          "Wrong number of sacked bytes after the cumulative ACK");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->GetLost(),
+                          segmentSize * (holes - 1),
+                          "Wrong number of lost bytes after the cumulative ACK");
+}
+
 void
 TcpTxBufferTestCase::TestTransmittedBlock()
 {
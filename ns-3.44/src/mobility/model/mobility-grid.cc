@@ -0,0 +1,230 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "mobility-grid.h"
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("MobilityGrid");
+
+MobilityGrid::MobilityGrid()
+    : m_cellSize(100),
+      m_maxSpeed(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+MobilityGrid::~MobilityGrid()
+{
+    NS_LOG_FUNCTION(this);
+    Clear();
+}
+
+void
+MobilityGrid::SetCellSize(double cellSize)
+{
+    NS_LOG_FUNCTION(this << cellSize);
+    NS_ASSERT_MSG(m_items.empty(), "Cannot change the size of the cells of a non-empty grid");
+    NS_ASSERT_MSG(cellSize > 0, "The size of the cells must be positive");
+    m_cellSize = cellSize;
+}
+
+double
+MobilityGrid::GetCellSize() const
+{
+    return m_cellSize;
+}
+
+void
+MobilityGrid::Add(uint64_t key, Ptr<MobilityModel> mobility)
+{
+    NS_LOG_FUNCTION(this << key << mobility);
+    NS_ASSERT(mobility);
+    const auto position = mobility->GetPosition();
+    const auto cell = GetCellKey(GetCellIndex(position.x), GetCellIndex(position.y));
+    auto [it, inserted] = m_items.emplace(key, Item{mobility, cell, false});
+    NS_ASSERT_MSG(inserted, "Key " << key << " already in the grid");
+    m_cells[cell].push_back(key);
+    Update(key, it->second);
+
+    auto& keys = m_keys[mobility];
+    if (keys.empty())
+    {
+        mobility->TraceConnectWithoutContext("CourseChange",
+                                             MakeCallback(&MobilityGrid::NotifyCourseChange, this));
+    }
+    keys.push_back(key);
+}
+
+void
+MobilityGrid::Remove(uint64_t key)
+{
+    NS_LOG_FUNCTION(this << key);
+    auto it = m_items.find(key);
+    NS_ASSERT_MSG(it != m_items.end(), "Key " << key << " not in the grid");
+    const auto& item = it->second;
+
+    auto& cellKeys = m_cells[item.cell];
+    cellKeys.erase(std::find(cellKeys.begin(), cellKeys.end(), key));
+    if (cellKeys.empty())
+    {
+        m_cells.erase(item.cell);
+    }
+    if (item.moving)
+    {
+        m_moving.erase(std::find(m_moving.begin(), m_moving.end(), key));
+    }
+    auto& keys = m_keys[item.mobility];
+    keys.erase(std::find(keys.begin(), keys.end(), key));
+    if (keys.empty())
+    {
+        item.mobility->TraceDisconnectWithoutContext(
+            "CourseChange",
+            MakeCallback(&MobilityGrid::NotifyCourseChange, this));
+        m_keys.erase(item.mobility);
+    }
+    m_items.erase(it);
+}
+
+void
+MobilityGrid::Clear()
+{
+    NS_LOG_FUNCTION(this);
+    for (const auto& [mobility, keys] : m_keys)
+    {
+        mobility->TraceDisconnectWithoutContext(
+            "CourseChange",
+            MakeCallback(&MobilityGrid::NotifyCourseChange, this));
+    }
+    m_keys.clear();
+    m_items.clear();
+    m_cells.clear();
+    m_moving.clear();
+    m_maxSpeed = 0;
+}
+
+std::size_t
+MobilityGrid::GetSize() const
+{
+    return m_items.size();
+}
+
+bool
+MobilityGrid::Find(const Vector& position, double distance, std::vector<uint64_t>& keys)
+{
+    NS_LOG_FUNCTION(this << position << distance);
+
+    if (m_maxSpeed * (Simulator::Now() - m_updateTime).GetSeconds() > m_cellSize / 2)
+    {
+        NS_LOG_LOGIC("Move " << m_moving.size() << " moving models to their cells");
+        std::vector<uint64_t> moving;
+        moving.swap(m_moving);
+        m_maxSpeed = 0;
+        m_updateTime = Simulator::Now();
+        for (auto key : moving)
+        {
+            auto& item = m_items.at(key);
+            item.moving = false;
+            Update(key, item);
+        }
+    }
+
+    // the moving models may have left their cells by this distance
+    const auto drift = m_maxSpeed * (Simulator::Now() - m_updateTime).GetSeconds();
+    const auto reach = std::ceil((distance + drift) / m_cellSize);
+    if ((2 * reach + 1) * (2 * reach + 1) > m_items.size())
+    {
+        NS_LOG_LOGIC("Distance " << distance << "m covers more cells than models");
+        return false;
+    }
+
+    const auto n = static_cast<int64_t>(reach);
+    const auto x0 = GetCellIndex(position.x);
+    const auto y0 = GetCellIndex(position.y);
+    const auto first = keys.size();
+    for (auto x = x0 - n; x <= x0 + n; x++)
+    {
+        for (auto y = y0 - n; y <= y0 + n; y++)
+        {
+            auto it = m_cells.find(GetCellKey(x, y));
+            if (it == m_cells.end())
+            {
+                continue;
+            }
+            for (auto key : it->second)
+            {
+                const auto& mobility = m_items.at(key).mobility;
+                if (CalculateDistance(position, mobility->GetPosition()) <= distance)
+                {
+                    keys.push_back(key);
+                }
+            }
+        }
+    }
+    std::sort(keys.begin() + first, keys.end());
+    NS_LOG_DEBUG(keys.size() - first << " models within " << distance << "m");
+    return true;
+}
+
+uint64_t
+MobilityGrid::GetCellKey(int64_t x, int64_t y)
+{
+    return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+}
+
+int64_t
+MobilityGrid::GetCellIndex(double coordinate) const
+{
+    return static_cast<int64_t>(std::floor(coordinate / m_cellSize));
+}
+
+void
+MobilityGrid::Update(uint64_t key, Item& item)
+{
+    const auto position = item.mobility->GetPosition();
+    const auto cell = GetCellKey(GetCellIndex(position.x), GetCellIndex(position.y));
+    if (cell != item.cell)
+    {
+        auto& cellKeys = m_cells[item.cell];
+        cellKeys.erase(std::find(cellKeys.begin(), cellKeys.end(), key));
+        if (cellKeys.empty())
+        {
+            m_cells.erase(item.cell);
+        }
+        m_cells[cell].push_back(key);
+        item.cell = cell;
+    }
+
+    const auto speed = item.mobility->GetVelocity().GetLength();
+    if (speed > 0)
+    {
+        m_maxSpeed = std::max(m_maxSpeed, speed);
+        if (!item.moving)
+        {
+            item.moving = true;
+            m_moving.push_back(key);
+        }
+    }
+}
+
+void
+MobilityGrid::NotifyCourseChange(Ptr<const MobilityModel> mobility)
+{
+    NS_LOG_FUNCTION(this << mobility);
+    auto it = m_keys.find(ConstCast<MobilityModel>(mobility));
+    NS_ASSERT(it != m_keys.end());
+    for (auto key : it->second)
+    {
+        Update(key, m_items.at(key));
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,147 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef MOBILITY_GRID_H
+#define MOBILITY_GRID_H
+
+#include "mobility-model.h"
+
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/vector.h"
+
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup mobility
+ *
+ * @brief Uniform grid of the positions of mobility models, to find the
+ * models close to a position without visiting all of them.
+ *
+ * The models are identified by keys chosen by the user (e.g., the index of
+ * the PHY using the model in the list of a channel), and stored in the
+ * square cell, in the x-y plane, containing their position. The models are
+ * moved to the cell of their new position when they notify a course change.
+ * As the moving models also move between their course changes, Find()
+ * extends the searched area by the distance they may have moved since they
+ * were stored in their cells, and moves them to their cells again once this
+ * distance exceeds half a cell.
+ */
+class MobilityGrid
+{
+  public:
+    MobilityGrid();
+    ~MobilityGrid();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    MobilityGrid(const MobilityGrid&) = delete;
+    MobilityGrid& operator=(const MobilityGrid&) = delete;
+
+    /**
+     * Set the size of the cells, which can only be changed while the grid is
+     * empty. The searches are most efficient when the cells are about as
+     * large as the searched distances.
+     *
+     * @param cellSize the size of the cells (m)
+     */
+    void SetCellSize(double cellSize);
+
+    /**
+     * @return the size of the cells (m)
+     */
+    double GetCellSize() const;
+
+    /**
+     * Add a mobility model to the grid.
+     *
+     * @param key the key identifying the model, which must not be in the grid
+     * @param mobility the mobility model, which may be added with several keys
+     */
+    void Add(uint64_t key, Ptr<MobilityModel> mobility);
+
+    /**
+     * Remove a mobility model from the grid.
+     *
+     * @param key the key identifying the model
+     */
+    void Remove(uint64_t key);
+
+    /**
+     * Remove all the mobility models from the grid.
+     */
+    void Clear();
+
+    /**
+     * @return the number of keys in the grid
+     */
+    std::size_t GetSize() const;
+
+    /**
+     * Find the mobility models within a distance of a position.
+     *
+     * @param position the position
+     * @param distance the distance (m)
+     * @param keys the vector to which the keys of the models within the
+     *        distance are appended, in increasing order
+     * @return false, without appending any key, if the search would visit
+     *         more cells than there are keys, in which case visiting all the
+     *         models is cheaper
+     */
+    bool Find(const Vector& position, double distance, std::vector<uint64_t>& keys);
+
+  private:
+    /// A mobility model in the grid
+    struct Item
+    {
+        Ptr<MobilityModel> mobility; //!< the mobility model
+        uint64_t cell;               //!< the cell containing the model
+        bool moving;                 //!< whether the model is in m_moving
+    };
+
+    /**
+     * @param x the column of a cell
+     * @param y the row of the cell
+     * @return the key of the cell
+     */
+    static uint64_t GetCellKey(int64_t x, int64_t y);
+
+    /**
+     * @param coordinate a coordinate of a position
+     * @return the column or row of the cells containing the coordinate
+     */
+    int64_t GetCellIndex(double coordinate) const;
+
+    /**
+     * Move a model to the cell of its current position, and record whether it moves.
+     *
+     * @param key the key identifying the model
+     * @param item the model
+     */
+    void Update(uint64_t key, Item& item);
+
+    /**
+     * Callback invoked when a mobility model notifies a course change.
+     *
+     * @param mobility the mobility model
+     */
+    void NotifyCourseChange(Ptr<const MobilityModel> mobility);
+
+    double m_cellSize; //!< the size of the cells (m)
+    double m_maxSpeed; //!< the maximum speed of the moving models (m/s)
+    Time m_updateTime; //!< the time the moving models were last moved to their cells
+
+    std::vector<uint64_t> m_moving;                              //!< the keys of the moving models
+    std::unordered_map<uint64_t, Item> m_items;                  //!< the models, by key
+    std::unordered_map<uint64_t, std::vector<uint64_t>> m_cells; //!< the keys, by cell
+    std::map<Ptr<MobilityModel>, std::vector<uint64_t>> m_keys;  //!< the keys, by model
+};
+
+} // namespace ns3
+
+#endif /* MOBILITY_GRID_H */
@@ -0,0 +1,147 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/constant-velocity-mobility-model.h"
+#include "ns3/mobility-grid.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * @ingroup mobility-test
+ *
+ * @brief Check that MobilityGrid finds the same models as a search of all the models.
+ *
+ * One hundred models are placed on a 10x10 lattice with a spacing of 30 m,
+ * and a model moves across the lattice without notifying course changes.
+ * The models found by the grid must be those within the searched distance.
+ */
+class MobilityGridTestCase : public TestCase
+{
+  public:
+    MobilityGridTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Check the models found within a distance of a position.
+     * @param position the position
+     * @param distance the distance (m)
+     */
+    void CheckFind(Vector position, double distance);
+
+    MobilityGrid m_grid;                      //!< the grid
+    std::vector<Ptr<MobilityModel>> m_models; //!< the models, by key
+    std::vector<bool> m_added;                //!< whether each model is in the grid
+};
+
+MobilityGridTestCase::MobilityGridTestCase()
+    : TestCase("Check the models found by MobilityGrid")
+{
+}
+
+void
+MobilityGridTestCase::CheckFind(Vector position, double distance)
+{
+    std::vector<uint64_t> expected;
+    for (std::size_t key = 0; key < m_models.size(); key++)
+    {
+        if (m_added[key] && CalculateDistance(position, m_models[key]->GetPosition()) <= distance)
+        {
+            expected.push_back(key);
+        }
+    }
+    std::vector<uint64_t> keys;
+    NS_TEST_ASSERT_MSG_EQ(m_grid.Find(position, distance, keys),
+                          true,
+                          "The grid should be searched at " << position);
+    NS_TEST_EXPECT_MSG_EQ((keys == expected),
+                          true,
+                          "Wrong models within " << distance << "m of " << position << " at "
+                                                 << Simulator::Now().As(Time::S));
+}
+
+void
+MobilityGridTestCase::DoRun()
+{
+    m_grid.SetCellSize(50);
+    for (uint32_t i = 0; i < 100; i++)
+    {
+        Ptr<MobilityModel> mobility = CreateObject<ConstantPositionMobilityModel>();
+        mobility->SetPosition(Vector(30.0 * (i % 10), 30.0 * (i / 10), 0));
+        m_models.push_back(mobility);
+    }
+    Ptr<ConstantVelocityMobilityModel> moving = CreateObject<ConstantVelocityMobilityModel>();
+    moving->SetPosition(Vector(-100, 100, 0));
+    moving->SetVelocity(Vector(20, 0, 0));
+    m_models.push_back(moving);
+    for (std::size_t key = 0; key < m_models.size(); key++)
+    {
+        m_grid.Add(key, m_models[key]);
+    }
+    m_added.assign(m_models.size(), true);
+    NS_TEST_EXPECT_MSG_EQ(m_grid.GetSize(), 101, "Wrong number of models");
+
+    CheckFind(Vector(0, 0, 0), 40);
+    CheckFind(Vector(135, 135, 0), 60);
+    CheckFind(Vector(-20, 100, 0), 85);
+
+    // the moving model crosses the lattice, one search every 5 seconds
+    for (uint32_t i = 1; i <= 8; i++)
+    {
+        Simulator::Schedule(Seconds(5 * i),
+                            &MobilityGridTestCase::CheckFind,
+                            this,
+                            Vector(moving->GetPosition().x + 100 * i, 100, 0),
+                            45);
+    }
+    // a model is moved, which notifies a course change
+    Simulator::Schedule(Seconds(12), [this]() {
+        m_models[55]->SetPosition(Vector(400, 400, 0));
+        CheckFind(Vector(400, 400, 0), 10);
+        CheckFind(Vector(150, 150, 0), 30);
+    });
+    // the removed models are not found
+    Simulator::Schedule(Seconds(13), [this]() {
+        m_grid.Remove(44);
+        m_grid.Remove(100);
+        m_added[44] = false;
+        m_added[100] = false;
+        CheckFind(Vector(120, 120, 0), 50);
+    });
+    Simulator::Run();
+
+    std::vector<uint64_t> keys;
+    NS_TEST_EXPECT_MSG_EQ(m_grid.Find(Vector(0, 0, 0), 1000, keys),
+                          false,
+                          "The grid should not be searched when all the cells are covered");
+    NS_TEST_EXPECT_MSG_EQ(keys.empty(), true, "No model should be found");
+
+    m_grid.Clear();
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup mobility-test
+ *
+ * @brief MobilityGrid TestSuite
+ */
+class MobilityGridTestSuite : public TestSuite
+{
+  public:
+    MobilityGridTestSuite();
+};
+
+MobilityGridTestSuite::MobilityGridTestSuite()
+    : TestSuite("mobility-grid", Type::UNIT)
+{
+    AddTestCase(new MobilityGridTestCase, TestCase::Duration::QUICK);
+}
+
+static MobilityGridTestSuite g_mobilityGridTestSuite; //!< Static variable for test initialization
@@ -44,6 +44,26 @@ PcapHelper::CreateFile(std::string filename,
     NS_LOG_FUNCTION(filename << filemode << dataLinkType << snapLen << tzCorrection);
 
     Ptr<PcapFileWrapper> file = CreateObject<PcapFileWrapper>();
+
+    const PcapngTarget& pcapng = GetPcapngTarget();
+    if (pcapng.file)
+    {
+        NS_ABORT_MSG_UNLESS(filemode & std::ios::out, "Cannot read " << filename);
+        std::string name = filename;
+        if (!pcapng.prefix.empty() && name.size() > pcapng.prefix.size() + 1 &&
+            name.starts_with(pcapng.prefix) && name[pcapng.prefix.size()] == '-')
+        {
+            name.erase(0, pcapng.prefix.size() + 1);
+        }
+        if (name.ends_with(".pcap"))
+        {
+            name.erase(name.size() - 5);
+        }
+        file->Open(pcapng.file, name, dataLinkType, snapLen);
+        NS_ABORT_MSG_IF(file->Fail(), "Unable to add " << name << " to a pcapng file");
+        return file;
+    }
+
     file->Open(filename, filemode);
     NS_ABORT_MSG_IF(file->Fail(), "Unable to Open " << filename << " for mode " << filemode);
 
@@ -64,6 +84,58 @@ PcapHelper::CreateFile(std::string filename,
     return file;
 }
 
+Ptr<PcapngFile>
+PcapHelper::CreatePcapngFile(std::string filename)
+{
+    NS_LOG_FUNCTION(filename);
+
+    NS_ABORT_MSG_UNLESS(!filename.empty(), "Empty pcapng file name");
+    auto it = GetPcapngFiles().find(filename);
+    if (it != GetPcapngFiles().end())
+    {
+        return it->second;
+    }
+
+    Ptr<PcapngFile> file = CreateObject<PcapngFile>();
+    file->Open(filename);
+    NS_ABORT_MSG_IF(file->Fail(), "Unable to Open " << filename);
+
+    // Like the pcap files, the pcapng file is kept alive by the trace sinks
+    // of its interfaces; we only keep it until the end of the simulation to
+    // share it between the helpers.
+    GetPcapngFiles()[filename] = file;
+    Simulator::ScheduleDestroy(&PcapHelper::ReleasePcapngFile, filename);
+    return file;
+}
+
+void
+PcapHelper::SetPcapngFile(Ptr<PcapngFile> file, std::string prefix)
+{
+    NS_LOG_FUNCTION(file << prefix);
+    GetPcapngTarget() = {file, file ? prefix : ""};
+}
+
+std::map<std::string, Ptr<PcapngFile>>&
+PcapHelper::GetPcapngFiles()
+{
+    static std::map<std::string, Ptr<PcapngFile>> files;
+    return files;
+}
+
+PcapHelper::PcapngTarget&
+PcapHelper::GetPcapngTarget()
+{
+    static PcapngTarget target;
+    return target;
+}
+
+void
+PcapHelper::ReleasePcapngFile(std::string filename)
+{
+    NS_LOG_FUNCTION(filename);
+    GetPcapngFiles().erase(filename);
+}
+
 std::string
 PcapHelper::GetFilenameFromDevice(std::string prefix, Ptr<NetDevice> device, bool useObjectNames)
 {
@@ -455,6 +527,55 @@ PcapHelperForDevice::EnablePcapAll(std::string prefix, bool promiscuous)
     EnablePcap(prefix, NodeContainer::GetGlobal(), promiscuous);
 }
 
+void
+PcapHelperForDevice::EnablePcap(std::string prefix,
+                                NetDeviceContainer d,
+                                Ptr<PcapngFile> file,
+                                bool promiscuous)
+{
+    NS_ABORT_MSG_UNLESS(file, "No pcapng file");
+    PcapHelper::SetPcapngFile(file, prefix);
+    EnablePcap(prefix, d, promiscuous);
+    PcapHelper::SetPcapngFile(nullptr);
+}
+
+void
+PcapHelperForDevice::EnablePcapAll(std::string prefix, Ptr<PcapngFile> file, bool promiscuous)
+{
+    NS_ABORT_MSG_UNLESS(file, "No pcapng file");
+    PcapHelper::SetPcapngFile(file, prefix);
+    EnablePcapAll(prefix, promiscuous);
+    PcapHelper::SetPcapngFile(nullptr);
+}
+
+/**
+ * @param filename the name of a pcapng file
+ * @returns the file name without its ".pcapng" extension
+ */
+static std::string
+GetPcapngPrefix(std::string filename)
+{
+    if (filename.ends_with(".pcapng"))
+    {
+        filename.erase(filename.size() - 7);
+    }
+    return filename;
+}
+
+void
+PcapHelperForDevice::EnablePcapng(std::string filename, NetDeviceContainer d, bool promiscuous)
+{
+    PcapHelper pcapHelper;
+    EnablePcap(GetPcapngPrefix(filename), d, pcapHelper.CreatePcapngFile(filename), promiscuous);
+}
+
+void
+PcapHelperForDevice::EnablePcapngAll(std::string filename, bool promiscuous)
+{
+    PcapHelper pcapHelper;
+    EnablePcapAll(GetPcapngPrefix(filename), pcapHelper.CreatePcapngFile(filename), promiscuous);
+}
+
 void
 PcapHelperForDevice::EnablePcap(std::string prefix,
                                 uint32_t nodeid,
@@ -13,8 +13,11 @@
 #include "ns3/assert.h"
 #include "ns3/output-stream-wrapper.h"
 #include "ns3/pcap-file-wrapper.h"
+#include "ns3/pcapng-file.h"
 #include "ns3/simulator.h"
 
+#include <map>
+
 namespace ns3
 {
 
@@ -105,6 +108,33 @@ class PcapHelper
                                     DataLinkType dataLinkType,
                                     uint32_t snapLen = std::numeric_limits<uint32_t>::max(),
                                     int32_t tzCorrection = 0);
+    /**
+     * @brief Create a pcapng file, or return the one already created with the
+     * same file name.
+     *
+     * The file is kept until the simulator is destroyed, so that the device
+     * helpers enabling their traces in the same file name share it.  It is
+     * configured through the attributes of ns3::PcapngFile.
+     *
+     * @param filename name of the pcapng file
+     * @returns the pcapng file
+     */
+    Ptr<PcapngFile> CreatePcapngFile(std::string filename);
+
+    /**
+     * @brief Select the pcapng file in which CreateFile adds the traces.
+     *
+     * While a pcapng file is set, CreateFile does not create pcap files, but
+     * adds an interface to the pcapng file instead.  The interface is named
+     * after the file name, without the given prefix followed by a dash, nor
+     * its ".pcap" extension (e.g., "2-1" for the device 1 of the node 2).
+     * Setting a null file makes CreateFile create pcap files again.
+     *
+     * @param file the pcapng file, or a null pointer
+     * @param prefix the file name prefix left out of the interface names
+     */
+    static void SetPcapngFile(Ptr<PcapngFile> file, std::string prefix = "");
+
     /**
      * @brief Hook a trace source to the default trace sink
      *
@@ -116,6 +146,30 @@ class PcapHelper
     void HookDefaultSink(Ptr<T> object, std::string traceName, Ptr<PcapFileWrapper> file);
 
   private:
+    /**
+     * @returns the pcapng files created by CreatePcapngFile, indexed by file name
+     */
+    static std::map<std::string, Ptr<PcapngFile>>& GetPcapngFiles();
+
+    /// The pcapng file selected by SetPcapngFile and the prefix of its file names
+    struct PcapngTarget
+    {
+        Ptr<PcapngFile> file; //!< the pcapng file, or a null pointer
+        std::string prefix;   //!< the file name prefix left out of the interface names
+    };
+
+    /**
+     * @returns the pcapng file in which CreateFile adds the traces
+     */
+    static PcapngTarget& GetPcapngTarget();
+
+    /**
+     * Release a pcapng file created by CreatePcapngFile.
+     *
+     * @param filename the name of the pcapng file
+     */
+    static void ReleasePcapngFile(std::string filename);
+
     /**
      * The basic default trace sink.
      *
@@ -708,6 +762,61 @@ class PcapHelperForDevice
      * @param promiscuous If true capture all possible packets available at the device.
      */
     void EnablePcapAll(std::string prefix, bool promiscuous = false);
+
+    /**
+     * @brief Enable pcap output on each device in the container which is of the
+     * appropriate type, gathering the packets of all the devices in the given
+     * pcapng file with one interface per device.
+     *
+     * @param prefix Filename prefix left out of the interface names.
+     * @param d container of devices
+     * @param file The pcapng file.
+     * @param promiscuous If true capture all possible packets available at the device.
+     *
+     * @see PcapHelper::SetPcapngFile
+     */
+    void EnablePcap(std::string prefix,
+                    NetDeviceContainer d,
+                    Ptr<PcapngFile> file,
+                    bool promiscuous = false);
+
+    /**
+     * @brief Enable pcap output on each device (which is of the appropriate type)
+     * in the set of all nodes created in the simulation, gathering the packets
+     * of all the devices in the given pcapng file with one interface per device.
+     *
+     * @param prefix Filename prefix left out of the interface names.
+     * @param file The pcapng file.
+     * @param promiscuous If true capture all possible packets available at the device.
+     *
+     * @see PcapHelper::SetPcapngFile
+     */
+    void EnablePcapAll(std::string prefix, Ptr<PcapngFile> file, bool promiscuous = false);
+
+    /**
+     * @brief Enable pcap output on each device in the container which is of the
+     * appropriate type, gathering the packets of all the devices in a single
+     * pcapng file with one interface per device.
+     *
+     * @param filename Name of the pcapng file.
+     * @param d container of devices
+     * @param promiscuous If true capture all possible packets available at the device.
+     *
+     * @see PcapHelper::CreatePcapngFile
+     */
+    void EnablePcapng(std::string filename, NetDeviceContainer d, bool promiscuous = false);
+
+    /**
+     * @brief Enable pcap output on each device (which is of the appropriate type)
+     * in the set of all nodes created in the simulation, gathering the packets
+     * of all the devices in a single pcapng file with one interface per device.
+     *
+     * @param filename Name of the pcapng file.
+     * @param promiscuous If true capture all possible packets available at the device.
+     *
+     * @see PcapHelper::CreatePcapngFile
+     */
+    void EnablePcapngAll(std::string filename, bool promiscuous = false);
 };
 
 /**
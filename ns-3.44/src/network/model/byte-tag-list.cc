@@ -52,6 +52,12 @@ static class ByteTagListDataFreeList : public std::vector<ByteTagListData*>
 } g_freeList; //!< Container for struct ByteTagListData
 
 static uint32_t g_maxSize = 0; //!< maximum data size (used for allocation)
+#endif /* USE_FREE_LIST */
+
+static uint64_t g_freeListHits = 0;   //!< allocations served from the free list
+static uint64_t g_freeListMisses = 0; //!< allocations served by the system allocator
+
+#ifdef USE_FREE_LIST
 
 ByteTagListDataFreeList::~ByteTagListDataFreeList()
 {
@@ -353,11 +359,13 @@ ByteTagList::Allocate(uint32_t size)
         {
             data->count = 1;
             data->dirty = 0;
+            g_freeListHits++;
             return data;
         }
         auto buffer = (uint8_t*)data;
         delete[] buffer;
     }
+    g_freeListMisses++;
     auto buffer = new uint8_t[std::max(size, g_maxSize) + sizeof(ByteTagListData) - 4];
     auto data = (ByteTagListData*)buffer;
     data->count = 1;
@@ -396,6 +404,7 @@ ByteTagListData*
 ByteTagList::Allocate(uint32_t size)
 {
     NS_LOG_FUNCTION(this << size);
+    g_freeListMisses++;
     uint8_t* buffer = new uint8_t[size + sizeof(ByteTagListData) - 4];
     ByteTagListData* data = (ByteTagListData*)buffer;
     data->count = 1;
@@ -422,6 +431,18 @@ ByteTagList::Deallocate(ByteTagListData* data)
 
 #endif /* USE_FREE_LIST */
 
+uint64_t
+ByteTagList::GetFreeListHits()
+{
+    return g_freeListHits;
+}
+
+uint64_t
+ByteTagList::GetFreeListMisses()
+{
+    return g_freeListMisses;
+}
+
 uint32_t
 ByteTagList::GetSerializedSize() const
 {
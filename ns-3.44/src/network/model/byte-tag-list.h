@@ -251,6 +251,16 @@ class ByteTagList
      */
     uint32_t Deserialize(const uint32_t* buffer, uint32_t size);
 
+    /**
+     * @returns the number of ByteTagListData allocations served from the free list
+     */
+    static uint64_t GetFreeListHits();
+    /**
+     * @returns the number of ByteTagListData allocations which could not be
+     * served from the free list
+     */
+    static uint64_t GetFreeListMisses();
+
   private:
     /**
      * @brief Returns an iterator pointing to the very first tag in this list.
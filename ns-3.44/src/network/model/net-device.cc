@@ -9,6 +9,7 @@
 #include "net-device.h"
 
 #include "ns3/log.h"
+#include "ns3/queue-item.h"
 
 namespace ns3
 {
@@ -29,4 +30,33 @@ NetDevice::~NetDevice()
     NS_LOG_FUNCTION(this);
 }
 
+bool
+NetDevice::SupportsSegmentationOffload() const
+{
+    return false;
+}
+
+bool
+NetDevice::SetFluidLoad(DataRate rate, Time delay)
+{
+    NS_LOG_FUNCTION(this << rate << delay);
+    return false;
+}
+
+uint32_t
+NetDevice::GetMaxBurstSize() const
+{
+    return 1;
+}
+
+void
+NetDevice::SendBurst(const std::vector<Ptr<QueueDiscItem>>& items)
+{
+    NS_LOG_FUNCTION(this << items.size());
+    for (const auto& item : items)
+    {
+        Send(item->GetPacket(), item->GetAddress(), item->GetProtocol());
+    }
+}
+
 } // namespace ns3
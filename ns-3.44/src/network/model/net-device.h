@@ -13,18 +13,22 @@
 #include "packet.h"
 
 #include "ns3/callback.h"
+#include "ns3/data-rate.h"
 #include "ns3/ipv4-address.h"
 #include "ns3/ipv6-address.h"
+#include "ns3/nstime.h"
 #include "ns3/object.h"
 #include "ns3/ptr.h"
 
 #include <stdint.h>
+#include <vector>
 
 namespace ns3
 {
 
 class Node;
 class Channel;
+class QueueDiscItem;
 
 /**
  * @ingroup network
@@ -356,6 +360,52 @@ class NetDevice : public Object
      * @return true if this interface supports a bridging mode, false otherwise.
      */
     virtual bool SupportsSendFrom() const = 0;
+
+    /**
+     * @return true if this interface can send the super-segments of a
+     *         transport protocol emulating segmentation offload, i.e., the
+     *         packets larger than the MTU carrying a SegmentationOffloadTag,
+     *         false otherwise (the default).
+     */
+    virtual bool SupportsSegmentationOffload() const;
+
+    /**
+     * @brief Set the load of the fluid flows sent through this interface.
+     *
+     * Fluid flows model background traffic at the flow level (see
+     * TcpFluidModel): they are not simulated packet by packet, but take part
+     * of the capacity of the interface and add a queueing delay to the
+     * packets it sends.
+     *
+     * @param rate the aggregate rate of the fluid flows
+     * @param delay the queueing delay the fluid flows add to each packet
+     * @return true if this interface models the load of fluid flows, false
+     *         otherwise (the default, the load being then ignored).
+     */
+    virtual bool SetFluidLoad(DataRate rate, Time delay);
+
+    /**
+     * @return the maximum number of packets this interface can be handed at
+     *         once with SendBurst, or 1 (the default) if it does not handle
+     *         bursts.
+     */
+    virtual uint32_t GetMaxBurstSize() const;
+
+    /**
+     * @brief Send a burst of packets, dequeued at once by the traffic control layer.
+     *
+     * This is the counterpart of the xmit_more hint of the Linux drivers: the
+     * interface is handed all the packets before it starts transmitting them,
+     * so that it can transmit them as a single train. The traffic control
+     * layer only sends bursts to the interfaces whose GetMaxBurstSize is
+     * greater than 1, and with no more bytes than the queue limits (e.g., BQL)
+     * of the device queue allow. The default implementation calls Send for
+     * each packet.
+     *
+     * @param items the packets, along with their destination address and
+     *        protocol number
+     */
+    virtual void SendBurst(const std::vector<Ptr<QueueDiscItem>>& items);
 };
 
 } // namespace ns3
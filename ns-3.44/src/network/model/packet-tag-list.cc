@@ -20,12 +20,60 @@
 #include "ns3/log.h"
 
 #include <cstring>
+#include <vector>
+
+#define PACKET_TAG_FREE_LIST_SIZE 1000
+/**
+ * Size of the data area of the TagData structs kept in the free list.
+ * Tags with a larger serialized size are always allocated on demand.
+ */
+#define PACKET_TAG_FREE_LIST_DATA_SIZE 32
 
 namespace ns3
 {
 
 NS_LOG_COMPONENT_DEFINE("PacketTagList");
 
+namespace
+{
+
+/**
+ * @ingroup packet
+ * Free list of small TagData structs.
+ *
+ * The free list is created on demand and released by the static
+ * destructor below. Once released, g_freeListDestroyed makes sure
+ * that TagData structs freed by later static destructors go straight
+ * back to the system allocator.
+ */
+std::vector<PacketTagList::TagData*>* g_freeList = nullptr;
+bool g_freeListDestroyed = false; //!< Whether the free list has been released
+uint64_t g_freeListHits = 0;      //!< Allocations served from the free list
+uint64_t g_freeListMisses = 0;    //!< Allocations served by the system allocator
+
+/**
+ * @ingroup packet
+ * Release the content of the free list at the end of the program.
+ */
+struct TagDataFreeListDestructor
+{
+    ~TagDataFreeListDestructor()
+    {
+        if (g_freeList != nullptr)
+        {
+            for (auto data : *g_freeList)
+            {
+                std::free(data);
+            }
+            delete g_freeList;
+            g_freeList = nullptr;
+        }
+        g_freeListDestroyed = true;
+    }
+} g_freeListDestructor; //!< Free list static destructor
+
+} // namespace
+
 PacketTagList::TagData*
 PacketTagList::CreateTagData(size_t dataSize)
 {
@@ -33,14 +81,69 @@ PacketTagList::CreateTagData(size_t dataSize)
                   "Requested TagData size " << dataSize << " exceeds maximum "
                                             << std::numeric_limits<decltype(TagData::size)>::max());
 
-    void* p = std::malloc(sizeof(TagData) + dataSize - 1);
-    // The matching frees are in RemoveAll and RemoveWriter
+    void* p = nullptr;
+    if (dataSize <= PACKET_TAG_FREE_LIST_DATA_SIZE)
+    {
+        if (g_freeList != nullptr && !g_freeList->empty())
+        {
+            p = g_freeList->back();
+            g_freeList->pop_back();
+            g_freeListHits++;
+        }
+        else
+        {
+            p = std::malloc(sizeof(TagData) + PACKET_TAG_FREE_LIST_DATA_SIZE - 1);
+            g_freeListMisses++;
+        }
+    }
+    else
+    {
+        p = std::malloc(sizeof(TagData) + dataSize - 1);
+        g_freeListMisses++;
+    }
+    // The matching release is in FreeTagData
 
     auto tag = new (p) TagData;
     tag->size = dataSize;
     return tag;
 }
 
+void
+PacketTagList::FreeTagData(TagData* data)
+{
+    // the size of a TagData is never changed after creation, so it
+    // tells us whether the data area is large enough to be recycled
+    bool recycle = data->size <= PACKET_TAG_FREE_LIST_DATA_SIZE && !g_freeListDestroyed;
+    data->~TagData();
+    if (!recycle)
+    {
+        std::free(data);
+        return;
+    }
+    if (g_freeList == nullptr)
+    {
+        g_freeList = new std::vector<TagData*>();
+    }
+    if (g_freeList->size() >= PACKET_TAG_FREE_LIST_SIZE)
+    {
+        std::free(data);
+        return;
+    }
+    g_freeList->push_back(data);
+}
+
+uint64_t
+PacketTagList::GetFreeListHits()
+{
+    return g_freeListHits;
+}
+
+uint64_t
+PacketTagList::GetFreeListMisses()
+{
+    return g_freeListMisses;
+}
+
 bool
 PacketTagList::COWTraverse(Tag& tag, PacketTagList::COWWriter Writer)
 {
@@ -161,9 +264,25 @@ PacketTagList::COWTraverse(Tag& tag, PacketTagList::COWWriter Writer)
     return found;
 }
 
+void
+PacketTagList::RemoveInline(uint32_t index)
+{
+    NS_ASSERT(index < m_nInline);
+    std::copy(m_inline + index + 1, m_inline + m_nInline, m_inline + index);
+    m_nInline--;
+}
+
 bool
 PacketTagList::Remove(Tag& tag)
 {
+    uint32_t index = FindInline(tag.GetInstanceTypeId());
+    if (index < m_nInline)
+    {
+        InlineTag& slot = m_inline[index];
+        tag.Deserialize(TagBuffer(slot.data, slot.data + slot.size));
+        RemoveInline(index);
+        return true;
+    }
     return COWTraverse(tag, &PacketTagList::RemoveWriter);
 }
 
@@ -184,8 +303,7 @@ PacketTagList::RemoveWriter(Tag& tag,
     if (preMerge)
     {
         // found tid before first merge, so delete cur
-        cur->~TagData();
-        std::free(cur);
+        FreeTagData(cur);
     }
     else
     {
@@ -204,6 +322,24 @@ PacketTagList::RemoveWriter(Tag& tag,
 bool
 PacketTagList::Replace(Tag& tag)
 {
+    uint32_t index = FindInline(tag.GetInstanceTypeId());
+    if (index < m_nInline)
+    {
+        uint32_t size = tag.GetSerializedSize();
+        if (size <= INLINE_TAG_SIZE)
+        {
+            InlineTag& slot = m_inline[index];
+            slot.size = size;
+            tag.Serialize(TagBuffer(slot.data, slot.data + slot.size));
+        }
+        else
+        {
+            // the new value does not fit inline anymore
+            RemoveInline(index);
+            Add(tag);
+        }
+        return true;
+    }
     bool found = COWTraverse(tag, &PacketTagList::ReplaceWriter);
     if (!found)
     {
@@ -251,17 +387,31 @@ void
 PacketTagList::Add(const Tag& tag) const
 {
     NS_LOG_FUNCTION(this << tag.GetInstanceTypeId());
+    TypeId tid = tag.GetInstanceTypeId();
     // ensure this id was not yet added
+    NS_ASSERT_MSG(FindInline(tid) == INLINE_TAGS,
+                  "Error: cannot add the same kind of tag twice. The tag type is "
+                      << tid.GetName());
     for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
     {
-        NS_ASSERT_MSG(cur->tid != tag.GetInstanceTypeId(),
+        NS_ASSERT_MSG(cur->tid != tid,
                       "Error: cannot add the same kind of tag twice. The tag type is "
-                          << tag.GetInstanceTypeId().GetName());
+                          << tid.GetName());
+    }
+    uint32_t size = tag.GetSerializedSize();
+    if (m_nInline < INLINE_TAGS && size <= INLINE_TAG_SIZE)
+    {
+        auto self = const_cast<PacketTagList*>(this);
+        InlineTag& slot = self->m_inline[self->m_nInline++];
+        slot.tid = tid;
+        slot.size = size;
+        tag.Serialize(TagBuffer(slot.data, slot.data + slot.size));
+        return;
     }
-    TagData* head = CreateTagData(tag.GetSerializedSize());
+    TagData* head = CreateTagData(size);
     head->count = 1;
     head->next = nullptr;
-    head->tid = tag.GetInstanceTypeId();
+    head->tid = tid;
     head->next = m_next;
     tag.Serialize(TagBuffer(head->data, head->data + head->size));
 
@@ -273,6 +423,14 @@ PacketTagList::Peek(Tag& tag) const
 {
     NS_LOG_FUNCTION(this << tag.GetInstanceTypeId());
     TypeId tid = tag.GetInstanceTypeId();
+    uint32_t index = FindInline(tid);
+    if (index < m_nInline)
+    {
+        const InlineTag& slot = m_inline[index];
+        tag.Deserialize(TagBuffer(const_cast<uint8_t*>(slot.data),
+                                  const_cast<uint8_t*>(slot.data) + slot.size));
+        return true;
+    }
     for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
     {
         if (cur->tid == tid)
@@ -301,12 +459,21 @@ PacketTagList::GetSerializedSize() const
 
     size = 4; // numberOfTags
 
+    // TypeId hash; ensure size is multiple of 4 bytes
+    uint32_t hashSize = (sizeof(TypeId::hash_t) + 3) & (~3);
+
+    for (uint32_t i = 0; i < m_nInline; ++i)
+    {
+        size += 4;        // InlineTag -> size
+        size += hashSize; // InlineTag -> tid
+        // InlineTag -> data; ensure size is multiple of 4 bytes
+        size += (m_inline[i].size + 3) & (~3);
+    }
+
     for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
     {
         size += 4; // TagData -> size
 
-        // TypeId hash; ensure size is multiple of 4 bytes
-        uint32_t hashSize = (sizeof(TypeId::hash_t) + 3) & (~3);
         size += hashSize;
 
         // TagData -> data; ensure size is multiple of 4 bytes
@@ -335,18 +502,18 @@ PacketTagList::Serialize(uint32_t* buffer, uint32_t maxSize) const
     uint32_t* numberOfTags = p;
     *p++ = 0;
 
-    for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
-    {
+    // serialize one tag, returns false if it does not fit in the buffer
+    auto serializeTag = [&](TypeId tagTid, const uint8_t* data, uint32_t dataSize) {
         size += 4;
 
         if (size > maxSize)
         {
-            return 0;
+            return false;
         }
 
-        *p++ = cur->size;
+        *p++ = dataSize;
 
-        NS_LOG_INFO("Serializing tag id " << cur->tid);
+        NS_LOG_INFO("Serializing tag id " << tagTid);
 
         // ensure size is multiple of 4 bytes for 4 byte boundaries
         uint32_t hashSize = (sizeof(TypeId::hash_t) + 3) & (~3);
@@ -354,32 +521,81 @@ PacketTagList::Serialize(uint32_t* buffer, uint32_t maxSize) const
 
         if (size > maxSize)
         {
-            return 0;
+            return false;
         }
 
-        TypeId::hash_t tid = cur->tid.GetHash();
+        TypeId::hash_t tid = tagTid.GetHash();
         memcpy(p, &tid, sizeof(TypeId::hash_t));
         p += hashSize / 4;
 
         // ensure size is multiple of 4 bytes for 4 byte boundaries
-        uint32_t tagWordSize = (cur->size + 3) & (~3);
+        uint32_t tagWordSize = (dataSize + 3) & (~3);
         size += tagWordSize;
 
         if (size > maxSize)
         {
-            return 0;
+            return false;
         }
 
-        memcpy(p, cur->data, cur->size);
+        memcpy(p, data, dataSize);
         p += tagWordSize / 4;
 
         (*numberOfTags)++;
+        return true;
+    };
+
+    for (uint32_t i = 0; i < m_nInline; ++i)
+    {
+        if (!serializeTag(m_inline[i].tid, m_inline[i].data, m_inline[i].size))
+        {
+            return 0;
+        }
+    }
+
+    for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
+    {
+        if (!serializeTag(cur->tid, cur->data, cur->size))
+        {
+            return 0;
+        }
     }
 
     // Serialized successfully
     return 1;
 }
 
+void
+PacketTagList::Append(TypeId tid, const uint8_t* data, uint32_t size, TagData** tail)
+{
+    NS_LOG_FUNCTION(this << tid << size);
+    if (m_nInline < INLINE_TAGS && size <= INLINE_TAG_SIZE && *tail == nullptr)
+    {
+        InlineTag& slot = m_inline[m_nInline++];
+        slot.tid = tid;
+        slot.size = size;
+        memcpy(slot.data, data, size);
+        return;
+    }
+
+    TagData* newTag = CreateTagData(size);
+    newTag->count = 1;
+    newTag->next = nullptr;
+    newTag->tid = tid;
+    memcpy(newTag->data, data, size);
+
+    // Set link list pointers.
+    if (*tail == nullptr)
+    {
+        NS_ASSERT(m_next == nullptr);
+        m_next = newTag;
+    }
+    else
+    {
+        (*tail)->next = newTag;
+    }
+    *tail = newTag;
+}
+
 uint32_t
 PacketTagList::Deserialize(const uint32_t* buffer, uint32_t size)
 {
@@ -411,30 +627,13 @@ PacketTagList::Deserialize(const uint32_t* buffer, uint32_t size)
 
         NS_LOG_INFO("Deserializing tag of type " << tid);
 
-        TagData* newTag = CreateTagData(tagSize);
-        newTag->count = 1;
-        newTag->next = nullptr;
-        newTag->tid = tid;
-
         NS_ASSERT(sizeCheck >= tagSize);
-        memcpy(newTag->data, p, tagSize);
+        Append(tid, reinterpret_cast<const uint8_t*>(p), tagSize, &prevTag);
 
         // ensure 4 byte boundary
         uint32_t tagWordSize = (tagSize + 3) & (~3);
         p += tagWordSize / 4;
         sizeCheck -= tagWordSize;
-
-        // Set link list pointers.
-        if (i == 0)
-        {
-            m_next = newTag;
-        }
-        else
-        {
-            prevTag->next = newTag;
-        }
-
-        prevTag = newTag;
     }
 
     NS_ASSERT(sizeCheck == 0);
@@ -15,6 +15,7 @@
 
 #include "ns3/type-id.h"
 
+#include <algorithm>
 #include <ostream>
 #include <stdint.h>
 
@@ -33,7 +34,16 @@ class Tag;
  *
  * @internal
  *
- * The implementation of this class is a bit tricky.  Refer to this
+ * The first #INLINE_TAGS tags whose serialized size does not exceed
+ * #INLINE_TAG_SIZE bytes are stored inline, in a small array held by
+ * the PacketTagList itself and looked up by TypeId. Adding, finding
+ * and removing those tags never allocates memory nor walks a list,
+ * and copying a PacketTagList copies only the used inline slots.
+ * This covers the few small tags (flow id, timestamp, priority, ...)
+ * that most protocol stacks attach to a packet.
+ *
+ * The remaining tags are stored in a tree of TagData structures.
+ * The implementation of this part is a bit tricky.  Refer to this
  * diagram in the discussion that follows.
  *
  * @dot
@@ -137,6 +147,11 @@ class PacketTagList
         uint8_t data[1]; //!< Serialization buffer
     };
 
+    /// Maximum number of tags stored inline
+    static constexpr uint32_t INLINE_TAGS = 4;
+    /// Maximum serialized size of a tag stored inline
+    static constexpr uint32_t INLINE_TAG_SIZE = 20;
+
     /**
      * Create a new PacketTagList.
      */
@@ -204,7 +219,7 @@ class PacketTagList
      */
     inline void RemoveAll();
     /**
-     * @returns pointer to head of tag list
+     * @returns pointer to head of the list of tags not stored inline
      */
     const PacketTagList::TagData* Head() const;
     /**
@@ -232,15 +247,74 @@ class PacketTagList
      */
     uint32_t Deserialize(const uint32_t* buffer, uint32_t size);
 
+    /**
+     * @returns the number of TagData allocations served from the free list
+     */
+    static uint64_t GetFreeListHits();
+    /**
+     * @returns the number of TagData allocations which could not be served
+     * from the free list
+     */
+    static uint64_t GetFreeListMisses();
+
   private:
+    /// Friend class
+    friend class PacketTagIterator;
+
+    /**
+     * Tag stored inline in the PacketTagList.
+     */
+    struct InlineTag
+    {
+        TypeId tid;                    //!< Type of the tag serialized into #data
+        uint8_t size;                  //!< Size of the serialized tag
+        uint8_t data[INLINE_TAG_SIZE]; //!< Serialization buffer
+    };
+
+    /**
+     * Find a tag stored inline.
+     *
+     * @param [in] tid The type of the tag.
+     * @returns The index of the inline slot holding the tag, or #INLINE_TAGS
+     *          if the tag is not stored inline.
+     */
+    inline uint32_t FindInline(TypeId tid) const;
+    /**
+     * Remove the tag stored in an inline slot, moving down the
+     * following slots.
+     *
+     * @param [in] index The index of the inline slot.
+     */
+    void RemoveInline(uint32_t index);
+    /**
+     * Append a serialized tag to this list, inline if possible.
+     *
+     * Used when deserializing, to preserve the order of the tags.
+     *
+     * @param [in] tid The type of the tag.
+     * @param [in] data The serialized tag.
+     * @param [in] size The size of the serialized tag.
+     * @param [in,out] tail Pointer to the last TagData of the list, if any.
+     */
+    void Append(TypeId tid, const uint8_t* data, uint32_t size, TagData** tail);
+
     /**
      * Allocate and construct a TagData struct, sizing the data area
      * large enough to serialize dataSize bytes from a Tag.
      *
+     * Small TagData structs are recycled through a free list.
+     *
      * @param [in] dataSize The serialized size of the Tag.
      * @returns The newly constructed TagData object.
      */
     static TagData* CreateTagData(size_t dataSize);
+    /**
+     * Destroy a TagData struct allocated by #CreateTagData, and
+     * return it to the free list if possible.
+     *
+     * @param [in] data The TagData to release.
+     */
+    static void FreeTagData(TagData* data);
 
     /**
      * Typedef of method function pointer for copy-on-write operations
@@ -290,6 +364,8 @@ class PacketTagList
      */
     bool ReplaceWriter(Tag& tag, bool preMerge, TagData* cur, TagData** prevNext);
 
+    InlineTag m_inline[INLINE_TAGS]; //!< Tags stored inline
+    uint32_t m_nInline;               //!< Number of tags stored inline
     /**
      * Pointer to first \ref TagData on the list
      */
@@ -306,13 +382,16 @@ namespace ns3
 {
 
 PacketTagList::PacketTagList()
-    : m_next()
+    : m_nInline(0),
+      m_next()
 {
 }
 
 PacketTagList::PacketTagList(const PacketTagList& o)
-    : m_next(o.m_next)
+    : m_nInline(o.m_nInline),
+      m_next(o.m_next)
 {
+    std::copy_n(o.m_inline, m_nInline, m_inline);
     if (m_next != nullptr)
     {
         m_next->count++;
@@ -323,16 +402,21 @@ PacketTagList&
 PacketTagList::operator=(const PacketTagList& o)
 {
     // self assignment
-    if (m_next == o.m_next)
+    if (this == &o)
     {
         return *this;
     }
-    RemoveAll();
-    m_next = o.m_next;
-    if (m_next != nullptr)
+    if (m_next != o.m_next)
     {
-        m_next->count++;
+        RemoveAll();
+        m_next = o.m_next;
+        if (m_next != nullptr)
+        {
+            m_next->count++;
+        }
     }
+    m_nInline = o.m_nInline;
+    std::copy_n(o.m_inline, m_nInline, m_inline);
     return *this;
 }
 
@@ -341,9 +425,21 @@ PacketTagList::~PacketTagList()
     RemoveAll();
 }
 
+uint32_t
+PacketTagList::FindInline(TypeId tid) const
+{
+    uint32_t i = 0;
+    while (i < m_nInline && m_inline[i].tid != tid)
+    {
+        ++i;
+    }
+    return (i < m_nInline) ? i : INLINE_TAGS;
+}
+
 void
 PacketTagList::RemoveAll()
 {
+    m_nInline = 0;
     TagData* prev = nullptr;
     for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
     {
@@ -354,15 +450,13 @@ PacketTagList::RemoveAll()
         }
         if (prev != nullptr)
         {
-            prev->~TagData();
-            std::free(prev);
+            FreeTagData(prev);
         }
         prev = cur;
     }
     if (prev != nullptr)
     {
-        prev->~TagData();
-        std::free(prev);
+        FreeTagData(prev);
     }
     m_next = nullptr;
 }
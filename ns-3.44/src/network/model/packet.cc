@@ -12,7 +12,11 @@
 #include "ns3/simulator.h"
 
 #include <cstdarg>
+#include <new>
 #include <string>
+#include <vector>
+
+#define PACKET_FREE_LIST_SIZE 1000
 
 namespace ns3
 {
@@ -21,6 +25,46 @@ NS_LOG_COMPONENT_DEFINE("Packet");
 
 uint32_t Packet::m_globalUid = 0;
 
+namespace
+{
+
+/**
+ * @ingroup packet
+ * Free list of Packet storage.
+ *
+ * The free list is created on demand and released by the static
+ * destructor below. Once released, g_freeListDestroyed makes sure
+ * that packets deleted by later static destructors go straight
+ * back to the system allocator.
+ */
+std::vector<void*>* g_freeList = nullptr;
+bool g_freeListDestroyed = false; //!< Whether the free list has been released
+uint64_t g_freeListHits = 0;      //!< Allocations served from the free list
+uint64_t g_freeListMisses = 0;    //!< Allocations served by the system allocator
+
+/**
+ * @ingroup packet
+ * Release the content of the free list at the end of the program.
+ */
+struct PacketFreeListDestructor
+{
+    ~PacketFreeListDestructor()
+    {
+        if (g_freeList != nullptr)
+        {
+            for (auto storage : *g_freeList)
+            {
+                ::operator delete(storage);
+            }
+            delete g_freeList;
+            g_freeList = nullptr;
+        }
+        g_freeListDestroyed = true;
+    }
+} g_freeListDestructor; //!< Free list static destructor
+
+} // namespace
+
 TypeId
 ByteTagIterator::Item::GetTypeId() const
 {
@@ -78,42 +122,51 @@ ByteTagIterator::ByteTagIterator(ByteTagList::Iterator i)
 {
 }
 
-PacketTagIterator::PacketTagIterator(const PacketTagList::TagData* head)
-    : m_current(head)
+PacketTagIterator::PacketTagIterator(const PacketTagList* list)
+    : m_list(list),
+      m_inline(0),
+      m_current(list->Head())
 {
 }
 
 bool
 PacketTagIterator::HasNext() const
 {
-    return m_current != nullptr;
+    return m_inline < m_list->m_nInline || m_current != nullptr;
 }
 
 PacketTagIterator::Item
 PacketTagIterator::Next()
 {
     NS_ASSERT(HasNext());
+    if (m_inline < m_list->m_nInline)
+    {
+        const PacketTagList::InlineTag& slot = m_list->m_inline[m_inline++];
+        return PacketTagIterator::Item(slot.tid, slot.data, slot.size);
+    }
     const PacketTagList::TagData* prev = m_current;
     m_current = m_current->next;
-    return PacketTagIterator::Item(prev);
+    return PacketTagIterator::Item(prev->tid, prev->data, prev->size);
 }
 
-PacketTagIterator::Item::Item(const PacketTagList::TagData* data)
-    : m_data(data)
+PacketTagIterator::Item::Item(TypeId tid, const uint8_t* data, uint32_t size)
+    : m_tid(tid),
+      m_data(data),
+      m_size(size)
 {
 }
 
 TypeId
 PacketTagIterator::Item::GetTypeId() const
 {
-    return m_data->tid;
+    return m_tid;
 }
 
 void
 PacketTagIterator::Item::GetTag(Tag& tag) const
 {
-    NS_ASSERT(tag.GetInstanceTypeId() == m_data->tid);
-    tag.Deserialize(TagBuffer((uint8_t*)m_data->data, (uint8_t*)m_data->data + m_data->size));
+    NS_ASSERT(tag.GetInstanceTypeId() == m_tid);
+    tag.Deserialize(TagBuffer((uint8_t*)m_data, (uint8_t*)m_data + m_size));
 }
 
 Ptr<Packet>
@@ -595,6 +648,57 @@ Packet::EnableChecking()
     PacketMetadata::EnableChecking();
 }
 
+Packet::FreeListStats
+Packet::GetFreeListStats()
+{
+    FreeListStats stats;
+    stats.packetHits = g_freeListHits;
+    stats.packetMisses = g_freeListMisses;
+    stats.packetTagHits = PacketTagList::GetFreeListHits();
+    stats.packetTagMisses = PacketTagList::GetFreeListMisses();
+    stats.byteTagListHits = ByteTagList::GetFreeListHits();
+    stats.byteTagListMisses = ByteTagList::GetFreeListMisses();
+    return stats;
+}
+
+void*
+Packet::operator new(std::size_t size)
+{
+    if (size == sizeof(Packet) && g_freeList != nullptr && !g_freeList->empty())
+    {
+        void* storage = g_freeList->back();
+        g_freeList->pop_back();
+        g_freeListHits++;
+        return storage;
+    }
+    g_freeListMisses++;
+    return ::operator new(size);
+}
+
+void
+Packet::operator delete(void* ptr, std::size_t size)
+{
+    if (ptr == nullptr)
+    {
+        return;
+    }
+    if (size != sizeof(Packet) || g_freeListDestroyed)
+    {
+        ::operator delete(ptr);
+        return;
+    }
+    if (g_freeList == nullptr)
+    {
+        g_freeList = new std::vector<void*>();
+    }
+    if (g_freeList->size() >= PACKET_FREE_LIST_SIZE)
+    {
+        ::operator delete(ptr);
+        return;
+    }
+    g_freeList->push_back(ptr);
+}
+
 uint32_t
 Packet::GetSerializedSize() const
 {
@@ -1008,7 +1112,7 @@ Packet::PrintPacketTags(std::ostream& os) const
 PacketTagIterator
 Packet::GetPacketTagIterator() const
 {
-    return PacketTagIterator(m_packetTagList.Head());
+    return PacketTagIterator(&m_packetTagList);
 }
 
 std::ostream&
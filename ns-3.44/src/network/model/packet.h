@@ -22,6 +22,7 @@
 #include "ns3/mac48-address.h"
 #include "ns3/ptr.h"
 
+#include <cstddef>
 #include <stdint.h>
 
 namespace ns3
@@ -149,10 +150,14 @@ class PacketTagIterator
         friend class PacketTagIterator;
         /**
          * Constructor
-         * @param data the data to copy.
+         * @param tid the type of the tag.
+         * @param data the serialized tag.
+         * @param size the size of the serialized tag.
          */
-        Item(const PacketTagList::TagData* data);
-        const PacketTagList::TagData* m_data; //!< the tag data
+        Item(TypeId tid, const uint8_t* data, uint32_t size);
+        TypeId m_tid;          //!< the type of the tag
+        const uint8_t* m_data; //!< the serialized tag
+        uint32_t m_size;       //!< the size of the serialized tag
     };
 
     /**
@@ -169,10 +174,12 @@ class PacketTagIterator
     friend class Packet;
     /**
      * Constructor
-     * @param head head of the items
+     * @param list the list of tags to iterate over
      */
-    PacketTagIterator(const PacketTagList::TagData* head);
-    const PacketTagList::TagData* m_current; //!< actual position over the set of tags in a packet
+    PacketTagIterator(const PacketTagList* list);
+    const PacketTagList* m_list;             //!< the list of tags to iterate over
+    uint32_t m_inline;                       //!< actual position over the inline tags
+    const PacketTagList::TagData* m_current; //!< actual position over the other tags
 };
 
 /**
@@ -526,6 +533,49 @@ class Packet : public SimpleRefCount<Packet>
      */
     static void EnableChecking();
 
+    /**
+     * @brief Counters of the free lists used to recycle packet storage.
+     *
+     * A hit is an allocation served from a free list, a miss is an
+     * allocation which had to be served by the system allocator.
+     */
+    struct FreeListStats
+    {
+        uint64_t packetHits;        //!< Packet instances recycled
+        uint64_t packetMisses;      //!< Packet instances allocated
+        uint64_t packetTagHits;     //!< PacketTagList::TagData recycled
+        uint64_t packetTagMisses;   //!< PacketTagList::TagData allocated
+        uint64_t byteTagListHits;   //!< ByteTagList data recycled
+        uint64_t byteTagListMisses; //!< ByteTagList data allocated
+    };
+
+    /**
+     * @brief Get the counters of the packet free lists.
+     *
+     * Packet instances, packet tags and byte tag lists are returned to
+     * free lists when their reference count drops to zero, and reused
+     * by later allocations.
+     *
+     * @returns the free list counters
+     */
+    static FreeListStats GetFreeListStats();
+
+    /**
+     * @brief Allocate the storage of a Packet, reusing the storage of a
+     * previously deleted Packet if available.
+     *
+     * @param size the size of the storage
+     * @returns a pointer to the storage
+     */
+    static void* operator new(std::size_t size);
+    /**
+     * @brief Release the storage of a Packet to the free list.
+     *
+     * @param ptr a pointer to the storage
+     * @param size the size of the storage
+     */
+    static void operator delete(void* ptr, std::size_t size);
+
     /**
      * @brief Returns number of bytes required for packet
      * serialization.
@@ -5,9 +5,12 @@
  */
 
 #include "ns3/drop-tail-queue.h"
+#include "ns3/ring-buffer.h"
 #include "ns3/string.h"
 #include "ns3/test.h"
 
+#include <deque>
+
 using namespace ns3;
 
 /**
@@ -76,6 +79,131 @@ DropTailQueueTestCase::DoRun()
     NS_TEST_EXPECT_MSG_EQ(packet, nullptr, "There are really no packets in there");
 }
 
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * @brief RingBuffer must behave like a sequence container as it wraps around and grows.
+ */
+class RingBufferTestCase : public TestCase
+{
+  public:
+    RingBufferTestCase();
+    void DoRun() override;
+
+  private:
+    /**
+     * Check that a RingBuffer has the same content as a reference deque.
+     * @param buffer the ring buffer
+     * @param expected the reference content
+     * @param step a description of the last operation
+     */
+    void CheckContent(const RingBuffer<int>& buffer,
+                      const std::deque<int>& expected,
+                      const std::string& step);
+};
+
+RingBufferTestCase::RingBufferTestCase()
+    : TestCase("Check the RingBuffer container used by the queues")
+{
+}
+
+void
+RingBufferTestCase::CheckContent(const RingBuffer<int>& buffer,
+                                 const std::deque<int>& expected,
+                                 const std::string& step)
+{
+    NS_TEST_ASSERT_MSG_EQ(buffer.size(), expected.size(), "Wrong size after " << step);
+    auto it = buffer.begin();
+    for (std::size_t i = 0; i < expected.size(); ++i, ++it)
+    {
+        NS_TEST_EXPECT_MSG_EQ(*it, expected[i], "Wrong element " << i << " after " << step);
+    }
+    NS_TEST_EXPECT_MSG_EQ((it == buffer.end()), true, "Wrong end after " << step);
+}
+
+void
+RingBufferTestCase::DoRun()
+{
+    RingBuffer<int> buffer;
+    std::deque<int> expected;
+    NS_TEST_EXPECT_MSG_EQ(buffer.empty(), true, "A new buffer is empty");
+    NS_TEST_EXPECT_MSG_EQ((buffer.begin() == buffer.end()), true, "A new buffer is empty");
+
+    // free slots, which must be reused before the array grows
+    int value = 0;
+    for (int i = 0; i < 5; ++i)
+    {
+        buffer.insert(buffer.end(), value);
+        buffer.erase(buffer.begin());
+        ++value;
+    }
+    std::size_t capacity = buffer.capacity();
+    for (std::size_t i = 0; i < capacity; ++i)
+    {
+        buffer.insert(buffer.end(), value);
+        expected.push_back(value++);
+    }
+    NS_TEST_EXPECT_MSG_EQ(buffer.capacity(), capacity, "The buffer must not grow before full");
+    CheckContent(buffer, expected, "filling the buffer");
+
+    // the buffer grows and keeps the order of the elements
+    buffer.insert(buffer.end(), value);
+    expected.push_back(value++);
+    NS_TEST_EXPECT_MSG_EQ(buffer.capacity(), 2 * capacity, "The capacity must be doubled");
+    CheckContent(buffer, expected, "growing the buffer");
+
+    // insertions and removals in the middle, close to either end
+    auto it = buffer.insert(std::next(buffer.begin(), 2), value);
+    NS_TEST_EXPECT_MSG_EQ(*it, value, "insert must return an iterator to the new element");
+    expected.insert(expected.begin() + 2, value++);
+    CheckContent(buffer, expected, "inserting close to the front");
+    it = buffer.insert(std::prev(buffer.end(), 2), value);
+    NS_TEST_EXPECT_MSG_EQ(*it, value, "insert must return an iterator to the new element");
+    expected.insert(expected.end() - 2, value++);
+    CheckContent(buffer, expected, "inserting close to the back");
+    it = buffer.erase(std::next(buffer.begin()));
+    NS_TEST_EXPECT_MSG_EQ(*it, expected[2], "erase must return an iterator to the next element");
+    expected.erase(expected.begin() + 1);
+    CheckContent(buffer, expected, "erasing close to the front");
+    it = buffer.erase(std::prev(buffer.end(), 3));
+    NS_TEST_EXPECT_MSG_EQ(*it, *(expected.end() - 2), "erase must return the next element");
+    expected.erase(expected.end() - 3);
+    CheckContent(buffer, expected, "erasing close to the back");
+    it = buffer.erase(std::prev(buffer.end()));
+    NS_TEST_EXPECT_MSG_EQ((it == buffer.end()), true, "Erasing the last element returns end");
+    expected.pop_back();
+    CheckContent(buffer, expected, "erasing the last element");
+
+    // inserting and erasing other elements, and growing the array, keep the iterators valid
+    auto first = buffer.begin();
+    auto middle = std::next(first, 3);
+    auto last = std::prev(buffer.end());
+    int firstValue = *first;
+    int middleValue = *middle;
+    int lastValue = *last;
+    buffer.erase(std::next(middle));
+    expected.erase(expected.begin() + 4);
+    int insertedValue = value;
+    buffer.insert(middle, value);
+    expected.insert(expected.begin() + 3, value++);
+    capacity = buffer.capacity();
+    while (buffer.capacity() == capacity)
+    {
+        buffer.push_front(value);
+        expected.push_front(value++);
+    }
+    CheckContent(buffer, expected, "growing the buffer again");
+    NS_TEST_EXPECT_MSG_EQ(*first, firstValue, "The iterator to the first element moved");
+    NS_TEST_EXPECT_MSG_EQ(*middle, middleValue, "The iterator to a middle element moved");
+    NS_TEST_EXPECT_MSG_EQ(*last, lastValue, "The iterator to the last element moved");
+    NS_TEST_EXPECT_MSG_EQ(*std::prev(middle), insertedValue, "Wrong element before the middle");
+    capacity = buffer.capacity();
+    buffer.clear();
+    NS_TEST_EXPECT_MSG_EQ(buffer.empty(), true, "The buffer must be empty after clear");
+    NS_TEST_EXPECT_MSG_EQ(buffer.capacity(), capacity, "clear must keep the capacity");
+}
+
 /**
  * @ingroup network-test
  * @ingroup tests
@@ -89,6 +217,7 @@ class DropTailQueueTestSuite : public TestSuite
         : TestSuite("drop-tail-queue", Type::UNIT)
     {
         AddTestCase(new DropTailQueueTestCase(), TestCase::Duration::QUICK);
+        AddTestCase(new RingBufferTestCase(), TestCase::Duration::QUICK);
     }
 };
 
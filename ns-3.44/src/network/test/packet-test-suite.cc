@@ -1257,6 +1257,169 @@ PacketTagListTest::DoRun()
     } // Timing
 }
 
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * Packet free list unit tests.
+ *
+ * Checks that Packet instances and packet tags are recycled once
+ * their reference count drops to zero, without breaking the
+ * copy-on-write semantics of Packet::Copy.
+ */
+class PacketFreeListTest : public TestCase
+{
+  public:
+    PacketFreeListTest();
+
+  private:
+    void DoRun() override;
+};
+
+PacketFreeListTest::PacketFreeListTest()
+    : TestCase("PacketFreeListTest: ")
+{
+}
+
+void
+PacketFreeListTest::DoRun()
+{
+    // ATestTag<25> is too large to be stored inline by PacketTagList,
+    // but small enough for its TagData to be recycled
+    {
+        // make sure the free lists hold at least one entry
+        Ptr<Packet> p = Create<Packet>(10);
+        p->AddPacketTag(ATestTag<25>(1));
+    }
+
+    Packet::FreeListStats before = Packet::GetFreeListStats();
+    Ptr<Packet> p = Create<Packet>(10);
+    p->AddPacketTag(ATestTag<25>(2));
+    Packet::FreeListStats after = Packet::GetFreeListStats();
+    NS_TEST_EXPECT_MSG_EQ(after.packetHits, before.packetHits + 1, "packet not recycled");
+    NS_TEST_EXPECT_MSG_EQ(after.packetMisses, before.packetMisses, "packet allocated");
+    NS_TEST_EXPECT_MSG_EQ(after.packetTagHits, before.packetTagHits + 1, "tag not recycled");
+    NS_TEST_EXPECT_MSG_EQ(after.packetTagMisses, before.packetTagMisses, "tag allocated");
+
+    // copy-on-write: the copy shares the tag with the original
+    Ptr<Packet> copy = p->Copy();
+    ATestTag<25> tag;
+    NS_TEST_EXPECT_MSG_EQ(copy->RemovePacketTag(tag), true, "tag missing from copy");
+    NS_TEST_EXPECT_MSG_EQ(tag.GetData(), 2, "wrong tag in copy");
+    copy->AddPacketTag(ATestTag<25>(3));
+    NS_TEST_EXPECT_MSG_EQ(p->PeekPacketTag(tag), true, "tag missing from original");
+    NS_TEST_EXPECT_MSG_EQ(tag.GetData(), 2, "original tag modified through copy");
+
+    // recycling the original must not affect the copy
+    p = nullptr;
+    Ptr<Packet> other = Create<Packet>(20);
+    other->AddPacketTag(ATestTag<25>(4));
+    NS_TEST_EXPECT_MSG_EQ(copy->PeekPacketTag(tag), true, "tag missing from copy");
+    NS_TEST_EXPECT_MSG_EQ(tag.GetData(), 3, "copy tag overwritten by recycled storage");
+    NS_TEST_EXPECT_MSG_EQ(tag.m_error, false, "copy tag corrupted");
+    NS_TEST_EXPECT_MSG_EQ(copy->GetSize(), 10, "copy size changed");
+    NS_TEST_EXPECT_MSG_EQ(other->GetSize(), 20, "recycled packet has a wrong size");
+    NS_TEST_EXPECT_MSG_EQ(other->PeekPacketTag(tag), true, "tag missing from recycled packet");
+    NS_TEST_EXPECT_MSG_EQ(tag.GetData(), 4, "wrong tag in recycled packet");
+}
+
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * Packet Tag list inline storage unit tests.
+ *
+ * Checks that tags stored inline and tags stored in the TagData list
+ * behave the same, including when a tag moves from one to the other.
+ */
+class PacketTagListInlineTest : public TestCase
+{
+  public:
+    PacketTagListInlineTest();
+
+  private:
+    void DoRun() override;
+};
+
+PacketTagListInlineTest::PacketTagListInlineTest()
+    : TestCase("PacketTagListInlineTest: ")
+{
+}
+
+void
+PacketTagListInlineTest::DoRun()
+{
+    // more small tags than inline slots, plus a large one
+    Ptr<Packet> p = Create<Packet>(10);
+    p->AddPacketTag(ATestTag<1>(1));
+    p->AddPacketTag(ATestTag<2>(2));
+    p->AddPacketTag(ATestTag<30>(30));
+    p->AddPacketTag(ATestTag<3>(3));
+    p->AddPacketTag(ATestTag<4>(4));
+    p->AddPacketTag(ATestTag<5>(5));
+    p->AddPacketTag(ATestTag<6>(6));
+
+    uint32_t count = 0;
+    PacketTagIterator it = p->GetPacketTagIterator();
+    while (it.HasNext())
+    {
+        it.Next();
+        count++;
+    }
+    NS_TEST_EXPECT_MSG_EQ(count, 7, "iterator did not visit every tag");
+
+    // removing an inline tag frees a slot for the next small tag
+    Ptr<Packet> copy = p->Copy();
+    ATestTag<2> t2;
+    NS_TEST_EXPECT_MSG_EQ(copy->RemovePacketTag(t2), true, "inline tag not removed");
+    NS_TEST_EXPECT_MSG_EQ(t2.GetData(), 2, "wrong inline tag removed");
+    NS_TEST_EXPECT_MSG_EQ(copy->PeekPacketTag(t2), false, "inline tag still present");
+    NS_TEST_EXPECT_MSG_EQ(p->PeekPacketTag(t2), true, "inline tag removed from original");
+    copy->AddPacketTag(ATestTag<7>(7));
+
+    // tags too large to be stored inline, and replaced through copy-on-write
+    ATestTag<3> t3;
+    NS_TEST_EXPECT_MSG_EQ(copy->PeekPacketTag(t3), true, "inline tag missing");
+    ALargeTestTag large;
+    copy->AddPacketTag(large);
+    ATestTag<6> t6(60);
+    NS_TEST_EXPECT_MSG_EQ(copy->ReplacePacketTag(t6), true, "list tag not replaced");
+    NS_TEST_EXPECT_MSG_EQ(copy->PeekPacketTag(t6), true, "list tag missing");
+    NS_TEST_EXPECT_MSG_EQ(t6.GetData(), 60, "list tag not replaced");
+    NS_TEST_EXPECT_MSG_EQ(p->PeekPacketTag(t6), true, "list tag missing from original");
+    NS_TEST_EXPECT_MSG_EQ(t6.GetData(), 6, "list tag replaced in original");
+
+    // serialization round trip preserves every tag
+    uint32_t size = copy->GetSerializedSize();
+    std::vector<uint8_t> buffer(size);
+    NS_TEST_EXPECT_MSG_EQ(copy->Serialize(buffer.data(), size), 1, "serialization failed");
+    Ptr<Packet> deserialized = Create<Packet>(buffer.data(), size, true);
+    ATestTag<1> t1;
+    ATestTag<4> t4;
+    ATestTag<5> t5;
+    ATestTag<7> t7;
+    ATestTag<30> t30;
+    NS_TEST_EXPECT_MSG_EQ(deserialized->PeekPacketTag(t1), true, "tag lost");
+    NS_TEST_EXPECT_MSG_EQ(t1.GetData(), 1, "tag corrupted");
+    NS_TEST_EXPECT_MSG_EQ(deserialized->PeekPacketTag(t2), false, "removed tag restored");
+    NS_TEST_EXPECT_MSG_EQ(deserialized->PeekPacketTag(t3), true, "tag lost");
+    NS_TEST_EXPECT_MSG_EQ(deserialized->PeekPacketTag(t4), true, "tag lost");
+    NS_TEST_EXPECT_MSG_EQ(deserialized->PeekPacketTag(t5), true, "tag lost");
+    NS_TEST_EXPECT_MSG_EQ(deserialized->PeekPacketTag(t6), true, "tag lost");
+    NS_TEST_EXPECT_MSG_EQ(t6.GetData(), 60, "tag corrupted");
+    NS_TEST_EXPECT_MSG_EQ(deserialized->PeekPacketTag(t7), true, "tag lost");
+    NS_TEST_EXPECT_MSG_EQ(t7.GetData(), 7, "tag corrupted");
+    NS_TEST_EXPECT_MSG_EQ(deserialized->PeekPacketTag(t30), true, "tag lost");
+    NS_TEST_EXPECT_MSG_EQ(t30.m_error, false, "tag corrupted");
+    NS_TEST_EXPECT_MSG_EQ(deserialized->PeekPacketTag(large), true, "tag lost");
+
+    deserialized->RemoveAllPacketTags();
+    NS_TEST_EXPECT_MSG_EQ(deserialized->GetPacketTagIterator().HasNext(),
+                          false,
+                          "tags left after RemoveAllPacketTags");
+    NS_TEST_EXPECT_MSG_EQ(copy->PeekPacketTag(t1), true, "tag removed from copy");
+}
+
 /**
  * @ingroup network-test
  * @ingroup tests
@@ -1274,6 +1437,8 @@ PacketTestSuite::PacketTestSuite()
 {
     AddTestCase(new PacketTest, TestCase::Duration::QUICK);
     AddTestCase(new PacketTagListTest, TestCase::Duration::QUICK);
+    AddTestCase(new PacketFreeListTest, TestCase::Duration::QUICK);
+    AddTestCase(new PacketTagListInlineTest, TestCase::Duration::QUICK);
 }
 
 static PacketTestSuite g_packetTestSuite; //!< Static variable for test initialization
@@ -4,15 +4,25 @@
  * Author:  Craig Dowell (craigdo@ee.washington.edu)
  */
 
+#include "ns3/boolean.h"
 #include "ns3/log.h"
+#include "ns3/packet.h"
+#include "ns3/pcap-file-wrapper.h"
 #include "ns3/pcap-file.h"
+#include "ns3/pcapng-file.h"
+#include "ns3/simulator.h"
 #include "ns3/test.h"
+#include "ns3/trace-helper.h"
+#include "ns3/uinteger.h"
 
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <fstream>
 #include <iostream>
+#include <iterator>
 #include <sstream>
+#include <vector>
 
 using namespace ns3;
 
@@ -1364,6 +1374,325 @@ DiffTestCase::DoRun()
     NS_TEST_EXPECT_MSG_EQ(usec, 3696, "Files are different from 2.3696 seconds");
 }
 
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * @brief Test case to make sure that a pcap file written through a write
+ * buffer is identical to the same file written synchronously.
+ */
+class WriteBufferTestCase : public TestCase
+{
+  public:
+    WriteBufferTestCase();
+
+  private:
+    void DoRun() override;
+    /**
+     * Write the known packets to a file.
+     * @param filename The file name.
+     * @param bufferSize The size of the write buffer, zero if unbuffered.
+     */
+    void WriteKnownPackets(const std::string& filename, uint32_t bufferSize);
+    /**
+     * Write packets through a buffered PcapFileWrapper, re-opened once, destroy
+     * the simulator without flushing the wrapper, and read the file back.
+     * @param keepWrapper Whether the wrapper is still referenced when the
+     * simulator is destroyed.
+     */
+    void CheckFlushOnDestroy(bool keepWrapper);
+};
+
+WriteBufferTestCase::WriteBufferTestCase()
+    : TestCase("Check that PcapFile::SetWriteBufferSize does not change the file content")
+{
+}
+
+void
+WriteBufferTestCase::WriteKnownPackets(const std::string& filename, uint32_t bufferSize)
+{
+    PcapFile f;
+    f.Open(filename, std::ios::out);
+    NS_TEST_ASSERT_MSG_EQ(f.Fail(),
+                          false,
+                          "Open (" << filename << ", \"std::ios::out\") returns error");
+    f.SetWriteBufferSize(bufferSize);
+    f.Init(1, N_PACKET_BYTES);
+    NS_TEST_ASSERT_MSG_EQ(f.Fail(), false, "Init (1, " << N_PACKET_BYTES << ") returns error");
+
+    for (uint32_t rep = 0; rep < 100; ++rep)
+    {
+        for (uint32_t i = 0; i < N_KNOWN_PACKETS; ++i)
+        {
+            const PacketEntry& p = knownPackets[i];
+            f.Write(p.tsSec + rep, p.tsUsec, (const uint8_t*)p.data, p.origLen);
+        }
+        NS_TEST_EXPECT_MSG_EQ(f.Fail(), false, "Write must not fail");
+    }
+    f.Close();
+}
+
+void
+WriteBufferTestCase::CheckFlushOnDestroy(bool keepWrapper)
+{
+    std::string filename = CreateTempDirFilename("destroyed.pcap");
+    Ptr<PcapFileWrapper> wrapper =
+        CreateObjectWithAttributes<PcapFileWrapper>("WriteBufferSize", UintegerValue(1 << 20));
+    // re-opening the file registers a single flush, which does not keep the wrapper alive
+    wrapper->Open(filename, std::ios::out);
+    wrapper->Close();
+    wrapper->Open(filename, std::ios::out);
+    NS_TEST_ASSERT_MSG_EQ(wrapper->Fail(), false, "Open (" << filename << ") returns error");
+    NS_TEST_EXPECT_MSG_EQ(wrapper->GetReferenceCount(),
+                          1,
+                          "The flush at Simulator::Destroy must not reference the wrapper");
+    wrapper->Init(1, N_PACKET_BYTES);
+    for (uint32_t i = 0; i < N_KNOWN_PACKETS; ++i)
+    {
+        const PacketEntry& p = knownPackets[i];
+        wrapper->Write(Seconds(p.tsSec) + MicroSeconds(p.tsUsec),
+                       (const uint8_t*)p.data,
+                       p.origLen);
+    }
+    if (!keepWrapper)
+    {
+        wrapper = nullptr;
+    }
+    // the records fit in the write buffer, only the simulator destruction writes them
+    Simulator::Destroy();
+
+    PcapFile f;
+    f.Open(filename, std::ios::in);
+    NS_TEST_ASSERT_MSG_EQ(f.Fail(), false, "Open (" << filename << ") returns error");
+    uint8_t data[N_PACKET_BYTES];
+    uint32_t tsSec;
+    uint32_t tsUsec;
+    uint32_t inclLen;
+    uint32_t origLen;
+    uint32_t readLen;
+    for (uint32_t i = 0; i < N_KNOWN_PACKETS; ++i)
+    {
+        const PacketEntry& p = knownPackets[i];
+        f.Read(data, sizeof(data), tsSec, tsUsec, inclLen, origLen, readLen);
+        NS_TEST_ASSERT_MSG_EQ(f.Fail(), false, "Record " << i << " is missing");
+        NS_TEST_EXPECT_MSG_EQ(tsSec, p.tsSec, "Wrong seconds of record " << i);
+        NS_TEST_EXPECT_MSG_EQ(tsUsec, p.tsUsec, "Wrong microseconds of record " << i);
+        NS_TEST_EXPECT_MSG_EQ(origLen, p.origLen, "Wrong length of record " << i);
+    }
+    f.Read(data, sizeof(data), tsSec, tsUsec, inclLen, origLen, readLen);
+    NS_TEST_EXPECT_MSG_EQ(f.Eof(), true, "Unexpected record at the end of the file");
+    f.Close();
+    wrapper = nullptr;
+    remove(filename.c_str());
+}
+
+void
+WriteBufferTestCase::DoRun()
+{
+    std::string reference = CreateTempDirFilename("unbuffered.pcap");
+    WriteKnownPackets(reference, 0);
+    std::ifstream in(reference, std::ios::binary);
+    std::string expected((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+
+    // smaller than a record, a few records, larger than the file
+    for (uint32_t bufferSize : {1, 100, 1 << 20})
+    {
+        std::string filename = CreateTempDirFilename("buffered.pcap");
+        WriteKnownPackets(filename, bufferSize);
+        std::ifstream in(filename, std::ios::binary);
+        std::string actual((std::istreambuf_iterator<char>(in)),
+                           std::istreambuf_iterator<char>());
+        NS_TEST_EXPECT_MSG_EQ(actual.size(),
+                              expected.size(),
+                              "Wrong file size with a buffer of " << bufferSize << " bytes");
+        NS_TEST_EXPECT_MSG_EQ((actual == expected),
+                              true,
+                              "Wrong file content with a buffer of " << bufferSize << " bytes");
+        in.close();
+        remove(filename.c_str());
+    }
+    remove(reference.c_str());
+
+    CheckFlushOnDestroy(true);
+    CheckFlushOnDestroy(false);
+}
+
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * @brief Test case to make sure that PcapngFile writes well-formed blocks,
+ * and that PcapHelper gathers the pcap files of several devices in it.
+ */
+class PcapngTestCase : public TestCase
+{
+  public:
+    PcapngTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * @brief A block read back from a pcapng file.
+     */
+    struct Block
+    {
+        uint32_t type;             //!< the block type
+        std::vector<uint8_t> body; //!< the block content, without type and lengths
+    };
+
+    /**
+     * Read all the blocks of a pcapng file.
+     * @param filename The file name.
+     * @returns the blocks
+     */
+    std::vector<Block> ReadBlocks(const std::string& filename);
+    /**
+     * Check the blocks of a file written with a given write buffer size.
+     * @param bufferSize The size of the write buffer, zero if unbuffered.
+     */
+    void CheckFile(uint32_t bufferSize);
+};
+
+PcapngTestCase::PcapngTestCase()
+    : TestCase("Check the pcapng file writer")
+{
+}
+
+std::vector<PcapngTestCase::Block>
+PcapngTestCase::ReadBlocks(const std::string& filename)
+{
+    std::vector<Block> blocks;
+    std::ifstream in(filename, std::ios::binary);
+    uint32_t type;
+    uint32_t length;
+    while (in.read((char*)&type, sizeof(type)) && in.read((char*)&length, sizeof(length)))
+    {
+        NS_TEST_EXPECT_MSG_EQ(length % 4, 0, "Block length must be a multiple of 4");
+        Block block{type, std::vector<uint8_t>(length - 12)};
+        in.read((char*)block.body.data(), block.body.size());
+        uint32_t trailer = 0;
+        in.read((char*)&trailer, sizeof(trailer));
+        NS_TEST_EXPECT_MSG_EQ(trailer, length, "Block lengths must match");
+        blocks.push_back(block);
+    }
+    return blocks;
+}
+
+void
+PcapngTestCase::CheckFile(uint32_t bufferSize)
+{
+    std::string filename = CreateTempDirFilename("merged.pcapng");
+    Ptr<PcapngFile> file = CreateObjectWithAttributes<PcapngFile>("WriteBufferSize",
+                                                                  UintegerValue(bufferSize),
+                                                                  "PacketComments",
+                                                                  BooleanValue(true));
+    file->Open(filename);
+    NS_TEST_ASSERT_MSG_EQ(file->Fail(), false, "Open (" << filename << ") returns error");
+    uint32_t eth = file->AddInterface("0-0", 1, 65535);
+    uint32_t ppp = file->AddInterface("1-0", 9, 8);
+    NS_TEST_EXPECT_MSG_EQ(file->GetNInterfaces(), 2, "Wrong number of interfaces");
+
+    uint8_t data[N_PACKET_BYTES];
+    for (uint32_t i = 0; i < N_PACKET_BYTES; ++i)
+    {
+        data[i] = i;
+    }
+    file->Write(eth, NanoSeconds(5000000001ULL), data, 13);
+    file->Write(ppp, MicroSeconds(3), Create<Packet>(data, N_PACKET_BYTES));
+    // the flush registered with the simulator must not keep the file alive
+    NS_TEST_EXPECT_MSG_EQ(file->GetReferenceCount(), 1, "The flush hook must not own the file");
+    file->Close();
+
+    std::vector<Block> blocks = ReadBlocks(filename);
+    NS_TEST_ASSERT_MSG_EQ(blocks.size(), 5, "Expected SHB, 2 IDB, 2 EPB");
+    NS_TEST_EXPECT_MSG_EQ(blocks[0].type, 0x0A0D0D0A, "Expected a section header block");
+    uint32_t magic;
+    std::memcpy(&magic, blocks[0].body.data(), sizeof(magic));
+    NS_TEST_EXPECT_MSG_EQ(magic, 0x1A2B3C4D, "Wrong byte-order magic");
+    NS_TEST_EXPECT_MSG_EQ(blocks[1].type, 1, "Expected an interface description block");
+    NS_TEST_EXPECT_MSG_EQ(blocks[2].type, 1, "Expected an interface description block");
+    uint16_t linkType;
+    std::memcpy(&linkType, blocks[2].body.data(), sizeof(linkType));
+    NS_TEST_EXPECT_MSG_EQ(linkType, 9, "Wrong data link type");
+
+    // interface id, timestamp (high, low), captured length, original length
+    uint32_t epb[5];
+    NS_TEST_EXPECT_MSG_EQ(blocks[3].type, 6, "Expected an enhanced packet block");
+    std::memcpy(epb, blocks[3].body.data(), sizeof(epb));
+    NS_TEST_EXPECT_MSG_EQ(epb[0], eth, "Wrong interface id");
+    NS_TEST_EXPECT_MSG_EQ(((uint64_t)epb[1] << 32) + epb[2], 5000000001ULL, "Wrong timestamp");
+    NS_TEST_EXPECT_MSG_EQ(epb[3], 13, "Wrong captured length");
+    NS_TEST_EXPECT_MSG_EQ(epb[4], 13, "Wrong original length");
+    NS_TEST_EXPECT_MSG_EQ(std::memcmp(blocks[3].body.data() + sizeof(epb), data, 13),
+                          0,
+                          "Wrong packet data");
+    std::string comment = "interface 0-0, context none";
+    std::string options((char*)blocks[3].body.data() + sizeof(epb) + 16,
+                        blocks[3].body.size() - sizeof(epb) - 16);
+    NS_TEST_EXPECT_MSG_NE(options.find(comment), std::string::npos, "Missing packet comment");
+
+    NS_TEST_EXPECT_MSG_EQ(blocks[4].type, 6, "Expected an enhanced packet block");
+    std::memcpy(epb, blocks[4].body.data(), sizeof(epb));
+    NS_TEST_EXPECT_MSG_EQ(epb[0], ppp, "Wrong interface id");
+    NS_TEST_EXPECT_MSG_EQ(((uint64_t)epb[1] << 32) + epb[2], 3000, "Wrong timestamp");
+    NS_TEST_EXPECT_MSG_EQ(epb[3], 8, "Captured length must be limited by the snaplen");
+    NS_TEST_EXPECT_MSG_EQ(epb[4], N_PACKET_BYTES, "Wrong original length");
+    remove(filename.c_str());
+}
+
+void
+PcapngTestCase::DoRun()
+{
+    CheckFile(0);
+    CheckFile(7);
+    CheckFile(1 << 16);
+
+    // the pcap files created by the helpers are gathered in the pcapng file
+    std::string filename = CreateTempDirFilename("helper.pcapng");
+    std::string prefix = CreateTempDirFilename("helper");
+    PcapHelper pcapHelper;
+    Ptr<PcapngFile> pcapng = pcapHelper.CreatePcapngFile(filename);
+    NS_TEST_EXPECT_MSG_EQ(pcapHelper.CreatePcapngFile(filename),
+                          pcapng,
+                          "The same file must be returned");
+    PcapHelper::SetPcapngFile(pcapng, prefix);
+    Ptr<PcapFileWrapper> first =
+        pcapHelper.CreateFile(prefix + "-0-1.pcap", std::ios::out, PcapHelper::DLT_EN10MB);
+    Ptr<PcapFileWrapper> second =
+        pcapHelper.CreateFile(prefix + "-1-1.pcap", std::ios::out, PcapHelper::DLT_PPP);
+    PcapHelper::SetPcapngFile(nullptr);
+    uint8_t data[N_PACKET_BYTES] = {};
+    // once the pcapng file is unset, pcap files are created again, whatever their name
+    std::string unrelatedFilename = CreateTempDirFilename("pcapng:helper-2-1.pcap");
+    Ptr<PcapFileWrapper> unrelated =
+        pcapHelper.CreateFile(unrelatedFilename, std::ios::out, PcapHelper::DLT_PPP);
+    first->Write(Seconds(1), data, N_PACKET_BYTES);
+    second->Write(Seconds(2), data, N_PACKET_BYTES);
+    unrelated->Write(Seconds(3), data, N_PACKET_BYTES);
+    pcapng = nullptr;
+    first = nullptr;
+    second = nullptr;
+    unrelated = nullptr;
+    Simulator::Destroy();
+
+    PcapFile unrelatedFile;
+    unrelatedFile.Open(unrelatedFilename, std::ios::in);
+    NS_TEST_EXPECT_MSG_EQ(unrelatedFile.Fail(),
+                          false,
+                          "The pcap file " << unrelatedFilename << " must be created");
+    NS_TEST_EXPECT_MSG_EQ(unrelatedFile.GetDataLinkType(), PcapHelper::DLT_PPP, "Wrong link type");
+    unrelatedFile.Close();
+    remove(unrelatedFilename.c_str());
+
+    std::vector<Block> blocks = ReadBlocks(filename);
+    NS_TEST_ASSERT_MSG_EQ(blocks.size(), 5, "Expected SHB, 2 IDB, 2 EPB");
+    std::string name((char*)blocks[2].body.data() + 8 + 4, 3);
+    NS_TEST_EXPECT_MSG_EQ(name, "1-1", "Wrong interface name");
+    remove(filename.c_str());
+}
+
 /**
  * @ingroup network-test
  * @ingroup tests
@@ -1387,6 +1716,8 @@ PcapFileTestSuite::PcapFileTestSuite()
     AddTestCase(new RecordHeaderTestCase, TestCase::Duration::QUICK);
     AddTestCase(new ReadFileTestCase, TestCase::Duration::QUICK);
     AddTestCase(new DiffTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new WriteBufferTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new PcapngTestCase, TestCase::Duration::QUICK);
 }
 
 static PcapFileTestSuite pcapFileTestSuite; //!< Static variable for test initialization
@@ -0,0 +1,317 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/data-rate.h"
+#include "ns3/ethernet-header.h"
+#include "ns3/mapped-pcap-file.h"
+#include "ns3/node.h"
+#include "ns3/packet.h"
+#include "ns3/pcap-file.h"
+#include "ns3/pcap-replay-application.h"
+#include "ns3/simple-channel.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * @brief MappedPcapFile must read the records written by PcapFile.
+ */
+class MappedPcapFileTest : public TestCase
+{
+  public:
+    MappedPcapFileTest();
+
+  private:
+    void DoRun() override;
+    /**
+     * Write a file with PcapFile and check it with MappedPcapFile.
+     * @param swapMode Whether the file byte order is swapped.
+     * @param nanosecMode Whether timestamps are in nanoseconds.
+     */
+    void CheckFile(bool swapMode, bool nanosecMode);
+};
+
+MappedPcapFileTest::MappedPcapFileTest()
+    : TestCase("Check that MappedPcapFile reads the records written by PcapFile")
+{
+}
+
+void
+MappedPcapFileTest::CheckFile(bool swapMode, bool nanosecMode)
+{
+    std::string filename = CreateTempDirFilename("mapped.pcap");
+    const uint32_t nPackets = 10;
+    const uint32_t snapLen = 100;
+    {
+        PcapFile f;
+        f.Open(filename, std::ios::out);
+        f.Init(1, snapLen, PcapFile::ZONE_DEFAULT, swapMode, nanosecMode);
+        std::vector<uint8_t> data(200);
+        for (uint32_t i = 0; i < nPackets; ++i)
+        {
+            data[0] = i;
+            f.Write(i, i * 1000, data.data(), 20 * i);
+        }
+        f.Close();
+    }
+
+    MappedPcapFile file;
+    file.Open(filename);
+    NS_TEST_ASSERT_MSG_EQ(file.Fail(), false, "Open (" << filename << ") returns error");
+    NS_TEST_EXPECT_MSG_EQ(file.GetDataLinkType(), 1, "Wrong data link type");
+    NS_TEST_EXPECT_MSG_EQ(file.GetSnapLen(), snapLen, "Wrong snap length");
+    NS_TEST_EXPECT_MSG_EQ(file.GetSwapMode(), swapMode, "Wrong swap mode");
+    NS_TEST_EXPECT_MSG_EQ(file.IsNanoSecMode(), nanosecMode, "Wrong nanosecond mode");
+
+    uint32_t i = 0;
+    for (const auto& record : file)
+    {
+        NS_TEST_EXPECT_MSG_EQ(record.tsSec, i, "Wrong timestamp");
+        NS_TEST_EXPECT_MSG_EQ(record.tsSubSec, i * 1000, "Wrong timestamp");
+        NS_TEST_EXPECT_MSG_EQ(record.origLen, 20 * i, "Wrong original length");
+        NS_TEST_EXPECT_MSG_EQ(record.inclLen, std::min(20 * i, snapLen), "Wrong included length");
+        Time expected = nanosecMode ? Seconds(i) + NanoSeconds(i * 1000)
+                                    : Seconds(i) + MicroSeconds(i * 1000);
+        NS_TEST_EXPECT_MSG_EQ(record.time, expected, "Wrong time");
+        if (record.inclLen > 0)
+        {
+            NS_TEST_EXPECT_MSG_EQ((uint32_t)record.data[0], i, "Wrong data");
+        }
+        NS_TEST_EXPECT_MSG_EQ(record.CreatePacket()->GetSize(), 20 * i, "Wrong packet size");
+        ++i;
+    }
+    NS_TEST_EXPECT_MSG_EQ(i, nPackets, "Wrong number of records");
+    NS_TEST_EXPECT_MSG_EQ(file.IsTruncated(), false, "File is not truncated");
+    std::size_t size = file.GetSize();
+    file.Close();
+
+    // a truncated last record ends the iteration
+    std::vector<char> content(size);
+    {
+        std::ifstream in(filename, std::ios::binary);
+        in.read(content.data(), size);
+    }
+    {
+        std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+        out.write(content.data(), size - 5);
+    }
+    file.Open(filename);
+    NS_TEST_ASSERT_MSG_EQ(file.Fail(), false, "Open (" << filename << ") returns error");
+    i = 0;
+    for (auto it = file.begin(); it != file.end(); ++it)
+    {
+        ++i;
+    }
+    NS_TEST_EXPECT_MSG_EQ(i, nPackets - 1, "The truncated record must not be returned");
+    NS_TEST_EXPECT_MSG_EQ(file.IsTruncated(), true, "File is truncated");
+    file.Close();
+    remove(filename.c_str());
+}
+
+void
+MappedPcapFileTest::DoRun()
+{
+    CheckFile(false, false);
+    CheckFile(true, false);
+    CheckFile(false, true);
+    CheckFile(true, true);
+
+    MappedPcapFile file;
+    file.Open(CreateTempDirFilename("does-not-exist.pcap"));
+    NS_TEST_EXPECT_MSG_EQ(file.Fail(), true, "Opening a missing file must fail");
+    NS_TEST_EXPECT_MSG_EQ((file.begin() == file.end()), true, "A failed file has no record");
+}
+
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * @brief PcapReplayApplication must send the packets of a capture to a device.
+ */
+class PcapReplayApplicationTest : public TestCase
+{
+  public:
+    PcapReplayApplicationTest();
+
+  private:
+    void DoRun() override;
+    /**
+     * Replay a capture.
+     * @param filename The capture.
+     * @param rate The replay rate, zero to follow the timestamps.
+     */
+    void Replay(const std::string& filename, DataRate rate);
+    /**
+     * Receive a packet.
+     * @param device The receiving device.
+     * @param packet The packet.
+     * @param protocol The protocol number.
+     * @param from The sender address.
+     * @return true
+     */
+    bool Receive(Ptr<NetDevice> device,
+                 Ptr<const Packet> packet,
+                 uint16_t protocol,
+                 const Address& from);
+
+    std::vector<Time> m_rxTimes;     //!< reception times
+    std::vector<uint32_t> m_rxSizes; //!< received packet sizes
+    uint16_t m_rxProtocol;           //!< last received protocol number
+};
+
+PcapReplayApplicationTest::PcapReplayApplicationTest()
+    : TestCase("Check that PcapReplayApplication replays a capture"),
+      m_rxProtocol(0)
+{
+}
+
+bool
+PcapReplayApplicationTest::Receive(Ptr<NetDevice> device,
+                                   Ptr<const Packet> packet,
+                                   uint16_t protocol,
+                                   const Address& from)
+{
+    m_rxTimes.push_back(Simulator::Now());
+    m_rxSizes.push_back(packet->GetSize());
+    m_rxProtocol = protocol;
+    return true;
+}
+
+void
+PcapReplayApplicationTest::Replay(const std::string& filename, DataRate rate)
+{
+    m_rxTimes.clear();
+    m_rxSizes.clear();
+
+    Ptr<Node> txNode = CreateObject<Node>();
+    Ptr<Node> rxNode = CreateObject<Node>();
+    Ptr<SimpleChannel> channel = CreateObject<SimpleChannel>();
+    Ptr<SimpleNetDevice> txDev = CreateObject<SimpleNetDevice>();
+    Ptr<SimpleNetDevice> rxDev = CreateObject<SimpleNetDevice>();
+    txDev->SetAddress(Mac48Address("00:00:00:00:00:01"));
+    rxDev->SetAddress(Mac48Address("00:00:00:00:00:02"));
+    txNode->AddDevice(txDev);
+    rxNode->AddDevice(rxDev);
+    txDev->SetChannel(channel);
+    rxDev->SetChannel(channel);
+    rxDev->SetReceiveCallback(MakeCallback(&PcapReplayApplicationTest::Receive, this));
+
+    Ptr<PcapReplayApplication> app = CreateObject<PcapReplayApplication>();
+    app->SetAttribute("Filename", StringValue(filename));
+    app->SetAttribute("DataRate", DataRateValue(rate));
+    app->SetDevice(txDev);
+    app->SetStartTime(Seconds(10));
+    txNode->AddApplication(app);
+
+    Simulator::Run();
+    Simulator::Destroy();
+}
+
+void
+PcapReplayApplicationTest::DoRun()
+{
+    std::string filename = CreateTempDirFilename("replay.pcap");
+    {
+        PcapFile f;
+        f.Open(filename, std::ios::out);
+        f.Init(1, 65535);
+        EthernetHeader header(false);
+        header.SetSource(Mac48Address("00:00:00:00:00:01"));
+        header.SetDestination(Mac48Address("00:00:00:00:00:02"));
+        header.SetLengthType(0x0800);
+        f.Write(1, 0, header, Create<Packet>(986));
+        f.Write(1, 500000, header, Create<Packet>(486));
+        f.Write(3, 0, header, Create<Packet>(986));
+        f.Close();
+    }
+
+    // follow the capture timestamps
+    Replay(filename, DataRate(0));
+    NS_TEST_ASSERT_MSG_EQ(m_rxTimes.size(), 3, "Wrong number of packets received");
+    NS_TEST_EXPECT_MSG_EQ(m_rxTimes[0], Seconds(10), "Wrong reception time");
+    NS_TEST_EXPECT_MSG_EQ(m_rxTimes[1], Seconds(10.5), "Wrong reception time");
+    NS_TEST_EXPECT_MSG_EQ(m_rxTimes[2], Seconds(12), "Wrong reception time");
+    NS_TEST_EXPECT_MSG_EQ(m_rxSizes[1], 486, "The Ethernet header must be removed");
+    NS_TEST_EXPECT_MSG_EQ(m_rxProtocol, 0x0800, "Wrong protocol number");
+
+    // back to back at 8 Mbps: 1000 bytes every ms, 500 bytes every 0.5 ms
+    Replay(filename, DataRate("8Mbps"));
+    NS_TEST_ASSERT_MSG_EQ(m_rxTimes.size(), 3, "Wrong number of packets received");
+    NS_TEST_EXPECT_MSG_EQ(m_rxTimes[0], Seconds(10), "Wrong reception time");
+    NS_TEST_EXPECT_MSG_EQ(m_rxTimes[1], Seconds(10) + MicroSeconds(1000), "Wrong reception time");
+    NS_TEST_EXPECT_MSG_EQ(m_rxTimes[2], Seconds(10) + MicroSeconds(1500), "Wrong reception time");
+
+    remove(filename.c_str());
+
+    // an 802.3 frame too short for an LLC/SNAP header cannot be decoded
+    {
+        PcapFile f;
+        f.Open(filename, std::ios::out);
+        f.Init(1, 65535);
+        EthernetHeader header(false);
+        header.SetSource(Mac48Address("00:00:00:00:00:01"));
+        header.SetDestination(Mac48Address("00:00:00:00:00:02"));
+        header.SetLengthType(4);
+        f.Write(1, 0, header, Create<Packet>(4));
+        header.SetLengthType(0x0800);
+        f.Write(2, 0, header, Create<Packet>(100));
+        f.Close();
+    }
+    Replay(filename, DataRate(0));
+    NS_TEST_ASSERT_MSG_EQ(m_rxTimes.size(), 1, "The short 802.3 frame must not be sent");
+    NS_TEST_EXPECT_MSG_EQ(m_rxTimes[0], Seconds(11), "Wrong reception time");
+    remove(filename.c_str());
+
+    // PPP captures with and without the address and control fields
+    {
+        PcapFile f;
+        f.Open(filename, std::ios::out);
+        f.Init(9, 65535);
+        std::vector<uint8_t> data(104);
+        data[0] = 0xff;
+        data[1] = 0x03;
+        data[2] = 0x00;
+        data[3] = 0x21;
+        f.Write(1, 0, data.data(), data.size());
+        f.Write(2, 0, data.data() + 2, data.size() - 2);
+        f.Close();
+    }
+    Replay(filename, DataRate(0));
+    NS_TEST_ASSERT_MSG_EQ(m_rxTimes.size(), 2, "Wrong number of PPP packets received");
+    NS_TEST_EXPECT_MSG_EQ(m_rxSizes[0],
+                          100,
+                          "The PPP address, control and protocol fields must be removed");
+    NS_TEST_EXPECT_MSG_EQ(m_rxSizes[1], 100, "The PPP protocol field must be removed");
+    NS_TEST_EXPECT_MSG_EQ(m_rxProtocol, 0x0800, "Wrong protocol number");
+    remove(filename.c_str());
+}
+
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * @brief Mapped pcap file and replay application TestSuite
+ */
+class PcapReplayTestSuite : public TestSuite
+{
+  public:
+    PcapReplayTestSuite()
+        : TestSuite("pcap-replay", Type::UNIT)
+    {
+        AddTestCase(new MappedPcapFileTest, TestCase::Duration::QUICK);
+        AddTestCase(new PcapReplayApplicationTest, TestCase::Duration::QUICK);
+    }
+};
+
+static PcapReplayTestSuite g_pcapReplayTestSuite; //!< Static variable for test initialization
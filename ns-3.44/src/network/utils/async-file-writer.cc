@@ -0,0 +1,290 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "async-file-writer.h"
+
+#include "ns3/assert.h"
+#include "ns3/global-value.h"
+#include "ns3/log.h"
+#include "ns3/uinteger.h"
+
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("AsyncFileWriter");
+
+/**
+ * @ingroup network
+ * @anchor GlobalValueAsyncFileWriterMemoryBudget
+ * @brief Maximum amount of memory held by the buffers waiting for the
+ * AsyncFileWriter I/O thread.
+ */
+static GlobalValue g_asyncFileWriterMemoryBudget =
+    GlobalValue("AsyncFileWriterMemoryBudget",
+                "The maximum number of bytes held by the buffers waiting to be "
+                "written by the AsyncFileWriter I/O thread",
+                UintegerValue(64 * 1024 * 1024),
+                MakeUintegerChecker<uint64_t>());
+
+/**
+ * @ingroup network
+ *
+ * @brief The I/O thread shared by all the AsyncFileWriter instances.
+ *
+ * The thread is started when the first AsyncFileWriter is created, and
+ * stopped when the last one is destroyed.
+ */
+class AsyncFileWriterThread
+{
+  public:
+    /**
+     * @returns the unique instance
+     */
+    static AsyncFileWriterThread& Get();
+
+    /**
+     * Destructor.  Stops the thread if some writers were never destroyed.
+     */
+    ~AsyncFileWriterThread();
+
+    /**
+     * @brief Register a new writer, starting the thread if needed.
+     */
+    void Attach();
+    /**
+     * @brief Unregister a writer, stopping the thread if it was the last one.
+     */
+    void Detach();
+    /**
+     * @brief Queue a buffer for writing, waiting for the memory budget.
+     *
+     * @param writer the writer the buffer belongs to
+     * @param data the buffer; replaced by an empty buffer
+     */
+    void Submit(AsyncFileWriter* writer, std::vector<uint8_t>& data);
+    /**
+     * @brief Wait until all the buffers of a writer have been written.
+     *
+     * @param writer the writer
+     */
+    void Wait(AsyncFileWriter* writer);
+
+  private:
+    /**
+     * @brief Main loop of the I/O thread.
+     */
+    void Run();
+
+    /**
+     * @brief A buffer waiting to be written.
+     */
+    struct Job
+    {
+        AsyncFileWriter* writer;   //!< the writer the buffer belongs to
+        std::vector<uint8_t> data; //!< the buffer
+    };
+
+    std::mutex m_mutex;                         //!< protects the members below
+    std::condition_variable m_jobReady;         //!< signaled when a job is queued
+    std::condition_variable m_jobDone;          //!< signaled when a job is written
+    std::deque<Job> m_jobs;                     //!< the buffers waiting to be written
+    std::vector<std::vector<uint8_t>> m_spares; //!< written buffers, for reuse
+    uint64_t m_queuedBytes{0};                  //!< bytes held by m_jobs
+    uint32_t m_nWriters{0};                     //!< number of registered writers
+    bool m_stop{false};                         //!< whether the thread must stop
+    std::thread m_thread;                       //!< the I/O thread
+};
+
+AsyncFileWriterThread&
+AsyncFileWriterThread::Get()
+{
+    static AsyncFileWriterThread instance;
+    return instance;
+}
+
+AsyncFileWriterThread::~AsyncFileWriterThread()
+{
+    if (m_thread.joinable())
+    {
+        {
+            std::unique_lock lock(m_mutex);
+            m_stop = true;
+        }
+        m_jobReady.notify_one();
+        m_thread.join();
+    }
+}
+
+void
+AsyncFileWriterThread::Attach()
+{
+    std::unique_lock lock(m_mutex);
+    if (m_nWriters++ == 0)
+    {
+        NS_LOG_LOGIC("starting I/O thread");
+        m_stop = false;
+        m_thread = std::thread(&AsyncFileWriterThread::Run, this);
+    }
+}
+
+void
+AsyncFileWriterThread::Detach()
+{
+    std::unique_lock lock(m_mutex);
+    NS_ASSERT(m_nWriters > 0);
+    if (--m_nWriters == 0)
+    {
+        NS_LOG_LOGIC("stopping I/O thread");
+        m_stop = true;
+        lock.unlock();
+        m_jobReady.notify_one();
+        m_thread.join();
+        lock.lock();
+        m_spares.clear();
+    }
+}
+
+void
+AsyncFileWriterThread::Submit(AsyncFileWriter* writer, std::vector<uint8_t>& data)
+{
+    UintegerValue budget;
+    g_asyncFileWriterMemoryBudget.GetValue(budget);
+
+    std::unique_lock lock(m_mutex);
+    // an empty queue always accepts a buffer, whatever its size
+    m_jobDone.wait(lock, [&] {
+        return m_queuedBytes == 0 || m_queuedBytes + data.size() <= budget.Get();
+    });
+    m_queuedBytes += data.size();
+    writer->m_pending++;
+    m_jobs.push_back({writer, std::move(data)});
+    if (!m_spares.empty())
+    {
+        data = std::move(m_spares.back());
+        m_spares.pop_back();
+    }
+    else
+    {
+        data = std::vector<uint8_t>();
+    }
+    lock.unlock();
+    m_jobReady.notify_one();
+}
+
+void
+AsyncFileWriterThread::Wait(AsyncFileWriter* writer)
+{
+    std::unique_lock lock(m_mutex);
+    m_jobDone.wait(lock, [writer] { return writer->m_pending == 0; });
+}
+
+void
+AsyncFileWriterThread::Run()
+{
+    std::unique_lock lock(m_mutex);
+    while (true)
+    {
+        m_jobReady.wait(lock, [this] { return m_stop || !m_jobs.empty(); });
+        if (m_jobs.empty())
+        {
+            // stopping: every queued buffer has been written
+            return;
+        }
+        Job job = std::move(m_jobs.front());
+        m_jobs.pop_front();
+        lock.unlock();
+
+        // no logging here: the ns-3 logging system is not thread safe
+        job.writer->m_stream->write(reinterpret_cast<const char*>(job.data.data()),
+                                    job.data.size());
+        if (job.writer->m_stream->fail())
+        {
+            job.writer->m_failed = true;
+        }
+
+        lock.lock();
+        m_queuedBytes -= job.data.size();
+        job.writer->m_pending--;
+        job.data.clear();
+        m_spares.push_back(std::move(job.data));
+        lock.unlock();
+        m_jobDone.notify_all();
+        lock.lock();
+    }
+}
+
+AsyncFileWriter::AsyncFileWriter(std::ostream* stream, uint32_t bufferSize)
+    : m_stream(stream),
+      m_bufferSize(bufferSize),
+      m_pending(0),
+      m_failed(false)
+{
+    NS_LOG_FUNCTION(this << stream << bufferSize);
+    NS_ASSERT(bufferSize > 0);
+    m_data.reserve(m_bufferSize);
+    AsyncFileWriterThread::Get().Attach();
+}
+
+AsyncFileWriter::~AsyncFileWriter()
+{
+    NS_LOG_FUNCTION(this);
+    Flush();
+    AsyncFileWriterThread::Get().Detach();
+}
+
+uint8_t*
+AsyncFileWriter::Reserve(uint32_t size)
+{
+    if (!m_data.empty() && m_data.size() + size > m_bufferSize)
+    {
+        Submit();
+    }
+    std::size_t offset = m_data.size();
+    m_data.resize(offset + size);
+    return m_data.data() + offset;
+}
+
+void
+AsyncFileWriter::Write(const void* data, uint32_t size)
+{
+    std::memcpy(Reserve(size), data, size);
+}
+
+void
+AsyncFileWriter::Submit()
+{
+    NS_LOG_FUNCTION(this << m_data.size());
+    AsyncFileWriterThread::Get().Submit(this, m_data);
+    m_data.reserve(m_bufferSize);
+}
+
+void
+AsyncFileWriter::Flush()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_data.empty())
+    {
+        Submit();
+    }
+    AsyncFileWriterThread::Get().Wait(this);
+    m_stream->flush();
+    if (m_stream->fail())
+    {
+        m_failed = true;
+    }
+}
+
+bool
+AsyncFileWriter::Failed() const
+{
+    return m_failed;
+}
+
+} // namespace ns3
@@ -0,0 +1,105 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef ASYNC_FILE_WRITER_H
+#define ASYNC_FILE_WRITER_H
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup network
+ *
+ * @brief Write-behind buffer for an output stream.
+ *
+ * Data written to an AsyncFileWriter is accumulated in a buffer of a
+ * configurable size.  Full buffers are handed to a background I/O thread,
+ * shared by all the AsyncFileWriter instances, which writes them to the
+ * stream in order.  The content of the stream is therefore identical to
+ * the one obtained by writing the same data directly, but the simulation
+ * thread does not wait for the I/O system calls.
+ *
+ * The amount of memory held by the buffers waiting for the I/O thread is
+ * bounded by the "AsyncFileWriterMemoryBudget" GlobalValue: when a buffer
+ * would exceed it, the simulation thread waits until the I/O thread has
+ * written enough data.
+ *
+ * While an AsyncFileWriter is attached to a stream, the stream must not be
+ * accessed directly, except right after a call to Flush.
+ *
+ * This class is not thread safe: a given instance must only be used by
+ * one thread (typically, the simulation thread).
+ */
+class AsyncFileWriter
+{
+  public:
+    /**
+     * Constructor
+     *
+     * @param stream the stream to write to
+     * @param bufferSize the size of the write buffers
+     */
+    AsyncFileWriter(std::ostream* stream, uint32_t bufferSize);
+    /**
+     * Destructor.  Writes the pending data to the stream.
+     */
+    ~AsyncFileWriter();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    AsyncFileWriter(const AsyncFileWriter&) = delete;
+    AsyncFileWriter& operator=(const AsyncFileWriter&) = delete;
+
+    /**
+     * @brief Reserve space at the end of the data to write.
+     *
+     * The caller must fill the returned area before any other call
+     * on this object.
+     *
+     * @param size the number of bytes to reserve
+     * @returns a pointer to the reserved area
+     */
+    uint8_t* Reserve(uint32_t size);
+    /**
+     * @brief Append data to write.
+     *
+     * @param data the data
+     * @param size the number of bytes of data
+     */
+    void Write(const void* data, uint32_t size);
+    /**
+     * @brief Write all the pending data to the stream and flush it.
+     *
+     * Returns once the I/O thread does not hold any buffer of this writer
+     * anymore, so the stream can then be accessed directly.
+     */
+    void Flush();
+    /**
+     * @returns true if writing to the stream failed
+     */
+    bool Failed() const;
+
+  private:
+    /**
+     * @brief Hand the current buffer to the I/O thread.
+     */
+    void Submit();
+
+    /// Friend class
+    friend class AsyncFileWriterThread;
+
+    std::ostream* m_stream;      //!< the stream to write to
+    uint32_t m_bufferSize;       //!< the size of the write buffers
+    std::vector<uint8_t> m_data; //!< the buffer being filled
+    uint32_t m_pending;          //!< buffers held by the I/O thread
+    std::atomic<bool> m_failed;  //!< whether writing to the stream failed
+};
+
+} // namespace ns3
+
+#endif /* ASYNC_FILE_WRITER_H */
@@ -0,0 +1,27 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "flush-on-destroy.h"
+
+#include "ns3/simulator.h"
+
+namespace ns3
+{
+
+FlushOnDestroy::~FlushOnDestroy()
+{
+    m_event.Cancel();
+}
+
+void
+FlushOnDestroy::Schedule(Callback<void> flush)
+{
+    if (m_event.IsPending())
+    {
+        return;
+    }
+    m_event = Simulator::ScheduleDestroy([flush]() { flush(); });
+}
+
+} // namespace ns3
@@ -0,0 +1,54 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef FLUSH_ON_DESTROY_H
+#define FLUSH_ON_DESTROY_H
+
+#include "ns3/callback.h"
+#include "ns3/event-id.h"
+
+namespace ns3
+{
+
+/**
+ * @ingroup network
+ *
+ * @brief Flush a buffered trace file when the simulator is destroyed.
+ *
+ * Trace sinks may keep a buffered file alive past the end of the
+ * simulation, hence its buffers are flushed by Simulator::Destroy.  The
+ * flush is registered at most once, however often the file is opened,
+ * and it does not keep the file alive: the owner of the FlushOnDestroy
+ * must be the object flushed by the callback, so that the flush is
+ * cancelled when the object is deleted.
+ */
+class FlushOnDestroy
+{
+  public:
+    FlushOnDestroy() = default;
+    /**
+     * Destructor.  Cancels the flush, if it did not run yet.
+     */
+    ~FlushOnDestroy();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    FlushOnDestroy(const FlushOnDestroy&) = delete;
+    FlushOnDestroy& operator=(const FlushOnDestroy&) = delete;
+
+    /**
+     * Run the given callback when the simulator is destroyed, unless a
+     * callback is already registered.
+     *
+     * @param flush the callback flushing the file, which must not hold a
+     *        reference to the file
+     */
+    void Schedule(Callback<void> flush);
+
+  private:
+    EventId m_event; //!< the destroy event running the flush
+};
+
+} // namespace ns3
+
+#endif /* FLUSH_ON_DESTROY_H */
@@ -0,0 +1,323 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "mapped-pcap-file.h"
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include "ns3/packet.h"
+
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+
+#ifndef __WIN32__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("MappedPcapFile");
+
+namespace
+{
+
+const uint32_t MAGIC = 0xa1b2c3d4;            //!< standard pcap file
+const uint32_t SWAPPED_MAGIC = 0xd4c3b2a1;    //!< standard pcap file, swapped
+const uint32_t NS_MAGIC = 0xa1b23c4d;         //!< nanosecond resolution pcap file
+const uint32_t NS_SWAPPED_MAGIC = 0x4d3cb2a1; //!< nanosecond resolution pcap file, swapped
+const uint16_t VERSION_MAJOR = 2;             //!< supported major version
+const uint16_t VERSION_MINOR = 4;             //!< supported minor version
+const std::size_t FILE_HEADER_SIZE = 24;      //!< size of the pcap file header
+const std::size_t RECORD_HEADER_SIZE = 16;    //!< size of a pcap record header
+
+} // namespace
+
+Ptr<Packet>
+MappedPcapFile::Record::CreatePacket() const
+{
+    Ptr<Packet> p = Create<Packet>(data, inclLen);
+    if (origLen > inclLen)
+    {
+        p->AddPaddingAtEnd(origLen - inclLen);
+    }
+    return p;
+}
+
+MappedPcapFile::Iterator::Iterator()
+    : m_file(nullptr),
+      m_offset(0),
+      m_record()
+{
+}
+
+MappedPcapFile::Iterator::Iterator(const MappedPcapFile* file, std::size_t offset)
+    : m_file(file),
+      m_offset(offset),
+      m_record()
+{
+    Decode();
+}
+
+void
+MappedPcapFile::Iterator::Decode()
+{
+    if (m_offset + RECORD_HEADER_SIZE > m_file->m_size)
+    {
+        m_file->m_truncated = m_offset != m_file->m_size;
+        m_file = nullptr;
+        return;
+    }
+    m_record.tsSec = m_file->Read32(m_offset);
+    m_record.tsSubSec = m_file->Read32(m_offset + 4);
+    m_record.inclLen = m_file->Read32(m_offset + 8);
+    m_record.origLen = m_file->Read32(m_offset + 12);
+    if (m_record.inclLen > m_file->m_size - m_offset - RECORD_HEADER_SIZE)
+    {
+        m_file->m_truncated = true;
+        m_file = nullptr;
+        return;
+    }
+    m_record.data = m_file->m_data + m_offset + RECORD_HEADER_SIZE;
+    if (m_file->m_nanosecMode)
+    {
+        m_record.time = NanoSeconds(m_record.tsSec * 1000000000ULL + m_record.tsSubSec);
+    }
+    else
+    {
+        m_record.time = MicroSeconds(m_record.tsSec * 1000000ULL + m_record.tsSubSec);
+    }
+}
+
+MappedPcapFile::Iterator::reference
+MappedPcapFile::Iterator::operator*() const
+{
+    NS_ASSERT_MSG(m_file, "Dereferencing the end iterator");
+    return m_record;
+}
+
+MappedPcapFile::Iterator::pointer
+MappedPcapFile::Iterator::operator->() const
+{
+    NS_ASSERT_MSG(m_file, "Dereferencing the end iterator");
+    return &m_record;
+}
+
+MappedPcapFile::Iterator&
+MappedPcapFile::Iterator::operator++()
+{
+    NS_ASSERT_MSG(m_file, "Incrementing the end iterator");
+    m_offset += RECORD_HEADER_SIZE + m_record.inclLen;
+    Decode();
+    return *this;
+}
+
+MappedPcapFile::Iterator
+MappedPcapFile::Iterator::operator++(int)
+{
+    Iterator tmp = *this;
+    ++*this;
+    return tmp;
+}
+
+bool
+MappedPcapFile::Iterator::operator==(const Iterator& other) const
+{
+    if (!m_file || !other.m_file)
+    {
+        return m_file == other.m_file;
+    }
+    return m_file == other.m_file && m_offset == other.m_offset;
+}
+
+MappedPcapFile::MappedPcapFile()
+    : m_data(nullptr),
+      m_size(0),
+      m_mapped(false),
+      m_fail(true),
+      m_truncated(false),
+      m_swapMode(false),
+      m_nanosecMode(false),
+      m_snapLen(0),
+      m_dataLinkType(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+MappedPcapFile::~MappedPcapFile()
+{
+    NS_LOG_FUNCTION(this);
+    Close();
+}
+
+void
+MappedPcapFile::Open(const std::string& filename)
+{
+    NS_LOG_FUNCTION(this << filename);
+    Close();
+
+#ifndef __WIN32__
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        NS_LOG_LOGIC("cannot open " << filename << ": " << std::strerror(errno));
+        return;
+    }
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > 0)
+    {
+        void* addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr != MAP_FAILED)
+        {
+            // records are read once, in order
+            madvise(addr, st.st_size, MADV_SEQUENTIAL);
+            m_data = static_cast<const uint8_t*>(addr);
+            m_size = st.st_size;
+            m_mapped = true;
+        }
+    }
+    close(fd);
+#endif
+
+    if (!m_mapped)
+    {
+        std::ifstream in(filename, std::ios::binary);
+        if (!in)
+        {
+            return;
+        }
+        m_copy.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        m_data = m_copy.data();
+        m_size = m_copy.size();
+    }
+
+    if (m_size < FILE_HEADER_SIZE)
+    {
+        return;
+    }
+    uint32_t magic;
+    std::memcpy(&magic, m_data, sizeof(magic));
+    if (magic != MAGIC && magic != SWAPPED_MAGIC && magic != NS_MAGIC && magic != NS_SWAPPED_MAGIC)
+    {
+        return;
+    }
+    m_swapMode = (magic == SWAPPED_MAGIC || magic == NS_SWAPPED_MAGIC);
+    m_nanosecMode = (magic == NS_MAGIC || magic == NS_SWAPPED_MAGIC);
+
+    if (Read16(4) != VERSION_MAJOR || Read16(6) != VERSION_MINOR)
+    {
+        return;
+    }
+    m_snapLen = Read32(16);
+    m_dataLinkType = Read32(20);
+    m_fail = false;
+}
+
+void
+MappedPcapFile::Close()
+{
+    NS_LOG_FUNCTION(this);
+#ifndef __WIN32__
+    if (m_mapped)
+    {
+        munmap(const_cast<uint8_t*>(m_data), m_size);
+    }
+#endif
+    m_copy.clear();
+    m_copy.shrink_to_fit();
+    m_data = nullptr;
+    m_size = 0;
+    m_mapped = false;
+    m_fail = true;
+    m_truncated = false;
+}
+
+bool
+MappedPcapFile::Fail() const
+{
+    return m_fail;
+}
+
+bool
+MappedPcapFile::IsTruncated() const
+{
+    return m_truncated;
+}
+
+MappedPcapFile::Iterator
+MappedPcapFile::begin() const
+{
+    if (m_fail)
+    {
+        return end();
+    }
+    return Iterator(this, FILE_HEADER_SIZE);
+}
+
+MappedPcapFile::Iterator
+MappedPcapFile::end() const
+{
+    return Iterator();
+}
+
+uint32_t
+MappedPcapFile::GetDataLinkType() const
+{
+    return m_dataLinkType;
+}
+
+uint32_t
+MappedPcapFile::GetSnapLen() const
+{
+    return m_snapLen;
+}
+
+bool
+MappedPcapFile::IsNanoSecMode() const
+{
+    return m_nanosecMode;
+}
+
+bool
+MappedPcapFile::GetSwapMode() const
+{
+    return m_swapMode;
+}
+
+std::size_t
+MappedPcapFile::GetSize() const
+{
+    return m_size;
+}
+
+uint16_t
+MappedPcapFile::Read16(std::size_t offset) const
+{
+    uint16_t v;
+    std::memcpy(&v, m_data + offset, sizeof(v));
+    if (m_swapMode)
+    {
+        v = ((v & 0x00ff) << 8) | ((v & 0xff00) >> 8);
+    }
+    return v;
+}
+
+uint32_t
+MappedPcapFile::Read32(std::size_t offset) const
+{
+    uint32_t v;
+    std::memcpy(&v, m_data + offset, sizeof(v));
+    if (m_swapMode)
+    {
+        v = ((v & 0x000000ff) << 24) | ((v & 0x0000ff00) << 8) | ((v & 0x00ff0000) >> 8) |
+            ((v & 0xff000000) >> 24);
+    }
+    return v;
+}
+
+} // namespace ns3
@@ -0,0 +1,221 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef MAPPED_PCAP_FILE_H
+#define MAPPED_PCAP_FILE_H
+
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+class Packet;
+
+/**
+ * @ingroup network
+ *
+ * @brief Read-only access to a pcap file mapped in memory.
+ *
+ * Unlike PcapFile::Read, which reads each record through an iostream
+ * into a caller-provided buffer, MappedPcapFile maps the whole file in
+ * the address space of the process and iterates over its records in
+ * place: the record data are pointers into the mapping, and the
+ * operating system pages the file in (and out) as the records are
+ * visited, so files much larger than the memory can be read.
+ *
+ * @code
+ *   MappedPcapFile file;
+ *   file.Open("capture.pcap");
+ *   for (const auto& record : file)
+ *   {
+ *       Ptr<Packet> p = record.CreatePacket();
+ *       ...
+ *   }
+ * @endcode
+ *
+ * The iteration stops at the first truncated record, if any; IsTruncated
+ * then returns true.
+ *
+ * On the platforms without mmap, the file is read in memory instead.
+ */
+class MappedPcapFile
+{
+  public:
+    /**
+     * @brief A record of the file.
+     *
+     * The data pointer is valid as long as the file is open.
+     */
+    struct Record
+    {
+        uint32_t tsSec;      //!< seconds part of the timestamp
+        uint32_t tsSubSec;   //!< microseconds (or nanoseconds) part of the timestamp
+        uint32_t inclLen;    //!< number of bytes of the packet stored in the file
+        uint32_t origLen;    //!< original length of the packet
+        const uint8_t* data; //!< the inclLen bytes of the packet, in the mapping
+        Time time;           //!< the timestamp
+
+        /**
+         * @brief Create a packet with the bytes of the record.
+         *
+         * The bytes are copied once, from the mapping to the packet buffer.
+         * If the packet was truncated by the capture, it is completed by
+         * zero padding up to its original length.
+         *
+         * @returns the packet
+         */
+        Ptr<Packet> CreatePacket() const;
+    };
+
+    /**
+     * @brief Forward iterator over the records of a file.
+     */
+    class Iterator
+    {
+      public:
+        using iterator_category = std::forward_iterator_tag; //!< iterator category
+        using value_type = Record;                           //!< value type
+        using difference_type = std::ptrdiff_t;              //!< difference type
+        using pointer = const Record*;                       //!< pointer type
+        using reference = const Record&;                     //!< reference type
+
+        /**
+         * Construct an end iterator.
+         */
+        Iterator();
+
+        /**
+         * @returns the current record
+         */
+        reference operator*() const;
+        /**
+         * @returns a pointer to the current record
+         */
+        pointer operator->() const;
+        /**
+         * @brief Move to the next record.
+         * @returns this iterator
+         */
+        Iterator& operator++();
+        /**
+         * @brief Move to the next record.
+         * @returns a copy of this iterator before moving
+         */
+        Iterator operator++(int);
+        /**
+         * @param other another iterator
+         * @returns true if both iterators point to the same record
+         */
+        bool operator==(const Iterator& other) const;
+
+      private:
+        friend class MappedPcapFile;
+
+        /**
+         * Construct an iterator on the record at a given offset.
+         *
+         * @param file the file
+         * @param offset the offset of the record
+         */
+        Iterator(const MappedPcapFile* file, std::size_t offset);
+        /**
+         * @brief Decode the record at m_offset, or become an end iterator.
+         */
+        void Decode();
+
+        const MappedPcapFile* m_file; //!< the file, nullptr for the end iterator
+        std::size_t m_offset;         //!< offset of the current record
+        Record m_record;              //!< the current record
+    };
+
+    MappedPcapFile();
+    ~MappedPcapFile();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    MappedPcapFile(const MappedPcapFile&) = delete;
+    MappedPcapFile& operator=(const MappedPcapFile&) = delete;
+
+    /**
+     * @brief Map a pcap file and check its header.
+     *
+     * @param filename the name of the file
+     */
+    void Open(const std::string& filename);
+    /**
+     * @brief Unmap the file.
+     */
+    void Close();
+    /**
+     * @returns true if the file could not be opened or is not a pcap file
+     */
+    bool Fail() const;
+    /**
+     * @returns true if the iteration stopped at a truncated record
+     */
+    bool IsTruncated() const;
+
+    /**
+     * @returns an iterator on the first record
+     */
+    Iterator begin() const;
+    /**
+     * @returns the end iterator
+     */
+    Iterator end() const;
+
+    /**
+     * @returns the data link type of the file
+     */
+    uint32_t GetDataLinkType() const;
+    /**
+     * @returns the maximum length of the records of the file
+     */
+    uint32_t GetSnapLen() const;
+    /**
+     * @returns true if the timestamps have a nanosecond resolution
+     */
+    bool IsNanoSecMode() const;
+    /**
+     * @returns true if the file byte order differs from the host one
+     */
+    bool GetSwapMode() const;
+    /**
+     * @returns the size of the file, in bytes
+     */
+    std::size_t GetSize() const;
+
+  private:
+    /**
+     * @param offset an offset in the file
+     * @returns the 16 bits integer at offset, in host byte order
+     */
+    uint16_t Read16(std::size_t offset) const;
+    /**
+     * @param offset an offset in the file
+     * @returns the 32 bits integer at offset, in host byte order
+     */
+    uint32_t Read32(std::size_t offset) const;
+
+    const uint8_t* m_data;       //!< the mapped file
+    std::size_t m_size;          //!< the size of the file
+    std::vector<uint8_t> m_copy; //!< the file content, when it cannot be mapped
+    bool m_mapped;               //!< whether m_data is a mapping
+    bool m_fail;                 //!< whether opening the file failed
+    mutable bool m_truncated;    //!< whether a truncated record was found
+    bool m_swapMode;             //!< whether the byte order must be swapped
+    bool m_nanosecMode;          //!< whether timestamps are in nanoseconds
+    uint32_t m_snapLen;          //!< the snapshot length
+    uint32_t m_dataLinkType;     //!< the data link type
+};
+
+} // namespace ns3
+
+#endif /* MAPPED_PCAP_FILE_H */
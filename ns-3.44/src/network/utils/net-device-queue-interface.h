@@ -199,6 +199,7 @@ class NetDeviceQueue : public Object
     Ptr<QueueLimits> m_queueLimits; //!< Queue limits object
     WakeCallback m_wakeCallback;    //!< Wake callback
     Ptr<NetDevice> m_device;        //!< the netdevice aggregated to the NetDeviceQueueInterface
+    uint32_t m_dequeuedBytes;       //!< Bytes dequeued and not notified to the queue limits yet
 
     NS_LOG_TEMPLATE_DECLARE; //!< redefinition of the log component
 };
@@ -353,9 +354,20 @@ NetDeviceQueue::PacketDequeued(QueueType* queue, Ptr<const typename QueueType::I
     NS_LOG_FUNCTION(this << queue << item);
     NS_ASSERT_MSG(m_device, "Aggregated NetDevice not set");
 
+    // The packets dequeued at once (e.g., a burst transmitted as a single train)
+    // are notified to BQL together, by a single event
+    if (m_dequeuedBytes > 0)
+    {
+        m_dequeuedBytes += item->GetSize();
+        return;
+    }
+    m_dequeuedBytes = item->GetSize();
+
     Simulator::ScheduleNow([=, this]() {
         // Inform BQL
-        NotifyTransmittedBytes(item->GetSize());
+        uint32_t bytes = m_dequeuedBytes;
+        m_dequeuedBytes = 0;
+        NotifyTransmittedBytes(bytes);
 
         // After dequeuing a packet, if there is room for another packet we
         // call Wake () that ensures that the queue is not stopped and restarts
@@ -37,11 +37,19 @@ PcapFileWrapper::GetTypeId()
                           "microseconds(default).",
                           BooleanValue(false),
                           MakeBooleanAccessor(&PcapFileWrapper::m_nanosecMode),
-                          MakeBooleanChecker());
+                          MakeBooleanChecker())
+            .AddAttribute("WriteBufferSize",
+                          "Size of the buffers in which records are accumulated before being "
+                          "written to the file by a background thread. Zero means that records "
+                          "are written synchronously by the simulation thread.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&PcapFileWrapper::m_writeBufferSize),
+                          MakeUintegerChecker<uint32_t>());
     return tid;
 }
 
 PcapFileWrapper::PcapFileWrapper()
+    : m_interfaceId(0)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -56,6 +64,10 @@ bool
 PcapFileWrapper::Fail() const
 {
     NS_LOG_FUNCTION(this);
+    if (m_pcapng)
+    {
+        return m_pcapng->Fail();
+    }
     return m_file.Fail();
 }
 
@@ -77,14 +89,47 @@ void
 PcapFileWrapper::Close()
 {
     NS_LOG_FUNCTION(this);
+    // the pcapng file is closed when the last interface releases it
+    m_pcapng = nullptr;
     m_file.Close();
 }
 
+void
+PcapFileWrapper::Flush()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_pcapng)
+    {
+        m_pcapng->Flush();
+    }
+    m_file.Flush();
+}
+
 void
 PcapFileWrapper::Open(const std::string& filename, std::ios::openmode mode)
 {
     NS_LOG_FUNCTION(this << filename << mode);
     m_file.Open(filename, mode);
+    if (m_writeBufferSize > 0 && (mode & std::ios::out) && !m_file.Fail())
+    {
+        m_file.SetWriteBufferSize(m_writeBufferSize);
+        m_flushOnDestroy.Schedule(MakeCallback(&PcapFileWrapper::Flush, this));
+    }
+}
+
+void
+PcapFileWrapper::Open(Ptr<PcapngFile> file,
+                      const std::string& name,
+                      uint32_t dataLinkType,
+                      uint32_t snapLen)
+{
+    NS_LOG_FUNCTION(this << file << name << dataLinkType << snapLen);
+    m_pcapng = file;
+    m_interfaceId = m_pcapng->AddInterface(name,
+                                           dataLinkType,
+                                           snapLen != std::numeric_limits<uint32_t>::max()
+                                               ? snapLen
+                                               : m_snapLen);
 }
 
 void
@@ -110,6 +155,11 @@ void
 PcapFileWrapper::Write(Time t, Ptr<const Packet> p)
 {
     NS_LOG_FUNCTION(this << t << p);
+    if (m_pcapng)
+    {
+        m_pcapng->Write(m_interfaceId, t, p);
+        return;
+    }
     if (m_file.IsNanoSecMode())
     {
         uint64_t current = t.GetNanoSeconds();
@@ -130,6 +180,11 @@ void
 PcapFileWrapper::Write(Time t, const Header& header, Ptr<const Packet> p)
 {
     NS_LOG_FUNCTION(this << t << &header << p);
+    if (m_pcapng)
+    {
+        m_pcapng->Write(m_interfaceId, t, header, p);
+        return;
+    }
     if (m_file.IsNanoSecMode())
     {
         uint64_t current = t.GetNanoSeconds();
@@ -150,6 +205,11 @@ void
 PcapFileWrapper::Write(Time t, const uint8_t* buffer, uint32_t length)
 {
     NS_LOG_FUNCTION(this << t << &buffer << length);
+    if (m_pcapng)
+    {
+        m_pcapng->Write(m_interfaceId, t, buffer, length);
+        return;
+    }
     if (m_file.IsNanoSecMode())
     {
         uint64_t current = t.GetNanoSeconds();
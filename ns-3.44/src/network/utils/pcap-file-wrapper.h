@@ -7,7 +7,9 @@
 #ifndef PCAP_FILE_WRAPPER_H
 #define PCAP_FILE_WRAPPER_H
 
+#include "flush-on-destroy.h"
 #include "pcap-file.h"
+#include "pcapng-file.h"
 
 #include "ns3/nstime.h"
 #include "ns3/object.h"
@@ -64,14 +66,40 @@ class PcapFileWrapper : public Object
      *
      * @param mode String containing the access mode for the file.
      *
+     * If the file is opened for writing and the "WriteBufferSize" attribute
+     * is not zero, records are written from a background thread, and the
+     * file is flushed when the simulator is destroyed.
      */
     void Open(const std::string& filename, std::ios::openmode mode);
 
+    /**
+     * Write the packets to an interface of a pcapng file gathering several
+     * interfaces, instead of a pcap file of their own.
+     *
+     * The Write methods then add the packets to the pcapng file, and the
+     * Init, Read and Get* methods must not be used.
+     *
+     * @param file the pcapng file, which must be open
+     * @param name the name of the interface
+     * @param dataLinkType the data link type of the packets, as in Init
+     * @param snapLen the maximum size of the packets stored in the file; if
+     * not provided, the "CaptureSize" attribute is used
+     */
+    void Open(Ptr<PcapngFile> file,
+              const std::string& name,
+              uint32_t dataLinkType,
+              uint32_t snapLen = std::numeric_limits<uint32_t>::max());
+
     /**
      * Close the underlying pcap file.
      */
     void Close();
 
+    /**
+     * Write the buffered records, if any, to the underlying pcap file.
+     */
+    void Flush();
+
     /**
      * Initialize the pcap file associated with this wrapper.  This file must have
      * been previously opened with write permissions.
@@ -211,9 +239,13 @@ class PcapFileWrapper : public Object
     uint32_t GetDataLinkType();
 
   private:
-    PcapFile m_file;    //!< Pcap file
-    uint32_t m_snapLen; //!< max length of saved packets
-    bool m_nanosecMode; //!< Timestamps in nanosecond mode
+    PcapFile m_file;                 //!< Pcap file
+    Ptr<PcapngFile> m_pcapng;        //!< pcapng file, used instead of m_file if set
+    uint32_t m_interfaceId;          //!< interface id in m_pcapng
+    uint32_t m_snapLen;              //!< max length of saved packets
+    bool m_nanosecMode;              //!< Timestamps in nanosecond mode
+    uint32_t m_writeBufferSize;      //!< size of the write buffers, zero if unbuffered
+    FlushOnDestroy m_flushOnDestroy; //!< flushes the write buffer at Simulator::Destroy
 };
 
 } // namespace ns3
@@ -8,6 +8,9 @@
 
 #include "pcap-file.h"
 
+#include "async-file-writer.h"
+#include "mapped-pcap-file.h"
+
 #include "ns3/assert.h"
 #include "ns3/buffer.h"
 #include "ns3/build-profile.h"
@@ -60,6 +63,11 @@ bool
 PcapFile::Fail() const
 {
     NS_LOG_FUNCTION(this);
+    if (m_writer)
+    {
+        // the I/O thread may be using m_file
+        return m_writer->Failed();
+    }
     return m_file.fail();
 }
 
@@ -67,6 +75,10 @@ bool
 PcapFile::Eof() const
 {
     NS_LOG_FUNCTION(this);
+    if (m_writer)
+    {
+        return false;
+    }
     return m_file.eof();
 }
 
@@ -74,6 +86,7 @@ void
 PcapFile::Clear()
 {
     NS_LOG_FUNCTION(this);
+    Flush();
     m_file.clear();
 }
 
@@ -81,9 +94,34 @@ void
 PcapFile::Close()
 {
     NS_LOG_FUNCTION(this);
+    m_writer.reset();
     m_file.close();
 }
 
+void
+PcapFile::SetWriteBufferSize(uint32_t bufferSize)
+{
+    NS_LOG_FUNCTION(this << bufferSize);
+    m_writer.reset();
+    if (bufferSize > 0)
+    {
+        NS_ASSERT_MSG(m_file.is_open() && !m_file.fail(),
+                      "PcapFile::SetWriteBufferSize(): file " << m_filename
+                                                              << " is not open for writing");
+        m_writer = std::make_unique<AsyncFileWriter>(&m_file, bufferSize);
+    }
+}
+
+void
+PcapFile::Flush()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_writer)
+    {
+        m_writer->Flush();
+    }
+}
+
 uint32_t
 PcapFile::GetMagic()
 {
@@ -200,6 +238,7 @@ PcapFile::WriteFileHeader()
     // If we're initializing the file, we need to write the pcap file header
     // at the start of the file.
     //
+    Flush();
     m_file.seekp(0, std::ios::beg);
 
     //
@@ -228,13 +267,26 @@ PcapFile::WriteFileHeader()
     // Watch out for memory alignment differences between machines, so write
     // them all individually.
     //
-    m_file.write((const char*)&headerOut->m_magicNumber, sizeof(headerOut->m_magicNumber));
-    m_file.write((const char*)&headerOut->m_versionMajor, sizeof(headerOut->m_versionMajor));
-    m_file.write((const char*)&headerOut->m_versionMinor, sizeof(headerOut->m_versionMinor));
-    m_file.write((const char*)&headerOut->m_zone, sizeof(headerOut->m_zone));
-    m_file.write((const char*)&headerOut->m_sigFigs, sizeof(headerOut->m_sigFigs));
-    m_file.write((const char*)&headerOut->m_snapLen, sizeof(headerOut->m_snapLen));
-    m_file.write((const char*)&headerOut->m_type, sizeof(headerOut->m_type));
+    WriteData(&headerOut->m_magicNumber, sizeof(headerOut->m_magicNumber));
+    WriteData(&headerOut->m_versionMajor, sizeof(headerOut->m_versionMajor));
+    WriteData(&headerOut->m_versionMinor, sizeof(headerOut->m_versionMinor));
+    WriteData(&headerOut->m_zone, sizeof(headerOut->m_zone));
+    WriteData(&headerOut->m_sigFigs, sizeof(headerOut->m_sigFigs));
+    WriteData(&headerOut->m_snapLen, sizeof(headerOut->m_snapLen));
+    WriteData(&headerOut->m_type, sizeof(headerOut->m_type));
+}
+
+void
+PcapFile::WriteData(const void* data, uint32_t size)
+{
+    if (m_writer)
+    {
+        m_writer->Write(data, size);
+    }
+    else
+    {
+        m_file.write((const char*)data, size);
+    }
 }
 
 void
@@ -321,6 +373,7 @@ PcapFile::Open(const std::string& filename, std::ios::openmode mode)
 {
     NS_LOG_FUNCTION(this << filename << mode);
     NS_ASSERT((mode & std::ios::app) == 0);
+    m_writer.reset();
     NS_ASSERT(!m_file.fail());
     //
     // All pcap files are binary files, so we just do this automatically.
@@ -402,7 +455,7 @@ uint32_t
 PcapFile::WritePacketHeader(uint32_t tsSec, uint32_t tsUsec, uint32_t totalLen)
 {
     NS_LOG_FUNCTION(this << tsSec << tsUsec << totalLen);
-    NS_ASSERT(m_file.good());
+    NS_ASSERT(m_writer ? !m_writer->Failed() : m_file.good());
 
     uint32_t inclLen = totalLen > m_fileHeader.m_snapLen ? m_fileHeader.m_snapLen : totalLen;
 
@@ -421,11 +474,14 @@ PcapFile::WritePacketHeader(uint32_t tsSec, uint32_t tsUsec, uint32_t totalLen)
     // Watch out for memory alignment differences between machines, so write
     // them all individually.
     //
-    m_file.write((const char*)&header.m_tsSec, sizeof(header.m_tsSec));
-    m_file.write((const char*)&header.m_tsUsec, sizeof(header.m_tsUsec));
-    m_file.write((const char*)&header.m_inclLen, sizeof(header.m_inclLen));
-    m_file.write((const char*)&header.m_origLen, sizeof(header.m_origLen));
-    NS_BUILD_DEBUG(m_file.flush());
+    WriteData(&header.m_tsSec, sizeof(header.m_tsSec));
+    WriteData(&header.m_tsUsec, sizeof(header.m_tsUsec));
+    WriteData(&header.m_inclLen, sizeof(header.m_inclLen));
+    WriteData(&header.m_origLen, sizeof(header.m_origLen));
+    if (!m_writer)
+    {
+        NS_BUILD_DEBUG(m_file.flush());
+    }
     return inclLen;
 }
 
@@ -434,8 +490,11 @@ PcapFile::Write(uint32_t tsSec, uint32_t tsUsec, const uint8_t* const data, uint
 {
     NS_LOG_FUNCTION(this << tsSec << tsUsec << &data << totalLen);
     uint32_t inclLen = WritePacketHeader(tsSec, tsUsec, totalLen);
-    m_file.write((const char*)data, inclLen);
-    NS_BUILD_DEBUG(m_file.flush());
+    WriteData(data, inclLen);
+    if (!m_writer)
+    {
+        NS_BUILD_DEBUG(m_file.flush());
+    }
 }
 
 void
@@ -443,6 +502,11 @@ PcapFile::Write(uint32_t tsSec, uint32_t tsUsec, Ptr<const Packet> p)
 {
     NS_LOG_FUNCTION(this << tsSec << tsUsec << p);
     uint32_t inclLen = WritePacketHeader(tsSec, tsUsec, p->GetSize());
+    if (m_writer)
+    {
+        p->CopyData(m_writer->Reserve(inclLen), inclLen);
+        return;
+    }
     p->CopyData(&m_file, inclLen);
     NS_BUILD_DEBUG(m_file.flush());
 }
@@ -459,8 +523,14 @@ PcapFile::Write(uint32_t tsSec, uint32_t tsUsec, const Header& header, Ptr<const
     headerBuffer.AddAtStart(headerSize);
     header.Serialize(headerBuffer.Begin());
     uint32_t toCopy = std::min(headerSize, inclLen);
-    headerBuffer.CopyData(&m_file, toCopy);
     inclLen -= toCopy;
+    if (m_writer)
+    {
+        headerBuffer.CopyData(m_writer->Reserve(toCopy), toCopy);
+        p->CopyData(m_writer->Reserve(inclLen), inclLen);
+        return;
+    }
+    headerBuffer.CopyData(&m_file, toCopy);
     p->CopyData(&m_file, inclLen);
 }
 
@@ -474,6 +544,7 @@ PcapFile::Read(uint8_t* const data,
                uint32_t& readLen)
 {
     NS_LOG_FUNCTION(this << &data << maxBytes << tsSec << tsUsec << inclLen << origLen << readLen);
+    NS_ASSERT(!m_writer);
     NS_ASSERT(m_file.good());
 
     PcapRecordHeader header;
@@ -531,79 +602,60 @@ PcapFile::Diff(const std::string& f1,
                uint32_t snapLen)
 {
     NS_LOG_FUNCTION(f1 << f2 << sec << usec << snapLen);
-    PcapFile pcap1;
-    PcapFile pcap2;
-    pcap1.Open(f1, std::ios::in);
-    pcap2.Open(f2, std::ios::in);
+    // Reference traces may be large: compare the records in place rather
+    // than reading each of them through a stream into a copy.
+    MappedPcapFile pcap1;
+    MappedPcapFile pcap2;
+    pcap1.Open(f1);
+    pcap2.Open(f2);
     bool bad = pcap1.Fail() || pcap2.Fail();
     if (bad)
     {
         return true;
     }
 
-    auto data1 = new uint8_t[snapLen]();
-    auto data2 = new uint8_t[snapLen]();
-    uint32_t tsSec1 = 0;
-    uint32_t tsSec2 = 0;
-    uint32_t tsUsec1 = 0;
-    uint32_t tsUsec2 = 0;
-    uint32_t inclLen1 = 0;
-    uint32_t inclLen2 = 0;
-    uint32_t origLen1 = 0;
-    uint32_t origLen2 = 0;
-    uint32_t readLen1 = 0;
-    uint32_t readLen2 = 0;
+    auto it1 = pcap1.begin();
+    auto it2 = pcap2.begin();
     bool diff = false;
 
-    while (!pcap1.Eof() && !pcap2.Eof())
+    for (; it1 != pcap1.end() && it2 != pcap2.end(); ++it1, ++it2)
     {
-        pcap1.Read(data1, snapLen, tsSec1, tsUsec1, inclLen1, origLen1, readLen1);
-        pcap2.Read(data2, snapLen, tsSec2, tsUsec2, inclLen2, origLen2, readLen2);
-
-        bool same = pcap1.Fail() == pcap2.Fail();
-        if (!same)
-        {
-            diff = true;
-            break;
-        }
-        if (pcap1.Eof())
-        {
-            break;
-        }
-
         ++packets;
+        sec = it1->tsSec;
+        usec = it1->tsSubSec;
 
-        if (tsSec1 != tsSec2 || tsUsec1 != tsUsec2)
+        if (it1->tsSec != it2->tsSec || it1->tsSubSec != it2->tsSubSec)
         {
             diff = true; // Next packet timestamps do not match
             break;
         }
 
+        uint32_t readLen1 = std::min(it1->inclLen, snapLen);
+        uint32_t readLen2 = std::min(it2->inclLen, snapLen);
         if (readLen1 != readLen2)
         {
             diff = true; // Packet lengths do not match
             break;
         }
 
-        if (std::memcmp(data1, data2, readLen1) != 0)
+        if (std::memcmp(it1->data, it2->data, readLen1) != 0)
         {
             diff = true; // Packet data do not match
             break;
         }
     }
-    sec = tsSec1;
-    usec = tsUsec1;
 
-    bad = pcap1.Fail() || pcap2.Fail();
-    bool eof = pcap1.Eof() && pcap2.Eof();
-    if (bad && !eof)
+    if (!diff && (it1 != pcap1.end() || it2 != pcap2.end() || pcap1.IsTruncated() ||
+                  pcap2.IsTruncated()))
     {
-        diff = true;
+        diff = true; // One file has more packets, or is corrupted
+        if (it1 != pcap1.end())
+        {
+            sec = it1->tsSec;
+            usec = it1->tsSubSec;
+        }
     }
 
-    delete[] data1;
-    delete[] data2;
-
     return diff;
 }
 
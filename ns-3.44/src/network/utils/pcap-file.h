@@ -12,6 +12,7 @@
 #include "ns3/ptr.h"
 
 #include <fstream>
+#include <memory>
 #include <stdint.h>
 #include <string>
 
@@ -20,6 +21,7 @@ namespace ns3
 
 class Packet;
 class Header;
+class AsyncFileWriter;
 
 /**
  * @brief A class representing a pcap file
@@ -75,6 +77,26 @@ class PcapFile
      */
     void Close();
 
+    /**
+     * @brief Write the records of this file from a background thread.
+     *
+     * Records are accumulated in buffers of \p bufferSize bytes, which are
+     * written to the file by an AsyncFileWriter.  The content of the file is
+     * identical to the one obtained with synchronous writes, but it is only
+     * complete after a call to Flush or Close.
+     *
+     * The file must have been opened for writing.
+     *
+     * @param bufferSize The size of the write buffers.  Zero switches back
+     * to synchronous writes.
+     */
+    void SetWriteBufferSize(uint32_t bufferSize);
+
+    /**
+     * @brief Write the buffered records, if any, to the file.
+     */
+    void Flush();
+
     /**
      * Initialize the pcap file associated with this object.  This file must have
      * been previously opened with write permissions.
@@ -340,6 +362,13 @@ class PcapFile
      */
     void Swap(PcapRecordHeader* from, PcapRecordHeader* to);
 
+    /**
+     * @brief Write data to the file, through the write buffer if any
+     * @param data the data
+     * @param size the size of the data
+     */
+    void WriteData(const void* data, uint32_t size);
+
     /**
      * @brief Write a Pcap file header
      */
@@ -362,11 +391,12 @@ class PcapFile
      */
     void ReadAndVerifyFileHeader();
 
-    std::string m_filename;      //!< file name
-    std::fstream m_file;         //!< file stream
-    PcapFileHeader m_fileHeader; //!< file header
-    bool m_swapMode;             //!< swap mode
-    bool m_nanosecMode;          //!< nanosecond timestamp mode
+    std::string m_filename;                    //!< file name
+    std::fstream m_file;                       //!< file stream
+    std::unique_ptr<AsyncFileWriter> m_writer; //!< write buffer, if any
+    PcapFileHeader m_fileHeader;               //!< file header
+    bool m_swapMode;                           //!< swap mode
+    bool m_nanosecMode;                        //!< nanosecond timestamp mode
 };
 
 } // namespace ns3
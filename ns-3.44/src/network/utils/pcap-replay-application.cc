@@ -0,0 +1,254 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "pcap-replay-application.h"
+
+#include "ethernet-header.h"
+#include "llc-snap-header.h"
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+#include "ns3/net-device.h"
+#include "ns3/packet.h"
+#include "ns3/pointer.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("PcapReplayApplication");
+
+NS_OBJECT_ENSURE_REGISTERED(PcapReplayApplication);
+
+namespace
+{
+
+const uint32_t DLT_EN10MB = 1; //!< Ethernet data link type
+const uint32_t DLT_PPP = 9;    //!< PPP data link type
+const uint32_t DLT_RAW = 101;  //!< raw IP data link type
+
+const uint16_t ETHERTYPE_IPV4 = 0x0800; //!< IPv4 EtherType
+const uint16_t ETHERTYPE_IPV6 = 0x86DD; //!< IPv6 EtherType
+const uint16_t PPP_IPV4 = 0x0021;       //!< IPv4 PPP protocol number
+const uint16_t PPP_IPV6 = 0x0057;       //!< IPv6 PPP protocol number
+
+} // namespace
+
+TypeId
+PcapReplayApplication::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::PcapReplayApplication")
+            .SetParent<Application>()
+            .SetGroupName("Network")
+            .AddConstructor<PcapReplayApplication>()
+            .AddAttribute("Filename",
+                          "The name of the pcap file to replay.",
+                          StringValue(""),
+                          MakeStringAccessor(&PcapReplayApplication::m_filename),
+                          MakeStringChecker())
+            .AddAttribute("DataRate",
+                          "The rate at which the packets are sent back to back. If zero, the "
+                          "packets are sent with the spacing of their timestamps.",
+                          DataRateValue(DataRate(0)),
+                          MakeDataRateAccessor(&PcapReplayApplication::m_dataRate),
+                          MakeDataRateChecker())
+            .AddAttribute("MaxPackets",
+                          "The maximum number of records to replay (zero means all of them).",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&PcapReplayApplication::m_maxPackets),
+                          MakeUintegerChecker<uint64_t>())
+            .AddAttribute("Device",
+                          "The device the packets are sent to.",
+                          PointerValue(),
+                          MakePointerAccessor(&PcapReplayApplication::m_device),
+                          MakePointerChecker<NetDevice>())
+            .AddTraceSource("Tx",
+                            "A packet is sent to the device",
+                            MakeTraceSourceAccessor(&PcapReplayApplication::m_txTrace),
+                            "ns3::Packet::TracedCallback")
+            .AddTraceSource("TxDrop",
+                            "A record could not be decoded or sent to the device",
+                            MakeTraceSourceAccessor(&PcapReplayApplication::m_txDropTrace),
+                            "ns3::Packet::TracedCallback");
+    return tid;
+}
+
+PcapReplayApplication::PcapReplayApplication()
+    : m_sent(0),
+      m_records(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+PcapReplayApplication::~PcapReplayApplication()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+PcapReplayApplication::SetDevice(Ptr<NetDevice> device)
+{
+    NS_LOG_FUNCTION(this << device);
+    m_device = device;
+}
+
+uint64_t
+PcapReplayApplication::GetSent() const
+{
+    return m_sent;
+}
+
+void
+PcapReplayApplication::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_device = nullptr;
+    m_next = MappedPcapFile::Iterator();
+    m_file.Close();
+    Application::DoDispose();
+}
+
+void
+PcapReplayApplication::StartApplication()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ABORT_MSG_UNLESS(m_device, "PcapReplayApplication: no device set");
+    m_file.Open(m_filename);
+    NS_ABORT_MSG_IF(m_file.Fail(), "PcapReplayApplication: cannot read " << m_filename);
+    uint32_t dlt = m_file.GetDataLinkType();
+    NS_ABORT_MSG_UNLESS(dlt == DLT_EN10MB || dlt == DLT_PPP || dlt == DLT_RAW,
+                        "PcapReplayApplication: unsupported data link type " << dlt);
+
+    m_next = m_file.begin();
+    m_records = 0;
+    if (m_next == m_file.end())
+    {
+        return;
+    }
+    m_firstTimestamp = m_next->time;
+    m_startTime = Simulator::Now();
+    ScheduleRecord(0);
+}
+
+void
+PcapReplayApplication::StopApplication()
+{
+    NS_LOG_FUNCTION(this);
+    Simulator::Cancel(m_sendEvent);
+    m_next = MappedPcapFile::Iterator();
+    m_file.Close();
+}
+
+void
+PcapReplayApplication::ScheduleRecord(uint32_t previousSize)
+{
+    if (m_next == m_file.end() || (m_maxPackets != 0 && m_records >= m_maxPackets))
+    {
+        NS_LOG_LOGIC("end of the replay after " << m_records << " records");
+        return;
+    }
+
+    Time delay;
+    if (m_dataRate.GetBitRate() != 0)
+    {
+        delay = m_dataRate.CalculateBytesTxTime(previousSize);
+    }
+    else
+    {
+        // the first record may not be the oldest one
+        Time offset = Max(m_next->time - m_firstTimestamp, Time(0));
+        delay = Max(m_startTime + offset - Simulator::Now(), Time(0));
+    }
+    m_sendEvent = Simulator::Schedule(delay, &PcapReplayApplication::SendRecord, this);
+}
+
+void
+PcapReplayApplication::SendRecord()
+{
+    NS_LOG_FUNCTION(this);
+    Ptr<Packet> packet = m_next->CreatePacket();
+    uint32_t size = packet->GetSize();
+    ++m_next;
+    ++m_records;
+
+    Address destination = m_device->GetBroadcast();
+    uint16_t protocol = 0;
+    switch (m_file.GetDataLinkType())
+    {
+    case DLT_EN10MB:
+        if (size >= 14)
+        {
+            EthernetHeader header(false);
+            packet->RemoveHeader(header);
+            destination = header.GetDestination();
+            protocol = header.GetLengthType();
+            if (protocol <= 1500)
+            {
+                // 802.3 length field, followed by an LLC/SNAP header
+                protocol = 0;
+                if (packet->GetSize() >= 8)
+                {
+                    LlcSnapHeader llc;
+                    packet->RemoveHeader(llc);
+                    protocol = llc.GetType();
+                }
+            }
+        }
+        break;
+    case DLT_PPP:
+        if (size >= 2)
+        {
+            uint8_t buffer[2];
+            packet->CopyData(buffer, 2);
+            if (buffer[0] == 0xff && buffer[1] == 0x03 && size >= 4)
+            {
+                // HDLC-like framing: skip the address and control fields
+                packet->RemoveAtStart(2);
+                packet->CopyData(buffer, 2);
+            }
+            packet->RemoveAtStart(2);
+            uint16_t pppProtocol = (buffer[0] << 8) | buffer[1];
+            protocol = pppProtocol == PPP_IPV4   ? ETHERTYPE_IPV4
+                       : pppProtocol == PPP_IPV6 ? ETHERTYPE_IPV6
+                                                 : 0;
+        }
+        break;
+    case DLT_RAW:
+        if (size >= 1)
+        {
+            uint8_t version;
+            packet->CopyData(&version, 1);
+            protocol = (version >> 4) == 4   ? ETHERTYPE_IPV4
+                       : (version >> 4) == 6 ? ETHERTYPE_IPV6
+                                             : 0;
+        }
+        break;
+    }
+
+    if (protocol == 0)
+    {
+        NS_LOG_LOGIC("cannot decode record " << m_records);
+        m_txDropTrace(packet);
+    }
+    else
+    {
+        m_txTrace(packet);
+        if (m_device->Send(packet, destination, protocol))
+        {
+            ++m_sent;
+        }
+        else
+        {
+            NS_LOG_LOGIC("device refused record " << m_records);
+            m_txDropTrace(packet);
+        }
+    }
+
+    ScheduleRecord(size);
+}
+
+} // namespace ns3
@@ -0,0 +1,105 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef PCAP_REPLAY_APPLICATION_H
+#define PCAP_REPLAY_APPLICATION_H
+
+#include "data-rate.h"
+#include "mapped-pcap-file.h"
+
+#include "ns3/application.h"
+#include "ns3/event-id.h"
+#include "ns3/ptr.h"
+#include "ns3/traced-callback.h"
+
+namespace ns3
+{
+
+class NetDevice;
+class Packet;
+
+/**
+ * @ingroup network
+ *
+ * @brief Replay the packets of a pcap file into a NetDevice.
+ *
+ * The file is read through a MappedPcapFile, one record at a time, so
+ * captures much larger than the memory can be replayed.  Each record is
+ * stripped of its link layer header and handed to NetDevice::Send, with
+ * the destination address and protocol number found in that header:
+ *
+ * - Ethernet (DLT_EN10MB) frames are sent to their destination MAC address
+ *   with their EtherType;
+ * - PPP (DLT_PPP) frames and raw IP (DLT_RAW) packets are broadcast with
+ *   the EtherType of their IPv4 or IPv6 payload.
+ *
+ * By default, the packets are sent with the same spacing as in the capture,
+ * the first one when the application starts.  If the "DataRate" attribute
+ * is not zero, the timestamps are ignored and the packets are sent back to
+ * back at that rate (e.g., the line rate of the device).
+ *
+ * The records that cannot be decoded, and the packets refused by the device
+ * (e.g., because its queue is full), are reported by the "TxDrop" trace.
+ */
+class PcapReplayApplication : public Application
+{
+  public:
+    /**
+     * @brief Get the type ID.
+     * @return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    PcapReplayApplication();
+    ~PcapReplayApplication() override;
+
+    /**
+     * @brief Set the device the packets are sent to.
+     * @param device the device
+     */
+    void SetDevice(Ptr<NetDevice> device);
+
+    /**
+     * @returns the number of packets sent so far
+     */
+    uint64_t GetSent() const;
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    void StartApplication() override;
+    void StopApplication() override;
+
+    /**
+     * @brief Send the current record and schedule the next one.
+     */
+    void SendRecord();
+    /**
+     * @brief Schedule the transmission of the current record.
+     * @param previousSize the size of the previous packet, in bytes
+     */
+    void ScheduleRecord(uint32_t previousSize);
+
+    std::string m_filename;          //!< the pcap file
+    DataRate m_dataRate;             //!< the replay rate, zero to follow the timestamps
+    uint64_t m_maxPackets;           //!< the maximum number of packets, zero for all
+    Ptr<NetDevice> m_device;         //!< the device the packets are sent to
+    MappedPcapFile m_file;           //!< the mapped pcap file
+    MappedPcapFile::Iterator m_next; //!< the next record to send
+    Time m_firstTimestamp;           //!< the timestamp of the first record
+    Time m_startTime;                //!< the time the replay started
+    uint64_t m_sent;                 //!< the number of packets sent
+    uint64_t m_records;              //!< the number of records replayed
+    EventId m_sendEvent;             //!< event to send the next packet
+
+    /// Traced Callback: packets sent to the device
+    TracedCallback<Ptr<const Packet>> m_txTrace;
+    /// Traced Callback: packets that could not be sent
+    TracedCallback<Ptr<const Packet>> m_txDropTrace;
+};
+
+} // namespace ns3
+
+#endif /* PCAP_REPLAY_APPLICATION_H */
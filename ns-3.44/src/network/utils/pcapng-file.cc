@@ -0,0 +1,381 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "pcapng-file.h"
+
+#include "async-file-writer.h"
+
+#include "ns3/abort.h"
+#include "ns3/assert.h"
+#include "ns3/boolean.h"
+#include "ns3/buffer.h"
+#include "ns3/header.h"
+#include "ns3/log.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+
+#include <cstring>
+#include <limits>
+#include <sstream>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("PcapngFile");
+
+NS_OBJECT_ENSURE_REGISTERED(PcapngFile);
+
+namespace
+{
+
+const uint32_t SECTION_HEADER_BLOCK = 0x0A0D0D0A; //!< SHB block type
+const uint32_t INTERFACE_DESCRIPTION_BLOCK = 0x1; //!< IDB block type
+const uint32_t ENHANCED_PACKET_BLOCK = 0x6;       //!< EPB block type
+const uint32_t BYTE_ORDER_MAGIC = 0x1A2B3C4D;     //!< SHB byte-order magic
+const uint16_t OPT_ENDOFOPT = 0;                  //!< end of options
+const uint16_t OPT_COMMENT = 1;                   //!< comment option
+const uint16_t SHB_USERAPPL = 4;                  //!< SHB application option
+const uint16_t IF_NAME = 2;                       //!< IDB interface name option
+const uint16_t IF_TSRESOL = 9;                    //!< IDB timestamp resolution option
+const uint8_t TSRESOL_NANOSECONDS = 9;            //!< 10^-9 s timestamp resolution
+const uint32_t SHB_HEADER_SIZE = 24;              //!< SHB size without options
+const uint32_t IDB_HEADER_SIZE = 16;              //!< IDB size without options
+const uint32_t EPB_HEADER_SIZE = 28;              //!< EPB size without data and options
+const uint32_t TRAILER_SIZE = 4;                  //!< size of the trailing block length
+const char* const USER_APPLICATION = "ns-3";      //!< written in the SHB
+
+/**
+ * @param size a size in bytes
+ * @returns the size rounded up to a multiple of 32 bits
+ */
+uint32_t
+Pad(uint32_t size)
+{
+    return (size + 3) & ~3U;
+}
+
+/**
+ * @param value the length of the value of an option
+ * @returns the size of the option, in bytes
+ */
+uint32_t
+OptionSize(uint32_t value)
+{
+    return 4 + Pad(value);
+}
+
+/**
+ * @brief Write a 16 bits integer in host byte order.
+ * @param p where to write
+ * @param v the value
+ * @returns the position after the value
+ */
+uint8_t*
+Put16(uint8_t* p, uint16_t v)
+{
+    std::memcpy(p, &v, sizeof(v));
+    return p + sizeof(v);
+}
+
+/**
+ * @brief Write a 32 bits integer in host byte order.
+ * @param p where to write
+ * @param v the value
+ * @returns the position after the value
+ */
+uint8_t*
+Put32(uint8_t* p, uint32_t v)
+{
+    std::memcpy(p, &v, sizeof(v));
+    return p + sizeof(v);
+}
+
+/**
+ * @brief Write an option, padded with zeros.
+ * @param p where to write
+ * @param code the option code
+ * @param value the option value
+ * @param length the length of the value
+ * @returns the position after the option
+ */
+uint8_t*
+PutOption(uint8_t* p, uint16_t code, const void* value, uint16_t length)
+{
+    p = Put16(p, code);
+    p = Put16(p, length);
+    std::memcpy(p, value, length);
+    std::memset(p + length, 0, Pad(length) - length);
+    return p + Pad(length);
+}
+
+/**
+ * @brief Write the end-of-options marker.
+ * @param p where to write
+ * @returns the position after the marker
+ */
+uint8_t*
+PutEndOfOptions(uint8_t* p)
+{
+    p = Put16(p, OPT_ENDOFOPT);
+    return Put16(p, 0);
+}
+
+} // namespace
+
+TypeId
+PcapngFile::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::PcapngFile")
+            .SetParent<Object>()
+            .SetGroupName("Network")
+            .AddConstructor<PcapngFile>()
+            .AddAttribute("WriteBufferSize",
+                          "Size of the buffers in which blocks are accumulated before being "
+                          "written to the file by a background thread. Zero means that blocks "
+                          "are written synchronously by the simulation thread.",
+                          UintegerValue(64 * 1024),
+                          MakeUintegerAccessor(&PcapngFile::m_writeBufferSize),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("PacketComments",
+                          "Whether each packet carries a comment with its interface name and "
+                          "the simulator context of the event which wrote it.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&PcapngFile::m_comments),
+                          MakeBooleanChecker());
+    return tid;
+}
+
+PcapngFile::PcapngFile()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+PcapngFile::~PcapngFile()
+{
+    NS_LOG_FUNCTION(this);
+    Close();
+}
+
+void
+PcapngFile::Open(const std::string& filename)
+{
+    NS_LOG_FUNCTION(this << filename);
+    Close();
+    m_filename = filename;
+    m_interfaces.clear();
+    m_file.clear();
+    m_file.open(filename, std::ios::out | std::ios::trunc | std::ios::binary);
+    if (m_file.fail())
+    {
+        return;
+    }
+    if (m_writeBufferSize > 0)
+    {
+        m_writer = std::make_unique<AsyncFileWriter>(&m_file, m_writeBufferSize);
+        m_flushOnDestroy.Schedule(MakeCallback(&PcapngFile::Flush, this));
+    }
+
+    uint32_t applLength = std::strlen(USER_APPLICATION);
+    uint32_t size = SHB_HEADER_SIZE + OptionSize(applLength) + OptionSize(0) + TRAILER_SIZE;
+    uint8_t* p = BeginBlock(size);
+    p = Put32(p, SECTION_HEADER_BLOCK);
+    p = Put32(p, size);
+    p = Put32(p, BYTE_ORDER_MAGIC);
+    p = Put16(p, 1); // major version
+    p = Put16(p, 0); // minor version
+    uint64_t sectionLength = std::numeric_limits<uint64_t>::max(); // not specified
+    std::memcpy(p, &sectionLength, sizeof(sectionLength));
+    p += sizeof(sectionLength);
+    p = PutOption(p, SHB_USERAPPL, USER_APPLICATION, applLength);
+    p = PutEndOfOptions(p);
+    Put32(p, size);
+    EndBlock();
+}
+
+void
+PcapngFile::Close()
+{
+    NS_LOG_FUNCTION(this);
+    m_writer.reset();
+    if (m_file.is_open())
+    {
+        m_file.close();
+    }
+}
+
+void
+PcapngFile::Flush()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_writer)
+    {
+        m_writer->Flush();
+    }
+    else if (m_file.is_open())
+    {
+        m_file.flush();
+    }
+}
+
+bool
+PcapngFile::Fail() const
+{
+    NS_LOG_FUNCTION(this);
+    if (m_writer)
+    {
+        // the I/O thread may be using m_file
+        return m_writer->Failed();
+    }
+    return m_file.fail();
+}
+
+uint32_t
+PcapngFile::AddInterface(const std::string& name, uint32_t dataLinkType, uint32_t snapLen)
+{
+    NS_LOG_FUNCTION(this << name << dataLinkType << snapLen);
+    NS_ABORT_MSG_UNLESS(m_file.is_open(), "PcapngFile::AddInterface(): file is not open");
+    NS_ABORT_MSG_UNLESS(name.size() <= std::numeric_limits<uint16_t>::max(),
+                        "PcapngFile::AddInterface(): interface name is too long");
+
+    uint32_t size =
+        IDB_HEADER_SIZE + OptionSize(name.size()) + OptionSize(1) + OptionSize(0) + TRAILER_SIZE;
+    uint8_t* p = BeginBlock(size);
+    p = Put32(p, INTERFACE_DESCRIPTION_BLOCK);
+    p = Put32(p, size);
+    p = Put16(p, dataLinkType);
+    p = Put16(p, 0); // reserved
+    p = Put32(p, snapLen);
+    p = PutOption(p, IF_NAME, name.data(), name.size());
+    p = PutOption(p, IF_TSRESOL, &TSRESOL_NANOSECONDS, 1);
+    p = PutEndOfOptions(p);
+    Put32(p, size);
+    EndBlock();
+
+    m_interfaces.push_back({name, snapLen});
+    return m_interfaces.size() - 1;
+}
+
+uint32_t
+PcapngFile::GetNInterfaces() const
+{
+    return m_interfaces.size();
+}
+
+uint8_t*
+PcapngFile::BeginBlock(uint32_t size)
+{
+    if (m_writer)
+    {
+        return m_writer->Reserve(size);
+    }
+    m_block.resize(size);
+    return m_block.data();
+}
+
+void
+PcapngFile::EndBlock()
+{
+    if (!m_writer)
+    {
+        m_file.write(reinterpret_cast<const char*>(m_block.data()), m_block.size());
+    }
+}
+
+uint32_t
+PcapngFile::GetCapturedLength(uint32_t interfaceId, uint32_t origLen) const
+{
+    NS_ASSERT_MSG(interfaceId < m_interfaces.size(),
+                  "PcapngFile::Write(): unknown interface " << interfaceId);
+    uint32_t snapLen = m_interfaces[interfaceId].snapLen;
+    return (snapLen != 0 && origLen > snapLen) ? snapLen : origLen;
+}
+
+uint8_t*
+PcapngFile::BeginPacket(uint32_t interfaceId, Time t, uint32_t origLen)
+{
+    uint32_t capLen = GetCapturedLength(interfaceId, origLen);
+
+    std::string comment;
+    if (m_comments)
+    {
+        std::ostringstream oss;
+        oss << "interface " << m_interfaces[interfaceId].name << ", context ";
+        if (Simulator::GetContext() == Simulator::NO_CONTEXT)
+        {
+            oss << "none";
+        }
+        else
+        {
+            oss << Simulator::GetContext();
+        }
+        comment = oss.str();
+    }
+
+    uint32_t size = EPB_HEADER_SIZE + Pad(capLen) + TRAILER_SIZE;
+    if (!comment.empty())
+    {
+        size += OptionSize(comment.size()) + OptionSize(0);
+    }
+    uint8_t* p = BeginBlock(size);
+    uint64_t ts = t.GetNanoSeconds();
+    p = Put32(p, ENHANCED_PACKET_BLOCK);
+    p = Put32(p, size);
+    p = Put32(p, interfaceId);
+    p = Put32(p, ts >> 32);
+    p = Put32(p, ts & 0xffffffff);
+    p = Put32(p, capLen);
+    p = Put32(p, origLen);
+    uint8_t* data = p;
+    p += capLen;
+    std::memset(p, 0, Pad(capLen) - capLen);
+    p += Pad(capLen) - capLen;
+    if (!comment.empty())
+    {
+        p = PutOption(p, OPT_COMMENT, comment.data(), comment.size());
+        p = PutEndOfOptions(p);
+    }
+    Put32(p, size);
+    return data;
+}
+
+void
+PcapngFile::Write(uint32_t interfaceId, Time t, Ptr<const Packet> p)
+{
+    NS_LOG_FUNCTION(this << interfaceId << t << p);
+    uint32_t capLen = GetCapturedLength(interfaceId, p->GetSize());
+    p->CopyData(BeginPacket(interfaceId, t, p->GetSize()), capLen);
+    EndBlock();
+}
+
+void
+PcapngFile::Write(uint32_t interfaceId, Time t, const Header& header, Ptr<const Packet> p)
+{
+    NS_LOG_FUNCTION(this << interfaceId << t << &header << p);
+    uint32_t headerSize = header.GetSerializedSize();
+    uint32_t origLen = headerSize + p->GetSize();
+    uint32_t capLen = GetCapturedLength(interfaceId, origLen);
+
+    Buffer headerBuffer;
+    headerBuffer.AddAtStart(headerSize);
+    header.Serialize(headerBuffer.Begin());
+    uint32_t toCopy = std::min(headerSize, capLen);
+
+    uint8_t* data = BeginPacket(interfaceId, t, origLen);
+    headerBuffer.CopyData(data, toCopy);
+    p->CopyData(data + toCopy, capLen - toCopy);
+    EndBlock();
+}
+
+void
+PcapngFile::Write(uint32_t interfaceId, Time t, const uint8_t* buffer, uint32_t length)
+{
+    NS_LOG_FUNCTION(this << interfaceId << t << &buffer << length);
+    uint32_t capLen = GetCapturedLength(interfaceId, length);
+    std::memcpy(BeginPacket(interfaceId, t, length), buffer, capLen);
+    EndBlock();
+}
+
+} // namespace ns3
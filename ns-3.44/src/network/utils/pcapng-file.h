@@ -0,0 +1,180 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef PCAPNG_FILE_H
+#define PCAPNG_FILE_H
+
+#include "flush-on-destroy.h"
+
+#include "ns3/nstime.h"
+#include "ns3/object.h"
+#include "ns3/ptr.h"
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+class AsyncFileWriter;
+class Header;
+class Packet;
+
+/**
+ * @ingroup network
+ *
+ * @brief Writer of a pcapng file gathering the packets of several interfaces.
+ *
+ * Unlike the classic pcap format, which stores a single data link type per
+ * file, a pcapng file holds one Interface Description Block (IDB) per
+ * interface, each with its own data link type and snapshot length, and one
+ * Enhanced Packet Block (EPB) per packet referring to its interface.  This
+ * allows the traces of all the devices of a simulation to be stored in a
+ * single file, which Wireshark and tshark read directly.
+ *
+ * Timestamps are stored with a nanosecond resolution.  When the
+ * "PacketComments" attribute is set, each packet carries a comment with its
+ * interface name and the simulator context (i.e., the node id) of the event
+ * which wrote it.
+ *
+ * Blocks are accumulated in buffers of "WriteBufferSize" bytes written by
+ * the AsyncFileWriter I/O thread; the file is flushed when the simulator is
+ * destroyed.
+ *
+ * See https://www.ietf.org/archive/id/draft-ietf-opsawg-pcapng-02.html
+ */
+class PcapngFile : public Object
+{
+  public:
+    /**
+     * @brief Get the type ID.
+     * @return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    PcapngFile();
+    ~PcapngFile() override;
+
+    /**
+     * Create a new pcapng file and write its Section Header Block.
+     *
+     * @param filename the name of the file
+     */
+    void Open(const std::string& filename);
+
+    /**
+     * Write the pending blocks and close the file.
+     */
+    void Close();
+
+    /**
+     * Write the buffered blocks, if any, to the file.
+     */
+    void Flush();
+
+    /**
+     * @return true if opening or writing the file failed
+     */
+    bool Fail() const;
+
+    /**
+     * @brief Add an interface to the file.
+     *
+     * @param name the interface name, as shown by the pcapng readers
+     * @param dataLinkType the data link type of the packets of the interface
+     * @param snapLen the maximum number of bytes stored per packet
+     * @returns the interface id, to be passed to Write
+     */
+    uint32_t AddInterface(const std::string& name, uint32_t dataLinkType, uint32_t snapLen);
+
+    /**
+     * @returns the number of interfaces of the file
+     */
+    uint32_t GetNInterfaces() const;
+
+    /**
+     * @brief Write a packet.
+     *
+     * @param interfaceId the interface id returned by AddInterface
+     * @param t the packet timestamp
+     * @param p the packet
+     */
+    void Write(uint32_t interfaceId, Time t, Ptr<const Packet> p);
+
+    /**
+     * @brief Write a packet preceded by a header.
+     *
+     * @param interfaceId the interface id returned by AddInterface
+     * @param t the packet timestamp
+     * @param header the header to prepend to the packet
+     * @param p the packet
+     */
+    void Write(uint32_t interfaceId, Time t, const Header& header, Ptr<const Packet> p);
+
+    /**
+     * @brief Write a packet given as a buffer.
+     *
+     * @param interfaceId the interface id returned by AddInterface
+     * @param t the packet timestamp
+     * @param buffer the packet bytes
+     * @param length the size of the buffer
+     */
+    void Write(uint32_t interfaceId, Time t, const uint8_t* buffer, uint32_t length);
+
+  private:
+    /**
+     * @brief An interface described in the file.
+     */
+    struct Interface
+    {
+        std::string name; //!< the interface name
+        uint32_t snapLen; //!< the maximum number of bytes stored per packet
+    };
+
+    /**
+     * @brief Reserve a block at the end of the file.
+     *
+     * The caller must fill the whole block, then call EndBlock, before any
+     * other call on this object.
+     *
+     * @param size the size of the block, in bytes
+     * @returns a pointer to the block
+     */
+    uint8_t* BeginBlock(uint32_t size);
+    /**
+     * @brief Complete the block returned by BeginBlock.
+     */
+    void EndBlock();
+    /**
+     * @brief Write the header of an Enhanced Packet Block, and reserve
+     * space for the packet bytes.
+     *
+     * @param interfaceId the interface id
+     * @param t the packet timestamp
+     * @param origLen the length of the packet
+     * @returns a pointer to the space reserved for the captured bytes
+     */
+    uint8_t* BeginPacket(uint32_t interfaceId, Time t, uint32_t origLen);
+    /**
+     * @param interfaceId the interface id
+     * @param origLen the length of the packet
+     * @returns the number of bytes of the packet stored in the file
+     */
+    uint32_t GetCapturedLength(uint32_t interfaceId, uint32_t origLen) const;
+
+    std::ofstream m_file;                      //!< the output file
+    std::string m_filename;                    //!< the name of the file
+    std::unique_ptr<AsyncFileWriter> m_writer; //!< the write buffer, if any
+    std::vector<uint8_t> m_block;              //!< block being built without write buffer
+    std::vector<Interface> m_interfaces;       //!< the interfaces of the file
+    uint32_t m_writeBufferSize;                //!< size of the write buffers
+    bool m_comments;                           //!< whether packets carry a comment
+    FlushOnDestroy m_flushOnDestroy;           //!< flushes the write buffer at Simulator::Destroy
+};
+
+} // namespace ns3
+
+#endif /* PCAPNG_FILE_H */
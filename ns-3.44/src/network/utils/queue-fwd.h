@@ -7,9 +7,9 @@
 #ifndef QUEUE_FWD_H
 #define QUEUE_FWD_H
 
-#include "ns3/ptr.h"
+#include "ring-buffer.h"
 
-#include <list>
+#include "ns3/ptr.h"
 
 /**
  * @file
@@ -22,7 +22,7 @@ namespace ns3
 
 // Forward declaration of template class Queue specifying
 // the default value for the template template parameter Container
-template <typename Item, typename Container = std::list<Ptr<Item>>>
+template <typename Item, typename Container = RingBuffer<Ptr<Item>>>
 class Queue;
 
 } // namespace ns3
@@ -0,0 +1,458 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+#include "ns3/assert.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup queue
+ * ns3::RingBuffer declaration and template implementation.
+ */
+
+namespace ns3
+{
+
+/**
+ * @ingroup queue
+ *
+ * @brief A sequence container storing its elements in the slots of an array
+ * linked in a ring.
+ *
+ * RingBuffer provides the subset of the std::list interface used by the
+ * Queue class (insert, erase, clear, begin, end and the iterator types) and
+ * by the FIFO queues of the queue discs (push_back, pop_front, front, ...),
+ * and is the default container of Queue. Each element is stored in a slot
+ * of an array, and the slots holding the elements are linked, together with
+ * a sentinel slot marking the end of the sequence, in a circular doubly
+ * linked list. The slots of the erased elements are kept in a free list and
+ * reused by the next insertions. The capacity of the array is doubled when
+ * there is no free slot left, so that, once the buffer has reached the
+ * typical depth of the queue, no memory is allocated to enqueue an item.
+ *
+ * Inserting or erasing an element takes constant time anywhere in the
+ * buffer. As with std::list, an element stays in its slot until it is
+ * erased, hence inserting or erasing an element, or growing the array, does
+ * not invalidate the iterators to the other elements. The capacity is never
+ * reduced, not even by clear.
+ *
+ * @tparam T \explicit Type of the elements
+ */
+template <typename T>
+class RingBuffer
+{
+  private:
+    /**
+     * @brief Bidirectional iterator over the elements of a RingBuffer.
+     *
+     * The iterator stores the index of the slot of the element, hence it is
+     * not invalidated when the array is reallocated.
+     *
+     * @tparam Const whether the elements are accessed through a const reference
+     */
+    template <bool Const>
+    class IteratorImpl
+    {
+      public:
+        using iterator_category = std::bidirectional_iterator_tag; //!< iterator category
+        using value_type = T;                                      //!< value type
+        using difference_type = std::ptrdiff_t;                    //!< difference type
+        using pointer = std::conditional_t<Const, const T*, T*>;   //!< pointer type
+        using reference = std::conditional_t<Const, const T&, T&>; //!< reference type
+        /// Type of the pointer to the buffer
+        using BufferPtr = std::conditional_t<Const, const RingBuffer*, RingBuffer*>;
+
+        /**
+         * Construct a singular iterator.
+         */
+        IteratorImpl()
+            : m_buffer(nullptr),
+              m_slot(SENTINEL)
+        {
+        }
+
+        /**
+         * Construct an iterator.
+         *
+         * @param buffer the buffer
+         * @param slot the index of the slot of the element
+         */
+        IteratorImpl(BufferPtr buffer, std::size_t slot)
+            : m_buffer(buffer),
+              m_slot(slot)
+        {
+        }
+
+        /**
+         * Convert an iterator into a const iterator.
+         *
+         * @param other the iterator
+         */
+        template <bool C = Const, typename = std::enable_if_t<C>>
+        IteratorImpl(const IteratorImpl<false>& other)
+            : m_buffer(other.m_buffer),
+              m_slot(other.m_slot)
+        {
+        }
+
+        /**
+         * @returns the element the iterator points to
+         */
+        reference operator*() const
+        {
+            NS_ASSERT(m_slot != SENTINEL);
+            return m_buffer->m_slots[m_slot].value;
+        }
+
+        /**
+         * @returns a pointer to the element the iterator points to
+         */
+        pointer operator->() const
+        {
+            return &**this;
+        }
+
+        /**
+         * @returns this iterator, moved to the next element
+         */
+        IteratorImpl& operator++()
+        {
+            m_slot = m_buffer->m_slots[m_slot].next;
+            return *this;
+        }
+
+        /**
+         * @returns a copy of this iterator before moving it to the next element
+         */
+        IteratorImpl operator++(int)
+        {
+            IteratorImpl tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        /**
+         * @returns this iterator, moved to the previous element
+         */
+        IteratorImpl& operator--()
+        {
+            m_slot = m_buffer->m_slots[m_slot].prev;
+            return *this;
+        }
+
+        /**
+         * @returns a copy of this iterator before moving it to the previous element
+         */
+        IteratorImpl operator--(int)
+        {
+            IteratorImpl tmp = *this;
+            --*this;
+            return tmp;
+        }
+
+        /**
+         * @param other another iterator
+         * @returns true if both iterators point to the same element
+         */
+        bool operator==(const IteratorImpl& other) const
+        {
+            return m_buffer == other.m_buffer && m_slot == other.m_slot;
+        }
+
+      private:
+        friend class RingBuffer;
+        friend class IteratorImpl<!Const>;
+
+        BufferPtr m_buffer; //!< the buffer
+        std::size_t m_slot; //!< the index of the slot of the element
+    };
+
+  public:
+    using value_type = T;                      //!< value type
+    using size_type = std::size_t;             //!< size type
+    using difference_type = std::ptrdiff_t;    //!< difference type
+    using reference = T&;                      //!< reference type
+    using const_reference = const T&;          //!< const reference type
+    using iterator = IteratorImpl<false>;      //!< iterator
+    using const_iterator = IteratorImpl<true>; //!< const iterator
+
+    RingBuffer()
+        : m_slots(1),
+          m_free(SENTINEL),
+          m_size(0)
+    {
+    }
+
+    /**
+     * @returns an iterator to the first element
+     */
+    iterator begin()
+    {
+        return iterator(this, m_slots[SENTINEL].next);
+    }
+
+    /**
+     * @returns a const iterator to the first element
+     */
+    const_iterator begin() const
+    {
+        return const_iterator(this, m_slots[SENTINEL].next);
+    }
+
+    /**
+     * @returns a const iterator to the first element
+     */
+    const_iterator cbegin() const
+    {
+        return begin();
+    }
+
+    /**
+     * @returns an iterator past the last element
+     */
+    iterator end()
+    {
+        return iterator(this, SENTINEL);
+    }
+
+    /**
+     * @returns a const iterator past the last element
+     */
+    const_iterator end() const
+    {
+        return const_iterator(this, SENTINEL);
+    }
+
+    /**
+     * @returns a const iterator past the last element
+     */
+    const_iterator cend() const
+    {
+        return end();
+    }
+
+    /**
+     * @returns the number of elements
+     */
+    size_type size() const
+    {
+        return m_size;
+    }
+
+    /**
+     * @returns true if the buffer has no element
+     */
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    /**
+     * @returns the number of elements the buffer can store before growing
+     */
+    size_type capacity() const
+    {
+        return m_slots.size() - 1;
+    }
+
+    /**
+     * @brief Make the buffer able to store the given number of elements without growing.
+     *
+     * @param n the number of elements
+     */
+    void reserve(size_type n)
+    {
+        if (n > capacity())
+        {
+            size_type capacity = std::max<size_type>(this->capacity(), 1);
+            while (capacity < n)
+            {
+                capacity *= 2;
+            }
+            Grow(capacity);
+        }
+    }
+
+    /**
+     * @returns the first element
+     */
+    reference front()
+    {
+        NS_ASSERT(m_size > 0);
+        return *begin();
+    }
+
+    /**
+     * @returns the first element
+     */
+    const_reference front() const
+    {
+        NS_ASSERT(m_size > 0);
+        return *begin();
+    }
+
+    /**
+     * @returns the last element
+     */
+    reference back()
+    {
+        NS_ASSERT(m_size > 0);
+        return *--end();
+    }
+
+    /**
+     * @returns the last element
+     */
+    const_reference back() const
+    {
+        NS_ASSERT(m_size > 0);
+        return *--end();
+    }
+
+    /**
+     * @brief Append an element.
+     *
+     * @param value the element
+     */
+    void push_back(const T& value)
+    {
+        insert(end(), value);
+    }
+
+    /**
+     * @brief Prepend an element.
+     *
+     * @param value the element
+     */
+    void push_front(const T& value)
+    {
+        insert(begin(), value);
+    }
+
+    /**
+     * @brief Remove the first element.
+     */
+    void pop_front()
+    {
+        NS_ASSERT(m_size > 0);
+        erase(begin());
+    }
+
+    /**
+     * @brief Remove the last element.
+     */
+    void pop_back()
+    {
+        NS_ASSERT(m_size > 0);
+        erase(--end());
+    }
+
+    /**
+     * @brief Insert an element before the given position.
+     *
+     * No iterator is invalidated.
+     *
+     * @param pos the position
+     * @param value the element
+     * @returns an iterator to the inserted element
+     */
+    iterator insert(const_iterator pos, const T& value)
+    {
+        NS_ASSERT(pos.m_buffer == this);
+        if (m_free == SENTINEL)
+        {
+            Grow(std::max(INITIAL_CAPACITY, 2 * capacity()));
+        }
+        std::size_t slot = m_free;
+        m_free = m_slots[slot].next;
+        m_slots[slot].value = value;
+        std::size_t next = pos.m_slot;
+        std::size_t prev = m_slots[next].prev;
+        m_slots[slot].prev = prev;
+        m_slots[slot].next = next;
+        m_slots[prev].next = slot;
+        m_slots[next].prev = slot;
+        ++m_size;
+        return iterator(this, slot);
+    }
+
+    /**
+     * @brief Erase the element at the given position.
+     *
+     * Only the iterators to the erased element are invalidated.
+     *
+     * @param pos the position
+     * @returns an iterator to the element that followed the erased one
+     */
+    iterator erase(const_iterator pos)
+    {
+        NS_ASSERT(pos.m_buffer == this && pos.m_slot != SENTINEL);
+        std::size_t slot = pos.m_slot;
+        std::size_t prev = m_slots[slot].prev;
+        std::size_t next = m_slots[slot].next;
+        m_slots[prev].next = next;
+        m_slots[next].prev = prev;
+        m_slots[slot].value = T();
+        m_slots[slot].next = m_free;
+        m_free = slot;
+        --m_size;
+        return iterator(this, next);
+    }
+
+    /**
+     * @brief Remove all the elements, keeping the capacity.
+     */
+    void clear()
+    {
+        while (m_size > 0)
+        {
+            pop_back();
+        }
+    }
+
+  private:
+    /// A slot of the array
+    struct Slot
+    {
+        T value{};           //!< the element, if the slot is in use
+        std::size_t prev{0}; //!< the previous slot in the ring
+        std::size_t next{0}; //!< the next slot in the ring, or in the free list
+    };
+
+    /**
+     * @brief Add free slots at the end of the array.
+     *
+     * @param capacity the new capacity
+     */
+    void Grow(std::size_t capacity)
+    {
+        NS_ASSERT(capacity > this->capacity());
+        std::size_t first = m_slots.size();
+        m_slots.resize(capacity + 1);
+        for (std::size_t slot = capacity; slot >= first; --slot)
+        {
+            m_slots[slot].next = m_free;
+            m_free = slot;
+        }
+    }
+
+    static constexpr std::size_t SENTINEL = 0;         //!< index of the slot marking the end
+    static constexpr std::size_t INITIAL_CAPACITY = 8; //!< capacity of the first array
+
+    std::vector<Slot> m_slots; //!< the slots, the first one being the sentinel
+    std::size_t m_free;        //!< index of the first free slot, or SENTINEL if none
+    std::size_t m_size;        //!< the number of elements
+};
+
+} // namespace ns3
+
+#endif /* RING_BUFFER_H */
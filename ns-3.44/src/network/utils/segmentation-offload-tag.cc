@@ -0,0 +1,102 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "segmentation-offload-tag.h"
+
+#include "ns3/log.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("SegmentationOffloadTag");
+
+NS_OBJECT_ENSURE_REGISTERED(SegmentationOffloadTag);
+
+TypeId
+SegmentationOffloadTag::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::SegmentationOffloadTag")
+                            .SetParent<Tag>()
+                            .SetGroupName("Network")
+                            .AddConstructor<SegmentationOffloadTag>();
+    return tid;
+}
+
+TypeId
+SegmentationOffloadTag::GetInstanceTypeId() const
+{
+    return GetTypeId();
+}
+
+uint32_t
+SegmentationOffloadTag::GetSerializedSize() const
+{
+    return 8;
+}
+
+void
+SegmentationOffloadTag::Serialize(TagBuffer buf) const
+{
+    buf.WriteU32(m_segmentSize);
+    buf.WriteU32(m_payloadSize);
+}
+
+void
+SegmentationOffloadTag::Deserialize(TagBuffer buf)
+{
+    m_segmentSize = buf.ReadU32();
+    m_payloadSize = buf.ReadU32();
+}
+
+void
+SegmentationOffloadTag::Print(std::ostream& os) const
+{
+    os << "SegmentSize=" << m_segmentSize << " PayloadSize=" << m_payloadSize;
+}
+
+SegmentationOffloadTag::SegmentationOffloadTag()
+    : Tag(),
+      m_segmentSize(0),
+      m_payloadSize(0)
+{
+}
+
+SegmentationOffloadTag::SegmentationOffloadTag(uint32_t segmentSize, uint32_t payloadSize)
+    : Tag(),
+      m_segmentSize(segmentSize),
+      m_payloadSize(payloadSize)
+{
+    NS_ASSERT(segmentSize > 0);
+}
+
+uint32_t
+SegmentationOffloadTag::GetSegmentSize() const
+{
+    return m_segmentSize;
+}
+
+uint32_t
+SegmentationOffloadTag::GetPayloadSize() const
+{
+    return m_payloadSize;
+}
+
+uint32_t
+SegmentationOffloadTag::GetSegmentCount() const
+{
+    return (m_payloadSize + m_segmentSize - 1) / m_segmentSize;
+}
+
+uint32_t
+SegmentationOffloadTag::GetWireSize(uint32_t size) const
+{
+    if (size <= m_payloadSize)
+    {
+        return size;
+    }
+    uint32_t headerSize = size - m_payloadSize;
+    return m_payloadSize + GetSegmentCount() * headerSize;
+}
+
+} // namespace ns3
@@ -0,0 +1,87 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef SEGMENTATION_OFFLOAD_TAG_H
+#define SEGMENTATION_OFFLOAD_TAG_H
+
+#include "ns3/tag.h"
+
+namespace ns3
+{
+
+/**
+ * @ingroup network
+ *
+ * @brief Packet tag marking a super-segment, i.e., a packet standing for
+ * several segments of a transport protocol, as produced by segmentation
+ * offload (TSO/GSO).
+ *
+ * A transport protocol emulating segmentation offload sends the payload of
+ * several segments in a single packet, larger than the MTU, which carries
+ * this tag and the headers of the first segment. The network layer does not
+ * fragment such packets when the output device supports segmentation offload
+ * (see NetDevice::SupportsSegmentationOffload), and the device transmits the
+ * packet in the time it takes to transmit the segments, each one with a copy
+ * of the headers (see GetWireSize). The receiving transport protocol
+ * handles the packet as a single segment holding the whole payload: e.g.,
+ * TcpSocketBase acknowledges it at once, without delaying the ACK, as receive
+ * offload (GRO) would do for the burst of its segments, so the receiver sends
+ * one ACK instead of one every DelAckCount segments.
+ */
+class SegmentationOffloadTag : public Tag
+{
+  public:
+    /**
+     * @brief Get the type ID.
+     * @return the object TypeId
+     */
+    static TypeId GetTypeId();
+    TypeId GetInstanceTypeId() const override;
+    uint32_t GetSerializedSize() const override;
+    void Serialize(TagBuffer buf) const override;
+    void Deserialize(TagBuffer buf) override;
+    void Print(std::ostream& os) const override;
+    SegmentationOffloadTag();
+
+    /**
+     * Constructs a SegmentationOffloadTag
+     *
+     * @param segmentSize the payload size of the segments
+     * @param payloadSize the payload size of the super-segment
+     */
+    SegmentationOffloadTag(uint32_t segmentSize, uint32_t payloadSize);
+
+    /**
+     * @returns the payload size of the segments
+     */
+    uint32_t GetSegmentSize() const;
+    /**
+     * @returns the payload size of the super-segment
+     */
+    uint32_t GetPayloadSize() const;
+    /**
+     * @returns the number of segments of the super-segment
+     */
+    uint32_t GetSegmentCount() const;
+
+    /**
+     * @brief Get the number of bytes sent on the wire for a packet carrying the tag.
+     *
+     * The packet holds the payload of the super-segment and the headers,
+     * which are sent with each segment. The fragments of a super-segment
+     * (smaller than its payload) are sent as they are.
+     *
+     * @param size the size of the packet, headers included
+     * @returns the size of the segments, headers included
+     */
+    uint32_t GetWireSize(uint32_t size) const;
+
+  private:
+    uint32_t m_segmentSize; //!< Payload size of the segments
+    uint32_t m_payloadSize; //!< Payload size of the super-segment
+};
+
+} // namespace ns3
+
+#endif /* SEGMENTATION_OFFLOAD_TAG_H */
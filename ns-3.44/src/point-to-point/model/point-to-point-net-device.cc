@@ -9,12 +9,15 @@
 #include "point-to-point-channel.h"
 #include "ppp-header.h"
 
+#include "ns3/abort.h"
 #include "ns3/error-model.h"
 #include "ns3/llc-snap-header.h"
 #include "ns3/log.h"
 #include "ns3/mac48-address.h"
 #include "ns3/pointer.h"
+#include "ns3/queue-item.h"
 #include "ns3/queue.h"
+#include "ns3/segmentation-offload-tag.h"
 #include "ns3/simulator.h"
 #include "ns3/trace-source-accessor.h"
 #include "ns3/uinteger.h"
@@ -60,6 +63,13 @@ PointToPointNetDevice::GetTypeId()
                           TimeValue(Seconds(0)),
                           MakeTimeAccessor(&PointToPointNetDevice::m_tInterframeGap),
                           MakeTimeChecker())
+            .AddAttribute("MaxBurstSize",
+                          "The maximum number of packets transmitted back to back as a single "
+                          "train, which the traffic control layer can also hand at once to the "
+                          "device (1 disables the bursts)",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&PointToPointNetDevice::m_maxBurstSize),
+                          MakeUintegerChecker<uint32_t>(1))
 
             //
             // Transmit queueing discipline for the device which includes its own set
@@ -204,6 +214,7 @@ PointToPointNetDevice::DoDispose()
     m_channel = nullptr;
     m_receiveErrorModel = nullptr;
     m_currentPkt = nullptr;
+    m_burst.clear();
     m_queue = nullptr;
     NetDevice::DoDispose();
 }
@@ -236,15 +247,61 @@ PointToPointNetDevice::TransmitStart(Ptr<Packet> p)
     NS_ASSERT_MSG(m_txMachineState == READY, "Must be READY to transmit");
     m_txMachineState = BUSY;
     m_currentPkt = p;
-    m_phyTxBeginTrace(m_currentPkt);
 
-    Time txTime = m_bps.CalculateBytesTxTime(p->GetSize());
-    Time txCompleteTime = txTime + m_tInterframeGap;
+    Time txCompleteTime;
+    bool result = TransmitPacket(p, txCompleteTime);
+
+    //
+    // The next packets of the queue, up to MaxBurstSize, are transmitted back
+    // to back as a single train, whose transmission completes at once.
+    //
+    while (m_burst.size() + 1 < m_maxBurstSize)
+    {
+        Ptr<Packet> next = m_queue->Dequeue();
+        if (!next)
+        {
+            break;
+        }
+        m_snifferTrace(next);
+        m_promiscSnifferTrace(next);
+        m_burst.push_back(next);
+        TransmitPacket(next, txCompleteTime);
+    }
 
     NS_LOG_LOGIC("Schedule TransmitCompleteEvent in " << txCompleteTime.As(Time::S));
     Simulator::Schedule(txCompleteTime, &PointToPointNetDevice::TransmitComplete, this);
+    return result;
+}
 
-    bool result = m_channel->TransmitStart(p, this, txTime);
+bool
+PointToPointNetDevice::TransmitPacket(Ptr<Packet> p, Time& offset)
+{
+    NS_LOG_FUNCTION(this << p << offset.As(Time::S));
+    m_phyTxBeginTrace(p);
+
+    uint32_t wireSize = p->GetSize();
+    uint32_t nFrames = 1;
+    SegmentationOffloadTag offloadTag;
+    if (p->PeekPacketTag(offloadTag) && wireSize > offloadTag.GetPayloadSize())
+    {
+        // A super-segment is sent as the segments it stands for
+        wireSize = offloadTag.GetWireSize(wireSize);
+        nFrames = offloadTag.GetSegmentCount();
+    }
+    // The fluid flows take part of the data rate, which may have been lowered
+    // since SetFluidLoad checked it
+    NS_ABORT_MSG_IF(m_fluidRate >= m_bps,
+                    "The fluid load (" << m_fluidRate << ") exceeds the data rate (" << m_bps
+                                       << ")");
+    DataRate bps(m_bps.GetBitRate() - m_fluidRate.GetBitRate());
+    Time txTime = bps.CalculateBytesTxTime(wireSize) + (nFrames - 1) * m_tInterframeGap;
+
+    // The packet is delayed by the fluid backlog, but not beyond the previous packet
+    Time rxTime = Max(Simulator::Now() + offset + txTime + m_fluidDelay, m_lastRxTime);
+    m_lastRxTime = rxTime;
+    offset += txTime + m_tInterframeGap;
+
+    bool result = m_channel->TransmitStart(p, this, rxTime - Simulator::Now());
     if (!result)
     {
         m_phyTxDropTrace(p);
@@ -270,6 +327,11 @@ PointToPointNetDevice::TransmitComplete()
 
     m_phyTxEndTrace(m_currentPkt);
     m_currentPkt = nullptr;
+    for (const auto& packet : m_burst)
+    {
+        m_phyTxEndTrace(packet);
+    }
+    m_burst.clear();
 
     Ptr<Packet> p = m_queue->Dequeue();
     if (!p)
@@ -505,6 +567,56 @@ PointToPointNetDevice::Send(Ptr<Packet> packet, const Address& dest, uint16_t pr
     NS_LOG_LOGIC("p=" << packet << ", dest=" << &dest);
     NS_LOG_LOGIC("UID is " << packet->GetUid());
 
+    if (!EnqueuePacket(packet, protocolNumber))
+    {
+        return false;
+    }
+
+    //
+    // If the channel is ready for transition we send the packet right now
+    //
+    if (m_txMachineState == READY)
+    {
+        packet = m_queue->Dequeue();
+        m_snifferTrace(packet);
+        m_promiscSnifferTrace(packet);
+        bool ret = TransmitStart(packet);
+        return ret;
+    }
+    return true;
+}
+
+void
+PointToPointNetDevice::SendBurst(const std::vector<Ptr<QueueDiscItem>>& items)
+{
+    NS_LOG_FUNCTION(this << items.size());
+
+    //
+    // The whole burst is enqueued before the transmission starts, so that the
+    // packets are transmitted as a single train.
+    //
+    for (const auto& item : items)
+    {
+        EnqueuePacket(item->GetPacket(), item->GetProtocol());
+    }
+
+    if (m_txMachineState == READY)
+    {
+        Ptr<Packet> packet = m_queue->Dequeue();
+        if (packet)
+        {
+            m_snifferTrace(packet);
+            m_promiscSnifferTrace(packet);
+            TransmitStart(packet);
+        }
+    }
+}
+
+bool
+PointToPointNetDevice::EnqueuePacket(Ptr<Packet> packet, uint16_t protocolNumber)
+{
+    NS_LOG_FUNCTION(this << packet << protocolNumber);
+
     //
     // If IsLinkUp() is false it means there is no channel to send any packet
     // over so we just hit the drop trace on the packet and return an error.
@@ -528,17 +640,6 @@ PointToPointNetDevice::Send(Ptr<Packet> packet, const Address& dest, uint16_t pr
     //
     if (m_queue->Enqueue(packet))
     {
-        //
-        // If the channel is ready for transition we send the packet right now
-        //
-        if (m_txMachineState == READY)
-        {
-            packet = m_queue->Dequeue();
-            m_snifferTrace(packet);
-            m_promiscSnifferTrace(packet);
-            bool ret = TransmitStart(packet);
-            return ret;
-        }
         return true;
     }
 
@@ -597,6 +698,28 @@ PointToPointNetDevice::SupportsSendFrom() const
     return false;
 }
 
+bool
+PointToPointNetDevice::SupportsSegmentationOffload() const
+{
+    return true;
+}
+
+uint32_t
+PointToPointNetDevice::GetMaxBurstSize() const
+{
+    return m_maxBurstSize;
+}
+
+bool
+PointToPointNetDevice::SetFluidLoad(DataRate rate, Time delay)
+{
+    NS_LOG_FUNCTION(this << rate << delay);
+    NS_ABORT_MSG_IF(rate >= m_bps, "The fluid flows must leave some capacity to the packets");
+    m_fluidRate = rate;
+    m_fluidDelay = delay;
+    return true;
+}
+
 void
 PointToPointNetDevice::DoMpiReceive(Ptr<Packet> p)
 {
@@ -20,6 +20,7 @@
 #include "ns3/traced-callback.h"
 
 #include <cstring>
+#include <vector>
 
 namespace ns3
 {
@@ -48,6 +49,23 @@ class ErrorModel;
  * Key parameters or objects that can be specified for this device
  * include a queue, data rate, and interframe transmission gap (the
  * propagation delay is set in the PointToPointChannel).
+ *
+ * The device supports segmentation offload: a super-segment (a packet
+ * carrying a SegmentationOffloadTag) is transmitted in the time it takes to
+ * transmit the segments it stands for, each one with its headers and
+ * followed by an interframe gap.
+ *
+ * The device also models the load of fluid flows (see SetFluidLoad): the
+ * packets are transmitted at the data rate left by the fluid flows, and
+ * received after the queueing delay added by the fluid flows.
+ *
+ * When the MaxBurstSize attribute is greater than 1, the device transmits
+ * up to MaxBurstSize packets of its queue back to back as a single train,
+ * with a single event for the end of the train, and the traffic control
+ * layer can hand it bursts of packets (see SendBurst). The packets are
+ * received at the same time as if they were transmitted one by one, but
+ * they are dequeued from the device queue, and the PhyTxBegin and PhyTxEnd
+ * traces are fired, at the beginning and at the end of the train.
  */
 class PointToPointNetDevice : public NetDevice
 {
@@ -186,6 +204,10 @@ class PointToPointNetDevice : public NetDevice
 
     void SetPromiscReceiveCallback(PromiscReceiveCallback cb) override;
     bool SupportsSendFrom() const override;
+    bool SupportsSegmentationOffload() const override;
+    bool SetFluidLoad(DataRate rate, Time delay) override;
+    uint32_t GetMaxBurstSize() const override;
+    void SendBurst(const std::vector<Ptr<QueueDiscItem>>& items) override;
 
   protected:
     /**
@@ -225,6 +247,15 @@ class PointToPointNetDevice : public NetDevice
      */
     bool ProcessHeader(Ptr<Packet> p, uint16_t& param);
 
+    /**
+     * Add the headers to a packet and enqueue it in the transmit queue,
+     * firing the drop trace if the link is down or the queue is full.
+     * @param packet packet
+     * @param protocolNumber protocol number
+     * @return true if the packet was enqueued
+     */
+    bool EnqueuePacket(Ptr<Packet> packet, uint16_t protocolNumber);
+
     /**
      * Start Sending a Packet Down the Wire.
      *
@@ -242,6 +273,17 @@ class PointToPointNetDevice : public NetDevice
      */
     bool TransmitStart(Ptr<Packet> p);
 
+    /**
+     * Pass a packet of the train being transmitted to the channel.
+     *
+     * @param p the packet
+     * @param offset the time, from now, at which the transmission of the
+     *        packet starts, which is advanced to the end of its transmission
+     *        and of the following interframe gap
+     * @returns true if success, false on failure
+     */
+    bool TransmitPacket(Ptr<Packet> p, Time& offset);
+
     /**
      * Stop Sending a Packet Down the Wire and Begin the Interframe Gap.
      *
@@ -283,6 +325,28 @@ class PointToPointNetDevice : public NetDevice
      */
     Time m_tInterframeGap;
 
+    /**
+     * The aggregate rate of the fluid flows sent through the device, which
+     * is not available to the packets
+     */
+    DataRate m_fluidRate;
+
+    /**
+     * The queueing delay added by the fluid flows to the packets
+     */
+    Time m_fluidDelay;
+
+    /**
+     * The time the last packet sent is received by the peer, so that the
+     * packets are not reordered when the delay of the fluid flows decreases
+     */
+    Time m_lastRxTime;
+
+    /**
+     * The maximum number of packets transmitted back to back as a single train
+     */
+    uint32_t m_maxBurstSize;
+
     /**
      * The PointToPointChannel to which this PointToPointNetDevice has been
      * attached.
@@ -431,7 +495,8 @@ class PointToPointNetDevice : public NetDevice
      */
     uint32_t m_mtu;
 
-    Ptr<Packet> m_currentPkt; //!< Current packet processed
+    Ptr<Packet> m_currentPkt;         //!< Current packet processed
+    std::vector<Ptr<Packet>> m_burst; //!< Packets transmitted after the current one, in a train
 
     /**
      * @brief PPP to Ethernet protocol number mapping
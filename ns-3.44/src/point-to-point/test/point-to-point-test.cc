@@ -6,14 +6,18 @@
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
 
+#include "ns3/data-rate.h"
 #include "ns3/drop-tail-queue.h"
 #include "ns3/net-device-queue-interface.h"
 #include "ns3/point-to-point-channel.h"
 #include "ns3/point-to-point-net-device.h"
+#include "ns3/queue-item.h"
 #include "ns3/simulator.h"
 #include "ns3/test.h"
+#include "ns3/uinteger.h"
 
 #include <string>
+#include <vector>
 
 using namespace ns3;
 
@@ -128,6 +132,161 @@ PointToPointTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @brief Queue disc item used to hand bursts of packets to the device
+ */
+class PointToPointBurstTestItem : public QueueDiscItem
+{
+  public:
+    /**
+     * @brief Constructor
+     *
+     * @param p the packet stored in this item
+     */
+    PointToPointBurstTestItem(Ptr<Packet> p);
+
+    void AddHeader() override;
+    bool Mark() override;
+};
+
+PointToPointBurstTestItem::PointToPointBurstTestItem(Ptr<Packet> p)
+    : QueueDiscItem(p, Mac48Address(), 0x800)
+{
+}
+
+void
+PointToPointBurstTestItem::AddHeader()
+{
+}
+
+bool
+PointToPointBurstTestItem::Mark()
+{
+    return false;
+}
+
+/**
+ * @brief Test the transmission of trains of packets
+ *
+ * A burst of six packets is handed to a device whose MaxBurstSize is 4: the
+ * packets must be received at the same time as if they were transmitted one
+ * by one, while the transmission of the first four packets, and then of the
+ * last two, completes at once.
+ */
+class PointToPointBurstTest : public TestCase
+{
+  public:
+    /**
+     * @brief Create the test
+     */
+    PointToPointBurstTest();
+
+    /**
+     * @brief Run the test
+     */
+    void DoRun() override;
+
+  private:
+    /**
+     * @brief Record the reception of a packet
+     *
+     * @param dev The receiving device.
+     * @param pkt The received packet.
+     * @param mode The protocol mode used.
+     * @param sender The sender address.
+     *
+     * @return true
+     */
+    bool RxPacket(Ptr<NetDevice> dev, Ptr<const Packet> pkt, uint16_t mode, const Address& sender);
+
+    /**
+     * @brief Record the end of the transmission of a packet
+     *
+     * @param pkt The transmitted packet.
+     */
+    void PhyTxEnd(Ptr<const Packet> pkt);
+
+    std::vector<Time> m_rxTimes;    //!< The reception times
+    std::vector<Time> m_txEndTimes; //!< The times the transmissions completed
+};
+
+PointToPointBurstTest::PointToPointBurstTest()
+    : TestCase("PointToPoint bursts")
+{
+}
+
+bool
+PointToPointBurstTest::RxPacket(Ptr<NetDevice> dev,
+                                Ptr<const Packet> pkt,
+                                uint16_t mode,
+                                const Address& sender)
+{
+    m_rxTimes.push_back(Simulator::Now());
+    return true;
+}
+
+void
+PointToPointBurstTest::PhyTxEnd(Ptr<const Packet> pkt)
+{
+    m_txEndTimes.push_back(Simulator::Now());
+}
+
+void
+PointToPointBurstTest::DoRun()
+{
+    Ptr<Node> a = CreateObject<Node>();
+    Ptr<Node> b = CreateObject<Node>();
+    Ptr<PointToPointNetDevice> devA = CreateObject<PointToPointNetDevice>();
+    Ptr<PointToPointNetDevice> devB = CreateObject<PointToPointNetDevice>();
+    Ptr<PointToPointChannel> channel = CreateObject<PointToPointChannel>();
+    channel->SetAttribute("Delay", TimeValue(MilliSeconds(1)));
+
+    devA->SetAttribute("DataRate", DataRateValue(DataRate("8Mbps")));
+    devA->SetAttribute("MaxBurstSize", UintegerValue(4));
+    devA->Attach(channel);
+    devA->SetAddress(Mac48Address::Allocate());
+    devA->SetQueue(CreateObject<DropTailQueue<Packet>>());
+    devB->Attach(channel);
+    devB->SetAddress(Mac48Address::Allocate());
+    devB->SetQueue(CreateObject<DropTailQueue<Packet>>());
+
+    a->AddDevice(devA);
+    b->AddDevice(devB);
+
+    devB->SetReceiveCallback(MakeCallback(&PointToPointBurstTest::RxPacket, this));
+    devA->TraceConnectWithoutContext("PhyTxEnd",
+                                     MakeCallback(&PointToPointBurstTest::PhyTxEnd, this));
+
+    NS_TEST_EXPECT_MSG_EQ(devA->GetMaxBurstSize(), 4, "Wrong maximum burst size");
+
+    // 998 bytes and the 2-byte PPP header take 1 ms at 8 Mbps
+    std::vector<Ptr<QueueDiscItem>> items;
+    for (uint32_t i = 0; i < 6; i++)
+    {
+        items.push_back(Create<PointToPointBurstTestItem>(Create<Packet>(998)));
+    }
+    Simulator::Schedule(Seconds(1), &PointToPointNetDevice::SendBurst, devA, items);
+
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ(m_rxTimes.size(), 6, "All the packets must have been received");
+    for (uint32_t i = 0; i < 6; i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_rxTimes[i],
+                              Seconds(1) + MilliSeconds(i + 2),
+                              "Packet " << i << " received at the wrong time");
+    }
+    NS_TEST_ASSERT_MSG_EQ(m_txEndTimes.size(), 6, "All the packets must have been transmitted");
+    for (uint32_t i = 0; i < 6; i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_txEndTimes[i],
+                              Seconds(1) + MilliSeconds(i < 4 ? 4 : 6),
+                              "Packet " << i << " transmitted at the wrong time");
+    }
+
+    Simulator::Destroy();
+}
+
 /**
  * @brief TestSuite for PointToPoint module
  */
@@ -144,6 +303,7 @@ PointToPointTestSuite::PointToPointTestSuite()
     : TestSuite("devices-point-to-point", Type::UNIT)
 {
     AddTestCase(new PointToPointTest, TestCase::Duration::QUICK);
+    AddTestCase(new PointToPointBurstTest, TestCase::Duration::QUICK);
 }
 
 static PointToPointTestSuite g_pointToPointTestSuite; //!< The testsuite
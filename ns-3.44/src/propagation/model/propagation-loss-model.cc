@@ -18,7 +18,9 @@
 #include "ns3/pointer.h"
 #include "ns3/string.h"
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 
 namespace ns3
 {
@@ -71,6 +73,28 @@ PropagationLossModel::CalcRxPower(double txPowerDbm,
     return self;
 }
 
+double
+PropagationLossModel::CalcMaxRange(double txPowerDbm, double rxPowerDbm) const
+{
+    double self = DoCalcMaxRange(txPowerDbm, rxPowerDbm);
+    if (m_next)
+    {
+        double next = m_next->CalcMaxRange(txPowerDbm, rxPowerDbm);
+        if (std::isinf(self) || std::isinf(next))
+        {
+            return std::numeric_limits<double>::infinity();
+        }
+        self = std::min(self, next);
+    }
+    return self;
+}
+
+double
+PropagationLossModel::DoCalcMaxRange(double txPowerDbm, double rxPowerDbm) const
+{
+    return std::numeric_limits<double>::infinity();
+}
+
 int64_t
 PropagationLossModel::AssignStreams(int64_t stream)
 {
@@ -272,6 +296,22 @@ FriisPropagationLossModel::DoCalcRxPower(double txPowerDbm,
     return txPowerDbm - std::max(lossDb, m_minLoss);
 }
 
+double
+FriisPropagationLossModel::DoCalcMaxRange(double txPowerDbm, double rxPowerDbm) const
+{
+    if (m_minLoss < 0)
+    {
+        return std::numeric_limits<double>::infinity();
+    }
+    if (txPowerDbm - m_minLoss < rxPowerDbm)
+    {
+        return 0;
+    }
+    // distance at which the loss of the Friis equation equals txPowerDbm - rxPowerDbm
+    return m_lambda / (4 * M_PI * std::sqrt(m_systemLoss)) *
+           std::pow(10.0, (txPowerDbm - rxPowerDbm) / 20);
+}
+
 int64_t
 FriisPropagationLossModel::DoAssignStreams(int64_t stream)
 {
@@ -549,6 +589,21 @@ LogDistancePropagationLossModel::DoCalcRxPower(double txPowerDbm,
     return txPowerDbm + rxc;
 }
 
+double
+LogDistancePropagationLossModel::DoCalcMaxRange(double txPowerDbm, double rxPowerDbm) const
+{
+    if (m_referenceLoss < 0 || m_exponent <= 0)
+    {
+        return std::numeric_limits<double>::infinity();
+    }
+    if (txPowerDbm - m_referenceLoss < rxPowerDbm)
+    {
+        return 0;
+    }
+    return m_referenceDistance *
+           std::pow(10.0, (txPowerDbm - m_referenceLoss - rxPowerDbm) / (10 * m_exponent));
+}
+
 int64_t
 LogDistancePropagationLossModel::DoAssignStreams(int64_t stream)
 {
@@ -648,6 +703,39 @@ ThreeLogDistancePropagationLossModel::DoCalcRxPower(double txPowerDbm,
     return txPowerDbm - pathLossDb;
 }
 
+double
+ThreeLogDistancePropagationLossModel::DoCalcMaxRange(double txPowerDbm, double rxPowerDbm) const
+{
+    if (m_referenceLoss < 0 || m_exponent0 < 0 || m_exponent1 < 0 || m_exponent2 <= 0)
+    {
+        return std::numeric_limits<double>::infinity();
+    }
+
+    // the loss at the beginning of each field, which never decreases with the distance
+    double maxLossDb = txPowerDbm - rxPowerDbm;
+    double loss0 = m_referenceLoss;
+    double loss1 = loss0 + 10 * m_exponent0 * std::log10(m_distance1 / m_distance0);
+    double loss2 = loss1 + 10 * m_exponent1 * std::log10(m_distance2 / m_distance1);
+
+    if (maxLossDb < 0)
+    {
+        return 0;
+    }
+    if (maxLossDb < loss0)
+    {
+        return m_distance0;
+    }
+    if (maxLossDb < loss1)
+    {
+        return m_distance0 * std::pow(10.0, (maxLossDb - loss0) / (10 * m_exponent0));
+    }
+    if (maxLossDb < loss2)
+    {
+        return m_distance1 * std::pow(10.0, (maxLossDb - loss1) / (10 * m_exponent1));
+    }
+    return m_distance2 * std::pow(10.0, (maxLossDb - loss2) / (10 * m_exponent2));
+}
+
 int64_t
 ThreeLogDistancePropagationLossModel::DoAssignStreams(int64_t stream)
 {
@@ -943,6 +1031,16 @@ RangePropagationLossModel::DoCalcRxPower(double txPowerDbm,
     }
 }
 
+double
+RangePropagationLossModel::DoCalcMaxRange(double txPowerDbm, double rxPowerDbm) const
+{
+    if (rxPowerDbm <= -1000)
+    {
+        return std::numeric_limits<double>::infinity();
+    }
+    return txPowerDbm < rxPowerDbm ? 0 : m_range;
+}
+
 int64_t
 RangePropagationLossModel::DoAssignStreams(int64_t stream)
 {
@@ -90,6 +90,23 @@ class PropagationLossModel : public Object
      */
     double CalcRxPower(double txPowerDbm, Ptr<MobilityModel> a, Ptr<MobilityModel> b) const;
 
+    /**
+     * Returns a distance beyond which the Rx Power, taking into account all
+     * the PropagationLossModel(s) chained to the current one, is always lower
+     * than the given power. This lets the channels skip the receivers which
+     * cannot receive the signal, without computing their Rx power.
+     *
+     * The distance of a chain is the smallest distance of its models, which
+     * assumes that the models with a finite distance never increase the power
+     * of the signal; the models which may increase it, or which do not know
+     * such a distance, return an infinite distance for the whole chain.
+     *
+     * @param txPowerDbm current transmission power (in dBm)
+     * @param rxPowerDbm the reception power (in dBm)
+     * @returns the distance (in meters), possibly infinite
+     */
+    double CalcMaxRange(double txPowerDbm, double rxPowerDbm) const;
+
     /**
      * If this loss model uses objects of type RandomVariableStream,
      * set the stream numbers to the integers starting with the offset
@@ -128,6 +145,17 @@ class PropagationLossModel : public Object
                                  Ptr<MobilityModel> a,
                                  Ptr<MobilityModel> b) const = 0;
 
+    /**
+     * Returns a distance beyond which the Rx Power computed by this model
+     * is always lower than the given power. The default implementation
+     * returns an infinite distance, i.e., the Rx power is not bounded.
+     *
+     * @param txPowerDbm current transmission power (in dBm)
+     * @param rxPowerDbm the reception power (in dBm)
+     * @returns the distance (in meters), possibly infinite
+     */
+    virtual double DoCalcMaxRange(double txPowerDbm, double rxPowerDbm) const;
+
     Ptr<PropagationLossModel> m_next; //!< Next propagation loss model in the list
 };
 
@@ -294,6 +322,7 @@ class FriisPropagationLossModel : public PropagationLossModel
     double DoCalcRxPower(double txPowerDbm,
                          Ptr<MobilityModel> a,
                          Ptr<MobilityModel> b) const override;
+    double DoCalcMaxRange(double txPowerDbm, double rxPowerDbm) const override;
     int64_t DoAssignStreams(int64_t stream) override;
 
     /**
@@ -484,6 +513,7 @@ class LogDistancePropagationLossModel : public PropagationLossModel
     double DoCalcRxPower(double txPowerDbm,
                          Ptr<MobilityModel> a,
                          Ptr<MobilityModel> b) const override;
+    double DoCalcMaxRange(double txPowerDbm, double rxPowerDbm) const override;
 
     int64_t DoAssignStreams(int64_t stream) override;
 
@@ -560,6 +590,7 @@ class ThreeLogDistancePropagationLossModel : public PropagationLossModel
     double DoCalcRxPower(double txPowerDbm,
                          Ptr<MobilityModel> a,
                          Ptr<MobilityModel> b) const override;
+    double DoCalcMaxRange(double txPowerDbm, double rxPowerDbm) const override;
 
     int64_t DoAssignStreams(int64_t stream) override;
 
@@ -789,6 +820,7 @@ class RangePropagationLossModel : public PropagationLossModel
     double DoCalcRxPower(double txPowerDbm,
                          Ptr<MobilityModel> a,
                          Ptr<MobilityModel> b) const override;
+    double DoCalcMaxRange(double txPowerDbm, double rxPowerDbm) const override;
 
     int64_t DoAssignStreams(int64_t stream) override;
 
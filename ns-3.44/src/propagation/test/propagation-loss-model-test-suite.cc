@@ -13,6 +13,8 @@
 #include "ns3/simulator.h"
 #include "ns3/test.h"
 
+#include <cmath>
+
 using namespace ns3;
 
 NS_LOG_COMPONENT_DEFINE("PropagationLossModelsTest");
@@ -478,6 +480,105 @@ RangePropagationLossModelTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup propagation-tests
+ *
+ * @brief Test the maximum range of the propagation loss models
+ *
+ * The Rx power must be at least the given power just within the maximum
+ * range, and lower just beyond it.
+ */
+class MaxRangePropagationLossModelTestCase : public TestCase
+{
+  public:
+    MaxRangePropagationLossModelTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Check the Rx power around the maximum range of a loss model.
+     *
+     * @param lossModel the loss model
+     * @param txPowerDbm the transmission power (in dBm)
+     * @param rxPowerDbm the reception power (in dBm)
+     */
+    void CheckMaxRange(Ptr<PropagationLossModel> lossModel, double txPowerDbm, double rxPowerDbm);
+};
+
+MaxRangePropagationLossModelTestCase::MaxRangePropagationLossModelTestCase()
+    : TestCase("Check the maximum range of the propagation loss models")
+{
+}
+
+void
+MaxRangePropagationLossModelTestCase::CheckMaxRange(Ptr<PropagationLossModel> lossModel,
+                                                   double txPowerDbm,
+                                                   double rxPowerDbm)
+{
+    double range = lossModel->CalcMaxRange(txPowerDbm, rxPowerDbm);
+    NS_LOG_INFO(lossModel->GetInstanceTypeId().GetName() << ": " << range << "m");
+    Ptr<MobilityModel> a = CreateObject<ConstantPositionMobilityModel>();
+    a->SetPosition(Vector(0, 0, 0));
+    Ptr<MobilityModel> b = CreateObject<ConstantPositionMobilityModel>();
+    b->SetPosition(Vector(0.999 * range, 0, 0));
+    NS_TEST_EXPECT_MSG_GT_OR_EQ(lossModel->CalcRxPower(txPowerDbm, a, b),
+                                rxPowerDbm,
+                                "Signal not received within the maximum range");
+    b->SetPosition(Vector(1.001 * range, 0, 0));
+    NS_TEST_EXPECT_MSG_LT(lossModel->CalcRxPower(txPowerDbm, a, b),
+                          rxPowerDbm,
+                          "Signal received beyond the maximum range");
+}
+
+void
+MaxRangePropagationLossModelTestCase::DoRun()
+{
+    double txPowerDbm = 16.0206;
+    double rxPowerDbm = -101;
+
+    Ptr<FriisPropagationLossModel> friis = CreateObject<FriisPropagationLossModel>();
+    friis->SetFrequency(5.15e9);
+    CheckMaxRange(friis, txPowerDbm, rxPowerDbm);
+
+    Ptr<LogDistancePropagationLossModel> logDistance =
+        CreateObject<LogDistancePropagationLossModel>();
+    CheckMaxRange(logDistance, txPowerDbm, rxPowerDbm);
+
+    Ptr<ThreeLogDistancePropagationLossModel> threeLogDistance =
+        CreateObject<ThreeLogDistancePropagationLossModel>();
+    CheckMaxRange(threeLogDistance, txPowerDbm, rxPowerDbm); // far field
+    CheckMaxRange(threeLogDistance, txPowerDbm, -80);        // middle field
+    CheckMaxRange(threeLogDistance, txPowerDbm, -50);        // near field
+    CheckMaxRange(threeLogDistance, txPowerDbm, -20);        // below Distance0
+
+    Ptr<RangePropagationLossModel> range = CreateObject<RangePropagationLossModel>();
+    range->SetAttribute("MaxRange", DoubleValue(150));
+    CheckMaxRange(range, txPowerDbm, rxPowerDbm);
+    NS_TEST_EXPECT_MSG_EQ(range->CalcMaxRange(txPowerDbm, rxPowerDbm), 150, "Wrong range");
+
+    // the range of a chain is the smallest range of its models
+    range->SetAttribute("MaxRange", DoubleValue(500));
+    range->SetNext(logDistance);
+    NS_TEST_EXPECT_MSG_EQ(range->CalcMaxRange(txPowerDbm, rxPowerDbm),
+                          logDistance->CalcMaxRange(txPowerDbm, rxPowerDbm),
+                          "Wrong range of the chain");
+    CheckMaxRange(range, txPowerDbm, rxPowerDbm);
+
+    // the fading of the Nakagami model may increase the power
+    logDistance->SetNext(CreateObject<NakagamiPropagationLossModel>());
+    NS_TEST_EXPECT_MSG_EQ(std::isinf(range->CalcMaxRange(txPowerDbm, rxPowerDbm)),
+                          true,
+                          "The range of the chain should not be bounded");
+
+    // the signal is never received
+    NS_TEST_EXPECT_MSG_EQ(friis->CalcMaxRange(txPowerDbm, txPowerDbm + 1),
+                          0,
+                          "The range should be zero");
+
+    Simulator::Destroy();
+}
+
 /**
  * @ingroup propagation-tests
  *
@@ -504,6 +605,7 @@ PropagationLossModelsTestSuite::PropagationLossModelsTestSuite()
     AddTestCase(new LogDistancePropagationLossModelTestCase, TestCase::Duration::QUICK);
     AddTestCase(new MatrixPropagationLossModelTestCase, TestCase::Duration::QUICK);
     AddTestCase(new RangePropagationLossModelTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new MaxRangePropagationLossModelTestCase, TestCase::Duration::QUICK);
 }
 
 /// Static variable for test initialization
@@ -81,6 +81,9 @@ MultiModelSpectrumChannel::DoDispose()
     NS_LOG_FUNCTION(this);
     m_txSpectrumModelInfoMap.clear();
     m_rxSpectrumModelInfoMap.clear();
+    m_rxPhyList.clear();
+    m_rxPhySpectrumModelUids.clear();
+    m_candidates.clear();
     SpectrumChannel::DoDispose();
 }
 
@@ -116,6 +119,8 @@ MultiModelSpectrumChannel::RemoveRx(Ptr<SpectrumPhy> phy)
         {
             rxInfoIterator->second.m_rxPhys.erase(phyIt);
             --m_numDevices;
+            m_rxPhyList.clear();
+            InvalidateSpatialIndex();
             break; // there should be at most one entry
         }
     }
@@ -144,6 +149,8 @@ MultiModelSpectrumChannel::AddRx(Ptr<SpectrumPhy> phy)
     // rxInfoIterator points either to the newly inserted element or to the element that
     // prevented insertion. In both cases, add the phy to the element pointed to by rxInfoIterator
     rxInfoIterator->second.m_rxPhys.push_back(phy);
+    m_rxPhyList.clear();
+    InvalidateSpatialIndex();
 
     if (inserted)
     {
@@ -221,9 +228,12 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
 
     NS_ASSERT(txParams->txPhy);
     NS_ASSERT(txParams->psd);
-    auto txParamsTrace = txParams->Copy(); // copy it since traced value cannot be const (because of
-                                           // potential underlying DynamicCasts)
-    m_txSigParamsTrace(txParamsTrace);
+    if (!m_txSigParamsTrace.IsEmpty())
+    {
+        // copy it since traced value cannot be const (because of potential underlying
+        // DynamicCasts)
+        m_txSigParamsTrace(txParams->Copy());
+    }
 
     auto txMobility = txParams->txPhy->GetMobility();
     const auto txSpectrumModelUid = txParams->psd->GetSpectrumModelUid();
@@ -238,7 +248,37 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
     NS_LOG_LOGIC("converter map first element: "
                  << txInfoIterator->second.m_spectrumConverterMap.begin()->first);
 
-    std::map<SpectrumModelUid_t, Ptr<SpectrumValue>> convertedPsds{};
+    // the signal is copied once, and shared by the receptions at all the receivers
+    auto signal = Create<TxSignal>();
+    signal->params = txParams->Copy();
+    signal->txPowerDbm = GetTxPowerDbm(txParams->psd);
+
+    auto culled = false;
+    std::set<SpectrumModelUid_t> candidateSpectrumModelUids;
+    if (m_enableSpatialIndex)
+    {
+        if (m_rxPhyList.size() != m_numDevices)
+        {
+            m_rxPhyList.clear();
+            m_rxPhySpectrumModelUids.clear();
+            for (const auto& [rxSpectrumModelUid, rxInfo] : m_rxSpectrumModelInfoMap)
+            {
+                m_rxPhyList.insert(m_rxPhyList.end(),
+                                   rxInfo.m_rxPhys.cbegin(),
+                                   rxInfo.m_rxPhys.cend());
+                m_rxPhySpectrumModelUids.resize(m_rxPhyList.size(), rxSpectrumModelUid);
+            }
+        }
+        culled = FindRxCandidates(txMobility, signal->txPowerDbm, m_rxPhyList, m_candidates);
+        if (culled)
+        {
+            for (auto index : m_candidates)
+            {
+                candidateSpectrumModelUids.insert(m_rxPhySpectrumModelUids[index]);
+            }
+        }
+    }
+
     for (auto rxInfoIterator = m_rxSpectrumModelInfoMap.begin();
          rxInfoIterator != m_rxSpectrumModelInfoMap.end();
          ++rxInfoIterator)
@@ -246,11 +286,17 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
         const auto rxSpectrumModelUid = rxInfoIterator->second.m_rxSpectrumModel->GetUid();
         NS_LOG_LOGIC("rxSpectrumModelUids " << rxSpectrumModelUid);
 
+        if (culled && !candidateSpectrumModelUids.contains(rxSpectrumModelUid))
+        {
+            // no receiver of this SpectrumModel within range
+            continue;
+        }
+
         Ptr<SpectrumValue> convertedTxPowerSpectrum;
         if (txSpectrumModelUid == rxSpectrumModelUid)
         {
             NS_LOG_LOGIC("no spectrum conversion needed");
-            convertedTxPowerSpectrum = txParams->psd;
+            convertedTxPowerSpectrum = signal->params->psd;
         }
         else
         {
@@ -265,159 +311,164 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
             }
             convertedTxPowerSpectrum = rxConverterIterator->second.Convert(txParams->psd);
         }
-        convertedPsds.emplace(rxSpectrumModelUid, convertedTxPowerSpectrum);
+        signal->convertedPsds.emplace(rxSpectrumModelUid, convertedTxPowerSpectrum);
     }
 
-    for (auto rxInfoIterator = m_rxSpectrumModelInfoMap.begin();
-         rxInfoIterator != m_rxSpectrumModelInfoMap.end();
-         ++rxInfoIterator)
+    if (culled)
     {
-        const auto rxSpectrumModelUid = rxInfoIterator->second.m_rxSpectrumModel->GetUid();
-
-        if ((txSpectrumModelUid != rxSpectrumModelUid) &&
-            !txInfoIterator->second.m_spectrumConverterMap.contains(rxSpectrumModelUid))
+        for (auto index : m_candidates)
         {
-            // No converter means TX SpectrumModel is orthogonal to RX SpectrumModel
-            continue;
+            StartTxTo(signal, m_rxPhyList[index], m_rxPhySpectrumModelUids[index]);
+        }
+        return;
+    }
+    for (const auto& [rxSpectrumModelUid, rxInfo] : m_rxSpectrumModelInfoMap)
+    {
+        for (const auto& rxPhy : rxInfo.m_rxPhys)
+        {
+            StartTxTo(signal, rxPhy, rxSpectrumModelUid);
         }
+    }
+}
+
+void
+MultiModelSpectrumChannel::StartTxTo(Ptr<const TxSignal> signal,
+                                     Ptr<SpectrumPhy> rxPhy,
+                                     SpectrumModelUid_t rxSpectrumModelUid)
+{
+    const auto& txParams = signal->params;
+    NS_LOG_FUNCTION(this << txParams << rxPhy << rxSpectrumModelUid);
+
+    if (!signal->convertedPsds.contains(rxSpectrumModelUid))
+    {
+        // No converter means TX SpectrumModel is orthogonal to RX SpectrumModel
+        return;
+    }
+
+    NS_ASSERT_MSG(rxPhy->GetRxSpectrumModel()->GetUid() == rxSpectrumModelUid,
+                  "SpectrumModel change was not notified to MultiModelSpectrumChannel "
+                  "(i.e., AddRx should be called again after model is changed)");
 
-        for (auto rxPhyIterator = rxInfoIterator->second.m_rxPhys.begin();
-             rxPhyIterator != rxInfoIterator->second.m_rxPhys.end();
-             ++rxPhyIterator)
+    if (rxPhy == txParams->txPhy)
+    {
+        return;
+    }
+
+    auto rxNetDevice = rxPhy->GetDevice();
+    auto txNetDevice = txParams->txPhy->GetDevice();
+
+    if (rxNetDevice && txNetDevice)
+    {
+        // we assume that devices are attached to a node
+        if (rxNetDevice->GetNode()->GetId() == txNetDevice->GetNode()->GetId())
         {
-            NS_ASSERT_MSG((*rxPhyIterator)->GetRxSpectrumModel()->GetUid() == rxSpectrumModelUid,
-                          "SpectrumModel change was not notified to MultiModelSpectrumChannel "
-                          "(i.e., AddRx should be called again after model is changed)");
+            NS_LOG_DEBUG("Skipping the pathloss calculation among different antennas of the "
+                         "same node, not supported yet by any pathloss model in ns-3.");
+            return;
+        }
+    }
 
-            auto txAntennaGain{0.0};
-            if ((*rxPhyIterator) != txParams->txPhy)
-            {
-                auto rxNetDevice = (*rxPhyIterator)->GetDevice();
-                auto txNetDevice = txParams->txPhy->GetDevice();
-
-                if (rxNetDevice && txNetDevice)
-                {
-                    // we assume that devices are attached to a node
-                    if (rxNetDevice->GetNode()->GetId() == txNetDevice->GetNode()->GetId())
-                    {
-                        NS_LOG_DEBUG(
-                            "Skipping the pathloss calculation among different antennas of the "
-                            "same node, not supported yet by any pathloss model in ns-3.");
-                        continue;
-                    }
-                }
-
-                if (m_filter && m_filter->Filter(txParams, *rxPhyIterator))
-                {
-                    continue;
-                }
-
-                NS_LOG_LOGIC("copying signal parameters " << txParams);
-                auto rxParams = txParams->Copy();
-                rxParams->psd = Copy<SpectrumValue>(convertedPsds.at(rxSpectrumModelUid));
-                Time delay{0};
-
-                auto receiverMobility = (*rxPhyIterator)->GetMobility();
-
-                if (txMobility && receiverMobility)
-                {
-                    if (rxParams->txAntenna)
-                    {
-                        Angles txAngles(receiverMobility->GetPosition(), txMobility->GetPosition());
-                        txAntennaGain = rxParams->txAntenna->GetGainDb(txAngles);
-                        NS_LOG_LOGIC("txAntennaGain = " << txAntennaGain << " dB");
-                    }
-                    if (m_propagationDelay)
-                    {
-                        delay = m_propagationDelay->GetDelay(txMobility, receiverMobility);
-                    }
-                }
-
-                if (rxNetDevice)
-                {
-                    // the receiver has a NetDevice, so we expect that it is attached to a Node
-                    auto dstNode = rxNetDevice->GetNode()->GetId();
-                    Simulator::ScheduleWithContext(dstNode,
-                                                   delay,
-                                                   &MultiModelSpectrumChannel::StartRx,
-                                                   this,
-                                                   txParams->psd,
-                                                   txAntennaGain,
-                                                   rxParams,
-                                                   *rxPhyIterator,
-                                                   convertedPsds);
-                }
-                else
-                {
-                    // the receiver is not attached to a NetDevice, so we cannot assume that it is
-                    // attached to a node
-                    Simulator::Schedule(delay,
-                                        &MultiModelSpectrumChannel::StartRx,
-                                        this,
-                                        txParams->psd,
-                                        txAntennaGain,
-                                        rxParams,
-                                        *rxPhyIterator,
-                                        convertedPsds);
-                }
-            }
+    if (m_filter && m_filter->Filter(txParams, rxPhy))
+    {
+        return;
+    }
+
+    Time delay{0};
+    auto txAntennaGain{0.0};
+
+    auto txMobility = txParams->txPhy->GetMobility();
+    auto receiverMobility = rxPhy->GetMobility();
+
+    if (txMobility && receiverMobility)
+    {
+        if (txParams->txAntenna)
+        {
+            Angles txAngles(receiverMobility->GetPosition(), txMobility->GetPosition());
+            txAntennaGain = txParams->txAntenna->GetGainDb(txAngles);
+            NS_LOG_LOGIC("txAntennaGain = " << txAntennaGain << " dB");
+        }
+        if (m_propagationDelay)
+        {
+            delay = m_propagationDelay->GetDelay(txMobility, receiverMobility);
         }
     }
+
+    if (rxNetDevice)
+    {
+        // the receiver has a NetDevice, so we expect that it is attached to a Node
+        auto dstNode = rxNetDevice->GetNode()->GetId();
+        Simulator::ScheduleWithContext(dstNode,
+                                       delay,
+                                       &MultiModelSpectrumChannel::StartRx,
+                                       this,
+                                       signal,
+                                       txAntennaGain,
+                                       rxPhy);
+    }
+    else
+    {
+        // the receiver is not attached to a NetDevice, so we cannot assume that it is
+        // attached to a node
+        Simulator::Schedule(delay,
+                            &MultiModelSpectrumChannel::StartRx,
+                            this,
+                            signal,
+                            txAntennaGain,
+                            rxPhy);
+    }
 }
 
 void
-MultiModelSpectrumChannel::StartRx(
-    Ptr<SpectrumValue> txPsd,
-    double txAntennaGain,
-    Ptr<SpectrumSignalParameters> params,
-    Ptr<SpectrumPhy> receiver,
-    const std::map<SpectrumModelUid_t, Ptr<SpectrumValue>>& availableConvertedPsds)
+MultiModelSpectrumChannel::StartRx(Ptr<const TxSignal> signal,
+                                   double txAntennaGain,
+                                   Ptr<SpectrumPhy> receiver)
 {
     NS_LOG_FUNCTION(this);
 
-    const auto rxSpectrumModelUid = params->psd->GetSpectrumModelUid();
+    const auto& txParams = signal->params;
+    const auto txSpectrumModelUid = txParams->psd->GetSpectrumModelUid();
     const auto phySpectrumModelUid = receiver->GetRxSpectrumModel()->GetUid();
-    NS_LOG_LOGIC("rxSpectrumModelUid " << rxSpectrumModelUid << " phySpectrumModelUid "
+    NS_LOG_LOGIC("txSpectrumModelUid " << txSpectrumModelUid << " phySpectrumModelUid "
                                        << phySpectrumModelUid);
 
-    if (rxSpectrumModelUid != phySpectrumModelUid)
+    // the PSD received by the PHY before the propagation loss, which is shared with the other
+    // receivers unless it is converted for this PHY only
+    auto rxPsd = txParams->psd;
+    auto sharedPsd = true;
+    if (txSpectrumModelUid != phySpectrumModelUid)
     {
-        NS_LOG_LOGIC("SpectrumModelUid changed since TX started");
-
-        const auto itConvertedPsd = availableConvertedPsds.find(phySpectrumModelUid);
-        if (itConvertedPsd != availableConvertedPsds.cend())
+        const auto itConvertedPsd = signal->convertedPsds.find(phySpectrumModelUid);
+        if (itConvertedPsd != signal->convertedPsds.cend())
         {
             NS_LOG_LOGIC("converted PSD already exists for " << phySpectrumModelUid);
-            params->psd = itConvertedPsd->second;
+            rxPsd = itConvertedPsd->second;
         }
         else
         {
+            NS_LOG_LOGIC("SpectrumModelUid changed since TX started");
             const auto txInfoIterator =
-                FindAndEventuallyAddTxSpectrumModel(txPsd->GetSpectrumModel());
+                FindAndEventuallyAddTxSpectrumModel(txParams->psd->GetSpectrumModel());
             NS_ASSERT(txInfoIterator != m_txSpectrumModelInfoMap.cend());
 
-            const auto txSpectrumModelUid = txPsd->GetSpectrumModelUid();
             NS_LOG_LOGIC("converting txPowerSpectrum SpectrumModelUids "
                          << txSpectrumModelUid << " --> " << phySpectrumModelUid);
             const auto rxConverterIterator =
                 txInfoIterator->second.m_spectrumConverterMap.find(phySpectrumModelUid);
-            if (rxConverterIterator == txInfoIterator->second.m_spectrumConverterMap.cend())
+            // No converter means TX SpectrumModel is orthogonal to current PHY SpectrumModel
+            if (rxConverterIterator != txInfoIterator->second.m_spectrumConverterMap.cend())
             {
-                // No converter means TX SpectrumModel is orthogonal to current PHY SpectrumModel
-                params->psd = txPsd;
-            }
-            else
-            {
-                params->psd = rxConverterIterator->second.Convert(txPsd);
+                rxPsd = rxConverterIterator->second.Convert(txParams->psd);
+                sharedPsd = false;
             }
         }
     }
 
-    auto txMobility = params->txPhy->GetMobility();
+    auto txMobility = txParams->txPhy->GetMobility();
     auto rxMobility = receiver->GetMobility();
+    auto pathLossDb{0.0};
     if (txMobility && rxMobility)
     {
-        auto pathLossDb{-txAntennaGain};
+        pathLossDb = -txAntennaGain;
         auto rxAntennaGain{0.0};
         auto propagationGainDb{0.0};
 
@@ -447,14 +498,25 @@ MultiModelSpectrumChannel::StartRx(
                     pathLossDb);
 
         // Pathloss trace
-        m_pathLossTrace(params->txPhy, receiver, pathLossDb);
+        m_pathLossTrace(txParams->txPhy, receiver, pathLossDb);
 
-        if (pathLossDb > m_maxLossDb)
+        if (IsOutOfRange(signal->txPowerDbm, pathLossDb))
         {
             // beyond range
             return;
         }
+    }
 
+    // the signal parameters are only copied for the receivers which receive the signal
+    NS_LOG_LOGIC("copying signal parameters " << txParams);
+    auto params = txParams->Copy();
+    if (rxPsd != txParams->psd)
+    {
+        params->psd = sharedPsd ? Copy<SpectrumValue>(rxPsd) : rxPsd;
+    }
+
+    if (txMobility && rxMobility)
+    {
         const auto pathLossLinear = std::pow(10.0, (-pathLossDb) / 10.0);
         *(params->psd) *= pathLossLinear;
 
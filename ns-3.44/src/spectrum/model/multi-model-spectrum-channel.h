@@ -126,21 +126,40 @@ class MultiModelSpectrumChannel : public SpectrumChannel
     TxSpectrumModelInfoMap_t::const_iterator FindAndEventuallyAddTxSpectrumModel(
         Ptr<const SpectrumModel> txSpectrumModel);
 
+    /**
+     * A transmitted signal, shared by the receptions at all the receivers,
+     * which copy the signal parameters once they know they receive it.
+     */
+    struct TxSignal : public SimpleRefCount<TxSignal>
+    {
+        Ptr<const SpectrumSignalParameters> params; //!< The signal parameters, with the TX PSD.
+        double txPowerDbm;                          //!< The TX power, from GetTxPowerDbm().
+        /// The TX PSD converted to the SpectrumModels of the receivers, by SpectrumModel.
+        std::map<SpectrumModelUid_t, Ptr<SpectrumValue>> convertedPsds;
+    };
+
+    /**
+     * Compute the delay from the transmitter to a receiver, and schedule the
+     * reception of the signal.
+     *
+     * @param signal The transmitted signal.
+     * @param rxPhy The receiver SpectrumPhy.
+     * @param rxSpectrumModelUid The SpectrumModel of the receiver.
+     */
+    void StartTxTo(Ptr<const TxSignal> signal,
+                   Ptr<SpectrumPhy> rxPhy,
+                   SpectrumModelUid_t rxSpectrumModelUid);
+
     /**
      * Used internally to reschedule transmission after the propagation delay.
      *
-     * @param txPsd The transmitted PSD.
+     * @param signal The transmitted signal.
      * @param txAntennaGain The antenna gain at the transmitter.
-     * @param params The signal parameters.
      * @param receiver A pointer to the receiver SpectrumPhy.
-     * @param availableConvertedPsds available converted PSDs from the TX PSD.
      */
-    virtual void StartRx(
-        Ptr<SpectrumValue> txPsd,
-        double txAntennaGain,
-        Ptr<SpectrumSignalParameters> params,
-        Ptr<SpectrumPhy> receiver,
-        const std::map<SpectrumModelUid_t, Ptr<SpectrumValue>>& availableConvertedPsds);
+    virtual void StartRx(Ptr<const TxSignal> signal,
+                         double txAntennaGain,
+                         Ptr<SpectrumPhy> receiver);
 
     /**
      * Data structure holding, for each TX SpectrumModel,  all the
@@ -160,6 +179,22 @@ class MultiModelSpectrumChannel : public SpectrumChannel
      * Number of devices connected to the channel.
      */
     std::size_t m_numDevices;
+
+    /**
+     * The receivers, in the order of m_rxSpectrumModelInfoMap, to be indexed
+     * by the spatial index; rebuilt when receivers are added or removed.
+     */
+    std::vector<Ptr<SpectrumPhy>> m_rxPhyList;
+
+    /**
+     * The SpectrumModel of each receiver in m_rxPhyList.
+     */
+    std::vector<SpectrumModelUid_t> m_rxPhySpectrumModelUids;
+
+    /**
+     * Indices in m_rxPhyList of the receivers which may receive the current signal.
+     */
+    std::vector<uint64_t> m_candidates;
 };
 
 } // namespace ns3
@@ -45,6 +45,7 @@ SingleModelSpectrumChannel::DoDispose()
 {
     NS_LOG_FUNCTION(this);
     m_phyList.clear();
+    m_candidates.clear();
     m_spectrumModel = nullptr;
     SpectrumChannel::DoDispose();
 }
@@ -68,6 +69,7 @@ SingleModelSpectrumChannel::RemoveRx(Ptr<SpectrumPhy> phy)
     if (it != std::end(m_phyList))
     {
         m_phyList.erase(it);
+        InvalidateSpatialIndex();
     }
 }
 
@@ -78,6 +80,7 @@ SingleModelSpectrumChannel::AddRx(Ptr<SpectrumPhy> phy)
     if (std::find(m_phyList.cbegin(), m_phyList.cend(), phy) == m_phyList.cend())
     {
         m_phyList.push_back(phy);
+        InvalidateSpatialIndex();
     }
     else
     {
@@ -93,10 +96,12 @@ SingleModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
     NS_ASSERT_MSG(txParams->psd, "NULL txPsd");
     NS_ASSERT_MSG(txParams->txPhy, "NULL txPhy");
 
-    Ptr<SpectrumSignalParameters> txParamsTrace =
-        txParams->Copy(); // copy it since traced value cannot be const (because of potential
-                          // underlying DynamicCasts)
-    m_txSigParamsTrace(txParamsTrace);
+    if (!m_txSigParamsTrace.IsEmpty())
+    {
+        // copy it since traced value cannot be const (because of potential underlying
+        // DynamicCasts)
+        m_txSigParamsTrace(txParams->Copy());
+    }
 
     // just a sanity check routine. We might want to remove it to save some computational load --
     // one "if" statement  ;-)
@@ -112,112 +117,134 @@ SingleModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
     }
 
     Ptr<MobilityModel> senderMobility = txParams->txPhy->GetMobility();
+    const auto txPowerDbm = GetTxPowerDbm(txParams->psd);
 
-    for (auto rxPhyIterator = m_phyList.begin(); rxPhyIterator != m_phyList.end(); ++rxPhyIterator)
+    if (m_enableSpatialIndex &&
+        FindRxCandidates(senderMobility, txPowerDbm, m_phyList, m_candidates))
     {
-        Ptr<NetDevice> rxNetDevice = (*rxPhyIterator)->GetDevice();
-        Ptr<NetDevice> txNetDevice = txParams->txPhy->GetDevice();
+        for (auto index : m_candidates)
+        {
+            StartTxTo(txParams, senderMobility, txPowerDbm, m_phyList[index]);
+        }
+        return;
+    }
+    for (const auto& phy : m_phyList)
+    {
+        StartTxTo(txParams, senderMobility, txPowerDbm, phy);
+    }
+}
+
+void
+SingleModelSpectrumChannel::StartTxTo(Ptr<SpectrumSignalParameters> txParams,
+                                      Ptr<MobilityModel> senderMobility,
+                                      double txPowerDbm,
+                                      Ptr<SpectrumPhy> receiver)
+{
+    NS_LOG_FUNCTION(this << txParams << receiver);
+    Ptr<NetDevice> rxNetDevice = receiver->GetDevice();
+    Ptr<NetDevice> txNetDevice = txParams->txPhy->GetDevice();
 
-        if (rxNetDevice && txNetDevice)
+    if (rxNetDevice && txNetDevice)
+    {
+        // we assume that devices are attached to a node
+        if (rxNetDevice->GetNode()->GetId() == txNetDevice->GetNode()->GetId())
         {
-            // we assume that devices are attached to a node
-            if (rxNetDevice->GetNode()->GetId() == txNetDevice->GetNode()->GetId())
-            {
-                NS_LOG_DEBUG("Skipping the pathloss calculation among different antennas of the "
-                             "same node, not supported yet by any pathloss model in ns-3.");
-                continue;
-            }
+            NS_LOG_DEBUG("Skipping the pathloss calculation among different antennas of the "
+                         "same node, not supported yet by any pathloss model in ns-3.");
+            return;
         }
+    }
+
+    if (m_filter && m_filter->Filter(txParams, receiver))
+    {
+        return;
+    }
+
+    if (receiver == txParams->txPhy)
+    {
+        return;
+    }
+
+    Time delay;
+    Ptr<SpectrumSignalParameters> rxParams;
 
-        if (m_filter && m_filter->Filter(txParams, *rxPhyIterator))
+    Ptr<MobilityModel> receiverMobility = receiver->GetMobility();
+    if (senderMobility && receiverMobility)
+    {
+        double txAntennaGain = 0;
+        double rxAntennaGain = 0;
+        double propagationGainDb = 0;
+        double pathLossDb = 0;
+        if (txParams->txAntenna)
+        {
+            Angles txAngles(receiverMobility->GetPosition(), senderMobility->GetPosition());
+            txAntennaGain = txParams->txAntenna->GetGainDb(txAngles);
+            NS_LOG_LOGIC("txAntennaGain = " << txAntennaGain << " dB");
+            pathLossDb -= txAntennaGain;
+        }
+        Ptr<AntennaModel> rxAntenna = DynamicCast<AntennaModel>(receiver->GetAntenna());
+        if (rxAntenna)
+        {
+            Angles rxAngles(senderMobility->GetPosition(), receiverMobility->GetPosition());
+            rxAntennaGain = rxAntenna->GetGainDb(rxAngles);
+            NS_LOG_LOGIC("rxAntennaGain = " << rxAntennaGain << " dB");
+            pathLossDb -= rxAntennaGain;
+        }
+        if (m_propagationLoss)
+        {
+            propagationGainDb = m_propagationLoss->CalcRxPower(0, senderMobility, receiverMobility);
+            NS_LOG_LOGIC("propagationGainDb = " << propagationGainDb << " dB");
+            pathLossDb -= propagationGainDb;
+        }
+        NS_LOG_LOGIC("total pathLoss = " << pathLossDb << " dB");
+        // Gain trace
+        m_gainTrace(senderMobility,
+                    receiverMobility,
+                    txAntennaGain,
+                    rxAntennaGain,
+                    propagationGainDb,
+                    pathLossDb);
+        // Pathloss trace
+        m_pathLossTrace(txParams->txPhy, receiver, pathLossDb);
+        if (IsOutOfRange(txPowerDbm, pathLossDb))
         {
-            continue;
+            // beyond range
+            return;
         }
+        // the signal parameters are only copied for the receivers which receive the signal
+        NS_LOG_LOGIC("copying signal parameters " << txParams);
+        rxParams = txParams->Copy();
+        double pathGainLinear = std::pow(10.0, (-pathLossDb) / 10.0);
+        *(rxParams->psd) *= pathGainLinear;
 
-        if ((*rxPhyIterator) != txParams->txPhy)
+        if (m_propagationDelay)
         {
-            Time delay;
-
-            Ptr<MobilityModel> receiverMobility = (*rxPhyIterator)->GetMobility();
-            NS_LOG_LOGIC("copying signal parameters " << txParams);
-            Ptr<SpectrumSignalParameters> rxParams = txParams->Copy();
-
-            if (senderMobility && receiverMobility)
-            {
-                double txAntennaGain = 0;
-                double rxAntennaGain = 0;
-                double propagationGainDb = 0;
-                double pathLossDb = 0;
-                if (rxParams->txAntenna)
-                {
-                    Angles txAngles(receiverMobility->GetPosition(), senderMobility->GetPosition());
-                    txAntennaGain = rxParams->txAntenna->GetGainDb(txAngles);
-                    NS_LOG_LOGIC("txAntennaGain = " << txAntennaGain << " dB");
-                    pathLossDb -= txAntennaGain;
-                }
-                Ptr<AntennaModel> rxAntenna =
-                    DynamicCast<AntennaModel>((*rxPhyIterator)->GetAntenna());
-                if (rxAntenna)
-                {
-                    Angles rxAngles(senderMobility->GetPosition(), receiverMobility->GetPosition());
-                    rxAntennaGain = rxAntenna->GetGainDb(rxAngles);
-                    NS_LOG_LOGIC("rxAntennaGain = " << rxAntennaGain << " dB");
-                    pathLossDb -= rxAntennaGain;
-                }
-                if (m_propagationLoss)
-                {
-                    propagationGainDb =
-                        m_propagationLoss->CalcRxPower(0, senderMobility, receiverMobility);
-                    NS_LOG_LOGIC("propagationGainDb = " << propagationGainDb << " dB");
-                    pathLossDb -= propagationGainDb;
-                }
-                NS_LOG_LOGIC("total pathLoss = " << pathLossDb << " dB");
-                // Gain trace
-                m_gainTrace(senderMobility,
-                            receiverMobility,
-                            txAntennaGain,
-                            rxAntennaGain,
-                            propagationGainDb,
-                            pathLossDb);
-                // Pathloss trace
-                m_pathLossTrace(txParams->txPhy, *rxPhyIterator, pathLossDb);
-                if (pathLossDb > m_maxLossDb)
-                {
-                    // beyond range
-                    continue;
-                }
-                double pathGainLinear = std::pow(10.0, (-pathLossDb) / 10.0);
-                *(rxParams->psd) *= pathGainLinear;
-
-                if (m_propagationDelay)
-                {
-                    delay = m_propagationDelay->GetDelay(senderMobility, receiverMobility);
-                }
-            }
-
-            if (rxNetDevice)
-            {
-                // the receiver has a NetDevice, so we expect that it is attached to a Node
-                uint32_t dstNode = rxNetDevice->GetNode()->GetId();
-                Simulator::ScheduleWithContext(dstNode,
-                                               delay,
-                                               &SingleModelSpectrumChannel::StartRx,
-                                               this,
-                                               rxParams,
-                                               *rxPhyIterator);
-            }
-            else
-            {
-                // the receiver is not attached to a NetDevice, so we cannot assume that it is
-                // attached to a node
-                Simulator::Schedule(delay,
-                                    &SingleModelSpectrumChannel::StartRx,
-                                    this,
-                                    rxParams,
-                                    *rxPhyIterator);
-            }
+            delay = m_propagationDelay->GetDelay(senderMobility, receiverMobility);
         }
     }
+    else
+    {
+        NS_LOG_LOGIC("copying signal parameters " << txParams);
+        rxParams = txParams->Copy();
+    }
+
+    if (rxNetDevice)
+    {
+        // the receiver has a NetDevice, so we expect that it is attached to a Node
+        uint32_t dstNode = rxNetDevice->GetNode()->GetId();
+        Simulator::ScheduleWithContext(dstNode,
+                                       delay,
+                                       &SingleModelSpectrumChannel::StartRx,
+                                       this,
+                                       rxParams,
+                                       receiver);
+    }
+    else
+    {
+        // the receiver is not attached to a NetDevice, so we cannot assume that it is
+        // attached to a node
+        Simulator::Schedule(delay, &SingleModelSpectrumChannel::StartRx, this, rxParams, receiver);
+    }
 }
 
 void
@@ -58,11 +58,30 @@ class SingleModelSpectrumChannel : public SpectrumChannel
      */
     void StartRx(Ptr<SpectrumSignalParameters> params, Ptr<SpectrumPhy> receiver);
 
+    /**
+     * Compute the path loss and delay from the transmitter to a receiver,
+     * and schedule the reception of the signal.
+     *
+     * @param txParams the parameters of the signal
+     * @param senderMobility the mobility model of the transmitter
+     * @param txPowerDbm the TX power of the signal (dBm), as returned by GetTxPowerDbm()
+     * @param receiver the receiver
+     */
+    void StartTxTo(Ptr<SpectrumSignalParameters> txParams,
+                   Ptr<MobilityModel> senderMobility,
+                   double txPowerDbm,
+                   Ptr<SpectrumPhy> receiver);
+
     /**
      * List of SpectrumPhy instances attached to the channel.
      */
     PhyList m_phyList;
 
+    /**
+     * Indices in m_phyList of the receivers which may receive the current signal.
+     */
+    std::vector<uint64_t> m_candidates;
+
     /**
      * SpectrumModel that this channel instance is supporting.
      */
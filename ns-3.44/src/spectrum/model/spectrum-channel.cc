@@ -8,11 +8,18 @@
 
 #include "spectrum-channel.h"
 
+#include "spectrum-value.h"
+
 #include "ns3/abort.h"
+#include "ns3/boolean.h"
 #include "ns3/double.h"
 #include "ns3/log.h"
 #include "ns3/pointer.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 namespace ns3
 {
 
@@ -21,6 +28,7 @@ NS_LOG_COMPONENT_DEFINE("SpectrumChannel");
 NS_OBJECT_ENSURE_REGISTERED(SpectrumChannel);
 
 SpectrumChannel::SpectrumChannel()
+    : m_indexBuilt(false)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -45,6 +53,9 @@ SpectrumChannel::DoDispose()
         m_phasedArraySpectrumPropagationLoss->Dispose();
     }
     m_phasedArraySpectrumPropagationLoss = nullptr;
+    m_grid.Clear();
+    m_unlocatedRx.clear();
+    m_indexBuilt = false;
 }
 
 TypeId
@@ -69,6 +80,46 @@ SpectrumChannel::GetTypeId()
                           MakeDoubleAccessor(&SpectrumChannel::m_maxLossDb),
                           MakeDoubleChecker<double>())
 
+            .AddAttribute("MinRxPowerDbm",
+                          "If a single-frequency PropagationLossModel is used, "
+                          "signals received below this power in dBm, computed from the "
+                          "total TX power, the antenna gains and the PropagationLossModel, "
+                          "will not be propagated to the receiver. Like MaxLossDb, this "
+                          "parameter is to be used to reduce the computational load. "
+                          "Note that the default value corresponds to considering all "
+                          "signals for reception.",
+                          DoubleValue(DEFAULT_MIN_RX_POWER_DBM),
+                          MakeDoubleAccessor(&SpectrumChannel::m_minRxPowerDbm),
+                          MakeDoubleChecker<double>())
+
+            .AddAttribute("EnableSpatialIndex",
+                          "If true, only the receivers located within the distance at which "
+                          "the single-frequency PropagationLossModel attenuates the signals "
+                          "beyond MaxLossDb, or below MinRxPowerDbm, are evaluated. "
+                          "The PathLoss and Gain traces are not fired for the other "
+                          "receivers. This requires a PropagationLossModel which "
+                          "can bound this distance.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&SpectrumChannel::m_enableSpatialIndex),
+                          MakeBooleanChecker())
+
+            .AddAttribute("SpatialIndexCellSize",
+                          "The size in meters of the cells of the spatial index, which "
+                          "is best set close to the range of the signals.",
+                          DoubleValue(100),
+                          MakeDoubleAccessor(&SpectrumChannel::m_cellSize),
+                          MakeDoubleChecker<double>(1e-3))
+
+            .AddAttribute("MaxAntennaGainDb",
+                          "The maximum sum in dB of the TX and RX antenna gains, which "
+                          "extends the distance of the receivers evaluated when "
+                          "EnableSpatialIndex is true. It must also cover the gains "
+                          "added by the frequency-dependent propagation loss models, "
+                          "if any.",
+                          DoubleValue(0),
+                          MakeDoubleAccessor(&SpectrumChannel::m_maxAntennaGainDb),
+                          MakeDoubleChecker<double>())
+
             .AddAttribute("PropagationLossModel",
                           "A pointer to the propagation loss model attached to this channel.",
                           PointerValue(nullptr),
@@ -262,4 +313,87 @@ SpectrumChannel::DoAssignStreams(int64_t stream)
     return 0;
 }
 
+bool
+SpectrumChannel::FindRxCandidates(Ptr<MobilityModel> txMobility,
+                                  double txPowerDbm,
+                                  const std::vector<Ptr<SpectrumPhy>>& rxPhys,
+                                  std::vector<uint64_t>& candidates)
+{
+    NS_LOG_FUNCTION(this << txMobility << txPowerDbm << rxPhys.size());
+    if (!m_propagationLoss || !txMobility)
+    {
+        return false;
+    }
+    if (!m_indexBuilt)
+    {
+        NS_LOG_LOGIC("Build the spatial index of " << rxPhys.size() << " receivers");
+        m_grid.Clear();
+        m_grid.SetCellSize(m_cellSize);
+        m_unlocatedRx.clear();
+        for (std::size_t index = 0; index < rxPhys.size(); index++)
+        {
+            if (auto mobility = rxPhys[index]->GetMobility())
+            {
+                m_grid.Add(index, mobility);
+            }
+            else
+            {
+                m_unlocatedRx.push_back(index);
+            }
+        }
+        m_indexBuilt = true;
+    }
+    NS_ASSERT(m_grid.GetSize() + m_unlocatedRx.size() == rxPhys.size());
+
+    // the receivers drop the signals whose propagation gain is below this value, whatever their
+    // antenna gains (see StartTx)
+    const auto minGainDb =
+        std::max(-m_maxLossDb, m_minRxPowerDbm - txPowerDbm) - m_maxAntennaGainDb;
+    auto range = m_propagationLoss->CalcMaxRange(0, minGainDb);
+    if (!std::isfinite(range))
+    {
+        NS_LOG_LOGIC("The propagation loss model does not bound the range");
+        return false;
+    }
+    range *= 1 + 1e-9; // absorb the rounding errors of the propagation loss model
+
+    candidates.clear();
+    if (!m_grid.Find(txMobility->GetPosition(), range, candidates))
+    {
+        return false;
+    }
+    if (!m_unlocatedRx.empty())
+    {
+        candidates.insert(candidates.end(), m_unlocatedRx.cbegin(), m_unlocatedRx.cend());
+        std::sort(candidates.begin(), candidates.end());
+    }
+    NS_LOG_DEBUG(candidates.size() << " of " << rxPhys.size() << " receivers within " << range
+                                   << "m");
+    return true;
+}
+
+void
+SpectrumChannel::InvalidateSpatialIndex()
+{
+    NS_LOG_FUNCTION(this);
+    m_indexBuilt = false;
+}
+
+double
+SpectrumChannel::GetTxPowerDbm(Ptr<const SpectrumValue> psd) const
+{
+    if (m_minRxPowerDbm == DEFAULT_MIN_RX_POWER_DBM)
+    {
+        return std::numeric_limits<double>::infinity();
+    }
+    return 10 * std::log10(Integral(*psd)) + 30;
+}
+
+bool
+SpectrumChannel::IsOutOfRange(double txPowerDbm, double pathLossDb) const
+{
+    return pathLossDb > m_maxLossDb || (m_minRxPowerDbm != DEFAULT_MIN_RX_POWER_DBM &&
+                                        txPowerDbm - pathLossDb < m_minRxPowerDbm);
+}
+
 } // namespace ns3
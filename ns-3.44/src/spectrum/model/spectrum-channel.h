@@ -16,6 +16,7 @@
 #include "spectrum-transmit-filter.h"
 
 #include "ns3/channel.h"
+#include "ns3/mobility-grid.h"
 #include "ns3/mobility-model.h"
 #include "ns3/nstime.h"
 #include "ns3/object.h"
@@ -23,6 +24,8 @@
 #include "ns3/propagation-loss-model.h"
 #include "ns3/traced-callback.h"
 
+#include <vector>
+
 namespace ns3
 {
 
@@ -34,6 +37,12 @@ class SpectrumValue;
  *
  * Defines the interface for spectrum-aware channel implementations
  *
+ * When the EnableSpatialIndex attribute is set, the channel keeps the
+ * receivers in a MobilityGrid, and only evaluates those located within the
+ * distance at which the single-frequency PropagationLossModel attenuates the
+ * signal beyond the MaxLossDb attribute, or below the MinRxPowerDbm
+ * attribute, given the MaxAntennaGainDb attribute. The PathLoss and Gain
+ * traces are not fired for the other receivers.
  */
 class SpectrumChannel : public Channel
 {
@@ -227,6 +236,48 @@ class SpectrumChannel : public Channel
      */
     virtual int64_t DoAssignStreams(int64_t stream);
 
+    /**
+     * Find the receivers which may receive a signal with the spatial index,
+     * i.e., those not located beyond the distance at which they drop the
+     * signal. The receivers without mobility model are always candidates.
+     *
+     * @param txMobility the mobility model of the transmitter
+     * @param txPowerDbm the TX power of the signal (dBm), as returned by GetTxPowerDbm()
+     * @param rxPhys the receivers, in the same order at each call until
+     *        InvalidateSpatialIndex() is called
+     * @param candidates the vector to fill with the indices of the
+     *        candidates in rxPhys, in increasing order
+     * @return false if all the receivers must be evaluated instead
+     */
+    bool FindRxCandidates(Ptr<MobilityModel> txMobility,
+                          double txPowerDbm,
+                          const std::vector<Ptr<SpectrumPhy>>& rxPhys,
+                          std::vector<uint64_t>& candidates);
+
+    /**
+     * Rebuild the spatial index at the next call to FindRxCandidates(), to be
+     * called when receivers are added to or removed from the channel.
+     */
+    void InvalidateSpatialIndex();
+
+    /**
+     * The PSD is only integrated if the MinRxPowerDbm attribute was changed
+     * from its default value, as the TX power is not needed otherwise.
+     *
+     * @param psd the PSD of a transmitted signal
+     * @return the TX power of the signal (dBm), or +infinity if the
+     *         MinRxPowerDbm attribute has its default value
+     */
+    double GetTxPowerDbm(Ptr<const SpectrumValue> psd) const;
+
+    /**
+     * @param txPowerDbm the TX power of a signal (dBm), as returned by GetTxPowerDbm()
+     * @param pathLossDb the loss between the transmitter and a receiver (dB)
+     * @return whether the loss is beyond MaxLossDb, or the RX power below
+     *         MinRxPowerDbm, i.e., whether the receiver drops the signal
+     */
+    bool IsOutOfRange(double txPowerDbm, double pathLossDb) const;
+
     /**
      * The `PathLoss` trace source. Exporting the pointers to the Tx and Rx
      * SpectrumPhy and a pathloss value, in dB.
@@ -258,6 +309,25 @@ class SpectrumChannel : public Channel
      */
     double m_maxLossDb;
 
+    /**
+     * Minimum RX power [dBm].
+     *
+     * Any device receiving the signal below this power, before the
+     * frequency-dependent propagation loss, is considered out of range.
+     */
+    double m_minRxPowerDbm;
+
+    /**
+     * Maximum sum of the TX and RX antenna gains [dB], which bounds the
+     * distance of the receivers evaluated with the spatial index.
+     */
+    double m_maxAntennaGainDb;
+
+    /**
+     * Whether only the receivers within range are evaluated.
+     */
+    bool m_enableSpatialIndex;
+
     /**
      * Single-frequency propagation loss model to be used with this channel.
      */
@@ -282,6 +352,15 @@ class SpectrumChannel : public Channel
      * Transmit filter to be used with this channel
      */
     Ptr<SpectrumTransmitFilter> m_filter{nullptr};
+
+  private:
+    /// Default value of the MinRxPowerDbm attribute, which drops no signal
+    static constexpr double DEFAULT_MIN_RX_POWER_DBM = -1.0e9;
+
+    double m_cellSize;                   //!< Size of the cells of the spatial index (m)
+    bool m_indexBuilt;                   //!< Whether the spatial index holds all the receivers
+    MobilityGrid m_grid;                 //!< Spatial index of the receivers, by index
+    std::vector<uint64_t> m_unlocatedRx; //!< Indices of the receivers without mobility model
 };
 
 } // namespace ns3
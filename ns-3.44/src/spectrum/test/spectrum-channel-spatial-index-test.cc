@@ -0,0 +1,364 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/boolean.h"
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/constant-velocity-mobility-model.h"
+#include "ns3/double.h"
+#include "ns3/multi-model-spectrum-channel.h"
+#include "ns3/net-device.h"
+#include "ns3/propagation-loss-model.h"
+#include "ns3/simulator.h"
+#include "ns3/single-model-spectrum-channel.h"
+#include "ns3/spectrum-phy.h"
+#include "ns3/spectrum-signal-parameters.h"
+#include "ns3/spectrum-value.h"
+#include "ns3/test.h"
+
+#include <algorithm>
+#include <optional>
+#include <tuple>
+#include <vector>
+
+using namespace ns3;
+
+/// A reception: the IDs of the transmitter and of the receiver, and the RX power (W)
+using Reception = std::tuple<uint32_t, uint32_t, double>;
+
+/**
+ * @ingroup spectrum-tests
+ *
+ * @brief SpectrumPhy recording the signals it receives.
+ */
+class SpatialIndexTestPhy : public SpectrumPhy
+{
+  public:
+    /**
+     * Constructor
+     * @param id the ID of the PHY
+     * @param model the RX spectrum model
+     * @param receptions the list of the receptions of all the PHYs
+     */
+    SpatialIndexTestPhy(uint32_t id,
+                        Ptr<const SpectrumModel> model,
+                        std::vector<Reception>& receptions)
+        : m_id(id),
+          m_model(model),
+          m_receptions(receptions)
+    {
+    }
+
+    void SetDevice(Ptr<NetDevice> d) override
+    {
+    }
+
+    Ptr<NetDevice> GetDevice() const override
+    {
+        return nullptr;
+    }
+
+    void SetMobility(Ptr<MobilityModel> m) override
+    {
+        m_mobility = m;
+    }
+
+    Ptr<MobilityModel> GetMobility() const override
+    {
+        return m_mobility;
+    }
+
+    void SetChannel(Ptr<SpectrumChannel> c) override
+    {
+    }
+
+    Ptr<const SpectrumModel> GetRxSpectrumModel() const override
+    {
+        return m_model;
+    }
+
+    Ptr<Object> GetAntenna() const override
+    {
+        return nullptr;
+    }
+
+    void StartRx(Ptr<SpectrumSignalParameters> params) override
+    {
+        auto tx = DynamicCast<SpatialIndexTestPhy>(params->txPhy);
+        m_receptions.emplace_back(tx->m_id, m_id, Integral(*params->psd));
+        // the received PSD belongs to this PHY
+        *params->psd = 0;
+    }
+
+  private:
+    uint32_t m_id;                        //!< the ID of the PHY
+    Ptr<const SpectrumModel> m_model;     //!< the RX spectrum model
+    Ptr<MobilityModel> m_mobility;        //!< the mobility model
+    std::vector<Reception>& m_receptions; //!< the receptions of all the PHYs
+};
+
+/**
+ * @ingroup spectrum-tests
+ *
+ * @brief Check that the spatial index of the spectrum channels does not change the receptions.
+ *
+ * Sixty PHYs are spread over a 300x300 m area, one of them moving and one of
+ * them without mobility model, and several of them transmit. With a
+ * LogDistancePropagationLossModel and a MinRxPowerDbm of -90 dBm, the signals
+ * transmitted at 20 dBm only reach the PHYs within about 130 m: the channel
+ * must deliver the same signals with and without the spatial index, and
+ * evaluate fewer receivers with it. The PHYs overwrite the PSDs they
+ * receive, which must not change the PSDs received by the other PHYs.
+ */
+class SpectrumChannelSpatialIndexTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     * @param channelType the TypeId name of the channel
+     */
+    SpectrumChannelSpatialIndexTestCase(std::string channelType);
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Run the scenario.
+     * @param enableSpatialIndex whether to enable the spatial index of the channel
+     * @param nPathLoss the number of path losses computed by the channel
+     * @return the sorted receptions
+     */
+    std::vector<Reception> RunScenario(bool enableSpatialIndex, uint32_t& nPathLoss);
+
+    std::string m_channelType; //!< the TypeId name of the channel
+};
+
+SpectrumChannelSpatialIndexTestCase::SpectrumChannelSpatialIndexTestCase(std::string channelType)
+    : TestCase("Check the spatial index of " + channelType),
+      m_channelType(channelType)
+{
+}
+
+std::vector<Reception>
+SpectrumChannelSpatialIndexTestCase::RunScenario(bool enableSpatialIndex, uint32_t& nPathLoss)
+{
+    std::vector<double> frequencies;
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        frequencies.push_back(2.4e9 + i * 1e6);
+    }
+    auto txModel = Create<SpectrumModel>(frequencies);
+    // the multi model channel converts the signals for half of the PHYs
+    auto rxModel = txModel;
+    if (m_channelType == "ns3::MultiModelSpectrumChannel")
+    {
+        std::vector<double> rxFrequencies;
+        for (uint32_t i = 0; i < 5; i++)
+        {
+            rxFrequencies.push_back(2.4005e9 + i * 2e6);
+        }
+        rxModel = Create<SpectrumModel>(rxFrequencies);
+    }
+
+    ObjectFactory factory(m_channelType);
+    factory.Set("EnableSpatialIndex", BooleanValue(enableSpatialIndex));
+    factory.Set("MinRxPowerDbm", DoubleValue(-90));
+    auto channel = factory.Create<SpectrumChannel>();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    nPathLoss = 0;
+    channel->TraceConnectWithoutContext(
+        "PathLoss",
+        Callback<void, Ptr<const SpectrumPhy>, Ptr<const SpectrumPhy>, double>(
+            [&nPathLoss](Ptr<const SpectrumPhy>, Ptr<const SpectrumPhy>, double) {
+                nPathLoss++;
+            }));
+
+    std::vector<Reception> receptions;
+    std::vector<Ptr<SpatialIndexTestPhy>> phys;
+    auto txPsd = Create<SpectrumValue>(txModel);
+    *txPsd = 1e-8; // 20 dBm
+    for (uint32_t i = 0; i < 60; i++)
+    {
+        auto phy = CreateObject<SpatialIndexTestPhy>(i, (i % 2) ? rxModel : txModel, receptions);
+        if (i == 1)
+        {
+            auto mobility = CreateObject<ConstantVelocityMobilityModel>();
+            mobility->SetPosition(Vector(0, 150, 0));
+            mobility->SetVelocity(Vector(30, 0, 0));
+            phy->SetMobility(mobility);
+        }
+        else if (i != 2)
+        {
+            auto mobility = CreateObject<ConstantPositionMobilityModel>();
+            mobility->SetPosition(Vector((i * 73) % 300, (i * 151) % 300, 0));
+            phy->SetMobility(mobility);
+        }
+        channel->AddRx(phy);
+        phys.push_back(phy);
+    }
+
+    for (uint32_t i = 0; i < 20; i++)
+    {
+        auto params = Create<SpectrumSignalParameters>();
+        params->txPhy = phys[(i * 7) % phys.size()];
+        params->psd = txPsd;
+        params->duration = MilliSeconds(1);
+        Simulator::Schedule(Seconds(0.5 * i), &SpectrumChannel::StartTx, channel, params);
+    }
+    Simulator::Run();
+    channel->Dispose();
+    Simulator::Destroy();
+
+    NS_TEST_EXPECT_MSG_EQ_TOL(Integral(*txPsd), 0.1, 1e-12, "The TX PSD should not be modified");
+    for (const auto& reception : receptions)
+    {
+        NS_TEST_EXPECT_MSG_GT(std::get<2>(reception), 0, "The RX PSDs should not be shared");
+    }
+
+    std::sort(receptions.begin(), receptions.end());
+    return receptions;
+}
+
+void
+SpectrumChannelSpatialIndexTestCase::DoRun()
+{
+    uint32_t nPathLoss;
+    const auto expected = RunScenario(false, nPathLoss);
+    uint32_t nPathLossIndexed;
+    const auto receptions = RunScenario(true, nPathLossIndexed);
+
+    NS_TEST_ASSERT_MSG_EQ(receptions.size(), expected.size(), "Wrong number of receptions");
+    for (std::size_t i = 0; i < expected.size(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(std::get<0>(receptions[i]), std::get<0>(expected[i]), "Wrong TX");
+        NS_TEST_EXPECT_MSG_EQ(std::get<1>(receptions[i]), std::get<1>(expected[i]), "Wrong RX");
+        NS_TEST_EXPECT_MSG_EQ_TOL(std::get<2>(receptions[i]),
+                                  std::get<2>(expected[i]),
+                                  1e-9 * std::get<2>(expected[i]),
+                                  "Wrong RX power");
+    }
+    NS_TEST_EXPECT_MSG_GT(expected.size(), 20, "Too few receptions");
+    NS_TEST_EXPECT_MSG_LT(expected.size(), 20 * 59, "Some signals should be dropped");
+    NS_TEST_EXPECT_MSG_LT(nPathLossIndexed,
+                          nPathLoss / 2,
+                          "The spatial index should skip the receivers out of range");
+}
+
+/**
+ * @ingroup spectrum-tests
+ *
+ * @brief Check that the spectrum channels only drop the signals for their RX
+ * power if the MinRxPowerDbm attribute is set.
+ *
+ * A signal with an all-zero PSD, whose TX power is -infinity dBm, must reach
+ * the receiver with the default MinRxPowerDbm, and be dropped with a
+ * MinRxPowerDbm of -90 dBm, with and without the spatial index.
+ */
+class SpectrumChannelMinRxPowerTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     * @param channelType the TypeId name of the channel
+     */
+    SpectrumChannelMinRxPowerTestCase(std::string channelType);
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Transmit a signal with an all-zero PSD to a receiver 10 m away.
+     * @param enableSpatialIndex whether to enable the spatial index of the channel
+     * @param minRxPowerDbm the MinRxPowerDbm attribute of the channel, if set
+     * @return the number of receptions
+     */
+    std::size_t CountReceptions(bool enableSpatialIndex, std::optional<double> minRxPowerDbm);
+
+    std::string m_channelType; //!< the TypeId name of the channel
+};
+
+SpectrumChannelMinRxPowerTestCase::SpectrumChannelMinRxPowerTestCase(std::string channelType)
+    : TestCase("Check the MinRxPowerDbm attribute of " + channelType),
+      m_channelType(channelType)
+{
+}
+
+std::size_t
+SpectrumChannelMinRxPowerTestCase::CountReceptions(bool enableSpatialIndex,
+                                                   std::optional<double> minRxPowerDbm)
+{
+    auto model = Create<SpectrumModel>(std::vector<double>{2.4e9, 2.401e9});
+
+    ObjectFactory factory(m_channelType);
+    factory.Set("EnableSpatialIndex", BooleanValue(enableSpatialIndex));
+    if (minRxPowerDbm)
+    {
+        factory.Set("MinRxPowerDbm", DoubleValue(*minRxPowerDbm));
+    }
+    auto channel = factory.Create<SpectrumChannel>();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+
+    std::vector<Reception> receptions;
+    std::vector<Ptr<SpatialIndexTestPhy>> phys;
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        auto phy = CreateObject<SpatialIndexTestPhy>(i, model, receptions);
+        auto mobility = CreateObject<ConstantPositionMobilityModel>();
+        mobility->SetPosition(Vector(10 * i, 0, 0));
+        phy->SetMobility(mobility);
+        channel->AddRx(phy);
+        phys.push_back(phy);
+    }
+
+    auto params = Create<SpectrumSignalParameters>();
+    params->txPhy = phys[0];
+    params->psd = Create<SpectrumValue>(model);
+    params->duration = MilliSeconds(1);
+    Simulator::Schedule(Seconds(1), &SpectrumChannel::StartTx, channel, params);
+    Simulator::Run();
+    channel->Dispose();
+    Simulator::Destroy();
+
+    return receptions.size();
+}
+
+void
+SpectrumChannelMinRxPowerTestCase::DoRun()
+{
+    for (auto enableSpatialIndex : {false, true})
+    {
+        NS_TEST_EXPECT_MSG_EQ(CountReceptions(enableSpatialIndex, std::nullopt),
+                              1,
+                              "The signal should be received with the default MinRxPowerDbm");
+        NS_TEST_EXPECT_MSG_EQ(CountReceptions(enableSpatialIndex, -90),
+                              0,
+                              "The signal should be dropped below MinRxPowerDbm");
+    }
+}
+
+/**
+ * @ingroup spectrum-tests
+ *
+ * @brief Spectrum channel spatial index TestSuite
+ */
+class SpectrumChannelSpatialIndexTestSuite : public TestSuite
+{
+  public:
+    SpectrumChannelSpatialIndexTestSuite();
+};
+
+SpectrumChannelSpatialIndexTestSuite::SpectrumChannelSpatialIndexTestSuite()
+    : TestSuite("spectrum-channel-spatial-index", Type::UNIT)
+{
+    AddTestCase(new SpectrumChannelSpatialIndexTestCase("ns3::SingleModelSpectrumChannel"),
+                TestCase::Duration::QUICK);
+    AddTestCase(new SpectrumChannelSpatialIndexTestCase("ns3::MultiModelSpectrumChannel"),
+                TestCase::Duration::QUICK);
+    AddTestCase(new SpectrumChannelMinRxPowerTestCase("ns3::SingleModelSpectrumChannel"),
+                TestCase::Duration::QUICK);
+    AddTestCase(new SpectrumChannelMinRxPowerTestCase("ns3::MultiModelSpectrumChannel"),
+                TestCase::Duration::QUICK);
+}
+
+/// Static variable for test initialization
+static SpectrumChannelSpatialIndexTestSuite g_spectrumChannelSpatialIndexTestSuite;
@@ -7,6 +7,8 @@
  *          Stefano Avallone <stefano.avallone@unina.it>
  */
 
+#include "ns3tc-flow-stats.h"
+
 #include "ns3/codel-queue-disc.h"
 #include "ns3/fq-codel-queue-disc.h"
 #include "ns3/ipv4-address.h"
@@ -135,14 +137,14 @@ FqCoDelQueueDiscNoSuitableFilter::DoRun()
     Address dest;
     item = Create<Ipv6QueueDiscItem>(p, dest, 0, ipv6Header);
     queueDisc->Enqueue(item);
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetNQueueDiscClasses(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetNFlowQueues(),
                           0,
                           "no flow queue should have been created");
 
     p = Create<Packet>(reinterpret_cast<const uint8_t*>("hello, world"), 12);
     item = Create<Ipv6QueueDiscItem>(p, dest, 0, ipv6Header);
     queueDisc->Enqueue(item);
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetNQueueDiscClasses(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetNFlowQueues(),
                           0,
                           "no flow queue should have been created");
 
@@ -211,7 +213,7 @@ FqCoDelQueueDiscIPFlowsSeparationAndPacketLimit::DoRun()
     NS_TEST_ASSERT_MSG_EQ(queueDisc->QueueDisc::GetNPackets(),
                           3,
                           "unexpected number of packets in the queue disc");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(0)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetNPackets(),
                           3,
                           "unexpected number of packets in the flow queue");
 
@@ -222,10 +224,10 @@ FqCoDelQueueDiscIPFlowsSeparationAndPacketLimit::DoRun()
     NS_TEST_ASSERT_MSG_EQ(queueDisc->QueueDisc::GetNPackets(),
                           4,
                           "unexpected number of packets in the queue disc");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(0)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetNPackets(),
                           3,
                           "unexpected number of packets in the flow queue");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(1)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(1).GetNPackets(),
                           1,
                           "unexpected number of packets in the flow queue");
     // Add the second packet that causes two packets to be dropped from the fat flow (max backlog =
@@ -234,10 +236,10 @@ FqCoDelQueueDiscIPFlowsSeparationAndPacketLimit::DoRun()
     NS_TEST_ASSERT_MSG_EQ(queueDisc->QueueDisc::GetNPackets(),
                           3,
                           "unexpected number of packets in the queue disc");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(0)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetNPackets(),
                           1,
                           "unexpected number of packets in the flow queue");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(1)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(1).GetNPackets(),
                           2,
                           "unexpected number of packets in the flow queue");
 
@@ -302,14 +304,13 @@ FqCoDelQueueDiscDeficit::DoRun()
     NS_TEST_ASSERT_MSG_EQ(queueDisc->QueueDisc::GetNPackets(),
                           1,
                           "unexpected number of packets in the queue disc");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(0)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetNPackets(),
                           1,
                           "unexpected number of packets in the first flow queue");
-    Ptr<FqCoDelFlow> flow1 = StaticCast<FqCoDelFlow>(queueDisc->GetQueueDiscClass(0));
-    NS_TEST_ASSERT_MSG_EQ(flow1->GetDeficit(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetDeficit(),
                           static_cast<int32_t>(queueDisc->GetQuantum()),
                           "the deficit of the first flow must equal the quantum");
-    NS_TEST_ASSERT_MSG_EQ(flow1->GetStatus(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetStatus(),
                           FqCoDelFlow::NEW_FLOW,
                           "the first flow must be in the list of new queues");
     // Dequeue a packet
@@ -317,11 +318,13 @@ FqCoDelQueueDiscDeficit::DoRun()
     NS_TEST_ASSERT_MSG_EQ(queueDisc->QueueDisc::GetNPackets(),
                           0,
                           "unexpected number of packets in the queue disc");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(0)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetNPackets(),
                           0,
                           "unexpected number of packets in the first flow queue");
     // the deficit for the first flow becomes 90 - (100+20) = -30
-    NS_TEST_ASSERT_MSG_EQ(flow1->GetDeficit(), -30, "unexpected deficit for the first flow");
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetDeficit(),
+                          -30,
+                          "unexpected deficit for the first flow");
 
     // Add two packets from the first flow
     AddPacket(queueDisc, hdr);
@@ -329,10 +332,10 @@ FqCoDelQueueDiscDeficit::DoRun()
     NS_TEST_ASSERT_MSG_EQ(queueDisc->QueueDisc::GetNPackets(),
                           2,
                           "unexpected number of packets in the queue disc");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(0)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetNPackets(),
                           2,
                           "unexpected number of packets in the first flow queue");
-    NS_TEST_ASSERT_MSG_EQ(flow1->GetStatus(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetStatus(),
                           FqCoDelFlow::NEW_FLOW,
                           "the first flow must still be in the list of new queues");
 
@@ -343,17 +346,16 @@ FqCoDelQueueDiscDeficit::DoRun()
     NS_TEST_ASSERT_MSG_EQ(queueDisc->QueueDisc::GetNPackets(),
                           4,
                           "unexpected number of packets in the queue disc");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(0)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetNPackets(),
                           2,
                           "unexpected number of packets in the first flow queue");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(1)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(1).GetNPackets(),
                           2,
                           "unexpected number of packets in the second flow queue");
-    Ptr<FqCoDelFlow> flow2 = StaticCast<FqCoDelFlow>(queueDisc->GetQueueDiscClass(1));
-    NS_TEST_ASSERT_MSG_EQ(flow2->GetDeficit(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(1).GetDeficit(),
                           static_cast<int32_t>(queueDisc->GetQuantum()),
                           "the deficit of the second flow must equal the quantum");
-    NS_TEST_ASSERT_MSG_EQ(flow2->GetStatus(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(1).GetStatus(),
                           FqCoDelFlow::NEW_FLOW,
                           "the second flow must be in the list of new queues");
 
@@ -362,21 +364,25 @@ FqCoDelQueueDiscDeficit::DoRun()
     NS_TEST_ASSERT_MSG_EQ(queueDisc->QueueDisc::GetNPackets(),
                           3,
                           "unexpected number of packets in the queue disc");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(0)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetNPackets(),
                           2,
                           "unexpected number of packets in the first flow queue");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(1)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(1).GetNPackets(),
                           1,
                           "unexpected number of packets in the second flow queue");
     // the first flow got a quantum of deficit (-30+90=60) and has been moved to the end of the list
     // of old queues
-    NS_TEST_ASSERT_MSG_EQ(flow1->GetDeficit(), 60, "unexpected deficit for the first flow");
-    NS_TEST_ASSERT_MSG_EQ(flow1->GetStatus(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetDeficit(),
+                          60,
+                          "unexpected deficit for the first flow");
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetStatus(),
                           FqCoDelFlow::OLD_FLOW,
                           "the first flow must be in the list of old queues");
     // the second flow has a negative deficit (-30) and is still in the list of new queues
-    NS_TEST_ASSERT_MSG_EQ(flow2->GetDeficit(), -30, "unexpected deficit for the second flow");
-    NS_TEST_ASSERT_MSG_EQ(flow2->GetStatus(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(1).GetDeficit(),
+                          -30,
+                          "unexpected deficit for the second flow");
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(1).GetStatus(),
                           FqCoDelFlow::NEW_FLOW,
                           "the second flow must be in the list of new queues");
 
@@ -385,21 +391,25 @@ FqCoDelQueueDiscDeficit::DoRun()
     NS_TEST_ASSERT_MSG_EQ(queueDisc->QueueDisc::GetNPackets(),
                           2,
                           "unexpected number of packets in the queue disc");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(0)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetNPackets(),
                           1,
                           "unexpected number of packets in the first flow queue");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(1)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(1).GetNPackets(),
                           1,
                           "unexpected number of packets in the second flow queue");
     // the first flow has a negative deficit (60-(100+20)= -60) and stays in the list of old queues
-    NS_TEST_ASSERT_MSG_EQ(flow1->GetDeficit(), -60, "unexpected deficit for the first flow");
-    NS_TEST_ASSERT_MSG_EQ(flow1->GetStatus(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetDeficit(),
+                          -60,
+                          "unexpected deficit for the first flow");
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetStatus(),
                           FqCoDelFlow::OLD_FLOW,
                           "the first flow must be in the list of old queues");
     // the second flow got a quantum of deficit (-30+90=60) and has been moved to the end of the
     // list of old queues
-    NS_TEST_ASSERT_MSG_EQ(flow2->GetDeficit(), 60, "unexpected deficit for the second flow");
-    NS_TEST_ASSERT_MSG_EQ(flow2->GetStatus(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(1).GetDeficit(),
+                          60,
+                          "unexpected deficit for the second flow");
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(1).GetStatus(),
                           FqCoDelFlow::OLD_FLOW,
                           "the second flow must be in the list of new queues");
 
@@ -408,21 +418,25 @@ FqCoDelQueueDiscDeficit::DoRun()
     NS_TEST_ASSERT_MSG_EQ(queueDisc->QueueDisc::GetNPackets(),
                           1,
                           "unexpected number of packets in the queue disc");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(0)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetNPackets(),
                           1,
                           "unexpected number of packets in the first flow queue");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(1)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(1).GetNPackets(),
                           0,
                           "unexpected number of packets in the second flow queue");
     // the first flow got a quantum of deficit (-60+90=30) and has been moved to the end of the list
     // of old queues
-    NS_TEST_ASSERT_MSG_EQ(flow1->GetDeficit(), 30, "unexpected deficit for the first flow");
-    NS_TEST_ASSERT_MSG_EQ(flow1->GetStatus(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetDeficit(),
+                          30,
+                          "unexpected deficit for the first flow");
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetStatus(),
                           FqCoDelFlow::OLD_FLOW,
                           "the first flow must be in the list of old queues");
     // the second flow has a negative deficit (60-(100+20)= -60)
-    NS_TEST_ASSERT_MSG_EQ(flow2->GetDeficit(), -60, "unexpected deficit for the second flow");
-    NS_TEST_ASSERT_MSG_EQ(flow2->GetStatus(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(1).GetDeficit(),
+                          -60,
+                          "unexpected deficit for the second flow");
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(1).GetStatus(),
                           FqCoDelFlow::OLD_FLOW,
                           "the second flow must be in the list of new queues");
 
@@ -431,21 +445,25 @@ FqCoDelQueueDiscDeficit::DoRun()
     NS_TEST_ASSERT_MSG_EQ(queueDisc->QueueDisc::GetNPackets(),
                           0,
                           "unexpected number of packets in the queue disc");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(0)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetNPackets(),
                           0,
                           "unexpected number of packets in the first flow queue");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(1)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(1).GetNPackets(),
                           0,
                           "unexpected number of packets in the second flow queue");
     // the first flow has a negative deficit (30-(100+20)= -90)
-    NS_TEST_ASSERT_MSG_EQ(flow1->GetDeficit(), -90, "unexpected deficit for the first flow");
-    NS_TEST_ASSERT_MSG_EQ(flow1->GetStatus(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetDeficit(),
+                          -90,
+                          "unexpected deficit for the first flow");
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetStatus(),
                           FqCoDelFlow::OLD_FLOW,
                           "the first flow must be in the list of old queues");
     // the second flow got a quantum of deficit (-60+90=30) and has been moved to the end of the
     // list of old queues
-    NS_TEST_ASSERT_MSG_EQ(flow2->GetDeficit(), 30, "unexpected deficit for the second flow");
-    NS_TEST_ASSERT_MSG_EQ(flow2->GetStatus(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(1).GetDeficit(),
+                          30,
+                          "unexpected deficit for the second flow");
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(1).GetStatus(),
                           FqCoDelFlow::OLD_FLOW,
                           "the second flow must be in the list of new queues");
 
@@ -458,12 +476,16 @@ FqCoDelQueueDiscDeficit::DoRun()
     // it gets another quantum of deficit (0+90=90). Then, the first flow is reconsidered again, now
     // it has a positive deficit and hence it is selected. But, it is empty and therefore is set to
     // inactive, too.
-    NS_TEST_ASSERT_MSG_EQ(flow1->GetDeficit(), 90, "unexpected deficit for the first flow");
-    NS_TEST_ASSERT_MSG_EQ(flow1->GetStatus(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetDeficit(),
+                          90,
+                          "unexpected deficit for the first flow");
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetStatus(),
                           FqCoDelFlow::INACTIVE,
                           "the first flow must be inactive");
-    NS_TEST_ASSERT_MSG_EQ(flow2->GetDeficit(), 30, "unexpected deficit for the second flow");
-    NS_TEST_ASSERT_MSG_EQ(flow2->GetStatus(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(1).GetDeficit(),
+                          30,
+                          "unexpected deficit for the second flow");
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(1).GetStatus(),
                           FqCoDelFlow::INACTIVE,
                           "the second flow must be inactive");
 
@@ -539,7 +561,7 @@ FqCoDelQueueDiscTCPFlowsSeparation::DoRun()
     NS_TEST_ASSERT_MSG_EQ(queueDisc->QueueDisc::GetNPackets(),
                           3,
                           "unexpected number of packets in the queue disc");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(0)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetNPackets(),
                           3,
                           "unexpected number of packets in the first flow queue");
 
@@ -549,10 +571,10 @@ FqCoDelQueueDiscTCPFlowsSeparation::DoRun()
     NS_TEST_ASSERT_MSG_EQ(queueDisc->QueueDisc::GetNPackets(),
                           4,
                           "unexpected number of packets in the queue disc");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(0)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetNPackets(),
                           3,
                           "unexpected number of packets in the first flow queue");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(1)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(1).GetNPackets(),
                           1,
                           "unexpected number of packets in the second flow queue");
 
@@ -562,13 +584,13 @@ FqCoDelQueueDiscTCPFlowsSeparation::DoRun()
     NS_TEST_ASSERT_MSG_EQ(queueDisc->QueueDisc::GetNPackets(),
                           5,
                           "unexpected number of packets in the queue disc");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(0)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetNPackets(),
                           3,
                           "unexpected number of packets in the first flow queue");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(1)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(1).GetNPackets(),
                           1,
                           "unexpected number of packets in the second flow queue");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(2)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(2).GetNPackets(),
                           1,
                           "unexpected number of packets in the third flow queue");
 
@@ -579,16 +601,16 @@ FqCoDelQueueDiscTCPFlowsSeparation::DoRun()
     NS_TEST_ASSERT_MSG_EQ(queueDisc->QueueDisc::GetNPackets(),
                           7,
                           "unexpected number of packets in the queue disc");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(0)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetNPackets(),
                           3,
                           "unexpected number of packets in the first flow queue");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(1)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(1).GetNPackets(),
                           1,
                           "unexpected number of packets in the second flow queue");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(2)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(2).GetNPackets(),
                           1,
                           "unexpected number of packets in the third flow queue");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(3)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(3).GetNPackets(),
                           2,
                           "unexpected number of packets in the third flow queue");
 
@@ -664,7 +686,7 @@ FqCoDelQueueDiscUDPFlowsSeparation::DoRun()
     NS_TEST_ASSERT_MSG_EQ(queueDisc->QueueDisc::GetNPackets(),
                           3,
                           "unexpected number of packets in the queue disc");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(0)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetNPackets(),
                           3,
                           "unexpected number of packets in the first flow queue");
 
@@ -674,10 +696,10 @@ FqCoDelQueueDiscUDPFlowsSeparation::DoRun()
     NS_TEST_ASSERT_MSG_EQ(queueDisc->QueueDisc::GetNPackets(),
                           4,
                           "unexpected number of packets in the queue disc");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(0)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetNPackets(),
                           3,
                           "unexpected number of packets in the first flow queue");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(1)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(1).GetNPackets(),
                           1,
                           "unexpected number of packets in the second flow queue");
 
@@ -687,13 +709,13 @@ FqCoDelQueueDiscUDPFlowsSeparation::DoRun()
     NS_TEST_ASSERT_MSG_EQ(queueDisc->QueueDisc::GetNPackets(),
                           5,
                           "unexpected number of packets in the queue disc");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(0)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetNPackets(),
                           3,
                           "unexpected number of packets in the first flow queue");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(1)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(1).GetNPackets(),
                           1,
                           "unexpected number of packets in the second flow queue");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(2)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(2).GetNPackets(),
                           1,
                           "unexpected number of packets in the third flow queue");
 
@@ -704,16 +726,16 @@ FqCoDelQueueDiscUDPFlowsSeparation::DoRun()
     NS_TEST_ASSERT_MSG_EQ(queueDisc->QueueDisc::GetNPackets(),
                           7,
                           "unexpected number of packets in the queue disc");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(0)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetNPackets(),
                           3,
                           "unexpected number of packets in the first flow queue");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(1)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(1).GetNPackets(),
                           1,
                           "unexpected number of packets in the second flow queue");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(2)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(2).GetNPackets(),
                           1,
                           "unexpected number of packets in the third flow queue");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(3)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(3).GetNPackets(),
                           2,
                           "unexpected number of packets in the third flow queue");
 
@@ -762,6 +784,8 @@ class FqCoDelQueueDiscECNMarking : public TestCase
      * @param nPkt The number of packets to dequeue.
      */
     void DequeueWithDelay(Ptr<FqCoDelQueueDisc> queue, double delay, uint32_t nPkt);
+
+    QueueDiscFlowStats m_flowStats; //!< Per flow statistics
 };
 
 FqCoDelQueueDiscECNMarking::FqCoDelQueueDiscECNMarking()
@@ -787,7 +811,7 @@ FqCoDelQueueDiscECNMarking::AddPacket(Ptr<FqCoDelQueueDisc> queue,
         Ptr<Ipv4QueueDiscItem> item = Create<Ipv4QueueDiscItem>(p, dest, 0, hdr);
         queue->Enqueue(item);
     }
-    NS_TEST_EXPECT_MSG_EQ(queue->GetNQueueDiscClasses(),
+    NS_TEST_EXPECT_MSG_EQ(queue->GetNFlowQueues(),
                           nQueueFlows,
                           "unexpected number of flow queues");
     NS_TEST_EXPECT_MSG_EQ(queue->GetNPackets(),
@@ -839,6 +863,7 @@ FqCoDelQueueDiscECNMarking::DoRun()
 
     queueDisc->SetQuantum(1514);
     queueDisc->Initialize();
+    m_flowStats.Connect(queueDisc);
     Ipv4Header hdr;
     hdr.SetPayloadSize(100);
     hdr.SetSource(Ipv4Address("10.10.1.1"));
@@ -906,72 +931,73 @@ FqCoDelQueueDiscECNMarking::DoRun()
     DequeueWithDelay(queueDisc, 0.11, 60);
     Simulator::Run();
     Simulator::Stop(Seconds(8));
-    Ptr<CoDelQueueDisc> q0 =
-        queueDisc->GetQueueDiscClass(0)->GetQueueDisc()->GetObject<CoDelQueueDisc>();
-    Ptr<CoDelQueueDisc> q1 =
-        queueDisc->GetQueueDiscClass(1)->GetQueueDisc()->GetObject<CoDelQueueDisc>();
-    Ptr<CoDelQueueDisc> q2 =
-        queueDisc->GetQueueDiscClass(2)->GetQueueDisc()->GetObject<CoDelQueueDisc>();
-    Ptr<CoDelQueueDisc> q3 =
-        queueDisc->GetQueueDiscClass(3)->GetQueueDisc()->GetObject<CoDelQueueDisc>();
-    Ptr<CoDelQueueDisc> q4 =
-        queueDisc->GetQueueDiscClass(4)->GetQueueDisc()->GetObject<CoDelQueueDisc>();
+    Ipv4Address flow0("10.10.1.2");
+    Ipv4Address flow1("10.10.1.10");
+    Ipv4Address flow2("10.10.1.20");
+    Ipv4Address flow3("10.10.1.30");
+    Ipv4Address flow4("10.10.1.40");
 
     // Ensure there are some remaining packets in the flow queues to check for flow queues with ECN
     // capable packets
-    NS_TEST_EXPECT_MSG_NE(queueDisc->GetQueueDiscClass(0)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_EXPECT_MSG_NE(queueDisc->GetFlowQueue(0).GetNPackets(),
                           0,
                           "There should be some remaining packets");
-    NS_TEST_EXPECT_MSG_NE(queueDisc->GetQueueDiscClass(1)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_EXPECT_MSG_NE(queueDisc->GetFlowQueue(1).GetNPackets(),
                           0,
                           "There should be some remaining packets");
-    NS_TEST_EXPECT_MSG_NE(queueDisc->GetQueueDiscClass(2)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_EXPECT_MSG_NE(queueDisc->GetFlowQueue(2).GetNPackets(),
                           0,
                           "There should be some remaining packets");
-    NS_TEST_EXPECT_MSG_NE(queueDisc->GetQueueDiscClass(3)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_EXPECT_MSG_NE(queueDisc->GetFlowQueue(3).GetNPackets(),
                           0,
                           "There should be some remaining packets");
-    NS_TEST_EXPECT_MSG_NE(queueDisc->GetQueueDiscClass(4)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_EXPECT_MSG_NE(queueDisc->GetFlowQueue(4).GetNPackets(),
                           0,
                           "There should be some remaining packets");
 
     // As packets in flow queues are ECN capable
-    NS_TEST_EXPECT_MSG_EQ(q0->GetStats().GetNMarkedPackets(CoDelQueueDisc::TARGET_EXCEEDED_MARK),
-                          6,
-                          "There should be 6 marked packets"
-                          "with 20 packets, total bytes in the queue = 120 * 20 = 2400. First "
-                          "packet dequeues at 110ms which is greater than"
-                          "test's default target value 5ms. Sojourn time has just gone above "
-                          "target from below, need to stay above for at"
-                          "least q->interval before packet can be dropped. Second packet dequeues "
-                          "at 220ms which is greater than last dequeue"
-                          "time plus q->interval(test default 100ms) so the packet is marked. "
-                          "Third packet dequeues at 330ms and the sojourn"
-                          "time stayed above the target and dropnext value is less than 320 hence "
-                          "the packet is marked. 4 subsequent packets"
-                          "are marked as the sojourn time stays above the target. With 8th dequeue "
-                          "number of bytes in queue = 120 * 12 = 1440"
-                          "which is less m_minBytes(test's default value 1500 bytes) hence the "
-                          "packets stop getting marked");
-    NS_TEST_EXPECT_MSG_EQ(q0->GetStats().GetNDroppedPackets(CoDelQueueDisc::TARGET_EXCEEDED_DROP),
-                          0,
-                          "There should not be any dropped packets");
-    NS_TEST_EXPECT_MSG_EQ(q1->GetStats().GetNMarkedPackets(CoDelQueueDisc::TARGET_EXCEEDED_MARK),
-                          6,
-                          "There should be 6 marked packets");
-    NS_TEST_EXPECT_MSG_EQ(q1->GetStats().GetNDroppedPackets(CoDelQueueDisc::TARGET_EXCEEDED_DROP),
-                          0,
-                          "There should not be any dropped packets");
-    NS_TEST_EXPECT_MSG_EQ(q2->GetStats().GetNMarkedPackets(CoDelQueueDisc::TARGET_EXCEEDED_MARK),
-                          6,
-                          "There should be 6 marked packets");
-    NS_TEST_EXPECT_MSG_EQ(q2->GetStats().GetNDroppedPackets(CoDelQueueDisc::TARGET_EXCEEDED_DROP),
-                          0,
-                          "There should not be any dropped packets");
+    NS_TEST_EXPECT_MSG_EQ(
+        m_flowStats.GetNMarkedPackets(flow0, CoDelQueueDisc::TARGET_EXCEEDED_MARK),
+        6,
+        "There should be 6 marked packets"
+        "with 20 packets, total bytes in the queue = 120 * 20 = 2400. First "
+        "packet dequeues at 110ms which is greater than"
+        "test's default target value 5ms. Sojourn time has just gone above "
+        "target from below, need to stay above for at"
+        "least q->interval before packet can be dropped. Second packet dequeues "
+        "at 220ms which is greater than last dequeue"
+        "time plus q->interval(test default 100ms) so the packet is marked. "
+        "Third packet dequeues at 330ms and the sojourn"
+        "time stayed above the target and dropnext value is less than 320 hence "
+        "the packet is marked. 4 subsequent packets"
+        "are marked as the sojourn time stays above the target. With 8th dequeue "
+        "number of bytes in queue = 120 * 12 = 1440"
+        "which is less m_minBytes(test's default value 1500 bytes) hence the "
+        "packets stop getting marked");
+    NS_TEST_EXPECT_MSG_EQ(
+        m_flowStats.GetNDroppedPackets(flow0, CoDelQueueDisc::TARGET_EXCEEDED_DROP),
+        0,
+        "There should not be any dropped packets");
+    NS_TEST_EXPECT_MSG_EQ(
+        m_flowStats.GetNMarkedPackets(flow1, CoDelQueueDisc::TARGET_EXCEEDED_MARK),
+        6,
+        "There should be 6 marked packets");
+    NS_TEST_EXPECT_MSG_EQ(
+        m_flowStats.GetNDroppedPackets(flow1, CoDelQueueDisc::TARGET_EXCEEDED_DROP),
+        0,
+        "There should not be any dropped packets");
+    NS_TEST_EXPECT_MSG_EQ(
+        m_flowStats.GetNMarkedPackets(flow2, CoDelQueueDisc::TARGET_EXCEEDED_MARK),
+        6,
+        "There should be 6 marked packets");
+    NS_TEST_EXPECT_MSG_EQ(
+        m_flowStats.GetNDroppedPackets(flow2, CoDelQueueDisc::TARGET_EXCEEDED_DROP),
+        0,
+        "There should not be any dropped packets");
 
     // As packets in flow queues are not ECN capable
     NS_TEST_EXPECT_MSG_EQ(
-        q3->GetStats().GetNDroppedPackets(CoDelQueueDisc::TARGET_EXCEEDED_DROP),
+        m_flowStats.GetNDroppedPackets(flow3, CoDelQueueDisc::TARGET_EXCEEDED_DROP),
         4,
         "There should be 4 dropped packets"
         "with 20 packets, total bytes in the queue = 120 * 20 = 2400. First packet dequeues at "
@@ -989,26 +1015,31 @@ FqCoDelQueueDiscECNMarking::DoRun()
         "12 Packets remaining in the queue, total number of bytes int the queue = 120 * 12 = 1440 "
         "which is less"
         "m_minBytes(test's default value 1500 bytes) hence the packets stop getting dropped");
-    NS_TEST_EXPECT_MSG_EQ(q3->GetStats().GetNMarkedPackets(CoDelQueueDisc::TARGET_EXCEEDED_MARK),
-                          0,
-                          "There should not be any marked packets");
-    NS_TEST_EXPECT_MSG_EQ(q4->GetStats().GetNDroppedPackets(CoDelQueueDisc::TARGET_EXCEEDED_DROP),
-                          4,
-                          "There should be 4 dropped packets");
-    NS_TEST_EXPECT_MSG_EQ(q4->GetStats().GetNMarkedPackets(CoDelQueueDisc::TARGET_EXCEEDED_MARK),
-                          0,
-                          "There should not be any marked packets");
+    NS_TEST_EXPECT_MSG_EQ(
+        m_flowStats.GetNMarkedPackets(flow3, CoDelQueueDisc::TARGET_EXCEEDED_MARK),
+        0,
+        "There should not be any marked packets");
+    NS_TEST_EXPECT_MSG_EQ(
+        m_flowStats.GetNDroppedPackets(flow4, CoDelQueueDisc::TARGET_EXCEEDED_DROP),
+        4,
+        "There should be 4 dropped packets");
+    NS_TEST_EXPECT_MSG_EQ(
+        m_flowStats.GetNMarkedPackets(flow4, CoDelQueueDisc::TARGET_EXCEEDED_MARK),
+        0,
+        "There should not be any marked packets");
     // Ensure flow queue 0,1 and 2 have ECN capable packets
-    // Peek () changes the stats of the queue and that is reason to be keep this test at last
-    Ptr<const Ipv4QueueDiscItem> pktQ0 = DynamicCast<const Ipv4QueueDiscItem>(q0->Peek());
+    Ptr<const Ipv4QueueDiscItem> pktQ0 =
+        DynamicCast<const Ipv4QueueDiscItem>(queueDisc->GetFlowQueue(0).GetHead());
     NS_TEST_EXPECT_MSG_NE(pktQ0->GetHeader().GetEcn(),
                           Ipv4Header::ECN_NotECT,
                           "flow queue should have ECT0 packets");
-    Ptr<const Ipv4QueueDiscItem> pktQ1 = DynamicCast<const Ipv4QueueDiscItem>(q1->Peek());
+    Ptr<const Ipv4QueueDiscItem> pktQ1 =
+        DynamicCast<const Ipv4QueueDiscItem>(queueDisc->GetFlowQueue(1).GetHead());
     NS_TEST_EXPECT_MSG_NE(pktQ1->GetHeader().GetEcn(),
                           Ipv4Header::ECN_NotECT,
                           "flow queue should have ECT0 packets");
-    Ptr<const Ipv4QueueDiscItem> pktQ2 = DynamicCast<const Ipv4QueueDiscItem>(q2->Peek());
+    Ptr<const Ipv4QueueDiscItem> pktQ2 =
+        DynamicCast<const Ipv4QueueDiscItem>(queueDisc->GetFlowQueue(2).GetHead());
     NS_TEST_EXPECT_MSG_NE(pktQ2->GetHeader().GetEcn(),
                           Ipv4Header::ECN_NotECT,
                           "flow queue should have ECT0 packets");
@@ -1024,6 +1055,7 @@ FqCoDelQueueDiscECNMarking::DoRun()
                                                              TimeValue(MilliSeconds(2)));
     queueDisc->SetQuantum(1514);
     queueDisc->Initialize();
+    m_flowStats.Connect(queueDisc);
 
     // Add 20 ECT0 (ECN capable) packets from first flow
     hdr.SetDestination(Ipv4Address("10.10.1.2"));
@@ -1087,57 +1119,55 @@ FqCoDelQueueDiscECNMarking::DoRun()
     DequeueWithDelay(queueDisc, 0.0001, 60);
     Simulator::Run();
     Simulator::Stop(Seconds(8));
-    q0 = queueDisc->GetQueueDiscClass(0)->GetQueueDisc()->GetObject<CoDelQueueDisc>();
-    q1 = queueDisc->GetQueueDiscClass(1)->GetQueueDisc()->GetObject<CoDelQueueDisc>();
-    q2 = queueDisc->GetQueueDiscClass(2)->GetQueueDisc()->GetObject<CoDelQueueDisc>();
-    q3 = queueDisc->GetQueueDiscClass(3)->GetQueueDisc()->GetObject<CoDelQueueDisc>();
-    q4 = queueDisc->GetQueueDiscClass(4)->GetQueueDisc()->GetObject<CoDelQueueDisc>();
 
     // Ensure there are some remaining packets in the flow queues to check for flow queues with ECN
     // capable packets
-    NS_TEST_EXPECT_MSG_NE(queueDisc->GetQueueDiscClass(0)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_EXPECT_MSG_NE(queueDisc->GetFlowQueue(0).GetNPackets(),
                           0,
                           "There should be some remaining packets");
-    NS_TEST_EXPECT_MSG_NE(queueDisc->GetQueueDiscClass(1)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_EXPECT_MSG_NE(queueDisc->GetFlowQueue(1).GetNPackets(),
                           0,
                           "There should be some remaining packets");
-    NS_TEST_EXPECT_MSG_NE(queueDisc->GetQueueDiscClass(2)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_EXPECT_MSG_NE(queueDisc->GetFlowQueue(2).GetNPackets(),
                           0,
                           "There should be some remaining packets");
-    NS_TEST_EXPECT_MSG_NE(queueDisc->GetQueueDiscClass(3)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_EXPECT_MSG_NE(queueDisc->GetFlowQueue(3).GetNPackets(),
                           0,
                           "There should be some remaining packets");
-    NS_TEST_EXPECT_MSG_NE(queueDisc->GetQueueDiscClass(4)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_EXPECT_MSG_NE(queueDisc->GetFlowQueue(4).GetNPackets(),
                           0,
                           "There should be some remaining packets");
 
     // As packets in flow queues are ECN capable
-    NS_TEST_EXPECT_MSG_EQ(q0->GetStats().GetNDroppedPackets(CoDelQueueDisc::TARGET_EXCEEDED_DROP),
-                          0,
-                          "There should not be any dropped packets");
     NS_TEST_EXPECT_MSG_EQ(
-        q0->GetStats().GetNMarkedPackets(CoDelQueueDisc::CE_THRESHOLD_EXCEEDED_MARK),
+        m_flowStats.GetNDroppedPackets(flow0, CoDelQueueDisc::TARGET_EXCEEDED_DROP),
+        0,
+        "There should not be any dropped packets");
+    NS_TEST_EXPECT_MSG_EQ(
+        m_flowStats.GetNMarkedPackets(flow0, CoDelQueueDisc::CE_THRESHOLD_EXCEEDED_MARK),
         0,
         "There should not be any marked packets"
         "with quantum of 1514, 13 packets of size 120 bytes can be dequeued. sojourn time of 13th "
         "packet is 1.3ms which is"
         "less than CE threshold");
-    NS_TEST_EXPECT_MSG_EQ(q1->GetStats().GetNDroppedPackets(CoDelQueueDisc::TARGET_EXCEEDED_DROP),
-                          0,
-                          "There should not be any dropped packets");
     NS_TEST_EXPECT_MSG_EQ(
-        q1->GetStats().GetNMarkedPackets(CoDelQueueDisc::CE_THRESHOLD_EXCEEDED_MARK),
+        m_flowStats.GetNDroppedPackets(flow1, CoDelQueueDisc::TARGET_EXCEEDED_DROP),
+        0,
+        "There should not be any dropped packets");
+    NS_TEST_EXPECT_MSG_EQ(
+        m_flowStats.GetNMarkedPackets(flow1, CoDelQueueDisc::CE_THRESHOLD_EXCEEDED_MARK),
         6,
         "There should be 6 marked packets"
         "with quantum of 1514, 13 packets of size 120 bytes can be dequeued. sojourn time of 8th "
         "packet is 2.1ms which is greater"
         "than CE threshold and subsequent packet also have sojourn time more 8th packet hence "
         "remaining packet are marked.");
-    NS_TEST_EXPECT_MSG_EQ(q2->GetStats().GetNDroppedPackets(CoDelQueueDisc::TARGET_EXCEEDED_DROP),
-                          0,
-                          "There should not be any dropped packets");
     NS_TEST_EXPECT_MSG_EQ(
-        q2->GetStats().GetNMarkedPackets(CoDelQueueDisc::CE_THRESHOLD_EXCEEDED_MARK),
+        m_flowStats.GetNDroppedPackets(flow2, CoDelQueueDisc::TARGET_EXCEEDED_DROP),
+        0,
+        "There should not be any dropped packets");
+    NS_TEST_EXPECT_MSG_EQ(
+        m_flowStats.GetNMarkedPackets(flow2, CoDelQueueDisc::CE_THRESHOLD_EXCEEDED_MARK),
         13,
         "There should be 13 marked packets"
         "with quantum of 1514, 13 packets of size 120 bytes can be dequeued and all of them have "
@@ -1145,31 +1175,32 @@ FqCoDelQueueDiscECNMarking::DoRun()
 
     // As packets in flow queues are not ECN capable
     NS_TEST_EXPECT_MSG_EQ(
-        q3->GetStats().GetNMarkedPackets(CoDelQueueDisc::CE_THRESHOLD_EXCEEDED_MARK),
+        m_flowStats.GetNMarkedPackets(flow3, CoDelQueueDisc::CE_THRESHOLD_EXCEEDED_MARK),
         0,
         "There should not be any marked packets");
-    NS_TEST_EXPECT_MSG_EQ(q3->GetStats().GetNDroppedPackets(CoDelQueueDisc::TARGET_EXCEEDED_DROP),
-                          0,
-                          "There should not be any dropped packets");
     NS_TEST_EXPECT_MSG_EQ(
-        q4->GetStats().GetNMarkedPackets(CoDelQueueDisc::CE_THRESHOLD_EXCEEDED_MARK),
+        m_flowStats.GetNDroppedPackets(flow3, CoDelQueueDisc::TARGET_EXCEEDED_DROP),
+        0,
+        "There should not be any dropped packets");
+    NS_TEST_EXPECT_MSG_EQ(
+        m_flowStats.GetNMarkedPackets(flow4, CoDelQueueDisc::CE_THRESHOLD_EXCEEDED_MARK),
         0,
         "There should not be any marked packets");
-    NS_TEST_EXPECT_MSG_EQ(q4->GetStats().GetNDroppedPackets(CoDelQueueDisc::TARGET_EXCEEDED_DROP),
-                          0,
-                          "There should not be any dropped packets");
+    NS_TEST_EXPECT_MSG_EQ(
+        m_flowStats.GetNDroppedPackets(flow4, CoDelQueueDisc::TARGET_EXCEEDED_DROP),
+        0,
+        "There should not be any dropped packets");
 
     // Ensure flow queue 0,1 and 2 have ECN capable packets
-    // Peek () changes the stats of the queue and that is reason to be keep this test at last
-    pktQ0 = DynamicCast<const Ipv4QueueDiscItem>(q0->Peek());
+    pktQ0 = DynamicCast<const Ipv4QueueDiscItem>(queueDisc->GetFlowQueue(0).GetHead());
     NS_TEST_EXPECT_MSG_NE(pktQ0->GetHeader().GetEcn(),
                           Ipv4Header::ECN_NotECT,
                           "flow queue should have ECT0 packets");
-    pktQ1 = DynamicCast<const Ipv4QueueDiscItem>(q1->Peek());
+    pktQ1 = DynamicCast<const Ipv4QueueDiscItem>(queueDisc->GetFlowQueue(1).GetHead());
     NS_TEST_EXPECT_MSG_NE(pktQ1->GetHeader().GetEcn(),
                           Ipv4Header::ECN_NotECT,
                           "flow queue should have ECT0 packets");
-    pktQ2 = DynamicCast<const Ipv4QueueDiscItem>(q2->Peek());
+    pktQ2 = DynamicCast<const Ipv4QueueDiscItem>(queueDisc->GetFlowQueue(2).GetHead());
     NS_TEST_EXPECT_MSG_NE(pktQ2->GetHeader().GetEcn(),
                           Ipv4Header::ECN_NotECT,
                           "flow queue should have ECT0 packets");
@@ -1185,6 +1216,7 @@ FqCoDelQueueDiscECNMarking::DoRun()
                                                              TimeValue(MilliSeconds(2)));
     queueDisc->SetQuantum(1514);
     queueDisc->Initialize();
+    m_flowStats.Connect(queueDisc);
 
     // Add 20 ECT0 (ECN capable) packets from first flow
     hdr.SetDestination(Ipv4Address("10.10.1.2"));
@@ -1248,91 +1280,89 @@ FqCoDelQueueDiscECNMarking::DoRun()
     DequeueWithDelay(queueDisc, 0.110, 60);
     Simulator::Run();
     Simulator::Stop(Seconds(8));
-    q0 = queueDisc->GetQueueDiscClass(0)->GetQueueDisc()->GetObject<CoDelQueueDisc>();
-    q1 = queueDisc->GetQueueDiscClass(1)->GetQueueDisc()->GetObject<CoDelQueueDisc>();
-    q2 = queueDisc->GetQueueDiscClass(2)->GetQueueDisc()->GetObject<CoDelQueueDisc>();
-    q3 = queueDisc->GetQueueDiscClass(3)->GetQueueDisc()->GetObject<CoDelQueueDisc>();
-    q4 = queueDisc->GetQueueDiscClass(4)->GetQueueDisc()->GetObject<CoDelQueueDisc>();
 
     // Ensure there are some remaining packets in the flow queues to check for flow queues with ECN
     // capable packets
-    NS_TEST_EXPECT_MSG_NE(queueDisc->GetQueueDiscClass(0)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_EXPECT_MSG_NE(queueDisc->GetFlowQueue(0).GetNPackets(),
                           0,
                           "There should be some remaining packets");
-    NS_TEST_EXPECT_MSG_NE(queueDisc->GetQueueDiscClass(1)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_EXPECT_MSG_NE(queueDisc->GetFlowQueue(1).GetNPackets(),
                           0,
                           "There should be some remaining packets");
-    NS_TEST_EXPECT_MSG_NE(queueDisc->GetQueueDiscClass(2)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_EXPECT_MSG_NE(queueDisc->GetFlowQueue(2).GetNPackets(),
                           0,
                           "There should be some remaining packets");
-    NS_TEST_EXPECT_MSG_NE(queueDisc->GetQueueDiscClass(3)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_EXPECT_MSG_NE(queueDisc->GetFlowQueue(3).GetNPackets(),
                           0,
                           "There should be some remaining packets");
-    NS_TEST_EXPECT_MSG_NE(queueDisc->GetQueueDiscClass(4)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_EXPECT_MSG_NE(queueDisc->GetFlowQueue(4).GetNPackets(),
                           0,
                           "There should be some remaining packets");
 
     // As packets in flow queues are ECN capable
-    NS_TEST_EXPECT_MSG_EQ(q0->GetStats().GetNDroppedPackets(CoDelQueueDisc::TARGET_EXCEEDED_DROP),
-                          0,
-                          "There should not be any dropped packets");
     NS_TEST_EXPECT_MSG_EQ(
-        q0->GetStats().GetNMarkedPackets(CoDelQueueDisc::CE_THRESHOLD_EXCEEDED_MARK) +
-            q0->GetStats().GetNMarkedPackets(CoDelQueueDisc::TARGET_EXCEEDED_MARK),
-        20 - q0->GetNPackets(),
+        m_flowStats.GetNDroppedPackets(flow0, CoDelQueueDisc::TARGET_EXCEEDED_DROP),
+        0,
+        "There should not be any dropped packets");
+    NS_TEST_EXPECT_MSG_EQ(
+        m_flowStats.GetNMarkedPackets(flow0, CoDelQueueDisc::CE_THRESHOLD_EXCEEDED_MARK) +
+            m_flowStats.GetNMarkedPackets(flow0, CoDelQueueDisc::TARGET_EXCEEDED_MARK),
+        20 - queueDisc->GetFlowQueue(0).GetNPackets(),
         "Number of CE threshold"
         " exceeded marks plus Number of Target exceeded marks should be equal to total number of "
         "packets dequeued");
-    NS_TEST_EXPECT_MSG_EQ(q1->GetStats().GetNDroppedPackets(CoDelQueueDisc::TARGET_EXCEEDED_DROP),
-                          0,
-                          "There should not be any dropped packets");
     NS_TEST_EXPECT_MSG_EQ(
-        q1->GetStats().GetNMarkedPackets(CoDelQueueDisc::CE_THRESHOLD_EXCEEDED_MARK) +
-            q1->GetStats().GetNMarkedPackets(CoDelQueueDisc::TARGET_EXCEEDED_MARK),
-        20 - q1->GetNPackets(),
+        m_flowStats.GetNDroppedPackets(flow1, CoDelQueueDisc::TARGET_EXCEEDED_DROP),
+        0,
+        "There should not be any dropped packets");
+    NS_TEST_EXPECT_MSG_EQ(
+        m_flowStats.GetNMarkedPackets(flow1, CoDelQueueDisc::CE_THRESHOLD_EXCEEDED_MARK) +
+            m_flowStats.GetNMarkedPackets(flow1, CoDelQueueDisc::TARGET_EXCEEDED_MARK),
+        20 - queueDisc->GetFlowQueue(1).GetNPackets(),
         "Number of CE threshold"
         " exceeded marks plus Number of Target exceeded marks should be equal to total number of "
         "packets dequeued");
-    NS_TEST_EXPECT_MSG_EQ(q2->GetStats().GetNDroppedPackets(CoDelQueueDisc::TARGET_EXCEEDED_DROP),
-                          0,
-                          "There should not be any dropped packets");
     NS_TEST_EXPECT_MSG_EQ(
-        q2->GetStats().GetNMarkedPackets(CoDelQueueDisc::CE_THRESHOLD_EXCEEDED_MARK) +
-            q2->GetStats().GetNMarkedPackets(CoDelQueueDisc::TARGET_EXCEEDED_MARK),
-        20 - q2->GetNPackets(),
+        m_flowStats.GetNDroppedPackets(flow2, CoDelQueueDisc::TARGET_EXCEEDED_DROP),
+        0,
+        "There should not be any dropped packets");
+    NS_TEST_EXPECT_MSG_EQ(
+        m_flowStats.GetNMarkedPackets(flow2, CoDelQueueDisc::CE_THRESHOLD_EXCEEDED_MARK) +
+            m_flowStats.GetNMarkedPackets(flow2, CoDelQueueDisc::TARGET_EXCEEDED_MARK),
+        20 - queueDisc->GetFlowQueue(2).GetNPackets(),
         "Number of CE threshold"
         " exceeded marks plus Number of Target exceeded marks should be equal to total number of "
         "packets dequeued");
 
     // As packets in flow queues are not ECN capable
     NS_TEST_EXPECT_MSG_EQ(
-        q3->GetStats().GetNMarkedPackets(CoDelQueueDisc::CE_THRESHOLD_EXCEEDED_MARK),
+        m_flowStats.GetNMarkedPackets(flow3, CoDelQueueDisc::CE_THRESHOLD_EXCEEDED_MARK),
         0,
         "There should not be any marked packets");
     NS_TEST_EXPECT_MSG_EQ(
-        q3->GetStats().GetNDroppedPackets(CoDelQueueDisc::TARGET_EXCEEDED_DROP),
+        m_flowStats.GetNDroppedPackets(flow3, CoDelQueueDisc::TARGET_EXCEEDED_DROP),
         4,
         "There should be 4 dropped packets"
         " As queue delay is same as in test case 1, number of dropped packets should also be same");
     NS_TEST_EXPECT_MSG_EQ(
-        q4->GetStats().GetNMarkedPackets(CoDelQueueDisc::CE_THRESHOLD_EXCEEDED_MARK),
+        m_flowStats.GetNMarkedPackets(flow4, CoDelQueueDisc::CE_THRESHOLD_EXCEEDED_MARK),
         0,
         "There should not be any marked packets");
-    NS_TEST_EXPECT_MSG_EQ(q4->GetStats().GetNDroppedPackets(CoDelQueueDisc::TARGET_EXCEEDED_DROP),
-                          4,
-                          "There should be 4 dropped packets");
+    NS_TEST_EXPECT_MSG_EQ(
+        m_flowStats.GetNDroppedPackets(flow4, CoDelQueueDisc::TARGET_EXCEEDED_DROP),
+        4,
+        "There should be 4 dropped packets");
 
     // Ensure flow queue 0,1 and 2 have ECN capable packets
-    // Peek () changes the stats of the queue and that is reason to be keep this test at last
-    pktQ0 = DynamicCast<const Ipv4QueueDiscItem>(q0->Peek());
+    pktQ0 = DynamicCast<const Ipv4QueueDiscItem>(queueDisc->GetFlowQueue(0).GetHead());
     NS_TEST_EXPECT_MSG_NE(pktQ0->GetHeader().GetEcn(),
                           Ipv4Header::ECN_NotECT,
                           "flow queue should have ECT0 packets");
-    pktQ1 = DynamicCast<const Ipv4QueueDiscItem>(q1->Peek());
+    pktQ1 = DynamicCast<const Ipv4QueueDiscItem>(queueDisc->GetFlowQueue(1).GetHead());
     NS_TEST_EXPECT_MSG_NE(pktQ1->GetHeader().GetEcn(),
                           Ipv4Header::ECN_NotECT,
                           "flow queue should have ECT0 packets");
-    pktQ2 = DynamicCast<const Ipv4QueueDiscItem>(q2->Peek());
+    pktQ2 = DynamicCast<const Ipv4QueueDiscItem>(queueDisc->GetFlowQueue(2).GetHead());
     NS_TEST_EXPECT_MSG_NE(pktQ2->GetHeader().GetEcn(),
                           Ipv4Header::ECN_NotECT,
                           "flow queue should have ECT0 packets");
@@ -1440,38 +1470,38 @@ FqCoDelQueueDiscSetLinearProbing::DoRun()
     NS_TEST_ASSERT_MSG_EQ(queueDisc->QueueDisc::GetNPackets(),
                           11,
                           "unexpected number of packets in the queue disc");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(0)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetNPackets(),
                           2,
                           "unexpected number of packets in the first flow queue of set one");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(1)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(1).GetNPackets(),
                           2,
                           "unexpected number of packets in the second flow queue of set one");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(2)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(2).GetNPackets(),
                           1,
                           "unexpected number of packets in the third flow queue of set one");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(3)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(3).GetNPackets(),
                           1,
                           "unexpected number of packets in the fourth flow queue of set one");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(4)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(4).GetNPackets(),
                           2,
                           "unexpected number of packets in the fifth flow queue of set one");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(5)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(5).GetNPackets(),
                           1,
                           "unexpected number of packets in the sixth flow queue of set one");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(6)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(6).GetNPackets(),
                           1,
                           "unexpected number of packets in the seventh flow queue of set one");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(7)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(7).GetNPackets(),
                           1,
                           "unexpected number of packets in the eighth flow queue of set one");
     g_hash = 1025;
     AddPacket(queueDisc, hdr);
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(0)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetNPackets(),
                           3,
                           "unexpected number of packets in the first flow of set one");
     g_hash = 10;
     AddPacket(queueDisc, hdr);
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(8)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(8).GetNPackets(),
                           1,
                           "unexpected number of packets in the first flow of set two");
     Simulator::Destroy();
@@ -1526,6 +1556,8 @@ class FqCoDelQueueDiscL4sMode : public TestCase
      * @param nPkt The number of packets to dequeue.
      */
     void DequeueWithDelay(Ptr<FqCoDelQueueDisc> queue, double delay, uint32_t nPkt);
+
+    QueueDiscFlowStats m_flowStats; //!< Per flow statistics
 };
 
 FqCoDelQueueDiscL4sMode::FqCoDelQueueDiscL4sMode()
@@ -1610,6 +1642,7 @@ FqCoDelQueueDiscL4sMode::DoRun()
 
     queueDisc->SetQuantum(1514);
     queueDisc->Initialize();
+    m_flowStats.Connect(queueDisc);
     Ipv4Header hdr;
     hdr.SetPayloadSize(100);
     hdr.SetSource(Ipv4Address("10.10.1.1"));
@@ -1644,13 +1677,11 @@ FqCoDelQueueDiscL4sMode::DoRun()
     DequeueWithDelay(queueDisc, delay, 140);
     Simulator::Run();
     Simulator::Stop(Seconds(8));
-    Ptr<CoDelQueueDisc> q0 =
-        queueDisc->GetQueueDiscClass(0)->GetQueueDisc()->GetObject<CoDelQueueDisc>();
-    Ptr<CoDelQueueDisc> q1 =
-        queueDisc->GetQueueDiscClass(1)->GetQueueDisc()->GetObject<CoDelQueueDisc>();
+    Ipv4Address flow0("10.10.1.2");
+    Ipv4Address flow1("10.10.1.10");
 
     NS_TEST_EXPECT_MSG_EQ(
-        q0->GetStats().GetNMarkedPackets(CoDelQueueDisc::CE_THRESHOLD_EXCEEDED_MARK),
+        m_flowStats.GetNMarkedPackets(flow0, CoDelQueueDisc::CE_THRESHOLD_EXCEEDED_MARK),
         66,
         "There should be 66 marked packets"
         "4th packet is enqueued at 2ms and dequeued at 4ms hence the delay of 2ms which not "
@@ -1658,18 +1689,22 @@ FqCoDelQueueDiscL4sMode::DoRun()
         "5th packet is enqueued at 2.5ms and dequeued at 5ms hence the delay of 2.5ms and "
         "subsequent packet also do have delay"
         "greater than CE threshold so all the packets after 4th packet are marked");
-    NS_TEST_EXPECT_MSG_EQ(q0->GetStats().GetNDroppedPackets(CoDelQueueDisc::TARGET_EXCEEDED_DROP),
-                          0,
-                          "There should not be any dropped packets");
-    NS_TEST_EXPECT_MSG_EQ(q0->GetStats().GetNMarkedPackets(CoDelQueueDisc::TARGET_EXCEEDED_MARK),
-                          0,
-                          "There should not be any marked packets");
-    NS_TEST_EXPECT_MSG_EQ(q1->GetStats().GetNMarkedPackets(CoDelQueueDisc::TARGET_EXCEEDED_MARK),
-                          1,
-                          "There should be 1 marked packets");
-    NS_TEST_EXPECT_MSG_EQ(q1->GetStats().GetNDroppedPackets(CoDelQueueDisc::TARGET_EXCEEDED_DROP),
-                          0,
-                          "There should not be any dropped packets");
+    NS_TEST_EXPECT_MSG_EQ(
+        m_flowStats.GetNDroppedPackets(flow0, CoDelQueueDisc::TARGET_EXCEEDED_DROP),
+        0,
+        "There should not be any dropped packets");
+    NS_TEST_EXPECT_MSG_EQ(
+        m_flowStats.GetNMarkedPackets(flow0, CoDelQueueDisc::TARGET_EXCEEDED_MARK),
+        0,
+        "There should not be any marked packets");
+    NS_TEST_EXPECT_MSG_EQ(
+        m_flowStats.GetNMarkedPackets(flow1, CoDelQueueDisc::TARGET_EXCEEDED_MARK),
+        1,
+        "There should be 1 marked packets");
+    NS_TEST_EXPECT_MSG_EQ(
+        m_flowStats.GetNDroppedPackets(flow1, CoDelQueueDisc::TARGET_EXCEEDED_DROP),
+        0,
+        "There should not be any dropped packets");
 
     Simulator::Destroy();
 
@@ -1687,6 +1722,7 @@ FqCoDelQueueDiscL4sMode::DoRun()
 
     queueDisc->SetQuantum(1514);
     queueDisc->Initialize();
+    m_flowStats.Connect(queueDisc);
     hdr.SetPayloadSize(100);
     hdr.SetSource(Ipv4Address("10.10.1.1"));
     hdr.SetDestination(Ipv4Address("10.10.1.2"));
@@ -1724,10 +1760,9 @@ FqCoDelQueueDiscL4sMode::DoRun()
     DequeueWithDelay(queueDisc, delay, 140);
     Simulator::Run();
     Simulator::Stop(Seconds(8));
-    q0 = queueDisc->GetQueueDiscClass(0)->GetQueueDisc()->GetObject<CoDelQueueDisc>();
 
     NS_TEST_EXPECT_MSG_EQ(
-        q0->GetStats().GetNMarkedPackets(CoDelQueueDisc::CE_THRESHOLD_EXCEEDED_MARK),
+        m_flowStats.GetNMarkedPackets(flow0, CoDelQueueDisc::CE_THRESHOLD_EXCEEDED_MARK),
         68,
         "There should be 68 marked packets"
         "2nd ECT1 packet is enqueued at 1.5ms and dequeued at 3ms hence the delay of 1.5ms which "
@@ -1735,12 +1770,14 @@ FqCoDelQueueDiscL4sMode::DoRun()
         "3rd packet is enqueued at 2.5ms and dequeued at 5ms hence the delay of 2.5ms and "
         "subsequent packet also do have delay"
         "greater than CE threshold so all the packets after 2nd packet are marked");
-    NS_TEST_EXPECT_MSG_EQ(q0->GetStats().GetNDroppedPackets(CoDelQueueDisc::TARGET_EXCEEDED_DROP),
-                          0,
-                          "There should not be any dropped packets");
-    NS_TEST_EXPECT_MSG_EQ(q0->GetStats().GetNMarkedPackets(CoDelQueueDisc::TARGET_EXCEEDED_MARK),
-                          1,
-                          "There should be 1 marked packets");
+    NS_TEST_EXPECT_MSG_EQ(
+        m_flowStats.GetNDroppedPackets(flow0, CoDelQueueDisc::TARGET_EXCEEDED_DROP),
+        0,
+        "There should not be any dropped packets");
+    NS_TEST_EXPECT_MSG_EQ(
+        m_flowStats.GetNMarkedPackets(flow0, CoDelQueueDisc::TARGET_EXCEEDED_MARK),
+        1,
+        "There should be 1 marked packets");
 
     Simulator::Destroy();
 }
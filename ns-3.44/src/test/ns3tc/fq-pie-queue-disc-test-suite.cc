@@ -14,6 +14,8 @@
  *
  */
 
+#include "ns3tc-flow-stats.h"
+
 #include "ns3/fq-pie-queue-disc.h"
 #include "ns3/ipv4-address.h"
 #include "ns3/ipv4-header.h"
@@ -142,14 +144,14 @@ FqPieQueueDiscNoSuitableFilter::DoRun()
     Address dest;
     item = Create<Ipv6QueueDiscItem>(p, dest, 0, ipv6Header);
     queueDisc->Enqueue(item);
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetNQueueDiscClasses(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetNFlowQueues(),
                           0,
                           "no flow queue should have been created");
 
     p = Create<Packet>(reinterpret_cast<const uint8_t*>("hello, world"), 12);
     item = Create<Ipv6QueueDiscItem>(p, dest, 0, ipv6Header);
     queueDisc->Enqueue(item);
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetNQueueDiscClasses(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetNFlowQueues(),
                           0,
                           "no flow queue should have been created");
 
@@ -217,7 +219,7 @@ FqPieQueueDiscIPFlowsSeparationAndPacketLimit::DoRun()
     NS_TEST_ASSERT_MSG_EQ(queueDisc->QueueDisc::GetNPackets(),
                           3,
                           "unexpected number of packets in the queue disc");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(0)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetNPackets(),
                           3,
                           "unexpected number of packets in the flow queue");
 
@@ -228,10 +230,10 @@ FqPieQueueDiscIPFlowsSeparationAndPacketLimit::DoRun()
     NS_TEST_ASSERT_MSG_EQ(queueDisc->QueueDisc::GetNPackets(),
                           4,
                           "unexpected number of packets in the queue disc");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(0)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetNPackets(),
                           3,
                           "unexpected number of packets in the flow queue");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(1)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(1).GetNPackets(),
                           1,
                           "unexpected number of packets in the flow queue");
     // Add the second packet that causes two packets to be dropped from the fat flow (max backlog =
@@ -240,10 +242,10 @@ FqPieQueueDiscIPFlowsSeparationAndPacketLimit::DoRun()
     NS_TEST_ASSERT_MSG_EQ(queueDisc->QueueDisc::GetNPackets(),
                           3,
                           "unexpected number of packets in the queue disc");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(0)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetNPackets(),
                           1,
                           "unexpected number of packets in the flow queue");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(1)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(1).GetNPackets(),
                           2,
                           "unexpected number of packets in the flow queue");
 
@@ -308,14 +310,13 @@ FqPieQueueDiscDeficit::DoRun()
     NS_TEST_ASSERT_MSG_EQ(queueDisc->QueueDisc::GetNPackets(),
                           1,
                           "unexpected number of packets in the queue disc");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(0)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetNPackets(),
                           1,
                           "unexpected number of packets in the first flow queue");
-    Ptr<FqPieFlow> flow1 = StaticCast<FqPieFlow>(queueDisc->GetQueueDiscClass(0));
-    NS_TEST_ASSERT_MSG_EQ(flow1->GetDeficit(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetDeficit(),
                           static_cast<int32_t>(queueDisc->GetQuantum()),
                           "the deficit of the first flow must equal the quantum");
-    NS_TEST_ASSERT_MSG_EQ(flow1->GetStatus(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetStatus(),
                           FqPieFlow::NEW_FLOW,
                           "the first flow must be in the list of new queues");
     // Dequeue a packet
@@ -323,11 +324,13 @@ FqPieQueueDiscDeficit::DoRun()
     NS_TEST_ASSERT_MSG_EQ(queueDisc->QueueDisc::GetNPackets(),
                           0,
                           "unexpected number of packets in the queue disc");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(0)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetNPackets(),
                           0,
                           "unexpected number of packets in the first flow queue");
     // the deficit for the first flow becomes 90 - (100+20) = -30
-    NS_TEST_ASSERT_MSG_EQ(flow1->GetDeficit(), -30, "unexpected deficit for the first flow");
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetDeficit(),
+                          -30,
+                          "unexpected deficit for the first flow");
 
     // Add two packets from the first flow
     AddPacket(queueDisc, hdr);
@@ -335,10 +338,10 @@ FqPieQueueDiscDeficit::DoRun()
     NS_TEST_ASSERT_MSG_EQ(queueDisc->QueueDisc::GetNPackets(),
                           2,
                           "unexpected number of packets in the queue disc");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(0)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetNPackets(),
                           2,
                           "unexpected number of packets in the first flow queue");
-    NS_TEST_ASSERT_MSG_EQ(flow1->GetStatus(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetStatus(),
                           FqPieFlow::NEW_FLOW,
                           "the first flow must still be in the list of new queues");
 
@@ -349,17 +352,16 @@ FqPieQueueDiscDeficit::DoRun()
     NS_TEST_ASSERT_MSG_EQ(queueDisc->QueueDisc::GetNPackets(),
                           4,
                           "unexpected number of packets in the queue disc");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(0)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetNPackets(),
                           2,
                           "unexpected number of packets in the first flow queue");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(1)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(1).GetNPackets(),
                           2,
                           "unexpected number of packets in the second flow queue");
-    Ptr<FqPieFlow> flow2 = StaticCast<FqPieFlow>(queueDisc->GetQueueDiscClass(1));
-    NS_TEST_ASSERT_MSG_EQ(flow2->GetDeficit(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(1).GetDeficit(),
                           static_cast<int32_t>(queueDisc->GetQuantum()),
                           "the deficit of the second flow must equal the quantum");
-    NS_TEST_ASSERT_MSG_EQ(flow2->GetStatus(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(1).GetStatus(),
                           FqPieFlow::NEW_FLOW,
                           "the second flow must be in the list of new queues");
 
@@ -368,21 +370,25 @@ FqPieQueueDiscDeficit::DoRun()
     NS_TEST_ASSERT_MSG_EQ(queueDisc->QueueDisc::GetNPackets(),
                           3,
                           "unexpected number of packets in the queue disc");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(0)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetNPackets(),
                           2,
                           "unexpected number of packets in the first flow queue");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(1)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(1).GetNPackets(),
                           1,
                           "unexpected number of packets in the second flow queue");
     // the first flow got a quantum of deficit (-30+90=60) and has been moved to the end of the list
     // of old queues
-    NS_TEST_ASSERT_MSG_EQ(flow1->GetDeficit(), 60, "unexpected deficit for the first flow");
-    NS_TEST_ASSERT_MSG_EQ(flow1->GetStatus(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetDeficit(),
+                          60,
+                          "unexpected deficit for the first flow");
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetStatus(),
                           FqPieFlow::OLD_FLOW,
                           "the first flow must be in the list of old queues");
     // the second flow has a negative deficit (-30) and is still in the list of new queues
-    NS_TEST_ASSERT_MSG_EQ(flow2->GetDeficit(), -30, "unexpected deficit for the second flow");
-    NS_TEST_ASSERT_MSG_EQ(flow2->GetStatus(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(1).GetDeficit(),
+                          -30,
+                          "unexpected deficit for the second flow");
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(1).GetStatus(),
                           FqPieFlow::NEW_FLOW,
                           "the second flow must be in the list of new queues");
 
@@ -391,21 +397,25 @@ FqPieQueueDiscDeficit::DoRun()
     NS_TEST_ASSERT_MSG_EQ(queueDisc->QueueDisc::GetNPackets(),
                           2,
                           "unexpected number of packets in the queue disc");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(0)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetNPackets(),
                           1,
                           "unexpected number of packets in the first flow queue");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(1)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(1).GetNPackets(),
                           1,
                           "unexpected number of packets in the second flow queue");
     // the first flow has a negative deficit (60-(100+20)= -60) and stays in the list of old queues
-    NS_TEST_ASSERT_MSG_EQ(flow1->GetDeficit(), -60, "unexpected deficit for the first flow");
-    NS_TEST_ASSERT_MSG_EQ(flow1->GetStatus(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetDeficit(),
+                          -60,
+                          "unexpected deficit for the first flow");
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetStatus(),
                           FqPieFlow::OLD_FLOW,
                           "the first flow must be in the list of old queues");
     // the second flow got a quantum of deficit (-30+90=60) and has been moved to the end of the
     // list of old queues
-    NS_TEST_ASSERT_MSG_EQ(flow2->GetDeficit(), 60, "unexpected deficit for the second flow");
-    NS_TEST_ASSERT_MSG_EQ(flow2->GetStatus(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(1).GetDeficit(),
+                          60,
+                          "unexpected deficit for the second flow");
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(1).GetStatus(),
                           FqPieFlow::OLD_FLOW,
                           "the second flow must be in the list of new queues");
 
@@ -414,21 +424,25 @@ FqPieQueueDiscDeficit::DoRun()
     NS_TEST_ASSERT_MSG_EQ(queueDisc->QueueDisc::GetNPackets(),
                           1,
                           "unexpected number of packets in the queue disc");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(0)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetNPackets(),
                           1,
                           "unexpected number of packets in the first flow queue");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(1)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(1).GetNPackets(),
                           0,
                           "unexpected number of packets in the second flow queue");
     // the first flow got a quantum of deficit (-60+90=30) and has been moved to the end of the list
     // of old queues
-    NS_TEST_ASSERT_MSG_EQ(flow1->GetDeficit(), 30, "unexpected deficit for the first flow");
-    NS_TEST_ASSERT_MSG_EQ(flow1->GetStatus(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetDeficit(),
+                          30,
+                          "unexpected deficit for the first flow");
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetStatus(),
                           FqPieFlow::OLD_FLOW,
                           "the first flow must be in the list of old queues");
     // the second flow has a negative deficit (60-(100+20)= -60)
-    NS_TEST_ASSERT_MSG_EQ(flow2->GetDeficit(), -60, "unexpected deficit for the second flow");
-    NS_TEST_ASSERT_MSG_EQ(flow2->GetStatus(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(1).GetDeficit(),
+                          -60,
+                          "unexpected deficit for the second flow");
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(1).GetStatus(),
                           FqPieFlow::OLD_FLOW,
                           "the second flow must be in the list of new queues");
 
@@ -437,21 +451,25 @@ FqPieQueueDiscDeficit::DoRun()
     NS_TEST_ASSERT_MSG_EQ(queueDisc->QueueDisc::GetNPackets(),
                           0,
                           "unexpected number of packets in the queue disc");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(0)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetNPackets(),
                           0,
                           "unexpected number of packets in the first flow queue");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(1)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(1).GetNPackets(),
                           0,
                           "unexpected number of packets in the second flow queue");
     // the first flow has a negative deficit (30-(100+20)= -90)
-    NS_TEST_ASSERT_MSG_EQ(flow1->GetDeficit(), -90, "unexpected deficit for the first flow");
-    NS_TEST_ASSERT_MSG_EQ(flow1->GetStatus(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetDeficit(),
+                          -90,
+                          "unexpected deficit for the first flow");
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetStatus(),
                           FqPieFlow::OLD_FLOW,
                           "the first flow must be in the list of old queues");
     // the second flow got a quantum of deficit (-60+90=30) and has been moved to the end of the
     // list of old queues
-    NS_TEST_ASSERT_MSG_EQ(flow2->GetDeficit(), 30, "unexpected deficit for the second flow");
-    NS_TEST_ASSERT_MSG_EQ(flow2->GetStatus(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(1).GetDeficit(),
+                          30,
+                          "unexpected deficit for the second flow");
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(1).GetStatus(),
                           FqPieFlow::OLD_FLOW,
                           "the second flow must be in the list of new queues");
 
@@ -464,12 +482,16 @@ FqPieQueueDiscDeficit::DoRun()
     // it gets another quantum of deficit (0+90=90). Then, the first flow is reconsidered again, now
     // it has a positive deficit and hence it is selected. But, it is empty and therefore is set to
     // inactive, too.
-    NS_TEST_ASSERT_MSG_EQ(flow1->GetDeficit(), 90, "unexpected deficit for the first flow");
-    NS_TEST_ASSERT_MSG_EQ(flow1->GetStatus(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetDeficit(),
+                          90,
+                          "unexpected deficit for the first flow");
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetStatus(),
                           FqPieFlow::INACTIVE,
                           "the first flow must be inactive");
-    NS_TEST_ASSERT_MSG_EQ(flow2->GetDeficit(), 30, "unexpected deficit for the second flow");
-    NS_TEST_ASSERT_MSG_EQ(flow2->GetStatus(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(1).GetDeficit(),
+                          30,
+                          "unexpected deficit for the second flow");
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(1).GetStatus(),
                           FqPieFlow::INACTIVE,
                           "the second flow must be inactive");
 
@@ -545,7 +567,7 @@ FqPieQueueDiscTCPFlowsSeparation::DoRun()
     NS_TEST_ASSERT_MSG_EQ(queueDisc->QueueDisc::GetNPackets(),
                           3,
                           "unexpected number of packets in the queue disc");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(0)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetNPackets(),
                           3,
                           "unexpected number of packets in the first flow queue");
 
@@ -555,10 +577,10 @@ FqPieQueueDiscTCPFlowsSeparation::DoRun()
     NS_TEST_ASSERT_MSG_EQ(queueDisc->QueueDisc::GetNPackets(),
                           4,
                           "unexpected number of packets in the queue disc");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(0)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetNPackets(),
                           3,
                           "unexpected number of packets in the first flow queue");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(1)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(1).GetNPackets(),
                           1,
                           "unexpected number of packets in the second flow queue");
 
@@ -568,13 +590,13 @@ FqPieQueueDiscTCPFlowsSeparation::DoRun()
     NS_TEST_ASSERT_MSG_EQ(queueDisc->QueueDisc::GetNPackets(),
                           5,
                           "unexpected number of packets in the queue disc");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(0)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetNPackets(),
                           3,
                           "unexpected number of packets in the first flow queue");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(1)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(1).GetNPackets(),
                           1,
                           "unexpected number of packets in the second flow queue");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(2)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(2).GetNPackets(),
                           1,
                           "unexpected number of packets in the third flow queue");
 
@@ -585,16 +607,16 @@ FqPieQueueDiscTCPFlowsSeparation::DoRun()
     NS_TEST_ASSERT_MSG_EQ(queueDisc->QueueDisc::GetNPackets(),
                           7,
                           "unexpected number of packets in the queue disc");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(0)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetNPackets(),
                           3,
                           "unexpected number of packets in the first flow queue");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(1)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(1).GetNPackets(),
                           1,
                           "unexpected number of packets in the second flow queue");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(2)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(2).GetNPackets(),
                           1,
                           "unexpected number of packets in the third flow queue");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(3)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(3).GetNPackets(),
                           2,
                           "unexpected number of packets in the third flow queue");
 
@@ -670,7 +692,7 @@ FqPieQueueDiscUDPFlowsSeparation::DoRun()
     NS_TEST_ASSERT_MSG_EQ(queueDisc->QueueDisc::GetNPackets(),
                           3,
                           "unexpected number of packets in the queue disc");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(0)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetNPackets(),
                           3,
                           "unexpected number of packets in the first flow queue");
 
@@ -680,10 +702,10 @@ FqPieQueueDiscUDPFlowsSeparation::DoRun()
     NS_TEST_ASSERT_MSG_EQ(queueDisc->QueueDisc::GetNPackets(),
                           4,
                           "unexpected number of packets in the queue disc");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(0)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetNPackets(),
                           3,
                           "unexpected number of packets in the first flow queue");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(1)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(1).GetNPackets(),
                           1,
                           "unexpected number of packets in the second flow queue");
 
@@ -693,13 +715,13 @@ FqPieQueueDiscUDPFlowsSeparation::DoRun()
     NS_TEST_ASSERT_MSG_EQ(queueDisc->QueueDisc::GetNPackets(),
                           5,
                           "unexpected number of packets in the queue disc");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(0)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetNPackets(),
                           3,
                           "unexpected number of packets in the first flow queue");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(1)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(1).GetNPackets(),
                           1,
                           "unexpected number of packets in the second flow queue");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(2)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(2).GetNPackets(),
                           1,
                           "unexpected number of packets in the third flow queue");
 
@@ -710,16 +732,16 @@ FqPieQueueDiscUDPFlowsSeparation::DoRun()
     NS_TEST_ASSERT_MSG_EQ(queueDisc->QueueDisc::GetNPackets(),
                           7,
                           "unexpected number of packets in the queue disc");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(0)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetNPackets(),
                           3,
                           "unexpected number of packets in the first flow queue");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(1)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(1).GetNPackets(),
                           1,
                           "unexpected number of packets in the second flow queue");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(2)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(2).GetNPackets(),
                           1,
                           "unexpected number of packets in the third flow queue");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(3)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(3).GetNPackets(),
                           2,
                           "unexpected number of packets in the third flow queue");
 
@@ -827,38 +849,38 @@ FqPieQueueDiscSetLinearProbing::DoRun()
     NS_TEST_ASSERT_MSG_EQ(queueDisc->QueueDisc::GetNPackets(),
                           11,
                           "unexpected number of packets in the queue disc");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(0)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetNPackets(),
                           2,
                           "unexpected number of packets in the first flow queue of set one");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(1)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(1).GetNPackets(),
                           2,
                           "unexpected number of packets in the second flow queue of set one");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(2)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(2).GetNPackets(),
                           1,
                           "unexpected number of packets in the third flow queue of set one");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(3)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(3).GetNPackets(),
                           1,
                           "unexpected number of packets in the fourth flow queue of set one");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(4)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(4).GetNPackets(),
                           2,
                           "unexpected number of packets in the fifth flow queue of set one");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(5)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(5).GetNPackets(),
                           1,
                           "unexpected number of packets in the sixth flow queue of set one");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(6)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(6).GetNPackets(),
                           1,
                           "unexpected number of packets in the seventh flow queue of set one");
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(7)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(7).GetNPackets(),
                           1,
                           "unexpected number of packets in the eighth flow queue of set one");
     g_hash = 1025;
     AddPacket(queueDisc, hdr);
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(0)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(0).GetNPackets(),
                           3,
                           "unexpected number of packets in the first flow of set one");
     g_hash = 10;
     AddPacket(queueDisc, hdr);
-    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(8)->GetQueueDisc()->GetNPackets(),
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetFlowQueue(8).GetNPackets(),
                           1,
                           "unexpected number of packets in the first flow of set two");
     Simulator::Destroy();
@@ -914,6 +936,8 @@ class FqPieQueueDiscL4sMode : public TestCase
      * @param nPkt The number of packets.
      */
     void DequeueWithDelay(Ptr<FqPieQueueDisc> queue, double delay, uint32_t nPkt);
+
+    QueueDiscFlowStats m_flowStats; //!< Per flow statistics
 };
 
 FqPieQueueDiscL4sMode::FqPieQueueDiscL4sMode()
@@ -998,6 +1022,7 @@ FqPieQueueDiscL4sMode::DoRun()
 
     queueDisc->SetQuantum(1514);
     queueDisc->Initialize();
+    m_flowStats.Connect(queueDisc);
     Ipv4Header hdr;
     hdr.SetPayloadSize(100);
     hdr.SetSource(Ipv4Address("10.10.1.1"));
@@ -1033,13 +1058,11 @@ FqPieQueueDiscL4sMode::DoRun()
     Simulator::Stop(Seconds(10));
     Simulator::Run();
 
-    Ptr<PieQueueDisc> q0 =
-        queueDisc->GetQueueDiscClass(0)->GetQueueDisc()->GetObject<PieQueueDisc>();
-    Ptr<PieQueueDisc> q1 =
-        queueDisc->GetQueueDiscClass(1)->GetQueueDisc()->GetObject<PieQueueDisc>();
+    Ipv4Address flow0("10.10.1.2");
+    Ipv4Address flow1("10.10.1.10");
 
     NS_TEST_EXPECT_MSG_EQ(
-        q0->GetStats().GetNMarkedPackets(PieQueueDisc::CE_THRESHOLD_EXCEEDED_MARK),
+        m_flowStats.GetNMarkedPackets(flow0, PieQueueDisc::CE_THRESHOLD_EXCEEDED_MARK),
         66,
         "There should be 66 marked packets"
         "4th packet is enqueued at 2ms and dequeued at 4ms hence the delay of 2ms which not "
@@ -1047,17 +1070,17 @@ FqPieQueueDiscL4sMode::DoRun()
         "5th packet is enqueued at 2.5ms and dequeued at 5ms hence the delay of 2.5ms and "
         "subsequent packet also do have delay"
         "greater than CE threshold so all the packets after 4th packet are marked");
-    NS_TEST_EXPECT_MSG_EQ(q0->GetStats().GetNDroppedPackets(PieQueueDisc::UNFORCED_DROP),
+    NS_TEST_EXPECT_MSG_EQ(m_flowStats.GetNDroppedPackets(flow0, PieQueueDisc::UNFORCED_DROP),
                           0,
                           "Queue delay is less than max burst allowance so"
                           "There should not be any dropped packets");
-    NS_TEST_EXPECT_MSG_EQ(q0->GetStats().GetNMarkedPackets(PieQueueDisc::UNFORCED_MARK),
+    NS_TEST_EXPECT_MSG_EQ(m_flowStats.GetNMarkedPackets(flow0, PieQueueDisc::UNFORCED_MARK),
                           0,
                           "There should not be any marked packets");
-    NS_TEST_EXPECT_MSG_EQ(q1->GetStats().GetNMarkedPackets(PieQueueDisc::UNFORCED_MARK),
+    NS_TEST_EXPECT_MSG_EQ(m_flowStats.GetNMarkedPackets(flow1, PieQueueDisc::UNFORCED_MARK),
                           0,
                           "There should not be marked packets.");
-    NS_TEST_EXPECT_MSG_EQ(q1->GetStats().GetNDroppedPackets(PieQueueDisc::UNFORCED_DROP),
+    NS_TEST_EXPECT_MSG_EQ(m_flowStats.GetNDroppedPackets(flow1, PieQueueDisc::UNFORCED_DROP),
                           0,
                           "There should not be any dropped packets");
 
@@ -1077,6 +1100,7 @@ FqPieQueueDiscL4sMode::DoRun()
 
     queueDisc->SetQuantum(1514);
     queueDisc->Initialize();
+    m_flowStats.Connect(queueDisc);
     hdr.SetPayloadSize(100);
     hdr.SetSource(Ipv4Address("10.10.1.1"));
     hdr.SetDestination(Ipv4Address("10.10.1.2"));
@@ -1114,11 +1138,9 @@ FqPieQueueDiscL4sMode::DoRun()
     DequeueWithDelay(queueDisc, delay, 140);
     Simulator::Stop(Seconds(1));
     Simulator::Run();
-    q0 = queueDisc->GetQueueDiscClass(0)->GetQueueDisc()->GetObject<PieQueueDisc>();
-    q0 = queueDisc->GetQueueDiscClass(0)->GetQueueDisc()->GetObject<PieQueueDisc>();
 
     NS_TEST_EXPECT_MSG_EQ(
-        q0->GetStats().GetNMarkedPackets(PieQueueDisc::CE_THRESHOLD_EXCEEDED_MARK),
+        m_flowStats.GetNMarkedPackets(flow0, PieQueueDisc::CE_THRESHOLD_EXCEEDED_MARK),
         68,
         "There should be 68 marked packets"
         "2nd ECT1 packet is enqueued at 1.5ms and dequeued at 3ms hence the delay of 1.5ms which "
@@ -1126,11 +1148,11 @@ FqPieQueueDiscL4sMode::DoRun()
         "3rd packet is enqueued at 2.5ms and dequeued at 5ms hence the delay of 2.5ms and "
         "subsequent packet also do have delay"
         "greater than CE threshold so all the packets after 2nd packet are marked");
-    NS_TEST_EXPECT_MSG_EQ(q0->GetStats().GetNDroppedPackets(PieQueueDisc::UNFORCED_DROP),
+    NS_TEST_EXPECT_MSG_EQ(m_flowStats.GetNDroppedPackets(flow0, PieQueueDisc::UNFORCED_DROP),
                           0,
                           "Queue delay is less than max burst allowance so"
                           "There should not be any dropped packets");
-    NS_TEST_EXPECT_MSG_EQ(q0->GetStats().GetNMarkedPackets(PieQueueDisc::UNFORCED_MARK),
+    NS_TEST_EXPECT_MSG_EQ(m_flowStats.GetNMarkedPackets(flow0, PieQueueDisc::UNFORCED_MARK),
                           0,
                           "There should not be any marked packets");
 
@@ -0,0 +1,52 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3tc-flow-stats.h"
+
+#include "ns3/callback.h"
+#include "ns3/ipv4-queue-disc-item.h"
+
+namespace ns3
+{
+
+void
+QueueDiscFlowStats::Connect(Ptr<QueueDisc> queueDisc)
+{
+    m_dropped.clear();
+    m_marked.clear();
+    queueDisc->TraceConnectWithoutContext("DropBeforeEnqueue",
+                                          MakeBoundCallback(&QueueDiscFlowStats::Count, &m_dropped));
+    queueDisc->TraceConnectWithoutContext("DropAfterDequeue",
+                                          MakeBoundCallback(&QueueDiscFlowStats::Count, &m_dropped));
+    queueDisc->TraceConnectWithoutContext("Mark",
+                                          MakeBoundCallback(&QueueDiscFlowStats::Count, &m_marked));
+}
+
+void
+QueueDiscFlowStats::Count(Counts* counts, Ptr<const QueueDiscItem> item, const char* reason)
+{
+    Ptr<const Ipv4QueueDiscItem> ipv4Item = DynamicCast<const Ipv4QueueDiscItem>(item);
+    (*counts)[{ipv4Item->GetHeader().GetDestination(), reason}]++;
+}
+
+uint32_t
+QueueDiscFlowStats::Get(const Counts& counts, Ipv4Address flow, std::string reason)
+{
+    auto it = counts.find({flow, reason});
+    return it == counts.end() ? 0 : it->second;
+}
+
+uint32_t
+QueueDiscFlowStats::GetNDroppedPackets(Ipv4Address flow, std::string reason) const
+{
+    return Get(m_dropped, flow, reason);
+}
+
+uint32_t
+QueueDiscFlowStats::GetNMarkedPackets(Ipv4Address flow, std::string reason) const
+{
+    return Get(m_marked, flow, reason);
+}
+
+} // namespace ns3
@@ -0,0 +1,74 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef NS3TC_FLOW_STATS_H
+#define NS3TC_FLOW_STATS_H
+
+#include "ns3/ipv4-address.h"
+#include "ns3/ptr.h"
+#include "ns3/queue-disc.h"
+
+#include <map>
+#include <string>
+#include <utility>
+
+namespace ns3
+{
+
+/**
+ * @ingroup system-tests-tc
+ *
+ * Count the packets dropped and marked by a queue disc, per flow and per
+ * reason. A flow is identified by the IPv4 destination of its packets.
+ */
+class QueueDiscFlowStats
+{
+  public:
+    /**
+     * Start counting the packets dropped and marked by a queue disc.
+     * @param queueDisc The queue disc.
+     */
+    void Connect(Ptr<QueueDisc> queueDisc);
+    /**
+     * Get the number of packets of a flow dropped for a given reason.
+     * @param flow The IPv4 destination of the packets of the flow.
+     * @param reason The reason.
+     * @return The number of dropped packets.
+     */
+    uint32_t GetNDroppedPackets(Ipv4Address flow, std::string reason) const;
+    /**
+     * Get the number of packets of a flow marked for a given reason.
+     * @param flow The IPv4 destination of the packets of the flow.
+     * @param reason The reason.
+     * @return The number of marked packets.
+     */
+    uint32_t GetNMarkedPackets(Ipv4Address flow, std::string reason) const;
+
+  private:
+    /// Packet counts, per flow and per reason
+    using Counts = std::map<std::pair<Ipv4Address, std::string>, uint32_t>;
+
+    /**
+     * Count a packet.
+     * @param counts The packet counts.
+     * @param item The packet.
+     * @param reason The reason.
+     */
+    static void Count(Counts* counts, Ptr<const QueueDiscItem> item, const char* reason);
+    /**
+     * Get a packet count.
+     * @param counts The packet counts.
+     * @param flow The IPv4 destination of the packets of the flow.
+     * @param reason The reason.
+     * @return The number of packets.
+     */
+    static uint32_t Get(const Counts& counts, Ipv4Address flow, std::string reason);
+
+    Counts m_dropped; //!< Number of dropped packets
+    Counts m_marked;  //!< Number of marked packets
+};
+
+} // namespace ns3
+
+#endif /* NS3TC_FLOW_STATS_H */
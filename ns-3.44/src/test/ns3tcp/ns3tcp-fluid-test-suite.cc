@@ -0,0 +1,250 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/bulk-send-helper.h"
+#include "ns3/double.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4-global-routing-helper.h"
+#include "ns3/log.h"
+#include "ns3/node-container.h"
+#include "ns3/packet-sink-helper.h"
+#include "ns3/packet-sink.h"
+#include "ns3/point-to-point-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/tcp-fluid-model.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("Ns3TcpFluidTest");
+
+/**
+ * @ingroup system-tests-tcp
+ *
+ * @brief Check the max-min fair rates of the fluid flows.
+ *
+ * Two flows from n0 and n3 cross the n1-n2 bottleneck, whose capacity is
+ * 18 Mbps (90% of 20 Mbps), along with a third flow limited to 2 Mbps: the
+ * first two flows get 8 Mbps each. Once the third flow is removed, they get
+ * 9 Mbps each, the first flow being limited by the n0-n1 link.
+ *
+ * @verbatim
+   n0 --10Mbps-- n1 --20Mbps-- n2
+                 |
+   n3 --100Mbps--+
+   @endverbatim
+ */
+class Ns3TcpFluidRatesTestCase : public TestCase
+{
+  public:
+    Ns3TcpFluidRatesTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+Ns3TcpFluidRatesTestCase::Ns3TcpFluidRatesTestCase()
+    : TestCase("Check the max-min fair rates of the fluid flows")
+{
+}
+
+void
+Ns3TcpFluidRatesTestCase::DoRun()
+{
+    NodeContainer nodes;
+    nodes.Create(4);
+
+    PointToPointHelper pointToPoint;
+    pointToPoint.SetDeviceAttribute("DataRate", StringValue("10Mbps"));
+    NetDeviceContainer link01 = pointToPoint.Install(nodes.Get(0), nodes.Get(1));
+    pointToPoint.SetDeviceAttribute("DataRate", StringValue("20Mbps"));
+    NetDeviceContainer link12 = pointToPoint.Install(nodes.Get(1), nodes.Get(2));
+    pointToPoint.SetDeviceAttribute("DataRate", StringValue("100Mbps"));
+    NetDeviceContainer link31 = pointToPoint.Install(nodes.Get(3), nodes.Get(1));
+
+    InternetStackHelper internet;
+    internet.Install(nodes);
+    Ipv4AddressHelper address;
+    address.SetBase("10.1.1.0", "255.255.255.0");
+    address.Assign(link01);
+    address.SetBase("10.1.2.0", "255.255.255.0");
+    Ipv4InterfaceContainer interfaces12 = address.Assign(link12);
+    address.SetBase("10.1.3.0", "255.255.255.0");
+    address.Assign(link31);
+    Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+
+    Ptr<TcpFluidModel> fluid = CreateObject<TcpFluidModel>();
+    Ipv4Address destination = interfaces12.GetAddress(1);
+    uint32_t flow0 = fluid->AddFlow(nodes.Get(0), destination);
+    uint32_t flow3 = fluid->AddFlow(nodes.Get(3), destination);
+    uint32_t limitedFlow = fluid->AddFlow(nodes.Get(3), destination, DataRate("2Mbps"));
+
+    NS_TEST_EXPECT_MSG_EQ(fluid->GetNFlows(), 3, "Wrong number of flows");
+    NS_TEST_EXPECT_MSG_EQ(fluid->GetFlowRate(limitedFlow),
+                          DataRate("2Mbps"),
+                          "The flow should be limited by its maximum rate");
+    NS_TEST_EXPECT_MSG_EQ(fluid->GetFlowRate(flow0),
+                          DataRate("8Mbps"),
+                          "The flow should get its fair share of the bottleneck");
+    NS_TEST_EXPECT_MSG_EQ(fluid->GetFlowRate(flow3),
+                          DataRate("8Mbps"),
+                          "The flow should get its fair share of the bottleneck");
+    NS_TEST_EXPECT_MSG_EQ(fluid->GetLoad(link12.Get(0)),
+                          DataRate("18Mbps"),
+                          "The bottleneck should be fully used");
+    NS_TEST_EXPECT_MSG_EQ(fluid->GetLoad(link12.Get(1)),
+                          DataRate(0),
+                          "The reverse direction should not be loaded");
+
+    fluid->RemoveFlow(limitedFlow);
+    NS_TEST_EXPECT_MSG_EQ(fluid->GetFlowRate(flow0),
+                          DataRate("9Mbps"),
+                          "The flow should be limited by its first link");
+    NS_TEST_EXPECT_MSG_EQ(fluid->GetFlowRate(flow3),
+                          DataRate("9Mbps"),
+                          "The flow should get the capacity left by the other flow");
+
+    fluid->RemoveFlow(flow0);
+    fluid->RemoveFlow(flow3);
+    NS_TEST_EXPECT_MSG_EQ(fluid->GetNFlows(), 0, "Wrong number of flows");
+    NS_TEST_EXPECT_MSG_EQ(fluid->GetLoad(link12.Get(0)),
+                          DataRate(0),
+                          "The bottleneck should not be loaded anymore");
+
+    fluid->Dispose();
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup system-tests-tcp
+ *
+ * @brief Check that the fluid flows slow down the packet-level flows.
+ *
+ * A bulk transfer crosses a 10 Mbps point-to-point link, alone and then
+ * along with a fluid flow taking half of its capacity: the transfer should
+ * take about twice as long.
+ */
+class Ns3TcpFluidLoadTestCase : public TestCase
+{
+  public:
+    Ns3TcpFluidLoadTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Run the transfer.
+     * @param withFluid Whether to add a fluid flow.
+     * @return The time the last byte was received.
+     */
+    Time RunTransfer(bool withFluid);
+
+    /**
+     * Receive a TCP packet.
+     * @param p The received packet.
+     * @param address The sender's address (unused).
+     */
+    void SinkRx(Ptr<const Packet> p, const Address& address);
+
+    uint32_t m_rxBytes; //!< Received bytes
+    Time m_lastRx;      //!< Time of the last reception
+};
+
+Ns3TcpFluidLoadTestCase::Ns3TcpFluidLoadTestCase()
+    : TestCase("Check that the fluid flows slow down the packet-level flows")
+{
+}
+
+void
+Ns3TcpFluidLoadTestCase::SinkRx(Ptr<const Packet> p, const Address&)
+{
+    m_rxBytes += p->GetSize();
+    m_lastRx = Simulator::Now();
+}
+
+Time
+Ns3TcpFluidLoadTestCase::RunTransfer(bool withFluid)
+{
+    const uint32_t maxBytes = 1000000;
+    m_rxBytes = 0;
+
+    NodeContainer nodes;
+    nodes.Create(2);
+    PointToPointHelper pointToPoint;
+    pointToPoint.SetDeviceAttribute("DataRate", StringValue("10Mbps"));
+    pointToPoint.SetChannelAttribute("Delay", StringValue("5ms"));
+    NetDeviceContainer devices = pointToPoint.Install(nodes);
+
+    InternetStackHelper internet;
+    internet.Install(nodes);
+    Ipv4AddressHelper address;
+    address.SetBase("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer interfaces = address.Assign(devices);
+
+    Ptr<TcpFluidModel> fluid = CreateObject<TcpFluidModel>();
+    fluid->SetAttribute("MaxUtilization", DoubleValue(0.5));
+    if (withFluid)
+    {
+        fluid->AddFlow(nodes.Get(0), interfaces.GetAddress(1));
+    }
+
+    uint16_t port = 50000;
+    BulkSendHelper source("ns3::TcpSocketFactory",
+                          InetSocketAddress(interfaces.GetAddress(1), port));
+    source.SetAttribute("MaxBytes", UintegerValue(maxBytes));
+    source.Install(nodes.Get(0)).Start(Seconds(0));
+    PacketSinkHelper sink("ns3::TcpSocketFactory", InetSocketAddress(Ipv4Address::GetAny(), port));
+    ApplicationContainer sinkApps = sink.Install(nodes.Get(1));
+    sinkApps.Start(Seconds(0));
+    sinkApps.Get(0)->TraceConnectWithoutContext(
+        "Rx",
+        MakeCallback(&Ns3TcpFluidLoadTestCase::SinkRx, this));
+
+    Simulator::Stop(Seconds(20));
+    Simulator::Run();
+    fluid->Dispose();
+    Simulator::Destroy();
+
+    NS_TEST_EXPECT_MSG_EQ(m_rxBytes, maxBytes, "All the data should have been received");
+    return m_lastRx;
+}
+
+void
+Ns3TcpFluidLoadTestCase::DoRun()
+{
+    Time duration = RunTransfer(false);
+    Time fluidDuration = RunTransfer(true);
+    NS_LOG_INFO("Alone: " << duration.As(Time::S) << ", with fluid flow: "
+                          << fluidDuration.As(Time::S));
+
+    NS_TEST_EXPECT_MSG_EQ_TOL(fluidDuration.GetSeconds(),
+                              2 * duration.GetSeconds(),
+                              0.2 * duration.GetSeconds(),
+                              "The fluid flow should take half of the capacity");
+}
+
+/**
+ * @ingroup system-tests-tcp
+ *
+ * TestSuite for the fluid model of background TCP flows.
+ */
+class Ns3TcpFluidTestSuite : public TestSuite
+{
+  public:
+    Ns3TcpFluidTestSuite();
+};
+
+Ns3TcpFluidTestSuite::Ns3TcpFluidTestSuite()
+    : TestSuite("ns3-tcp-fluid", Type::SYSTEM)
+{
+    AddTestCase(new Ns3TcpFluidRatesTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new Ns3TcpFluidLoadTestCase, TestCase::Duration::QUICK);
+}
+
+/// Do not forget to allocate an instance of this TestSuite.
+static Ns3TcpFluidTestSuite g_ns3TcpFluidTestSuite;
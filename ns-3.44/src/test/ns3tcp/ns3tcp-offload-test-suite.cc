@@ -0,0 +1,190 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/bulk-send-helper.h"
+#include "ns3/config.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4-global-routing-helper.h"
+#include "ns3/log.h"
+#include "ns3/node-container.h"
+#include "ns3/packet-sink-helper.h"
+#include "ns3/packet-sink.h"
+#include "ns3/point-to-point-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/traffic-control-helper.h"
+#include "ns3/uinteger.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("Ns3TcpOffloadTest");
+
+/**
+ * @ingroup system-tests-tcp
+ *
+ * @brief Tests of the TCP segmentation offload emulation.
+ *
+ * A bulk transfer crosses two point-to-point links without drops, with and
+ * without segmentation offload: the transfer must complete in about the same time,
+ * with much fewer packets sent on the links when offload is enabled.
+ */
+class Ns3TcpOffloadTestCase : public TestCase
+{
+  public:
+    Ns3TcpOffloadTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Run the transfer.
+     * @param offloadSize The maximum size of the super-segments (0 disables offload).
+     * @param[out] txPackets The number of packets sent on the first link.
+     * @return The time the last byte was received.
+     */
+    Time RunTransfer(uint32_t offloadSize, uint32_t& txPackets);
+
+    /**
+     * Receive a TCP packet.
+     * @param p The received packet.
+     * @param address The sender's address (unused).
+     */
+    void SinkRx(Ptr<const Packet> p, const Address& address);
+
+    /**
+     * Count a packet sent by the sender.
+     * @param p The packet.
+     */
+    void PhyTxEnd(Ptr<const Packet> p);
+
+    uint32_t m_rxBytes;   //!< Received bytes
+    Time m_lastRx;        //!< Time of the last reception
+    uint32_t m_txPackets; //!< Packets sent by the sender
+};
+
+Ns3TcpOffloadTestCase::Ns3TcpOffloadTestCase()
+    : TestCase("Check that TCP segmentation offload preserves the transfer time")
+{
+}
+
+void
+Ns3TcpOffloadTestCase::SinkRx(Ptr<const Packet> p, const Address&)
+{
+    m_rxBytes += p->GetSize();
+    m_lastRx = Simulator::Now();
+}
+
+void
+Ns3TcpOffloadTestCase::PhyTxEnd(Ptr<const Packet>)
+{
+    m_txPackets++;
+}
+
+Time
+Ns3TcpOffloadTestCase::RunTransfer(uint32_t offloadSize, uint32_t& txPackets)
+{
+    const uint32_t maxBytes = 2000000;
+    m_rxBytes = 0;
+    m_txPackets = 0;
+    Config::SetDefault("ns3::TcpSocketBase::SegmentationOffload", UintegerValue(offloadSize));
+    Config::SetDefault("ns3::TcpSocket::SndBufSize", UintegerValue(1 << 20));
+    Config::SetDefault("ns3::TcpSocket::RcvBufSize", UintegerValue(1 << 20));
+
+    NodeContainer nodes;
+    nodes.Create(3);
+
+    // byte-limited queues large enough to never drop, since a packet-limited
+    // queue would hold more data with offload enabled
+    PointToPointHelper pointToPoint;
+    pointToPoint.SetQueue("ns3::DropTailQueue<Packet>", "MaxSize", StringValue("4MB"));
+    pointToPoint.SetDeviceAttribute("DataRate", StringValue("100Mbps"));
+    pointToPoint.SetChannelAttribute("Delay", StringValue("1ms"));
+    NetDeviceContainer access = pointToPoint.Install(nodes.Get(0), nodes.Get(1));
+    pointToPoint.SetDeviceAttribute("DataRate", StringValue("20Mbps"));
+    pointToPoint.SetChannelAttribute("Delay", StringValue("10ms"));
+    NetDeviceContainer bottleneck = pointToPoint.Install(nodes.Get(1), nodes.Get(2));
+
+    InternetStackHelper internet;
+    internet.Install(nodes);
+    Ipv4AddressHelper address;
+    address.SetBase("10.1.1.0", "255.255.255.0");
+    address.Assign(access);
+    address.SetBase("10.1.2.0", "255.255.255.0");
+    Ipv4InterfaceContainer interfaces = address.Assign(bottleneck);
+    TrafficControlHelper tch;
+    tch.Uninstall(access);
+    tch.Uninstall(bottleneck);
+    Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+
+    uint16_t port = 50000;
+    BulkSendHelper source("ns3::TcpSocketFactory",
+                          InetSocketAddress(interfaces.GetAddress(1), port));
+    source.SetAttribute("MaxBytes", UintegerValue(maxBytes));
+    source.Install(nodes.Get(0)).Start(Seconds(0));
+    PacketSinkHelper sink("ns3::TcpSocketFactory", InetSocketAddress(Ipv4Address::GetAny(), port));
+    ApplicationContainer sinkApps = sink.Install(nodes.Get(2));
+    sinkApps.Start(Seconds(0));
+
+    sinkApps.Get(0)->TraceConnectWithoutContext(
+        "Rx",
+        MakeCallback(&Ns3TcpOffloadTestCase::SinkRx, this));
+    access.Get(0)->TraceConnectWithoutContext(
+        "PhyTxEnd",
+        MakeCallback(&Ns3TcpOffloadTestCase::PhyTxEnd, this));
+
+    Simulator::Stop(Seconds(20));
+    Simulator::Run();
+    Simulator::Destroy();
+
+    Config::SetDefault("ns3::TcpSocketBase::SegmentationOffload", UintegerValue(0));
+    Config::SetDefault("ns3::TcpSocket::SndBufSize", UintegerValue(131072));
+    Config::SetDefault("ns3::TcpSocket::RcvBufSize", UintegerValue(131072));
+
+    NS_TEST_EXPECT_MSG_EQ(m_rxBytes, maxBytes, "All the data should have been received");
+    txPackets = m_txPackets;
+    return m_lastRx;
+}
+
+void
+Ns3TcpOffloadTestCase::DoRun()
+{
+    uint32_t txPackets;
+    uint32_t offloadTxPackets;
+    Time duration = RunTransfer(0, txPackets);
+    Time offloadDuration = RunTransfer(16384, offloadTxPackets);
+    NS_LOG_INFO("Without offload: " << duration.As(Time::S) << ", " << txPackets << " packets");
+    NS_LOG_INFO("With offload: " << offloadDuration.As(Time::S) << ", " << offloadTxPackets
+                                 << " packets");
+
+    NS_TEST_EXPECT_MSG_LT(offloadTxPackets * 10,
+                          txPackets,
+                          "Offload should send much fewer packets");
+    NS_TEST_EXPECT_MSG_EQ_TOL(offloadDuration.GetSeconds(),
+                              duration.GetSeconds(),
+                              duration.GetSeconds() * 0.05,
+                              "Offload should not change the transfer time");
+}
+
+/**
+ * @ingroup system-tests-tcp
+ *
+ * TestSuite for the TCP segmentation offload emulation.
+ */
+class Ns3TcpOffloadTestSuite : public TestSuite
+{
+  public:
+    Ns3TcpOffloadTestSuite();
+};
+
+Ns3TcpOffloadTestSuite::Ns3TcpOffloadTestSuite()
+    : TestSuite("ns3-tcp-offload", Type::SYSTEM)
+{
+    AddTestCase(new Ns3TcpOffloadTestCase, TestCase::Duration::QUICK);
+}
+
+/// Do not forget to allocate an instance of this TestSuite.
+static Ns3TcpOffloadTestSuite g_ns3TcpOffloadTestSuite;
@@ -32,6 +32,22 @@ NS_LOG_COMPONENT_DEFINE("CobaltQueueDisc");
 
 NS_OBJECT_ENSURE_REGISTERED(CobaltQueueDisc);
 
+/// The OVERLIMIT_DROP reason, registered once
+static const QueueDisc::Reason g_overlimitDrop =
+    QueueDisc::RegisterReason(CobaltQueueDisc::OVERLIMIT_DROP);
+
+/// The TARGET_EXCEEDED_DROP reason, registered once
+static const QueueDisc::Reason g_targetExceededDrop =
+    QueueDisc::RegisterReason(CobaltQueueDisc::TARGET_EXCEEDED_DROP);
+
+/// The CE_THRESHOLD_EXCEEDED_MARK reason, registered once
+static const QueueDisc::Reason g_ceThresholdExceededMark =
+    QueueDisc::RegisterReason(CobaltQueueDisc::CE_THRESHOLD_EXCEEDED_MARK);
+
+/// The FORCED_MARK reason, registered once
+static const QueueDisc::Reason g_forcedMark =
+    QueueDisc::RegisterReason(CobaltQueueDisc::FORCED_MARK);
+
 TypeId
 CobaltQueueDisc::GetTypeId()
 {
@@ -328,7 +344,7 @@ CobaltQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
         int64_t now = CoDelGetTime();
         // Call this to update Blue's drop probability
         CobaltQueueFull(now);
-        DropBeforeEnqueue(item, OVERLIMIT_DROP);
+        DropBeforeEnqueue(item, g_overlimitDrop);
         return false;
     }
 
@@ -374,7 +390,7 @@ CobaltQueueDisc::DoDequeue()
 
         if (drop)
         {
-            DropAfterDequeue(item, TARGET_EXCEEDED_DROP);
+            DropAfterDequeue(item, g_targetExceededDrop);
         }
         else
         {
@@ -457,7 +473,7 @@ CobaltQueueDisc::CobaltShouldDrop(Ptr<QueueDiscItem> item, int64_t now)
                 NS_LOG_DEBUG("CE packet " << static_cast<uint16_t>(tosByte & 0x3));
             }
             if (CoDelTimeAfter(sojournTime, Time2CoDel(m_ceThreshold)) &&
-                Mark(item, CE_THRESHOLD_EXCEEDED_MARK))
+                Mark(item, g_ceThresholdExceededMark))
             {
                 NS_LOG_LOGIC("Marking due to CeThreshold " << m_ceThreshold.GetSeconds());
             }
@@ -487,7 +503,7 @@ CobaltQueueDisc::CobaltShouldDrop(Ptr<QueueDiscItem> item, int64_t now)
         /* Check for marking possibility only if BLUE decides NOT to drop. */
         /* Check if router and packet, both have ECN enabled. Only if this is true, mark the packet.
          */
-        isMarked = (m_useEcn && Mark(item, FORCED_MARK));
+        isMarked = (m_useEcn && Mark(item, g_forcedMark));
         drop = !isMarked;
 
         m_count = std::max(m_count, m_count + 1);
@@ -513,7 +529,7 @@ CobaltQueueDisc::CobaltShouldDrop(Ptr<QueueDiscItem> item, int64_t now)
     // suppressed. If UseL4S attribute is enabled then ECT0 packets should not be marked.
     if (!isMarked && !m_useL4s && m_useEcn &&
         CoDelTimeAfter(sojournTime, Time2CoDel(m_ceThreshold)) &&
-        Mark(item, CE_THRESHOLD_EXCEEDED_MARK))
+        Mark(item, g_ceThresholdExceededMark))
     {
         NS_LOG_LOGIC("Marking due to CeThreshold " << m_ceThreshold.GetSeconds());
     }
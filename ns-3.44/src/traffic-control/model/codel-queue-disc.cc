@@ -59,6 +59,22 @@ CoDelGetTime()
 
 NS_OBJECT_ENSURE_REGISTERED(CoDelQueueDisc);
 
+/// The OVERLIMIT_DROP reason, registered once
+static const QueueDisc::Reason g_overlimitDrop =
+    QueueDisc::RegisterReason(CoDelQueueDisc::OVERLIMIT_DROP);
+
+/// The CE_THRESHOLD_EXCEEDED_MARK reason, registered once
+static const QueueDisc::Reason g_ceThresholdExceededMark =
+    QueueDisc::RegisterReason(CoDelQueueDisc::CE_THRESHOLD_EXCEEDED_MARK);
+
+/// The TARGET_EXCEEDED_MARK reason, registered once
+static const QueueDisc::Reason g_targetExceededMark =
+    QueueDisc::RegisterReason(CoDelQueueDisc::TARGET_EXCEEDED_MARK);
+
+/// The TARGET_EXCEEDED_DROP reason, registered once
+static const QueueDisc::Reason g_targetExceededDrop =
+    QueueDisc::RegisterReason(CoDelQueueDisc::TARGET_EXCEEDED_DROP);
+
 TypeId
 CoDelQueueDisc::GetTypeId()
 {
@@ -168,7 +184,7 @@ CoDelQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
     if (GetCurrentSize() + item > GetMaxSize())
     {
         NS_LOG_LOGIC("Queue full -- dropping pkt");
-        DropBeforeEnqueue(item, OVERLIMIT_DROP);
+        DropBeforeEnqueue(item, g_overlimitDrop);
         return false;
     }
 
@@ -257,7 +273,7 @@ CoDelQueueDisc::DoDequeue()
             }
 
             if (CoDelTimeAfter(ldelay, Time2CoDel(m_ceThreshold)) &&
-                Mark(item, CE_THRESHOLD_EXCEEDED_MARK))
+                Mark(item, g_ceThresholdExceededMark))
             {
                 NS_LOG_LOGIC("Marking due to CeThreshold " << m_ceThreshold.GetSeconds());
             }
@@ -297,7 +313,7 @@ CoDelQueueDisc::DoDequeue()
                 // A large amount of packets in queue might result in drop
                 // rates so high that the next drop should happen now,
                 // hence the while loop.
-                if (m_useEcn && Mark(item, TARGET_EXCEEDED_MARK))
+                if (m_useEcn && Mark(item, g_targetExceededMark))
                 {
                     isMarked = true;
                     NS_LOG_LOGIC("Sojourn time is still above target and it's time for next drop "
@@ -312,7 +328,7 @@ CoDelQueueDisc::DoDequeue()
                 NS_LOG_LOGIC(
                     "Sojourn time is still above target and it's time for next drop; dropping "
                     << item);
-                DropAfterDequeue(item, TARGET_EXCEEDED_DROP);
+                DropAfterDequeue(item, g_targetExceededDrop);
 
                 item = GetInternalQueue(0)->Dequeue();
 
@@ -348,7 +364,7 @@ CoDelQueueDisc::DoDequeue()
                      "first packet");
         if (okToDrop)
         {
-            if (m_useEcn && Mark(item, TARGET_EXCEEDED_MARK))
+            if (m_useEcn && Mark(item, g_targetExceededMark))
             {
                 isMarked = true;
                 NS_LOG_LOGIC("Sojourn time goes above target, marking the first packet "
@@ -359,7 +375,7 @@ CoDelQueueDisc::DoDequeue()
                 // Drop the first packet and enter dropping state unless the queue is empty
                 NS_LOG_LOGIC("Sojourn time goes above target, dropping the first packet "
                              << item << " and entering the dropping state");
-                DropAfterDequeue(item, TARGET_EXCEEDED_DROP);
+                DropAfterDequeue(item, g_targetExceededDrop);
                 item = GetInternalQueue(0)->Dequeue();
                 if (item)
                 {
@@ -400,7 +416,7 @@ end:
     // it would result in two counts of mark in the queue statistics. Therefore, we
     // use the isMarked flag to suppress a second attempt at marking.
     if (!isMarked && item && !m_useL4s && m_useEcn &&
-        CoDelTimeAfter(ldelay, Time2CoDel(m_ceThreshold)) && Mark(item, CE_THRESHOLD_EXCEEDED_MARK))
+        CoDelTimeAfter(ldelay, Time2CoDel(m_ceThreshold)) && Mark(item, g_ceThresholdExceededMark))
     {
         NS_LOG_LOGIC("Marking due to CeThreshold " << m_ceThreshold.GetSeconds());
     }
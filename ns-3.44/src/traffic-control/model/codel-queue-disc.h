@@ -102,6 +102,7 @@ class CoDelQueueDisc : public QueueDisc
   private:
     friend class ::CoDelQueueDiscNewtonStepTest; // Test code
     friend class ::CoDelQueueDiscControlLawTest; // Test code
+    friend class FqCoDelQueueDisc;               // Runs CoDel on its flow queues
     /**
      * @brief Add a packet to the queue
      *
@@ -19,6 +19,10 @@ NS_LOG_COMPONENT_DEFINE("FifoQueueDisc");
 
 NS_OBJECT_ENSURE_REGISTERED(FifoQueueDisc);
 
+/// The LIMIT_EXCEEDED_DROP reason, registered once
+static const QueueDisc::Reason g_limitExceededDrop =
+    QueueDisc::RegisterReason(FifoQueueDisc::LIMIT_EXCEEDED_DROP);
+
 TypeId
 FifoQueueDisc::GetTypeId()
 {
@@ -54,7 +58,7 @@ FifoQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
     if (GetCurrentSize() + item > GetMaxSize())
     {
         NS_LOG_LOGIC("Queue full -- dropping pkt");
-        DropBeforeEnqueue(item, LIMIT_EXCEEDED_DROP);
+        DropBeforeEnqueue(item, g_limitExceededDrop);
         return false;
     }
 
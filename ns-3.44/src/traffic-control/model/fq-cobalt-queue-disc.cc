@@ -29,6 +29,14 @@ NS_LOG_COMPONENT_DEFINE("FqCobaltQueueDisc");
 
 NS_OBJECT_ENSURE_REGISTERED(FqCobaltFlow);
 
+/// The UNCLASSIFIED_DROP reason, registered once
+static const QueueDisc::Reason g_unclassifiedDrop =
+    QueueDisc::RegisterReason(FqCobaltQueueDisc::UNCLASSIFIED_DROP);
+
+/// The OVERLIMIT_DROP reason, registered once
+static const QueueDisc::Reason g_overlimitDrop =
+    QueueDisc::RegisterReason(FqCobaltQueueDisc::OVERLIMIT_DROP);
+
 TypeId
 FqCobaltFlow::GetTypeId()
 {
@@ -267,7 +275,7 @@ FqCobaltQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
         else
         {
             NS_LOG_ERROR("No filter has been able to classify this packet, drop it.");
-            DropBeforeEnqueue(item, UNCLASSIFIED_DROP);
+            DropBeforeEnqueue(item, g_unclassifiedDrop);
             return false;
         }
     }
@@ -515,7 +523,7 @@ FqCobaltQueueDisc::FqCobaltDrop()
         NS_LOG_DEBUG("Drop packet (overflow); count: " << count << " len: " << len
                                                        << " threshold: " << threshold);
         item = qd->GetInternalQueue(0)->Dequeue();
-        DropAfterDequeue(item, OVERLIMIT_DROP);
+        DropAfterDequeue(item, g_overlimitDrop);
         len += item->GetSize();
     } while (++count < m_dropBatchSize && len < threshold);
 
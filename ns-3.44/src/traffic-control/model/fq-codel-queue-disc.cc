@@ -14,88 +14,149 @@
 #include "ns3/log.h"
 #include "ns3/net-device-queue-interface.h"
 #include "ns3/queue.h"
+#include "ns3/simulator.h"
 #include "ns3/string.h"
 
+#include <limits>
+
 namespace ns3
 {
 
 NS_LOG_COMPONENT_DEFINE("FqCoDelQueueDisc");
 
-NS_OBJECT_ENSURE_REGISTERED(FqCoDelFlow);
+/// Position of the flow queue of the indices with no flow queue yet
+static const uint32_t NO_FLOW = std::numeric_limits<uint32_t>::max();
 
-TypeId
-FqCoDelFlow::GetTypeId()
+/**
+ * Returns the given time translated in CoDel time representation
+ * @param t the time
+ * @return the time in units of CoDel time
+ */
+static uint32_t
+Time2CoDel(Time t)
 {
-    static TypeId tid = TypeId("ns3::FqCoDelFlow")
-                            .SetParent<QueueDiscClass>()
-                            .SetGroupName("TrafficControl")
-                            .AddConstructor<FqCoDelFlow>();
-    return tid;
+    return static_cast<uint32_t>(t.GetNanoSeconds() >> CODEL_SHIFT);
 }
 
-FqCoDelFlow::FqCoDelFlow()
-    : m_deficit(0),
-      m_status(INACTIVE),
-      m_index(0)
+/**
+ * Returns the current time translated in CoDel time representation
+ * @return the current time
+ */
+static uint32_t
+CoDelGetTime()
 {
-    NS_LOG_FUNCTION(this);
+    return Time2CoDel(Simulator::Now());
 }
 
-FqCoDelFlow::~FqCoDelFlow()
+/**
+ * Check if CoDel time a is successive to b
+ * @param a left operand
+ * @param b right operand
+ * @return true if a is greater than b
+ */
+static bool
+CoDelTimeAfter(uint32_t a, uint32_t b)
 {
-    NS_LOG_FUNCTION(this);
+    return ((int64_t)(a) - (int64_t)(b) > 0);
 }
 
-void
-FqCoDelFlow::SetDeficit(uint32_t deficit)
+/**
+ * Check if CoDel time a is successive or equal to b
+ * @param a left operand
+ * @param b right operand
+ * @return true if a is greater than or equal to b
+ */
+static bool
+CoDelTimeAfterEq(uint32_t a, uint32_t b)
 {
-    NS_LOG_FUNCTION(this << deficit);
-    m_deficit = deficit;
+    return ((int64_t)(a) - (int64_t)(b) >= 0);
 }
 
-int32_t
-FqCoDelFlow::GetDeficit() const
+/**
+ * Check if CoDel time a is preceding b
+ * @param a left operand
+ * @param b right operand
+ * @return true if a is less than b
+ */
+static bool
+CoDelTimeBefore(uint32_t a, uint32_t b)
 {
-    NS_LOG_FUNCTION(this);
-    return m_deficit;
+    return ((int64_t)(a) - (int64_t)(b) < 0);
 }
 
-void
-FqCoDelFlow::IncreaseDeficit(int32_t deficit)
+FqCoDelFlow::FqCoDelFlow()
+    : m_bytes(0),
+      m_deficit(0),
+      m_status(INACTIVE),
+      m_index(0),
+      m_tag(0),
+      m_count(0),
+      m_lastCount(0),
+      m_dropping(false),
+      m_recInvSqrt(~0U >> REC_INV_SQRT_SHIFT),
+      m_firstAboveTime(0),
+      m_dropNext(0)
 {
-    NS_LOG_FUNCTION(this << deficit);
-    m_deficit += deficit;
 }
 
-void
-FqCoDelFlow::SetStatus(FlowStatus status)
+int32_t
+FqCoDelFlow::GetDeficit() const
 {
-    NS_LOG_FUNCTION(this);
-    m_status = status;
+    return m_deficit;
 }
 
 FqCoDelFlow::FlowStatus
 FqCoDelFlow::GetStatus() const
 {
-    NS_LOG_FUNCTION(this);
     return m_status;
 }
 
-void
-FqCoDelFlow::SetIndex(uint32_t index)
+uint32_t
+FqCoDelFlow::GetIndex() const
 {
-    NS_LOG_FUNCTION(this);
-    m_index = index;
+    return m_index;
 }
 
 uint32_t
-FqCoDelFlow::GetIndex() const
+FqCoDelFlow::GetNPackets() const
 {
-    return m_index;
+    return m_packets.size();
+}
+
+uint32_t
+FqCoDelFlow::GetNBytes() const
+{
+    return m_bytes;
+}
+
+Ptr<const QueueDiscItem>
+FqCoDelFlow::GetHead() const
+{
+    return m_packets.empty() ? nullptr : m_packets.front();
 }
 
 NS_OBJECT_ENSURE_REGISTERED(FqCoDelQueueDisc);
 
+/// The UNCLASSIFIED_DROP reason, registered once
+static const QueueDisc::Reason g_unclassifiedDrop =
+    QueueDisc::RegisterReason(FqCoDelQueueDisc::UNCLASSIFIED_DROP);
+
+/// The CE_THRESHOLD_EXCEEDED_MARK reason, registered once
+static const QueueDisc::Reason g_ceThresholdExceededMark =
+    QueueDisc::RegisterReason(CoDelQueueDisc::CE_THRESHOLD_EXCEEDED_MARK);
+
+/// The TARGET_EXCEEDED_MARK reason, registered once
+static const QueueDisc::Reason g_targetExceededMark =
+    QueueDisc::RegisterReason(CoDelQueueDisc::TARGET_EXCEEDED_MARK);
+
+/// The TARGET_EXCEEDED_DROP reason, registered once
+static const QueueDisc::Reason g_targetExceededDrop =
+    QueueDisc::RegisterReason(CoDelQueueDisc::TARGET_EXCEEDED_DROP);
+
+/// The OVERLIMIT_DROP reason, registered once
+static const QueueDisc::Reason g_overlimitDrop =
+    QueueDisc::RegisterReason(FqCoDelQueueDisc::OVERLIMIT_DROP);
+
 TypeId
 FqCoDelQueueDisc::GetTypeId()
 {
@@ -112,13 +173,18 @@ FqCoDelQueueDisc::GetTypeId()
             .AddAttribute("Interval",
                           "The CoDel algorithm interval for each FQCoDel queue",
                           StringValue("100ms"),
-                          MakeStringAccessor(&FqCoDelQueueDisc::m_interval),
-                          MakeStringChecker())
+                          MakeTimeAccessor(&FqCoDelQueueDisc::m_interval),
+                          MakeTimeChecker())
             .AddAttribute("Target",
                           "The CoDel algorithm target queue delay for each FQCoDel queue",
                           StringValue("5ms"),
-                          MakeStringAccessor(&FqCoDelQueueDisc::m_target),
-                          MakeStringChecker())
+                          MakeTimeAccessor(&FqCoDelQueueDisc::m_target),
+                          MakeTimeChecker())
+            .AddAttribute("MinBytes",
+                          "The CoDel algorithm minbytes parameter for each FQCoDel queue",
+                          UintegerValue(1500),
+                          MakeUintegerAccessor(&FqCoDelQueueDisc::m_minBytes),
+                          MakeUintegerChecker<uint32_t>())
             .AddAttribute("MaxSize",
                           "The maximum number of packets accepted by this queue disc",
                           QueueSizeValue(QueueSize("10240p")),
@@ -188,6 +254,30 @@ FqCoDelQueueDisc::GetQuantum() const
     return m_quantum;
 }
 
+std::size_t
+FqCoDelQueueDisc::GetNFlowQueues() const
+{
+    return m_flowQueues.size();
+}
+
+const FqCoDelFlow&
+FqCoDelQueueDisc::GetFlowQueue(std::size_t i) const
+{
+    NS_ASSERT_MSG(i < m_flowQueues.size(), "Flow queue " << i << " does not exist");
+    return m_flowQueues[i];
+}
+
+void
+FqCoDelQueueDisc::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_flowQueues.clear();
+    m_flowsIndices.clear();
+    m_newFlows.clear();
+    m_oldFlows.clear();
+    QueueDisc::DoDispose();
+}
+
 uint32_t
 FqCoDelQueueDisc::SetAssociativeHash(uint32_t flowHash)
 {
@@ -199,22 +289,18 @@ FqCoDelQueueDisc::SetAssociativeHash(uint32_t flowHash)
 
     for (uint32_t i = outerHash; i < outerHash + m_setWays; i++)
     {
-        auto it = m_flowsIndices.find(i);
+        uint32_t pos = m_flowsIndices[i];
 
-        if (it == m_flowsIndices.end() ||
-            (m_tags.find(i) != m_tags.end() && m_tags[i] == flowHash) ||
-            StaticCast<FqCoDelFlow>(GetQueueDiscClass(it->second))->GetStatus() ==
-                FqCoDelFlow::INACTIVE)
+        if (pos == NO_FLOW || m_flowQueues[pos].m_tag == flowHash ||
+            m_flowQueues[pos].m_status == FqCoDelFlow::INACTIVE)
         {
             // this queue has not been created yet or is associated with this flow
             // or is inactive, hence we can use it
-            m_tags[i] = flowHash;
             return i;
         }
     }
 
     // all the queues of the set are used. Use the first queue of the set
-    m_tags[outerHash] = flowHash;
     return outerHash;
 }
 
@@ -241,7 +327,7 @@ FqCoDelQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
         else
         {
             NS_LOG_ERROR("No filter has been able to classify this packet, drop it.");
-            DropBeforeEnqueue(item, UNCLASSIFIED_DROP);
+            DropBeforeEnqueue(item, g_unclassifiedDrop);
             return false;
         }
     }
@@ -255,42 +341,30 @@ FqCoDelQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
         h = flowHash % m_flows;
     }
 
-    Ptr<FqCoDelFlow> flow;
-    if (m_flowsIndices.find(h) == m_flowsIndices.end())
+    if (m_flowsIndices[h] == NO_FLOW)
     {
         NS_LOG_DEBUG("Creating a new flow queue with index " << h);
-        flow = m_flowFactory.Create<FqCoDelFlow>();
-        Ptr<QueueDisc> qd = m_queueDiscFactory.Create<QueueDisc>();
-        // If CoDel, Set values of CoDelQueueDisc to match this QueueDisc
-        Ptr<CoDelQueueDisc> codel = qd->GetObject<CoDelQueueDisc>();
-        if (codel)
-        {
-            codel->SetAttribute("UseEcn", BooleanValue(m_useEcn));
-            codel->SetAttribute("CeThreshold", TimeValue(m_ceThreshold));
-            codel->SetAttribute("UseL4s", BooleanValue(m_useL4s));
-        }
-        qd->Initialize();
-        flow->SetQueueDisc(qd);
-        flow->SetIndex(h);
-        AddQueueDiscClass(flow);
-
-        m_flowsIndices[h] = GetNQueueDiscClasses() - 1;
-    }
-    else
-    {
-        flow = StaticCast<FqCoDelFlow>(GetQueueDiscClass(m_flowsIndices[h]));
+        m_flowsIndices[h] = m_flowQueues.size();
+        m_flowQueues.emplace_back();
+        m_flowQueues.back().m_index = h;
     }
 
-    if (flow->GetStatus() == FqCoDelFlow::INACTIVE)
+    uint32_t pos = m_flowsIndices[h];
+    FqCoDelFlow& flow = m_flowQueues[pos];
+    flow.m_tag = flowHash;
+
+    if (flow.m_status == FqCoDelFlow::INACTIVE)
     {
-        flow->SetStatus(FqCoDelFlow::NEW_FLOW);
-        flow->SetDeficit(m_quantum);
-        m_newFlows.push_back(flow);
+        flow.m_status = FqCoDelFlow::NEW_FLOW;
+        flow.m_deficit = m_quantum;
+        m_newFlows.push_back(pos);
     }
 
-    flow->GetQueueDisc()->Enqueue(item);
+    flow.m_packets.push_back(item);
+    flow.m_bytes += item->GetSize();
+    PacketEnqueued(item);
 
-    NS_LOG_DEBUG("Packet enqueued into flow " << h << "; flow index " << m_flowsIndices[h]);
+    NS_LOG_DEBUG("Packet enqueued into flow " << h << "; flow index " << pos);
 
     if (GetCurrentSize() > GetMaxSize())
     {
@@ -306,7 +380,7 @@ FqCoDelQueueDisc::DoDequeue()
 {
     NS_LOG_FUNCTION(this);
 
-    Ptr<FqCoDelFlow> flow;
+    uint32_t pos = 0;
     Ptr<QueueDiscItem> item;
 
     do
@@ -315,35 +389,39 @@ FqCoDelQueueDisc::DoDequeue()
 
         while (!found && !m_newFlows.empty())
         {
-            flow = m_newFlows.front();
+            pos = m_newFlows.front();
+            FqCoDelFlow& flow = m_flowQueues[pos];
 
-            if (flow->GetDeficit() <= 0)
+            if (flow.m_deficit <= 0)
             {
-                NS_LOG_DEBUG("Increase deficit for new flow index " << flow->GetIndex());
-                flow->IncreaseDeficit(m_quantum);
-                flow->SetStatus(FqCoDelFlow::OLD_FLOW);
-                m_oldFlows.splice(m_oldFlows.end(), m_newFlows, m_newFlows.begin());
+                NS_LOG_DEBUG("Increase deficit for new flow index " << flow.m_index);
+                flow.m_deficit += m_quantum;
+                flow.m_status = FqCoDelFlow::OLD_FLOW;
+                m_oldFlows.push_back(pos);
+                m_newFlows.pop_front();
             }
             else
             {
-                NS_LOG_DEBUG("Found a new flow " << flow->GetIndex() << " with positive deficit");
+                NS_LOG_DEBUG("Found a new flow " << flow.m_index << " with positive deficit");
                 found = true;
             }
         }
 
         while (!found && !m_oldFlows.empty())
         {
-            flow = m_oldFlows.front();
+            pos = m_oldFlows.front();
+            FqCoDelFlow& flow = m_flowQueues[pos];
 
-            if (flow->GetDeficit() <= 0)
+            if (flow.m_deficit <= 0)
             {
-                NS_LOG_DEBUG("Increase deficit for old flow index " << flow->GetIndex());
-                flow->IncreaseDeficit(m_quantum);
-                m_oldFlows.splice(m_oldFlows.end(), m_oldFlows, m_oldFlows.begin());
+                NS_LOG_DEBUG("Increase deficit for old flow index " << flow.m_index);
+                flow.m_deficit += m_quantum;
+                m_oldFlows.pop_front();
+                m_oldFlows.push_back(pos);
             }
             else
             {
-                NS_LOG_DEBUG("Found an old flow " << flow->GetIndex() << " with positive deficit");
+                NS_LOG_DEBUG("Found an old flow " << flow.m_index << " with positive deficit");
                 found = true;
             }
         }
@@ -354,20 +432,21 @@ FqCoDelQueueDisc::DoDequeue()
             return nullptr;
         }
 
-        item = flow->GetQueueDisc()->Dequeue();
+        FqCoDelFlow& flow = m_flowQueues[pos];
+        item = CoDelDequeue(flow);
 
         if (!item)
         {
             NS_LOG_DEBUG("Could not get a packet from the selected flow queue");
             if (!m_newFlows.empty())
             {
-                flow->SetStatus(FqCoDelFlow::OLD_FLOW);
-                m_oldFlows.push_back(flow);
+                flow.m_status = FqCoDelFlow::OLD_FLOW;
+                m_oldFlows.push_back(pos);
                 m_newFlows.pop_front();
             }
             else
             {
-                flow->SetStatus(FqCoDelFlow::INACTIVE);
+                flow.m_status = FqCoDelFlow::INACTIVE;
                 m_oldFlows.pop_front();
             }
         }
@@ -377,8 +456,233 @@ FqCoDelQueueDisc::DoDequeue()
         }
     } while (!item);
 
-    flow->IncreaseDeficit(item->GetSize() * -1);
+    m_flowQueues[pos].m_deficit -= item->GetSize();
+
+    return item;
+}
+
+Ptr<QueueDiscItem>
+FqCoDelQueueDisc::DequeueFromFlow(FqCoDelFlow& flow)
+{
+    NS_LOG_FUNCTION(this << flow.m_index);
+
+    if (flow.m_packets.empty())
+    {
+        return nullptr;
+    }
+
+    Ptr<QueueDiscItem> item = flow.m_packets.front();
+    flow.m_packets.pop_front();
+    flow.m_bytes -= item->GetSize();
+    PacketDequeued(item);
+
+    NS_LOG_LOGIC("Popped " << item);
+    NS_LOG_LOGIC("Number packets remaining " << flow.m_packets.size());
+    NS_LOG_LOGIC("Number bytes remaining " << flow.m_bytes);
+    return item;
+}
+
+bool
+FqCoDelQueueDisc::OkToDrop(FqCoDelFlow& flow, Ptr<QueueDiscItem> item, uint32_t now)
+{
+    NS_LOG_FUNCTION(this << flow.m_index);
+
+    if (!item)
+    {
+        flow.m_firstAboveTime = 0;
+        return false;
+    }
+
+    Time delta = Simulator::Now() - item->GetTimeStamp();
+    NS_LOG_INFO("Sojourn time " << delta.As(Time::MS));
+    uint32_t sojournTime = Time2CoDel(delta);
+
+    if (CoDelTimeBefore(sojournTime, Time2CoDel(m_target)) || flow.m_bytes < m_minBytes)
+    {
+        // went below so we'll stay below for at least q->interval
+        NS_LOG_LOGIC("Sojourn time is below target or number of bytes in queue is less than "
+                     "minBytes; packet should not be dropped");
+        flow.m_firstAboveTime = 0;
+        return false;
+    }
+    bool okToDrop = false;
+    if (flow.m_firstAboveTime == 0)
+    {
+        /* just went above from below. If we stay above
+         * for at least q->interval we'll say it's ok to drop
+         */
+        NS_LOG_LOGIC("Sojourn time has just gone above target from below, need to stay above for "
+                     "at least q->interval before packet can be dropped. ");
+        flow.m_firstAboveTime = now + Time2CoDel(m_interval);
+    }
+    else if (CoDelTimeAfter(now, flow.m_firstAboveTime))
+    {
+        NS_LOG_LOGIC("Sojourn time has been above target for at least q->interval; it's OK to "
+                     "(possibly) drop packet.");
+        okToDrop = true;
+    }
+    return okToDrop;
+}
+
+Ptr<QueueDiscItem>
+FqCoDelQueueDisc::CoDelDequeue(FqCoDelFlow& flow)
+{
+    NS_LOG_FUNCTION(this << flow.m_index);
+
+    Ptr<QueueDiscItem> item = DequeueFromFlow(flow);
+    if (!item)
+    {
+        // Leave dropping state when queue is empty
+        flow.m_dropping = false;
+        NS_LOG_LOGIC("Queue empty");
+        return nullptr;
+    }
+    uint32_t ldelay = Time2CoDel(Simulator::Now() - item->GetTimeStamp());
+    if (m_useL4s)
+    {
+        uint8_t tosByte = 0;
+        if (item->GetUint8Value(QueueItem::IP_DSFIELD, tosByte) &&
+            (((tosByte & 0x3) == 1) || (tosByte & 0x3) == 3))
+        {
+            if ((tosByte & 0x3) == 1)
+            {
+                NS_LOG_DEBUG("ECT1 packet " << static_cast<uint16_t>(tosByte & 0x3));
+            }
+            else
+            {
+                NS_LOG_DEBUG("CE packet " << static_cast<uint16_t>(tosByte & 0x3));
+            }
+
+            if (CoDelTimeAfter(ldelay, Time2CoDel(m_ceThreshold)) &&
+                Mark(item, g_ceThresholdExceededMark))
+            {
+                NS_LOG_LOGIC("Marking due to CeThreshold " << m_ceThreshold.GetSeconds());
+            }
+            return item;
+        }
+    }
 
+    uint32_t now = CoDelGetTime();
+
+    // Determine if item should be dropped
+    bool okToDrop = OkToDrop(flow, item, now);
+    bool isMarked = false;
+
+    if (flow.m_dropping)
+    { // In the dropping state (sojourn time has gone above target and hasn't come down yet)
+        // Check if we can leave the dropping state or next drop should occur
+        NS_LOG_LOGIC("In dropping state, check if it's OK to leave or next drop should occur");
+        if (!okToDrop)
+        {
+            /* sojourn time fell below target - leave dropping state */
+            NS_LOG_LOGIC("Sojourn time goes below target, it's OK to leave dropping state.");
+            flow.m_dropping = false;
+        }
+        else if (CoDelTimeAfterEq(now, flow.m_dropNext))
+        {
+            while (flow.m_dropping && CoDelTimeAfterEq(now, flow.m_dropNext))
+            {
+                ++flow.m_count;
+                flow.m_recInvSqrt = CoDelQueueDisc::NewtonStep(flow.m_recInvSqrt, flow.m_count);
+                // It's time for the next drop. Drop the current packet and
+                // dequeue the next. The dequeue might take us out of dropping
+                // state. If not, schedule the next drop.
+                // A large amount of packets in queue might result in drop
+                // rates so high that the next drop should happen now,
+                // hence the while loop.
+                if (m_useEcn && Mark(item, g_targetExceededMark))
+                {
+                    isMarked = true;
+                    NS_LOG_LOGIC("Sojourn time is still above target and it's time for next drop "
+                                 "or mark; marking "
+                                 << item);
+                    flow.m_dropNext = CoDelQueueDisc::ControlLaw(now,
+                                                                 Time2CoDel(m_interval),
+                                                                 flow.m_recInvSqrt);
+                    NS_LOG_LOGIC("Scheduled next drop at " << (double)flow.m_dropNext / 1000000);
+                    break;
+                }
+                NS_LOG_LOGIC(
+                    "Sojourn time is still above target and it's time for next drop; dropping "
+                    << item);
+                DropAfterDequeue(item, g_targetExceededDrop);
+
+                item = DequeueFromFlow(flow);
+
+                if (!OkToDrop(flow, item, now))
+                {
+                    /* leave dropping state */
+                    NS_LOG_LOGIC("Leaving dropping state");
+                    flow.m_dropping = false;
+                }
+                else
+                {
+                    /* schedule the next drop */
+                    flow.m_dropNext = CoDelQueueDisc::ControlLaw(flow.m_dropNext,
+                                                                 Time2CoDel(m_interval),
+                                                                 flow.m_recInvSqrt);
+                    NS_LOG_LOGIC("Scheduled next drop at " << (double)flow.m_dropNext / 1000000);
+                }
+            }
+        }
+    }
+    else
+    {
+        // Not in the dropping state
+        // Decide if we have to enter the dropping state and drop the first packet
+        NS_LOG_LOGIC("Not in dropping state; decide if we have to enter the state and drop the "
+                     "first packet");
+        if (okToDrop)
+        {
+            if (m_useEcn && Mark(item, g_targetExceededMark))
+            {
+                isMarked = true;
+                NS_LOG_LOGIC("Sojourn time goes above target, marking the first packet "
+                             << item << " and entering the dropping state");
+            }
+            else
+            {
+                // Drop the first packet and enter dropping state unless the queue is empty
+                NS_LOG_LOGIC("Sojourn time goes above target, dropping the first packet "
+                             << item << " and entering the dropping state");
+                DropAfterDequeue(item, g_targetExceededDrop);
+                item = DequeueFromFlow(flow);
+                OkToDrop(flow, item, now);
+            }
+            flow.m_dropping = true;
+            /*
+             * if min went above target close to when we last went below it
+             * assume that the drop rate that controlled the queue on the
+             * last cycle is a good starting point to control it now.
+             */
+            int delta = flow.m_count - flow.m_lastCount;
+            if (delta > 1 && CoDelTimeBefore(now - flow.m_dropNext, 16 * Time2CoDel(m_interval)))
+            {
+                flow.m_count = delta;
+                flow.m_recInvSqrt = CoDelQueueDisc::NewtonStep(flow.m_recInvSqrt, flow.m_count);
+            }
+            else
+            {
+                flow.m_count = 1;
+                flow.m_recInvSqrt = ~0U >> REC_INV_SQRT_SHIFT;
+            }
+            flow.m_lastCount = flow.m_count;
+            flow.m_dropNext =
+                CoDelQueueDisc::ControlLaw(now, Time2CoDel(m_interval), flow.m_recInvSqrt);
+            NS_LOG_LOGIC("Scheduled next drop at " << (double)flow.m_dropNext / 1000000 << " now "
+                                                   << (double)now / 1000000);
+        }
+    }
+    // In Linux, this branch of code is executed even if the packet has been marked
+    // according to the target delay above. As in CoDelQueueDisc, we use the isMarked
+    // flag to suppress a second attempt at marking.
+    if (!isMarked && item && !m_useL4s && m_useEcn &&
+        CoDelTimeAfter(Time2CoDel(Simulator::Now() - item->GetTimeStamp()),
+                       Time2CoDel(m_ceThreshold)) &&
+        Mark(item, g_ceThresholdExceededMark))
+    {
+        NS_LOG_LOGIC("Marking due to CeThreshold " << m_ceThreshold.GetSeconds());
+    }
     return item;
 }
 
@@ -442,12 +746,7 @@ FqCoDelQueueDisc::InitializeParams()
 {
     NS_LOG_FUNCTION(this);
 
-    m_flowFactory.SetTypeId("ns3::FqCoDelFlow");
-
-    m_queueDiscFactory.SetTypeId("ns3::CoDelQueueDisc");
-    m_queueDiscFactory.Set("MaxSize", QueueSizeValue(GetMaxSize()));
-    m_queueDiscFactory.Set("Interval", StringValue(m_interval));
-    m_queueDiscFactory.Set("Target", StringValue(m_target));
+    m_flowsIndices.assign(m_flows, NO_FLOW);
 }
 
 uint32_t
@@ -457,13 +756,11 @@ FqCoDelQueueDisc::FqCoDelDrop()
 
     uint32_t maxBacklog = 0;
     uint32_t index = 0;
-    Ptr<QueueDisc> qd;
 
     /* Queue is full! Find the fat flow and drop packet(s) from it */
-    for (uint32_t i = 0; i < GetNQueueDiscClasses(); i++)
+    for (uint32_t i = 0; i < m_flowQueues.size(); i++)
     {
-        qd = GetQueueDiscClass(i)->GetQueueDisc();
-        uint32_t bytes = qd->GetNBytes();
+        uint32_t bytes = m_flowQueues[i].m_bytes;
         if (bytes > maxBacklog)
         {
             maxBacklog = bytes;
@@ -475,15 +772,15 @@ FqCoDelQueueDisc::FqCoDelDrop()
     uint32_t len = 0;
     uint32_t count = 0;
     uint32_t threshold = maxBacklog >> 1;
-    qd = GetQueueDiscClass(index)->GetQueueDisc();
+    FqCoDelFlow& flow = m_flowQueues[index];
     Ptr<QueueDiscItem> item;
 
     do
     {
         NS_LOG_DEBUG("Drop packet (overflow); count: " << count << " len: " << len
                                                        << " threshold: " << threshold);
-        item = qd->GetInternalQueue(0)->Dequeue();
-        DropAfterDequeue(item, OVERLIMIT_DROP);
+        item = DequeueFromFlow(flow);
+        DropAfterDequeue(item, g_overlimitDrop);
         len += item->GetSize();
     } while (++count < m_dropBatchSize && len < threshold);
 
@@ -12,10 +12,9 @@
 
 #include "queue-disc.h"
 
-#include "ns3/object-factory.h"
+#include "ns3/ring-buffer.h"
 
-#include <list>
-#include <map>
+#include <vector>
 
 namespace ns3
 {
@@ -24,23 +23,21 @@ namespace ns3
  * @ingroup traffic-control
  *
  * @brief A flow queue used by the FqCoDel queue disc
+ *
+ * A flow queue is not an object: the FqCoDel queue disc stores its flow
+ * queues in an array, in which they are created when they receive their
+ * first packet. A flow queue holds its packets and the state of the CoDel
+ * algorithm that the FqCoDel queue disc runs on it (as the codel_vars of
+ * the flows of the Linux fq_codel), in place of a child CoDelQueueDisc.
  */
-
-class FqCoDelFlow : public QueueDiscClass
+class FqCoDelFlow
 {
   public:
-    /**
-     * @brief Get the type ID.
-     * @return the object TypeId
-     */
-    static TypeId GetTypeId();
     /**
      * @brief FqCoDelFlow constructor
      */
     FqCoDelFlow();
 
-    ~FqCoDelFlow() override;
-
     /**
      * @enum FlowStatus
      * @brief Used to determine the status of this flow queue
@@ -52,46 +49,52 @@ class FqCoDelFlow : public QueueDiscClass
         OLD_FLOW
     };
 
-    /**
-     * @brief Set the deficit for this flow
-     * @param deficit the deficit for this flow
-     */
-    void SetDeficit(uint32_t deficit);
     /**
      * @brief Get the deficit for this flow
      * @return the deficit for this flow
      */
     int32_t GetDeficit() const;
-    /**
-     * @brief Increase the deficit for this flow
-     * @param deficit the amount by which the deficit is to be increased
-     */
-    void IncreaseDeficit(int32_t deficit);
-    /**
-     * @brief Set the status for this flow
-     * @param status the status for this flow
-     */
-    void SetStatus(FlowStatus status);
     /**
      * @brief Get the status of this flow
      * @return the status of this flow
      */
     FlowStatus GetStatus() const;
-    /**
-     * @brief Set the index for this flow
-     * @param index the index for this flow
-     */
-    void SetIndex(uint32_t index);
     /**
      * @brief Get the index of this flow
      * @return the index of this flow
      */
     uint32_t GetIndex() const;
+    /**
+     * @brief Get the number of packets in this flow queue
+     * @return the number of packets in this flow queue
+     */
+    uint32_t GetNPackets() const;
+    /**
+     * @brief Get the amount of bytes in this flow queue
+     * @return the amount of bytes in this flow queue
+     */
+    uint32_t GetNBytes() const;
+    /**
+     * @brief Get the packet at the head of this flow queue
+     * @return the packet at the head of this flow queue, or null if it is empty
+     */
+    Ptr<const QueueDiscItem> GetHead() const;
 
   private:
-    int32_t m_deficit;   //!< the deficit for this flow
-    FlowStatus m_status; //!< the status of this flow
-    uint32_t m_index;    //!< the index for this flow
+    friend class FqCoDelQueueDisc;
+
+    RingBuffer<Ptr<QueueDiscItem>> m_packets; //!< the packets of this flow
+    uint32_t m_bytes;                         //!< the amount of bytes of the packets
+    int32_t m_deficit;                        //!< the deficit for this flow
+    FlowStatus m_status;                      //!< the status of this flow
+    uint32_t m_index;                         //!< the index for this flow
+    uint32_t m_tag;                           //!< the flow hash (used by set associative hash)
+    uint32_t m_count;          //!< Number of packets dropped since entering drop state
+    uint32_t m_lastCount;      //!< Last number of packets dropped since entering drop state
+    bool m_dropping;           //!< True if in dropping state
+    uint16_t m_recInvSqrt;     //!< Reciprocal inverse square root
+    uint32_t m_firstAboveTime; //!< Time to declare sojourn time above target
+    uint32_t m_dropNext;       //!< Time to drop next packet
 };
 
 /**
@@ -131,17 +134,61 @@ class FqCoDelQueueDisc : public QueueDisc
      */
     uint32_t GetQuantum() const;
 
+    /**
+     * @brief Get the number of flow queues created so far.
+     *
+     * @returns The number of flow queues
+     */
+    std::size_t GetNFlowQueues() const;
+
+    /**
+     * @brief Get a flow queue.
+     *
+     * @param i The index of the flow queue, in the order in which the flow
+     *          queues were created (i.e., received their first packet)
+     * @returns The flow queue
+     */
+    const FqCoDelFlow& GetFlowQueue(std::size_t i) const;
+
     // Reasons for dropping packets
     static constexpr const char* UNCLASSIFIED_DROP =
         "Unclassified drop"; //!< No packet filter able to classify packet
     static constexpr const char* OVERLIMIT_DROP = "Overlimit drop"; //!< Overlimit dropped packets
 
+  protected:
+    void DoDispose() override;
+
   private:
     bool DoEnqueue(Ptr<QueueDiscItem> item) override;
     Ptr<QueueDiscItem> DoDequeue() override;
     bool CheckConfig() override;
     void InitializeParams() override;
 
+    /**
+     * @brief Remove the packet at the head of a flow queue
+     * @param flow the flow queue
+     * @return the packet, or null if the flow queue is empty
+     */
+    Ptr<QueueDiscItem> DequeueFromFlow(FqCoDelFlow& flow);
+
+    /**
+     * @brief Dequeue a packet from a flow queue, running the CoDel algorithm
+     *        on the flow queue (see CoDelQueueDisc::DoDequeue)
+     * @param flow the flow queue
+     * @return the packet, or null if the flow queue is or becomes empty
+     */
+    Ptr<QueueDiscItem> CoDelDequeue(FqCoDelFlow& flow);
+
+    /**
+     * @brief Determine whether a packet dequeued from a flow queue is OK to
+     *        be dropped (see CoDelQueueDisc::OkToDrop)
+     * @param flow the flow queue
+     * @param item the packet that is considered
+     * @param now the current time in units of CoDel time
+     * @returns True if it is OK to drop the packet
+     */
+    bool OkToDrop(FqCoDelFlow& flow, Ptr<QueueDiscItem> item, uint32_t now);
+
     /**
      * @brief Drop a packet from the head of the queue with the largest current byte count
      * @return the index of the queue with the largest current byte count
@@ -158,8 +205,9 @@ class FqCoDelQueueDisc : public QueueDisc
      */
     uint32_t SetAssociativeHash(uint32_t flowHash);
 
-    std::string m_interval;          //!< CoDel interval attribute
-    std::string m_target;            //!< CoDel target attribute
+    Time m_interval;                 //!< CoDel interval attribute
+    Time m_target;                   //!< CoDel target attribute
+    uint32_t m_minBytes;             //!< CoDel minbytes attribute
     uint32_t m_quantum;              //!< Deficit assigned to flows at each round
     uint32_t m_flows;                //!< Number of flow queues
     uint32_t m_setWays;              //!< size of a set of queues (used by set associative hash)
@@ -169,14 +217,10 @@ class FqCoDelQueueDisc : public QueueDisc
     bool m_enableSetAssociativeHash; //!< whether to enable set associative hash
     bool m_useL4s; //!< True if L4S is used (ECT1 packets are marked at CE threshold)
 
-    std::list<Ptr<FqCoDelFlow>> m_newFlows; //!< The list of new flows
-    std::list<Ptr<FqCoDelFlow>> m_oldFlows; //!< The list of old flows
-
-    std::map<uint32_t, uint32_t> m_flowsIndices; //!< Map with the index of class for each flow
-    std::map<uint32_t, uint32_t> m_tags;         //!< Tags used by set associative hash
-
-    ObjectFactory m_flowFactory;      //!< Factory to create a new flow
-    ObjectFactory m_queueDiscFactory; //!< Factory to create a new queue
+    std::vector<FqCoDelFlow> m_flowQueues; //!< The flow queues, in order of creation
+    std::vector<uint32_t> m_flowsIndices;  //!< The position of the flow queue for each index
+    RingBuffer<uint32_t> m_newFlows;       //!< The positions of the new flows
+    RingBuffer<uint32_t> m_oldFlows;       //!< The positions of the old flows
 };
 
 } // namespace ns3
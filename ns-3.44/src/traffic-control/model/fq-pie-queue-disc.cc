@@ -19,88 +19,101 @@
 #include "ns3/log.h"
 #include "ns3/net-device-queue-interface.h"
 #include "ns3/queue.h"
+#include "ns3/simulator.h"
 #include "ns3/string.h"
 
+#include <algorithm>
+#include <limits>
+
 namespace ns3
 {
 
 NS_LOG_COMPONENT_DEFINE("FqPieQueueDisc");
 
-NS_OBJECT_ENSURE_REGISTERED(FqPieFlow);
+/// Position of the flow queue of the indices with no flow queue yet
+static const uint32_t NO_FLOW = std::numeric_limits<uint32_t>::max();
 
-TypeId
-FqPieFlow::GetTypeId()
-{
-    static TypeId tid = TypeId("ns3::FqPieFlow")
-                            .SetParent<QueueDiscClass>()
-                            .SetGroupName("TrafficControl")
-                            .AddConstructor<FqPieFlow>();
-    return tid;
-}
+/// Invalid dqCount value
+static const uint64_t DQCOUNT_INVALID = std::numeric_limits<uint64_t>::max();
 
 FqPieFlow::FqPieFlow()
-    : m_deficit(0),
+    : m_bytes(0),
+      m_deficit(0),
       m_status(INACTIVE),
-      m_index(0)
-{
-    NS_LOG_FUNCTION(this);
-}
-
-FqPieFlow::~FqPieFlow()
-{
-    NS_LOG_FUNCTION(this);
-}
-
-void
-FqPieFlow::SetDeficit(uint32_t deficit)
+      m_index(0),
+      m_tag(0),
+      m_dropProb(0),
+      m_qDelayOld(Seconds(0)),
+      m_qDelay(Seconds(0)),
+      m_burstAllowance(Seconds(0)),
+      m_burstReset(0),
+      m_burstState(PieQueueDisc::NO_BURST),
+      m_inMeasurement(false),
+      m_avgDqRate(0.0),
+      m_dqStart(Seconds(0)),
+      m_dqCount(DQCOUNT_INVALID),
+      m_accuProb(0.0)
 {
-    NS_LOG_FUNCTION(this << deficit);
-    m_deficit = deficit;
 }
 
 int32_t
 FqPieFlow::GetDeficit() const
 {
-    NS_LOG_FUNCTION(this);
     return m_deficit;
 }
 
-void
-FqPieFlow::IncreaseDeficit(int32_t deficit)
+FqPieFlow::FlowStatus
+FqPieFlow::GetStatus() const
 {
-    NS_LOG_FUNCTION(this << deficit);
-    m_deficit += deficit;
+    return m_status;
 }
 
-void
-FqPieFlow::SetStatus(FlowStatus status)
+uint32_t
+FqPieFlow::GetIndex() const
 {
-    NS_LOG_FUNCTION(this);
-    m_status = status;
+    return m_index;
 }
 
-FqPieFlow::FlowStatus
-FqPieFlow::GetStatus() const
+uint32_t
+FqPieFlow::GetNPackets() const
 {
-    NS_LOG_FUNCTION(this);
-    return m_status;
+    return m_packets.size();
 }
 
-void
-FqPieFlow::SetIndex(uint32_t index)
+uint32_t
+FqPieFlow::GetNBytes() const
 {
-    NS_LOG_FUNCTION(this);
-    m_index = index;
+    return m_bytes;
 }
 
-uint32_t
-FqPieFlow::GetIndex() const
+Time
+FqPieFlow::GetQueueDelay() const
 {
-    return m_index;
+    return m_qDelay;
 }
 
 NS_OBJECT_ENSURE_REGISTERED(FqPieQueueDisc);
 
+/// The UNCLASSIFIED_DROP reason, registered once
+static const QueueDisc::Reason g_unclassifiedDrop =
+    QueueDisc::RegisterReason(FqPieQueueDisc::UNCLASSIFIED_DROP);
+
+/// The UNFORCED_MARK reason, registered once
+static const QueueDisc::Reason g_unforcedMark =
+    QueueDisc::RegisterReason(PieQueueDisc::UNFORCED_MARK);
+
+/// The UNFORCED_DROP reason, registered once
+static const QueueDisc::Reason g_unforcedDrop =
+    QueueDisc::RegisterReason(PieQueueDisc::UNFORCED_DROP);
+
+/// The CE_THRESHOLD_EXCEEDED_MARK reason, registered once
+static const QueueDisc::Reason g_ceThresholdExceededMark =
+    QueueDisc::RegisterReason(PieQueueDisc::CE_THRESHOLD_EXCEEDED_MARK);
+
+/// The OVERLIMIT_DROP reason, registered once
+static const QueueDisc::Reason g_overlimitDrop =
+    QueueDisc::RegisterReason(FqPieQueueDisc::OVERLIMIT_DROP);
+
 TypeId
 FqPieQueueDisc::GetTypeId()
 {
@@ -223,6 +236,7 @@ FqPieQueueDisc::FqPieQueueDisc()
       m_quantum(0)
 {
     NS_LOG_FUNCTION(this);
+    m_uv = CreateObject<UniformRandomVariable>();
 }
 
 FqPieQueueDisc::~FqPieQueueDisc()
@@ -243,6 +257,40 @@ FqPieQueueDisc::GetQuantum() const
     return m_quantum;
 }
 
+std::size_t
+FqPieQueueDisc::GetNFlowQueues() const
+{
+    return m_flowQueues.size();
+}
+
+const FqPieFlow&
+FqPieQueueDisc::GetFlowQueue(std::size_t i) const
+{
+    NS_ASSERT_MSG(i < m_flowQueues.size(), "Flow queue " << i << " does not exist");
+    return m_flowQueues[i];
+}
+
+int64_t
+FqPieQueueDisc::AssignStreams(int64_t stream)
+{
+    NS_LOG_FUNCTION(this << stream);
+    m_uv->SetStream(stream);
+    return 1;
+}
+
+void
+FqPieQueueDisc::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_uv = nullptr;
+    m_rtrsEvent.Cancel();
+    m_flowQueues.clear();
+    m_flowsIndices.clear();
+    m_newFlows.clear();
+    m_oldFlows.clear();
+    QueueDisc::DoDispose();
+}
+
 uint32_t
 FqPieQueueDisc::SetAssociativeHash(uint32_t flowHash)
 {
@@ -254,22 +302,18 @@ FqPieQueueDisc::SetAssociativeHash(uint32_t flowHash)
 
     for (uint32_t i = outerHash; i < outerHash + m_setWays; i++)
     {
-        auto it = m_flowsIndices.find(i);
+        uint32_t pos = m_flowsIndices[i];
 
-        if (it == m_flowsIndices.end() ||
-            (m_tags.find(i) != m_tags.end() && m_tags[i] == flowHash) ||
-            StaticCast<FqPieFlow>(GetQueueDiscClass(it->second))->GetStatus() ==
-                FqPieFlow::INACTIVE)
+        if (pos == NO_FLOW || m_flowQueues[pos].m_tag == flowHash ||
+            m_flowQueues[pos].m_status == FqPieFlow::INACTIVE)
         {
             // this queue has not been created yet or is associated with this flow
             // or is inactive, hence we can use it
-            m_tags[i] = flowHash;
             return i;
         }
     }
 
     // all the queues of the set are used. Use the first queue of the set
-    m_tags[outerHash] = flowHash;
     return outerHash;
 }
 
@@ -296,7 +340,7 @@ FqPieQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
         else
         {
             NS_LOG_ERROR("No filter has been able to classify this packet, drop it.");
-            DropBeforeEnqueue(item, UNCLASSIFIED_DROP);
+            DropBeforeEnqueue(item, g_unclassifiedDrop);
             return false;
         }
     }
@@ -310,42 +354,66 @@ FqPieQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
         h = flowHash % m_flows;
     }
 
-    Ptr<FqPieFlow> flow;
-    if (m_flowsIndices.find(h) == m_flowsIndices.end())
+    if (m_flowsIndices[h] == NO_FLOW)
     {
         NS_LOG_DEBUG("Creating a new flow queue with index " << h);
-        flow = m_flowFactory.Create<FqPieFlow>();
-        Ptr<QueueDisc> qd = m_queueDiscFactory.Create<QueueDisc>();
-        // If Pie, Set values of PieQueueDisc to match this QueueDisc
-        Ptr<PieQueueDisc> pie = qd->GetObject<PieQueueDisc>();
-        if (pie)
-        {
-            pie->SetAttribute("UseEcn", BooleanValue(m_useEcn));
-            pie->SetAttribute("CeThreshold", TimeValue(m_ceThreshold));
-            pie->SetAttribute("UseL4s", BooleanValue(m_useL4s));
-        }
-        qd->Initialize();
-        flow->SetQueueDisc(qd);
-        flow->SetIndex(h);
-        AddQueueDiscClass(flow);
+        m_flowsIndices[h] = m_flowQueues.size();
+        m_flowQueues.emplace_back();
+        m_flowQueues.back().m_index = h;
+    }
 
-        m_flowsIndices[h] = GetNQueueDiscClasses() - 1;
+    uint32_t pos = m_flowsIndices[h];
+    FqPieFlow& flow = m_flowQueues[pos];
+    flow.m_tag = flowHash;
+
+    if (flow.m_status == FqPieFlow::INACTIVE)
+    {
+        flow.m_status = FqPieFlow::NEW_FLOW;
+        flow.m_deficit = m_quantum;
+        m_newFlows.push_back(pos);
     }
-    else
+
+    // If L4S is enabled, then check if the packet is ECT1, and if it is then set isEct true
+    bool isEct1 = false;
+    if (m_useL4s)
     {
-        flow = StaticCast<FqPieFlow>(GetQueueDiscClass(m_flowsIndices[h]));
+        uint8_t tosByte = 0;
+        if (item->GetUint8Value(QueueItem::IP_DSFIELD, tosByte) &&
+            (((tosByte & 0x3) == 1) || (tosByte & 0x3) == 3))
+        {
+            if ((tosByte & 0x3) == 1)
+            {
+                NS_LOG_DEBUG("Enqueueing ECT1 packet " << static_cast<uint16_t>(tosByte & 0x3));
+            }
+            else
+            {
+                NS_LOG_DEBUG("Enqueueing CE packet " << static_cast<uint16_t>(tosByte & 0x3));
+            }
+            isEct1 = true;
+        }
     }
 
-    if (flow->GetStatus() == FqPieFlow::INACTIVE)
+    // isEct1 will be true only if L4S enabled as well as the packet is ECT1.
+    // If L4S is enabled and packet is ECT1 then directly enqueue the packet.
+    uint32_t qSize =
+        GetMaxSize().GetUnit() == QueueSizeUnit::BYTES ? flow.m_bytes : flow.m_packets.size();
+    if (!isEct1 && DropEarly(flow, item, qSize))
     {
-        flow->SetStatus(FqPieFlow::NEW_FLOW);
-        flow->SetDeficit(m_quantum);
-        m_newFlows.push_back(flow);
+        if (!m_useEcn || flow.m_dropProb >= m_markEcnTh ||
+            !Mark(item, g_unforcedMark))
+        {
+            // Early probability drop: proactive
+            DropBeforeEnqueue(item, g_unforcedDrop);
+            flow.m_accuProb = 0;
+            return false;
+        }
     }
 
-    flow->GetQueueDisc()->Enqueue(item);
+    flow.m_packets.push_back(item);
+    flow.m_bytes += item->GetSize();
+    PacketEnqueued(item);
 
-    NS_LOG_DEBUG("Packet enqueued into flow " << h << "; flow index " << m_flowsIndices[h]);
+    NS_LOG_DEBUG("Packet enqueued into flow " << h << "; flow index " << pos);
 
     if (GetCurrentSize() > GetMaxSize())
     {
@@ -361,7 +429,7 @@ FqPieQueueDisc::DoDequeue()
 {
     NS_LOG_FUNCTION(this);
 
-    Ptr<FqPieFlow> flow;
+    uint32_t pos = 0;
     Ptr<QueueDiscItem> item;
 
     do
@@ -370,37 +438,39 @@ FqPieQueueDisc::DoDequeue()
 
         while (!found && !m_newFlows.empty())
         {
-            flow = m_newFlows.front();
+            pos = m_newFlows.front();
+            FqPieFlow& flow = m_flowQueues[pos];
 
-            if (flow->GetDeficit() <= 0)
+            if (flow.m_deficit <= 0)
             {
-                NS_LOG_DEBUG("Increase deficit for new flow index " << flow->GetIndex());
-                flow->IncreaseDeficit(m_quantum);
-                flow->SetStatus(FqPieFlow::OLD_FLOW);
-                m_oldFlows.push_back(flow);
+                NS_LOG_DEBUG("Increase deficit for new flow index " << flow.m_index);
+                flow.m_deficit += m_quantum;
+                flow.m_status = FqPieFlow::OLD_FLOW;
+                m_oldFlows.push_back(pos);
                 m_newFlows.pop_front();
             }
             else
             {
-                NS_LOG_DEBUG("Found a new flow " << flow->GetIndex() << " with positive deficit");
+                NS_LOG_DEBUG("Found a new flow " << flow.m_index << " with positive deficit");
                 found = true;
             }
         }
 
         while (!found && !m_oldFlows.empty())
         {
-            flow = m_oldFlows.front();
+            pos = m_oldFlows.front();
+            FqPieFlow& flow = m_flowQueues[pos];
 
-            if (flow->GetDeficit() <= 0)
+            if (flow.m_deficit <= 0)
             {
-                NS_LOG_DEBUG("Increase deficit for old flow index " << flow->GetIndex());
-                flow->IncreaseDeficit(m_quantum);
-                m_oldFlows.push_back(flow);
+                NS_LOG_DEBUG("Increase deficit for old flow index " << flow.m_index);
+                flow.m_deficit += m_quantum;
                 m_oldFlows.pop_front();
+                m_oldFlows.push_back(pos);
             }
             else
             {
-                NS_LOG_DEBUG("Found an old flow " << flow->GetIndex() << " with positive deficit");
+                NS_LOG_DEBUG("Found an old flow " << flow.m_index << " with positive deficit");
                 found = true;
             }
         }
@@ -411,20 +481,21 @@ FqPieQueueDisc::DoDequeue()
             return nullptr;
         }
 
-        item = flow->GetQueueDisc()->Dequeue();
+        FqPieFlow& flow = m_flowQueues[pos];
+        item = PieDequeue(flow);
 
         if (!item)
         {
             NS_LOG_DEBUG("Could not get a packet from the selected flow queue");
             if (!m_newFlows.empty())
             {
-                flow->SetStatus(FqPieFlow::OLD_FLOW);
-                m_oldFlows.push_back(flow);
+                flow.m_status = FqPieFlow::OLD_FLOW;
+                m_oldFlows.push_back(pos);
                 m_newFlows.pop_front();
             }
             else
             {
-                flow->SetStatus(FqPieFlow::INACTIVE);
+                flow.m_status = FqPieFlow::INACTIVE;
                 m_oldFlows.pop_front();
             }
         }
@@ -434,8 +505,301 @@ FqPieQueueDisc::DoDequeue()
         }
     } while (!item);
 
-    flow->IncreaseDeficit(item->GetSize() * -1);
+    m_flowQueues[pos].m_deficit -= item->GetSize();
+
+    return item;
+}
+
+bool
+FqPieQueueDisc::DropEarly(FqPieFlow& flow, Ptr<QueueDiscItem> item, uint32_t qSize)
+{
+    NS_LOG_FUNCTION(this << flow.m_index << item << qSize);
+    if (flow.m_burstAllowance.GetSeconds() > 0)
+    {
+        // If there is still burst_allowance left, skip random early drop.
+        return false;
+    }
+
+    if (flow.m_burstState == PieQueueDisc::NO_BURST)
+    {
+        flow.m_burstState = PieQueueDisc::IN_BURST_PROTECTING;
+        flow.m_burstAllowance = m_maxBurst;
+    }
+
+    double p = flow.m_dropProb;
+
+    uint32_t packetSize = item->GetSize();
+
+    if (GetMaxSize().GetUnit() == QueueSizeUnit::BYTES)
+    {
+        p = p * packetSize / m_meanPktSize;
+    }
+
+    // Safeguard PIE to be work conserving (Section 4.1 of RFC 8033)
+    if ((flow.m_qDelayOld.GetSeconds() < (0.5 * m_qDelayRef.GetSeconds()) &&
+         flow.m_dropProb < 0.2) ||
+        (GetMaxSize().GetUnit() == QueueSizeUnit::BYTES && qSize <= 2 * m_meanPktSize) ||
+        (GetMaxSize().GetUnit() == QueueSizeUnit::PACKETS && qSize <= 2))
+    {
+        return false;
+    }
+
+    if (m_useDerandomization)
+    {
+        if (flow.m_dropProb == 0)
+        {
+            flow.m_accuProb = 0;
+        }
+        flow.m_accuProb += flow.m_dropProb;
+        if (flow.m_accuProb < 0.85)
+        {
+            return false;
+        }
+        else if (flow.m_accuProb >= 8.5)
+        {
+            return true;
+        }
+    }
+
+    double u = m_uv->GetValue();
+    return u <= p;
+}
+
+void
+FqPieQueueDisc::CalculateP()
+{
+    NS_LOG_FUNCTION(this);
+
+    for (auto& flow : m_flowQueues)
+    {
+        CalculateFlowP(flow);
+    }
+    m_rtrsEvent = Simulator::Schedule(m_tUpdate, &FqPieQueueDisc::CalculateP, this);
+}
+
+void
+FqPieQueueDisc::CalculateFlowP(FqPieFlow& flow)
+{
+    Time qDelay;
+    double p = 0.0;
+    bool missingInitFlag = false;
 
+    if (m_useDqRateEstimator)
+    {
+        if (flow.m_avgDqRate > 0)
+        {
+            qDelay = Seconds(flow.m_bytes / flow.m_avgDqRate);
+        }
+        else
+        {
+            qDelay = Seconds(0);
+            missingInitFlag = true;
+        }
+        flow.m_qDelay = qDelay;
+    }
+    else
+    {
+        qDelay = flow.m_qDelay;
+    }
+    NS_LOG_DEBUG("Queue delay of flow " << flow.m_index << " while calculating probability: "
+                                        << qDelay.GetMilliSeconds() << "ms");
+
+    if (flow.m_burstAllowance.GetSeconds() > 0)
+    {
+        flow.m_dropProb = 0;
+    }
+    else
+    {
+        p = m_a * (qDelay.GetSeconds() - m_qDelayRef.GetSeconds()) +
+            m_b * (qDelay.GetSeconds() - flow.m_qDelayOld.GetSeconds());
+        if (flow.m_dropProb < 0.000001)
+        {
+            p /= 2048;
+        }
+        else if (flow.m_dropProb < 0.00001)
+        {
+            p /= 512;
+        }
+        else if (flow.m_dropProb < 0.0001)
+        {
+            p /= 128;
+        }
+        else if (flow.m_dropProb < 0.001)
+        {
+            p /= 32;
+        }
+        else if (flow.m_dropProb < 0.01)
+        {
+            p /= 8;
+        }
+        else if (flow.m_dropProb < 0.1)
+        {
+            p /= 2;
+        }
+
+        // Cap Drop Adjustment (Section 5.5 of RFC 8033)
+        if (m_isCapDropAdjustment && (flow.m_dropProb >= 0.1) && (p > 0.02))
+        {
+            p = 0.02;
+        }
+    }
+
+    p += flow.m_dropProb;
+
+    // For non-linear drop in prob
+    // Decay the drop probability exponentially (Section 4.2 of RFC 8033)
+    if (qDelay.GetSeconds() == 0 && flow.m_qDelayOld.GetSeconds() == 0)
+    {
+        p *= 0.98;
+    }
+
+    // bound the drop probability (Section 4.2 of RFC 8033)
+    flow.m_dropProb = std::min(std::max(p, 0.0), 1.0);
+
+    // Section 4.4 #2
+    if (flow.m_burstAllowance < m_tUpdate)
+    {
+        flow.m_burstAllowance = Seconds(0);
+    }
+    else
+    {
+        flow.m_burstAllowance -= m_tUpdate;
+    }
+
+    auto burstResetLimit = static_cast<uint32_t>(BURST_RESET_TIMEOUT / m_tUpdate.GetSeconds());
+    if ((qDelay.GetSeconds() < 0.5 * m_qDelayRef.GetSeconds()) &&
+        (flow.m_qDelayOld.GetSeconds() < (0.5 * m_qDelayRef.GetSeconds())) &&
+        (flow.m_dropProb == 0) && !missingInitFlag)
+    {
+        flow.m_dqCount = DQCOUNT_INVALID;
+        flow.m_avgDqRate = 0.0;
+    }
+    if ((qDelay.GetSeconds() < 0.5 * m_qDelayRef.GetSeconds()) &&
+        (flow.m_qDelayOld.GetSeconds() < (0.5 * m_qDelayRef.GetSeconds())) &&
+        (flow.m_dropProb == 0) && (flow.m_burstAllowance.GetSeconds() == 0))
+    {
+        if (flow.m_burstState == PieQueueDisc::IN_BURST_PROTECTING)
+        {
+            flow.m_burstState = PieQueueDisc::IN_BURST;
+            flow.m_burstReset = 0;
+        }
+        else if (flow.m_burstState == PieQueueDisc::IN_BURST)
+        {
+            flow.m_burstReset++;
+            if (flow.m_burstReset > burstResetLimit)
+            {
+                flow.m_burstReset = 0;
+                flow.m_burstState = PieQueueDisc::NO_BURST;
+            }
+        }
+    }
+    else if (flow.m_burstState == PieQueueDisc::IN_BURST)
+    {
+        flow.m_burstReset = 0;
+    }
+
+    flow.m_qDelayOld = qDelay;
+}
+
+Ptr<QueueDiscItem>
+FqPieQueueDisc::PieDequeue(FqPieFlow& flow)
+{
+    NS_LOG_FUNCTION(this << flow.m_index);
+
+    if (flow.m_packets.empty())
+    {
+        NS_LOG_LOGIC("Queue empty");
+        return nullptr;
+    }
+
+    Ptr<QueueDiscItem> item = flow.m_packets.front();
+    flow.m_packets.pop_front();
+    flow.m_bytes -= item->GetSize();
+    PacketDequeued(item);
+
+    // If L4S is enabled and packet is ECT1, then check if delay is greater
+    // than CE threshold and if it is then mark the packet,
+    // skip PIE steps, and return the item.
+    if (m_useL4s)
+    {
+        uint8_t tosByte = 0;
+        if (item->GetUint8Value(QueueItem::IP_DSFIELD, tosByte) &&
+            (((tosByte & 0x3) == 1) || (tosByte & 0x3) == 3))
+        {
+            if ((tosByte & 0x3) == 1)
+            {
+                NS_LOG_DEBUG("ECT1 packet " << static_cast<uint16_t>(tosByte & 0x3));
+            }
+            else
+            {
+                NS_LOG_DEBUG("CE packet " << static_cast<uint16_t>(tosByte & 0x3));
+            }
+            if ((Now() - item->GetTimeStamp() > m_ceThreshold) &&
+                Mark(item, g_ceThresholdExceededMark))
+            {
+                NS_LOG_LOGIC("Marking due to CeThreshold " << m_ceThreshold.GetSeconds());
+            }
+            return item;
+        }
+    }
+
+    // if not in a measurement cycle and the queue has built up to dq_threshold,
+    // start the measurement cycle
+    if (m_useDqRateEstimator)
+    {
+        if ((flow.m_bytes >= m_dqThreshold) && (!flow.m_inMeasurement))
+        {
+            flow.m_dqStart = Now();
+            flow.m_dqCount = 0;
+            flow.m_inMeasurement = true;
+        }
+
+        if (flow.m_inMeasurement)
+        {
+            flow.m_dqCount += item->GetSize();
+
+            // done with a measurement cycle
+            if (flow.m_dqCount >= m_dqThreshold)
+            {
+                Time dqTime = Now() - flow.m_dqStart;
+                if (dqTime.IsStrictlyPositive())
+                {
+                    if (flow.m_avgDqRate == 0)
+                    {
+                        flow.m_avgDqRate = flow.m_dqCount / dqTime.GetSeconds();
+                    }
+                    else
+                    {
+                        flow.m_avgDqRate = (0.5 * flow.m_avgDqRate) +
+                                           (0.5 * (flow.m_dqCount / dqTime.GetSeconds()));
+                    }
+                }
+                NS_LOG_DEBUG("Average Dequeue Rate after Dequeue: " << flow.m_avgDqRate);
+
+                // restart a measurement cycle if there is enough data
+                if (flow.m_bytes > m_dqThreshold)
+                {
+                    flow.m_dqStart = Now();
+                    flow.m_dqCount = 0;
+                    flow.m_inMeasurement = true;
+                }
+                else
+                {
+                    flow.m_dqCount = 0;
+                    flow.m_inMeasurement = false;
+                }
+            }
+        }
+    }
+    else
+    {
+        flow.m_qDelay = Now() - item->GetTimeStamp();
+
+        if (flow.m_bytes == 0)
+        {
+            flow.m_qDelay = Seconds(0);
+        }
+    }
     return item;
 }
 
@@ -499,21 +863,8 @@ FqPieQueueDisc::InitializeParams()
 {
     NS_LOG_FUNCTION(this);
 
-    m_flowFactory.SetTypeId("ns3::FqPieFlow");
-
-    m_queueDiscFactory.SetTypeId("ns3::PieQueueDisc");
-    m_queueDiscFactory.Set("MaxSize", QueueSizeValue(GetMaxSize()));
-    m_queueDiscFactory.Set("MeanPktSize", UintegerValue(m_meanPktSize));
-    m_queueDiscFactory.Set("A", DoubleValue(m_a));
-    m_queueDiscFactory.Set("B", DoubleValue(m_b));
-    m_queueDiscFactory.Set("Tupdate", TimeValue(m_tUpdate));
-    m_queueDiscFactory.Set("Supdate", TimeValue(m_sUpdate));
-    m_queueDiscFactory.Set("DequeueThreshold", UintegerValue(m_dqThreshold));
-    m_queueDiscFactory.Set("QueueDelayReference", TimeValue(m_qDelayRef));
-    m_queueDiscFactory.Set("MaxBurstAllowance", TimeValue(m_maxBurst));
-    m_queueDiscFactory.Set("UseDequeueRateEstimator", BooleanValue(m_useDqRateEstimator));
-    m_queueDiscFactory.Set("UseCapDropAdjustment", BooleanValue(m_isCapDropAdjustment));
-    m_queueDiscFactory.Set("UseDerandomization", BooleanValue(m_useDerandomization));
+    m_flowsIndices.assign(m_flows, NO_FLOW);
+    m_rtrsEvent = Simulator::Schedule(m_sUpdate, &FqPieQueueDisc::CalculateP, this);
 }
 
 uint32_t
@@ -523,13 +874,11 @@ FqPieQueueDisc::FqPieDrop()
 
     uint32_t maxBacklog = 0;
     uint32_t index = 0;
-    Ptr<QueueDisc> qd;
 
     /* Queue is full! Find the fat flow and drop packet(s) from it */
-    for (uint32_t i = 0; i < GetNQueueDiscClasses(); i++)
+    for (uint32_t i = 0; i < m_flowQueues.size(); i++)
     {
-        qd = GetQueueDiscClass(i)->GetQueueDisc();
-        uint32_t bytes = qd->GetNBytes();
+        uint32_t bytes = m_flowQueues[i].m_bytes;
         if (bytes > maxBacklog)
         {
             maxBacklog = bytes;
@@ -541,15 +890,18 @@ FqPieQueueDisc::FqPieDrop()
     uint32_t len = 0;
     uint32_t count = 0;
     uint32_t threshold = maxBacklog >> 1;
-    qd = GetQueueDiscClass(index)->GetQueueDisc();
+    FqPieFlow& flow = m_flowQueues[index];
     Ptr<QueueDiscItem> item;
 
     do
     {
         NS_LOG_DEBUG("Drop packet (overflow); count: " << count << " len: " << len
                                                        << " threshold: " << threshold);
-        item = qd->GetInternalQueue(0)->Dequeue();
-        DropAfterDequeue(item, OVERLIMIT_DROP);
+        item = flow.m_packets.front();
+        flow.m_packets.pop_front();
+        flow.m_bytes -= item->GetSize();
+        PacketDequeued(item);
+        DropAfterDequeue(item, g_overlimitDrop);
         len += item->GetSize();
     } while (++count < m_dropBatchSize && len < threshold);
 
@@ -15,12 +15,13 @@
 #ifndef FQ_PIE_QUEUE_DISC
 #define FQ_PIE_QUEUE_DISC
 
+#include "pie-queue-disc.h"
 #include "queue-disc.h"
 
-#include "ns3/object-factory.h"
+#include "ns3/event-id.h"
+#include "ns3/ring-buffer.h"
 
-#include <list>
-#include <map>
+#include <vector>
 
 namespace ns3
 {
@@ -29,23 +30,20 @@ namespace ns3
  * @ingroup traffic-control
  *
  * @brief A flow queue used by the FqPie queue disc
+ *
+ * A flow queue is not an object: the FqPie queue disc stores its flow queues
+ * in an array, in which they are created when they receive their first
+ * packet. A flow queue holds its packets and the state of the PIE algorithm
+ * that the FqPie queue disc runs on it, in place of a child PieQueueDisc.
  */
-
-class FqPieFlow : public QueueDiscClass
+class FqPieFlow
 {
   public:
-    /**
-     * @brief Get the type ID.
-     * @return the object TypeId
-     */
-    static TypeId GetTypeId();
     /**
      * @brief FqPieFlow constructor
      */
     FqPieFlow();
 
-    ~FqPieFlow() override;
-
     /**
      * @enum FlowStatus
      * @brief Used to determine the status of this flow queue
@@ -57,46 +55,58 @@ class FqPieFlow : public QueueDiscClass
         OLD_FLOW
     };
 
-    /**
-     * @brief Set the deficit for this flow
-     * @param deficit the deficit for this flow
-     */
-    void SetDeficit(uint32_t deficit);
     /**
      * @brief Get the deficit for this flow
      * @return the deficit for this flow
      */
     int32_t GetDeficit() const;
-    /**
-     * @brief Increase the deficit for this flow
-     * @param deficit the amount by which the deficit is to be increased
-     */
-    void IncreaseDeficit(int32_t deficit);
-    /**
-     * @brief Set the status for this flow
-     * @param status the status for this flow
-     */
-    void SetStatus(FlowStatus status);
     /**
      * @brief Get the status of this flow
      * @return the status of this flow
      */
     FlowStatus GetStatus() const;
-    /**
-     * @brief Set the index for this flow
-     * @param index the index for this flow
-     */
-    void SetIndex(uint32_t index);
     /**
      * @brief Get the index of this flow
      * @return the index of this flow
      */
     uint32_t GetIndex() const;
+    /**
+     * @brief Get the number of packets in this flow queue
+     * @return the number of packets in this flow queue
+     */
+    uint32_t GetNPackets() const;
+    /**
+     * @brief Get the amount of bytes in this flow queue
+     * @return the amount of bytes in this flow queue
+     */
+    uint32_t GetNBytes() const;
+    /**
+     * @brief Get the queue delay of this flow queue, as estimated by PIE
+     * @return the queue delay of this flow queue
+     */
+    Time GetQueueDelay() const;
 
   private:
-    int32_t m_deficit;   //!< the deficit for this flow
-    FlowStatus m_status; //!< the status of this flow
-    uint32_t m_index;    //!< the index for this flow
+    friend class FqPieQueueDisc;
+
+    RingBuffer<Ptr<QueueDiscItem>> m_packets; //!< the packets of this flow
+    uint32_t m_bytes;                         //!< the amount of bytes of the packets
+    int32_t m_deficit;                        //!< the deficit for this flow
+    FlowStatus m_status;                      //!< the status of this flow
+    uint32_t m_index;                         //!< the index for this flow
+    uint32_t m_tag;                           //!< the flow hash (used by set associative hash)
+    double m_dropProb;                        //!< Variable used in calculation of drop probability
+    Time m_qDelayOld;                         //!< Old value of queue delay
+    Time m_qDelay;                            //!< Current value of queue delay
+    Time m_burstAllowance;    //!< Current max burst value in seconds that is allowed before random
+                              //!< drops kick in
+    uint32_t m_burstReset;    //!< Used to reset value of burst allowance
+    PieQueueDisc::BurstStateT m_burstState; //!< Used to determine the current state of burst
+    bool m_inMeasurement;                   //!< Indicates whether we are in a measurement cycle
+    double m_avgDqRate;                     //!< Time averaged dequeue rate
+    Time m_dqStart;                         //!< Start timestamp of current measurement cycle
+    uint64_t m_dqCount; //!< Number of bytes departed since current measurement cycle starts
+    double m_accuProb;  //!< Accumulated drop probability
 };
 
 /**
@@ -136,17 +146,77 @@ class FqPieQueueDisc : public QueueDisc
      */
     uint32_t GetQuantum() const;
 
+    /**
+     * @brief Get the number of flow queues created so far.
+     *
+     * @returns The number of flow queues
+     */
+    std::size_t GetNFlowQueues() const;
+
+    /**
+     * @brief Get a flow queue.
+     *
+     * @param i The index of the flow queue, in the order in which the flow
+     *          queues were created (i.e., received their first packet)
+     * @returns The flow queue
+     */
+    const FqPieFlow& GetFlowQueue(std::size_t i) const;
+
+    /**
+     * Assign a fixed random variable stream number to the random variables
+     * used by this model.  Return the number of streams (possibly zero) that
+     * have been assigned.
+     *
+     * @param stream first stream index to use
+     * @return the number of stream indices assigned by this model
+     */
+    int64_t AssignStreams(int64_t stream);
+
     // Reasons for dropping packets
     static constexpr const char* UNCLASSIFIED_DROP =
         "Unclassified drop"; //!< No packet filter able to classify packet
     static constexpr const char* OVERLIMIT_DROP = "Overlimit drop"; //!< Overlimit dropped packets
 
+  protected:
+    void DoDispose() override;
+
   private:
     bool DoEnqueue(Ptr<QueueDiscItem> item) override;
     Ptr<QueueDiscItem> DoDequeue() override;
     bool CheckConfig() override;
     void InitializeParams() override;
 
+    /**
+     * @brief Dequeue a packet from a flow queue, running the PIE algorithm on
+     *        the flow queue (see PieQueueDisc::DoDequeue)
+     * @param flow the flow queue
+     * @return the packet, or null if the flow queue is empty
+     */
+    Ptr<QueueDiscItem> PieDequeue(FqPieFlow& flow);
+
+    /**
+     * @brief Check if a packet needs to be dropped due to probability drop
+     *        (see PieQueueDisc::DropEarly)
+     * @param flow the flow queue of the packet
+     * @param item queue item
+     * @param qSize size of the flow queue
+     * @returns 0 for no drop, 1 for drop
+     */
+    bool DropEarly(FqPieFlow& flow, Ptr<QueueDiscItem> item, uint32_t qSize);
+
+    /**
+     * Periodically update the drop probability of all the flow queues (see
+     * PieQueueDisc::CalculateP). As in Linux, a single timer serves all the
+     * flow queues.
+     */
+    void CalculateP();
+
+    /**
+     * @brief Update the drop probability of a flow queue
+     * @param flow the flow queue
+     */
+    void CalculateFlowP(FqPieFlow& flow);
+
     /**
      * @brief Drop a packet from the head of the queue with the largest current byte count
      * @return the index of the queue with the largest current byte count
@@ -189,14 +259,14 @@ class FqPieQueueDisc : public QueueDisc
     uint32_t m_perturbation;         //!< hash perturbation value
     bool m_enableSetAssociativeHash; //!< whether to enable set associative hash
 
-    std::list<Ptr<FqPieFlow>> m_newFlows; //!< The list of new flows
-    std::list<Ptr<FqPieFlow>> m_oldFlows; //!< The list of old flows
-
-    std::map<uint32_t, uint32_t> m_flowsIndices; //!< Map with the index of class for each flow
-    std::map<uint32_t, uint32_t> m_tags;         //!< Tags used by set associative hash
+    std::vector<FqPieFlow> m_flowQueues;  //!< The flow queues, in order of creation
+    std::vector<uint32_t> m_flowsIndices; //!< The position of the flow queue for each index
+    RingBuffer<uint32_t> m_newFlows;      //!< The positions of the new flows
+    RingBuffer<uint32_t> m_oldFlows;      //!< The positions of the old flows
 
-    ObjectFactory m_flowFactory;      //!< Factory to create a new flow
-    ObjectFactory m_queueDiscFactory; //!< Factory to create a new queue
+    Ptr<UniformRandomVariable> m_uv; //!< Rng stream
+    EventId m_rtrsEvent;             //!< Event used to decide the decision of interval of drop
+                                     //!< probability calculation
 };
 
 } // namespace ns3
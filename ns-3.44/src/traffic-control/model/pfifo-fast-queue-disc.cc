@@ -22,6 +22,10 @@ NS_LOG_COMPONENT_DEFINE("PfifoFastQueueDisc");
 
 NS_OBJECT_ENSURE_REGISTERED(PfifoFastQueueDisc);
 
+/// The LIMIT_EXCEEDED_DROP reason, registered once
+static const QueueDisc::Reason g_limitExceededDrop =
+    QueueDisc::RegisterReason(PfifoFastQueueDisc::LIMIT_EXCEEDED_DROP);
+
 TypeId
 PfifoFastQueueDisc::GetTypeId()
 {
@@ -59,7 +63,7 @@ PfifoFastQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
     if (GetCurrentSize() >= GetMaxSize())
     {
         NS_LOG_LOGIC("Queue disc limit exceeded -- dropping packet");
-        DropBeforeEnqueue(item, LIMIT_EXCEEDED_DROP);
+        DropBeforeEnqueue(item, g_limitExceededDrop);
         return false;
     }
 
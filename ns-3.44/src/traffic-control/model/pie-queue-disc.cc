@@ -30,6 +30,22 @@ NS_LOG_COMPONENT_DEFINE("PieQueueDisc");
 
 NS_OBJECT_ENSURE_REGISTERED(PieQueueDisc);
 
+/// The FORCED_DROP reason, registered once
+static const QueueDisc::Reason g_forcedDrop =
+    QueueDisc::RegisterReason(PieQueueDisc::FORCED_DROP);
+
+/// The UNFORCED_MARK reason, registered once
+static const QueueDisc::Reason g_unforcedMark =
+    QueueDisc::RegisterReason(PieQueueDisc::UNFORCED_MARK);
+
+/// The UNFORCED_DROP reason, registered once
+static const QueueDisc::Reason g_unforcedDrop =
+    QueueDisc::RegisterReason(PieQueueDisc::UNFORCED_DROP);
+
+/// The CE_THRESHOLD_EXCEEDED_MARK reason, registered once
+static const QueueDisc::Reason g_ceThresholdExceededMark =
+    QueueDisc::RegisterReason(PieQueueDisc::CE_THRESHOLD_EXCEEDED_MARK);
+
 TypeId
 PieQueueDisc::GetTypeId()
 {
@@ -192,7 +208,7 @@ PieQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
     if (nQueued + item > GetMaxSize())
     {
         // Drops due to queue limit: reactive
-        DropBeforeEnqueue(item, FORCED_DROP);
+        DropBeforeEnqueue(item, g_forcedDrop);
         m_accuProb = 0;
         return false;
     }
@@ -201,10 +217,10 @@ PieQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
     else if ((m_activeThreshold == Time::Max() || m_active) && !isEct1 &&
              DropEarly(item, nQueued.GetValue()))
     {
-        if (!m_useEcn || m_dropProb >= m_markEcnTh || !Mark(item, UNFORCED_MARK))
+        if (!m_useEcn || m_dropProb >= m_markEcnTh || !Mark(item, g_unforcedMark))
         {
             // Early probability drop: proactive
-            DropBeforeEnqueue(item, UNFORCED_DROP);
+            DropBeforeEnqueue(item, g_unforcedDrop);
             m_accuProb = 0;
             return false;
         }
@@ -488,7 +504,7 @@ PieQueueDisc::DoDequeue()
                 NS_LOG_DEBUG("CE packet " << static_cast<uint16_t>(tosByte & 0x3));
             }
             if ((Now() - item->GetTimeStamp() > m_ceThreshold) &&
-                Mark(item, CE_THRESHOLD_EXCEEDED_MARK))
+                Mark(item, g_ceThresholdExceededMark))
             {
                 NS_LOG_LOGIC("Marking due to CeThreshold " << m_ceThreshold.GetSeconds());
             }
@@ -13,11 +13,16 @@
 #include "ns3/object-vector.h"
 #include "ns3/packet.h"
 #include "ns3/pointer.h"
+#include "ns3/queue-limits.h"
 #include "ns3/queue.h"
 #include "ns3/simulator.h"
 #include "ns3/socket.h"
 #include "ns3/uinteger.h"
 
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
 namespace ns3
 {
 
@@ -96,77 +101,93 @@ QueueDisc::Stats::Stats()
 {
 }
 
-uint32_t
-QueueDisc::Stats::GetNDroppedPackets(std::string reason) const
+std::size_t
+QueueDisc::Stats::InternReason(std::string_view reason)
 {
-    uint32_t count = 0;
-    auto it = nDroppedPacketsBeforeEnqueue.find(reason);
+    std::size_t id = FindReason(reason);
 
-    if (it != nDroppedPacketsBeforeEnqueue.end())
+    if (id == reasons.size())
     {
-        count += it->second;
+        reasons.emplace_back(reason);
+        nDroppedPacketsBeforeEnqueue.push_back(0);
+        nDroppedPacketsAfterDequeue.push_back(0);
+        nDroppedBytesBeforeEnqueue.push_back(0);
+        nDroppedBytesAfterDequeue.push_back(0);
+        nMarkedPackets.push_back(0);
+        nMarkedBytes.push_back(0);
     }
 
-    it = nDroppedPacketsAfterDequeue.find(reason);
+    return id;
+}
+
+std::size_t
+QueueDisc::Stats::FindReason(std::string_view reason) const
+{
+    return std::find(reasons.begin(), reasons.end(), reason) - reasons.begin();
+}
 
-    if (it != nDroppedPacketsAfterDequeue.end())
+uint32_t
+QueueDisc::Stats::GetNDroppedPackets(std::string reason) const
+{
+    std::size_t id = FindReason(reason);
+
+    if (id == reasons.size())
     {
-        count += it->second;
+        return 0;
     }
 
-    return count;
+    return nDroppedPacketsBeforeEnqueue[id] + nDroppedPacketsAfterDequeue[id];
 }
 
 uint64_t
 QueueDisc::Stats::GetNDroppedBytes(std::string reason) const
 {
-    uint64_t count = 0;
-    auto it = nDroppedBytesBeforeEnqueue.find(reason);
-
-    if (it != nDroppedBytesBeforeEnqueue.end())
-    {
-        count += it->second;
-    }
-
-    it = nDroppedBytesAfterDequeue.find(reason);
+    std::size_t id = FindReason(reason);
 
-    if (it != nDroppedBytesAfterDequeue.end())
+    if (id == reasons.size())
     {
-        count += it->second;
+        return 0;
     }
 
-    return count;
+    return nDroppedBytesBeforeEnqueue[id] + nDroppedBytesAfterDequeue[id];
 }
 
 uint32_t
 QueueDisc::Stats::GetNMarkedPackets(std::string reason) const
 {
-    auto it = nMarkedPackets.find(reason);
+    std::size_t id = FindReason(reason);
 
-    if (it != nMarkedPackets.end())
+    if (id == reasons.size())
     {
-        return it->second;
+        return 0;
     }
 
-    return 0;
+    return nMarkedPackets[id];
 }
 
 uint64_t
 QueueDisc::Stats::GetNMarkedBytes(std::string reason) const
 {
-    auto it = nMarkedBytes.find(reason);
+    std::size_t id = FindReason(reason);
 
-    if (it != nMarkedBytes.end())
+    if (id == reasons.size())
     {
-        return it->second;
+        return 0;
     }
 
-    return 0;
+    return nMarkedBytes[id];
 }
 
 void
 QueueDisc::Stats::Print(std::ostream& os) const
 {
+    // print the counters of the reasons in alphabetical order
+    std::vector<std::size_t> ids(reasons.size());
+    std::iota(ids.begin(), ids.end(), 0);
+    std::sort(ids.begin(), ids.end(), [this](std::size_t a, std::size_t b) {
+        return reasons[a] < reasons[b];
+    });
+
     os << std::endl
        << "Packets/Bytes received: " << nTotalReceivedPackets << " / " << nTotalReceivedBytes
        << std::endl
@@ -181,45 +202,41 @@ QueueDisc::Stats::Print(std::ostream& os) const
        << "Packets/Bytes dropped before enqueue: " << nTotalDroppedPacketsBeforeEnqueue << " / "
        << nTotalDroppedBytesBeforeEnqueue;
 
-    auto itp = nDroppedPacketsBeforeEnqueue.begin();
-    auto itb = nDroppedBytesBeforeEnqueue.begin();
-
-    while (itp != nDroppedPacketsBeforeEnqueue.end() && itb != nDroppedBytesBeforeEnqueue.end())
+    for (auto id : ids)
     {
-        NS_ASSERT(itp->first == itb->first);
-        os << std::endl << "  " << itp->first << ": " << itp->second << " / " << itb->second;
-        itp++;
-        itb++;
+        if (nDroppedPacketsBeforeEnqueue[id] > 0)
+        {
+            os << std::endl
+               << "  " << reasons[id] << ": " << nDroppedPacketsBeforeEnqueue[id] << " / "
+               << nDroppedBytesBeforeEnqueue[id];
+        }
     }
 
     os << std::endl
        << "Packets/Bytes dropped after dequeue: " << nTotalDroppedPacketsAfterDequeue << " / "
        << nTotalDroppedBytesAfterDequeue;
 
-    itp = nDroppedPacketsAfterDequeue.begin();
-    itb = nDroppedBytesAfterDequeue.begin();
-
-    while (itp != nDroppedPacketsAfterDequeue.end() && itb != nDroppedBytesAfterDequeue.end())
+    for (auto id : ids)
     {
-        NS_ASSERT(itp->first == itb->first);
-        os << std::endl << "  " << itp->first << ": " << itp->second << " / " << itb->second;
-        itp++;
-        itb++;
+        if (nDroppedPacketsAfterDequeue[id] > 0)
+        {
+            os << std::endl
+               << "  " << reasons[id] << ": " << nDroppedPacketsAfterDequeue[id] << " / "
+               << nDroppedBytesAfterDequeue[id];
+        }
     }
 
     os << std::endl
        << "Packets/Bytes sent: " << nTotalSentPackets << " / " << nTotalSentBytes << std::endl
        << "Packets/Bytes marked: " << nTotalMarkedPackets << " / " << nTotalMarkedBytes;
 
-    itp = nMarkedPackets.begin();
-    itb = nMarkedBytes.begin();
-
-    while (itp != nMarkedPackets.end() && itb != nMarkedBytes.end())
+    for (auto id : ids)
     {
-        NS_ASSERT(itp->first == itb->first);
-        os << std::endl << "  " << itp->first << ": " << itp->second << " / " << itb->second;
-        itp++;
-        itb++;
+        if (nMarkedPackets[id] > 0)
+        {
+            os << std::endl
+               << "  " << reasons[id] << ": " << nMarkedPackets[id] << " / " << nMarkedBytes[id];
+        }
     }
 
     os << std::endl;
@@ -234,6 +251,26 @@ operator<<(std::ostream& os, const QueueDisc::Stats& stats)
 
 NS_OBJECT_ENSURE_REGISTERED(QueueDisc);
 
+/// Packets dropped by an internal queue
+static const QueueDisc::Reason g_internalQueueDrop =
+    QueueDisc::RegisterReason(QueueDisc::INTERNAL_QUEUE_DROP);
+
+QueueDisc::Reason
+QueueDisc::RegisterReason(const char* text)
+{
+    // the reasons known to all the queue discs, indexed by their identifier
+    static std::vector<std::string> reasons;
+
+    std::size_t id = std::find(reasons.begin(), reasons.end(), text) - reasons.begin();
+
+    if (id == reasons.size())
+    {
+        reasons.emplace_back(text);
+    }
+
+    return {text, id};
+}
+
 TypeId
 QueueDisc::GetTypeId()
 {
@@ -308,6 +345,7 @@ QueueDisc::QueueDisc(QueueDiscSizePolicy policy)
     : m_nPackets(0),
       m_nBytes(0),
       m_maxSize(QueueSize("1p")), // to avoid that setting the mode at construction time is ignored
+      m_maxBurstSize(1),
       m_running(false),
       m_peeked(false),
       m_sizePolicy(policy),
@@ -321,10 +359,10 @@ QueueDisc::QueueDisc(QueueDiscSizePolicy policy)
     // internal queues, the INTERNAL_QUEUE_DROP constant is passed as the reason
     // why the packet is dropped.
     m_internalQueueDbeFunctor = [this](Ptr<const QueueDiscItem> item) {
-        return DropBeforeEnqueue(item, INTERNAL_QUEUE_DROP);
+        return DropBeforeEnqueue(item, g_internalQueueDrop);
     };
     m_internalQueueDadFunctor = [this](Ptr<const QueueDiscItem> item) {
-        return DropAfterDequeue(item, INTERNAL_QUEUE_DROP);
+        return DropAfterDequeue(item, g_internalQueueDrop);
     };
 
     // These lambdas call the DropBeforeEnqueue or DropAfterDequeue methods of this
@@ -333,19 +371,26 @@ QueueDisc::QueueDisc(QueueDiscSizePolicy policy)
     // child queue discs, the concatenation of the CHILD_QUEUE_DISC_DROP constant
     // and the second argument provided by such traces is passed as the reason why
     // the packet is dropped.
+    // Unlike the reasons passed by the subclasses, the content of these messages
+    // changes with the child queue disc and its reason, hence they are interned
+    // by value.
     m_childQueueDiscDbeFunctor = [this](Ptr<const QueueDiscItem> item, const char* r) {
-        return DropBeforeEnqueue(
-            item,
-            m_childQueueDiscDropMsg.assign(CHILD_QUEUE_DISC_DROP).append(r).data());
+        m_childQueueDiscDropMsg.assign(CHILD_QUEUE_DISC_DROP).append(r);
+        return DoDropBeforeEnqueue(item,
+                                   m_childQueueDiscDropMsg.data(),
+                                   m_stats.InternReason(m_childQueueDiscDropMsg));
     };
     m_childQueueDiscDadFunctor = [this](Ptr<const QueueDiscItem> item, const char* r) {
-        return DropAfterDequeue(
-            item,
-            m_childQueueDiscDropMsg.assign(CHILD_QUEUE_DISC_DROP).append(r).data());
+        m_childQueueDiscDropMsg.assign(CHILD_QUEUE_DISC_DROP).append(r);
+        return DoDropAfterDequeue(item,
+                                  m_childQueueDiscDropMsg.data(),
+                                  m_stats.InternReason(m_childQueueDiscDropMsg));
     };
     m_childQueueDiscMarkFunctor = [this](Ptr<const QueueDiscItem> item, const char* r) {
-        return Mark(const_cast<QueueDiscItem*>(PeekPointer(item)),
-                    m_childQueueDiscMarkMsg.assign(CHILD_QUEUE_DISC_MARK).append(r).data());
+        m_childQueueDiscMarkMsg.assign(CHILD_QUEUE_DISC_MARK).append(r);
+        return DoMark(const_cast<QueueDiscItem*>(PeekPointer(item)),
+                      m_childQueueDiscMarkMsg.data(),
+                      m_stats.InternReason(m_childQueueDiscMarkMsg));
     };
 }
 
@@ -370,6 +415,8 @@ QueueDisc::DoDispose()
     m_classes.clear();
     m_devQueueIface = nullptr;
     m_send = nullptr;
+    m_sendBurst = nullptr;
+    m_burst.clear();
     m_requeued = nullptr;
     m_internalQueueDbeFunctor = nullptr;
     m_internalQueueDadFunctor = nullptr;
@@ -544,6 +591,14 @@ QueueDisc::GetSendCallback() const
     return m_send;
 }
 
+void
+QueueDisc::SetSendBurstCallback(SendBurstCallback func, uint32_t maxBurstSize)
+{
+    NS_LOG_FUNCTION(this << maxBurstSize);
+    m_sendBurst = func;
+    m_maxBurstSize = maxBurstSize;
+}
+
 void
 QueueDisc::SetQuota(const uint32_t quota)
 {
@@ -705,8 +760,38 @@ QueueDisc::PacketDequeued(Ptr<const QueueDiscItem> item)
     }
 }
 
+std::size_t
+QueueDisc::GetStatsId(const Reason& reason)
+{
+    if (reason.id >= m_statsIds.size())
+    {
+        m_statsIds.resize(reason.id + 1, std::numeric_limits<std::size_t>::max());
+    }
+
+    std::size_t& id = m_statsIds[reason.id];
+
+    if (id == std::numeric_limits<std::size_t>::max())
+    {
+        id = m_stats.InternReason(reason.text);
+    }
+
+    return id;
+}
+
+void
+QueueDisc::DropBeforeEnqueue(Ptr<const QueueDiscItem> item, const Reason& reason)
+{
+    DoDropBeforeEnqueue(item, reason.text, GetStatsId(reason));
+}
+
 void
 QueueDisc::DropBeforeEnqueue(Ptr<const QueueDiscItem> item, const char* reason)
+{
+    DoDropBeforeEnqueue(item, reason, m_stats.InternReason(reason));
+}
+
+void
+QueueDisc::DoDropBeforeEnqueue(Ptr<const QueueDiscItem> item, const char* reason, std::size_t id)
 {
     NS_LOG_FUNCTION(this << item << reason);
 
@@ -715,26 +800,9 @@ QueueDisc::DropBeforeEnqueue(Ptr<const QueueDiscItem> item, const char* reason)
     m_stats.nTotalDroppedPacketsBeforeEnqueue++;
     m_stats.nTotalDroppedBytesBeforeEnqueue += item->GetSize();
 
-    // update the number of packets dropped for the given reason
-    auto itp = m_stats.nDroppedPacketsBeforeEnqueue.find(reason);
-    if (itp != m_stats.nDroppedPacketsBeforeEnqueue.end())
-    {
-        itp->second++;
-    }
-    else
-    {
-        m_stats.nDroppedPacketsBeforeEnqueue[reason] = 1;
-    }
-    // update the amount of bytes dropped for the given reason
-    auto itb = m_stats.nDroppedBytesBeforeEnqueue.find(reason);
-    if (itb != m_stats.nDroppedBytesBeforeEnqueue.end())
-    {
-        itb->second += item->GetSize();
-    }
-    else
-    {
-        m_stats.nDroppedBytesBeforeEnqueue[reason] = item->GetSize();
-    }
+    // update the number of packets and bytes dropped for the given reason
+    m_stats.nDroppedPacketsBeforeEnqueue[id]++;
+    m_stats.nDroppedBytesBeforeEnqueue[id] += item->GetSize();
 
     NS_LOG_DEBUG("Total packets/bytes dropped before enqueue: "
                  << m_stats.nTotalDroppedPacketsBeforeEnqueue << " / "
@@ -744,8 +812,20 @@ QueueDisc::DropBeforeEnqueue(Ptr<const QueueDiscItem> item, const char* reason)
     m_traceDropBeforeEnqueue(item, reason);
 }
 
+void
+QueueDisc::DropAfterDequeue(Ptr<const QueueDiscItem> item, const Reason& reason)
+{
+    DoDropAfterDequeue(item, reason.text, GetStatsId(reason));
+}
+
 void
 QueueDisc::DropAfterDequeue(Ptr<const QueueDiscItem> item, const char* reason)
+{
+    DoDropAfterDequeue(item, reason, m_stats.InternReason(reason));
+}
+
+void
+QueueDisc::DoDropAfterDequeue(Ptr<const QueueDiscItem> item, const char* reason, std::size_t id)
 {
     NS_LOG_FUNCTION(this << item << reason);
 
@@ -754,26 +834,9 @@ QueueDisc::DropAfterDequeue(Ptr<const QueueDiscItem> item, const char* reason)
     m_stats.nTotalDroppedPacketsAfterDequeue++;
     m_stats.nTotalDroppedBytesAfterDequeue += item->GetSize();
 
-    // update the number of packets dropped for the given reason
-    auto itp = m_stats.nDroppedPacketsAfterDequeue.find(reason);
-    if (itp != m_stats.nDroppedPacketsAfterDequeue.end())
-    {
-        itp->second++;
-    }
-    else
-    {
-        m_stats.nDroppedPacketsAfterDequeue[reason] = 1;
-    }
-    // update the amount of bytes dropped for the given reason
-    auto itb = m_stats.nDroppedBytesAfterDequeue.find(reason);
-    if (itb != m_stats.nDroppedBytesAfterDequeue.end())
-    {
-        itb->second += item->GetSize();
-    }
-    else
-    {
-        m_stats.nDroppedBytesAfterDequeue[reason] = item->GetSize();
-    }
+    // update the number of packets and bytes dropped for the given reason
+    m_stats.nDroppedPacketsAfterDequeue[id]++;
+    m_stats.nDroppedBytesAfterDequeue[id] += item->GetSize();
 
     // if in the context of a peek request a dequeued packet is dropped, we need
     // to update the statistics and fire the dequeue trace before firing the drop
@@ -794,8 +857,20 @@ QueueDisc::DropAfterDequeue(Ptr<const QueueDiscItem> item, const char* reason)
     m_traceDropAfterDequeue(item, reason);
 }
 
+bool
+QueueDisc::Mark(Ptr<QueueDiscItem> item, const Reason& reason)
+{
+    return DoMark(item, reason.text, GetStatsId(reason));
+}
+
 bool
 QueueDisc::Mark(Ptr<QueueDiscItem> item, const char* reason)
+{
+    return DoMark(item, reason, m_stats.InternReason(reason));
+}
+
+bool
+QueueDisc::DoMark(Ptr<QueueDiscItem> item, const char* reason, std::size_t id)
 {
     NS_LOG_FUNCTION(this << item << reason);
 
@@ -809,26 +884,9 @@ QueueDisc::Mark(Ptr<QueueDiscItem> item, const char* reason)
     m_stats.nTotalMarkedPackets++;
     m_stats.nTotalMarkedBytes += item->GetSize();
 
-    // update the number of packets marked for the given reason
-    auto itp = m_stats.nMarkedPackets.find(reason);
-    if (itp != m_stats.nMarkedPackets.end())
-    {
-        itp->second++;
-    }
-    else
-    {
-        m_stats.nMarkedPackets[reason] = 1;
-    }
-    // update the amount of bytes marked for the given reason
-    auto itb = m_stats.nMarkedBytes.find(reason);
-    if (itb != m_stats.nMarkedBytes.end())
-    {
-        itb->second += item->GetSize();
-    }
-    else
-    {
-        m_stats.nMarkedBytes[reason] = item->GetSize();
-    }
+    // update the number of packets and bytes marked for the given reason
+    m_stats.nMarkedPackets[id]++;
+    m_stats.nMarkedBytes[id] += item->GetSize();
 
     NS_LOG_DEBUG("Total packets/bytes marked: " << m_stats.nTotalMarkedPackets << " / "
                                                 << m_stats.nTotalMarkedBytes);
@@ -938,10 +996,9 @@ QueueDisc::Run()
     if (RunBegin())
     {
         uint32_t quota = m_quota;
-        while (Restart())
+        while (Restart(quota))
         {
-            quota -= 1;
-            if (quota <= 0)
+            if (quota == 0)
             {
                 /// @todo netif_schedule (q);
                 break;
@@ -972,9 +1029,10 @@ QueueDisc::RunEnd()
 }
 
 bool
-QueueDisc::Restart()
+QueueDisc::Restart(uint32_t& quota)
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION(this << quota);
+    bool requeued = (m_requeued != nullptr);
     Ptr<QueueDiscItem> item = DequeuePacket();
     if (!item)
     {
@@ -982,6 +1040,20 @@ QueueDisc::Restart()
         return false;
     }
 
+    // As in Linux, a requeued packet is sent alone. DequeuePacket does not check
+    // whether the device queue of the packet is stopped if the device is multi-queue,
+    // in which case the packet is requeued by Transmit
+    Ptr<NetDeviceQueue> txQueue =
+        m_devQueueIface ? m_devQueueIface->GetTxQueue(item->GetTxQueueIndex()) : nullptr;
+    if (!requeued && m_sendBurst && m_maxBurstSize > 1 && quota > 1 && txQueue &&
+        txQueue->GetQueueLimits() && !txQueue->IsStopped())
+    {
+        DequeueBulk(item, std::min(quota, m_maxBurstSize));
+        quota -= m_burst.size();
+        return TransmitBurst();
+    }
+
+    quota--;
     return Transmit(item);
 }
 
@@ -1035,6 +1107,32 @@ QueueDisc::DequeuePacket()
     return item;
 }
 
+void
+QueueDisc::DequeueBulk(Ptr<QueueDiscItem> item, uint32_t quota)
+{
+    NS_LOG_FUNCTION(this << item << quota);
+
+    // The bulk holds the bytes the queue limits (e.g., BQL) allow, hence the
+    // device queue is not overrun and the queue limits apply to the whole burst
+    Ptr<QueueLimits> queueLimits =
+        m_devQueueIface->GetTxQueue(item->GetTxQueueIndex())->GetQueueLimits();
+    int64_t bytes = static_cast<int64_t>(queueLimits->Available()) - item->GetSize();
+    m_burst.push_back(item);
+
+    while (bytes > 0 && m_burst.size() < quota)
+    {
+        item = Dequeue();
+        if (!item)
+        {
+            break;
+        }
+        item->AddHeader();
+        bytes -= item->GetSize();
+        m_burst.push_back(item);
+    }
+    NS_LOG_LOGIC("Dequeued a bulk of " << m_burst.size() << " packets");
+}
+
 void
 QueueDisc::Requeue(Ptr<QueueDiscItem> item)
 {
@@ -1094,4 +1192,28 @@ QueueDisc::Transmit(Ptr<QueueDiscItem> item)
         (m_devQueueIface && m_devQueueIface->GetTxQueue(item->GetTxQueueIndex())->IsStopped()));
 }
 
+bool
+QueueDisc::TransmitBurst()
+{
+    NS_LOG_FUNCTION(this);
+
+    // the device queue was not stopped when the bulk was dequeued, and nothing was
+    // sent to the device since, hence the burst is not requeued
+    std::size_t txq = m_burst.front()->GetTxQueueIndex();
+    NS_ASSERT(!m_devQueueIface->GetTxQueue(txq)->IsStopped());
+    if (m_devQueueIface->GetNTxQueues() == 1)
+    {
+        for (const auto& item : m_burst)
+        {
+            SocketPriorityTag priorityTag;
+            item->GetPacket()->RemovePacketTag(priorityTag);
+        }
+    }
+    NS_ASSERT_MSG(m_sendBurst, "Send burst callback not set");
+    m_sendBurst(m_burst);
+    m_burst.clear();
+
+    return !(GetNPackets() == 0 || m_devQueueIface->GetTxQueue(txq)->IsStopped());
+}
+
 } // namespace ns3
@@ -18,8 +18,9 @@
 #include "ns3/traced-value.h"
 
 #include <functional>
-#include <map>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 namespace ns3
@@ -195,38 +196,55 @@ class QueueDisc : public Object
         uint32_t nTotalDroppedPackets;
         /// Total packets dropped before enqueue
         uint32_t nTotalDroppedPacketsBeforeEnqueue;
-        /// Packets dropped before enqueue, for each reason
-        std::map<std::string, uint32_t, std::less<>> nDroppedPacketsBeforeEnqueue;
+        /// Packets dropped before enqueue, for each reason identifier
+        std::vector<uint32_t> nDroppedPacketsBeforeEnqueue;
         /// Total packets dropped after dequeue
         uint32_t nTotalDroppedPacketsAfterDequeue;
-        /// Packets dropped after dequeue, for each reason
-        std::map<std::string, uint32_t, std::less<>> nDroppedPacketsAfterDequeue;
+        /// Packets dropped after dequeue, for each reason identifier
+        std::vector<uint32_t> nDroppedPacketsAfterDequeue;
         /// Total dropped bytes
         uint64_t nTotalDroppedBytes;
         /// Total bytes dropped before enqueue
         uint64_t nTotalDroppedBytesBeforeEnqueue;
-        /// Bytes dropped before enqueue, for each reason
-        std::map<std::string, uint64_t, std::less<>> nDroppedBytesBeforeEnqueue;
+        /// Bytes dropped before enqueue, for each reason identifier
+        std::vector<uint64_t> nDroppedBytesBeforeEnqueue;
         /// Total bytes dropped after dequeue
         uint64_t nTotalDroppedBytesAfterDequeue;
-        /// Bytes dropped after dequeue, for each reason
-        std::map<std::string, uint64_t, std::less<>> nDroppedBytesAfterDequeue;
+        /// Bytes dropped after dequeue, for each reason identifier
+        std::vector<uint64_t> nDroppedBytesAfterDequeue;
         /// Total requeued packets
         uint32_t nTotalRequeuedPackets;
         /// Total requeued bytes
         uint64_t nTotalRequeuedBytes;
         /// Total marked packets
         uint32_t nTotalMarkedPackets;
-        /// Marked packets, for each reason
-        std::map<std::string, uint32_t, std::less<>> nMarkedPackets;
+        /// Marked packets, for each reason identifier
+        std::vector<uint32_t> nMarkedPackets;
         /// Total marked bytes
         uint32_t nTotalMarkedBytes;
-        /// Marked bytes, for each reason
-        std::map<std::string, uint64_t, std::less<>> nMarkedBytes;
+        /// Marked bytes, for each reason identifier
+        std::vector<uint64_t> nMarkedBytes;
+        /// The reasons why packets were dropped or marked, indexed by their identifier
+        std::vector<std::string> reasons;
 
         /// constructor
         Stats();
 
+        /**
+         * @brief Get the identifier of a reason, adding the reason and its
+         *        counters if it is not known yet
+         * @param reason the reason why packets were dropped or marked
+         * @return the identifier of the reason
+         */
+        std::size_t InternReason(std::string_view reason);
+        /**
+         * @brief Get the identifier of a reason
+         * @param reason the reason why packets were dropped or marked
+         * @return the identifier of the reason, or the number of reasons if
+         *         the reason is not known
+         */
+        std::size_t FindReason(std::string_view reason) const;
+
         /**
          * @brief Get the number of packets dropped for the given reason
          * @param reason the reason why packets were dropped
@@ -367,6 +385,21 @@ class QueueDisc : public Object
      */
     SendCallback GetSendCallback() const;
 
+    /// Callback invoked to send a burst of packets to the receiving object when Run is called
+    typedef std::function<void(const std::vector<Ptr<QueueDiscItem>>&)> SendBurstCallback;
+
+    /**
+     * @param func the callback to send a burst of packets to the receiving object.
+     * @param maxBurstSize the maximum number of packets of a burst
+     *
+     * Set the callback used by the Run method to send the packets dequeued in
+     * bulk to the receiving object, as a burst. Packets are dequeued in bulk
+     * only if this callback is set, maxBurstSize is greater than 1 and the
+     * device queue has queue limits (e.g., BQL): the bulk then holds the bytes
+     * the queue limits allow (see NetDevice::SendBurst).
+     */
+    void SetSendBurstCallback(SendBurstCallback func, uint32_t maxBurstSize);
+
     /**
      * @brief Set the maximum number of dequeue operations following a packet enqueue
      * @param quota the maximum number of dequeue operations following a packet enqueue.
@@ -515,6 +548,31 @@ class QueueDisc : public Object
     static constexpr const char* CHILD_QUEUE_DISC_MARK =
         "(Marked by child queue disc) "; //!< Packet marked by a child queue disc
 
+    /**
+     * @brief A reason why packets are dropped or marked, along with its identifier
+     *
+     * The identifier of a reason is shared by all the queue discs, which find the
+     * counters of the reason in their statistics by indexing a vector with it.
+     */
+    struct Reason
+    {
+        const char* text; //!< the reason
+        std::size_t id;   //!< the identifier of the reason
+    };
+
+    /**
+     * @brief Get the reason with the given text, adding it to the reasons known
+     *        to all the queue discs if it is not known yet
+     *
+     * The text is compared with the known reasons, hence this method is meant to
+     * be called once for each reason, e.g., when initializing a static variable,
+     * and the returned reason to be passed to DropBeforeEnqueue, DropAfterDequeue
+     * and Mark.
+     * @param text the reason, which must outlive the returned object
+     * @return the reason
+     */
+    static Reason RegisterReason(const char* text);
+
   protected:
     /**
      * @brief Dispose of the object
@@ -540,6 +598,16 @@ class QueueDisc : public Object
      * This method must be called by subclasses to record that a packet was
      * dropped before enqueue for the specified reason
      */
+    void DropBeforeEnqueue(Ptr<const QueueDiscItem> item, const Reason& reason);
+
+    /**
+     * @brief Perform the actions required when the queue disc is notified of
+     *        a packet dropped before enqueue
+     * @param item item that was dropped
+     * @param reason the reason why the item was dropped
+     * The reason is looked up by value, hence subclasses should rather pass
+     * a Reason obtained once from RegisterReason
+     */
     void DropBeforeEnqueue(Ptr<const QueueDiscItem> item, const char* reason);
 
     /**
@@ -550,6 +618,16 @@ class QueueDisc : public Object
      * This method must be called by subclasses to record that a packet was
      * dropped after dequeue for the specified reason
      */
+    void DropAfterDequeue(Ptr<const QueueDiscItem> item, const Reason& reason);
+
+    /**
+     * @brief Perform the actions required when the queue disc is notified of
+     *        a packet dropped after dequeue
+     * @param item item that was dropped
+     * @param reason the reason why the item was dropped
+     * The reason is looked up by value, hence subclasses should rather pass
+     * a Reason obtained once from RegisterReason
+     */
     void DropAfterDequeue(Ptr<const QueueDiscItem> item, const char* reason);
 
     /**
@@ -559,9 +637,76 @@ class QueueDisc : public Object
      * @param reason the reason why the item has to be marked
      * @return true if the item was successfully marked, false otherwise
      */
+    bool Mark(Ptr<QueueDiscItem> item, const Reason& reason);
+
+    /**
+     * @brief Marks the given packet and, if successful, updates the counters
+     *        associated with the given reason
+     * @param item item that has to be marked
+     * @param reason the reason why the item has to be marked
+     * @return true if the item was successfully marked, false otherwise
+     * The reason is looked up by value, hence subclasses should rather pass
+     * a Reason obtained once from RegisterReason
+     */
     bool Mark(Ptr<QueueDiscItem> item, const char* reason);
 
+    /**
+     * @brief Perform the actions required when the queue disc is notified of
+     *        a packet enqueue
+     * @param item item that was enqueued
+     * This method is called when an internal queue or a child queue disc
+     * enqueues a packet, and must be called by subclasses storing the packets
+     * themselves when they enqueue a packet
+     */
+    void PacketEnqueued(Ptr<const QueueDiscItem> item);
+
+    /**
+     * @brief Perform the actions required when the queue disc is notified of
+     *        a packet dequeue
+     * @param item item that was dequeued
+     * This method is called when an internal queue or a child queue disc
+     * dequeues a packet, and must be called by subclasses storing the packets
+     * themselves when they remove a packet (before dropping it, if needed)
+     */
+    void PacketDequeued(Ptr<const QueueDiscItem> item);
+
   private:
+    /**
+     * @brief Get the identifier of a reason in the statistics of this queue disc,
+     *        adding the reason to the statistics if it is not there yet
+     * @param reason the reason why packets were dropped or marked
+     * @return the identifier of the reason in the statistics
+     */
+    std::size_t GetStatsId(const Reason& reason);
+
+    /**
+     * @brief Update the statistics and fire the traces for a packet dropped
+     *        before enqueue
+     * @param item item that was dropped
+     * @param reason the reason why the item was dropped
+     * @param id the identifier of the reason
+     */
+    void DoDropBeforeEnqueue(Ptr<const QueueDiscItem> item, const char* reason, std::size_t id);
+
+    /**
+     * @brief Update the statistics and fire the traces for a packet dropped
+     *        after dequeue
+     * @param item item that was dropped
+     * @param reason the reason why the item was dropped
+     * @param id the identifier of the reason
+     */
+    void DoDropAfterDequeue(Ptr<const QueueDiscItem> item, const char* reason, std::size_t id);
+
+    /**
+     * @brief Mark the given packet and, if successful, update the statistics
+     *        and fire the trace
+     * @param item item that has to be marked
+     * @param reason the reason why the item has to be marked
+     * @param id the identifier of the reason
+     * @return true if the item was successfully marked, false otherwise
+     */
+    bool DoMark(Ptr<QueueDiscItem> item, const char* reason, std::size_t id);
+
     /**
      * This function actually enqueues a packet into the queue disc.
      * @param item item to enqueue
@@ -632,10 +777,14 @@ class QueueDisc : public Object
 
     /**
      * Modelled after the Linux function qdisc_restart (net/sched/sch_generic.c)
-     * Dequeue a packet (by calling DequeuePacket) and send it to the device (by calling Transmit).
-     * @return true if a packet is successfully sent to the device.
+     * Dequeue a packet (by calling DequeuePacket) and send it to the device (by calling Transmit),
+     * or dequeue a bulk of packets (by also calling DequeueBulk) and send them to the device as
+     * a burst (by calling TransmitBurst).
+     * @param quota the number of packets that can still be dequeued in this run, which is
+     *        decreased by the number of packets sent to the device.
+     * @return true if the packets are successfully sent to the device.
      */
-    bool Restart();
+    bool Restart(uint32_t& quota);
 
     /**
      * Modelled after the Linux function dequeue_skb (net/sched/sch_generic.c)
@@ -643,6 +792,15 @@ class QueueDisc : public Object
      */
     Ptr<QueueDiscItem> DequeuePacket();
 
+    /**
+     * Modelled after the Linux function try_bulk_dequeue_skb (net/sched/sch_generic.c)
+     * Dequeue the packets following the given one, as long as the queue limits of the
+     * device queue allow it, and add them to the burst to send.
+     * @param item the packet dequeued first
+     * @param quota the maximum number of packets of the burst
+     */
+    void DequeueBulk(Ptr<QueueDiscItem> item, uint32_t quota);
+
     /**
      * Modelled after the Linux function dev_requeue_skb (net/sched/sch_generic.c)
      * Requeues a packet whose transmission failed.
@@ -660,18 +818,10 @@ class QueueDisc : public Object
     bool Transmit(Ptr<QueueDiscItem> item);
 
     /**
-     * @brief Perform the actions required when the queue disc is notified of
-     *        a packet enqueue
-     * @param item item that was enqueued
-     */
-    void PacketEnqueued(Ptr<const QueueDiscItem> item);
-
-    /**
-     * @brief Perform the actions required when the queue disc is notified of
-     *        a packet dequeue
-     * @param item item that was dequeued
+     * Send the packets dequeued in bulk to the device, as a burst.
+     * @return true if the device queue is not stopped and the queue disc is not empty
      */
-    void PacketDequeued(Ptr<const QueueDiscItem> item);
+    bool TransmitBurst();
 
     /// Default quota (as in /proc/sys/net/core/dev_weight)
     static const uint32_t DEFAULT_QUOTA = 64;
@@ -686,9 +836,13 @@ class QueueDisc : public Object
     QueueSize m_maxSize;              //!< max queue size
 
     Stats m_stats;    //!< The collected statistics
+    /// Identifier in the statistics of each reason, indexed by the identifier of the reason
+    std::vector<std::size_t> m_statsIds;
     uint32_t m_quota; //!< Maximum number of packets dequeued in a qdisc run
     Ptr<NetDeviceQueueInterface> m_devQueueIface; //!< NetDevice queue interface
     SendCallback m_send;           //!< Callback used to send a packet to the receiving object
+    SendBurstCallback m_sendBurst; //!< Callback used to send a burst to the receiving object
+    uint32_t m_maxBurstSize;       //!< Maximum number of packets of a burst
     bool m_running;                //!< The queue disc is performing multiple dequeue operations
     Ptr<QueueDiscItem> m_requeued; //!< The last packet that failed to be transmitted
     bool m_peeked;                 //!< A packet was dequeued because Peek was called
@@ -696,6 +850,8 @@ class QueueDisc : public Object
     std::string m_childQueueDiscMarkMsg; //!< Reason why a packet was marked by a child queue disc
     QueueDiscSizePolicy m_sizePolicy;    //!< The queue disc size policy
     bool m_prohibitChangeMode;           //!< True if changing mode is prohibited
+    /// Packets dequeued in bulk, to be sent as a burst
+    std::vector<Ptr<QueueDiscItem>> m_burst;
 
     /// Traced callback: fired when a packet is enqueued
     TracedCallback<Ptr<const QueueDiscItem>> m_traceEnqueue;
@@ -61,6 +61,22 @@ NS_LOG_COMPONENT_DEFINE("RedQueueDisc");
 
 NS_OBJECT_ENSURE_REGISTERED(RedQueueDisc);
 
+/// The UNFORCED_MARK reason, registered once
+static const QueueDisc::Reason g_unforcedMark =
+    QueueDisc::RegisterReason(RedQueueDisc::UNFORCED_MARK);
+
+/// The UNFORCED_DROP reason, registered once
+static const QueueDisc::Reason g_unforcedDrop =
+    QueueDisc::RegisterReason(RedQueueDisc::UNFORCED_DROP);
+
+/// The FORCED_MARK reason, registered once
+static const QueueDisc::Reason g_forcedMark =
+    QueueDisc::RegisterReason(RedQueueDisc::FORCED_MARK);
+
+/// The FORCED_DROP reason, registered once
+static const QueueDisc::Reason g_forcedDrop =
+    QueueDisc::RegisterReason(RedQueueDisc::FORCED_DROP);
+
 TypeId
 RedQueueDisc::GetTypeId()
 {
@@ -399,20 +415,20 @@ RedQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
 
     if (dropType == DTYPE_UNFORCED)
     {
-        if (!m_useEcn || !Mark(item, UNFORCED_MARK))
+        if (!m_useEcn || !Mark(item, g_unforcedMark))
         {
             NS_LOG_DEBUG("\t Dropping due to Prob Mark " << m_qAvg);
-            DropBeforeEnqueue(item, UNFORCED_DROP);
+            DropBeforeEnqueue(item, g_unforcedDrop);
             return false;
         }
         NS_LOG_DEBUG("\t Marking due to Prob Mark " << m_qAvg);
     }
     else if (dropType == DTYPE_FORCED)
     {
-        if (m_useHardDrop || !m_useEcn || !Mark(item, FORCED_MARK))
+        if (m_useHardDrop || !m_useEcn || !Mark(item, g_forcedMark))
         {
             NS_LOG_DEBUG("\t Dropping due to Hard Mark " << m_qAvg);
-            DropBeforeEnqueue(item, FORCED_DROP);
+            DropBeforeEnqueue(item, g_forcedDrop);
             if (m_isNs1Compat)
             {
                 m_count = 0;
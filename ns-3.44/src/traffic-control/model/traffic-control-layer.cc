@@ -201,6 +201,16 @@ TrafficControlLayer::ScanDevices()
                 q->SetSendCallback([dev](Ptr<QueueDiscItem> item) {
                     dev->Send(item->GetPacket(), item->GetAddress(), item->GetProtocol());
                 });
+                // the packets of a burst must all be destined to the same device queue
+                if (dev->GetMaxBurstSize() > 1 &&
+                    (!ndqi || ndqi->GetNTxQueues() == 1 || q != ndi->second.m_rootQueueDisc))
+                {
+                    q->SetSendBurstCallback(
+                        [dev](const std::vector<Ptr<QueueDiscItem>>& items) {
+                            dev->SendBurst(items);
+                        },
+                        dev->GetMaxBurstSize());
+                }
             }
         }
     }
@@ -265,6 +275,7 @@ TrafficControlLayer::DeleteRootQueueDiscOnDevice(Ptr<NetDevice> device)
     {
         q->SetNetDeviceQueueInterface(nullptr);
         q->SetSendCallback(nullptr);
+        q->SetSendBurstCallback(nullptr, 1);
     }
     ndi->second.m_queueDiscsToWake.clear();
 
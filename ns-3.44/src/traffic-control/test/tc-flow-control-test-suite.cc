@@ -10,12 +10,16 @@
 #include "ns3/config.h"
 #include "ns3/data-rate.h"
 #include "ns3/double.h"
+#include "ns3/drop-tail-queue.h"
+#include "ns3/error-model.h"
 #include "ns3/log.h"
 #include "ns3/net-device-queue-interface.h"
 #include "ns3/node-container.h"
 #include "ns3/pointer.h"
 #include "ns3/queue.h"
+#include "ns3/simple-channel.h"
 #include "ns3/simple-net-device-helper.h"
+#include "ns3/simple-net-device.h"
 #include "ns3/simulator.h"
 #include "ns3/string.h"
 #include "ns3/test.h"
@@ -481,6 +485,198 @@ TcFlowControlTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup traffic-control-test
+ *
+ * @brief Simple net device accepting bursts of packets, which records their size
+ */
+class BurstTestNetDevice : public SimpleNetDevice
+{
+  public:
+    uint32_t GetMaxBurstSize() const override;
+    void SendBurst(const std::vector<Ptr<QueueDiscItem>>& items) override;
+
+    static const uint32_t MAX_BURST_SIZE = 8; //!< the maximum number of packets of a burst
+    std::vector<std::size_t> m_bursts;        //!< the size of the bursts sent to the device
+};
+
+uint32_t
+BurstTestNetDevice::GetMaxBurstSize() const
+{
+    return MAX_BURST_SIZE;
+}
+
+void
+BurstTestNetDevice::SendBurst(const std::vector<Ptr<QueueDiscItem>>& items)
+{
+    m_bursts.push_back(items.size());
+    SimpleNetDevice::SendBurst(items);
+}
+
+/**
+ * @ingroup traffic-control-test
+ *
+ * @brief Traffic Control Bulk Dequeue Test Case
+ *
+ * Check that the packets are dequeued in bulk and sent as bursts to a device
+ * accepting them only if the device queue has queue limits, and that no packet
+ * is sent to the device while its queue is stopped, also when the device has
+ * several queues, each one served by a child queue disc of an mq queue disc.
+ */
+class TcBulkDequeueTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     *
+     * @param queueLimits whether the device queue has queue limits (BQL)
+     * @param nTxQueues the number of device queues
+     */
+    TcBulkDequeueTestCase(bool queueLimits, std::size_t nTxQueues);
+
+  private:
+    void DoRun() override;
+    /**
+     * Receive a packet
+     * @param dev the receiving device
+     * @param p the packet
+     * @param protocol the protocol number
+     * @param from the sender address
+     * @param to the destination address
+     * @param type the packet type
+     * @return true
+     */
+    bool Receive(Ptr<NetDevice> dev,
+                 Ptr<const Packet> p,
+                 uint16_t protocol,
+                 const Address& from,
+                 const Address& to,
+                 NetDevice::PacketType type);
+
+    bool m_queueLimits;      //!< whether the device queue has queue limits
+    std::size_t m_nTxQueues; //!< the number of device queues
+    uint32_t m_rxPackets;    //!< the number of received packets
+    Time m_firstRxTime;      //!< the time the first packet was received
+};
+
+TcBulkDequeueTestCase::TcBulkDequeueTestCase(bool queueLimits, std::size_t nTxQueues)
+    : TestCase(std::string("Test the bulk dequeue of packets ") +
+               (queueLimits ? "with" : "without") + " queue limits and " +
+               std::to_string(nTxQueues) + " device queue(s)"),
+      m_queueLimits(queueLimits),
+      m_nTxQueues(nTxQueues),
+      m_rxPackets(0)
+{
+}
+
+bool
+TcBulkDequeueTestCase::Receive(Ptr<NetDevice> dev,
+                               Ptr<const Packet> p,
+                               uint16_t protocol,
+                               const Address& from,
+                               const Address& to,
+                               NetDevice::PacketType type)
+{
+    if (m_rxPackets++ == 0)
+    {
+        m_firstRxTime = Simulator::Now();
+    }
+    return true;
+}
+
+void
+TcBulkDequeueTestCase::DoRun()
+{
+    const uint32_t nPackets = 20;
+
+    NodeContainer n;
+    n.Create(2);
+    n.Get(0)->AggregateObject(CreateObject<TrafficControlLayer>());
+
+    SimpleNetDeviceHelper simple;
+    NetDeviceContainer rxDevC = simple.Install(n.Get(1));
+    rxDevC.Get(0)->SetPromiscReceiveCallback(MakeCallback(&TcBulkDequeueTestCase::Receive, this));
+
+    Ptr<BurstTestNetDevice> txDev = CreateObject<BurstTestNetDevice>();
+    txDev->SetAttribute("DataRate", DataRateValue(DataRate("1Mb/s")));
+    txDev->SetAddress(Mac48Address::Allocate());
+    n.Get(0)->AddDevice(txDev);
+    txDev->SetChannel(DynamicCast<SimpleChannel>(rxDevC.Get(0)->GetChannel()));
+    Ptr<Queue<Packet>> queue = CreateObject<DropTailQueue<Packet>>();
+    txDev->SetQueue(queue);
+    Ptr<NetDeviceQueueInterface> ndqi =
+        CreateObjectWithAttributes<NetDeviceQueueInterface>("NTxQueues",
+                                                            UintegerValue(m_nTxQueues));
+    // all the packets are sent through the first device queue
+    ndqi->SetSelectQueueCallback([](Ptr<QueueItem>) -> std::size_t { return 0; });
+    ndqi->GetTxQueue(0)->ConnectQueueTraces(queue);
+    txDev->AggregateObject(ndqi);
+
+    TrafficControlHelper tch = TrafficControlHelper::Default();
+    if (m_nTxQueues > 1)
+    {
+        tch = TrafficControlHelper();
+        uint16_t handle = tch.SetRootQueueDisc("ns3::MqQueueDisc");
+        TrafficControlHelper::ClassIdList cls =
+            tch.AddQueueDiscClasses(handle, m_nTxQueues, "ns3::QueueDiscClass");
+        tch.AddChildQueueDiscs(handle, cls, "ns3::FifoQueueDisc");
+    }
+    if (m_queueLimits)
+    {
+        // the queue limits allow all the packets to be sent to the device
+        tch.SetQueueLimits("ns3::DynamicQueueLimits", "MinLimit", UintegerValue(100000));
+    }
+    tch.Install(txDev);
+
+    // The packets are stored in the queue disc while the device queue is stopped,
+    // and dequeued when it is woken up
+    Ptr<TrafficControlLayer> tc = n.Get(0)->GetObject<TrafficControlLayer>();
+    Simulator::Schedule(MilliSeconds(1), &NetDeviceQueue::Stop, ndqi->GetTxQueue(0));
+    for (uint32_t i = 0; i < nPackets; i++)
+    {
+        Simulator::Schedule(MilliSeconds(1),
+                            &TrafficControlLayer::Send,
+                            tc,
+                            txDev,
+                            Create<QueueDiscTestItem>(Create<Packet>(1000)));
+    }
+    Simulator::Schedule(MilliSeconds(10), &NetDeviceQueue::Wake, ndqi->GetTxQueue(0));
+
+    Simulator::Run();
+    Simulator::Destroy();
+
+    NS_TEST_EXPECT_MSG_EQ(m_rxPackets, nPackets, "All the packets must have been received");
+    NS_TEST_EXPECT_MSG_GT_OR_EQ(m_firstRxTime,
+                                MilliSeconds(10),
+                                "No packet must be sent while the device queue is stopped");
+    if (m_queueLimits)
+    {
+        // the bursts are limited by the maximum burst size of the device (the
+        // first one is limited by the initial limit of DQL)
+        std::size_t nBurstPackets = 0;
+        std::size_t maxBurst = 0;
+        for (auto burst : txDev->m_bursts)
+        {
+            nBurstPackets += burst;
+            maxBurst = std::max(maxBurst, burst);
+        }
+        // with several device queues, the first packet is dequeued while the device
+        // queue is stopped, hence it is requeued and then sent alone
+        NS_TEST_EXPECT_MSG_EQ(nBurstPackets,
+                              nPackets - (m_nTxQueues > 1 ? 1 : 0),
+                              "All the other packets must be sent in bursts");
+        NS_TEST_EXPECT_MSG_EQ(maxBurst,
+                              BurstTestNetDevice::MAX_BURST_SIZE,
+                              "The bursts must be as large as the device allows");
+    }
+    else
+    {
+        NS_TEST_EXPECT_MSG_EQ(txDev->m_bursts.size(),
+                              0,
+                              "No burst must be sent without queue limits");
+    }
+}
+
 /**
  * @ingroup traffic-control-test
  *
@@ -515,5 +711,8 @@ static class TcFlowControlTestSuite : public TestSuite
         // also be made parametric.
         AddTestCase(new TcFlowControlTestCase(QueueSizeUnit::BYTES, 5000, 10),
                     TestCase::Duration::QUICK);
+        AddTestCase(new TcBulkDequeueTestCase(true, 1), TestCase::Duration::QUICK);
+        AddTestCase(new TcBulkDequeueTestCase(false, 1), TestCase::Duration::QUICK);
+        AddTestCase(new TcBulkDequeueTestCase(true, 2), TestCase::Duration::QUICK);
     }
 } g_tcFlowControlTestSuite; ///< the test suite
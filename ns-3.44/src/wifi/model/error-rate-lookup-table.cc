@@ -0,0 +1,106 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "error-rate-lookup-table.h"
+
+#include "wifi-utils.h"
+
+#include "ns3/log.h"
+
+#include <cmath>
+#include <limits>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("ErrorRateLookupTable");
+
+ErrorRateLookupTable::ErrorRateLookupTable(const ErrorRateFunction& errorRate, double maxError)
+    : m_step{1},
+      m_minSnr{MIN_SNR},
+      m_negligibleSnr{std::numeric_limits<double>::infinity()}
+{
+    NS_LOG_FUNCTION(this << maxError);
+    NS_ASSERT_MSG(maxError > 0, "The maximum error must be positive");
+    while (true)
+    {
+        m_logErrorRates.clear();
+        m_minSnr = MIN_SNR;
+        m_negligibleSnr = std::numeric_limits<double>::infinity();
+        for (std::size_t i = 0; MIN_SNR + i * m_step <= MAX_SNR; i++)
+        {
+            const dB_u snr = MIN_SNR + i * m_step;
+            const auto rate = errorRate(DbToRatio(snr));
+            if (rate >= 1 && m_logErrorRates.empty())
+            {
+                // the table starts after the saturation of the error rate, whose kink
+                // would be poorly interpolated
+                m_minSnr = snr + m_step;
+                continue;
+            }
+            if (rate < NEGLIGIBLE_ERROR_RATE)
+            {
+                m_negligibleSnr = snr;
+                break;
+            }
+            m_logErrorRates.push_back(std::log(rate));
+        }
+
+        double error = 0;
+        for (std::size_t i = 0; i + 1 < m_logErrorRates.size(); i++)
+        {
+            const auto rate = errorRate(DbToRatio(m_minSnr + (i + 0.5) * m_step));
+            const auto interpolated = std::exp((m_logErrorRates[i] + m_logErrorRates[i + 1]) / 2);
+            error = std::max(error, std::abs(interpolated - rate) / rate);
+        }
+        if (error <= maxError)
+        {
+            break;
+        }
+        if (m_step / 2 < MIN_STEP)
+        {
+            NS_LOG_WARN("Relative error " << error << " above " << maxError << " with a "
+                                          << m_step << " dB spacing");
+            break;
+        }
+        m_step /= 2;
+    }
+    NS_LOG_DEBUG(m_logErrorRates.size() << " error rates with a " << m_step << " dB spacing");
+}
+
+std::optional<double>
+ErrorRateLookupTable::GetErrorRate(double snr) const
+{
+    if (snr <= 0)
+    {
+        return std::nullopt;
+    }
+    const auto snrDb = RatioToDb(snr);
+    if (snrDb >= m_negligibleSnr)
+    {
+        return 0;
+    }
+    const auto position = (snrDb - m_minSnr) / m_step;
+    if (position < 0 || position + 1 >= m_logErrorRates.size())
+    {
+        return std::nullopt;
+    }
+    const auto i = static_cast<std::size_t>(position);
+    const auto fraction = position - i;
+    return std::exp(m_logErrorRates[i] + fraction * (m_logErrorRates[i + 1] - m_logErrorRates[i]));
+}
+
+dB_u
+ErrorRateLookupTable::GetStep() const
+{
+    return m_step;
+}
+
+std::size_t
+ErrorRateLookupTable::GetSize() const
+{
+    return m_logErrorRates.size();
+}
+
+} // namespace ns3
@@ -0,0 +1,79 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef ERROR_RATE_LOOKUP_TABLE_H
+#define ERROR_RATE_LOOKUP_TABLE_H
+
+#include "wifi-units.h"
+
+#include <functional>
+#include <optional>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup wifi
+ * @brief Lookup table of an error probability decreasing with the SNR, built from an
+ * analytical error rate model.
+ *
+ * The table stores the logarithm of the error probability returned by the analytical
+ * model at SNR values evenly spaced in dB, from the first SNR above MIN_SNR at which the
+ * error probability is lower than 1, up to the first SNR at which the error probability
+ * is negligible, i.e., too small to change 1 - p in double precision.
+ * The error probability is interpolated linearly in the log domain. The spacing starts
+ * at 1 dB and is halved until the error probabilities interpolated in the middle of the
+ * intervals are within the requested relative error of the analytical model.
+ */
+class ErrorRateLookupTable
+{
+  public:
+    /// Function returning the error probability at the given SNR (linear scale)
+    using ErrorRateFunction = std::function<double(double)>;
+
+    /**
+     * Build the lookup table of an analytical error rate model.
+     *
+     * @param errorRate the function returning the error probability at the given SNR
+     * @param maxError the maximum relative error of the interpolated error probabilities
+     */
+    ErrorRateLookupTable(const ErrorRateFunction& errorRate, double maxError);
+
+    /**
+     * @param snr the SNR (linear scale)
+     * @return the error probability interpolated at the given SNR, 0 if it is negligible,
+     *         or std::nullopt if the SNR is below the table or between its last SNR and the
+     *         SNR at which the error probability is negligible, in which case the analytical
+     *         model must be used
+     */
+    std::optional<double> GetErrorRate(double snr) const;
+
+    /**
+     * @return the spacing of the SNR values of the table
+     */
+    dB_u GetStep() const;
+
+    /**
+     * @return the number of SNR values in the table
+     */
+    std::size_t GetSize() const;
+
+    static constexpr dB_u MIN_SNR{-10};   //!< the lowest SNR of the tables
+    static constexpr dB_u MAX_SNR{100};   //!< the highest SNR of the tables
+    static constexpr dB_u MIN_STEP{1e-3}; //!< the smallest spacing of the SNR values
+
+    /// the error probability below which 1 - p rounds to 1 in double precision
+    static constexpr double NEGLIGIBLE_ERROR_RATE = 1e-17;
+
+  private:
+    dB_u m_step;                         //!< the spacing of the SNR values
+    dB_u m_minSnr;                       //!< the first SNR of the table
+    dB_u m_negligibleSnr;                //!< the SNR above which the error rate is negligible
+    std::vector<double> m_logErrorRates; //!< the logarithm of the error probabilities
+};
+
+} // namespace ns3
+
+#endif /* ERROR_RATE_LOOKUP_TABLE_H */
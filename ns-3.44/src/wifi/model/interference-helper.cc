@@ -187,10 +187,6 @@ void
 InterferenceHelper::DoDispose()
 {
     NS_LOG_FUNCTION(this);
-    for (auto it : m_niChanges)
-    {
-        it.second.clear();
-    }
     m_niChanges.clear();
     m_firstPowers.clear();
     m_errorRateModel = nullptr;
@@ -344,12 +340,25 @@ InterferenceHelper::GetEnergyDuration(Watt_u energy, const WifiSpectrumBandInfo&
     return end > now ? end - now : Time{0};
 }
 
+InterferenceHelper::NiChangesSpanGuard::NiChangesSpanGuard(const InterferenceHelper& helper)
+    : m_helper(helper)
+{
+    ++m_helper.m_nNiChangesSpans;
+}
+
+InterferenceHelper::NiChangesSpanGuard::~NiChangesSpanGuard()
+{
+    NS_ASSERT(m_helper.m_nNiChangesSpans > 0);
+    --m_helper.m_nNiChangesSpans;
+}
+
 void
 InterferenceHelper::AppendEvent(Ptr<Event> event,
                                 const FrequencyRange& freqRange,
                                 bool isStartHePortionRxing)
 {
     NS_LOG_FUNCTION(this << event << freqRange << isStartHePortionRxing);
+    NS_ASSERT_MSG(m_nNiChangesSpans == 0, "Cannot append an event while NiChanges are viewed");
     for (const auto& [band, power] : event->GetRxPowerPerBand())
     {
         auto niIt = m_niChanges.find(band);
@@ -372,10 +381,12 @@ InterferenceHelper::AppendEvent(Ptr<Event> event,
             // HE TB PPDU transmission and the start of HE TB payload.
             m_firstPowers.find(band)->second = previousPowerStart;
         }
-        auto first =
-            AddNiChangeEvent(event->GetStartTime(), NiChange(previousPowerStart, event), niIt);
+        const auto first = std::distance(
+            niIt->second.begin(),
+            AddNiChangeEvent(event->GetStartTime(), NiChange(previousPowerStart, event), niIt));
+        // adding the NiChange at the end invalidates the iterator to the one at the start
         auto last = AddNiChangeEvent(event->GetEndTime(), NiChange(previousPowerEnd, event), niIt);
-        for (auto i = first; i != last; ++i)
+        for (auto i = niIt->second.begin() + first; i != last; ++i)
         {
             i->second.AddPower(power);
         }
@@ -435,7 +446,7 @@ InterferenceHelper::CalculateSnr(Watt_u signal,
 
 Watt_u
 InterferenceHelper::CalculateNoiseInterferenceW(Ptr<Event> event,
-                                                NiChangesPerBand& nis,
+                                                NiChangesSpan& nis,
                                                 const WifiSpectrumBandInfo& band) const
 {
     NS_LOG_FUNCTION(this << band);
@@ -444,12 +455,23 @@ InterferenceHelper::CalculateNoiseInterferenceW(Ptr<Event> event,
     auto noiseInterference = firstPower_it->second;
     auto niIt = m_niChanges.find(band);
     NS_ABORT_IF(niIt == m_niChanges.end());
+    const auto& niChanges = niIt->second;
     const auto now = Simulator::Now();
-    auto it = niIt->second.find(event->GetStartTime());
+    // the first NiChange at the start of the event, if any
+    auto start = std::lower_bound(niChanges.cbegin(),
+                                  niChanges.cend(),
+                                  event->GetStartTime(),
+                                  [](const auto& change, Time moment) {
+                                      return change.first < moment;
+                                  });
+    if (start != niChanges.cend() && start->first != event->GetStartTime())
+    {
+        start = niChanges.cend();
+    }
     const auto muMimoPower = (event->GetPpdu()->GetType() == WIFI_PPDU_TYPE_UL_MU)
                                  ? CalculateMuMimoPowerW(event, band)
                                  : Watt_u{0.0};
-    for (; it != niIt->second.end() && it->first < now; ++it)
+    for (auto it = start; it != niChanges.cend() && it->first < now; ++it)
     {
         if (IsSameMuMimoTransmission(event, it->second.GetEvent()) &&
             (event != it->second.GetEvent()))
@@ -465,20 +487,18 @@ InterferenceHelper::CalculateNoiseInterferenceW(Ptr<Event> event,
             noiseInterference = Watt_u{0.0};
         }
     }
-    it = niIt->second.find(event->GetStartTime());
-    NS_ABORT_IF(it == niIt->second.end());
-    for (; it != niIt->second.end() && it->second.GetEvent() != event; ++it)
-    {
-        ;
-    }
-    NiChanges ni;
-    ni.emplace(event->GetStartTime(), NiChange(Watt_u{0}, event));
-    while (++it != niIt->second.end() && it->second.GetEvent() != event)
-    {
-        ni.insert(*it);
-    }
-    ni.emplace(event->GetEndTime(), NiChange(Watt_u{0}, event));
-    nis.insert({band, ni});
+    NS_ABORT_IF(start == niChanges.cend());
+    start = std::find_if(start, niChanges.cend(), [&event](const auto& change) {
+        return change.second.GetEvent() == event;
+    });
+    NS_ABORT_IF(start == niChanges.cend());
+    const auto end = std::find_if(std::next(start), niChanges.cend(), [&event](const auto& change) {
+        return change.second.GetEvent() == event;
+    });
+    NS_ABORT_IF(end == niChanges.cend());
+    // the span stays valid as long as the caller holds a NiChangesSpanGuard
+    NS_ASSERT(m_nNiChangesSpans > 0);
+    nis = NiChangesSpan(start, std::next(end));
     NS_ASSERT_MSG(noiseInterference >= Watt_u{0.0},
                   "CalculateNoiseInterferenceW returns negative value " << noiseInterference);
     return noiseInterference;
@@ -497,7 +517,7 @@ InterferenceHelper::CalculateMuMimoPowerW(Ptr<const Event> event,
     {
         if (IsSameMuMimoTransmission(event, it->second.GetEvent()))
         {
-            auto hePpdu = DynamicCast<HePpdu>(it->second.GetEvent()->GetPpdu()->Copy());
+            auto hePpdu = DynamicCast<const HePpdu>(it->second.GetEvent()->GetPpdu());
             NS_ASSERT(hePpdu);
             HePpdu::TxPsdFlag psdFlag = hePpdu->GetTxPsdFlag();
             if (psdFlag == HePpdu::PSD_HE_PORTION)
@@ -567,15 +587,14 @@ InterferenceHelper::CalculatePayloadChunkSuccessRate(double snir,
 double
 InterferenceHelper::CalculatePayloadPer(Ptr<const Event> event,
                                         MHz_u channelWidth,
-                                        NiChangesPerBand* nis,
+                                        NiChangesSpan nis,
                                         const WifiSpectrumBandInfo& band,
                                         uint16_t staId,
                                         std::pair<Time, Time> window) const
 {
     NS_LOG_FUNCTION(this << channelWidth << band << staId << window.first << window.second);
     double psr = 1.0; /* Packet Success Rate */
-    const auto& niIt = nis->find(band)->second;
-    auto j = niIt.cbegin();
+    auto j = nis.begin();
     auto previous = j->first;
     Watt_u muMimoPower{0.0};
     const auto payloadMode = event->GetPpdu()->GetTxVector().GetMode(staId);
@@ -596,7 +615,7 @@ InterferenceHelper::CalculatePayloadPer(Ptr<const Event> event,
     NS_ABORT_IF(!m_firstPowers.contains(band));
     auto noiseInterference = m_firstPowers.at(band);
     auto power = event->GetRxPower(band);
-    while (++j != niIt.cend())
+    while (++j != nis.end())
     {
         Time current = j->first;
         NS_LOG_DEBUG("previous= " << previous << ", current=" << current);
@@ -648,15 +667,14 @@ InterferenceHelper::CalculatePayloadPer(Ptr<const Event> event,
 double
 InterferenceHelper::CalculatePhyHeaderSectionPsr(
     Ptr<const Event> event,
-    NiChangesPerBand* nis,
+    NiChangesSpan nis,
     MHz_u channelWidth,
     const WifiSpectrumBandInfo& band,
     PhyEntity::PhyHeaderSections phyHeaderSections) const
 {
     NS_LOG_FUNCTION(this << band);
     double psr = 1.0; /* Packet Success Rate */
-    auto niIt = nis->find(band)->second;
-    auto j = niIt.begin();
+    auto j = nis.begin();
 
     NS_ASSERT(!phyHeaderSections.empty());
     Time stopLastSection;
@@ -669,7 +687,7 @@ InterferenceHelper::CalculatePhyHeaderSectionPsr(
     NS_ABORT_IF(!m_firstPowers.contains(band));
     auto noiseInterference = m_firstPowers.at(band);
     const auto power = event->GetRxPower(band);
-    while (++j != niIt.end())
+    while (++j != nis.end())
     {
         auto current = j->first;
         NS_LOG_DEBUG("previous= " << previous << ", current=" << current);
@@ -711,19 +729,18 @@ InterferenceHelper::CalculatePhyHeaderSectionPsr(
 
 double
 InterferenceHelper::CalculatePhyHeaderPer(Ptr<const Event> event,
-                                          NiChangesPerBand* nis,
+                                          NiChangesSpan nis,
                                           MHz_u channelWidth,
                                           const WifiSpectrumBandInfo& band,
                                           WifiPpduField header) const
 {
     NS_LOG_FUNCTION(this << band << header);
-    auto niIt = nis->find(band)->second;
     auto phyEntity =
         WifiPhy::GetStaticPhyEntity(event->GetPpdu()->GetTxVector().GetModulationClass());
 
     PhyEntity::PhyHeaderSections sections;
     for (const auto& section :
-         phyEntity->GetPhyHeaderSections(event->GetPpdu()->GetTxVector(), niIt.begin()->first))
+         phyEntity->GetPhyHeaderSections(event->GetPpdu()->GetTxVector(), nis.front().first))
     {
         if (section.first == header)
         {
@@ -748,7 +765,8 @@ InterferenceHelper::CalculatePayloadSnrPer(Ptr<Event> event,
 {
     NS_LOG_FUNCTION(this << channelWidth << band << staId << relativeMpduStartStop.first
                          << relativeMpduStartStop.second);
-    NiChangesPerBand ni;
+    NiChangesSpanGuard guard(*this);
+    NiChangesSpan ni;
     const auto noiseInterference = CalculateNoiseInterferenceW(event, ni, band);
     const auto snr = CalculateSnr(event->GetRxPower(band),
                                   noiseInterference,
@@ -759,7 +777,7 @@ InterferenceHelper::CalculatePayloadSnrPer(Ptr<Event> event,
      * all SNIR changes in the SNIR vector.
      */
     const auto per =
-        CalculatePayloadPer(event, channelWidth, &ni, band, staId, relativeMpduStartStop);
+        CalculatePayloadPer(event, channelWidth, ni, band, staId, relativeMpduStartStop);
 
     return PhyEntity::SnrPer(snr, per);
 }
@@ -770,7 +788,8 @@ InterferenceHelper::CalculateSnr(Ptr<Event> event,
                                  uint8_t nss,
                                  const WifiSpectrumBandInfo& band) const
 {
-    NiChangesPerBand ni;
+    NiChangesSpanGuard guard(*this);
+    NiChangesSpan ni;
     const auto noiseInterference = CalculateNoiseInterferenceW(event, ni, band);
     return CalculateSnr(event->GetRxPower(band), noiseInterference, channelWidth, nss);
 }
@@ -782,14 +801,15 @@ InterferenceHelper::CalculatePhyHeaderSnrPer(Ptr<Event> event,
                                              WifiPpduField header) const
 {
     NS_LOG_FUNCTION(this << band << header);
-    NiChangesPerBand ni;
+    NiChangesSpanGuard guard(*this);
+    NiChangesSpan ni;
     const auto noiseInterference = CalculateNoiseInterferenceW(event, ni, band);
     const auto snr = CalculateSnr(event->GetRxPower(band), noiseInterference, channelWidth, 1);
 
     /* calculate the SNIR at the start of the PHY header and accumulate
      * all SNIR changes in the SNIR vector.
      */
-    const auto per = CalculatePhyHeaderPer(event, &ni, channelWidth, band, header);
+    const auto per = CalculatePhyHeaderPer(event, ni, channelWidth, band, header);
 
     return PhyEntity::SnrPer(snr, per);
 }
@@ -797,7 +817,10 @@ InterferenceHelper::CalculatePhyHeaderSnrPer(Ptr<Event> event,
 InterferenceHelper::NiChanges::iterator
 InterferenceHelper::GetNextPosition(Time moment, NiChangesPerBand::iterator niIt)
 {
-    return niIt->second.upper_bound(moment);
+    return std::upper_bound(niIt->second.begin(),
+                            niIt->second.end(),
+                            moment,
+                            [](Time moment, const auto& change) { return moment < change.first; });
 }
 
 InterferenceHelper::NiChanges::iterator
@@ -813,6 +836,7 @@ InterferenceHelper::GetPreviousPosition(Time moment, NiChangesPerBand::iterator
 InterferenceHelper::NiChanges::iterator
 InterferenceHelper::AddNiChangeEvent(Time moment, NiChange change, NiChangesPerBand::iterator niIt)
 {
+    NS_ASSERT_MSG(m_nNiChangesSpans == 0, "Cannot add a NiChange while NiChanges are viewed");
     return niIt->second.insert(GetNextPosition(moment, niIt), {moment, change});
 }
 
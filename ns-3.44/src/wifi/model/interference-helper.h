@@ -13,6 +13,9 @@
 
 #include "ns3/object.h"
 
+#include <span>
+#include <vector>
+
 namespace ns3
 {
 
@@ -391,9 +394,18 @@ class InterferenceHelper : public Object
     };
 
     /**
-     * typedef for a multimap of NiChange
+     * typedef for a vector of NiChange, sorted by time. The NiChanges at the
+     * same time are kept in the order they were added.
      */
-    using NiChanges = std::multimap<Time, NiChange>;
+    using NiChanges = std::vector<std::pair<Time, NiChange>>;
+
+    /**
+     * The NiChanges of a band during an event, from the NiChange at the start
+     * of the event to the NiChange at the end of the event. A span is a view into
+     * m_niChanges and is invalidated when a NiChange is added or removed, hence it
+     * must only be used while a NiChangesSpanGuard is alive.
+     */
+    using NiChangesSpan = std::span<const NiChanges::value_type>;
 
     /**
      * Map of NiChanges per band
@@ -407,6 +419,42 @@ class InterferenceHelper : public Object
 
     NiChangesPerBand m_niChanges; //!< NI Changes for each band
 
+    /**
+     * Scoped guard that marks the NiChanges as being viewed by a NiChangesSpan, so that
+     * adding or removing a NiChange while the span is in use triggers an assert.
+     */
+    class NiChangesSpanGuard
+    {
+      public:
+        /**
+         * Constructor
+         *
+         * @param helper the interference helper whose NiChanges are viewed
+         */
+        NiChangesSpanGuard(const InterferenceHelper& helper);
+        ~NiChangesSpanGuard();
+
+        NiChangesSpanGuard(const NiChangesSpanGuard&) = delete;
+        NiChangesSpanGuard& operator=(const NiChangesSpanGuard&) = delete;
+
+      private:
+        const InterferenceHelper& m_helper; //!< the interference helper
+    };
+
+    /**
+     * Calculate noise and interference power.
+     *
+     * @param event the event
+     * @param nis the NiChanges of the band during the event (the caller must hold a
+     *            NiChangesSpanGuard for as long as the span is used)
+     * @param band the band
+     *
+     * @return noise and interference power
+     */
+    Watt_u CalculateNoiseInterferenceW(Ptr<Event> event,
+                                       NiChangesSpan& nis,
+                                       const WifiSpectrumBandInfo& band) const;
+
   private:
     /**
      * Check whether a given band is tracked by this interference helper.
@@ -436,19 +484,6 @@ class InterferenceHelper : public Object
      */
     void AppendEvent(Ptr<Event> event, const FrequencyRange& freqRange, bool isStartHePortionRxing);
 
-    /**
-     * Calculate noise and interference power.
-     *
-     * @param event the event
-     * @param nis the NiChanges
-     * @param band the band
-     *
-     * @return noise and interference power
-     */
-    Watt_u CalculateNoiseInterferenceW(Ptr<Event> event,
-                                       NiChangesPerBand& nis,
-                                       const WifiSpectrumBandInfo& band) const;
-
     /**
      * Calculate power of all other events preceding a given event that belong to the same MU-MIMO
      * transmission.
@@ -468,7 +503,7 @@ class InterferenceHelper : public Object
      *
      * @param event the event
      * @param channelWidth the channel width used to transmit the PSDU
-     * @param nis the NiChanges
+     * @param nis the NiChanges of the band during the event
      * @param band identify the band used by the PSDU
      * @param staId the station ID of the PSDU (only used for MU)
      * @param window time window (pair of start and end times) of PHY payload to focus on
@@ -477,7 +512,7 @@ class InterferenceHelper : public Object
      */
     double CalculatePayloadPer(Ptr<const Event> event,
                                MHz_u channelWidth,
-                               NiChangesPerBand* nis,
+                               NiChangesSpan nis,
                                const WifiSpectrumBandInfo& band,
                                uint16_t staId,
                                std::pair<Time, Time> window) const;
@@ -486,7 +521,7 @@ class InterferenceHelper : public Object
      * can be divided into multiple chunks (e.g. due to interference from other transmissions).
      *
      * @param event the event
-     * @param nis the NiChanges
+     * @param nis the NiChanges of the band during the event
      * @param channelWidth the channel width for header measurement
      * @param band the band
      * @param header the PHY header to consider
@@ -494,7 +529,7 @@ class InterferenceHelper : public Object
      * @return the error rate of the HT PHY header
      */
     double CalculatePhyHeaderPer(Ptr<const Event> event,
-                                 NiChangesPerBand* nis,
+                                 NiChangesSpan nis,
                                  MHz_u channelWidth,
                                  const WifiSpectrumBandInfo& band,
                                  WifiPpduField header) const;
@@ -502,7 +537,7 @@ class InterferenceHelper : public Object
      * Calculate the success rate of the PHY header sections for the provided event.
      *
      * @param event the event
-     * @param nis the NiChanges
+     * @param nis the NiChanges of the band during the event
      * @param channelWidth the channel width for header measurement
      * @param band the band
      * @param phyHeaderSections the map of PHY header sections (\see PhyEntity::PhyHeaderSections)
@@ -510,7 +545,7 @@ class InterferenceHelper : public Object
      * @return the success rate of the PHY header sections
      */
     double CalculatePhyHeaderSectionPsr(Ptr<const Event> event,
-                                        NiChangesPerBand* nis,
+                                        NiChangesSpan nis,
                                         MHz_u channelWidth,
                                         const WifiSpectrumBandInfo& band,
                                         PhyEntity::PhyHeaderSections phyHeaderSections) const;
@@ -519,6 +554,7 @@ class InterferenceHelper : public Object
     Ptr<ErrorRateModel> m_errorRateModel; //!< error rate model
     uint8_t m_numRxAntennas;         //!< the number of RX antennas in the corresponding receiver
     FirstPowerPerBand m_firstPowers; //!< first power of each band
+    mutable std::size_t m_nNiChangesSpans{0}; //!< number of NiChangesSpanGuard alive
 
     /**
      * Returns an iterator to the first NiChange that is later than moment
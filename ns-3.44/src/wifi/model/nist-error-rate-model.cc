@@ -11,10 +11,15 @@
 
 #include "wifi-tx-vector.h"
 
+#include "ns3/boolean.h"
+#include "ns3/double.h"
 #include "ns3/log.h"
 
+#include <bit>
 #include <bitset>
 #include <cmath>
+#include <map>
+#include <tuple>
 
 namespace ns3
 {
@@ -29,7 +34,24 @@ NistErrorRateModel::GetTypeId()
     static TypeId tid = TypeId("ns3::NistErrorRateModel")
                             .SetParent<ErrorRateModel>()
                             .SetGroupName("Wifi")
-                            .AddConstructor<NistErrorRateModel>();
+                            .AddConstructor<NistErrorRateModel>()
+                            .AddAttribute(
+                                "UseLookupTables",
+                                "If true, the coded bit error rates are interpolated in lookup "
+                                "tables built from the model the first time each constellation "
+                                "size and coding rate is used, instead of being computed for "
+                                "every chunk.",
+                                BooleanValue(false),
+                                MakeBooleanAccessor(&NistErrorRateModel::m_useLookupTables),
+                                MakeBooleanChecker())
+                            .AddAttribute(
+                                "LookupTableMaxError",
+                                "The maximum relative error of the bit error rates interpolated in "
+                                "the lookup tables, checked against the model when the tables are "
+                                "built. It must be set before the model is used.",
+                                DoubleValue(1e-3),
+                                MakeDoubleAccessor(&NistErrorRateModel::m_lookupTableMaxError),
+                                MakeDoubleChecker<double>(0));
     return tid;
 }
 
@@ -37,6 +59,34 @@ NistErrorRateModel::NistErrorRateModel()
 {
 }
 
+const ErrorRateLookupTable&
+NistErrorRateModel::GetLookupTable(uint16_t constellationSize, uint8_t bValue) const
+{
+    auto& table = m_lookupTables.at(std::countr_zero(constellationSize)).at(bValue);
+    if (table)
+    {
+        return *table;
+    }
+    // the tables only depend on the model, hence they are shared by all the instances
+    static std::map<std::tuple<uint16_t, uint8_t, double>, ErrorRateLookupTable> g_lookupTables;
+    const auto key = std::make_tuple(constellationSize, bValue, m_lookupTableMaxError);
+    if (auto it = g_lookupTables.find(key); it != g_lookupTables.end())
+    {
+        table = &it->second;
+        return *table;
+    }
+    NS_LOG_DEBUG("Build the lookup table of " << constellationSize << "-QAM, bValue=" << +bValue);
+    auto errorRate = [this, constellationSize, bValue](double snr) {
+        const auto ber = (constellationSize == 2)   ? GetBpskBer(snr)
+                         : (constellationSize == 4) ? GetQpskBer(snr)
+                                                    : GetQamBer(constellationSize, snr);
+        return (ber == 0.0) ? 0.0 : std::min(CalculatePe(ber, bValue), 1.0);
+    };
+    table = &g_lookupTables.emplace(key, ErrorRateLookupTable(errorRate, m_lookupTableMaxError))
+                  .first->second;
+    return *table;
+}
+
 double
 NistErrorRateModel::GetBpskBer(double snr) const
 {
@@ -74,6 +124,13 @@ double
 NistErrorRateModel::GetFecBpskBer(double snr, uint64_t nbits, uint8_t bValue) const
 {
     NS_LOG_FUNCTION(this << snr << nbits << +bValue);
+    if (m_useLookupTables)
+    {
+        if (const auto pe = GetLookupTable(2, bValue).GetErrorRate(snr))
+        {
+            return std::pow(1 - *pe, nbits);
+        }
+    }
     double ber = GetBpskBer(snr);
     if (ber == 0.0)
     {
@@ -89,6 +146,13 @@ double
 NistErrorRateModel::GetFecQpskBer(double snr, uint64_t nbits, uint8_t bValue) const
 {
     NS_LOG_FUNCTION(this << snr << nbits << +bValue);
+    if (m_useLookupTables)
+    {
+        if (const auto pe = GetLookupTable(4, bValue).GetErrorRate(snr))
+        {
+            return std::pow(1 - *pe, nbits);
+        }
+    }
     double ber = GetQpskBer(snr);
     if (ber == 0.0)
     {
@@ -158,6 +222,13 @@ NistErrorRateModel::GetFecQamBer(uint16_t constellationSize,
                                  uint8_t bValue) const
 {
     NS_LOG_FUNCTION(this << constellationSize << snr << nbits << +bValue);
+    if (m_useLookupTables)
+    {
+        if (const auto pe = GetLookupTable(constellationSize, bValue).GetErrorRate(snr))
+        {
+            return std::pow(1 - *pe, nbits);
+        }
+    }
     double ber = GetQamBer(constellationSize, snr);
     if (ber == 0.0)
     {
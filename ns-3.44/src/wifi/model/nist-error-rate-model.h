@@ -9,9 +9,12 @@
 #ifndef NIST_ERROR_RATE_MODEL_H
 #define NIST_ERROR_RATE_MODEL_H
 
+#include "error-rate-lookup-table.h"
 #include "error-rate-model.h"
 #include "wifi-mode.h"
 
+#include <array>
+
 namespace ns3
 {
 
@@ -22,6 +25,11 @@ namespace ns3
  * the model description and validation can be found in
  * http://www.nsnam.org/~pei/80211ofdm.pdf.  For DSSS modulations (802.11b),
  * the model uses the DsssErrorRateModel.
+ *
+ * When the UseLookupTables attribute is true, the coded bit error rates are
+ * interpolated in lookup tables built from the model the first time each
+ * constellation size and coding rate is used (\see ErrorRateLookupTable).
+ * The tables are shared by all the models using the same maximum error.
  */
 class NistErrorRateModel : public ErrorRateModel
 {
@@ -117,6 +125,24 @@ class NistErrorRateModel : public ErrorRateModel
                         double snr,
                         uint64_t nbits,
                         uint8_t bValue) const;
+    /**
+     * Return the lookup table of the coded BER for the given constellation size and
+     * bValue, which is built if it does not exist yet, and shared by all the models
+     * using the same maximum error.
+     *
+     * @param constellationSize the constellation size (M)
+     * @param bValue the bValue such that coding rate = bValue / (bValue + 1)
+     *
+     * @return the lookup table of the coded BER
+     */
+    const ErrorRateLookupTable& GetLookupTable(uint16_t constellationSize, uint8_t bValue) const;
+
+    bool m_useLookupTables;       //!< whether to interpolate the BER in lookup tables
+    double m_lookupTableMaxError; //!< the maximum relative error of the lookup tables
+
+    /// the lookup tables used by this model, indexed by log2 of the constellation size
+    /// and bValue
+    mutable std::array<std::array<const ErrorRateLookupTable*, 6>, 13> m_lookupTables{};
 };
 
 } // namespace ns3
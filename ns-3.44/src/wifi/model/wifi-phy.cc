@@ -37,6 +37,7 @@
 
 #include <algorithm>
 #include <numeric>
+#include <unordered_map>
 
 #undef NS_LOG_APPEND_CONTEXT
 #define NS_LOG_APPEND_CONTEXT                                                                      \
@@ -50,6 +51,80 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("WifiPhy");
 
+namespace
+{
+
+/**
+ * The parameters determining the duration of a non-MU PPDU carrying a single PSDU
+ */
+struct TxDurationKey
+{
+    uint32_t size;           //!< the size of the PSDU (bytes)
+    uint32_t modeUid;        //!< the UID of the mode
+    WifiPreamble preamble;   //!< the preamble type
+    WifiPhyBand band;        //!< the frequency band
+    MHz_u channelWidth;      //!< the channel width
+    int64_t guardIntervalNs; //!< the guard interval (ns)
+    uint8_t nss;             //!< the number of spatial streams
+    uint8_t ness;            //!< the number of extension spatial streams
+    bool stbc;               //!< whether STBC is used
+
+    /**
+     * @param other the other key
+     * @return true if the two keys are equal
+     */
+    bool operator==(const TxDurationKey& other) const = default;
+};
+
+/**
+ * Hashing functor taking a TxDurationKey and returning a @c std::size_t.
+ */
+struct TxDurationKeyHash
+{
+    /**
+     * The functor.
+     * @param key the key to hash
+     * @return the hash
+     */
+    std::size_t operator()(const TxDurationKey& key) const
+    {
+        auto hash = std::hash<uint64_t>{}((static_cast<uint64_t>(key.size) << 32) | key.modeUid);
+        const auto params = (static_cast<uint64_t>(key.guardIntervalNs) << 40) |
+                            (static_cast<uint64_t>(key.channelWidth) << 24) |
+                            (static_cast<uint64_t>(key.preamble) << 16) |
+                            (static_cast<uint64_t>(key.band) << 8) |
+                            (static_cast<uint64_t>(key.nss) << 4) | (key.ness << 1) | key.stbc;
+        hash ^= std::hash<uint64_t>{}(params) + 0x9e3779b97f4a7c15 + (hash << 6) + (hash >> 2);
+        return hash;
+    }
+};
+
+/// The maximum number of durations stored in the cache of the PPDU durations
+constexpr std::size_t TX_DURATION_CACHE_MAX_SIZE = 4096;
+
+/**
+ * The cache of the PPDU durations computed by WifiPhy::CalculateTxDuration, shared by all
+ * the PHYs since the PPDU durations do not depend on the PHY
+ */
+struct TxDurationCache
+{
+    std::unordered_map<TxDurationKey, Time, TxDurationKeyHash> durations; //!< the durations
+    uint64_t hits{0};   //!< the number of durations found in the cache
+    uint64_t misses{0}; //!< the number of durations not found in the cache
+};
+
+/**
+ * @return the cache of the PPDU durations
+ */
+TxDurationCache&
+GetTxDurationCache()
+{
+    static TxDurationCache g_txDurationCache;
+    return g_txDurationCache;
+}
+
+} // namespace
+
 /****************************************************************
  *       The actual WifiPhy class
  ****************************************************************/
@@ -804,6 +879,8 @@ WifiPhy::AddStaticPhyEntity(WifiModulationClass modulation, Ptr<PhyEntity> phyEn
                   "The PHY entity has already been added. The setting should only be done once per "
                   "modulation class");
     GetStaticPhyEntities()[modulation] = phyEntity;
+    // the cached PPDU durations may have been computed by another PHY entity
+    ClearTxDurationCache();
 }
 
 void
@@ -1589,12 +1666,66 @@ WifiPhy::CalculateTxDuration(uint32_t size,
                              WifiPhyBand band,
                              uint16_t staId)
 {
+    if (txVector.IsMu())
+    {
+        // the duration of MU PPDUs depends on the RUs and the users, hence it is not cached.
+        // EHT SU PPDUs use the EHT MU preamble but are not MU PPDUs, hence they are cached
+        Time duration = CalculatePhyPreambleAndHeaderDuration(txVector) +
+                        GetPayloadDuration(size, txVector, band, NORMAL_MPDU, staId);
+        NS_ASSERT(duration.IsStrictlyPositive());
+        return duration;
+    }
+
+    // the duration of non-MU PPDUs does not depend on the STA-ID
+    const TxDurationKey key{size,
+                            txVector.GetMode().GetUid(),
+                            txVector.GetPreambleType(),
+                            band,
+                            txVector.GetChannelWidth(),
+                            txVector.GetGuardInterval().GetNanoSeconds(),
+                            txVector.GetNss(),
+                            txVector.GetNess(),
+                            txVector.IsStbc()};
+    auto& cache = GetTxDurationCache();
+    if (auto it = cache.durations.find(key); it != cache.durations.end())
+    {
+        ++cache.hits;
+        return it->second;
+    }
+    ++cache.misses;
+
     Time duration = CalculatePhyPreambleAndHeaderDuration(txVector) +
                     GetPayloadDuration(size, txVector, band, NORMAL_MPDU, staId);
     NS_ASSERT(duration.IsStrictlyPositive());
+    if (cache.durations.size() >= TX_DURATION_CACHE_MAX_SIZE)
+    {
+        cache.durations.clear();
+    }
+    cache.durations.emplace(key, duration);
     return duration;
 }
 
+uint64_t
+WifiPhy::GetTxDurationCacheHits()
+{
+    return GetTxDurationCache().hits;
+}
+
+uint64_t
+WifiPhy::GetTxDurationCacheMisses()
+{
+    return GetTxDurationCache().misses;
+}
+
+void
+WifiPhy::ClearTxDurationCache()
+{
+    auto& cache = GetTxDurationCache();
+    cache.durations.clear();
+    cache.hits = 0;
+    cache.misses = 0;
+}
+
 Time
 WifiPhy::CalculateTxDuration(Ptr<const WifiPsdu> psdu,
                              const WifiTxVector& txVector,
@@ -239,6 +239,10 @@ class WifiPhy : public Object
      * @param band the frequency band being used
      * @param staId the STA-ID of the recipient (only used for MU)
      *
+     * The durations of the non-MU PPDUs are stored in a bounded cache shared by all
+     * the PHYs, so that the durations computed repeatedly by the MAC (e.g., for the
+     * NAV, the protection and the aggregation) are only computed once.
+     *
      * @return the total amount of time this PHY will stay busy for the transmission of these bytes.
      */
     static Time CalculateTxDuration(uint32_t size,
@@ -273,6 +277,22 @@ class WifiPhy : public Object
                                     const WifiTxVector& txVector,
                                     WifiPhyBand band);
 
+    /**
+     * @return the number of PPDU durations found in the cache of CalculateTxDuration
+     *         since the cache was last cleared
+     */
+    static uint64_t GetTxDurationCacheHits();
+    /**
+     * @return the number of PPDU durations computed and stored in the cache of
+     *         CalculateTxDuration since the cache was last cleared
+     */
+    static uint64_t GetTxDurationCacheMisses();
+    /**
+     * Remove all the PPDU durations from the cache of CalculateTxDuration and reset
+     * its hit and miss counters.
+     */
+    static void ClearTxDurationCache();
+
     /**
      * @param txVector the transmission parameters used for this packet
      *
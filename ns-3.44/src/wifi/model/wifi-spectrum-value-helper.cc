@@ -79,6 +79,102 @@ operator<(const WifiSpectrumModelId& lhs, const WifiSpectrumModelId& rhs)
 static std::map<WifiSpectrumModelId, Ptr<SpectrumModel>>
     g_wifiSpectrumModelMap; ///< static initializer for the class
 
+///< Wifi transmit PSD structure
+struct WifiTxPsdId
+{
+    /// Function building the transmit PSD
+    enum class Type : uint8_t
+    {
+        DSSS = 0,
+        OFDM,
+        DUPLICATED_20MHZ,
+        HT_OFDM,
+        HE_OFDM
+    };
+
+    Type type;                              ///< function building the transmit PSD
+    std::vector<MHz_u> centerFrequencies;   ///< center frequency per segment
+    MHz_u channelWidth;                     ///< channel width
+    MHz_u guardBandwidth;                   ///< guard band width
+    dBr_u minInnerBand;                     ///< minimum relative power in the inner band
+    dBr_u minOuterBand;                     ///< minimum relative power in the outer band
+    dBr_u lowestPoint;                      ///< maximum relative power of the outermost bands
+    std::vector<bool> puncturedSubchannels; ///< whether each 20 MHz subchannel is punctured
+};
+
+/**
+ * Less than operator
+ * @param lhs the left hand side wifi transmit PSD to compare
+ * @param rhs the right hand side wifi transmit PSD to compare
+ * @returns true if the left hand side transmit PSD is less than the right hand side one
+ */
+bool
+operator<(const WifiTxPsdId& lhs, const WifiTxPsdId& rhs)
+{
+    return std::tie(lhs.type,
+                    lhs.centerFrequencies,
+                    lhs.channelWidth,
+                    lhs.guardBandwidth,
+                    lhs.minInnerBand,
+                    lhs.minOuterBand,
+                    lhs.lowestPoint,
+                    lhs.puncturedSubchannels) < std::tie(rhs.type,
+                                                         rhs.centerFrequencies,
+                                                         rhs.channelWidth,
+                                                         rhs.guardBandwidth,
+                                                         rhs.minInnerBand,
+                                                         rhs.minOuterBand,
+                                                         rhs.lowestPoint,
+                                                         rhs.puncturedSubchannels);
+}
+
+/**
+ * Transmit PSDs already built, along with the transmit power they were built for. The PSDs
+ * are proportional to the transmit power, hence a PSD built once is scaled to any other power.
+ */
+static std::map<WifiTxPsdId, std::pair<Ptr<const SpectrumValue>, Watt_u>> g_wifiTxPsdMap;
+
+/**
+ * Get a copy of a transmit PSD already built, scaled to the given transmit power.
+ *
+ * @param key the parameters of the transmit PSD
+ * @param txPower the transmit power
+ * @return a newly allocated copy of the transmit PSD, or a null pointer if the transmit PSD has
+ *         not been built yet
+ */
+static Ptr<SpectrumValue>
+GetCachedTxPsd(const WifiTxPsdId& key, Watt_u txPower)
+{
+    const auto it = g_wifiTxPsdMap.find(key);
+    if (it == g_wifiTxPsdMap.cend())
+    {
+        return nullptr;
+    }
+    const auto& [cachedPsd, cachedTxPower] = it->second;
+    auto psd = Copy<SpectrumValue>(cachedPsd);
+    if (txPower != cachedTxPower)
+    {
+        *psd *= txPower / cachedTxPower;
+    }
+    return psd;
+}
+
+/**
+ * Store a copy of a transmit PSD, unless it cannot be scaled to other transmit powers.
+ *
+ * @param key the parameters of the transmit PSD
+ * @param psd the transmit PSD
+ * @param txPower the transmit power the transmit PSD was built for
+ */
+static void
+CacheTxPsd(const WifiTxPsdId& key, Ptr<const SpectrumValue> psd, Watt_u txPower)
+{
+    if (txPower > Watt_u{0} && std::isfinite(txPower))
+    {
+        g_wifiTxPsdMap.emplace(key, std::make_pair(Copy<SpectrumValue>(psd), txPower));
+    }
+}
+
 Ptr<SpectrumModel>
 WifiSpectrumValueHelper::GetSpectrumModel(const std::vector<MHz_u>& centerFrequencies,
                                           MHz_u channelWidth,
@@ -162,6 +258,18 @@ WifiSpectrumValueHelper::CreateDsssTxPowerSpectralDensity(MHz_u centerFrequency,
                                                           MHz_u guardBandwidth)
 {
     NS_LOG_FUNCTION(centerFrequency << txPower << +guardBandwidth);
+    const WifiTxPsdId key{WifiTxPsdId::Type::DSSS,
+                          {centerFrequency},
+                          MHz_u{22},
+                          guardBandwidth,
+                          dBr_u{0},
+                          dBr_u{0},
+                          dBr_u{0},
+                          {}};
+    if (auto psd = GetCachedTxPsd(key, txPower))
+    {
+        return psd;
+    }
     MHz_u channelWidth{22}; // DSSS channels are 22 MHz wide
     Hz_u carrierSpacing{312500};
     Ptr<SpectrumValue> c = Create<SpectrumValue>(
@@ -182,6 +290,7 @@ WifiSpectrumValueHelper::CreateDsssTxPowerSpectralDensity(MHz_u centerFrequency,
             *vit = psd;
         }
     }
+    CacheTxPsd(key, c, txPower);
     return c;
 }
 
@@ -196,6 +305,18 @@ WifiSpectrumValueHelper::CreateOfdmTxPowerSpectralDensity(MHz_u centerFrequency,
 {
     NS_LOG_FUNCTION(centerFrequency << channelWidth << txPower << guardBandwidth << minInnerBand
                                     << minOuterBand << lowestPoint);
+    const WifiTxPsdId key{WifiTxPsdId::Type::OFDM,
+                          {centerFrequency},
+                          channelWidth,
+                          guardBandwidth,
+                          minInnerBand,
+                          minOuterBand,
+                          lowestPoint,
+                          {}};
+    if (auto psd = GetCachedTxPsd(key, txPower))
+    {
+        return psd;
+    }
     Hz_u carrierSpacing{0};
     uint32_t innerSlopeWidth = 0;
     switch (static_cast<uint16_t>(channelWidth))
@@ -255,6 +376,7 @@ WifiSpectrumValueHelper::CreateOfdmTxPowerSpectralDensity(MHz_u centerFrequency,
                               lowestPoint);
     NormalizeSpectrumMask(c, txPower);
     NS_ASSERT_MSG(std::abs(txPower - Integral(*c)) < 1e-6, "Power allocation failed");
+    CacheTxPsd(key, c, txPower);
     return c;
 }
 
@@ -276,6 +398,18 @@ WifiSpectrumValueHelper::CreateDuplicated20MhzTxPowerSpectralDensity(
     NS_LOG_FUNCTION(printFrequencies(centerFrequencies)
                     << channelWidth << txPower << guardBandwidth << minInnerBand << minOuterBand
                     << lowestPoint);
+    const WifiTxPsdId key{WifiTxPsdId::Type::DUPLICATED_20MHZ,
+                          centerFrequencies,
+                          channelWidth,
+                          guardBandwidth,
+                          minInnerBand,
+                          minOuterBand,
+                          lowestPoint,
+                          puncturedSubchannels};
+    if (auto psd = GetCachedTxPsd(key, txPower))
+    {
+        return psd;
+    }
     const Hz_u carrierSpacing{312500};
     Ptr<SpectrumValue> c = Create<SpectrumValue>(
         GetSpectrumModel(centerFrequencies, channelWidth, carrierSpacing, guardBandwidth));
@@ -361,6 +495,7 @@ WifiSpectrumValueHelper::CreateDuplicated20MhzTxPowerSpectralDensity(
                               puncturedSlopeWidth);
     NormalizeSpectrumMask(c, txPower);
     NS_ASSERT_MSG(std::abs(txPower - Integral(*c)) < 1e-6, "Power allocation failed");
+    CacheTxPsd(key, c, txPower);
     return c;
 }
 
@@ -381,6 +516,18 @@ WifiSpectrumValueHelper::CreateHtOfdmTxPowerSpectralDensity(
     NS_LOG_FUNCTION(printFrequencies(centerFrequencies)
                     << channelWidth << txPower << guardBandwidth << minInnerBand << minOuterBand
                     << lowestPoint);
+    const WifiTxPsdId key{WifiTxPsdId::Type::HT_OFDM,
+                          centerFrequencies,
+                          channelWidth,
+                          guardBandwidth,
+                          minInnerBand,
+                          minOuterBand,
+                          lowestPoint,
+                          {}};
+    if (auto psd = GetCachedTxPsd(key, txPower))
+    {
+        return psd;
+    }
     const Hz_u carrierSpacing{312500};
     Ptr<SpectrumValue> c = Create<SpectrumValue>(
         GetSpectrumModel(centerFrequencies, channelWidth, carrierSpacing, guardBandwidth));
@@ -451,6 +598,7 @@ WifiSpectrumValueHelper::CreateHtOfdmTxPowerSpectralDensity(
                               lowestPoint);
     NormalizeSpectrumMask(c, txPower);
     NS_ASSERT_MSG(std::abs(txPower - Integral(*c)) < 1e-6, "Power allocation failed");
+    CacheTxPsd(key, c, txPower);
     return c;
 }
 
@@ -492,6 +640,18 @@ WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity(
     NS_LOG_FUNCTION(printFrequencies(centerFrequencies)
                     << channelWidth << txPower << guardBandwidth << minInnerBand << minOuterBand
                     << lowestPoint);
+    const WifiTxPsdId key{WifiTxPsdId::Type::HE_OFDM,
+                          centerFrequencies,
+                          channelWidth,
+                          guardBandwidth,
+                          minInnerBand,
+                          minOuterBand,
+                          lowestPoint,
+                          puncturedSubchannels};
+    if (auto psd = GetCachedTxPsd(key, txPower))
+    {
+        return psd;
+    }
     const Hz_u carrierSpacing{78125};
     Ptr<SpectrumValue> c = Create<SpectrumValue>(
         GetSpectrumModel(centerFrequencies, channelWidth, carrierSpacing, guardBandwidth));
@@ -643,6 +803,7 @@ WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity(
                               puncturedSlopeWidth);
     NormalizeSpectrumMask(c, txPower);
     NS_ASSERT_MSG(std::abs(txPower - Integral(*c)) < 1e-6, "Power allocation failed");
+    CacheTxPsd(key, c, txPower);
     return c;
 }
 
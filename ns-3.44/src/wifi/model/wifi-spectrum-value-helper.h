@@ -31,6 +31,11 @@ using WifiSpectrumBandIndices = std::pair<uint32_t, uint32_t>;
  *  This class defines all functions to create a spectrum model for
  *  Wi-Fi based on a a spectral model aligned with an OFDM subcarrier
  *  spacing of 312.5 KHz (model also reused for DSSS modulations)
+ *
+ *  The transmit power spectral densities of the DSSS, OFDM, HT and HE
+ *  transmissions are only built once per set of parameters other than
+ *  the transmit power: the following calls return a copy of the stored
+ *  PSD, scaled to the requested transmit power.
  */
 class WifiSpectrumValueHelper
 {
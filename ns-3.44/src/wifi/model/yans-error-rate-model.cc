@@ -12,9 +12,14 @@
 #include "wifi-tx-vector.h"
 #include "wifi-utils.h"
 
+#include "ns3/boolean.h"
+#include "ns3/double.h"
 #include "ns3/log.h"
 
+#include <bit>
 #include <cmath>
+#include <map>
+#include <tuple>
 
 namespace ns3
 {
@@ -29,7 +34,24 @@ YansErrorRateModel::GetTypeId()
     static TypeId tid = TypeId("ns3::YansErrorRateModel")
                             .SetParent<ErrorRateModel>()
                             .SetGroupName("Wifi")
-                            .AddConstructor<YansErrorRateModel>();
+                            .AddConstructor<YansErrorRateModel>()
+                            .AddAttribute(
+                                "UseLookupTables",
+                                "If true, the coded bit error rates of the OFDM modulations are "
+                                "interpolated in lookup tables built from the model the first "
+                                "time each modulation and code is used, instead of being computed "
+                                "for every chunk.",
+                                BooleanValue(false),
+                                MakeBooleanAccessor(&YansErrorRateModel::m_useLookupTables),
+                                MakeBooleanChecker())
+                            .AddAttribute(
+                                "LookupTableMaxError",
+                                "The maximum relative error of the bit error rates interpolated in "
+                                "the lookup tables, checked against the model when the tables are "
+                                "built. It must be set before the model is used.",
+                                DoubleValue(1e-3),
+                                MakeDoubleAccessor(&YansErrorRateModel::m_lookupTableMaxError),
+                                MakeDoubleChecker<double>(0));
     return tid;
 }
 
@@ -37,6 +59,48 @@ YansErrorRateModel::YansErrorRateModel()
 {
 }
 
+const ErrorRateLookupTable&
+YansErrorRateModel::GetLookupTable(uint32_t m,
+                                   uint32_t dFree,
+                                   uint32_t adFree,
+                                   uint32_t adFreePlusOne) const
+{
+    auto& table = m_lookupTables.at(std::countr_zero(m)).at(dFree);
+    if (table)
+    {
+        return *table;
+    }
+    // the tables only depend on the model, hence they are shared by all the instances
+    static std::map<std::tuple<uint32_t, uint32_t, uint32_t, uint32_t, double>,
+                    ErrorRateLookupTable>
+        g_lookupTables;
+    const auto key = std::make_tuple(m, dFree, adFree, adFreePlusOne, m_lookupTableMaxError);
+    if (auto it = g_lookupTables.find(key); it != g_lookupTables.end())
+    {
+        table = &it->second;
+        return *table;
+    }
+    NS_LOG_DEBUG("Build the lookup table of m=" << m << ", dFree=" << dFree);
+    auto errorRate = [this, m, dFree, adFree, adFreePlusOne](double ebNo) {
+        // the SNR equals Eb/No for a 1 MHz signal spread at 1 Mb/s
+        const auto ber = (m == 2) ? GetBpskBer(ebNo, MHz_u{1}, 1000000)
+                                  : GetQamBer(ebNo, m, MHz_u{1}, 1000000);
+        if (ber == 0.0)
+        {
+            return 0.0;
+        }
+        auto pmu = adFree * CalculatePd(ber, dFree);
+        if (m != 2)
+        {
+            pmu += adFreePlusOne * CalculatePd(ber, dFree + 1);
+        }
+        return std::min(pmu, 1.0);
+    };
+    table = &g_lookupTables.emplace(key, ErrorRateLookupTable(errorRate, m_lookupTableMaxError))
+                  .first->second;
+    return *table;
+}
+
 double
 YansErrorRateModel::GetBpskBer(double snr, MHz_u signalSpread, uint64_t phyRate) const
 {
@@ -142,6 +206,14 @@ YansErrorRateModel::GetFecBpskBer(double snr,
                                   uint32_t adFree) const
 {
     NS_LOG_FUNCTION(this << snr << nbits << signalSpread << phyRate << dFree << adFree);
+    if (m_useLookupTables)
+    {
+        const auto ebNo = snr * signalSpread * 1e6 / phyRate;
+        if (const auto pmu = GetLookupTable(2, dFree, adFree, 0).GetErrorRate(ebNo))
+        {
+            return std::pow(1 - *pmu, nbits);
+        }
+    }
     double ber = GetBpskBer(snr, signalSpread, phyRate);
     if (ber == 0.0)
     {
@@ -166,6 +238,14 @@ YansErrorRateModel::GetFecQamBer(double snr,
 {
     NS_LOG_FUNCTION(this << snr << nbits << signalSpread << phyRate << m << dFree << adFree
                          << adFreePlusOne);
+    if (m_useLookupTables)
+    {
+        const auto ebNo = snr * signalSpread * 1e6 / phyRate;
+        if (const auto pmu = GetLookupTable(m, dFree, adFree, adFreePlusOne).GetErrorRate(ebNo))
+        {
+            return std::pow(1 - *pmu, nbits);
+        }
+    }
     double ber = GetQamBer(snr, m, signalSpread, phyRate);
     if (ber == 0.0)
     {
@@ -9,8 +9,11 @@
 #ifndef YANS_ERROR_RATE_MODEL_H
 #define YANS_ERROR_RATE_MODEL_H
 
+#include "error-rate-lookup-table.h"
 #include "error-rate-model.h"
 
+#include <array>
+
 namespace ns3
 {
 
@@ -38,6 +41,12 @@ namespace ns3
  *      57(2):440-449, February 2009.
  *    - More detailed description and validation can be found in
  *      http://www.nsnam.org/~pei/80211b.pdf
+ *
+ * When the UseLookupTables attribute is true, the coded bit error rates of the
+ * OFDM modulations are interpolated in lookup tables of Eb/No built from the
+ * model the first time each modulation and convolutional code is used
+ * (\see ErrorRateLookupTable). The tables are shared by all the models using
+ * the same maximum error.
  */
 class YansErrorRateModel : public ErrorRateModel
 {
@@ -154,6 +163,29 @@ class YansErrorRateModel : public ErrorRateModel
                         uint32_t dfree,
                         uint32_t adFree,
                         uint32_t adFreePlusOne) const;
+    /**
+     * Return the lookup table of the coded BER as a function of Eb/No for the given
+     * modulation and code, which is built if it does not exist yet, and shared by all
+     * the models using the same maximum error.
+     *
+     * @param m the constellation size, 2 for BPSK
+     * @param dFree the free distance of the code
+     * @param adFree the number of error events at the free distance
+     * @param adFreePlusOne the number of error events at the free distance plus one
+     *
+     * @return the lookup table of the coded BER
+     */
+    const ErrorRateLookupTable& GetLookupTable(uint32_t m,
+                                               uint32_t dFree,
+                                               uint32_t adFree,
+                                               uint32_t adFreePlusOne) const;
+
+    bool m_useLookupTables;       //!< whether to interpolate the BER in lookup tables
+    double m_lookupTableMaxError; //!< the maximum relative error of the lookup tables
+
+    /// the lookup tables used by this model, indexed by log2 of the constellation size
+    /// and the free distance of the code, which identifies the code
+    mutable std::array<std::array<const ErrorRateLookupTable*, 11>, 13> m_lookupTables{};
 };
 
 } // namespace ns3
@@ -14,6 +14,8 @@
 #include "wifi-utils.h"
 #include "yans-wifi-phy.h"
 
+#include "ns3/boolean.h"
+#include "ns3/double.h"
 #include "ns3/log.h"
 #include "ns3/mobility-model.h"
 #include "ns3/node.h"
@@ -22,6 +24,10 @@
 #include "ns3/propagation-loss-model.h"
 #include "ns3/simulator.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 namespace ns3
 {
 
@@ -46,11 +52,26 @@ YansWifiChannel::GetTypeId()
                           "A pointer to the propagation delay model attached to this channel.",
                           PointerValue(),
                           MakePointerAccessor(&YansWifiChannel::m_delay),
-                          MakePointerChecker<PropagationDelayModel>());
+                          MakePointerChecker<PropagationDelayModel>())
+            .AddAttribute("EnableSpatialIndex",
+                          "If true, only the PHYs within the maximum range given by the "
+                          "propagation loss model are evaluated when a PPDU is sent, using a "
+                          "grid of the positions of the PHYs.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&YansWifiChannel::m_enableSpatialIndex),
+                          MakeBooleanChecker())
+            .AddAttribute("SpatialIndexCellSize",
+                          "The size (in meters) of the cells of the grid of the positions of "
+                          "the PHYs, which should be close to the maximum range.",
+                          DoubleValue(100),
+                          MakeDoubleAccessor(&YansWifiChannel::m_cellSize),
+                          MakeDoubleChecker<double>(1));
     return tid;
 }
 
 YansWifiChannel::YansWifiChannel()
+    : m_indexBuilt(false),
+      m_minRxThreshold(0)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -81,42 +102,98 @@ YansWifiChannel::Send(Ptr<YansWifiPhy> sender, Ptr<const WifiPpdu> ppdu, dBm_u t
     NS_LOG_FUNCTION(this << sender << ppdu << txPower);
     Ptr<MobilityModel> senderMobility = sender->GetMobility();
     NS_ASSERT(senderMobility);
-    for (auto i = m_phyList.begin(); i != m_phyList.end(); i++)
+    if (m_enableSpatialIndex && FindCandidates(senderMobility, ppdu, txPower))
     {
-        if (sender != (*i))
+        for (auto index : m_candidates)
         {
-            // For now don't account for inter channel interference nor channel bonding
-            if ((*i)->GetChannelNumber() != sender->GetChannelNumber())
-            {
-                continue;
-            }
-
-            auto receiverMobility = (*i)->GetMobility()->GetObject<MobilityModel>();
-            const auto delay = m_delay->GetDelay(senderMobility, receiverMobility);
-            const dBm_u rxPower{m_loss->CalcRxPower(txPower, senderMobility, receiverMobility)};
-            NS_LOG_DEBUG("propagation: txPower="
-                         << txPower << "dBm, rxPower=" << rxPower << "dBm, "
-                         << "distance=" << senderMobility->GetDistanceFrom(receiverMobility)
-                         << "m, delay=" << delay);
-            auto dstNetDevice = (*i)->GetDevice();
-            uint32_t dstNode;
-            if (!dstNetDevice)
-            {
-                dstNode = 0xffffffff;
-            }
-            else
-            {
-                dstNode = dstNetDevice->GetNode()->GetId();
-            }
-
-            Simulator::ScheduleWithContext(dstNode,
-                                           delay,
-                                           &YansWifiChannel::Receive,
-                                           (*i),
-                                           ppdu,
-                                           rxPower);
+            SendTo(sender, senderMobility, m_phyList[index], ppdu, txPower);
         }
+        return;
+    }
+    for (const auto& phy : m_phyList)
+    {
+        SendTo(sender, senderMobility, phy, ppdu, txPower);
+    }
+}
+
+void
+YansWifiChannel::SendTo(Ptr<YansWifiPhy> sender,
+                        Ptr<MobilityModel> senderMobility,
+                        Ptr<YansWifiPhy> receiver,
+                        Ptr<const WifiPpdu> ppdu,
+                        dBm_u txPower) const
+{
+    if (sender == receiver)
+    {
+        return;
+    }
+    // For now don't account for inter channel interference nor channel bonding
+    if (receiver->GetChannelNumber() != sender->GetChannelNumber())
+    {
+        return;
     }
+
+    auto receiverMobility = receiver->GetMobility()->GetObject<MobilityModel>();
+    const auto delay = m_delay->GetDelay(senderMobility, receiverMobility);
+    const dBm_u rxPower{m_loss->CalcRxPower(txPower, senderMobility, receiverMobility)};
+    NS_LOG_DEBUG("propagation: txPower="
+                 << txPower << "dBm, rxPower=" << rxPower << "dBm, "
+                 << "distance=" << senderMobility->GetDistanceFrom(receiverMobility)
+                 << "m, delay=" << delay);
+    auto dstNetDevice = receiver->GetDevice();
+    uint32_t dstNode;
+    if (!dstNetDevice)
+    {
+        dstNode = 0xffffffff;
+    }
+    else
+    {
+        dstNode = dstNetDevice->GetNode()->GetId();
+    }
+
+    Simulator::ScheduleWithContext(dstNode,
+                                   delay,
+                                   &YansWifiChannel::Receive,
+                                   receiver,
+                                   ppdu,
+                                   rxPower);
+}
+
+bool
+YansWifiChannel::FindCandidates(Ptr<MobilityModel> senderMobility,
+                                Ptr<const WifiPpdu> ppdu,
+                                dBm_u txPower) const
+{
+    NS_LOG_FUNCTION(this << senderMobility << ppdu << txPower);
+    if (!m_indexBuilt)
+    {
+        NS_LOG_LOGIC("Build the spatial index of " << m_phyList.size() << " PHYs");
+        m_grid.Clear();
+        m_grid.SetCellSize(m_cellSize);
+        m_minRxThreshold = std::numeric_limits<double>::infinity();
+        for (std::size_t index = 0; index < m_phyList.size(); index++)
+        {
+            const auto& phy = m_phyList[index];
+            m_minRxThreshold =
+                std::min(m_minRxThreshold, phy->GetRxSensitivity() - phy->GetRxGain());
+            NS_ASSERT_MSG(phy->GetMobility(), "The PHYs need a mobility model");
+            m_grid.Add(index, phy->GetMobility());
+        }
+        m_indexBuilt = true;
+    }
+
+    // The receivers drop the signals below this power (see Receive)
+    const auto threshold = m_minRxThreshold + RatioToDb(ppdu->GetTxChannelWidth() / MHz_u{20});
+    auto range = m_loss->CalcMaxRange(txPower, threshold);
+    if (!std::isfinite(range))
+    {
+        NS_LOG_LOGIC("The propagation loss model does not bound the range");
+        return false;
+    }
+    range *= 1 + 1e-9; // absorb the rounding errors of the propagation loss model
+
+    m_candidates.clear();
+    return m_grid.Find(senderMobility->GetPosition(), range, m_candidates);
 }
 
 void
@@ -158,6 +235,7 @@ YansWifiChannel::Add(Ptr<YansWifiPhy> phy)
 {
     NS_LOG_FUNCTION(this << phy);
     m_phyList.push_back(phy);
+    m_indexBuilt = false;
 }
 
 int64_t
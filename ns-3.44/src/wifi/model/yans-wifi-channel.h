@@ -12,6 +12,9 @@
 #include "wifi-units.h"
 
 #include "ns3/channel.h"
+#include "ns3/mobility-grid.h"
+
+#include <vector>
 
 namespace ns3
 {
@@ -32,6 +35,15 @@ class WifiPpdu;
  * class and supports an ns3::PropagationLossModel and an
  * ns3::PropagationDelayModel.  By default, no propagation models are set;
  * it is the caller's responsibility to set them before using the channel.
+ *
+ * When the EnableSpatialIndex attribute is set, the channel keeps the PHYs
+ * in a MobilityGrid, and only evaluates the receivers located within
+ * the range given by PropagationLossModel::CalcMaxRange for the lowest
+ * reception threshold of the PHYs. The other receivers would have dropped
+ * the signal as too weak to process, so that the simulation results do not
+ * change, except that their SignalArrival trace is not fired. The receive
+ * thresholds (RxSensitivity and RxGain) of the PHYs are read when the
+ * first PPDU is sent after a PHY is added to the channel.
  */
 class YansWifiChannel : public Channel
 {
@@ -104,9 +116,45 @@ class YansWifiChannel : public Channel
      */
     static void Receive(Ptr<YansWifiPhy> receiver, Ptr<const WifiPpdu> ppdu, dBm_u txPower);
 
+    /**
+     * Compute the propagation loss and delay from the sender to a receiver,
+     * and schedule the reception of the PPDU.
+     *
+     * @param sender the PHY object from which the packet is originating
+     * @param senderMobility the mobility model of the sender
+     * @param receiver the PHY object to which the packet is sent
+     * @param ppdu the PPDU to send
+     * @param txPower the TX power associated to the packet
+     */
+    void SendTo(Ptr<YansWifiPhy> sender,
+                Ptr<MobilityModel> senderMobility,
+                Ptr<YansWifiPhy> receiver,
+                Ptr<const WifiPpdu> ppdu,
+                dBm_u txPower) const;
+
+    /**
+     * Find the PHYs which may receive a PPDU with the spatial index, and
+     * store their indices, in the order of the PHY list, in m_candidates.
+     *
+     * @param senderMobility the mobility model of the sender
+     * @param ppdu the PPDU to send
+     * @param txPower the TX power associated to the packet
+     * @return false if all the PHYs must be evaluated instead
+     */
+    bool FindCandidates(Ptr<MobilityModel> senderMobility,
+                        Ptr<const WifiPpdu> ppdu,
+                        dBm_u txPower) const;
+
     PhyList m_phyList;                  //!< List of YansWifiPhys connected to this YansWifiChannel
     Ptr<PropagationLossModel> m_loss;   //!< Propagation loss model
     Ptr<PropagationDelayModel> m_delay; //!< Propagation delay model
+
+    bool m_enableSpatialIndex;      //!< Whether only the receivers in range are evaluated
+    double m_cellSize;              //!< Size of the cells of the spatial index (m)
+    mutable bool m_indexBuilt;      //!< Whether the spatial index holds all the PHYs
+    mutable dBm_u m_minRxThreshold; //!< Lowest RX sensitivity minus RX gain of the PHYs
+    mutable MobilityGrid m_grid;    //!< Spatial index of the PHYs, by index in the PHY list
+    mutable std::vector<uint64_t> m_candidates; //!< PHYs which may receive the current PPDU
 };
 
 } // namespace ns3
@@ -0,0 +1,433 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/interference-helper.h"
+#include "ns3/log.h"
+#include "ns3/nist-error-rate-model.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+#include "ns3/wifi-mac-header.h"
+#include "ns3/wifi-phy-operating-channel.h"
+#include "ns3/wifi-psdu.h"
+#include "ns3/wifi-spectrum-value-helper.h"
+#include "ns3/wifi-utils.h"
+
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("InterferenceHelperTest");
+
+/**
+ * @ingroup wifi-test
+ * @ingroup tests
+ *
+ * @brief Interference helper giving access to its NiChanges
+ */
+class NiChangesInterferenceHelper : public InterferenceHelper
+{
+  public:
+    using InterferenceHelper::CalculateSnr;
+
+    /// A NiChange as seen by the test: time, power and event
+    using Change = std::tuple<Time, Watt_u, Ptr<Event>>;
+
+    /**
+     * @param band the band
+     * @return the NiChanges of the given band
+     */
+    std::vector<Change> GetNiChanges(const WifiSpectrumBandInfo& band) const
+    {
+        std::vector<Change> changes;
+        for (const auto& [time, change] : m_niChanges.at(band))
+        {
+            changes.emplace_back(time, change.GetPower(), change.GetEvent());
+        }
+        return changes;
+    }
+
+    /**
+     * @param event the event
+     * @param band the band
+     * @return the noise and interference power of the given event and the
+     *         NiChanges of the given band during the given event
+     */
+    std::pair<Watt_u, std::vector<Change>> GetNiChangesSpan(Ptr<Event> event,
+                                                            const WifiSpectrumBandInfo& band) const
+    {
+        NiChangesSpanGuard guard(*this);
+        NiChangesSpan nis;
+        const auto noiseInterference = CalculateNoiseInterferenceW(event, nis, band);
+        std::vector<Change> changes;
+        for (const auto& [time, change] : nis)
+        {
+            changes.emplace_back(time, change.GetPower(), change.GetEvent());
+        }
+        return {noiseInterference, changes};
+    }
+};
+
+/**
+ * @ingroup wifi-test
+ * @ingroup tests
+ *
+ * @brief Test the NiChanges kept by the interference helper for a band, and the
+ * NiChanges it hands out for an event, when events start or end at the same time,
+ * when events end before events that were added earlier, and when the NiChanges of
+ * past events are removed while other events still overlap.
+ */
+class InterferenceHelperNiChangesTest : public TestCase
+{
+  public:
+    InterferenceHelperNiChangesTest();
+
+  private:
+    void DoSetup() override;
+    void DoRun() override;
+    void DoTeardown() override;
+
+    /// Events start and end at the same time
+    void RunEqualTimestamps();
+    /// Events end before events that were added earlier
+    void RunOutOfOrder();
+    /// The NiChanges of past events are removed while another event overlaps
+    void RunRemovalWithOverlap();
+
+    /**
+     * Add a signal starting now.
+     *
+     * @param power the received power
+     * @param duration the duration of the signal
+     * @return the event of the signal
+     */
+    Ptr<Event> AddSignal(Watt_u power, Time duration);
+
+    /**
+     * Check the NiChanges of the band.
+     *
+     * @param expected the expected NiChanges, without the initial one
+     */
+    void CheckNiChanges(const std::vector<NiChangesInterferenceHelper::Change>& expected);
+
+    /**
+     * Check the noise and interference power of an event and the NiChanges handed out
+     * for it, as well as its SNR.
+     *
+     * @param event the event
+     * @param expectedNi the expected noise and interference power
+     * @param expected the expected NiChanges during the event
+     */
+    void CheckEvent(Ptr<Event> event,
+                    Watt_u expectedNi,
+                    const std::vector<NiChangesInterferenceHelper::Change>& expected);
+
+    /**
+     * Check two lists of NiChanges.
+     *
+     * @param actual the actual NiChanges
+     * @param expected the expected NiChanges
+     * @param what what the NiChanges are
+     */
+    void CheckChanges(const std::vector<NiChangesInterferenceHelper::Change>& actual,
+                      const std::vector<NiChangesInterferenceHelper::Change>& expected,
+                      const std::string& what);
+
+    Ptr<NiChangesInterferenceHelper> m_interference; //!< the interference helper
+    WifiSpectrumBandInfo m_band;                     //!< the band
+    Ptr<const WifiPpdu> m_ppdu;                      //!< the PPDU of all the signals
+};
+
+InterferenceHelperNiChangesTest::InterferenceHelperNiChangesTest()
+    : TestCase("Check the sorted NiChanges of the interference helper"),
+      m_band{{{0, 63}}, {{MHzToHz(5170), MHzToHz(5190)}}}
+{
+}
+
+void
+InterferenceHelperNiChangesTest::DoSetup()
+{
+    WifiMacHeader hdr;
+    hdr.SetType(WIFI_MAC_QOSDATA);
+    hdr.SetQosTid(0);
+    m_ppdu = Create<WifiPpdu>(Create<WifiPsdu>(Create<Packet>(0), hdr),
+                              WifiTxVector(),
+                              WifiPhyOperatingChannel());
+}
+
+void
+InterferenceHelperNiChangesTest::DoTeardown()
+{
+    m_ppdu = nullptr;
+}
+
+Ptr<Event>
+InterferenceHelperNiChangesTest::AddSignal(Watt_u power, Time duration)
+{
+    RxPowerWattPerChannelBand rxPowerW{{m_band, power}};
+    return m_interference->Add(m_ppdu, duration, rxPowerW, WHOLE_WIFI_SPECTRUM);
+}
+
+void
+InterferenceHelperNiChangesTest::CheckChanges(
+    const std::vector<NiChangesInterferenceHelper::Change>& actual,
+    const std::vector<NiChangesInterferenceHelper::Change>& expected,
+    const std::string& what)
+{
+    NS_TEST_EXPECT_MSG_EQ(actual.size(), expected.size(), "Unexpected number of " << what);
+    for (std::size_t i = 0; i < std::min(actual.size(), expected.size()); ++i)
+    {
+        const auto& [time, power, event] = actual.at(i);
+        const auto& [expectedTime, expectedPower, expectedEvent] = expected.at(i);
+        NS_TEST_EXPECT_MSG_EQ(time, expectedTime, "Unexpected time of " << what << " #" << i);
+        NS_TEST_EXPECT_MSG_EQ_TOL(power,
+                                  expectedPower,
+                                  1e-12,
+                                  "Unexpected power of " << what << " #" << i);
+        NS_TEST_EXPECT_MSG_EQ(event, expectedEvent, "Unexpected event of " << what << " #" << i);
+    }
+}
+
+void
+InterferenceHelperNiChangesTest::CheckNiChanges(
+    const std::vector<NiChangesInterferenceHelper::Change>& expected)
+{
+    auto changes = m_interference->GetNiChanges(m_band);
+    NS_TEST_EXPECT_MSG_EQ(std::is_sorted(changes.cbegin(),
+                                         changes.cend(),
+                                         [](const auto& lhs, const auto& rhs) {
+                                             return std::get<Time>(lhs) < std::get<Time>(rhs);
+                                         }),
+                          true,
+                          "NiChanges are not sorted by time");
+    NS_TEST_EXPECT_MSG_EQ((!changes.empty() && !std::get<Ptr<Event>>(changes.front())),
+                          true,
+                          "The initial NiChange is missing");
+    if (!changes.empty())
+    {
+        changes.erase(changes.begin());
+    }
+    CheckChanges(changes, expected, "NiChanges");
+}
+
+void
+InterferenceHelperNiChangesTest::CheckEvent(
+    Ptr<Event> event,
+    Watt_u expectedNi,
+    const std::vector<NiChangesInterferenceHelper::Change>& expected)
+{
+    const auto [noiseInterference, changes] = m_interference->GetNiChangesSpan(event, m_band);
+    NS_TEST_EXPECT_MSG_EQ_TOL(noiseInterference,
+                              expectedNi,
+                              1e-12,
+                              "Unexpected noise and interference power at " << Simulator::Now());
+    CheckChanges(changes, expected, "NiChanges of event");
+    NS_TEST_EXPECT_MSG_EQ_TOL(
+        m_interference->CalculateSnr(event, MHz_u{20}, 1, m_band),
+        m_interference->CalculateSnr(event->GetRxPower(m_band), expectedNi, MHz_u{20}, 1),
+        1e-9,
+        "Unexpected SNR at " << Simulator::Now());
+}
+
+void
+InterferenceHelperNiChangesTest::RunEqualTimestamps()
+{
+    Ptr<Event> a;
+    Ptr<Event> b;
+    Ptr<Event> c;
+
+    // A, B and C start at 1us, A and B end at 11us
+    Simulator::Schedule(MicroSeconds(1), [&, this]() {
+        a = AddSignal(Watt_u{1}, MicroSeconds(10));
+        m_interference->NotifyRxStart(WHOLE_WIFI_SPECTRUM);
+        b = AddSignal(Watt_u{2}, MicroSeconds(10));
+        c = AddSignal(Watt_u{4}, MicroSeconds(5));
+    });
+
+    // the NiChanges at the same time are kept in the order they were added
+    Simulator::Schedule(MicroSeconds(3), [&, this]() {
+        CheckNiChanges({{MicroSeconds(1), 1, a},
+                        {MicroSeconds(1), 3, b},
+                        {MicroSeconds(1), 7, c},
+                        {MicroSeconds(6), 3, c},
+                        {MicroSeconds(11), 2, a},
+                        {MicroSeconds(11), 0, b}});
+        CheckEvent(a,
+                   6,
+                   {{MicroSeconds(1), 1, a},
+                    {MicroSeconds(1), 3, b},
+                    {MicroSeconds(1), 7, c},
+                    {MicroSeconds(6), 3, c},
+                    {MicroSeconds(11), 2, a}});
+        CheckEvent(b,
+                   5,
+                   {{MicroSeconds(1), 3, b},
+                    {MicroSeconds(1), 7, c},
+                    {MicroSeconds(6), 3, c},
+                    {MicroSeconds(11), 2, a},
+                    {MicroSeconds(11), 0, b}});
+        CheckEvent(c, 3, {{MicroSeconds(1), 7, c}, {MicroSeconds(6), 3, c}});
+    });
+
+    Simulator::Schedule(MicroSeconds(8), [&, this]() {
+        CheckEvent(a,
+                   2,
+                   {{MicroSeconds(1), 1, a},
+                    {MicroSeconds(1), 3, b},
+                    {MicroSeconds(1), 7, c},
+                    {MicroSeconds(6), 3, c},
+                    {MicroSeconds(11), 2, a}});
+        CheckEvent(b,
+                   1,
+                   {{MicroSeconds(1), 3, b},
+                    {MicroSeconds(1), 7, c},
+                    {MicroSeconds(6), 3, c},
+                    {MicroSeconds(11), 2, a},
+                    {MicroSeconds(11), 0, b}});
+    });
+
+    Simulator::Run();
+}
+
+void
+InterferenceHelperNiChangesTest::RunOutOfOrder()
+{
+    Ptr<Event> a;
+    Ptr<Event> b;
+    Ptr<Event> c;
+    Ptr<Event> d;
+
+    // A is received from 1us to 21us, B, C and D end before A and D ends with B
+    Simulator::Schedule(MicroSeconds(1), [&, this]() {
+        a = AddSignal(Watt_u{1}, MicroSeconds(20));
+        m_interference->NotifyRxStart(WHOLE_WIFI_SPECTRUM);
+    });
+    Simulator::Schedule(MicroSeconds(3),
+                        [&, this]() { b = AddSignal(Watt_u{2}, MicroSeconds(4)); });
+    Simulator::Schedule(MicroSeconds(5),
+                        [&, this]() { c = AddSignal(Watt_u{4}, MicroSeconds(10)); });
+    Simulator::Schedule(MicroSeconds(6),
+                        [&, this]() { d = AddSignal(Watt_u{8}, MicroSeconds(1)); });
+
+    Simulator::Schedule(NanoSeconds(6500), [&, this]() {
+        CheckNiChanges({{MicroSeconds(1), 1, a},
+                        {MicroSeconds(3), 3, b},
+                        {MicroSeconds(5), 7, c},
+                        {MicroSeconds(6), 15, d},
+                        {MicroSeconds(7), 13, b},
+                        {MicroSeconds(7), 5, d},
+                        {MicroSeconds(15), 1, c},
+                        {MicroSeconds(21), 0, a}});
+        CheckEvent(a,
+                   14,
+                   {{MicroSeconds(1), 1, a},
+                    {MicroSeconds(3), 3, b},
+                    {MicroSeconds(5), 7, c},
+                    {MicroSeconds(6), 15, d},
+                    {MicroSeconds(7), 13, b},
+                    {MicroSeconds(7), 5, d},
+                    {MicroSeconds(15), 1, c},
+                    {MicroSeconds(21), 0, a}});
+        CheckEvent(b,
+                   13,
+                   {{MicroSeconds(3), 3, b},
+                    {MicroSeconds(5), 7, c},
+                    {MicroSeconds(6), 15, d},
+                    {MicroSeconds(7), 13, b}});
+        CheckEvent(c,
+                   11,
+                   {{MicroSeconds(5), 7, c},
+                    {MicroSeconds(6), 15, d},
+                    {MicroSeconds(7), 13, b},
+                    {MicroSeconds(7), 5, d},
+                    {MicroSeconds(15), 1, c}});
+        CheckEvent(d,
+                   7,
+                   {{MicroSeconds(6), 15, d}, {MicroSeconds(7), 13, b}, {MicroSeconds(7), 5, d}});
+    });
+
+    Simulator::Run();
+}
+
+void
+InterferenceHelperNiChangesTest::RunRemovalWithOverlap()
+{
+    Ptr<Event> a;
+    Ptr<Event> b;
+    Ptr<Event> c;
+
+    // A lasts from 1us to 21us, B from 3us to 7us, the reception ends at 10us
+    Simulator::Schedule(MicroSeconds(1), [&, this]() {
+        a = AddSignal(Watt_u{1}, MicroSeconds(20));
+        m_interference->NotifyRxStart(WHOLE_WIFI_SPECTRUM);
+    });
+    Simulator::Schedule(MicroSeconds(3),
+                        [&, this]() { b = AddSignal(Watt_u{2}, MicroSeconds(4)); });
+    Simulator::Schedule(MicroSeconds(10), [&, this]() {
+        m_interference->NotifyRxEnd(Simulator::Now(), WHOLE_WIFI_SPECTRUM);
+    });
+
+    // C is added while not receiving: the NiChanges up to its start are removed,
+    // but the end of A, which still overlaps C, is kept
+    Simulator::Schedule(MicroSeconds(12), [&, this]() {
+        c = AddSignal(Watt_u{4}, MicroSeconds(5));
+        m_interference->NotifyRxStart(WHOLE_WIFI_SPECTRUM);
+    });
+
+    Simulator::Schedule(MicroSeconds(14), [&, this]() {
+        CheckNiChanges({{MicroSeconds(12), 5, c},
+                        {MicroSeconds(17), 1, c},
+                        {MicroSeconds(21), 0, a}});
+        CheckEvent(c, 1, {{MicroSeconds(12), 5, c}, {MicroSeconds(17), 1, c}});
+        // the energy of A is still accounted for until its end
+        NS_TEST_EXPECT_MSG_EQ(m_interference->GetEnergyDuration(Watt_u{2}, m_band),
+                              MicroSeconds(3),
+                              "Unexpected energy duration above 2W");
+        NS_TEST_EXPECT_MSG_EQ(m_interference->GetEnergyDuration(Watt_u{0.5}, m_band),
+                              MicroSeconds(7),
+                              "Unexpected energy duration above 0.5W");
+    });
+
+    Simulator::Run();
+}
+
+void
+InterferenceHelperNiChangesTest::DoRun()
+{
+    for (auto run : {&InterferenceHelperNiChangesTest::RunEqualTimestamps,
+                     &InterferenceHelperNiChangesTest::RunOutOfOrder,
+                     &InterferenceHelperNiChangesTest::RunRemovalWithOverlap})
+    {
+        m_interference = CreateObject<NiChangesInterferenceHelper>();
+        m_interference->SetNoiseFigure(1);
+        m_interference->SetErrorRateModel(CreateObject<NistErrorRateModel>());
+        m_interference->SetNumberOfReceiveAntennas(1);
+        m_interference->AddBand(m_band);
+        (this->*run)();
+        m_interference->Dispose();
+        m_interference = nullptr;
+        Simulator::Destroy();
+    }
+}
+
+/**
+ * @ingroup wifi-test
+ * @ingroup tests
+ *
+ * @brief Interference Helper Test Suite
+ */
+class InterferenceHelperTestSuite : public TestSuite
+{
+  public:
+    InterferenceHelperTestSuite();
+};
+
+InterferenceHelperTestSuite::InterferenceHelperTestSuite()
+    : TestSuite("wifi-interference-helper", Type::UNIT)
+{
+    AddTestCase(new InterferenceHelperNiChangesTest, TestCase::Duration::QUICK);
+}
+
+static InterferenceHelperTestSuite g_interferenceHelperTestSuite; ///< the test suite
@@ -21,6 +21,7 @@
 
 #include <list>
 #include <numeric>
+#include <vector>
 
 using namespace ns3;
 
@@ -1925,6 +1926,137 @@ PhyHeaderSectionsTest::DoRun()
     CheckPhyHeaderSections(phyEntity->GetPhyHeaderSections(txVector, ppduStart), sections);
 }
 
+/**
+ * @ingroup wifi-test
+ * @ingroup tests
+ *
+ * @brief Tx duration cache test
+ *
+ * The durations of non-MU PPDUs, including EHT SU PPDUs, are computed once by
+ * WifiPhy::CalculateTxDuration and then returned from its cache, whereas the durations of
+ * MU PPDUs are never cached. The durations
+ * returned from the cache must match the durations computed for the same parameters, and
+ * the PPDUs differing by any of these parameters must not share their durations.
+ */
+class TxDurationCacheTest : public TestCase
+{
+  public:
+    TxDurationCacheTest();
+
+  private:
+    void DoRun() override;
+};
+
+TxDurationCacheTest::TxDurationCacheTest()
+    : TestCase("Wifi TX duration cache")
+{
+}
+
+void
+TxDurationCacheTest::DoRun()
+{
+    WifiTxVector txVector;
+    txVector.SetMode(HePhy::GetHeMcs7());
+    txVector.SetPreambleType(WIFI_PREAMBLE_HE_SU);
+    txVector.SetChannelWidth(MHz_u{80});
+    txVector.SetGuardInterval(NanoSeconds(800));
+    txVector.SetNss(1);
+    txVector.SetNess(0);
+    txVector.SetStbc(false);
+
+    // the TX vectors differing from the first one by a single parameter
+    std::vector<WifiTxVector> txVectors{txVector};
+    txVectors.push_back(txVector);
+    txVectors.back().SetMode(HePhy::GetHeMcs9());
+    txVectors.push_back(txVector);
+    txVectors.back().SetChannelWidth(MHz_u{40});
+    txVectors.push_back(txVector);
+    txVectors.back().SetGuardInterval(NanoSeconds(3200));
+    txVectors.push_back(txVector);
+    txVectors.back().SetNss(2);
+    txVectors.push_back(txVector);
+    txVectors.back().SetPreambleType(WIFI_PREAMBLE_HE_ER_SU);
+    txVectors.back().SetChannelWidth(MHz_u{20});
+    txVectors.push_back(txVector);
+    txVectors.back().SetMode(HtPhy::GetHtMcs7());
+    txVectors.back().SetPreambleType(WIFI_PREAMBLE_HT_MF);
+    txVectors.back().SetChannelWidth(MHz_u{20});
+    txVectors.push_back(txVectors.back());
+    txVectors.back().SetStbc(true);
+    txVectors.push_back(txVectors.back());
+    txVectors.back().SetNess(1);
+    // EHT SU PPDUs use the EHT MU preamble
+    txVectors.push_back(txVector);
+    txVectors.back().SetMode(EhtPhy::GetEhtMcs7());
+    txVectors.back().SetPreambleType(WIFI_PREAMBLE_EHT_MU);
+    txVectors.back().SetEhtPpduType(1);
+    txVectors.back().SetChannelWidth(MHz_u{160});
+    txVectors.push_back(txVectors.back());
+    txVectors.back().SetMode(EhtPhy::GetEhtMcs3());
+
+    WifiPhy::ClearTxDurationCache();
+    std::vector<Time> durations;
+    for (const auto band : {WIFI_PHY_BAND_5GHZ, WIFI_PHY_BAND_2_4GHZ})
+    {
+        for (const auto& vector : txVectors)
+        {
+            for (const uint32_t size : {1500, 1501, 65535})
+            {
+                durations.push_back(WifiPhy::CalculateTxDuration(size, vector, band));
+            }
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ(WifiPhy::GetTxDurationCacheHits(), 0, "No duration should be cached");
+    NS_TEST_EXPECT_MSG_EQ(WifiPhy::GetTxDurationCacheMisses(),
+                          durations.size(),
+                          "All the durations should be computed");
+
+    auto duration = durations.cbegin();
+    for (const auto band : {WIFI_PHY_BAND_5GHZ, WIFI_PHY_BAND_2_4GHZ})
+    {
+        for (const auto& vector : txVectors)
+        {
+            for (const uint32_t size : {1500, 1501, 65535})
+            {
+                NS_TEST_EXPECT_MSG_EQ(WifiPhy::CalculateTxDuration(size, vector, band),
+                                      *duration++,
+                                      "Unexpected cached duration for " << vector);
+            }
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ(WifiPhy::GetTxDurationCacheHits(),
+                          durations.size(),
+                          "All the durations should be cached");
+    NS_TEST_EXPECT_MSG_EQ(WifiPhy::GetTxDurationCacheMisses(),
+                          durations.size(),
+                          "No duration should be computed again");
+
+    // the durations of MU PPDUs are not cached
+    WifiTxVector muTxVector;
+    muTxVector.SetPreambleType(WIFI_PREAMBLE_HE_MU);
+    muTxVector.SetChannelWidth(MHz_u{20});
+    muTxVector.SetGuardInterval(NanoSeconds(800));
+    muTxVector.SetHeMuUserInfo(1, {{HeRu::RU_106_TONE, 1, true}, 7, 1});
+    muTxVector.SetHeMuUserInfo(2, {{HeRu::RU_106_TONE, 2, true}, 7, 1});
+    muTxVector.SetSigBMode(VhtPhy::GetVhtMcs0());
+    muTxVector.SetRuAllocation({96}, 0);
+    const auto muDuration = WifiPhy::CalculateTxDuration(1500, muTxVector, WIFI_PHY_BAND_5GHZ, 1);
+    NS_TEST_EXPECT_MSG_EQ(WifiPhy::CalculateTxDuration(1500, muTxVector, WIFI_PHY_BAND_5GHZ, 1),
+                          muDuration,
+                          "Unexpected MU PPDU duration");
+    NS_TEST_EXPECT_MSG_EQ(WifiPhy::GetTxDurationCacheHits() + WifiPhy::GetTxDurationCacheMisses(),
+                          2 * durations.size(),
+                          "The duration of MU PPDUs should not be cached");
+
+    WifiPhy::ClearTxDurationCache();
+    NS_TEST_EXPECT_MSG_EQ(WifiPhy::CalculateTxDuration(1500, txVector, WIFI_PHY_BAND_5GHZ),
+                          durations.front(),
+                          "Unexpected duration after clearing the cache");
+    NS_TEST_EXPECT_MSG_EQ(WifiPhy::GetTxDurationCacheMisses(),
+                          1,
+                          "The duration should be computed after clearing the cache");
+}
+
 /**
  * @ingroup wifi-test
  * @ingroup tests
@@ -1942,6 +2074,8 @@ TxDurationTestSuite::TxDurationTestSuite()
 {
     AddTestCase(new TxDurationTest, TestCase::Duration::QUICK);
 
+    AddTestCase(new TxDurationCacheTest, TestCase::Duration::QUICK);
+
     AddTestCase(new PhyHeaderSectionsTest, TestCase::Duration::QUICK);
 
     // 20 MHz band, HeSigBDurationTest::OFDMA, even number of users per HE-SIG-B content channel
@@ -14,6 +14,8 @@
 #include <gsl/gsl_sf_bessel.h>
 #endif
 
+#include "ns3/boolean.h"
+#include "ns3/double.h"
 #include "ns3/dsss-error-rate-model.h"
 #include "ns3/he-phy.h" //includes HT and VHT
 #include "ns3/interference-helper.h"
@@ -1102,6 +1104,88 @@ TableBasedErrorRateTestCase::DoRun()
     }
 }
 
+/**
+ * @ingroup wifi-test
+ * @ingroup tests
+ *
+ * @brief Wifi Error Rate Models Lookup Tables Test Case
+ *
+ * The chunk success rates returned by an error rate model using lookup tables must be
+ * close to the chunk success rates computed by the same model without lookup tables,
+ * over the whole range of SNRs, and equal where the chunks are almost surely received.
+ */
+class WifiErrorRateModelsLookupTablesTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     *
+     * @param model the TypeId name of the error rate model
+     */
+    WifiErrorRateModelsLookupTablesTestCase(const std::string& model);
+
+  private:
+    void DoRun() override;
+
+    std::string m_model; ///< The TypeId name of the error rate model
+};
+
+WifiErrorRateModelsLookupTablesTestCase::WifiErrorRateModelsLookupTablesTestCase(
+    const std::string& model)
+    : TestCase("Lookup tables of " + model),
+      m_model(model)
+{
+}
+
+void
+WifiErrorRateModelsLookupTablesTestCase::DoRun()
+{
+    ObjectFactory factory(m_model);
+    auto model = factory.Create<ErrorRateModel>();
+    factory.Set("UseLookupTables", BooleanValue(true));
+    factory.Set("LookupTableMaxError", DoubleValue(1e-3));
+    auto tableModel = factory.Create<ErrorRateModel>();
+
+    std::vector<WifiMode> modes{OfdmPhy::GetOfdmRate6Mbps(),
+                                OfdmPhy::GetOfdmRate9Mbps(),
+                                OfdmPhy::GetOfdmRate54Mbps()};
+    for (uint8_t mcs = 0; mcs <= 11; mcs++)
+    {
+        modes.push_back(HePhy::GetHeMcs(mcs));
+    }
+    for (const auto& mode : modes)
+    {
+        WifiTxVector txVector;
+        txVector.SetMode(mode);
+        txVector.SetPreambleType(GetPreambleForTransmission(mode.GetModulationClass(), false));
+        txVector.SetChannelWidth(MHz_u{20});
+        txVector.SetGuardInterval(NanoSeconds(800));
+        for (dB_u snr{-15}; snr <= dB_u{60}; snr += dB_u{0.13})
+        {
+            for (const uint64_t nbits : {8, 1500 * 8, 65535 * 8})
+            {
+                const auto ps = model->GetChunkSuccessRate(mode, txVector, DbToRatio(snr), nbits);
+                const auto tablePs =
+                    tableModel->GetChunkSuccessRate(mode, txVector, DbToRatio(snr), nbits);
+                NS_TEST_EXPECT_MSG_EQ_TOL(tablePs,
+                                          ps,
+                                          1e-3,
+                                          "Wrong success rate of " << nbits << " bits with "
+                                                                   << mode << " at " << snr
+                                                                   << " dB");
+                if (ps == 1.0)
+                {
+                    NS_TEST_EXPECT_MSG_EQ(tablePs,
+                                          1.0,
+                                          "The chunk of " << nbits << " bits with " << mode
+                                                          << " at " << snr
+                                                          << " dB should be received");
+                }
+            }
+        }
+    }
+}
+
 /**
  * @ingroup wifi-test
  * @ingroup tests
@@ -1120,6 +1204,10 @@ WifiErrorRateModelsTestSuite::WifiErrorRateModelsTestSuite()
     AddTestCase(new WifiErrorRateModelsTestCaseDsss, TestCase::Duration::QUICK);
     AddTestCase(new WifiErrorRateModelsTestCaseNist, TestCase::Duration::QUICK);
     AddTestCase(new WifiErrorRateModelsTestCaseMimo, TestCase::Duration::QUICK);
+    AddTestCase(new WifiErrorRateModelsLookupTablesTestCase("ns3::NistErrorRateModel"),
+                TestCase::Duration::QUICK);
+    AddTestCase(new WifiErrorRateModelsLookupTablesTestCase("ns3::YansErrorRateModel"),
+                TestCase::Duration::QUICK);
     AddTestCase(new TableBasedErrorRateTestCase("DefaultTableBasedHtMcs0-1458bytes",
                                                 HtPhy::GetHtMcs0(),
                                                 1458),
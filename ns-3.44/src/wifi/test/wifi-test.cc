@@ -11,9 +11,12 @@
 
 #include "ns3/adhoc-wifi-mac.h"
 #include "ns3/ap-wifi-mac.h"
+#include "ns3/boolean.h"
 #include "ns3/config.h"
 #include "ns3/constant-position-mobility-model.h"
 #include "ns3/constant-rate-wifi-manager.h"
+#include "ns3/constant-velocity-mobility-model.h"
+#include "ns3/double.h"
 #include "ns3/error-model.h"
 #include "ns3/fcfs-wifi-queue-scheduler.h"
 #include "ns3/he-frame-exchange-manager.h"
@@ -45,6 +48,7 @@
 #include "ns3/wifi-psdu.h"
 #include "ns3/wifi-spectrum-signal-parameters.h"
 #include "ns3/yans-error-rate-model.h"
+#include "ns3/yans-wifi-channel.h"
 #include "ns3/yans-wifi-helper.h"
 #include "ns3/yans-wifi-phy.h"
 
@@ -3961,6 +3965,174 @@ DsssModulationTest::DoRun()
     NS_TEST_ASSERT_MSG_EQ(m_received, 4, "Did not receive four DSSS packets");
 }
 
+//-----------------------------------------------------------------------------
+/**
+ * @ingroup wifi-test
+ * @ingroup tests
+ *
+ * @brief Check that the spatial index of the YansWifiChannel does not change the receptions.
+ *
+ * Twenty ad hoc stations are placed every 50 meters on a line, and a
+ * station moves towards them from 2 km away. The first station and a
+ * station in the middle of the line send broadcast frames periodically.
+ * The stations must start receiving the same frames with and without the
+ * spatial index of the channel, while the signals of the stations out of
+ * range do not reach the PHYs with the spatial index.
+ */
+class YansWifiChannelSpatialIndexTest : public TestCase
+{
+  public:
+    YansWifiChannelSpatialIndexTest();
+    void DoRun() override;
+
+  private:
+    /**
+     * Run the scenario.
+     * @param enableIndex whether to enable the spatial index of the channel
+     */
+    void RunScenario(bool enableIndex);
+
+    /**
+     * Send a broadcast frame.
+     * @param device the sending device
+     */
+    void SendBroadcast(Ptr<NetDevice> device);
+
+    /**
+     * Callback invoked when a PHY starts receiving a frame.
+     * @param index the index of the station
+     * @param packet the received packet
+     * @param rxPowersW the received power per channel band in watts
+     */
+    void RxBegin(std::size_t index, Ptr<const Packet> packet, RxPowerWattPerChannelBand rxPowersW);
+
+    /**
+     * Callback invoked when a signal reaches a PHY.
+     * @param ppdu the PPDU
+     * @param rxPowerDbm the received power in dBm
+     * @param duration the duration of the signal
+     */
+    void SignalArrival(Ptr<const WifiPpdu> ppdu, double rxPowerDbm, Time duration);
+
+    std::vector<uint32_t> m_rxBegin; ///< number of frames received by each station
+    uint32_t m_signalArrivals;       ///< number of signals reaching a PHY
+};
+
+YansWifiChannelSpatialIndexTest::YansWifiChannelSpatialIndexTest()
+    : TestCase("Check the spatial index of the YansWifiChannel")
+{
+}
+
+void
+YansWifiChannelSpatialIndexTest::SendBroadcast(Ptr<NetDevice> device)
+{
+    device->Send(Create<Packet>(100), device->GetBroadcast(), 1);
+}
+
+void
+YansWifiChannelSpatialIndexTest::RxBegin(std::size_t index,
+                                         Ptr<const Packet> packet,
+                                         RxPowerWattPerChannelBand rxPowersW)
+{
+    m_rxBegin[index]++;
+}
+
+void
+YansWifiChannelSpatialIndexTest::SignalArrival(Ptr<const WifiPpdu> ppdu,
+                                               double rxPowerDbm,
+                                               Time duration)
+{
+    m_signalArrivals++;
+}
+
+void
+YansWifiChannelSpatialIndexTest::RunScenario(bool enableIndex)
+{
+    const std::size_t nStations = 21;
+    m_rxBegin.assign(nStations, 0);
+    m_signalArrivals = 0;
+
+    NodeContainer nodes;
+    nodes.Create(nStations);
+
+    YansWifiChannelHelper channel = YansWifiChannelHelper::Default();
+    Ptr<YansWifiChannel> yansChannel = channel.Create();
+    yansChannel->SetAttribute("EnableSpatialIndex", BooleanValue(enableIndex));
+    yansChannel->SetAttribute("SpatialIndexCellSize", DoubleValue(250));
+    YansWifiPhyHelper phy;
+    phy.SetChannel(yansChannel);
+
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211a);
+    wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager");
+    WifiMacHelper mac;
+    mac.SetType("ns3::AdhocWifiMac");
+    NetDeviceContainer devices = wifi.Install(phy, mac, nodes);
+    WifiHelper::AssignStreams(devices, 100);
+
+    MobilityHelper mobility;
+    Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator>();
+    for (std::size_t i = 0; i + 1 < nStations; i++)
+    {
+        positionAlloc->Add(Vector(50.0 * i, 0.0, 0.0));
+    }
+    positionAlloc->Add(Vector(-2000.0, 10.0, 0.0));
+    mobility.SetPositionAllocator(positionAlloc);
+    mobility.SetMobilityModel("ns3::ConstantVelocityMobilityModel");
+    mobility.Install(nodes);
+    nodes.Get(nStations - 1)->GetObject<ConstantVelocityMobilityModel>()->SetVelocity(
+        Vector(100.0, 0.0, 0.0));
+
+    for (std::size_t i = 0; i < nStations; i++)
+    {
+        auto yansPhy = DynamicCast<YansWifiPhy>(
+            DynamicCast<WifiNetDevice>(devices.Get(i))->GetPhy());
+        yansPhy->TraceConnectWithoutContext(
+            "PhyRxBegin",
+            MakeCallback(&YansWifiChannelSpatialIndexTest::RxBegin, this).Bind(i));
+        yansPhy->TraceConnectWithoutContext(
+            "SignalArrival",
+            MakeCallback(&YansWifiChannelSpatialIndexTest::SignalArrival, this));
+    }
+
+    for (Time t = MilliSeconds(100); t < Seconds(20); t += MilliSeconds(100))
+    {
+        Simulator::Schedule(t,
+                            &YansWifiChannelSpatialIndexTest::SendBroadcast,
+                            this,
+                            devices.Get(0));
+        Simulator::Schedule(t + MilliSeconds(50),
+                            &YansWifiChannelSpatialIndexTest::SendBroadcast,
+                            this,
+                            devices.Get(nStations / 2));
+    }
+
+    Simulator::Stop(Seconds(20));
+    Simulator::Run();
+    Simulator::Destroy();
+}
+
+void
+YansWifiChannelSpatialIndexTest::DoRun()
+{
+    RunScenario(false);
+    auto rxBegin = m_rxBegin;
+    auto signalArrivals = m_signalArrivals;
+
+    RunScenario(true);
+    for (std::size_t i = 0; i < rxBegin.size(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_rxBegin[i],
+                              rxBegin[i],
+                              "Station " << i << " did not receive the same frames");
+    }
+    NS_TEST_EXPECT_MSG_GT(rxBegin.back(), 0, "The moving station did not receive frames");
+    NS_TEST_EXPECT_MSG_LT(rxBegin.back(), rxBegin[1], "The moving station was always in range");
+    NS_TEST_EXPECT_MSG_LT(m_signalArrivals,
+                          signalArrivals,
+                          "All the PHYs were evaluated with the spatial index");
+}
+
 /**
  * @ingroup wifi-test
  * @ingroup tests
@@ -3995,6 +4167,7 @@ WifiTestSuite::WifiTestSuite()
     AddTestCase(new HeRuMcsDataRateTestCase, TestCase::Duration::QUICK);
     AddTestCase(new WifiMgtHeaderTest, TestCase::Duration::QUICK);
     AddTestCase(new DsssModulationTest, TestCase::Duration::QUICK);
+    AddTestCase(new YansWifiChannelSpatialIndexTest, TestCase::Duration::QUICK);
 }
 
 static WifiTestSuite g_wifiTestSuite; ///< the test suite
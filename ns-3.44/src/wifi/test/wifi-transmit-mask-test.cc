@@ -15,6 +15,7 @@
 #include "ns3/wifi-standards.h"
 
 #include <cmath>
+#include <functional>
 #include <vector>
 
 using namespace ns3;
@@ -299,6 +300,160 @@ WifiOfdmMaskSlopesTestCase::DoRun()
     }
 }
 
+/**
+ * @ingroup wifi-test
+ * @ingroup tests
+ *
+ * @brief Test checks that the transmit PSDs stored by WifiSpectrumValueHelper are scaled
+ * to the requested transmit power, are only shared by PSDs built with the same parameters
+ * and are not modified through the returned PSDs.
+ */
+class WifiTxPsdCacheTestCase : public TestCase
+{
+  public:
+    WifiTxPsdCacheTestCase();
+
+  private:
+    void DoRun() override;
+
+    /// Function building a transmit PSD for the given transmit power
+    using CreatePsdFunction = std::function<Ptr<SpectrumValue>(Watt_u)>;
+
+    /**
+     * Check the transmit PSDs built by a function for different transmit powers.
+     *
+     * @param name the name of the function
+     * @param createPsd the function building the transmit PSD
+     */
+    void CheckTxPsds(const std::string& name, const CreatePsdFunction& createPsd);
+};
+
+WifiTxPsdCacheTestCase::WifiTxPsdCacheTestCase()
+    : TestCase("Check the transmit PSDs stored by WifiSpectrumValueHelper")
+{
+}
+
+void
+WifiTxPsdCacheTestCase::CheckTxPsds(const std::string& name, const CreatePsdFunction& createPsd)
+{
+    const Watt_u txPower{0.1};
+    auto psd = createPsd(txPower);
+    NS_TEST_EXPECT_MSG_EQ_TOL(Integral(*psd), txPower, 1e-9, "Wrong " << name << " TX power");
+    const auto expected = psd->Copy();
+
+    auto scaledPsd = createPsd(4 * txPower);
+    NS_TEST_EXPECT_MSG_EQ_TOL(Integral(*scaledPsd),
+                              4 * txPower,
+                              1e-9,
+                              "Wrong scaled " << name << " TX power");
+    for (std::size_t i = 0; i < expected->GetValuesN(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ_TOL((*scaledPsd)[i],
+                                  4 * (*expected)[i],
+                                  1e-9 * (*expected)[i],
+                                  "Wrong scaled " << name << " PSD for band " << i);
+    }
+
+    // the returned PSDs belong to the caller
+    *psd = 0;
+    *scaledPsd = 0;
+    auto otherPsd = createPsd(txPower);
+    NS_TEST_EXPECT_MSG_EQ((otherPsd != psd), true, "The " << name << " PSDs should not be shared");
+    for (std::size_t i = 0; i < expected->GetValuesN(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ((*otherPsd)[i],
+                              (*expected)[i],
+                              "Wrong " << name << " PSD for band " << i);
+    }
+}
+
+void
+WifiTxPsdCacheTestCase::DoRun()
+{
+    CheckTxPsds("DSSS", [](Watt_u txPower) {
+        return WifiSpectrumValueHelper::CreateDsssTxPowerSpectralDensity(MHz_u{2412},
+                                                                         txPower,
+                                                                         MHz_u{20});
+    });
+    CheckTxPsds("OFDM", [](Watt_u txPower) {
+        return WifiSpectrumValueHelper::CreateOfdmTxPowerSpectralDensity(MHz_u{5180},
+                                                                         MHz_u{20},
+                                                                         txPower,
+                                                                         MHz_u{20});
+    });
+    CheckTxPsds("HT OFDM", [](Watt_u txPower) {
+        return WifiSpectrumValueHelper::CreateHtOfdmTxPowerSpectralDensity({MHz_u{5190}},
+                                                                           MHz_u{40},
+                                                                           txPower,
+                                                                           MHz_u{20});
+    });
+    for (const auto& puncturedSubchannels :
+         std::vector<std::vector<bool>>{{}, {false, true, false, false}})
+    {
+        CheckTxPsds("non-HT duplicate", [&](Watt_u txPower) {
+            return WifiSpectrumValueHelper::CreateDuplicated20MhzTxPowerSpectralDensity(
+                {MHz_u{5210}},
+                MHz_u{80},
+                txPower,
+                MHz_u{20},
+                dBr_u{-20},
+                dBr_u{-28},
+                dBr_u{-40},
+                puncturedSubchannels);
+        });
+        CheckTxPsds("HE OFDM", [&](Watt_u txPower) {
+            return WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity(
+                MHz_u{5210},
+                MHz_u{80},
+                txPower,
+                MHz_u{20},
+                dBr_u{-20},
+                dBr_u{-28},
+                dBr_u{-40},
+                puncturedSubchannels);
+        });
+    }
+
+    // the PSDs built with different parameters are not mixed up
+    const Watt_u txPower{0.1};
+    const auto psd = WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity(MHz_u{5210},
+                                                                                 MHz_u{80},
+                                                                                 txPower,
+                                                                                 MHz_u{20});
+    const auto puncturedPsd =
+        WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity(MHz_u{5210},
+                                                                    MHz_u{80},
+                                                                    txPower,
+                                                                    MHz_u{20},
+                                                                    dBr_u{-20},
+                                                                    dBr_u{-28},
+                                                                    dBr_u{-40},
+                                                                    {false, true, false, false});
+    const auto otherMaskPsd =
+        WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity(MHz_u{5210},
+                                                                    MHz_u{80},
+                                                                    txPower,
+                                                                    MHz_u{20},
+                                                                    dBr_u{-25},
+                                                                    dBr_u{-28},
+                                                                    dBr_u{-40});
+    // the second 20 MHz subchannel of the 80 MHz channel is punctured
+    const auto band = psd->GetValuesN() / 2 - 256 + 64;
+    NS_TEST_EXPECT_MSG_GT((*psd)[band],
+                          50 * (*puncturedPsd)[band],
+                          "The punctured subchannel should carry no power");
+    // the inner band of the mask goes down to -20 dBr or -25 dBr
+    std::size_t nLowerBands = 0;
+    for (std::size_t i = 0; i < psd->GetValuesN(); i++)
+    {
+        if ((*psd)[i] > 2 * (*otherMaskPsd)[i])
+        {
+            nLowerBands++;
+        }
+    }
+    NS_TEST_EXPECT_MSG_GT(nLowerBands, 0, "The inner band should be lower with a -25 dBr mask");
+}
+
 /**
  * @ingroup wifi-test
  * @ingroup tests
@@ -1504,4 +1659,6 @@ WifiTransmitMaskTestSuite::WifiTransmitMaskTestSuite()
                                        prec,
                                        {false, false, false, false, false, false, true, true}),
         TestCase::Duration::QUICK);
+
+    AddTestCase(new WifiTxPsdCacheTestCase, TestCase::Duration::QUICK);
 }
@@ -0,0 +1,149 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program can be used to benchmark the cost of an enqueue/dequeue pair
+// in a FIFO queue holding a given number of packets, with the std::list and
+// the RingBuffer containers, and through a DropTailQueue.
+// Sample usage:  ./ns3 run 'bench-queue --n=1000000 --depths=10,100,1000'
+
+#include "ns3/command-line.h"
+#include "ns3/drop-tail-queue.h"
+#include "ns3/packet.h"
+#include "ns3/queue-size.h"
+#include "ns3/ring-buffer.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <list>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * Enqueue and dequeue packets in a container, the way Queue does.
+ *
+ * @tparam Container the container type
+ * @param packets the packets, as many as the depth of the queue
+ * @param n the number of enqueue/dequeue pairs
+ */
+template <typename Container>
+static void
+benchContainer(const std::vector<Ptr<Packet>>& packets, uint32_t n)
+{
+    Container container;
+    for (const auto& p : packets)
+    {
+        container.insert(container.end(), p);
+    }
+    for (uint32_t i = 0; i < n; i++)
+    {
+        Ptr<Packet> p = *container.begin();
+        container.erase(container.begin());
+        container.insert(container.end(), p);
+    }
+}
+
+/**
+ * Enqueue and dequeue packets in a DropTailQueue.
+ *
+ * @param packets the packets, as many as the depth of the queue
+ * @param n the number of enqueue/dequeue pairs
+ */
+static void
+benchDropTailQueue(const std::vector<Ptr<Packet>>& packets, uint32_t n)
+{
+    Ptr<DropTailQueue<Packet>> queue = CreateObject<DropTailQueue<Packet>>();
+    queue->SetMaxSize(QueueSize(QueueSizeUnit::PACKETS, packets.size() + 1));
+    for (const auto& p : packets)
+    {
+        queue->Enqueue(p);
+    }
+    for (uint32_t i = 0; i < n; i++)
+    {
+        queue->Enqueue(queue->Dequeue());
+    }
+    queue->Dispose();
+}
+
+/**
+ * Run a benchmark several times and print the best time per enqueue/dequeue pair.
+ *
+ * @param bench the benchmark
+ * @param depth the number of packets in the queue
+ * @param n the number of enqueue/dequeue pairs
+ * @param minIterations the number of runs
+ * @param name the name of the benchmark
+ */
+static void
+runBench(void (*bench)(const std::vector<Ptr<Packet>>&, uint32_t),
+         uint32_t depth,
+         uint32_t n,
+         uint32_t minIterations,
+         const char* name)
+{
+    std::vector<Ptr<Packet>> packets;
+    for (uint32_t i = 0; i < depth; i++)
+    {
+        packets.push_back(Create<Packet>(1500));
+    }
+    uint64_t minDelay = std::numeric_limits<uint64_t>::max();
+    for (uint32_t i = 0; i < minIterations; i++)
+    {
+        SystemWallClockMs time;
+        time.Start();
+        (*bench)(packets, n);
+        minDelay = std::min(minDelay, static_cast<uint64_t>(time.End()));
+    }
+    double ns = minDelay * 1e6 / n;
+    std::cout << std::setw(8) << depth << std::setw(12) << std::fixed << std::setprecision(1)
+              << ns << " ns/pair (" << minDelay << " ms elapsed)\t" << name << std::endl;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t n = 1000000;
+    uint32_t minIterations = 1;
+    std::string depths = "1,10,100,1000,10000";
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the containers of the Queue class");
+    cmd.AddValue("n", "number of enqueue/dequeue pairs", n);
+    cmd.AddValue("min-iterations",
+                 "number of subiterations to minimize iteration time over",
+                 minIterations);
+    cmd.AddValue("depths", "comma separated list of queue depths, in packets", depths);
+    cmd.Parse(argc, argv);
+
+    if (n == 0)
+    {
+        std::cerr << "Error-- the number of enqueue/dequeue pairs must not be zero" << std::endl;
+        exit(1);
+    }
+    std::cout << "Running bench-queue with n=" << n << std::endl;
+    std::cout << "   depth        time" << std::endl;
+
+    std::istringstream iss(depths);
+    std::string token;
+    while (std::getline(iss, token, ','))
+    {
+        uint32_t depth = std::stoul(token);
+        if (depth == 0)
+        {
+            std::cerr << "Error-- the queue depths must not be zero" << std::endl;
+            exit(1);
+        }
+        runBench(&benchContainer<std::list<Ptr<Packet>>>, depth, n, minIterations, "std::list");
+        runBench(&benchContainer<RingBuffer<Ptr<Packet>>>, depth, n, minIterations, "RingBuffer");
+        runBench(&benchDropTailQueue, depth, n, minIterations, "DropTailQueue");
+    }
+
+    return 0;
+}